@@ -15,6 +15,10 @@
 #include "lib/ob_define.h"
 #include "isa-l/crc64.h"
 #include "isa-l/crc.h"
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#endif
 
 namespace oceanbase
 {
@@ -451,6 +455,205 @@ uint64_t crc64_sse42(uint64_t uCRC64,
   return crc;
 }
 
+/*
+ * The crc32 instruction has a latency of 3 cycles but can be issued once per cycle, so
+ * crc64_sse42 which computes a single dependent chain only uses 1/3 of the throughput.
+ * crc64_sse42_3way splits the buffer into three adjacent blocks, computes them as three
+ * independent chains and merges the results:
+ *   crc(A|B, c) = crc(B, shift(crc(A, c), len(B)))   and   crc(B, c) = shift(c, len(B)) ^ crc(B, 0)
+ * shift(c, n) multiplies c by x^(8n) modulo the crc32c polynomial, it is a linear function
+ * of c and is computed by four table lookups.
+ *
+ * crc64_sse42_fold is used for large buffers when the CPU supports PCLMULQDQ, it folds
+ * 64 bytes per round with carry-less multiplications, and reduces the folded 128 bits
+ * with the crc32 instruction.
+ *
+ * Both of them return the same value as crc64_sse42.
+ */
+#if defined(__x86_64__)
+#define OB_CRC32C_TARGET __attribute__((target("sse4.2")))
+#define OB_CRC32C_FOLD_TARGET __attribute__((target("sse4.2,pclmul")))
+#define OB_CRC32C_U64(crc, ptr) _mm_crc32_u64((crc), *(const uint64_t *)(ptr))
+#define OB_CRC32C_U8(crc, ptr) _mm_crc32_u8(static_cast<uint32_t>(crc), *(const uint8_t *)(ptr))
+#elif defined(__aarch64__)
+#define OB_CRC32C_TARGET
+#define OB_CRC32C_U64(crc, ptr) __crc32cd(static_cast<uint32_t>(crc), *(const uint64_t *)(ptr))
+#define OB_CRC32C_U8(crc, ptr) __crc32cb(static_cast<uint32_t>(crc), *(const uint8_t *)(ptr))
+#endif
+
+static const uint32_t CRC32C_POLY_REFLECTED = 0x82F63B78;
+static const int64_t CRC32C_LONG_BLOCK = 8192;
+static const int64_t CRC32C_SHORT_BLOCK = 256;
+static const int64_t CRC32C_FOLD_MIN_SIZE = 1024;
+static uint32_t crc32c_long_shift_table[4][256];
+static uint32_t crc32c_short_shift_table[4][256];
+// constants of crc64_sse42_fold, see crc32c_fold_constant
+static uint64_t crc32c_fold64_constant[2];
+static uint64_t crc32c_fold16_constant[2];
+
+// the polynomials are bit reflected, bit 31 is the coefficient of x^0.
+static uint32_t crc32c_multmodp(uint32_t a, uint32_t b)
+{
+  uint32_t m = 1U << 31;
+  uint32_t p = 0;
+  while (0 != m) {
+    if (a & m) {
+      p ^= b;
+    }
+    m >>= 1;
+    b = (b & 1) ? ((b >> 1) ^ CRC32C_POLY_REFLECTED) : (b >> 1);
+  }
+  return p;
+}
+
+// x^n modulo the crc32c polynomial
+static uint32_t crc32c_xpow_modp(int64_t n)
+{
+  uint32_t p = 1U << 31;
+  for (int64_t i = 0; i < n; i++) {
+    p = (p & 1) ? ((p >> 1) ^ CRC32C_POLY_REFLECTED) : (p >> 1);
+  }
+  return p;
+}
+
+static void crc32c_init_shift_table(uint32_t table[4][256], const int64_t len)
+{
+  const uint32_t xp = crc32c_xpow_modp(len * 8);
+  for (int64_t k = 0; k < 4; k++) {
+    for (uint32_t b = 0; b < 256; b++) {
+      table[k][b] = crc32c_multmodp(xp, b << (8 * k));
+    }
+  }
+}
+
+// A 128 bits lane is folded forward 'len' bytes by multiplying its high degree half with
+// x^(8 * len + 64) and low degree half with x^(8 * len). The product of pclmulqdq on two
+// reflected operands is shifted by x^33 in the 128 bits lane, so x^33 is subtracted from
+// the exponents.
+static void crc32c_fold_constant(uint64_t constant[2], const int64_t len)
+{
+  constant[0] = crc32c_xpow_modp(len * 8 + 64 - 33);
+  constant[1] = crc32c_xpow_modp(len * 8 - 33);
+}
+
+void ob_init_crc32c_shift_table()
+{
+  crc32c_init_shift_table(crc32c_long_shift_table, CRC32C_LONG_BLOCK);
+  crc32c_init_shift_table(crc32c_short_shift_table, CRC32C_SHORT_BLOCK);
+  crc32c_fold_constant(crc32c_fold64_constant, 64);
+  crc32c_fold_constant(crc32c_fold16_constant, 16);
+}
+
+void __attribute__((constructor)) ob_global_init_crc32c_shift_table()
+{
+  ob_init_crc32c_shift_table();
+}
+
+static inline uint64_t crc32c_shift(const uint32_t table[4][256], const uint64_t crc)
+{
+  return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff]
+      ^ table[2][(crc >> 16) & 0xff] ^ table[3][(crc >> 24) & 0xff];
+}
+
+OB_CRC32C_TARGET static inline void crc32c_3way_blocks(const uint32_t table[4][256],
+                                                      const int64_t block_size,
+                                                      uint64_t &crc,
+                                                      const char *&buf,
+                                                      int64_t &len)
+{
+  while (len >= 3 * block_size) {
+    uint64_t crc0 = crc;
+    uint64_t crc1 = 0;
+    uint64_t crc2 = 0;
+    const char *end = buf + block_size;
+    do {
+      crc0 = OB_CRC32C_U64(crc0, buf);
+      crc1 = OB_CRC32C_U64(crc1, buf + block_size);
+      crc2 = OB_CRC32C_U64(crc2, buf + 2 * block_size);
+      buf += 8;
+    } while (buf < end);
+    crc = crc32c_shift(table, crc0) ^ crc1;
+    crc = crc32c_shift(table, crc) ^ crc2;
+    buf += 2 * block_size;
+    len -= 3 * block_size;
+  }
+}
+
+OB_CRC32C_TARGET uint64_t crc64_sse42_3way(uint64_t uCRC64, const char *buf, int64_t len)
+{
+  uint64_t crc = uCRC64;
+  if (NULL != buf && len > 0) {
+    while (len > 0 && ((uint64_t) buf & 7)) {
+      crc = OB_CRC32C_U8(crc, buf);
+      buf++;
+      len--;
+    }
+    crc32c_3way_blocks(crc32c_long_shift_table, CRC32C_LONG_BLOCK, crc, buf, len);
+    crc32c_3way_blocks(crc32c_short_shift_table, CRC32C_SHORT_BLOCK, crc, buf, len);
+    while (len >= 32) {
+      crc = OB_CRC32C_U64(crc, buf);
+      crc = OB_CRC32C_U64(crc, buf + 8);
+      crc = OB_CRC32C_U64(crc, buf + 16);
+      crc = OB_CRC32C_U64(crc, buf + 24);
+      buf += 32;
+      len -= 32;
+    }
+    while (len >= 8) {
+      crc = OB_CRC32C_U64(crc, buf);
+      buf += 8;
+      len -= 8;
+    }
+    while (len > 0) {
+      crc = OB_CRC32C_U8(crc, buf);
+      buf++;
+      len--;
+    }
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+OB_CRC32C_FOLD_TARGET static inline __m128i crc32c_fold(const __m128i x, const __m128i constant)
+{
+  return _mm_xor_si128(_mm_clmulepi64_si128(x, constant, 0x00),
+                       _mm_clmulepi64_si128(x, constant, 0x11));
+}
+
+OB_CRC32C_FOLD_TARGET uint64_t crc64_sse42_fold(uint64_t uCRC64, const char *buf, int64_t len)
+{
+  uint64_t crc = uCRC64;
+  if (NULL == buf || len < CRC32C_FOLD_MIN_SIZE) {
+    crc = crc64_sse42_3way(crc, buf, len);
+  } else {
+    const __m128i fold64 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(crc32c_fold64_constant));
+    const __m128i fold16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(crc32c_fold16_constant));
+    const __m128i *ptr = reinterpret_cast<const __m128i *>(buf);
+    // crc(D, c) == crc(D ^ c, 0), c is xored into the first 4 bytes
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(ptr), _mm_cvtsi32_si128(static_cast<uint32_t>(crc)));
+    __m128i x1 = _mm_loadu_si128(ptr + 1);
+    __m128i x2 = _mm_loadu_si128(ptr + 2);
+    __m128i x3 = _mm_loadu_si128(ptr + 3);
+    ptr += 4;
+    len -= 64;
+    while (len >= 64) {
+      x0 = _mm_xor_si128(crc32c_fold(x0, fold64), _mm_loadu_si128(ptr));
+      x1 = _mm_xor_si128(crc32c_fold(x1, fold64), _mm_loadu_si128(ptr + 1));
+      x2 = _mm_xor_si128(crc32c_fold(x2, fold64), _mm_loadu_si128(ptr + 2));
+      x3 = _mm_xor_si128(crc32c_fold(x3, fold64), _mm_loadu_si128(ptr + 3));
+      ptr += 4;
+      len -= 64;
+    }
+    x0 = _mm_xor_si128(crc32c_fold(x0, fold16), x1);
+    x0 = _mm_xor_si128(crc32c_fold(x0, fold16), x2);
+    x0 = _mm_xor_si128(crc32c_fold(x0, fold16), x3);
+    crc = _mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(x0)));
+    crc = _mm_crc32_u64(crc, static_cast<uint64_t>(_mm_extract_epi64(x0, 1)));
+    crc = crc64_sse42_3way(crc, reinterpret_cast<const char *>(ptr), len);
+  }
+  return crc;
+}
+#endif
+
 uint64_t crc64_sse42_manually(uint64_t crc, const char *buf, int64_t len)
 {
   /**
@@ -1134,8 +1337,13 @@ uint64_t crc64_sse42_dispatch(uint64_t crc, const char *buf, int64_t len)
     _OB_LOG(WARN, "Use ISAL for crc64 calculate");
   } else{
     asm("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "0"(1));
-    if ((c & (1 << 20)) != 0) {
-      ob_crc64_sse42_func = &crc64_sse42;
+    if ((c & (1 << 20)) != 0 && (c & (1 << 1)) != 0) {
+      ob_init_crc32c_shift_table();
+      ob_crc64_sse42_func = &crc64_sse42_fold;
+      _OB_LOG(WARN, "Use CPU crc32 and pclmulqdq instructs for crc64 calculate");
+    } else if ((c & (1 << 20)) != 0) {
+      ob_init_crc32c_shift_table();
+      ob_crc64_sse42_func = &crc64_sse42_3way;
       _OB_LOG(WARN, "Use CPU crc32 instructs for crc64 calculate");
     } else {
       ob_crc64_sse42_func = &fast_crc64_sse42_manually;
@@ -1144,7 +1352,8 @@ uint64_t crc64_sse42_dispatch(uint64_t crc, const char *buf, int64_t len)
   }
   #elif defined(__aarch64__)
     #if 1
-    ob_crc64_sse42_func = &crc64_sse42;
+    ob_init_crc32c_shift_table();
+    ob_crc64_sse42_func = &crc64_sse42_3way;
     _OB_LOG(INFO, "Use CPU crc32 instructs for crc64 calculate");
     #else
     ob_crc64_sse42_func = &fast_crc64_sse42_manually;
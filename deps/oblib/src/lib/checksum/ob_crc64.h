@@ -70,6 +70,13 @@ inline uint64_t ob_crc64_sse42(const void *pv, int64_t cb)
 
 uint64_t ob_crc64_isal(uint64_t uCRC64, const char* buf, int64_t cb);
 uint64_t crc64_sse42(uint64_t uCRC64, const char* buf, int64_t len);
+// computes three interleaved crc32 streams, returns the same value as crc64_sse42
+uint64_t crc64_sse42_3way(uint64_t uCRC64, const char* buf, int64_t len);
+#if defined(__x86_64__)
+// folds large buffers with pclmulqdq, returns the same value as crc64_sse42
+uint64_t crc64_sse42_fold(uint64_t uCRC64, const char* buf, int64_t len);
+#endif
+void ob_init_crc32c_shift_table();
 uint64_t crc64_sse42_manually(uint64_t crc, const char *buf, int64_t len);
 uint64_t fast_crc64_sse42_manually(uint64_t crc, const char *buf, int64_t len);
 
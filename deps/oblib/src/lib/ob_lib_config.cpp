@@ -18,7 +18,8 @@ namespace lib
 
 ObLibConfig::ObLibConfig()
   : enable_diagnose_info_(true),
-    enable_trace_log_(true)
+    enable_trace_log_(true),
+    diagnose_info_sample_percentage_(100)
 {
 }
 
@@ -38,5 +39,11 @@ void ObLibConfig::reload_trace_log_config(const bool enable_trace_log)
   ATOMIC_SET(&enable_trace_log_, enable_trace_log);
 }
 
+void ObLibConfig::reload_diagnose_info_sample_config(const int64_t sample_percentage)
+{
+  ATOMIC_SET(&diagnose_info_sample_percentage_,
+             sample_percentage < 1 ? 1 : (sample_percentage > 100 ? 100 : sample_percentage));
+}
+
 } //lib
 } //oceanbase
@@ -26,6 +26,7 @@ public:
   static ObLibConfig &get_instance();
   void reload_diagnose_info_config(const bool enable_diagnose_info);
   void reload_trace_log_config(const bool enable_trace_log);
+  void reload_diagnose_info_sample_config(const int64_t sample_percentage);
   bool is_diagnose_info_enabled() const
   {
     return enable_diagnose_info_;
@@ -34,13 +35,31 @@ public:
   {
     return enable_trace_log_;
   }
+  int64_t get_diagnose_info_sample_percentage() const
+  {
+    return diagnose_info_sample_percentage_;
+  }
 private:
   ObLibConfig();
   virtual ~ObLibConfig() = default;
   volatile bool enable_diagnose_info_ CACHE_ALIGNED;
   volatile bool enable_trace_log_ CACHE_ALIGNED;
+  volatile int64_t diagnose_info_sample_percentage_ CACHE_ALIGNED;
 };
 
+// Sample scale of the wait events of the request processed by current thread,
+// set by ObDiagnoseInfoSampleGuard:
+//   0: the request is not sampled, its wait events are not counted into
+//      the session and tenant wait event statistics
+//   1: all requests are sampled, or not in request processing
+//   N: the request is sampled by 1/N, wait event statistics are scaled by N
+// The per-request wait info (sql audit, session wait, ASH) is not sampled.
+OB_INLINE int64_t &get_diagnose_info_sample_scale()
+{
+  thread_local int64_t sample_scale = 1;
+  return sample_scale;
+}
+
 inline bool is_diagnose_info_enabled()
 {
   return ObLibConfig::get_instance().is_diagnose_info_enabled();
@@ -53,6 +72,13 @@ inline int reload_diagnose_info_config(const bool enable_diagnose_info)
   return ret;
 }
 
+inline int reload_diagnose_info_sample_config(const int64_t sample_percentage)
+{
+  int ret = common::OB_SUCCESS;
+  ObLibConfig::get_instance().reload_diagnose_info_sample_config(sample_percentage);
+  return ret;
+}
+
 inline bool is_trace_log_enabled()
 {
   return ObLibConfig::get_instance().is_trace_log_enabled();
@@ -15,6 +15,7 @@
 
 #include "lib/queue/ob_link_queue.h"
 #include "lib/lock/ob_scond.h"
+#include "lib/allocator/ob_malloc.h"
 
 namespace oceanbase
 {
@@ -203,6 +204,207 @@ private:
   int64_t limit_ CACHE_ALIGNED;
   DISALLOW_COPY_AND_ASSIGN(ObPriorityQueue2);
 };
+
+// Sharded version of ObPriorityQueue2.
+// Tasks are pushed into the shard of pusher's cpu, and popped from the home shard of the
+// worker first, then stolen from sibling shards. Shards are scanned priority by priority,
+// so a higher priority task in any shard is always preferred to lower priority ones.
+// Waiters share one cond, so any pushed task can wake up an idle worker.
+// With one shard, it behaves the same as ObPriorityQueue2 and needs no extra memory.
+template <int HIGH_HIGH_PRIOS, int HIGH_PRIOS=0, int LOW_PRIOS=0>
+class ObShardedPriorityQueue2
+{
+public:
+  enum { PRIO_CNT = HIGH_HIGH_PRIOS + HIGH_PRIOS + LOW_PRIOS };
+  static const int64_t MAX_SHARD_CNT = 64;
+
+  ObShardedPriorityQueue2()
+    : default_shard_(), shards_(&default_shard_), shard_cnt_(1), limit_(INT64_MAX) {}
+  ~ObShardedPriorityQueue2() { destroy(); }
+
+  // should be called before any task is pushed
+  int init(const int64_t shard_cnt, const ObMemAttr &attr)
+  {
+    int ret = OB_SUCCESS;
+    Shard *shards = NULL;
+    if (OB_UNLIKELY(shard_cnt <= 0) || OB_UNLIKELY(shard_cnt > MAX_SHARD_CNT)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "invalid shard count", K(ret), K(shard_cnt));
+    } else if (OB_UNLIKELY(size() > 0) || OB_UNLIKELY(shards_ != &default_shard_)) {
+      ret = OB_INIT_TWICE;
+      COMMON_LOG(WARN, "sharded priority queue is in use", K(ret), K(size()), K_(shard_cnt));
+    } else if (1 == shard_cnt) {
+      // use default shard
+    } else if (OB_ISNULL(shards = static_cast<Shard*>(ob_malloc(sizeof(Shard) * shard_cnt, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "alloc shards failed", K(ret), K(shard_cnt));
+    } else {
+      for (int64_t i = 0; i < shard_cnt; i++) {
+        new (shards + i) Shard();
+      }
+      shards_ = shards;
+      shard_cnt_ = shard_cnt;
+      set_limit(limit_);
+    }
+    return ret;
+  }
+
+  void destroy()
+  {
+    if (shards_ != &default_shard_) {
+      for (int64_t i = 0; i < shard_cnt_; i++) {
+        shards_[i].~Shard();
+      }
+      ob_free(shards_);
+      shards_ = &default_shard_;
+      shard_cnt_ = 1;
+      set_limit(limit_);
+    }
+  }
+
+  // split the limit among shards, so the total size never exceeds it
+  void set_limit(int64_t limit)
+  {
+    limit_ = limit;
+    for (int64_t i = 0; i < shard_cnt_; i++) {
+      shards_[i].limit_ = INT64_MAX == limit ? limit : limit / shard_cnt_ + (i < limit % shard_cnt_ ? 1 : 0);
+    }
+  }
+  int64_t get_shard_cnt() const { return shard_cnt_; }
+  inline int64_t size() const
+  {
+    int64_t size = 0;
+    for (int64_t i = 0; i < shard_cnt_; i++) {
+      size += ATOMIC_LOAD(&shards_[i].size_);
+    }
+    return size;
+  }
+  int64_t queue_size(const int i) const
+  {
+    int64_t size = 0;
+    for (int64_t j = 0; j < shard_cnt_; j++) {
+      size += shards_[j].queue_[i].size();
+    }
+    return size;
+  }
+  int64_t to_string(char *buf, const int64_t buf_len) const
+  {
+    int64_t pos = 0;
+    common::databuff_printf(buf, buf_len, pos, "total_size=%ld shard_cnt=%ld ", size(), shard_cnt_);
+    for(int i = 0; i < PRIO_CNT; i++) {
+      common::databuff_printf(buf, buf_len, pos, "queue[%d]=%ld ", i, queue_size(i));
+    }
+    return pos;
+  }
+
+  int push(ObLink* data, int priority)
+  {
+    return push(data, priority, icpu_id());
+  }
+
+  // push into the shard of hint, or its siblings if the shard is full
+  int push(ObLink* data, int priority, int64_t hint)
+  {
+    int ret = OB_SIZE_OVERFLOW;
+    if (OB_UNLIKELY(NULL == data) || OB_UNLIKELY(priority < 0) || OB_UNLIKELY(priority >= PRIO_CNT)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "push error, invalid argument", KP(data), K(priority));
+    } else {
+      const int64_t shard_cnt = shard_cnt_;
+      const int64_t home = (hint & INT64_MAX) % shard_cnt;
+      for (int64_t i = 0; OB_SIZE_OVERFLOW == ret && i < shard_cnt; i++) {
+        Shard &shard = shards_[(home + i) % shard_cnt];
+        if (ATOMIC_FAA(&shard.size_, 1) >= shard.limit_) {
+          (void)ATOMIC_FAA(&shard.size_, -1);
+        } else if (OB_FAIL(shard.queue_[priority].push(data))) {
+          (void)ATOMIC_FAA(&shard.size_, -1);
+        } else if (priority < HIGH_HIGH_PRIOS) {
+          cond_.signal(1, 0);
+        } else if (priority < HIGH_PRIOS + HIGH_HIGH_PRIOS) {
+          cond_.signal(1, 1);
+        } else {
+          cond_.signal(1, 2);
+        }
+      }
+    }
+    return ret;
+  }
+
+  int pop(ObLink*& data, int64_t timeout_us, int64_t home = 0)
+  {
+    return do_pop(data, PRIO_CNT, timeout_us, home);
+  }
+
+  int pop_high(ObLink*& data, int64_t timeout_us, int64_t home = 0)
+  {
+    return do_pop(data, HIGH_HIGH_PRIOS + HIGH_PRIOS, timeout_us, home);
+  }
+
+  int pop_high_high(ObLink*& data, int64_t timeout_us, int64_t home = 0)
+  {
+    return do_pop(data, HIGH_HIGH_PRIOS, timeout_us, home);
+  }
+
+private:
+  struct Shard
+  {
+    Shard() : queue_(), size_(0), limit_(INT64_MAX) {}
+    ObLinkQueue queue_[PRIO_CNT];
+    int64_t size_ CACHE_ALIGNED;
+    int64_t limit_;
+  } CACHE_ALIGNED;
+
+  inline int do_pop(ObLink*& data, int64_t plimit, int64_t timeout_us, int64_t home)
+  {
+    int ret = OB_ENTRY_NOT_EXIST;
+    if (OB_UNLIKELY(timeout_us < 0)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(ERROR, "timeout is invalid", K(ret), K(timeout_us));
+    } else {
+      if (plimit <= HIGH_HIGH_PRIOS) {
+        cond_.prepare(0);
+      } else if (plimit <= HIGH_PRIOS + HIGH_HIGH_PRIOS) {
+        cond_.prepare(1);
+      } else {
+        cond_.prepare(2);
+      }
+      const int64_t shard_cnt = shard_cnt_;
+      home = (home & INT64_MAX) % shard_cnt;
+      // only scan the shards which are not empty, taken after cond_.prepare
+      // so that a task pushed later wakes up the wait below
+      uint64_t non_empty = 0;
+      for (int64_t j = 0; j < shard_cnt; j++) {
+        if (ATOMIC_LOAD(&shards_[(home + j) % shard_cnt].size_) > 0) {
+          non_empty |= (1UL << j);
+        }
+      }
+      for(int i = 0; OB_ENTRY_NOT_EXIST == ret && 0 != non_empty && i < plimit; i++) {
+        // home shard first, then steal from siblings
+        for (int64_t j = 0; OB_ENTRY_NOT_EXIST == ret && j < shard_cnt; j++) {
+          Shard &shard = shards_[(home + j) % shard_cnt];
+          if (0 == (non_empty & (1UL << j))) {
+            // skip empty shard
+          } else if (OB_SUCCESS == shard.queue_[i].pop(data)) {
+            (void)ATOMIC_FAA(&shard.size_, -1);
+            ret = OB_SUCCESS;
+          }
+        }
+      }
+      if (OB_FAIL(ret)) {
+        cond_.wait(timeout_us);
+        data = NULL;
+      }
+    }
+    return ret;
+  }
+
+  SCondTemp<3> cond_;
+  Shard default_shard_;
+  Shard *shards_;
+  int64_t shard_cnt_;
+  int64_t limit_;
+  DISALLOW_COPY_AND_ASSIGN(ObShardedPriorityQueue2);
+};
 } // end namespace common
 } // end namespace oceanbase
 
@@ -470,16 +470,18 @@ int ObDiagnoseSessionInfo::notify_wait_end(ObDiagnoseTenantInfo *tenant_info, co
         total_wait_->time_waited_ += event_desc->wait_time_;
         ++total_wait_->total_waits_;
       }
+      // only the statistics of sampled requests are counted and scaled, see ObDiagnoseInfoSampleGuard
+      const int64_t scale = lib::get_diagnose_info_sample_scale();
       ObWaitEventStat *event_stat = event_stats_.get(event_desc->event_no_);
       ObWaitEventStat *tenant_event_stat = tenant_info->get_event_stats().get(event_desc->event_no_);
-      if (NULL != event_stat && NULL != tenant_event_stat) {
-        event_stat->total_waits_++;
-        tenant_event_stat->total_waits_++;
-        event_stat->time_waited_ += event_desc->wait_time_;
-        tenant_event_stat->time_waited_ += event_desc->wait_time_;
+      if (scale > 0 && NULL != event_stat && NULL != tenant_event_stat) {
+        event_stat->total_waits_ += scale;
+        tenant_event_stat->total_waits_ += scale;
+        event_stat->time_waited_ += event_desc->wait_time_ * scale;
+        tenant_event_stat->time_waited_ += event_desc->wait_time_ * scale;
         if (event_desc->timeout_ms_ > 0 && event_desc->wait_time_ > static_cast<int64_t>(event_desc->timeout_ms_) * 1000) {
-          event_stat->total_timeouts_++;
-          tenant_event_stat->total_timeouts_++;
+          event_stat->total_timeouts_ += scale;
+          tenant_event_stat->total_timeouts_ += scale;
         }
         if (event_desc->wait_time_ > static_cast<int64_t>(event_stat->max_wait_)) {
           event_stat->max_wait_ = event_desc->wait_time_;
@@ -707,13 +709,15 @@ ObWaitEventGuard::~ObWaitEventGuard()
     ObDiagnoseTenantInfo *tenant_di = ObDiagnoseTenantInfo::get_local_diagnose_info();
     if (NULL != di_ && NULL != tenant_di) {
       di_->notify_wait_end(tenant_di, is_atomic_);
-    } else if (NULL == di_ && NULL != tenant_di && 0 != wait_begin_time_) {
+    } else if (NULL == di_ && NULL != tenant_di && 0 != wait_begin_time_
+               && lib::get_diagnose_info_sample_scale() > 0) {
+      const int64_t scale = lib::get_diagnose_info_sample_scale();
       ObWaitEventStat *tenant_event_stat = tenant_di->get_event_stats().get(event_no_);
-      tenant_event_stat->total_waits_++;
+      tenant_event_stat->total_waits_ += scale;
       wait_time = ObTimeUtility::current_time() - wait_begin_time_;
-      tenant_event_stat->time_waited_ += wait_time;
+      tenant_event_stat->time_waited_ += wait_time * scale;
       if (timeout_ms_ > 0 && wait_time > static_cast<int64_t>(timeout_ms_) * 1000) {
-        tenant_event_stat->total_timeouts_++;
+        tenant_event_stat->total_timeouts_ += scale;
       }
       if (wait_time > static_cast<int64_t>(tenant_event_stat->max_wait_)) {
         tenant_event_stat->max_wait_ = wait_time;
@@ -795,5 +799,26 @@ ObTotalWaitGuard::~ObTotalWaitGuard()
   }
 }
 
+ObDiagnoseInfoSampleGuard::ObDiagnoseInfoSampleGuard()
+  : prev_scale_(lib::get_diagnose_info_sample_scale())
+{
+  const int64_t sample_percentage = lib::ObLibConfig::get_instance().get_diagnose_info_sample_percentage();
+  int64_t scale = 1;
+  if (OB_LIKELY(sample_percentage >= 100 || sample_percentage <= 0)) {
+    // all requests are sampled
+  } else {
+    // sample one of every N requests processed by this thread
+    thread_local int64_t request_seq = 0;
+    const int64_t n = (100 + sample_percentage / 2) / sample_percentage;
+    scale = (0 == (request_seq++ % n)) ? n : 0;
+  }
+  lib::get_diagnose_info_sample_scale() = scale;
+}
+
+ObDiagnoseInfoSampleGuard::~ObDiagnoseInfoSampleGuard()
+{
+  lib::get_diagnose_info_sample_scale() = prev_scale_;
+}
+
 } /* namespace common */
 } /* namespace oceanbase */
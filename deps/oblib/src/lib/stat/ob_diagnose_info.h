@@ -207,6 +207,18 @@ private:
   bool need_record_;
 };
 
+// Decide whether the wait events of the request are counted into the session and tenant
+// wait event statistics, by _perf_event_sample_percentage. The per-request wait info
+// (max/total wait, current wait) is always recorded, see lib::get_diagnose_info_sample_scale.
+class ObDiagnoseInfoSampleGuard
+{
+public:
+  ObDiagnoseInfoSampleGuard();
+  ~ObDiagnoseInfoSampleGuard();
+private:
+  int64_t prev_scale_;
+};
+
 } /* namespace common */
 } /* namespace oceanbase */
 
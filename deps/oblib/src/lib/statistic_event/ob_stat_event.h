@@ -33,6 +33,12 @@ STAT_EVENT_ADD_DEF(RPC_STREAM_COMPRESS_ORIGINAL_PACKET_CNT, "rpc stream compress
 STAT_EVENT_ADD_DEF(RPC_STREAM_COMPRESS_COMPRESSED_PACKET_CNT, "rpc stream compress compressed packet cnt", ObStatClassIds::NETWORK, "rpc stream compress compressed pacekt cnt", 10017, true, true)
 STAT_EVENT_ADD_DEF(RPC_STREAM_COMPRESS_ORIGINAL_SIZE, "rpc stream compress original size", ObStatClassIds::NETWORK, "rpc stream compress original size", 10018, true, true)
 STAT_EVENT_ADD_DEF(RPC_STREAM_COMPRESS_COMPRESSED_SIZE, "rpc stream compress compressed size", ObStatClassIds::NETWORK, "rpc stream compress compressed size", 10019, true, true)
+STAT_EVENT_ADD_DEF(MYSQL_RESPONSE_WRITE_COUNT, "mysql response write count", ObStatClassIds::NETWORK, "mysql response write count", 10020, true, true)
+STAT_EVENT_ADD_DEF(MYSQL_RESPONSE_COUNT, "mysql response count", ObStatClassIds::NETWORK, "mysql response count", 10021, true, true)
+STAT_EVENT_ADD_DEF(RPC_BATCH_FRAME_COUNT, "rpc batch frame count", ObStatClassIds::NETWORK, "rpc batch frame count", 10022, true, true)
+STAT_EVENT_ADD_DEF(RPC_BATCH_REQ_COUNT, "rpc batch request count", ObStatClassIds::NETWORK, "rpc batch request count", 10023, true, true)
+STAT_EVENT_ADD_DEF(RPC_SG_PACKET_OUT, "rpc scatter-gather packet out", ObStatClassIds::NETWORK, "rpc scatter-gather packet out", 10024, true, true)
+STAT_EVENT_ADD_DEF(RPC_SG_BYTES_OUT, "rpc scatter-gather bytes out", ObStatClassIds::NETWORK, "rpc scatter-gather bytes out", 10025, true, true)
 
 // QUEUE
 // STAT_EVENT_ADD_DEF(REQUEST_QUEUED_COUNT, "REQUEST_QUEUED_COUNT", QUEUE, "REQUEST_QUEUED_COUNT")
@@ -121,6 +127,12 @@ STAT_EVENT_ADD_DEF(HA_GTS_CACHE_MISS_COUNT, "ha gts cache miss count", ObStatCla
 STAT_EVENT_ADD_DEF(TRANS_ELR_ENABLE_COUNT, "trans early lock release enable count", ObStatClassIds::TRANS, "trans early lock releaes enable count", 30077, true, true)
 STAT_EVENT_ADD_DEF(TRANS_ELR_UNABLE_COUNT, "trans early lock release unable count", ObStatClassIds::TRANS, "trans early lock releaes unable count", 30078, true, true)
 STAT_EVENT_ADD_DEF(READ_ELR_ROW_COUNT, "read elr row count", ObStatClassIds::TRANS, "read elr row count", 30079, true, true)
+STAT_EVENT_ADD_DEF(GTS_RPC_COALESCED_COUNT, "gts rpc coalesced count", ObStatClassIds::TRANS, "gts rpc coalesced count", 30080, true, true)
+STAT_EVENT_ADD_DEF(GTS_RPC_TOTAL_TIME, "gts rpc total time", ObStatClassIds::TRANS, "gts rpc total time", 30081, true, true)
+STAT_EVENT_ADD_DEF(ELR_COMMIT_DEPENDENCY_COUNT, "elr commit dependency count", ObStatClassIds::TRANS, "elr commit dependency count", 30082, true, true)
+STAT_EVENT_ADD_DEF(ELR_COMMIT_DEPENDENCY_WAIT_COUNT, "elr commit dependency wait count", ObStatClassIds::TRANS, "elr commit dependency wait count", 30083, true, true)
+STAT_EVENT_ADD_DEF(TX_REPLAY_PARALLEL_REDO_COUNT, "tx replay parallel redo count", ObStatClassIds::TRANS, "tx replay parallel redo count", 30084, true, true)
+STAT_EVENT_ADD_DEF(TX_REPLAY_PARALLEL_REDO_TIME, "tx replay parallel redo time", ObStatClassIds::TRANS, "tx replay parallel redo time", 30085, true, true)
 
 // SQL
 //STAT_EVENT_ADD_DEF(PLAN_CACHE_HIT, "PLAN_CACHE_HIT", SQL, "PLAN_CACHE_HIT")
@@ -229,6 +241,8 @@ STAT_EVENT_ADD_DEF(TMP_BLOCK_CACHE_HIT, "tmp block cache hit", ObStatClassIds::C
 STAT_EVENT_ADD_DEF(TMP_BLOCK_CACHE_MISS, "tmp block cache miss", ObStatClassIds::CACHE, "tmp block cache miss", 50052, true, true)
 STAT_EVENT_ADD_DEF(SECONDARY_META_CACHE_HIT, "secondary meta cache hit", ObStatClassIds::CACHE, "secondary meta cache hit", 50053, true, true)
 STAT_EVENT_ADD_DEF(SECONDARY_META_CACHE_MISS, "secondary meta cache miss", ObStatClassIds::CACHE, "secondary meta cache miss", 50054, true, true)
+STAT_EVENT_ADD_DEF(LOG_CACHE_HIT, "log cache hit", ObStatClassIds::CACHE, "log cache hit", 50055, true, true)
+STAT_EVENT_ADD_DEF(LOG_CACHE_MISS, "log cache miss", ObStatClassIds::CACHE, "log cache miss", 50056, true, true)
 
 
 // STORAGE
@@ -332,6 +346,10 @@ STAT_EVENT_ADD_DEF(INDEX_BLOCK_CACHE_HIT, "index micro block cache hit", ObStatC
 STAT_EVENT_ADD_DEF(BLOCKSCAN_BLOCK_CNT, "blockscaned data micro block count", ObStatClassIds::STORAGE, "blockscaned data micro block count", 60088, true, true)
 STAT_EVENT_ADD_DEF(BLOCKSCAN_ROW_CNT, "blockscaned row count", ObStatClassIds::STORAGE, "blockscaned row count", 60089, true, true)
 STAT_EVENT_ADD_DEF(PUSHDOWN_STORAGE_FILTER_ROW_CNT, "storage filtered row count", ObStatClassIds::STORAGE, "storage filter row count", 60090, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_WRITE_LOCK_HANDOFF_COUNT, "memstore write lock handoff count in lock_wait_mgr", ObStatClassIds::STORAGE, "memstore write lock handoff count in lock_wait_mgr", 60091, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_ROW_COMPRESS_COUNT, "memstore row compress count", ObStatClassIds::STORAGE, "memstore row compress count", 60092, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_ROW_COMPRESS_SAVED_BYTES, "memstore row compress saved bytes", ObStatClassIds::STORAGE, "memstore row compress saved bytes", 60093, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_ROW_DECOMPRESS_COUNT, "memstore row decompress count", ObStatClassIds::STORAGE, "memstore row decompress count", 60094, true, true)
 
 // backup & restore
 STAT_EVENT_ADD_DEF(BACKUP_IO_READ_COUNT, "backup io read count", ObStatClassIds::STORAGE, "backup io read count", 69000, true, true)
@@ -437,6 +455,12 @@ STAT_EVENT_ADD_DEF(CLOG_FILE_TOTAL_SIZE, "clog file total size", ObStatClassIds:
 STAT_EVENT_ADD_DEF(ILOG_FILE_TOTAL_SIZE, "ilog file total size", ObStatClassIds::CLOG, "ilog file total size", 80062, true, true)
 STAT_EVENT_ADD_DEF(CLOG_BATCH_SUBMITTED_COUNT, "clog batch submitted count", ObStatClassIds::CLOG, "clog batch submitted count", 80063, true, true)
 STAT_EVENT_ADD_DEF(CLOG_BATCH_COMMITTED_COUNT, "clog batch committed count", ObStatClassIds::CLOG, "clog batch committed count", 80064, true, true)
+STAT_EVENT_ADD_DEF(CLOG_COMPRESS_COUNT, "clog compress count", ObStatClassIds::CLOG, "clog compress count", 80065, true, true)
+STAT_EVENT_ADD_DEF(CLOG_COMPRESS_SAVED_SIZE, "clog compress saved size", ObStatClassIds::CLOG, "clog compress saved size", 80066, true, true)
+STAT_EVENT_ADD_DEF(CLOG_DECOMPRESS_COUNT, "clog decompress count", ObStatClassIds::CLOG, "clog decompress count", 80067, true, true)
+STAT_EVENT_ADD_DEF(CLOG_FETCH_LOG_STREAM_TASK_COUNT, "clog fetch log stream task count", ObStatClassIds::CLOG, "clog fetch log stream task count", 80068, true, true)
+STAT_EVENT_ADD_DEF(CLOG_FETCH_LOG_STREAM_OUTSTANDING_SIZE, "clog fetch log stream outstanding size", ObStatClassIds::CLOG, "clog fetch log stream outstanding size", 80069, true, true)
+STAT_EVENT_ADD_DEF(CLOG_FETCH_LOG_STREAM_WAIT_ACK_COUNT, "clog fetch log stream wait ack count", ObStatClassIds::CLOG, "clog fetch log stream wait ack count", 80070, true, true)
 
 // CLOG.EXTLOG 81001 ~ 90000
 STAT_EVENT_ADD_DEF(CLOG_EXTLOG_FETCH_LOG_SIZE, "external log service fetch log size", ObStatClassIds::CLOG, "external log service fetch log size", 81001, true, true)
@@ -444,6 +468,8 @@ STAT_EVENT_ADD_DEF(CLOG_EXTLOG_FETCH_LOG_COUNT, "external log service fetch log
 STAT_EVENT_ADD_DEF(CLOG_EXTLOG_FETCH_RPC_COUNT, "external log service fetch rpc count", ObStatClassIds::CLOG, "external log service fetch rpc count", 81003, true, true)
 STAT_EVENT_ADD_DEF(CLOG_EXTLOG_HEARTBEAT_RPC_COUNT, "external log service heartbeat rpc count", ObStatClassIds::CLOG, "external log service heartbeat rpc count", 81004, true, true)
 STAT_EVENT_ADD_DEF(CLOG_EXTLOG_HEARTBEAT_PARTITION_COUNT, "external log service heartbeat partition count", ObStatClassIds::CLOG, "external log service heartbeat partition count", 81005, true, true)
+STAT_EVENT_ADD_DEF(CLOG_EXTLOG_SUBSCRIBE_RPC_COUNT, "external log service subscribe rpc count", ObStatClassIds::CLOG, "external log service subscribe rpc count", 81006, true, true)
+STAT_EVENT_ADD_DEF(CLOG_EXTLOG_SUBSCRIBE_NOTIFY_COUNT, "external log service subscribe notify count", ObStatClassIds::CLOG, "external log service subscribe notify count", 81007, true, true)
 
 //CLOG.REPLAY
 STAT_EVENT_ADD_DEF(CLOG_SUCC_REPLAY_TRANS_LOG_COUNT, "replay engine success replay transaction log count", ObStatClassIds::CLOG, "replay engine success replay transaction log count", 82001, true, true)
@@ -599,7 +599,10 @@ int on_close(easy_connection_t *c)
 int cleanup(easy_request_t *r, void *apacket)
 {
   int eret = EASY_ERROR;
-  if (OB_ISNULL(r) || OB_ISNULL(r->ms)) {
+  if (OB_ISNULL(r) && OB_NOT_NULL(apacket)) {
+    // response of a client session which has been destroyed, nothing to clean
+    eret = EASY_OK;
+  } else if (OB_ISNULL(r) || OB_ISNULL(r->ms)) {
     LOG_ERROR("invalid argument", K(r), K(apacket));
   } else {
     int64_t start_time = common::ObTimeUtility::current_time();
@@ -23,6 +23,7 @@
 #include "lib/worker.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
 #include "rpc/obrpc/ob_rpc_stat.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 #include "rpc/obrpc/ob_net_keepalive.h"
 #include "rpc/frame/ob_net_easy.h"
 
@@ -48,6 +49,7 @@ int async_cb(easy_request_t *r)
   int64_t after_decode_time = 0;
   int64_t after_process_time = 0;
   ObRpcPacketCode pcode = OB_INVALID_RPC_CODE;
+  ObRpcSGPayload *sg_payload = NULL;
   if (OB_ISNULL(r) || OB_ISNULL(r->ms)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_ERROR("invalid argument", K(r),K(ret));
@@ -55,6 +57,7 @@ int async_cb(easy_request_t *r)
     typedef ObReqTransport::AsyncCB ACB;
     ACB *cb = reinterpret_cast<ACB*>(r->user_data);
     cb->record_stat(r->ipacket == NULL);
+    sg_payload = cb->get_sg_payload();
 
     if (!r->ipacket) {
       // 1. destination doesn't response
@@ -117,6 +120,8 @@ int async_cb(easy_request_t *r)
   } else {
     LOG_ERROR("receive NULL request or message", K(r));
   }
+  // easy has written out or copied the request data by now
+  ObRpcSGPayload::destroy(sg_payload);
 
   if (!OB_SUCC(ret)) {
     LOG_DEBUG("process async request fail", K(r), K(ret));
@@ -92,7 +92,7 @@ public:
   public:
     AsyncCB(int pcode)
         : dst_(), timeout_(0), tenant_id_(0),
-          err_(0), pcode_(pcode), send_ts_(0), payload_(0)
+          err_(0), pcode_(pcode), send_ts_(0), payload_(0), sg_payload_(NULL)
     {}
     virtual ~AsyncCB() {}
 
@@ -121,6 +121,9 @@ public:
     int64_t get_send_ts() { return send_ts_; }
     void set_payload(const int64_t payload) { payload_ = payload; }
     int64_t get_payload() { return payload_; }
+    // segments referenced by the request, released after the session is destroyed
+    void set_sg_payload(obrpc::ObRpcSGPayload *sg_payload) { sg_payload_ = sg_payload; }
+    obrpc::ObRpcSGPayload *get_sg_payload() { return sg_payload_; }
 
   private:
     static const int64_t REQUEST_ITEM_COST_RT = 100 * 1000; // 100ms
@@ -132,6 +135,7 @@ public:
     int pcode_;
     int64_t send_ts_;
     int64_t payload_;
+    obrpc::ObRpcSGPayload *sg_payload_;
   };
 
   class Request {
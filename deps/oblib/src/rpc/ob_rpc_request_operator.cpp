@@ -13,6 +13,7 @@
 #include "rpc/ob_rpc_request_operator.h"
 #include "rpc/obrpc/ob_easy_rpc_request_operator.h"
 #include "rpc/obrpc/ob_poc_rpc_request_operator.h"
+#include "rpc/obrpc/ob_rpc_batch_request_operator.h"
 #include "rpc/obrpc/ob_rpc_opts.h"
 
 namespace oceanbase
@@ -22,6 +23,7 @@ namespace rpc
 {
 ObEasyRpcRequestOperator global_easy_req_operator;
 ObPocRpcRequestOperator global_poc_req_operator;
+ObRpcBatchRequestOperator global_batch_req_operator;
 ObIRpcRequestOperator& ObRpcRequestOperator::get_operator(const ObRequest* req)
 {
   ObIRpcRequestOperator* op = NULL;
@@ -29,6 +31,9 @@ ObIRpcRequestOperator& ObRpcRequestOperator::get_operator(const ObRequest* req)
     case ObRequest::TRANSPORT_PROTO_POC:
       op = &global_poc_req_operator;
       break;
+    case ObRequest::TRANSPORT_PROTO_BATCH:
+      op = &global_batch_req_operator;
+      break;
     default:
       op = &global_easy_req_operator;
   }
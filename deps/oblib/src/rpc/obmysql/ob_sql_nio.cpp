@@ -12,6 +12,7 @@
 
 #define USING_LOG_PREFIX RPC_OBMYSQL
 #include "rpc/obmysql/ob_sql_nio.h"
+#include "rpc/obmysql/ob_sql_nio_uring.h"
 #include "rpc/obmysql/ob_sql_sock_session.h"
 #include "rpc/obmysql/ob_i_sql_sock_handler.h"
 #include "rpc/obmysql/ob_sql_sock_session.h"
@@ -23,6 +24,7 @@
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/profile/ob_trace_id.h"
 #include <sys/epoll.h>
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/eventfd.h>
@@ -127,22 +129,79 @@ private:
   int32_t ready_ CACHE_ALIGNED;
 };
 
+// data received by io_uring in sql nio thread, and copied into ReadBuffer by the handling thread
+struct RecvChunk: public ObLink
+{
+  RecvChunk(int64_t sz): sz_(sz), pos_(0) {}
+  ~RecvChunk() {}
+  int64_t sz_;
+  int64_t pos_;
+  char data_[0];
+};
+
 class ReadBuffer
 {
 public:
   enum { IO_BUFFER_SIZE = 1<<16 };
-  ReadBuffer(int fd): fd_(fd), has_EAGAIN_(false), request_more_data_(false),
+  // recv is paused when received but not consumed chunks reach the limits,
+  // and resumed when they drop below half of the limits
+  enum {
+    MAX_RECV_CHUNK_BYTES = 1<<21,
+    MAX_RECV_CHUNK_CNT = 1024,
+  };
+  ReadBuffer(int fd): fd_(fd), has_EAGAIN_(false), request_more_data_(false), recv_chunk_mode_(false),
                 alloc_buf_(NULL), buf_end_(NULL), cur_buf_(NULL), data_end_(NULL),
-                consume_sz_(0)
+                consume_sz_(0), cur_chunk_(NULL), recv_chunk_bytes_(0), recv_chunk_cnt_(0),
+                recv_paused_(false)
   {}
   ~ReadBuffer() 
   {
     if (NULL != alloc_buf_) {
       direct_free(alloc_buf_);
     }
+    if (NULL != cur_chunk_) {
+      free_chunk(cur_chunk_);
+    }
+    RecvChunk* chunk = NULL;
+    while(NULL != (chunk = (RecvChunk*)recv_chunks_.pop())) {
+      free_chunk(chunk);
+    }
   }
   int64_t get_remain_sz() const { return remain(); }
+  // data of next request has been received, but not consumed
+  bool has_buffered_data() const { return remain() > 0 || NULL != cur_chunk_ || !recv_chunks_.empty(); }
   void set_fd(int fd) { fd_ = fd; }
+  // data is received by sql nio thread and pushed by push_recv_chunk(), instead of read from fd
+  void set_recv_chunk_mode() { recv_chunk_mode_ = true; }
+  int push_recv_chunk(const char* data, int64_t sz) {
+    int ret = OB_SUCCESS;
+    RecvChunk* chunk = NULL;
+    if (NULL == (chunk = (RecvChunk*)direct_alloc(sizeof(RecvChunk) + sz))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc recv chunk fail", K(ret), K_(fd), K(sz));
+    } else {
+      new(chunk)RecvChunk(sz);
+      memcpy(chunk->data_, data, sz);
+      ATOMIC_AAF(&recv_chunk_bytes_, sz);
+      ATOMIC_AAF(&recv_chunk_cnt_, 1);
+      recv_chunks_.push(chunk);
+    }
+    return ret;
+  }
+  bool is_recv_chunk_full() const {
+    return ATOMIC_LOAD(&recv_chunk_bytes_) >= MAX_RECV_CHUNK_BYTES
+        || ATOMIC_LOAD(&recv_chunk_cnt_) >= MAX_RECV_CHUNK_CNT;
+  }
+  bool is_recv_chunk_low() const {
+    return ATOMIC_LOAD(&recv_chunk_bytes_) < MAX_RECV_CHUNK_BYTES / 2
+        && ATOMIC_LOAD(&recv_chunk_cnt_) < MAX_RECV_CHUNK_CNT / 2;
+  }
+  // set by sql nio thread when recv is not armed again because of full chunks
+  void set_recv_paused() { ATOMIC_STORE(&recv_paused_, true); }
+  // return true if the caller should arm recv again
+  bool try_resume_recv() {
+    return ATOMIC_LOAD(&recv_paused_) && is_recv_chunk_low() && ATOMIC_BCAS(&recv_paused_, true, false);
+  }
   int peek_data(int64_t limit, const char*& buf, int64_t& sz) {
     int ret = OB_SUCCESS;
     if (OB_FAIL(try_read_fd(limit))) {
@@ -185,6 +244,8 @@ private:
       
     } else if (cur_buf_ + limit > buf_end_ && OB_FAIL(switch_buffer(limit))) {
       LOG_ERROR("alloc read buffer fail", K_(fd), K(ret));
+    } else if (OB_UNLIKELY(recv_chunk_mode_)) {
+      do_read_chunk(limit);
     } else if (OB_FAIL(do_read_fd(limit))) {
       LOG_WARN("do_read_fd fail", K(ret), K_(fd), K(limit));
     }
@@ -240,6 +301,29 @@ private:
     }
     return ret;
   }
+  void do_read_chunk(int64_t sz) {
+    while(remain() < sz) {
+      if (NULL == cur_chunk_ && NULL == (cur_chunk_ = (RecvChunk*)recv_chunks_.pop())) {
+        has_EAGAIN_ = true;
+        break;
+      } else {
+        int64_t copy_sz = std::min(cur_chunk_->sz_ - cur_chunk_->pos_, (int64_t)(buf_end_ - data_end_));
+        memcpy(data_end_, cur_chunk_->data_ + cur_chunk_->pos_, copy_sz);
+        data_end_ += copy_sz;
+        cur_chunk_->pos_ += copy_sz;
+        if (cur_chunk_->pos_ >= cur_chunk_->sz_) {
+          ATOMIC_SAF(&recv_chunk_bytes_, cur_chunk_->sz_);
+          ATOMIC_SAF(&recv_chunk_cnt_, 1);
+          free_chunk(cur_chunk_);
+          cur_chunk_ = NULL;
+        }
+      }
+    }
+  }
+  static void free_chunk(RecvChunk* chunk) {
+    chunk->~RecvChunk();
+    direct_free(chunk);
+  }
   void* alloc_io_buffer(int64_t sz) { return direct_alloc(sz); }
   void free_io_buffer(void* p) { direct_free(p); }
   static void* direct_alloc(int64_t sz) { return ob_malloc(sz, ObModIds::OB_COMMON_NETWORK); }
@@ -248,11 +332,17 @@ private:
   int fd_;
   bool has_EAGAIN_;
   bool request_more_data_;
+  bool recv_chunk_mode_;
   char* alloc_buf_;
   char* buf_end_;
   char* cur_buf_;
   char* data_end_;
   uint64_t consume_sz_;
+  RecvChunk* cur_chunk_;
+  ObSpScLinkQueue recv_chunks_;
+  int64_t recv_chunk_bytes_;
+  int64_t recv_chunk_cnt_;
+  bool recv_paused_;
 };
 
 class ObSqlNioImpl;
@@ -269,6 +359,20 @@ public:
     buf_ = buf;
     sz_ = sz;
   }
+  bool get(const char*& buf, int64_t& sz) const {
+    buf = buf_;
+    sz = sz_;
+    return NULL != buf_;
+  }
+  void consume(int64_t wbytes, bool& become_clean) {
+    if (wbytes >= sz_) {
+      become_clean = true;
+      reset();
+    } else {
+      buf_ += wbytes;
+      sz_ -= wbytes;
+    }
+  }
   int try_write(int fd, bool& become_clean) {
     int ret = OB_SUCCESS;
     int64_t wbytes = 0;
@@ -276,12 +380,8 @@ public:
       // no pending task
     } else if (OB_FAIL(do_write(fd, buf_, sz_, wbytes))) {
       LOG_WARN("do_write fail", K(ret));
-    } else if (wbytes >= sz_) {
-      become_clean = true;
-      reset();
     } else {
-      buf_ += wbytes;
-      sz_ -= wbytes;
+      consume(wbytes, become_clean);
     }
     return ret;
   }
@@ -317,11 +417,13 @@ class ObSqlSock: public ObLink
 public:
   ObSqlSock(ObSqlNioImpl& nio, int fd): nio_impl_(nio), fd_(fd), err_(0), read_buffer_(fd), 
             need_epoll_trigger_write_(false), may_handling_(true), handler_close_flag_(false),
-            need_shutdown_(false), last_decode_time_(0), last_write_time_(0), sql_session_info_(NULL) {
+            need_shutdown_(false), last_decode_time_(0), last_write_time_(0), sql_session_info_(NULL),
+            uring_ref_(0), uring_cancel_pending_(false), recv_canceling_(false) {
     memset(sess_, 0, sizeof(sess_));
   }
   ~ObSqlSock() {}
   int64_t get_remain_sz() const { return read_buffer_.get_remain_sz(); }
+  bool has_buffered_data() const { return read_buffer_.has_buffered_data(); }
   TO_STRING_KV(KP(this), K_(fd), K_(err), K(last_decode_time_), K(last_write_time_),
               K(read_buffer_.get_consume_sz()), K(get_pending_flag()), KPC(get_trace_id()));
   ObSqlNioImpl& get_nio_impl() { return nio_impl_; }
@@ -347,6 +449,29 @@ public:
   }
 
   bool is_need_epoll_trigger_write() const { return need_epoll_trigger_write_; }
+  void set_need_epoll_trigger_write() { need_epoll_trigger_write_ = true; }
+  bool get_pending_write(const char*& buf, int64_t& sz) const { return pending_write_task_.get(buf, sz); }
+  void consume_pending_write(int64_t sz, bool& become_clean) {
+    pending_write_task_.consume(sz, become_clean);
+    if (become_clean) {
+      last_write_time_ = ObTimeUtility::current_time();
+      need_epoll_trigger_write_ = false;
+    }
+  }
+  void set_recv_chunk_mode() { read_buffer_.set_recv_chunk_mode(); }
+  int push_recv_chunk(const char* data, int64_t sz) { return read_buffer_.push_recv_chunk(data, sz); }
+  bool is_recv_chunk_full() const { return read_buffer_.is_recv_chunk_full(); }
+  bool is_recv_chunk_low() const { return read_buffer_.is_recv_chunk_low(); }
+  void set_recv_paused() { read_buffer_.set_recv_paused(); }
+  bool try_resume_recv() { return read_buffer_.try_resume_recv(); }
+  // io_uring requests in flight, only accessed by sql nio thread
+  void inc_uring_ref() { uring_ref_++; }
+  void dec_uring_ref() { uring_ref_--; }
+  int64_t get_uring_ref() const { return uring_ref_; }
+  void set_uring_cancel_pending(bool pending) { uring_cancel_pending_ = pending; }
+  bool is_uring_cancel_pending() const { return uring_cancel_pending_; }
+  void set_recv_canceling(bool canceling) { recv_canceling_ = canceling; }
+  bool is_recv_canceling() const { return recv_canceling_; }
   int do_pending_write(bool& become_clean) {
     int ret = OB_SUCCESS;
     if (OB_FAIL(pending_write_task_.try_write(fd_, become_clean))) {
@@ -419,6 +544,7 @@ public:
   ObDLink dlink_;
   ObDLink all_list_link_;
   ObLink write_task_link_;
+  ObLink resume_recv_link_;
 private:
   ObSqlNioImpl& nio_impl_;
   int fd_;
@@ -434,6 +560,9 @@ private:
   int64_t last_decode_time_;
   int64_t last_write_time_;
   void* sql_session_info_;
+  int64_t uring_ref_;
+  bool uring_cancel_pending_;
+  bool recv_canceling_;
 public:
   char sess_[3000] __attribute__((aligned(16)));
 };
@@ -523,17 +652,23 @@ public:
       evfd_ = -1;
     }
   }
-  int create(int epfd) {
+  int create() {
     int ret = OB_SUCCESS;
-    uint32_t eflag = EPOLLIN | EPOLLERR | EPOLLET | EPOLLRDHUP;
     if ((evfd_ = eventfd(0, EFD_NONBLOCK)) < 0) {
       ret = OB_IO_ERROR;
       LOG_WARN("eventfd create fail", K(errno));
-    } else if (0 != epoll_regist(epfd, evfd_, eflag, this)) {
+    }
+    return ret;
+  }
+  int regist(int epfd) {
+    int ret = OB_SUCCESS;
+    uint32_t eflag = EPOLLIN | EPOLLERR | EPOLLET | EPOLLRDHUP;
+    if (0 != epoll_regist(epfd, evfd_, eflag, this)) {
       ret = OB_IO_ERROR;
     }
     return ret;
   }
+  int get_fd() const { return evfd_; }
   void begin_epoll() { ATOMIC_STORE(&in_epoll_, 1); }
   void end_epoll() { ATOMIC_STORE(&in_epoll_, 0); }
   void signal() {
@@ -553,26 +688,53 @@ private:
   set_error() triggered by worker or by epoll.
   prepare_destroy() add sock to close_pending_list.
   handler.on_close() free user allocated resource.
+
+  with io_uring, accept and recv are multishot requests, received data is handed over
+  to the handling thread by RecvChunk, and pending writes of all socks are submitted
+  together with the wait of events, in one io_uring_enter().
+  a sock is freed after all its io_uring requests are completed or canceled, and its fd
+  is closed only then.
+  recv of a sock is paused when too much data is received but not consumed, and armed
+  again by resume_recv_queue_ after the handling thread consumes it.
  */
 class ObSqlNioImpl
 {
 public:
-  ObSqlNioImpl(ObISqlSockHandler& handler): handler_(handler), epfd_(-1), lfd_(-1) {}
+  enum {
+    URING_ENTRIES = 1024,
+    URING_BUF_CNT = 256,
+    URING_BUF_SIZE = 16 * 1024,
+  };
+  // low bits of io_uring user data, the rest is ObSqlSock*
+  enum {
+    URING_OP_ACCEPT = 1,
+    URING_OP_EVFD = 2,
+    URING_OP_RECV = 3,
+    URING_OP_POLL = 4,
+    URING_OP_SEND = 5,
+    URING_OP_CANCEL = 6,
+    URING_OP_MASK = 7
+  };
+  ObSqlNioImpl(ObISqlSockHandler& handler): handler_(handler), epfd_(-1), lfd_(-1), uring_(NULL) {}
   ~ObSqlNioImpl() {}
-  int init(int port) {
+  int init(int port, bool use_io_uring) {
     int ret = OB_SUCCESS;
     uint32_t epflag = EPOLLIN;
-    if ((epfd_ = epoll_create1(EPOLL_CLOEXEC)) < 0) {
-      ret = OB_IO_ERROR;
-      LOG_WARN("epoll_create fail", K(ret), K(errno));
-    } else if ((lfd_ = listen_create(port)) < 0) {
+    if ((lfd_ = listen_create(port)) < 0) {
       ret = OB_IO_ERROR;
       LOG_WARN("listen create fail", K(port), K(errno));
+    } else if (OB_FAIL(evfd_.create())) {
+      LOG_WARN("evfd create fail", K(ret));
+    } else if (use_io_uring && OB_SUCCESS == init_uring()) {
+      LOG_INFO("sql_nio listen succ with io_uring", K(port));
+    } else if ((epfd_ = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("epoll_create fail", K(ret), K(errno));
     } else if (0 != epoll_regist(epfd_, lfd_, epflag, NULL)) {
       ret = OB_IO_ERROR;
       LOG_WARN("regist listen fd fail", K(ret));
-    } else if (OB_FAIL(evfd_.create(epfd_))) {
-      LOG_WARN("evfd create fail", K(ret));
+    } else if (OB_FAIL(evfd_.regist(epfd_))) {
+      LOG_WARN("evfd regist fail", K(ret));
     } else {
       LOG_INFO("sql_nio listen succ", K(port));
     }
@@ -582,11 +744,18 @@ public:
     if (write_req_queue_.empty()) {
       evfd_.begin_epoll();
       if (write_req_queue_.empty()) {
-        handle_epoll_event();
+        if (NULL != uring_) {
+          handle_uring_event(1000 * 1000);
+        } else {
+          handle_epoll_event();
+        }
       }
       evfd_.end_epoll();
+    } else if (NULL != uring_) {
+      handle_uring_event(0);
     }
     handle_write_req_queue();
+    handle_resume_recv_queue();
     handle_close_req_queue();
     handle_pending_destroy_list();
     print_session_info();
@@ -603,6 +772,10 @@ public:
     write_req_queue_.push(&s->write_task_link_);
     evfd_.signal();
   }
+  void push_resume_recv_req(ObSqlSock* s) {
+    resume_recv_queue_.push(&s->resume_recv_link_);
+    evfd_.signal();
+  }
   void revert_sock(ObSqlSock* s) {
     if (OB_UNLIKELY(s->has_error())) {
       LOG_TRACE("revert_sock: sock has error", K(*s));
@@ -647,7 +820,11 @@ private:
   }
   void prepare_destroy(ObSqlSock* s) {
     LOG_WARN("prepare destroy", K(*s));
-    s->remove_fd_from_epoll(epfd_);
+    if (NULL != uring_) {
+      cancel_uring_req(s);
+    } else {
+      s->remove_fd_from_epoll(epfd_);
+    }
     s->on_disconnect();
     pending_destroy_list_.add(&s->dlink_);
   }
@@ -659,6 +836,9 @@ private:
       ObSqlSock* s = CONTAINER_OF(cur, ObSqlSock, dlink_);
       cur = cur->next_;
       bool need_destroy = false;
+      if (OB_UNLIKELY(s->is_uring_cancel_pending())) {
+        cancel_uring_req(s);
+      }
       if (false == s->handler_close_been_called()) {
         if (false == s->get_may_handling_flag()) {
           LOG_WARN("can close safely, do destroy", K(*s));
@@ -676,7 +856,7 @@ private:
           s->set_handler_close_been_called();
         }
       } else {
-        if (true == s->sql_session_info_is_null()) {
+        if (true == s->sql_session_info_is_null() && 0 == s->get_uring_ref()) {
           pending_destroy_list_.del(&s->dlink_);
           remove_session_info(s);
           s->do_close();
@@ -699,7 +879,7 @@ private:
       if (OB_UNLIKELY(0 == err && (EPOLLOUT & mask))) {
         s->set_writable();
         if (s->is_need_epoll_trigger_write()) {
-          err = do_pending_write(s);
+          err = NULL != uring_ ? prep_pending_send(s) : do_pending_write(s);
         }
       }
       if (OB_LIKELY(0 == err && (EPOLLIN & mask))) {
@@ -730,7 +910,7 @@ private:
       ObSqlSock* s = CONTAINER_OF(p, ObSqlSock, write_task_link_);
       if (s->has_error()) {
         revert_sock(s);
-      } else if (0 != do_pending_write(s)) {
+      } else if (0 != (NULL != uring_ ? prep_pending_send(s) : do_pending_write(s))) {
         revert_sock(s);
         if (s->set_error(EIO)) {
           prepare_destroy(s);
@@ -739,6 +919,18 @@ private:
     }
   }
 
+  void handle_resume_recv_queue() {
+    ObLink* p = NULL;
+    while((p = (ObLink*)resume_recv_queue_.pop())) {
+      ObSqlSock* s = CONTAINER_OF(p, ObSqlSock, resume_recv_link_);
+      if (s->has_error()) {
+        // sock is destroying
+      } else if (OB_SUCCESS != arm_recv(s)) {
+        handle_sock_event(s, EPOLLERR);
+      }
+    }
+  }
+
   void do_accept_loop() {
     while(1){
       int fd = -1;
@@ -750,14 +942,16 @@ private:
           break;
         }
       } else {
-        int err = 0;
-        if (0 != (err = do_accept_one(fd))) {
-          LOG_ERROR("do_accept_one fail", K(fd), K(err));
-          close(fd);
-        }
+        handle_accept_fd(fd);
       }
     }
   }
+  void handle_accept_fd(int fd) {
+    int err = 0;
+    if (0 != (err = do_accept_one(fd))) {
+      LOG_ERROR("do_accept_one fail", K(fd), K(err));
+    }
+  }
   int do_accept_one(int fd) {
     int err = 0;
     ObSqlSock* s = NULL;
@@ -765,6 +959,16 @@ private:
     if (NULL == (s = alloc_sql_sock(fd))) {
       err = -ENOMEM;
       LOG_WARN("alloc_sql_sock fail", K(fd), K(err));
+    } else if (NULL != uring_) {
+      s->set_recv_chunk_mode();
+      if (0 != (err = handler_.on_connect(s->sess_, fd))) {
+        LOG_WARN("on_connect fail", K(err));
+      } else if (OB_SUCCESS != arm_recv(s) || OB_SUCCESS != arm_poll(s)) {
+        err = -EIO;
+        LOG_WARN("arm io_uring request fail", K(fd), K(err));
+      } else {
+        LOG_INFO("accept one succ", K(*s));
+      }
     } else if (0 != (err = epoll_regist(epfd_, fd, epflag, s))) {
       LOG_WARN("epoll_regist fail", K(fd), K(err));
     } else if (0 != (err = handler_.on_connect(s->sess_, fd))) {
@@ -772,12 +976,254 @@ private:
     } else {
       LOG_INFO("accept one succ", K(*s));
     }
-    if (0 != err && NULL != s) {
+    if (0 == err) {
+    } else if (NULL == s) {
+      close(fd);
+    } else {
+      // fd is owned by sock, and closed after the armed io_uring requests are canceled
       ObSqlSockSession* sess = (ObSqlSockSession *)s->sess_;
       sess->destroy_sock();
     }
     return err;
   }
+private:
+  int init_uring() {
+    int ret = OB_SUCCESS;
+    ObSqlNioUring* uring = NULL;
+    if (NULL == (uring = (ObSqlNioUring*)direct_alloc(sizeof(ObSqlNioUring)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc io_uring fail", K(ret));
+    } else if (FALSE_IT(new(uring)ObSqlNioUring())) {
+    } else if (OB_FAIL(uring->init(URING_ENTRIES, URING_BUF_CNT, URING_BUF_SIZE))) {
+      LOG_WARN("io_uring init fail, use epoll instead", K(ret));
+    } else {
+      uring_ = uring;
+      if (OB_FAIL(arm_accept())) {
+        LOG_WARN("arm accept fail", K(ret));
+      } else if (OB_FAIL(arm_evfd())) {
+        LOG_WARN("arm evfd fail", K(ret));
+      } else if (OB_FAIL(uring_->submit_and_wait(0))) {
+        LOG_WARN("submit io_uring fail", K(ret));
+      }
+      if (OB_FAIL(ret)) {
+        uring_ = NULL;
+      }
+    }
+    if (OB_FAIL(ret) && NULL != uring) {
+      uring->~ObSqlNioUring();
+      direct_free(uring);
+    }
+    return ret;
+  }
+  static uint64_t make_user_data(void* p, int op) { return (uint64_t)p | op; }
+  uring::Sqe* get_sqe() {
+    uring::Sqe* sqe = uring_->get_sqe();
+    if (OB_ISNULL(sqe)) {
+      LOG_WARN("io_uring sq is full");
+    }
+    return sqe;
+  }
+  int arm_accept() {
+    int ret = OB_SUCCESS;
+    uring::Sqe* sqe = NULL;
+    if (NULL == (sqe = get_sqe())) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      ObSqlNioUring::prep_accept_multishot(sqe, lfd_, SOCK_NONBLOCK|SOCK_CLOEXEC, make_user_data(NULL, URING_OP_ACCEPT));
+    }
+    return ret;
+  }
+  int arm_evfd() {
+    int ret = OB_SUCCESS;
+    uring::Sqe* sqe = NULL;
+    if (NULL == (sqe = get_sqe())) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      ObSqlNioUring::prep_poll_multishot(sqe, evfd_.get_fd(), POLLIN, make_user_data(NULL, URING_OP_EVFD));
+    }
+    return ret;
+  }
+  int arm_recv(ObSqlSock* s) {
+    int ret = OB_SUCCESS;
+    uring::Sqe* sqe = NULL;
+    if (NULL == (sqe = get_sqe())) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      ObSqlNioUring::prep_recv_multishot(sqe, s->get_fd(), make_user_data(s, URING_OP_RECV));
+      s->inc_uring_ref();
+    }
+    return ret;
+  }
+  // for writable event, error and hang up are always reported
+  int arm_poll(ObSqlSock* s) {
+    int ret = OB_SUCCESS;
+    uring::Sqe* sqe = NULL;
+    if (NULL == (sqe = get_sqe())) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      ObSqlNioUring::prep_poll_multishot(sqe, s->get_fd(), POLLOUT, make_user_data(s, URING_OP_POLL));
+      s->inc_uring_ref();
+    }
+    return ret;
+  }
+  int prep_pending_send(ObSqlSock* s) {
+    int ret = OB_SUCCESS;
+    const char* buf = NULL;
+    int64_t sz = 0;
+    uring::Sqe* sqe = NULL;
+    if (!s->get_pending_write(buf, sz)) {
+      // no pending write
+    } else if (NULL == (sqe = get_sqe())) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      ObSqlNioUring::prep_send(sqe, s->get_fd(), buf, sz, MSG_NOSIGNAL, make_user_data(s, URING_OP_SEND));
+      s->inc_uring_ref();
+    }
+    return ret;
+  }
+  // retried by handle_pending_destroy_list() if sq is full, the sock is not freed until
+  // all its requests are canceled
+  void cancel_uring_req(ObSqlSock* s) {
+    uring::Sqe* sqe = NULL;
+    if (NULL == (sqe = get_sqe())) {
+      LOG_WARN("cancel io_uring request fail, retry later", K(*s));
+      s->set_uring_cancel_pending(true);
+    } else {
+      ObSqlNioUring::prep_cancel_fd(sqe, s->get_fd(), make_user_data(NULL, URING_OP_CANCEL));
+      s->set_uring_cancel_pending(false);
+    }
+  }
+  // stop the multishot recv, the final cqe of it is -ECANCELED
+  void cancel_recv(ObSqlSock* s) {
+    uring::Sqe* sqe = NULL;
+    if (s->is_recv_canceling()) {
+    } else if (NULL == (sqe = get_sqe())) {
+      // try again on next recv cqe
+    } else {
+      ObSqlNioUring::prep_cancel(sqe, make_user_data(s, URING_OP_RECV), make_user_data(NULL, URING_OP_CANCEL));
+      s->set_recv_canceling(true);
+    }
+  }
+  void handle_uring_event(int64_t timeout_us) {
+    const int64_t max_cqe_cnt = 512;
+    uring::Cqe* cqe = NULL;
+    IGNORE_RETURN uring_->submit_and_wait(timeout_us);
+    for (int64_t i = 0; i < max_cqe_cnt && NULL != (cqe = uring_->peek_cqe()); i++) {
+      const uint64_t user_data = cqe->user_data_;
+      const int res = cqe->res_;
+      const uint32_t flags = cqe->flags_;
+      uring_->advance_cqe();
+      handle_cqe(user_data, res, flags);
+    }
+  }
+  void handle_cqe(uint64_t user_data, int res, uint32_t flags) {
+    ObSqlSock* s = (ObSqlSock*)(user_data & ~(uint64_t)URING_OP_MASK);
+    const bool has_more = 0 != (flags & uring::CQE_F_MORE);
+    switch (user_data & URING_OP_MASK) {
+      case URING_OP_ACCEPT:
+        if (res >= 0) {
+          handle_accept_fd(res);
+        } else {
+          LOG_ERROR("io_uring accept fail", K(lfd_), K(res));
+        }
+        if (!has_more) {
+          IGNORE_RETURN arm_accept();
+        }
+        break;
+      case URING_OP_EVFD:
+        evfd_.consume();
+        if (!has_more) {
+          IGNORE_RETURN arm_evfd();
+        }
+        break;
+      case URING_OP_RECV:
+        handle_recv_cqe(s, res, flags);
+        break;
+      case URING_OP_POLL:
+        if (!has_more) {
+          s->dec_uring_ref();
+        }
+        if (res > 0) {
+          handle_sock_event(s, (uint32_t)res);
+        } else if (res < 0 && -ECANCELED != res) {
+          handle_sock_event(s, EPOLLERR);
+        }
+        if (!has_more && !s->has_error() && OB_SUCCESS != arm_poll(s)) {
+          handle_sock_event(s, EPOLLERR);
+        }
+        break;
+      case URING_OP_SEND:
+        s->dec_uring_ref();
+        handle_send_cqe(s, res);
+        break;
+      default:
+        break;
+    }
+  }
+  void handle_recv_cqe(ObSqlSock* s, int res, uint32_t flags) {
+    const bool has_more = 0 != (flags & uring::CQE_F_MORE);
+    if (!has_more) {
+      s->dec_uring_ref();
+    }
+    if (res > 0) {
+      const uint16_t bid = (uint16_t)(flags >> uring::CQE_BUFFER_SHIFT);
+      int ret = s->push_recv_chunk(uring_->get_buf(bid), res);
+      uring_->recycle_buf(bid);
+      handle_sock_event(s, OB_SUCCESS == ret ? EPOLLIN : EPOLLERR);
+    } else if (0 == res) {
+      // peer closed
+      handle_sock_event(s, EPOLLRDHUP);
+    } else if (-ENOBUFS == res || -ECANCELED == res) {
+      // all buffers are in use, or recv is canceled because of full chunks or destroying sock,
+      // recv is armed again below if needed
+    } else {
+      handle_sock_event(s, EPOLLERR);
+    }
+    if (has_more) {
+      if (s->is_recv_chunk_full() && !s->has_error()) {
+        cancel_recv(s);
+      }
+    } else if (FALSE_IT(s->set_recv_canceling(false))) {
+    } else if (s->has_error()) {
+      // sock is destroying
+    } else if (s->is_recv_chunk_full()) {
+      // armed again by the handling thread after data is consumed, check again in case
+      // all data is consumed before recv_paused is set
+      s->set_recv_paused();
+      LOG_INFO("too much data not consumed, pause recv", K(*s));
+      if (s->try_resume_recv() && OB_SUCCESS != arm_recv(s)) {
+        handle_sock_event(s, EPOLLERR);
+      }
+    } else if (OB_SUCCESS != arm_recv(s)) {
+      handle_sock_event(s, EPOLLERR);
+    }
+  }
+  void handle_send_cqe(ObSqlSock* s, int res) {
+    int err = 0;
+    bool become_clean = false;
+    if (s->has_error()) {
+      err = EIO;
+    } else if (res >= 0) {
+      s->consume_pending_write(res, become_clean);
+      if (become_clean) {
+        handler_.on_flushed(s->sess_);
+      } else if (OB_SUCCESS != prep_pending_send(s)) {
+        err = EIO;
+      }
+    } else if (-EAGAIN == res) {
+      LOG_INFO("need epoll trigger write", K(*s));
+      s->set_need_epoll_trigger_write();
+    } else {
+      LOG_WARN("io_uring send fail", K(res), K(*s));
+      err = EIO;
+    }
+    if (0 != err) {
+      revert_sock(s);
+      if (s->set_error(err)) {
+        prepare_destroy(s);
+      }
+    }
+  }
 private:
   ObSqlSock* alloc_sql_sock(int fd) {
     ObSqlSock* s = NULL;
@@ -825,13 +1271,15 @@ private:
   int epfd_;
   int lfd_;
   Evfd evfd_;
+  ObSqlNioUring* uring_;
   ObSpScLinkQueue close_req_queue_;
   ObSpScLinkQueue write_req_queue_;
+  ObSpScLinkQueue resume_recv_queue_;
   ObDList pending_destroy_list_;
   ObDList all_list_;
 };
 
-int ObSqlNio::start(int port, ObISqlSockHandler* handler, int n_thread)
+int ObSqlNio::start(int port, ObISqlSockHandler* handler, int n_thread, bool use_io_uring)
 {
   int ret = OB_SUCCESS;
   if (NULL == (impl_ = (typeof(impl_))ob_malloc(sizeof(ObSqlNioImpl) * n_thread, "SqlNio"))) {
@@ -840,7 +1288,7 @@ int ObSqlNio::start(int port, ObISqlSockHandler* handler, int n_thread)
   } else {
     for(int i = 0; OB_SUCCESS == ret && i < n_thread; i++) {
       new(impl_ + i)ObSqlNioImpl(*handler);
-      if (OB_FAIL(impl_[i].init(port))) {
+      if (OB_FAIL(impl_[i].init(port, use_io_uring))) {
         LOG_WARN("impl init fail", K(ret));
       }
     }
@@ -930,7 +1378,17 @@ bool ObSqlNio::has_error(void* sess)
 
 int ObSqlNio::peek_data(void* sess, int64_t limit, const char*& buf, int64_t& sz)
 {
-  return sess2sock(sess)->peek_data(limit, buf, sz);
+  ObSqlSock* sock = sess2sock(sess);
+  int ret = sock->peek_data(limit, buf, sz);
+  if (OB_UNLIKELY(sock->try_resume_recv())) {
+    sock->get_nio_impl().push_resume_recv_req(sock);
+  }
+  return ret;
+}
+
+bool ObSqlNio::has_buffered_data(void* sess)
+{
+  return sess2sock(sess)->has_buffered_data();
 }
 
 int ObSqlNio::consume_data(void* sess, int64_t sz)
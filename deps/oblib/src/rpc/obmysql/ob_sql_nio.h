@@ -27,12 +27,13 @@ class ObSqlNio: public lib::Threads
 public:
   ObSqlNio(): impl_(NULL) {}
   virtual ~ObSqlNio() {}
-  int start(int port, ObISqlSockHandler* handler, int n_thread);
+  int start(int port, ObISqlSockHandler* handler, int n_thread, bool use_io_uring = false);
   bool has_error(void* sess);
   void destroy_sock(void* sess);
   void revert_sock(void* sess);
   int peek_data(void* sess, int64_t limit, const char*& buf, int64_t& sz);
   int consume_data(void* sess, int64_t sz);
+  bool has_buffered_data(void* sess);
   int write_data(void* sess, const char* buf, int64_t sz);
   void async_write_data(void* sess, const char* buf, int64_t sz);
   void stop();
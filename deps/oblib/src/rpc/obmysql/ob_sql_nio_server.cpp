@@ -19,12 +19,12 @@ using namespace common;
 namespace obmysql
 {
 
-int ObSqlNioServer::start(int port, rpc::frame::ObReqDeliver* deliver, int n_thread)
+int ObSqlNioServer::start(int port, rpc::frame::ObReqDeliver* deliver, int n_thread, bool use_io_uring)
 {
   int ret = OB_SUCCESS;
   if (OB_FAIL(io_handler_.init(deliver))) {
     LOG_WARN("handler init fail", K(ret));
-  } else if (OB_FAIL(nio_.start(port, &io_handler_, n_thread))) {
+  } else if (OB_FAIL(nio_.start(port, &io_handler_, n_thread, use_io_uring))) {
     LOG_WARN("sql nio start fail", K(ret));
   }
   return ret;
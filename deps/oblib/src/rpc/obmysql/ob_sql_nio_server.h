@@ -25,7 +25,7 @@ class ObSqlNioServer
 public:
   ObSqlNioServer(ObISMConnectionCallback& conn_cb, ObMySQLHandler& mysql_handler): thread_processor_(mysql_handler), io_handler_(conn_cb, thread_processor_, nio_) {}
   virtual ~ObSqlNioServer() {}
-  int start(int port, rpc::frame::ObReqDeliver* deliver, int n_thread);
+  int start(int port, rpc::frame::ObReqDeliver* deliver, int n_thread, bool use_io_uring = false);
   void revert_sock(void* sess);
   int peek_data(void* sess, int64_t limit, const char*& buf, int64_t& sz);
   int consume_data(void* sess, int64_t sz);
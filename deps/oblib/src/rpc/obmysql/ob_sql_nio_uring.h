@@ -0,0 +1,455 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_OBMYSQL_OB_SQL_NIO_URING_H_
+#define OCEANBASE_OBMYSQL_OB_SQL_NIO_URING_H_
+#include <stdint.h>
+#include <unistd.h>
+#include <algorithm>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "lib/atomic/ob_atomic.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/utility/ob_template_utils.h"
+
+namespace oceanbase
+{
+namespace obmysql
+{
+// Minimal io_uring for sql nio, by raw syscalls instead of liburing.
+// The kernel ABI is redefined here so that it builds with old kernel headers,
+// it works with kernel 6.0 or later (multishot accept/recv and provided buffer ring),
+// and init() fails on older kernels, so caller can fall back to epoll.
+// Not thread safe, it should be used by the owner sql nio thread only.
+namespace uring
+{
+enum
+{
+  SYS_SETUP = 425,
+  SYS_ENTER = 426,
+  SYS_REGISTER = 427,
+};
+
+enum
+{
+  OP_POLL_ADD = 6,
+  OP_ACCEPT = 13,
+  OP_ASYNC_CANCEL = 14,
+  OP_SEND = 26,
+  OP_RECV = 27,
+};
+
+static const uint8_t SQE_BUFFER_SELECT = 1U << 5;
+static const uint32_t POLL_ADD_MULTI = 1U << 0;
+static const uint16_t ACCEPT_MULTISHOT = 1U << 0;
+static const uint16_t RECV_MULTISHOT = 1U << 1;
+static const uint32_t ASYNC_CANCEL_ALL = 1U << 0;
+static const uint32_t ASYNC_CANCEL_FD = 1U << 1;
+static const uint32_t CQE_F_BUFFER = 1U << 0;
+static const uint32_t CQE_F_MORE = 1U << 1;
+static const int CQE_BUFFER_SHIFT = 16;
+static const uint32_t SETUP_CQSIZE = 1U << 3;
+static const uint32_t SETUP_CLAMP = 1U << 4;
+static const uint32_t FEAT_SINGLE_MMAP = 1U << 0;
+static const uint32_t FEAT_NODROP = 1U << 1;
+static const uint32_t FEAT_EXT_ARG = 1U << 8;
+static const uint32_t ENTER_GETEVENTS = 1U << 0;
+static const uint32_t ENTER_EXT_ARG = 1U << 3;
+static const uint32_t SQ_CQ_OVERFLOW = 1U << 1;
+static const unsigned REGISTER_PBUF_RING = 22;
+static const int64_t OFF_SQ_RING = 0;
+static const int64_t OFF_CQ_RING = 0x8000000;
+static const int64_t OFF_SQES = 0x10000000;
+
+struct Sqe
+{
+  uint8_t opcode_;
+  uint8_t flags_;
+  uint16_t ioprio_;
+  int32_t fd_;
+  uint64_t off_;
+  uint64_t addr_;
+  uint32_t len_;
+  uint32_t op_flags_; // poll32_events, msg_flags, accept_flags, cancel_flags
+  uint64_t user_data_;
+  uint16_t buf_group_;
+  uint16_t personality_;
+  int32_t file_index_;
+  uint64_t addr3_;
+  uint64_t pad_;
+};
+
+struct Cqe
+{
+  uint64_t user_data_;
+  int32_t res_;
+  uint32_t flags_;
+};
+
+struct SqRingOffsets
+{
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t flags_;
+  uint32_t dropped_;
+  uint32_t array_;
+  uint32_t resv1_;
+  uint64_t user_addr_;
+};
+
+struct CqRingOffsets
+{
+  uint32_t head_;
+  uint32_t tail_;
+  uint32_t ring_mask_;
+  uint32_t ring_entries_;
+  uint32_t overflow_;
+  uint32_t cqes_;
+  uint32_t flags_;
+  uint32_t resv1_;
+  uint64_t user_addr_;
+};
+
+struct Params
+{
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  uint32_t flags_;
+  uint32_t sq_thread_cpu_;
+  uint32_t sq_thread_idle_;
+  uint32_t features_;
+  uint32_t wq_fd_;
+  uint32_t resv_[3];
+  SqRingOffsets sq_off_;
+  CqRingOffsets cq_off_;
+};
+
+struct BufReg
+{
+  uint64_t ring_addr_;
+  uint32_t ring_entries_;
+  uint16_t bgid_;
+  uint16_t flags_;
+  uint64_t resv_[3];
+};
+
+// one entry of provided buffer ring, tail of the ring overlaps resv_ of the first entry
+struct Buf
+{
+  uint64_t addr_;
+  uint32_t len_;
+  uint16_t bid_;
+  uint16_t resv_;
+};
+
+struct KernelTimespec
+{
+  int64_t tv_sec_;
+  int64_t tv_nsec_;
+};
+
+struct GeteventsArg
+{
+  uint64_t sigmask_;
+  uint32_t sigmask_sz_;
+  uint32_t pad_;
+  uint64_t ts_;
+};
+
+STATIC_ASSERT(sizeof(Sqe) == 64, "size of io_uring sqe should be 64");
+STATIC_ASSERT(sizeof(Cqe) == 16, "size of io_uring cqe should be 16");
+STATIC_ASSERT(sizeof(Params) == 120, "size of io_uring params should be 120");
+STATIC_ASSERT(sizeof(BufReg) == 40, "size of io_uring buf reg should be 40");
+STATIC_ASSERT(sizeof(Buf) == 16, "size of io_uring buf should be 16");
+}; // end namespace uring
+
+class ObSqlNioUring
+{
+public:
+  enum { BUF_GROUP_ID = 0 };
+  ObSqlNioUring(): ring_fd_(-1), features_(0), sq_ring_(NULL), sq_ring_sz_(0), cq_ring_(NULL), cq_ring_sz_(0),
+                   sqes_(NULL), sqes_sz_(0), sq_head_(NULL), sq_tail_(NULL), sq_flags_(NULL), sq_mask_(0),
+                   sq_entries_(0), cq_head_(NULL), cq_tail_(NULL), cq_mask_(0), cqes_(NULL),
+                   local_sq_tail_(0), buf_ring_(NULL), buf_ring_sz_(0), buf_cnt_(0),
+                   buf_size_(0), bufs_(NULL), bufs_sz_(0), buf_tail_(0) {}
+  ~ObSqlNioUring() { destroy(); }
+  int init(uint32_t entries, uint32_t buf_cnt, uint32_t buf_size)
+  {
+    int ret = common::OB_SUCCESS;
+    uring::Params params;
+    memset(&params, 0, sizeof(params));
+    params.flags_ = uring::SETUP_CQSIZE | uring::SETUP_CLAMP;
+    params.cq_entries_ = entries * 4;
+    if ((ring_fd_ = (int)syscall(uring::SYS_SETUP, entries, &params)) < 0) {
+      ret = common::OB_NOT_SUPPORTED;
+      RPC_LOG(WARN, "io_uring_setup fail", K(ret), K(errno), K(entries));
+    } else if (0 == (params.features_ & uring::FEAT_SINGLE_MMAP)
+               || 0 == (params.features_ & uring::FEAT_NODROP)
+               || 0 == (params.features_ & uring::FEAT_EXT_ARG)) {
+      ret = common::OB_NOT_SUPPORTED;
+      RPC_LOG(WARN, "io_uring features not supported", K(ret), K(params.features_));
+    } else if (OB_FAIL(map_rings(params))) {
+      RPC_LOG(WARN, "io_uring map rings fail", K(ret));
+    } else if (OB_FAIL(init_buf_ring(buf_cnt, buf_size))) {
+      RPC_LOG(WARN, "io_uring init provided buffer ring fail", K(ret), K(buf_cnt), K(buf_size));
+    } else {
+      features_ = params.features_;
+    }
+    if (OB_FAIL(ret)) {
+      destroy();
+    }
+    return ret;
+  }
+  void destroy()
+  {
+    unmap(bufs_, bufs_sz_);
+    unmap(buf_ring_, buf_ring_sz_);
+    unmap(sqes_, sqes_sz_);
+    if (cq_ring_ != sq_ring_) {
+      unmap(cq_ring_, cq_ring_sz_);
+    }
+    cq_ring_ = NULL;
+    unmap(sq_ring_, sq_ring_sz_);
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+      ring_fd_ = -1;
+    }
+  }
+  // return NULL only if sq is still full after submit
+  uring::Sqe* get_sqe()
+  {
+    uring::Sqe* sqe = NULL;
+    if (local_sq_tail_ - ATOMIC_LOAD_ACQ(sq_head_) >= sq_entries_) {
+      IGNORE_RETURN submit_and_wait(0);
+    }
+    if (local_sq_tail_ - ATOMIC_LOAD_ACQ(sq_head_) < sq_entries_) {
+      sqe = sqes_ + (local_sq_tail_ & sq_mask_);
+      memset(sqe, 0, sizeof(*sqe));
+      local_sq_tail_++;
+    }
+    return sqe;
+  }
+  // submit all prepared sqes and wait at most timeout_us for one cqe, by one syscall
+  int submit_and_wait(int64_t timeout_us)
+  {
+    int ret = common::OB_SUCCESS;
+    uint32_t flags = 0;
+    uint32_t wait_nr = 0;
+    const uint32_t to_submit = local_sq_tail_ - ATOMIC_LOAD_ACQ(sq_head_);
+    uring::KernelTimespec ts;
+    uring::GeteventsArg arg;
+    ATOMIC_STORE_REL(sq_tail_, local_sq_tail_);
+    if (timeout_us > 0) {
+      ts.tv_sec_ = timeout_us / 1000000;
+      ts.tv_nsec_ = (timeout_us % 1000000) * 1000;
+      memset(&arg, 0, sizeof(arg));
+      arg.ts_ = (uint64_t)&ts;
+      flags = uring::ENTER_GETEVENTS | uring::ENTER_EXT_ARG;
+      wait_nr = 1;
+    } else if (0 != (ATOMIC_LOAD(sq_flags_) & uring::SQ_CQ_OVERFLOW)) {
+      // flush overflowed cqes into cq ring
+      flags = uring::ENTER_GETEVENTS;
+    }
+    if (0 == to_submit && 0 == flags) {
+      // nothing to do
+    } else if (syscall(uring::SYS_ENTER, ring_fd_, to_submit, wait_nr, flags,
+                       0 == wait_nr ? NULL : &arg, sizeof(arg)) < 0
+               && ETIME != errno && EINTR != errno && EBUSY != errno && EAGAIN != errno) {
+      ret = common::OB_IO_ERROR;
+      RPC_LOG(WARN, "io_uring_enter fail", K(ret), K(errno), K(to_submit));
+    }
+    return ret;
+  }
+  uring::Cqe* peek_cqe()
+  {
+    uring::Cqe* cqe = NULL;
+    uint32_t head = *cq_head_;
+    if (head != ATOMIC_LOAD_ACQ(cq_tail_)) {
+      cqe = cqes_ + (head & cq_mask_);
+    }
+    return cqe;
+  }
+  void advance_cqe() { ATOMIC_STORE_REL(cq_head_, *cq_head_ + 1); }
+  const char* get_buf(uint16_t bid) const { return bufs_ + (int64_t)bid * buf_size_; }
+  // give the buffer back to kernel after data in it is consumed
+  void recycle_buf(uint16_t bid)
+  {
+    uring::Buf* buf = buf_ring_ + (buf_tail_ & (buf_cnt_ - 1));
+    buf->addr_ = (uint64_t)get_buf(bid);
+    buf->len_ = buf_size_;
+    buf->bid_ = bid;
+    buf_tail_++;
+    ATOMIC_STORE_REL(&buf_ring_[0].resv_, buf_tail_);
+  }
+  static void prep_poll_multishot(uring::Sqe* sqe, int fd, uint32_t events, uint64_t user_data)
+  {
+    sqe->opcode_ = uring::OP_POLL_ADD;
+    sqe->fd_ = fd;
+    sqe->len_ = uring::POLL_ADD_MULTI;
+    sqe->op_flags_ = events;
+    sqe->user_data_ = user_data;
+  }
+  static void prep_accept_multishot(uring::Sqe* sqe, int fd, uint32_t flags, uint64_t user_data)
+  {
+    sqe->opcode_ = uring::OP_ACCEPT;
+    sqe->fd_ = fd;
+    sqe->ioprio_ = uring::ACCEPT_MULTISHOT;
+    sqe->op_flags_ = flags;
+    sqe->user_data_ = user_data;
+  }
+  static void prep_recv_multishot(uring::Sqe* sqe, int fd, uint64_t user_data)
+  {
+    sqe->opcode_ = uring::OP_RECV;
+    sqe->fd_ = fd;
+    sqe->flags_ = uring::SQE_BUFFER_SELECT;
+    sqe->ioprio_ = uring::RECV_MULTISHOT;
+    sqe->buf_group_ = BUF_GROUP_ID;
+    sqe->user_data_ = user_data;
+  }
+  static void prep_send(uring::Sqe* sqe, int fd, const char* buf, int64_t sz, uint32_t flags, uint64_t user_data)
+  {
+    sqe->opcode_ = uring::OP_SEND;
+    sqe->fd_ = fd;
+    sqe->addr_ = (uint64_t)buf;
+    sqe->len_ = (uint32_t)std::min(sz, (int64_t)UINT32_MAX);
+    sqe->op_flags_ = flags;
+    sqe->user_data_ = user_data;
+  }
+  // cancel all requests of fd
+  static void prep_cancel_fd(uring::Sqe* sqe, int fd, uint64_t user_data)
+  {
+    sqe->opcode_ = uring::OP_ASYNC_CANCEL;
+    sqe->fd_ = fd;
+    sqe->op_flags_ = uring::ASYNC_CANCEL_FD | uring::ASYNC_CANCEL_ALL;
+    sqe->user_data_ = user_data;
+  }
+  // cancel the request submitted with target_user_data
+  static void prep_cancel(uring::Sqe* sqe, uint64_t target_user_data, uint64_t user_data)
+  {
+    sqe->opcode_ = uring::OP_ASYNC_CANCEL;
+    sqe->fd_ = -1;
+    sqe->addr_ = target_user_data;
+    sqe->user_data_ = user_data;
+  }
+private:
+  int map_rings(const uring::Params& params)
+  {
+    int ret = common::OB_SUCCESS;
+    sq_ring_sz_ = params.sq_off_.array_ + params.sq_entries_ * sizeof(uint32_t);
+    cq_ring_sz_ = params.cq_off_.cqes_ + params.cq_entries_ * sizeof(uring::Cqe);
+    sq_ring_sz_ = cq_ring_sz_ = std::max(sq_ring_sz_, cq_ring_sz_);
+    sqes_sz_ = params.sq_entries_ * sizeof(uring::Sqe);
+    if (NULL == (sq_ring_ = map(sq_ring_sz_, ring_fd_, uring::OFF_SQ_RING))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    } else if (NULL == (sqes_ = (uring::Sqe*)map(sqes_sz_, ring_fd_, uring::OFF_SQES))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      cq_ring_ = sq_ring_;
+      sq_head_ = (uint32_t*)(sq_ring_ + params.sq_off_.head_);
+      sq_tail_ = (uint32_t*)(sq_ring_ + params.sq_off_.tail_);
+      sq_flags_ = (uint32_t*)(sq_ring_ + params.sq_off_.flags_);
+      sq_mask_ = *(uint32_t*)(sq_ring_ + params.sq_off_.ring_mask_);
+      sq_entries_ = *(uint32_t*)(sq_ring_ + params.sq_off_.ring_entries_);
+      uint32_t* sq_array = (uint32_t*)(sq_ring_ + params.sq_off_.array_);
+      for (uint32_t i = 0; i < sq_entries_; i++) {
+        sq_array[i] = i;
+      }
+      cq_head_ = (uint32_t*)(cq_ring_ + params.cq_off_.head_);
+      cq_tail_ = (uint32_t*)(cq_ring_ + params.cq_off_.tail_);
+      cq_mask_ = *(uint32_t*)(cq_ring_ + params.cq_off_.ring_mask_);
+      cqes_ = (uring::Cqe*)(cq_ring_ + params.cq_off_.cqes_);
+      local_sq_tail_ = *sq_tail_;
+    }
+    return ret;
+  }
+  int init_buf_ring(uint32_t buf_cnt, uint32_t buf_size)
+  {
+    int ret = common::OB_SUCCESS;
+    uring::BufReg reg;
+    buf_ring_sz_ = buf_cnt * sizeof(uring::Buf);
+    bufs_sz_ = (int64_t)buf_cnt * buf_size;
+    if (0 == buf_cnt || 0 != (buf_cnt & (buf_cnt - 1)) || buf_cnt > UINT16_MAX) {
+      ret = common::OB_INVALID_ARGUMENT;
+    } else if (NULL == (buf_ring_ = (uring::Buf*)map(buf_ring_sz_, -1, 0))
+               || NULL == (bufs_ = (char*)map(bufs_sz_, -1, 0))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      memset(&reg, 0, sizeof(reg));
+      reg.ring_addr_ = (uint64_t)buf_ring_;
+      reg.ring_entries_ = buf_cnt;
+      reg.bgid_ = BUF_GROUP_ID;
+      if (syscall(uring::SYS_REGISTER, ring_fd_, uring::REGISTER_PBUF_RING, &reg, 1) < 0) {
+        ret = common::OB_NOT_SUPPORTED;
+        RPC_LOG(WARN, "register provided buffer ring fail", K(ret), K(errno));
+      } else {
+        buf_cnt_ = buf_cnt;
+        buf_size_ = buf_size;
+        for (uint32_t i = 0; i < buf_cnt; i++) {
+          recycle_buf((uint16_t)i);
+        }
+      }
+    }
+    return ret;
+  }
+  static char* map(int64_t sz, int fd, int64_t offset)
+  {
+    void* p = NULL;
+    if (fd >= 0) {
+      p = mmap(NULL, sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    } else {
+      p = mmap(NULL, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    return MAP_FAILED == p ? NULL : (char*)p;
+  }
+  template <typename T>
+  static void unmap(T*& p, int64_t sz)
+  {
+    if (NULL != p) {
+      munmap((void*)p, sz);
+      p = NULL;
+    }
+  }
+private:
+  int ring_fd_;
+  uint32_t features_;
+  char* sq_ring_;
+  int64_t sq_ring_sz_;
+  char* cq_ring_;
+  int64_t cq_ring_sz_;
+  uring::Sqe* sqes_;
+  int64_t sqes_sz_;
+  uint32_t* sq_head_;
+  uint32_t* sq_tail_;
+  uint32_t* sq_flags_;
+  uint32_t sq_mask_;
+  uint32_t sq_entries_;
+  uint32_t* cq_head_;
+  uint32_t* cq_tail_;
+  uint32_t cq_mask_;
+  uring::Cqe* cqes_;
+  uint32_t local_sq_tail_;
+  uring::Buf* buf_ring_;
+  int64_t buf_ring_sz_;
+  uint32_t buf_cnt_;
+  uint32_t buf_size_;
+  char* bufs_;
+  int64_t bufs_sz_;
+  uint16_t buf_tail_;
+};
+
+}; // end namespace obmysql
+}; // end namespace oceanbase
+
+#endif /* OCEANBASE_OBMYSQL_OB_SQL_NIO_URING_H_ */
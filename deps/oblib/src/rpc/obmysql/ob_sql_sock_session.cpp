@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX RPC_OBMYSQL
 #include "rpc/obmysql/ob_sql_sock_session.h"
 #include "rpc/obmysql/ob_sql_nio.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 namespace oceanbase
 {
@@ -21,6 +22,8 @@ using namespace rpc;
 using namespace observer;
 namespace obmysql
 {
+int64_t ObSqlSockSession::RESPONSE_COALESCE_SIZE = 0;
+int64_t ObSqlSockSession::RESPONSE_COALESCE_TIME = 0;
 
 ObSqlSockSession::ObSqlSockSession(ObISMConnectionCallback& conn_cb, ObSqlNio& nio):
     nio_(nio),
@@ -28,7 +31,8 @@ ObSqlSockSession::ObSqlSockSession(ObISMConnectionCallback& conn_cb, ObSqlNio& n
     sql_req_(ObRequest::OB_MYSQL, 1),
     last_pkt_sz_(0),
     pending_write_buf_(NULL),
-    pending_write_sz_(0)
+    pending_write_sz_(0),
+    coalescer_()
 {
   sql_req_.set_server_handle_context(this);
 }
@@ -44,6 +48,7 @@ void ObSqlSockSession::destroy()
 {
   sm_conn_cb_.destroy(conn_);
   pool_.reset();
+  coalescer_.destroy();
 }
 
 void ObSqlSockSession::destroy_sock()
@@ -78,7 +83,22 @@ void ObSqlSockSession::revert_sock()
     int64_t sz = pending_write_sz_;
     pending_write_buf_ = NULL;
     pending_write_sz_ = 0;
-    nio_.async_write_data((void*)this, data, sz);
+    if (try_coalesce_response(data, sz)) {
+      // next request has been received, handle it before writing
+      pool_.reuse();
+      nio_.revert_sock((void*)this);
+    } else if (OB_SUCCESS != flush_coalesced_response(data, sz)) {
+      nio_.revert_sock((void*)this);
+    } else {
+      EVENT_INC(MYSQL_RESPONSE_WRITE_COUNT);
+      nio_.async_write_data((void*)this, data, sz);
+    }
+  } else if (coalescer_.get_cnt() > 0 && !nio_.has_buffered_data((void*)this)) {
+    // no response for this request, but held responses can not wait any more
+    EVENT_INC(MYSQL_RESPONSE_WRITE_COUNT);
+    EVENT_ADD(MYSQL_RESPONSE_COUNT, coalescer_.get_cnt());
+    coalescer_.detach();
+    nio_.async_write_data((void*)this, coalescer_.get_buf(), coalescer_.get_sz());
   } else {
     pool_.reuse();
     nio_.revert_sock((void*)this);
@@ -89,6 +109,7 @@ void ObSqlSockSession::on_flushed()
 {
   /* TODO should not go here*/
   //abort();
+  coalescer_.on_written();
   pool_.reuse();
   nio_.revert_sock((void*)this);
 }
@@ -156,6 +177,94 @@ int ObSqlSockSession::async_write_data(const char* buf, int64_t sz)
   return ret;
 }
 
+bool ObSqlSockSession::try_coalesce_response(const char* buf, int64_t sz)
+{
+  bool bret = false;
+  if (ATOMIC_LOAD(&RESPONSE_COALESCE_SIZE) <= 0 || has_error()) {
+  } else if (!nio_.has_buffered_data((void*)this)) {
+    // input drained, client is waiting for responses
+  } else {
+    bret = coalescer_.hold(buf, sz, ATOMIC_LOAD(&RESPONSE_COALESCE_SIZE),
+                           ATOMIC_LOAD(&RESPONSE_COALESCE_TIME), ObTimeUtility::current_time());
+  }
+  return bret;
+}
+
+// merge current response into held responses. if it can not be merged, held responses are written synchronously.
+int ObSqlSockSession::flush_coalesced_response(const char*& buf, int64_t& sz)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = coalescer_.get_cnt();
+  if (coalescer_.merge(buf, sz)) {
+    EVENT_ADD(MYSQL_RESPONSE_COUNT, cnt + 1);
+  } else {
+    EVENT_INC(MYSQL_RESPONSE_WRITE_COUNT);
+    EVENT_ADD(MYSQL_RESPONSE_COUNT, cnt + 1);
+    if (OB_FAIL(write_data(coalescer_.get_buf(), coalescer_.get_sz()))) {
+      LOG_WARN("write coalesced response fail", K(ret), "coalesce_sz", coalescer_.get_sz());
+    }
+    coalescer_.on_written();
+  }
+  return ret;
+}
+
+void ObSqlResponseCoalescer::destroy()
+{
+  if (NULL != buf_) {
+    ob_free(buf_);
+    buf_ = NULL;
+  }
+  buf_size_ = 0;
+  sz_ = 0;
+  cnt_ = 0;
+}
+
+bool ObSqlResponseCoalescer::hold(const char* buf, int64_t sz, int64_t size_limit, int64_t time_limit, int64_t now)
+{
+  bool bret = false;
+  if (size_limit <= 0 || sz_ + sz > size_limit) {
+  } else if (cnt_ > 0 && now - start_ts_ >= time_limit) {
+  } else {
+    if (NULL == buf_) {
+      if (NULL != (buf_ = (char*)ob_malloc(size_limit, ObMemAttr(OB_SERVER_TENANT_ID, "SqlRespCoalesce")))) {
+        buf_size_ = size_limit;
+      }
+    }
+    if (NULL != buf_ && sz_ + sz <= buf_size_) {
+      MEMCPY(buf_ + sz_, buf, sz);
+      if (0 == cnt_) {
+        start_ts_ = now;
+      }
+      sz_ += sz;
+      cnt_++;
+      bret = true;
+    }
+  }
+  return bret;
+}
+
+bool ObSqlResponseCoalescer::merge(const char*& buf, int64_t& sz)
+{
+  bool bret = true;
+  if (cnt_ <= 0) {
+  } else if (sz_ + sz <= buf_size_) {
+    MEMCPY(buf_ + sz_, buf, sz);
+    sz_ += sz;
+    buf = buf_;
+    sz = sz_;
+    cnt_ = 0;
+  } else {
+    bret = false;
+  }
+  return bret;
+}
+
+void ObSqlResponseCoalescer::on_written()
+{
+  // the buffer is not kept for idle connection
+  destroy();
+}
+
 void ObSqlSockSession::set_sql_session_info(void* sess)
 {
   nio_.set_sql_session_info((void *)this, sess);
@@ -36,6 +36,35 @@ private:
   obrpc::ObRpcMemPool pool_;
 };
 
+// responses of pipelined requests of one connection are copied into one buffer and
+// written at once. the buffer is allocated by the first held response, and freed after
+// the held responses are written.
+class ObSqlResponseCoalescer
+{
+public:
+  ObSqlResponseCoalescer(): buf_(NULL), buf_size_(0), sz_(0), cnt_(0), start_ts_(0) {}
+  ~ObSqlResponseCoalescer() { destroy(); }
+  void destroy();
+  // hold the response if it fits in size_limit, and the first held response is held
+  // for less than time_limit
+  bool hold(const char* buf, int64_t sz, int64_t size_limit, int64_t time_limit, int64_t now);
+  // append the response to held responses, and return them by buf and sz.
+  // return false if it does not fit, held responses should be written first.
+  bool merge(const char*& buf, int64_t& sz);
+  // held responses are handed over to write, the buffer is kept until on_written()
+  void detach() { cnt_ = 0; }
+  void on_written();
+  const char* get_buf() const { return buf_; }
+  int64_t get_sz() const { return sz_; }
+  int64_t get_cnt() const { return cnt_; }
+private:
+  char* buf_;
+  int64_t buf_size_;
+  int64_t sz_;
+  int64_t cnt_;
+  int64_t start_ts_;
+};
+
 class ObSqlSockSession
 {
 public:
@@ -59,6 +88,15 @@ public:
   int on_disconnect();
   void clear_sql_session_info();
   void set_sql_session_info(void* sess);
+private:
+  bool try_coalesce_response(const char* buf, int64_t sz);
+  int flush_coalesced_response(const char*& buf, int64_t& sz);
+public:
+  // responses of pipelined requests are held until the size or time limit is reached,
+  // or no more request is received, then they are written at once. 0 means disabled.
+  // held responses also wait for the next request to finish.
+  static int64_t RESPONSE_COALESCE_SIZE;
+  static int64_t RESPONSE_COALESCE_TIME;
   ObSqlNio& nio_;
   ObISMConnectionCallback& sm_conn_cb_;
   rpc::ObRequest sql_req_;
@@ -67,6 +105,7 @@ public:
   int64_t last_pkt_sz_; // to be consumed
   const char* pending_write_buf_;
   int64_t pending_write_sz_;
+  ObSqlResponseCoalescer coalescer_;
   common::ObAddr client_addr_;
 };
 
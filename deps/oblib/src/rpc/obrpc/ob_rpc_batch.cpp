@@ -0,0 +1,720 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX RPC_OBRPC
+#include "rpc/obrpc/ob_rpc_batch.h"
+#include "rpc/obrpc/ob_rpc_proxy.h"
+#include "rpc/ob_rpc_request_operator.h"
+#include "lib/thread/ob_thread_name.h"
+#include "lib/utility/utility.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::rpc;
+using namespace oceanbase::rpc::frame;
+namespace oceanbase
+{
+namespace obrpc
+{
+int64_t ObRpcBatchClient::BATCH_WINDOW = 0;
+ObRpcBatchClient global_rpc_batch_client;
+
+class ObRpcBatchSPAlloc: public SPAlloc
+{
+public:
+  ObRpcBatchSPAlloc(ObRpcMemPool& pool): pool_(pool) {}
+  virtual ~ObRpcBatchSPAlloc() {}
+  void* alloc(int64_t sz) const {
+    return pool_.alloc(sz);
+  }
+private:
+  ObRpcMemPool& pool_;
+};
+
+static void fail_ucb(UAsyncCB& ucb, int easy_err)
+{
+  ucb.set_error(easy_err);
+  if (OB_SUCCESS != ucb.on_error(easy_err)) {
+    ucb.on_timeout();
+  }
+}
+
+ObRpcBatchFrame* ObRpcBatchFrame::create(const ObAddr& dst)
+{
+  ObRpcBatchFrame* frame = NULL;
+  ObRpcMemPool* pool = NULL;
+  if (NULL == (pool = ObRpcMemPool::create(sizeof(ObRpcBatchFrame)))) {
+    LOG_WARN("create rpc batch frame pool fail", K(dst));
+  } else if (NULL == (frame = (ObRpcBatchFrame*)pool->alloc(sizeof(ObRpcBatchFrame)))) {
+    LOG_WARN("alloc rpc batch frame fail", K(dst));
+    pool->destroy();
+  } else {
+    new(frame)ObRpcBatchFrame(*pool, dst);
+  }
+  return frame;
+}
+
+bool ObRpcBatchFrame::need_response() const
+{
+  bool bret = false;
+  for (int64_t i = 0; !bret && i < cnt_; i++) {
+    bret = NULL != entries_[i].cb_;
+  }
+  return bret;
+}
+
+bool ObRpcBatchFrame::can_add(ObRpcPacketCode pcode, int64_t req_sz, int64_t timeout) const
+{
+  return 0 == cnt_
+      || (cnt_ < MAX_BATCH_CNT
+          && pcode == pcode_
+          && timeout == timeout_
+          && get_encoded_size() + serialization::encoded_length_i64(req_sz) + req_sz <= MAX_FRAME_SIZE);
+}
+
+void ObRpcBatchFrame::add(ObRpcPacketCode pcode, const char* req, int64_t req_sz, UAsyncCB* cb, int64_t timeout)
+{
+  if (0 == cnt_) {
+    start_ts_ = ObTimeUtility::current_time();
+    pcode_ = pcode;
+    // 合并包里子请求的超时都相同, 发送时再扣掉在窗口里等待的时间
+    timeout_ = timeout;
+  }
+  entries_[cnt_].req_ = req;
+  entries_[cnt_].req_sz_ = req_sz;
+  entries_[cnt_].cb_ = cb;
+  cnt_++;
+  sz_ += serialization::encoded_length_i64(req_sz) + req_sz;
+}
+
+UAsyncCB* ObRpcBatchFrame::clone_cb(const UAsyncCB& ucb)
+{
+  ObRpcBatchSPAlloc sp_alloc(pool_);
+  return ucb.clone(sp_alloc);
+}
+
+int64_t ObRpcBatchFrame::get_encoded_size() const
+{
+  return serialization::encoded_length_i64(cnt_) + sz_;
+}
+
+int ObRpcBatchFrame::encode(char* buf, int64_t len, int64_t& pos) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(serialization::encode_i64(buf, len, pos, cnt_))) {
+    LOG_WARN("encode batch cnt fail", K(ret), K(len), K(pos));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < cnt_; i++) {
+    const Entry& entry = entries_[i];
+    if (OB_FAIL(serialization::encode_i64(buf, len, pos, entry.req_sz_))) {
+      LOG_WARN("encode batch entry size fail", K(ret), K(len), K(pos));
+    } else if (pos + entry.req_sz_ > len) {
+      ret = OB_BUF_NOT_ENOUGH;
+      LOG_WARN("batch buffer not enough", K(ret), K(len), K(pos), K(entry.req_sz_));
+    } else {
+      MEMCPY(buf + pos, entry.req_, entry.req_sz_);
+      pos += entry.req_sz_;
+    }
+  }
+  return ret;
+}
+
+int ObRpcBatchFrame::decode_entry(const char* buf, int64_t len, int64_t& pos, const char*& entry, int64_t& entry_sz)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(serialization::decode_i64(buf, len, pos, &entry_sz))) {
+    LOG_WARN("decode batch entry size fail", K(ret), K(len), K(pos));
+  } else if (entry_sz < 0 || pos + entry_sz > len) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid batch entry size", K(ret), K(len), K(pos), K(entry_sz));
+  } else {
+    entry = buf + pos;
+    pos += entry_sz;
+  }
+  return ret;
+}
+
+void ObRpcBatchFrame::handle_resp(char* buf, int64_t len)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  int64_t cnt = 0;
+  if (OB_FAIL(serialization::decode_i64(buf, len, pos, &cnt))) {
+    LOG_WARN("decode batch resp cnt fail", K(ret), K(len));
+  } else if (cnt != cnt_) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("batch resp cnt not match", K(ret), K(cnt), K(*this));
+  }
+  for (int64_t i = 0; i < cnt_; i++) {
+    UAsyncCB* cb = entries_[i].cb_;
+    const char* resp = NULL;
+    int64_t resp_sz = 0;
+    ObRpcPacket* pkt = NULL;
+    int tmp_ret = OB_SUCCESS;
+    if (OB_FAIL(ret)) {
+      if (NULL != cb) {
+        cb->on_invalid();
+      }
+    } else if (OB_FAIL(decode_entry(buf, len, pos, resp, resp_sz))) {
+      if (NULL != cb) {
+        cb->on_invalid();
+      }
+    } else if (NULL == cb) {
+      // unneed response
+    } else if (0 == resp_sz) {
+      // 服务端没有产生应答, 和单独发送时一样按出错处理
+      fail_ucb(*cb, EASY_ERROR);
+    } else if (OB_SUCCESS != (tmp_ret = rpc_decode_ob_packet(pool_, const_cast<char*>(resp), resp_sz, pkt))) {
+      cb->on_invalid();
+      LOG_WARN("rpc_decode_ob_packet fail", K(tmp_ret));
+    } else {
+      cb->record_stat(false);
+      if (OB_SUCCESS != (tmp_ret = cb->decode(pkt))) {
+        cb->on_invalid();
+        LOG_WARN("ucb.decode fail", K(tmp_ret));
+      } else {
+        if (OB_SUCCESS != (tmp_ret = cb->process())) {
+          LOG_WARN("ucb.process fail", K(tmp_ret));
+        }
+        if (cb->get_cloned()) {
+          cb->reset_rcode();
+        }
+      }
+    }
+  }
+}
+
+void ObRpcBatchFrame::handle_error(int easy_err)
+{
+  for (int64_t i = 0; i < cnt_; i++) {
+    UAsyncCB* cb = entries_[i].cb_;
+    if (NULL != cb) {
+      cb->record_stat(true);
+      fail_ucb(*cb, easy_err);
+    }
+  }
+}
+
+void ObRpcBatchFrame::handle_invalid()
+{
+  for (int64_t i = 0; i < cnt_; i++) {
+    UAsyncCB* cb = entries_[i].cb_;
+    if (NULL != cb) {
+      cb->on_invalid();
+    }
+  }
+}
+
+// 合并包的回调, 收到应答后拆开分发给各个子请求的回调
+class ObRpcBatchCB: public UAsyncCB
+{
+public:
+  ObRpcBatchCB(ObRpcBatchFrame& frame):
+      UAsyncCB(OB_RPC_BATCH_FRAME), frame_(frame), pkt_(NULL), pos_(0), cloned_(false) {}
+  virtual ~ObRpcBatchCB() {}
+  UAsyncCB* clone(const SPAlloc& alloc) const
+  {
+    UAsyncCB* cb = NULL;
+    void* buf = alloc.alloc(sizeof(*this));
+    if (NULL != buf) {
+      cb = new(buf) ObRpcBatchCB(frame_);
+    }
+    return cb;
+  }
+  int decode(void* pkt)
+  {
+    int ret = OB_SUCCESS;
+    pos_ = 0;
+    if (OB_ISNULL(pkt_ = reinterpret_cast<ObRpcPacket*>(pkt))) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_WARN("pkt should not be NULL", K(ret));
+    } else if (OB_FAIL(pkt_->verify_checksum())) {
+      LOG_ERROR("verify checksum fail", K(*pkt_), K(ret));
+    } else if (OB_FAIL(rcode_.deserialize(pkt_->get_cdata(), pkt_->get_clen(), pos_))) {
+      LOG_WARN("decode result code fail", K(*pkt_), K(ret));
+    }
+    return ret;
+  }
+  int process()
+  {
+    int ret = OB_SUCCESS;
+    if (OB_SUCCESS != rcode_.rcode_) {
+      ret = rcode_.rcode_;
+      LOG_WARN("rpc batch frame fail", K(ret), K(frame_));
+      frame_.handle_error(EASY_ERROR);
+    } else {
+      frame_.handle_resp(const_cast<char*>(pkt_->get_cdata()) + pos_, pkt_->get_clen() - pos_);
+    }
+    frame_.destroy();
+    return ret;
+  }
+  int get_rcode() { return rcode_.rcode_; }
+  void reset_rcode() { rcode_.reset(); }
+  void set_cloned(bool cloned) { cloned_ = cloned; }
+  bool get_cloned() { return cloned_; }
+  void on_invalid()
+  {
+    frame_.handle_invalid();
+    frame_.destroy();
+  }
+  void on_timeout()
+  {
+    frame_.handle_error(EASY_TIMEOUT);
+    frame_.destroy();
+  }
+  int on_error(int err)
+  {
+    frame_.handle_error(err);
+    frame_.destroy();
+    return OB_SUCCESS;
+  }
+private:
+  ObRpcBatchFrame& frame_;
+  ObRpcPacket* pkt_;
+  int64_t pos_;
+  ObRpcResultCode rcode_;
+  bool cloned_;
+};
+
+static ObRpcProxy& get_frame_proxy()
+{
+  static ObRpcProxy proxy;
+  return proxy;
+}
+
+int ObRpcBatchClient::init(const ObReqTransport* transport)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("rpc batch client init twice", K(ret));
+  } else if (OB_ISNULL(transport)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid transport", K(ret));
+  } else if (OB_FAIL(get_frame_proxy().init(transport))) {
+    LOG_WARN("init rpc batch frame proxy fail", K(ret));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("init rpc batch cond fail", K(ret));
+  } else {
+    transport_ = transport;
+    set_thread_count(1);
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObRpcBatchClient::destroy()
+{
+  if (is_inited_) {
+    lib::ThreadPool::stop();
+    {
+      ObThreadCondGuard guard(cond_);
+      cond_.signal();
+    }
+    lib::ThreadPool::wait();
+    flush(0);
+    lib::ThreadPool::destroy();
+    cond_.destroy();
+    is_inited_ = false;
+  }
+  for (int64_t i = 0; i < MAX_DEST_CNT; i++) {
+    if (NULL != buffers_[i]) {
+      OB_DELETE(DestBuffer, "RpcBatchBuf", buffers_[i]);
+      buffers_[i] = NULL;
+    }
+  }
+}
+
+void ObRpcBatchClient::run1()
+{
+  lib::set_thread_name("RpcBatch");
+  while (!has_set_stop()) {
+    const int64_t window = ATOMIC_LOAD(&BATCH_WINDOW);
+    const int64_t seq = ATOMIC_LOAD(&new_frame_seq_);
+    // 窗口关闭后残留的包也要立即发出去
+    const int64_t next_flush_ts = flush(window);
+    if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      print_stat();
+    }
+    // 睡到最早的合并包窗口结束, 没有待发的包就等到新建合并包时被唤醒
+    const int64_t wait_us = INT64_MAX == next_flush_ts
+        ? 100 * 1000 : next_flush_ts - ObTimeUtility::current_time();
+    if (wait_us > 0) {
+      ObThreadCondGuard guard(cond_);
+      ATOMIC_STORE(&is_idle_, true);
+      if (seq == ATOMIC_LOAD(&new_frame_seq_) && !has_set_stop()) {
+        cond_.wait_us(wait_us);
+      }
+      ATOMIC_STORE(&is_idle_, false);
+    }
+  }
+}
+
+bool ObRpcBatchClient::can_batch(const ObRpcProxy& proxy, const ObAddr& addr) const
+{
+  return is_inited_
+      && proxy.transport_ == transport_
+      && proxy.init_
+      && proxy.active_
+      && !proxy.do_ratelimit_
+      && ObRpcProxy::BACKGROUND_FLOW != proxy.is_bg_flow_
+      && !ObCompressorPool::get_instance().need_common_compress(proxy.compressor_type_)
+      && addr.is_valid();
+}
+
+int64_t ObRpcBatchClient::get_proxy_timeout(const ObRpcProxy& proxy)
+{
+  return proxy.timeout_;
+}
+
+ObRpcBatchClient::DestBuffer* ObRpcBatchClient::fetch_buffer(const ObAddr& addr, ObRpcPacketCode pcode)
+{
+  DestBuffer* buffer = NULL;
+  DestBuffer* new_buffer = NULL;
+  const uint64_t start = (addr.hash() * 31 + pcode) % MAX_DEST_CNT;
+  for (int64_t i = 0; NULL == buffer && i < MAX_DEST_CNT; i++) {
+    DestBuffer** slot = &buffers_[(start + i) % MAX_DEST_CNT];
+    DestBuffer* cur = ATOMIC_LOAD(slot);
+    if (NULL == cur) {
+      if (NULL == new_buffer && NULL == (new_buffer = OB_NEW(DestBuffer, "RpcBatchBuf", addr, pcode))) {
+        LOG_WARN("alloc rpc batch buffer fail", K(addr), K(pcode));
+        break;
+      } else if (ATOMIC_BCAS(slot, NULL, new_buffer)) {
+        cur = new_buffer;
+        new_buffer = NULL;
+      } else {
+        cur = ATOMIC_LOAD(slot);
+      }
+    }
+    if (cur->dst_ == addr && cur->pcode_ == pcode) {
+      buffer = cur;
+    }
+  }
+  if (NULL != new_buffer) {
+    OB_DELETE(DestBuffer, "RpcBatchBuf", new_buffer);
+  }
+  return buffer;
+}
+
+int ObRpcBatchClient::prepare_frame(DestBuffer& buffer, int64_t req_sz, int64_t timeout, ObRpcBatchFrame*& frame,
+                                    ObRpcBatchFrame*& full_frame, bool& is_new_frame)
+{
+  int ret = OB_SUCCESS;
+  // 超时不同的请求不放进同一个合并包, 当前的包先发出去
+  if (NULL != buffer.frame_ && !buffer.frame_->can_add(buffer.pcode_, req_sz, timeout)) {
+    full_frame = buffer.frame_;
+    buffer.frame_ = NULL;
+  }
+  if (NULL != buffer.frame_) {
+    frame = buffer.frame_;
+  } else if (NULL == (buffer.frame_ = ObRpcBatchFrame::create(buffer.dst_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    is_new_frame = true;
+    frame = buffer.frame_;
+  }
+  return ret;
+}
+
+void ObRpcBatchClient::inc_batched_cnt(ObRpcPacketCode pcode)
+{
+  EVENT_INC(RPC_BATCH_REQ_COUNT);
+  ATOMIC_INC(&batched_cnt_[ObRpcPacketSet::instance().idx_of_pcode(pcode)]);
+}
+
+void ObRpcBatchClient::wakeup_flusher()
+{
+  ATOMIC_INC(&new_frame_seq_);
+  if (ATOMIC_LOAD(&is_idle_)) {
+    ObThreadCondGuard guard(cond_);
+    cond_.signal();
+  }
+}
+
+// 发出窗口已经结束的合并包, 返回剩下的包中最早的窗口结束时间
+int64_t ObRpcBatchClient::flush(int64_t window)
+{
+  const int64_t now = ObTimeUtility::current_time();
+  int64_t next_flush_ts = INT64_MAX;
+  for (int64_t i = 0; i < MAX_DEST_CNT; i++) {
+    DestBuffer* buffer = ATOMIC_LOAD(&buffers_[i]);
+    ObRpcBatchFrame* frame = NULL;
+    if (NULL != buffer) {
+      {
+        ObSpinLockGuard guard(buffer->lock_);
+        if (NULL == buffer->frame_) {
+        } else if (window <= 0 || now - buffer->frame_->get_start_ts() >= window) {
+          frame = buffer->frame_;
+          buffer->frame_ = NULL;
+        } else {
+          next_flush_ts = std::min(next_flush_ts, buffer->frame_->get_start_ts() + window);
+        }
+      }
+      if (NULL != frame) {
+        send(frame);
+      }
+    }
+  }
+  return next_flush_ts;
+}
+
+int ObRpcBatchClient::send(ObRpcBatchFrame* frame)
+{
+  int ret = OB_SUCCESS;
+  ObReqTransport::Request req;
+  ObRpcBatchCB cb(*frame);
+  ObRpcOpts opts;
+  const bool need_response = frame->need_response();
+  const int64_t payload = frame->get_encoded_size();
+  // 子请求的超时从加入合并包时算起, 不因为在窗口里等待而延后
+  const int64_t timeout = frame->get_remain_timeout(ObTimeUtility::current_time());
+  int easy_err = EASY_ERROR;
+  int64_t pos = 0;
+  if (timeout <= 0) {
+    ret = OB_TIMEOUT;
+    easy_err = EASY_TIMEOUT;
+    LOG_WARN("rpc batch frame timeout before sent", K(ret), K(*frame));
+  } else if (OB_FAIL(ObRpcProxy::create_request(OB_RPC_BATCH_FRAME, *transport_, req, frame->get_dst(), payload,
+                                                timeout, ObAddr(), false, 0, ObString(),
+                                                need_response ? &cb : NULL))) {
+    LOG_WARN("create rpc batch request fail", K(ret), K(*frame));
+  } else if (OB_ISNULL(req.pkt()) || OB_ISNULL(req.buf())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("request packet is NULL", K(ret));
+  } else if (OB_FAIL(frame->encode(req.buf(), payload, pos))) {
+    LOG_WARN("encode rpc batch frame fail", K(ret), K(*frame));
+  } else {
+    req.pkt()->set_content(req.buf(), pos);
+    if (OB_FAIL(get_frame_proxy().init_pkt(req.pkt(), OB_RPC_BATCH_FRAME, opts, !need_response))) {
+      LOG_WARN("init packet fail", K(ret));
+    } else {
+      req.pkt()->set_timeout(timeout);
+      req.set_async();
+      if (OB_FAIL(transport_->post(req))) {
+        LOG_WARN("post rpc batch frame fail", K(ret), K(*frame));
+        req.destroy();
+      } else {
+        EVENT_INC(RPC_BATCH_FRAME_COUNT);
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // 上层已经认为请求发送成功, 只能通过回调通知失败
+    frame->handle_error(easy_err);
+    frame->destroy();
+  } else if (!need_response) {
+    frame->destroy();
+  }
+  return ret;
+}
+
+void ObRpcBatchClient::print_stat()
+{
+  const ObRpcPacketSet& set = ObRpcPacketSet::instance();
+  for (int64_t i = 0; i < ObRpcPacketSet::THE_PCODE_COUNT; i++) {
+    const int64_t cnt = ATOMIC_LOAD(&batched_cnt_[i]);
+    if (cnt > 0) {
+      LOG_INFO("rpc batch statistics", "pcode", set.name_of_idx(i), K(cnt));
+    }
+  }
+}
+
+void* ObRpcBatchServerHandleContext::SubContext::alloc(int64_t sz)
+{
+  if (NULL != resp_buf_) {
+    ob_free(resp_buf_);
+  }
+  resp_buf_ = ob_malloc(sz, ObMemAttr(OB_SERVER_TENANT_ID, "RpcBatchResp"));
+  return resp_buf_;
+}
+
+void ObRpcBatchServerHandleContext::SubContext::resp(ObRpcPacket* pkt)
+{
+  int ret = OB_SUCCESS;
+  if (NULL != pkt) {
+    const int64_t sz = pkt->get_encoded_size();
+    int64_t pos = 0;
+    if (NULL == (resp_ = (char*)ob_malloc(sz, ObMemAttr(OB_SERVER_TENANT_ID, "RpcBatchResp")))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc batch response fail", K(ret), K(sz));
+    } else if (OB_FAIL(pkt->encode_header(resp_, sz, pos))) {
+      LOG_WARN("encode header fail", K(ret), K(sz));
+      ob_free(resp_);
+      resp_ = NULL;
+    } else {
+      MEMCPY(resp_ + pos, pkt->get_cdata(), pkt->get_clen());
+      resp_sz_ = sz;
+    }
+  }
+  if (NULL != resp_buf_) {
+    ob_free(resp_buf_);
+    resp_buf_ = NULL;
+  }
+  ctx_.dec_ref();
+}
+
+int ObRpcBatchServerHandleContext::deliver(ObRequest& req, ObReqDeliver& deliver)
+{
+  int ret = OB_SUCCESS;
+  ObRpcMemPool* pool = NULL;
+  ObRpcBatchServerHandleContext* ctx = NULL;
+  if (NULL == (pool = ObRpcMemPool::create(sizeof(ObRpcBatchServerHandleContext)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("create rpc batch pool fail", K(ret));
+  } else if (NULL == (ctx = (ObRpcBatchServerHandleContext*)pool->alloc(sizeof(ObRpcBatchServerHandleContext)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc rpc batch context fail", K(ret));
+    pool->destroy();
+  } else {
+    new(ctx)ObRpcBatchServerHandleContext(*pool, req);
+    if (OB_FAIL(ctx->split())) {
+      LOG_WARN("split rpc batch frame fail", K(ret));
+      ctx->destroy();
+    } else {
+      const int64_t cnt = ctx->cnt_;
+      for (int64_t i = 0; i < cnt; i++) {
+        // 投递失败的子请求已经由 deliver 回了错误包
+        int tmp_ret = deliver.deliver(ctx->subs_[i].req_);
+        if (OB_SUCCESS != tmp_ret) {
+          LOG_WARN("deliver batch sub request fail", K(tmp_ret), K(i));
+        }
+      }
+      ctx->dec_ref();
+    }
+  }
+  return ret;
+}
+
+int ObRpcBatchServerHandleContext::split()
+{
+  int ret = OB_SUCCESS;
+  const ObRpcPacket& pkt = reinterpret_cast<const ObRpcPacket&>(req_.get_packet());
+  const char* buf = pkt.get_cdata();
+  const int64_t len = pkt.get_clen();
+  const int64_t now = ObTimeUtility::current_time();
+  int64_t pos = 0;
+  int64_t cnt = 0;
+  if (OB_FAIL(serialization::decode_i64(buf, len, pos, &cnt))) {
+    LOG_WARN("decode batch cnt fail", K(ret), K(len));
+  } else if (cnt <= 0 || cnt > ObRpcBatchFrame::MAX_BATCH_CNT) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid batch cnt", K(ret), K(cnt));
+  } else if (NULL == (subs_ = (SubContext*)pool_.alloc(sizeof(SubContext) * cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc batch sub context fail", K(ret), K(cnt));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+    const char* entry = NULL;
+    int64_t entry_sz = 0;
+    ObRpcPacket* sub_pkt = NULL;
+    if (OB_FAIL(ObRpcBatchFrame::decode_entry(buf, len, pos, entry, entry_sz))) {
+      LOG_WARN("decode batch entry fail", K(ret), K(i));
+    } else if (OB_FAIL(rpc_decode_ob_packet(pool_, const_cast<char*>(entry), entry_sz, sub_pkt))) {
+      LOG_WARN("rpc_decode_ob_packet fail", K(ret), K(i));
+    } else if (sub_pkt->is_stream() || OB_RPC_BATCH_FRAME == sub_pkt->get_pcode()) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("rpc can not be batched", K(ret), K(*sub_pkt));
+    } else {
+      SubContext* sub = new(subs_ + i) SubContext(*this);
+      sub->req_.set_server_handle_context(sub);
+      sub->req_.set_packet(sub_pkt);
+      sub->req_.set_receive_timestamp(req_.get_receive_timestamp());
+      sub->req_.set_request_arrival_time(req_.get_request_arrival_time());
+      sub->req_.set_arrival_push_diff(now);
+      cnt_++;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ref_ = cnt_ + 1;
+  }
+  return ret;
+}
+
+void ObRpcBatchServerHandleContext::dec_ref()
+{
+  if (0 == ATOMIC_AAF(&ref_, -1)) {
+    resp();
+    destroy();
+  }
+}
+
+void ObRpcBatchServerHandleContext::resp()
+{
+  int ret = OB_SUCCESS;
+  const ObRpcPacket& pkt = reinterpret_cast<const ObRpcPacket&>(req_.get_packet());
+  ObRpcPacket* resp_pkt = NULL;
+  if (!pkt.unneed_response()) {
+    ObRpcResultCode rcode;
+    const int64_t header_sz = OB_NET_HEADER_LENGTH + ObRpcPacket::get_header_size();
+    int64_t content_sz = rcode.get_serialize_size() + serialization::encoded_length_i64(cnt_);
+    char* buf = NULL;
+    for (int64_t i = 0; i < cnt_; i++) {
+      content_sz += serialization::encoded_length_i64(subs_[i].resp_sz_) + subs_[i].resp_sz_;
+    }
+    if (NULL == (buf = (char*)RPC_REQ_OP.alloc_response_buffer(&req_, sizeof(ObRpcPacket) + header_sz + content_sz))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc batch response buffer fail", K(ret), K(content_sz));
+    } else {
+      char* content = buf + sizeof(ObRpcPacket) + header_sz;
+      int64_t pos = 0;
+      if (OB_FAIL(rcode.serialize(content, content_sz, pos))) {
+        LOG_WARN("serialize result code fail", K(ret));
+      } else if (OB_FAIL(serialization::encode_i64(content, content_sz, pos, cnt_))) {
+        LOG_WARN("encode batch cnt fail", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < cnt_; i++) {
+        if (OB_FAIL(serialization::encode_i64(content, content_sz, pos, subs_[i].resp_sz_))) {
+          LOG_WARN("encode batch entry size fail", K(ret), K(i));
+        } else if (subs_[i].resp_sz_ > 0) {
+          MEMCPY(content + pos, subs_[i].resp_, subs_[i].resp_sz_);
+          pos += subs_[i].resp_sz_;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        resp_pkt = new(buf) ObRpcPacket();
+        resp_pkt->set_content(content, pos);
+        resp_pkt->set_pcode(pkt.get_pcode());
+        resp_pkt->set_chid(pkt.get_chid());
+        resp_pkt->set_session_id(0);
+        resp_pkt->set_trace_id(pkt.get_trace_id());
+        resp_pkt->set_resp();
+        resp_pkt->set_dst_cluster_id(pkt.get_src_cluster_id());
+        resp_pkt->set_unis_version(pkt.get_unis_version());
+        resp_pkt->calc_checksum();
+        EVENT_INC(RPC_PACKET_OUT);
+        EVENT_ADD(RPC_PACKET_OUT_BYTES, pos + header_sz);
+      }
+    }
+  }
+  RPC_REQ_OP.response_result(&req_, resp_pkt);
+  if (ObRequest::TRANSPORT_PROTO_EASY == req_.get_nio_protocol() && NULL != EASY_IOTH_SELF) {
+    // 子请求都在网络线程里应答了(例如全部被拒绝), easy 不会唤醒这个请求
+    easy_request_wakeup(req_.get_ez_req());
+  }
+}
+
+void ObRpcBatchServerHandleContext::destroy()
+{
+  for (int64_t i = 0; i < cnt_; i++) {
+    SubContext& sub = subs_[i];
+    if (NULL != sub.resp_) {
+      ob_free(sub.resp_);
+    }
+    if (NULL != sub.resp_buf_) {
+      ob_free(sub.resp_buf_);
+    }
+    sub.~SubContext();
+  }
+  pool_.destroy();
+}
+
+}; // end namespace obrpc
+}; // end namespace oceanbase
@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_OBRPC_OB_RPC_BATCH_H_
+#define OCEANBASE_OBRPC_OB_RPC_BATCH_H_
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/thread/thread_pool.h"
+#include "lib/stat/ob_diagnose_info.h"
+#include "rpc/frame/ob_req_transport.h"
+#include "rpc/frame/ob_req_deliver.h"
+#include "rpc/obrpc/ob_rpc_endec.h"
+#include "rpc/obrpc/ob_poc_rpc_proxy.h"
+#include "rpc/ob_request.h"
+
+namespace oceanbase
+{
+namespace obrpc
+{
+class ObRpcProxy;
+
+/*
+ * 发往同一目的端的多个小请求合并成一个 OB_RPC_BATCH_FRAME 包.
+ * 请求和应答的 content 格式相同: [cnt][size, ObRpcPacket] * cnt,
+ * 应答 content 前面多一个 ObRpcResultCode. 子包的编码与单独发送时完全一致,
+ * 服务端拆包后按普通请求投递, 各自应答后再合并成一个应答包.
+ * 合并包要等所有子请求都处理完才应答, 超时也只有一个, 所以一个合并包里只放
+ * pcode 和超时都相同的请求, 避免慢请求拖住快请求, 也避免子请求超时后迟迟不回调.
+ */
+class ObRpcBatchFrame
+{
+public:
+  enum { MAX_BATCH_CNT = 64, MAX_FRAME_SIZE = 1<<16 };
+  struct Entry
+  {
+    const char* req_;
+    int64_t req_sz_;
+    UAsyncCB* cb_;
+  };
+  ObRpcBatchFrame(ObRpcMemPool& pool, const common::ObAddr& dst):
+      pool_(pool), dst_(dst), pcode_(OB_INVALID_RPC_CODE), cnt_(0), sz_(0), start_ts_(0), timeout_(0) {}
+  ~ObRpcBatchFrame() {}
+  static ObRpcBatchFrame* create(const common::ObAddr& dst);
+  void destroy() { pool_.destroy(); }
+  ObRpcMemPool& get_pool() { return pool_; }
+  const common::ObAddr& get_dst() const { return dst_; }
+  ObRpcPacketCode get_pcode() const { return pcode_; }
+  int64_t get_cnt() const { return cnt_; }
+  int64_t get_start_ts() const { return start_ts_; }
+  int64_t get_timeout() const { return timeout_; }
+  // 从第一个子请求加入算起, 合并包剩余的超时时间
+  int64_t get_remain_timeout(int64_t now) const { return timeout_ - (now - start_ts_); }
+  bool need_response() const;
+  bool can_add(ObRpcPacketCode pcode, int64_t req_sz, int64_t timeout) const;
+  void add(ObRpcPacketCode pcode, const char* req, int64_t req_sz, UAsyncCB* cb, int64_t timeout);
+  UAsyncCB* clone_cb(const UAsyncCB& ucb);
+  int64_t get_encoded_size() const;
+  int encode(char* buf, int64_t len, int64_t& pos) const;
+  static int decode_entry(const char* buf, int64_t len, int64_t& pos, const char*& entry, int64_t& entry_sz);
+  void handle_resp(char* buf, int64_t len);
+  void handle_error(int easy_err);
+  void handle_invalid();
+  TO_STRING_KV(K_(dst), K_(pcode), K_(cnt), K_(sz), K_(start_ts), K_(timeout));
+private:
+  ObRpcMemPool& pool_;
+  common::ObAddr dst_;
+  ObRpcPacketCode pcode_;
+  int64_t cnt_;
+  int64_t sz_;
+  int64_t start_ts_;
+  int64_t timeout_;
+  Entry entries_[MAX_BATCH_CNT];
+};
+
+class ObRpcBatchClient: public lib::ThreadPool
+{
+public:
+  // 每个目的端的每种 pcode 占一个 DestBuffer
+  enum { MAX_DEST_CNT = 4096, MAX_BATCH_REQ_SIZE = 4096 };
+  // 合并窗口, 单位 us, 0 表示不合并
+  static int64_t BATCH_WINDOW;
+  struct DestBuffer
+  {
+    DestBuffer(const common::ObAddr& dst, ObRpcPacketCode pcode): dst_(dst), pcode_(pcode), frame_(NULL) {}
+    common::ObSpinLock lock_;
+    common::ObAddr dst_;
+    ObRpcPacketCode pcode_;
+    ObRpcBatchFrame* frame_;
+  };
+  ObRpcBatchClient(): transport_(NULL), is_inited_(false), new_frame_seq_(0), is_idle_(false)
+  {
+    memset(buffers_, 0, sizeof(buffers_));
+    memset(batched_cnt_, 0, sizeof(batched_cnt_));
+  }
+  virtual ~ObRpcBatchClient() { destroy(); }
+  int init(const rpc::frame::ObReqTransport* transport);
+  void destroy();
+  void run1() override;
+  template<typename Input, typename UCB>
+      bool need_batch(ObRpcProxy& proxy, const common::ObAddr& addr, ObRpcPacketCode pcode, const Input& args, UCB* ucb, const ObRpcOpts& opts) const {
+    UNUSED(pcode);
+    UNUSED(ucb);
+    UNUSED(opts);
+    return ATOMIC_LOAD(&BATCH_WINDOW) > 0
+        && common::serialization::encoded_length(args) <= MAX_BATCH_REQ_SIZE
+        && can_batch(proxy, addr);
+  }
+  template<typename Input, typename UCB>
+      int post(ObRpcProxy& proxy, const common::ObAddr& addr, ObRpcPacketCode pcode, const Input& args, UCB* ucb, const ObRpcOpts& opts) {
+    int ret = common::OB_SUCCESS;
+    const int64_t start_ts = common::ObTimeUtility::current_time();
+    const int64_t est_sz = ObRpcPacket::get_header_size() + calc_extra_payload_size()
+        + common::serialization::encoded_length(args);
+    const int64_t timeout = get_proxy_timeout(proxy);
+    DestBuffer* buffer = NULL;
+    ObRpcBatchFrame* full_frame = NULL;
+    bool is_new_frame = false;
+    if (NULL == (buffer = fetch_buffer(addr, pcode))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      RPC_OBRPC_LOG(WARN, "fetch batch buffer fail", K(ret), K(addr));
+    } else {
+      common::ObSpinLockGuard guard(buffer->lock_);
+      ObRpcBatchFrame* frame = NULL;
+      UAsyncCB* cb = NULL;
+      char* req = NULL;
+      int64_t req_sz = 0;
+      if (OB_FAIL(prepare_frame(*buffer, est_sz, timeout, frame, full_frame, is_new_frame))) {
+        RPC_OBRPC_LOG(WARN, "prepare batch frame fail", K(ret), K(addr));
+      } else if (OB_FAIL(rpc_encode_req(proxy, frame->get_pool(), pcode, args, opts, req, req_sz, NULL == ucb))) {
+        RPC_OBRPC_LOG(WARN, "rpc encode req fail", K(ret));
+      } else if (NULL != ucb && NULL == (cb = frame->clone_cb(*ucb))) {
+        ret = common::OB_ALLOCATE_MEMORY_FAILED;
+        RPC_OBRPC_LOG(WARN, "ucb.clone fail", K(ret));
+      } else {
+        if (NULL != cb) {
+          init_ucb(proxy, *cb, addr, start_ts, req_sz);
+          set_ucb_args(*static_cast<UCB*>(cb), args);
+        }
+        frame->add(pcode, req, req_sz, cb, timeout);
+        inc_batched_cnt(pcode);
+      }
+    }
+    if (NULL != full_frame) {
+      send(full_frame);
+    }
+    if (is_new_frame) {
+      wakeup_flusher();
+    }
+    return ret;
+  }
+private:
+  bool can_batch(const ObRpcProxy& proxy, const common::ObAddr& addr) const;
+  static int64_t get_proxy_timeout(const ObRpcProxy& proxy);
+  DestBuffer* fetch_buffer(const common::ObAddr& addr, ObRpcPacketCode pcode);
+  int prepare_frame(DestBuffer& buffer, int64_t req_sz, int64_t timeout, ObRpcBatchFrame*& frame,
+                    ObRpcBatchFrame*& full_frame, bool& is_new_frame);
+  void inc_batched_cnt(ObRpcPacketCode pcode);
+  void wakeup_flusher();
+  int64_t flush(int64_t window);
+  int send(ObRpcBatchFrame* frame);
+  void print_stat();
+private:
+  const rpc::frame::ObReqTransport* transport_;
+  bool is_inited_;
+  // 发送线程没有待发的包时在 cond_ 上等待, 新建合并包时唤醒
+  common::ObThreadCond cond_;
+  int64_t new_frame_seq_;
+  bool is_idle_;
+  DestBuffer* buffers_[MAX_DEST_CNT];
+  int64_t batched_cnt_[ObRpcPacketSet::THE_PCODE_COUNT];
+};
+
+// 服务端拆包上下文, 所有子请求应答后合并成一个应答包回给对端
+class ObRpcBatchServerHandleContext
+{
+public:
+  struct SubContext
+  {
+    SubContext(ObRpcBatchServerHandleContext& ctx):
+        ctx_(ctx), req_(rpc::ObRequest::OB_RPC, rpc::ObRequest::TRANSPORT_PROTO_BATCH),
+        resp_buf_(NULL), resp_(NULL), resp_sz_(0) {}
+    ~SubContext() {}
+    void* alloc(int64_t sz);
+    void resp(ObRpcPacket* pkt);
+    ObRpcBatchServerHandleContext& ctx_;
+    rpc::ObRequest req_;
+    void* resp_buf_;
+    char* resp_;
+    int64_t resp_sz_;
+  };
+  ObRpcBatchServerHandleContext(ObRpcMemPool& pool, rpc::ObRequest& req):
+      pool_(pool), req_(req), cnt_(0), ref_(0), subs_(NULL) {}
+  ~ObRpcBatchServerHandleContext() {}
+  static int deliver(rpc::ObRequest& req, rpc::frame::ObReqDeliver& deliver);
+  rpc::ObRequest& get_request() { return req_; }
+  void dec_ref();
+private:
+  int split();
+  void resp();
+  void destroy();
+private:
+  ObRpcMemPool& pool_;
+  rpc::ObRequest& req_;
+  int64_t cnt_;
+  int64_t ref_;
+  SubContext* subs_;
+};
+
+extern ObRpcBatchClient global_rpc_batch_client;
+#define RPC_BATCH_INTERCEPT(func, args...) if (global_rpc_batch_client.need_batch(*this, args)) return global_rpc_batch_client.func(*this, args);
+}; // end namespace obrpc
+}; // end namespace oceanbase
+
+#endif /* OCEANBASE_OBRPC_OB_RPC_BATCH_H_ */
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "rpc/obrpc/ob_rpc_batch_request_operator.h"
+#include "rpc/obrpc/ob_rpc_batch.h"
+
+using namespace oceanbase::rpc;
+namespace oceanbase
+{
+namespace obrpc
+{
+ObRpcBatchServerHandleContext::SubContext* get_batch_sub_context(const rpc::ObRequest* req)
+{
+  return (ObRpcBatchServerHandleContext::SubContext*)req->get_server_handle_context();
+}
+
+void* ObRpcBatchRequestOperator::alloc_response_buffer(ObRequest* req, int64_t size)
+{
+  return get_batch_sub_context(req)->alloc(size);
+}
+
+void ObRpcBatchRequestOperator::response_result(ObRequest* req, obrpc::ObRpcPacket* pkt)
+{
+  get_batch_sub_context(req)->resp(pkt);
+}
+
+ObAddr ObRpcBatchRequestOperator::get_peer(const ObRequest* req)
+{
+  return RPC_REQ_OP.get_peer(&get_batch_sub_context(req)->ctx_.get_request());
+}
+
+}; // end namespace obrpc
+}; // end namespace oceanbase
@@ -28,7 +28,8 @@ int init_packet(ObRpcProxy& proxy, ObRpcPacket& pkt, ObRpcPacketCode pcode, cons
                 const bool unneed_response);
 
 template <typename T>
-    int rpc_encode_req(ObRpcProxy& proxy, ObRpcMemPool& pool, ObRpcPacketCode pcode, const T& args, const ObRpcOpts& opts, char*& req, int64_t& req_sz)
+    int rpc_encode_req(ObRpcProxy& proxy, ObRpcMemPool& pool, ObRpcPacketCode pcode, const T& args, const ObRpcOpts& opts, char*& req, int64_t& req_sz,
+                   const bool unneed_response = false)
 {
   int ret = common::OB_SUCCESS;
   ObRpcPacket pkt;
@@ -53,7 +54,7 @@ template <typename T>
   } else {
     int64_t header_pos = 0;
     pkt.set_content(payload_buf, payload_sz);
-    if (OB_FAIL(init_packet(proxy, pkt, pcode, opts, false))) {
+    if (OB_FAIL(init_packet(proxy, pkt, pcode, opts, unneed_response))) {
       RPC_OBRPC_LOG(WARN, "init packet fail", K(ret));
     } else if (OB_FAIL(pkt.encode_header(header_buf, header_sz, header_pos))) {
       RPC_OBRPC_LOG(WARN, "encode header fail", K(ret));
@@ -23,6 +23,7 @@
 #include "lib/allocator/ob_tc_malloc.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
 #include "rpc/obrpc/ob_virtual_rpc_protocol_processor.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::common::serialization;
@@ -379,5 +380,17 @@ int ObRpcNetHandler::on_idle(easy_connection_t *c)
   return eret;
 }
 
+int ObRpcNetHandler::cleanup(easy_request_t *r, void *apacket)
+{
+  UNUSED(apacket);
+  // Server side request is done, its response has been written out or dropped along with
+  // the connection, so the buffers referenced by the response can be released. Client side
+  // sessions release them after the session is destroyed, see async_cb.
+  if (NULL != r && NULL != r->ms && EASY_TYPE_MESSAGE == r->ms->type && NULL != r->opacket) {
+    static_cast<ObRpcPacket*>(r->opacket)->destroy_sg_payload();
+  }
+  return EASY_OK;
+}
+
 } // end of namespace obrpc
 } // end of namespace oceanbase
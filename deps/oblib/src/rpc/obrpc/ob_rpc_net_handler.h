@@ -36,6 +36,7 @@ public:
     ez_handler_.on_connect     = oceanbase::easy::on_connect;
     ez_handler_.on_disconnect  = oceanbase::easy::on_disconnect;
     ez_handler_.new_keepalive_packet    = oceanbase::easy::new_keepalive_packet;
+    ez_handler_.cleanup        = oceanbase::easy::cleanup;
   }
 
   int try_decode_keepalive(easy_message_t *ms, int &result);
@@ -46,6 +47,7 @@ public:
   int on_connect(easy_connection_t *c);
   int on_disconnect(easy_connection_t *c);
   int on_idle(easy_connection_t *c);
+  int cleanup(easy_request_t *r, void *apacket);
 
 public:
   static int64_t CLUSTER_ID;
@@ -17,6 +17,7 @@
 #include "lib/coro/co_var.h"
 #include "common/storage/ob_sequence.h"
 #include "rpc/obrpc/ob_rpc_net_handler.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 
 using namespace oceanbase::common::serialization;
 using namespace oceanbase::common;
@@ -182,7 +183,7 @@ uint32_t ObRpcPacket::global_chid = 0;
 uint64_t ObRpcPacket::INVALID_CLUSTER_NAME_HASH = 0;
 
 ObRpcPacket::ObRpcPacket()
-    : cdata_(NULL), clen_(0), chid_(0), receive_ts_(0L),
+    : cdata_(NULL), clen_(0), chid_(0), receive_ts_(0L), sg_payload_(NULL),
       assemble_(false), msg_count_(0), payload_(0)
 {
   easy_list_init(&list_);
@@ -197,6 +198,27 @@ ObRpcPacket::~ObRpcPacket()
 {
 }
 
+uint64_t ObRpcPacket::calc_sg_checksum() const
+{
+  return sg_payload_->calc_checksum(cdata_, clen_);
+}
+
+void ObRpcPacket::fill_sg_payload()
+{
+  if (NULL != sg_payload_) {
+    // segment 在 content 中的位置是序列化时预留的, 可以直接写
+    sg_payload_->fill(const_cast<char*>(cdata_));
+  }
+}
+
+void ObRpcPacket::destroy_sg_payload()
+{
+  if (NULL != sg_payload_) {
+    ObRpcSGPayload::destroy(sg_payload_);
+    sg_payload_ = NULL;
+  }
+}
+
 int ObRpcPacket::encode_ez_header(char *buf, int64_t len, int64_t &pos)
 {
   int ret = OB_SUCCESS;
@@ -25,6 +25,7 @@ namespace oceanbase
 {
 namespace obrpc
 {
+class ObRpcSGPayload;
 
 enum ObRpcPriority
 {
@@ -196,6 +197,13 @@ public:
   inline void calc_checksum();
   inline int verify_checksum() const;
 
+  // content 中引用外部缓冲区的 segment, 只在发送端使用, 不序列化
+  inline void set_sg_payload(ObRpcSGPayload *sg_payload);
+  inline ObRpcSGPayload *get_sg_payload() const;
+  // 把 segment 拷回 content, 之后 content 自包含; 引用仍由 payload 的所有者释放
+  void fill_sg_payload();
+  void destroy_sg_payload();
+
   inline uint32_t get_chid() const;
   inline void set_chid(const uint32_t chid);
   inline void set_packet_id(const uint64_t packet_id);
@@ -324,12 +332,16 @@ public:
   }
   static uint64_t get_self_cluster_name_hash();
 
+private:
+  uint64_t calc_sg_checksum() const;
+
 private:
   ObRpcPacketHeader hdr_;
   const char *cdata_;
   uint32_t clen_;
   uint32_t chid_;         // channel id
   int64_t receive_ts_;  // do not serialize it
+  ObRpcSGPayload *sg_payload_;  // do not serialize it
 public:
   // for assemble
   bool assemble_;
@@ -355,7 +367,7 @@ uint64_t ObRpcPacket::get_checksum() const
 
 void ObRpcPacket::calc_checksum()
 {
-  hdr_.checksum_ = common::ob_crc64(cdata_, clen_);
+  hdr_.checksum_ = NULL == sg_payload_ ? common::ob_crc64(cdata_, clen_) : calc_sg_checksum();
 }
 
 int ObRpcPacket::verify_checksum() const
@@ -365,6 +377,16 @@ int ObRpcPacket::verify_checksum() const
       common::OB_CHECKSUM_ERROR;
 }
 
+void ObRpcPacket::set_sg_payload(ObRpcSGPayload *sg_payload)
+{
+  sg_payload_ = sg_payload;
+}
+
+ObRpcSGPayload *ObRpcPacket::get_sg_payload() const
+{
+  return sg_payload_;
+}
+
 void ObRpcPacket::set_content(const char *content, int64_t len)
 {
   cdata_ = content;
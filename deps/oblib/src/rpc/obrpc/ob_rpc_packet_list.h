@@ -630,6 +630,8 @@ PCODE_DEF(OB_BATCH, 0x750)
 // Server black list
 PCODE_DEF(OB_SERVER_BLACKLIST_REQ, 0x751)
 PCODE_DEF(OB_SERVER_BLACKLIST_RESP, 0x752)
+// small requests merged by ObRpcBatchClient
+PCODE_DEF(OB_RPC_BATCH_FRAME, 0x753)
 
 // xa trans
 PCODE_DEF(OB_XA_PREPARE, 0x760)
@@ -676,6 +678,7 @@ PCODE_DEF(OB_DUMP_TENANT_CACHE_MASTER_KEY, 0x85A)
 //PCODE_DEF(OB_LOG_REQ_UNLOAD_PROXY, 0x85D)
 //PCODE_DEF(OB_LOG_REQ_LOAD_PROXY_PROGRESS, 0x85E)
 PCODE_DEF(OB_HANDLE_PART_TRANS_CTX, 0x85F)
+PCODE_DEF(OB_LS_SUBSCRIBE_LOG, 0x860)
 
 
 //partition service
@@ -29,6 +29,7 @@
 #include "rpc/obrpc/ob_irpc_extra_payload.h"
 #include "rpc/obrpc/ob_rpc_processor_base.h"
 #include "rpc/obrpc/ob_rpc_net_handler.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 
 using namespace oceanbase::common;
 
@@ -325,9 +326,16 @@ int ObRpcProcessorBase::do_response(const Response &rsp)
       }
     }
   
+    if (NULL == packet && NULL != rsp.pkt_) {
+      // 不回包时 easy 不会在 cleanup 中释放
+      rsp.pkt_->destroy_sg_payload();
+    }
     RPC_REQ_OP.response_result(req_, packet);
     req_ = NULL;
   }
+  if ((is_stream_end_ || OB_FAIL(ret)) && NULL != rsp.pkt_) {
+    rsp.pkt_->destroy_sg_payload();
+  }
   return ret;
 }
 
@@ -453,6 +461,10 @@ int ObRpcProcessorBase::part_response(const int retcode, bool is_last)
       }
     }
 
+    // 直接由 easy 发出的未压缩应答允许引用大块数据, 其余路径照常拷贝
+    const bool enable_sg = OB_SUCC(ret) && NULL == tmp_buf
+        && rpc::ObRequest::TRANSPORT_PROTO_EASY == req_->get_nio_protocol();
+    ObRpcSGGuard sg_guard(enable_sg ? using_buffer_->get_data() : NULL, content_size);
     // serialize
     if (OB_SUCC(ret)) {
       if (OB_ISNULL(using_buffer_)) {
@@ -483,6 +495,7 @@ int ObRpcProcessorBase::part_response(const int retcode, bool is_last)
                         dst_buf, content_size + max_overflow_size, pkt);
       } else {
         pkt->set_content(using_buffer_->get_data(), using_buffer_->get_position());
+        pkt->set_sg_payload(sg_guard.take());
       }
       if (OB_FAIL(do_response(rsp))) {
         RPC_OBRPC_LOG(WARN, "response data fail", K(ret));
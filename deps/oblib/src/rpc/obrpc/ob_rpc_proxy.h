@@ -27,6 +27,7 @@
 #include "rpc/obrpc/ob_rpc_proxy_macros.h"
 #include "rpc/obrpc/ob_rpc_processor.h"
 #include "rpc/obrpc/ob_rpc_opts.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 
 namespace oceanbase
 {
@@ -36,6 +37,7 @@ namespace obrpc
 class Handle;
 class ObRpcProxy
 {
+  friend class ObRpcBatchClient;
 public:
   class PCodeGuard;
 public:
@@ -325,6 +327,7 @@ extern ObRpcProxy::NoneT None;
 } // end of namespace oceanbase
 
 #include "rpc/obrpc/ob_poc_rpc_proxy.h"
+#include "rpc/obrpc/ob_rpc_batch.h"
 #include "rpc/obrpc/ob_rpc_proxy.ipp"
 
 #define DEFINE_TO(CLS, ...)                                             \
@@ -596,6 +596,7 @@ int ObRpcProxy::rpc_post(const typename pcodeStruct::Request &args,
                          AsyncCB<pcodeStruct> *cb, const ObRpcOpts &opts)
 {
   POC_RPC_INTERCEPT(post, dst_, pcodeStruct::PCODE, args, *cb, opts);
+  RPC_BATCH_INTERCEPT(post, dst_, pcodeStruct::PCODE, args, cb, opts);
   using namespace oceanbase::common;
   using namespace rpc::frame;
   int ret = OB_SUCCESS;
@@ -624,6 +625,7 @@ int ObRpcProxy::rpc_post(const typename pcodeStruct::Request &args,
   common::ObCompressor *compressor = NULL;
   bool use_context = false;
   bool has_trace_info = false;
+  ObRpcSGPayload *sg_payload = NULL;
   if (OB_SUCC(ret) && need_compressed) {
     int64_t tmp_pos = 0;
     if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type_,
@@ -723,8 +725,12 @@ int ObRpcProxy::rpc_post(const typename pcodeStruct::Request &args,
     }
 
     if (!need_compressed) {
+      // The cloned callback lives as long as the session, large buffers of args are
+      // referenced by the request and released along with it.
+      ObRpcSGGuard sg_guard(NULL != req.cb() && req.cb() != cb ? req.buf() : NULL, payload);
       if (OB_FAIL(common::serialization::encode(req.buf(), payload, pos, args))) {
         RPC_OBRPC_LOG(WARN, "serialize argument fail", K(ret));
+      } else if (FALSE_IT(sg_payload = sg_guard.take())) {
       } else if (OB_FAIL(fill_extra_payload(req, payload, pos))) {
         RPC_OBRPC_LOG(WARN, "fill extra payload fail", K(ret), K(pos), K(payload));
       } else {
@@ -735,6 +741,7 @@ int ObRpcProxy::rpc_post(const typename pcodeStruct::Request &args,
          * So we do set_content with pos, instead of payload.
          */
         req.pkt_->set_content(req.buf(), pos);
+        req.pkt_->set_sg_payload(sg_payload);
       }
     }
     timeguard.click();
@@ -754,6 +761,7 @@ int ObRpcProxy::rpc_post(const typename pcodeStruct::Request &args,
       newcb->set_timeout(timeout_);
       newcb->set_send_ts(start_ts);
       newcb->set_payload(payload);
+      newcb->set_sg_payload(sg_payload);
     }
     req.set_async();
     if (OB_FAIL(init_pkt(req.pkt(), pcodeStruct::PCODE, opts, NULL == cb))) {
@@ -773,6 +781,12 @@ int ObRpcProxy::rpc_post(const typename pcodeStruct::Request &args,
     timeguard.click();
   }
 
+  // the session owns sg payload only after it is posted
+  if (OB_FAIL(ret) && NULL != sg_payload) {
+    ObRpcSGPayload::destroy(sg_payload);
+    sg_payload = NULL;
+  }
+
   static ObRpcPacketCode pcode = pcodeStruct::PCODE;
   if (NULL != serialize_buf) {
     ob_free(serialize_buf);
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX RPC_OBRPC
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/checksum/ob_crc64.h"
+#include "lib/coro/co_var.h"
+#include "lib/stat/ob_diagnose_info.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace obrpc
+{
+
+ObRpcSGPayload *ObRpcSGPayload::create()
+{
+  ObRpcSGPayload *payload = NULL;
+  void *buf = ob_malloc(sizeof(ObRpcSGPayload), ObModIds::OB_RPC);
+  if (NULL != buf) {
+    payload = new(buf) ObRpcSGPayload();
+    memset(payload->ebufs_, 0, sizeof(payload->ebufs_));
+  }
+  return payload;
+}
+
+void ObRpcSGPayload::destroy(ObRpcSGPayload *payload)
+{
+  if (NULL != payload) {
+    payload->~ObRpcSGPayload();
+    ob_free(payload);
+  }
+}
+
+int ObRpcSGPayload::add(int64_t offset, const char *data, int64_t len, ObRpcSGRef *ref)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(data) || OB_ISNULL(ref) || offset < 0 || len <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(offset), KP(data), K(len), KP(ref));
+  } else if (cnt_ >= MAX_SEGMENT_CNT) {
+    ret = OB_SIZE_OVERFLOW;
+  } else if (cnt_ > 0 && offset < segments_[cnt_ - 1].offset_ + segments_[cnt_ - 1].len_) {
+    // segment 必须按 content 中的位置递增且不重叠
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("segment overlapped", K(ret), K(offset), K(len), "last", segments_[cnt_ - 1]);
+  } else {
+    ref->inc_ref();
+    Segment &seg = segments_[cnt_++];
+    seg.offset_ = offset;
+    seg.data_ = data;
+    seg.len_ = len;
+    seg.ref_ = ref;
+    size_ += len;
+  }
+  return ret;
+}
+
+void ObRpcSGPayload::release()
+{
+  for (int64_t i = 0; i < cnt_; i++) {
+    if (NULL != segments_[i].ref_) {
+      segments_[i].ref_->dec_ref();
+      segments_[i].ref_ = NULL;
+    }
+  }
+  cnt_ = 0;
+  size_ = 0;
+}
+
+uint64_t ObRpcSGPayload::calc_checksum(const char *content, int64_t clen) const
+{
+  uint64_t checksum = 0;
+  int64_t pos = 0;
+  for (int64_t i = 0; i < cnt_; i++) {
+    const Segment &seg = segments_[i];
+    checksum = ob_crc64(checksum, content + pos, seg.offset_ - pos);
+    checksum = ob_crc64(checksum, seg.data_, seg.len_);
+    pos = seg.offset_ + seg.len_;
+  }
+  return ob_crc64(checksum, content + pos, clen - pos);
+}
+
+void ObRpcSGPayload::fill(char *content) const
+{
+  for (int64_t i = 0; i < cnt_; i++) {
+    MEMCPY(content + segments_[i].offset_, segments_[i].data_, segments_[i].len_);
+  }
+}
+
+int ObRpcSGPayload::add_ebufs(easy_request_t *req, char *header, int64_t header_len,
+                              const char *content, int64_t clen)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(req) || OB_ISNULL(req->ms) || OB_ISNULL(header) || header + header_len != content) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(req), KP(header), K(header_len), KP(content));
+  } else if (cnt_ <= 0 || segments_[cnt_ - 1].offset_ + segments_[cnt_ - 1].len_ > clen) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("segments out of content", K(ret), K_(cnt), K(clen));
+  } else {
+    /*
+     * easy 按挂链顺序 writev, 对端收到的字节序为:
+     *  | header, content[0, off0) | seg0 | content[off0 + len0, off1) | seg1 | ... | content tail |
+     * content 中 segment 占的位置序列化时只预留未填充, 不会发出去.
+     */
+    int64_t idx = 0;
+    easy_buf_set_data(req->ms->pool, &req->tx_ebuf, header,
+                      static_cast<uint32_t>(header_len + segments_[0].offset_));
+    easy_request_addbuf(req, &req->tx_ebuf);
+    for (int64_t i = 0; i < cnt_; i++) {
+      const Segment &seg = segments_[i];
+      const int64_t start = seg.offset_ + seg.len_;
+      const int64_t end = i + 1 < cnt_ ? segments_[i + 1].offset_ : clen;
+      easy_buf_set_data(req->ms->pool, &ebufs_[idx], seg.data_, static_cast<uint32_t>(seg.len_));
+      easy_request_addbuf(req, &ebufs_[idx++]);
+      if (end > start) {
+        easy_buf_set_data(req->ms->pool, &ebufs_[idx], content + start, static_cast<uint32_t>(end - start));
+        easy_request_addbuf(req, &ebufs_[idx++]);
+      }
+    }
+    EVENT_INC(RPC_SG_PACKET_OUT);
+    EVENT_ADD(RPC_SG_BYTES_OUT, size_);
+  }
+  return ret;
+}
+
+bool ObRpcSGPayload::reference(char *buf, const int64_t buf_len, int64_t &pos,
+                               const char *data, const int64_t len, ObRpcSGRef *ref)
+{
+  bool bret = false;
+  ObRpcSGGuard *guard = ObRpcSGGuard::current();
+  if (NULL == guard || NULL == guard->content_ || NULL == ref
+      || len < MIN_SEGMENT_SIZE || buf_len - pos < len) {
+  } else if (buf + pos < guard->content_ || buf + pos + len > guard->content_ + guard->clen_) {
+    // 不是在向 rpc content 序列化
+  } else if (NULL == guard->payload_ && NULL == (guard->payload_ = ObRpcSGPayload::create())) {
+  } else if (OB_SUCCESS == guard->payload_->add(buf + pos - guard->content_, data, len, ref)) {
+    pos += len;
+    bret = true;
+  }
+  return bret;
+}
+
+ObRpcSGGuard::ObRpcSGGuard(char *content, int64_t clen)
+    : prev_(current()), content_(content), clen_(clen), payload_(NULL)
+{
+  current() = this;
+}
+
+ObRpcSGGuard::~ObRpcSGGuard()
+{
+  current() = prev_;
+  ObRpcSGPayload::destroy(payload_);
+  payload_ = NULL;
+}
+
+ObRpcSGPayload *ObRpcSGGuard::take()
+{
+  ObRpcSGPayload *payload = payload_;
+  payload_ = NULL;
+  return payload;
+}
+
+ObRpcSGGuard *&ObRpcSGGuard::current()
+{
+  RLOCAL(ObRpcSGGuard*, guard);
+  return guard;
+}
+
+}; // end namespace obrpc
+}; // end namespace oceanbase
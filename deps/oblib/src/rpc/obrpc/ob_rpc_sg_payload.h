@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_OBRPC_OB_RPC_SG_PAYLOAD_H_
+#define OCEANBASE_OBRPC_OB_RPC_SG_PAYLOAD_H_
+#include "io/easy_io.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace obrpc
+{
+
+/*
+ * 被 rpc 包引用的外部缓冲区. 创建者持有一个引用, 每个引用它的 segment 再持有一个,
+ * 引用计数归零时调用 release 归还缓冲区.
+ */
+class ObRpcSGRef
+{
+public:
+  ObRpcSGRef(): ref_(1) {}
+  virtual ~ObRpcSGRef() {}
+  void inc_ref() { ATOMIC_INC(&ref_); }
+  void dec_ref()
+  {
+    if (0 == ATOMIC_AAF(&ref_, -1)) {
+      release();
+    }
+  }
+  int64_t get_ref() const { return ATOMIC_LOAD(&ref_); }
+protected:
+  virtual void release() = 0;
+private:
+  int64_t ref_;
+};
+
+/*
+ * scatter-gather payload.
+ * 序列化时大块数据只在 content 中预留位置而不拷贝, 记录为 segment. 发送时 easy 按
+ * content 片段和 segment 交替组成写向量, 线上字节与拷贝后的 content 完全相同,
+ * 对端解包不感知. 不走 easy 直发的路径 (压缩等) 先 fill 回 content.
+ */
+class ObRpcSGPayload
+{
+public:
+  enum { MAX_SEGMENT_CNT = 16 };
+  // 小于该值的数据拷贝的代价低于多一个 iovec
+  static const int64_t MIN_SEGMENT_SIZE = 8 << 10;
+  struct Segment
+  {
+    int64_t offset_;
+    const char *data_;
+    int64_t len_;
+    ObRpcSGRef *ref_;
+    TO_STRING_KV(K_(offset), KP_(data), K_(len), KP_(ref));
+  };
+  ObRpcSGPayload(): cnt_(0), size_(0) {}
+  ~ObRpcSGPayload() { release(); }
+  static ObRpcSGPayload *create();
+  // 释放所有引用并归还内存, 调用时 easy 不能再访问这些 segment
+  static void destroy(ObRpcSGPayload *payload);
+
+  int64_t get_cnt() const { return cnt_; }
+  int64_t get_size() const { return size_; }
+  const Segment &get_segment(int64_t idx) const { return segments_[idx]; }
+  int add(int64_t offset, const char *data, int64_t len, ObRpcSGRef *ref);
+  void release();
+  // 按线上字节序计算 content 的 crc64, 与 fill 之后整体计算的结果相同
+  uint64_t calc_checksum(const char *content, int64_t clen) const;
+  void fill(char *content) const;
+  // 把 content 片段和 segment 依次挂到 easy 的发送链上, header 紧挨着 content 之前
+  int add_ebufs(easy_request_t *req, char *header, int64_t header_len,
+                const char *content, int64_t clen);
+
+  // 在序列化函数中调用, 当前线程装了 ObRpcSGGuard 时引用 data 并预留 buf + pos 处的空间,
+  // 返回 false 时调用者照常拷贝
+  static bool reference(char *buf, const int64_t buf_len, int64_t &pos,
+                        const char *data, const int64_t len, ObRpcSGRef *ref);
+  TO_STRING_KV(K_(cnt), K_(size));
+private:
+  int64_t cnt_;
+  int64_t size_;
+  Segment segments_[MAX_SEGMENT_CNT];
+  // 每个 segment 及其后的 content 片段各占一个
+  easy_buf_t ebufs_[MAX_SEGMENT_CNT * 2];
+};
+
+// 向 content 序列化期间挂在当前线程上, 析构时释放没有被 take 走的 payload.
+// content 为 NULL 时本次序列化不允许引用.
+class ObRpcSGGuard
+{
+public:
+  ObRpcSGGuard(char *content, int64_t clen);
+  ~ObRpcSGGuard();
+  ObRpcSGPayload *take();
+  static ObRpcSGGuard *&current();
+private:
+  friend class ObRpcSGPayload;
+  ObRpcSGGuard *prev_;
+  char *content_;
+  int64_t clen_;
+  ObRpcSGPayload *payload_;
+  DISALLOW_COPY_AND_ASSIGN(ObRpcSGGuard);
+};
+
+}; // end namespace obrpc
+}; // end namespace oceanbase
+
+#endif /* OCEANBASE_OBRPC_OB_RPC_SG_PAYLOAD_H_ */
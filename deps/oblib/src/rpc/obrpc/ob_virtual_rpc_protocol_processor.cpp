@@ -22,6 +22,7 @@
 #include "rpc/obrpc/ob_rpc_proxy.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
 #include "rpc/obrpc/ob_rpc_net_handler.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 #include "rpc/frame/ob_req_handler.h"
 
 using namespace oceanbase::common;
@@ -91,6 +92,8 @@ int ObVirtualRpcProtocolProcessor::encode_compressed_rpc_packet(ObTimeGuard &tim
     ret = OB_ERR_UNEXPECTED;
     LOG_ERROR("compress ctx set is NULL", K(ret));
   } else {
+    // the compressor reads content as a whole, put referenced segments back first
+    pkt->fill_sg_payload();
     ObRpcCompressCCtx &compress_ctx = ctx_set->compress_ctx_;
     if (!compress_ctx.is_inited_) {
       ret = OB_NOT_INIT;
@@ -333,8 +336,16 @@ int ObVirtualRpcProtocolProcessor::encode_raw_rpc_packet(ObTimeGuard &timeguard,
            * In RX side, req->ms->pool does not make any sense. It will be changed to easy_request_t
            * by easy_buf_set_cleanup soon.
            */
-          easy_buf_set_data(req->ms->pool, ebuf, ez_rpc_header, ez_rpc_header_size + pkt->get_clen());
-          easy_request_addbuf(req, ebuf);
+          if (NULL != pkt->get_sg_payload()) {
+            // referenced segments are chained between content pieces instead of being copied
+            if (OB_FAIL(pkt->get_sg_payload()->add_ebufs(req, ez_rpc_header, ez_rpc_header_size,
+                                                         pkt->get_cdata(), pkt->get_clen()))) {
+              LOG_WARN("failed to add scatter-gather ebufs", K(ret), "sg_payload", *pkt->get_sg_payload());
+            }
+          } else {
+            easy_buf_set_data(req->ms->pool, ebuf, ez_rpc_header, ez_rpc_header_size + pkt->get_clen());
+            easy_request_addbuf(req, ebuf);
+          }
         }
       }
       timeguard.click();
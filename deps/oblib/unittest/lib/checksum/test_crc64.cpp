@@ -48,14 +48,40 @@ TEST(TestCrc64, common)
     uint64_t fast_manually_hash = fast_crc64_sse42_manually(intermediate_hash, str, i);
     uint64_t sse42_hash = crc64_sse42(intermediate_hash, str, i);
     uint64_t isal_hash = ob_crc64_isal(intermediate_hash, str, i);
+    uint64_t sse42_3way_hash = crc64_sse42_3way(intermediate_hash, str, i);
     ASSERT_EQ(manually_hash, fast_manually_hash);
     ASSERT_EQ(manually_hash, sse42_hash);
     ASSERT_EQ(manually_hash, isal_hash);
+    ASSERT_EQ(manually_hash, sse42_3way_hash);
+#if defined(__x86_64__)
+    uint64_t sse42_fold_hash = crc64_sse42_fold(intermediate_hash, str, i);
+    ASSERT_EQ(manually_hash, sse42_fold_hash);
+#endif
     //cout << "st = "<< tmp_str << endl;
     //cout << "crc64c = "<< manually_hash << endl;
   }
 }
 
+TEST(TestCrc64, large_unaligned)
+{
+  const int64_t BUF_LEN = 1 << 20;
+  char *buf = new char[BUF_LEN + 64];
+  for (int64_t i = 0; i < BUF_LEN + 64; ++i) {
+    buf[i] = static_cast<char>(rand());
+  }
+  for (int64_t i = 0; i < 1000; ++i) {
+    const int64_t offset = rand() % 64;
+    const int64_t len = rand() % BUF_LEN;
+    const uint64_t intermediate_hash = static_cast<uint32_t>(rand());
+    uint64_t sse42_hash = crc64_sse42(intermediate_hash, buf + offset, len);
+    ASSERT_EQ(sse42_hash, crc64_sse42_3way(intermediate_hash, buf + offset, len));
+#if defined(__x86_64__)
+    ASSERT_EQ(sse42_hash, crc64_sse42_fold(intermediate_hash, buf + offset, len));
+#endif
+  }
+  delete [] buf;
+}
+
 TEST(TestCrc64, test_speed)
 {
   const int64_t STR_LEN = 2 << 20;
@@ -85,6 +111,22 @@ TEST(TestCrc64, test_speed)
     end = get_current_time_us();
     cout << "          ob_crc64(sse42), execut_count = "<< COUNT << ", cost_us = " << end - start << " len = " << i << endl;
 
+    start = get_current_time_us();
+    for (int64_t j = 0; j < COUNT; ++j) {
+      crc64_sse42_3way(0, tmp_str, i);
+    }
+    end = get_current_time_us();
+    cout << "     ob_crc64(sse42_3way), execut_count = "<< COUNT << ", cost_us = " << end - start << " len = " << i << endl;
+
+#if defined(__x86_64__)
+    start = get_current_time_us();
+    for (int64_t j = 0; j < COUNT; ++j) {
+      crc64_sse42_fold(0, tmp_str, i);
+    }
+    end = get_current_time_us();
+    cout << "     ob_crc64(sse42_fold), execut_count = "<< COUNT << ", cost_us = " << end - start << " len = " << i << endl;
+#endif
+
     start = get_current_time_us();
     for (int64_t j = 0; j < COUNT; ++j) {
       ob_crc64_isal(0, tmp_str, i);
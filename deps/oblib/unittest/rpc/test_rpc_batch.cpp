@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "rpc/obrpc/ob_rpc_batch.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::rpc;
+using namespace oceanbase::obrpc;
+
+class TestCB: public UAsyncCB
+{
+public:
+  TestCB(int64_t& process_cnt, int64_t& error_cnt):
+      UAsyncCB(OB_TEST_PCODE), process_cnt_(process_cnt), error_cnt_(error_cnt), pkt_(NULL) {}
+  UAsyncCB* clone(const frame::SPAlloc& alloc) const
+  {
+    return new(alloc.alloc(sizeof(*this))) TestCB(process_cnt_, error_cnt_);
+  }
+  int decode(void* pkt)
+  {
+    pkt_ = reinterpret_cast<ObRpcPacket*>(pkt);
+    return OB_SUCCESS;
+  }
+  int process()
+  {
+    EXPECT_EQ(0, MEMCMP("resp", pkt_->get_cdata(), pkt_->get_clen()));
+    process_cnt_++;
+    return OB_SUCCESS;
+  }
+  int get_rcode() { return OB_SUCCESS; }
+  void reset_rcode() {}
+  void set_cloned(bool cloned) { UNUSED(cloned); }
+  bool get_cloned() { return false; }
+  int on_error(int err)
+  {
+    UNUSED(err);
+    error_cnt_++;
+    return OB_SUCCESS;
+  }
+private:
+  int64_t& process_cnt_;
+  int64_t& error_cnt_;
+  ObRpcPacket* pkt_;
+};
+
+int encode_packet(ObRpcMemPool& pool, const char* content, char*& buf, int64_t& sz)
+{
+  ObRpcPacket pkt;
+  pkt.set_pcode(OB_TEST_PCODE);
+  pkt.set_content(content, strlen(content));
+  return rpc_encode_ob_packet(pool, &pkt, buf, sz);
+}
+
+TEST(TestRpcBatch, encode_and_dispatch)
+{
+  int64_t process_cnt = 0;
+  int64_t error_cnt = 0;
+  TestCB cb(process_cnt, error_cnt);
+  ObRpcBatchFrame* frame = ObRpcBatchFrame::create(ObAddr(ObAddr::IPV4, "127.0.0.1", 2882));
+  ASSERT_TRUE(NULL != frame);
+  char* req = NULL;
+  int64_t req_sz = 0;
+  ASSERT_EQ(OB_SUCCESS, encode_packet(frame->get_pool(), "req", req, req_sz));
+  ASSERT_TRUE(frame->can_add(OB_TEST_PCODE, req_sz, 1000));
+  frame->add(OB_TEST_PCODE, req, req_sz, frame->clone_cb(cb), 1000);
+  frame->add(OB_TEST_PCODE, req, req_sz, frame->clone_cb(cb), 1000);
+  frame->add(OB_TEST_PCODE, req, req_sz, NULL, 1000);
+  ASSERT_EQ(3, frame->get_cnt());
+  ASSERT_EQ(OB_TEST_PCODE, frame->get_pcode());
+  ASSERT_EQ(1000, frame->get_timeout());
+  ASSERT_EQ(1000, frame->get_remain_timeout(frame->get_start_ts()));
+  ASSERT_EQ(600, frame->get_remain_timeout(frame->get_start_ts() + 400));
+  ASSERT_TRUE(frame->need_response());
+  ASSERT_TRUE(frame->can_add(OB_TEST_PCODE, req_sz, 1000));
+  ASSERT_FALSE(frame->can_add(OB_TEST_PCODE, ObRpcBatchFrame::MAX_FRAME_SIZE, 1000));
+  // only requests of the same pcode and timeout are merged
+  ASSERT_FALSE(frame->can_add(OB_TEST_PCODE, req_sz, 2000));
+  ASSERT_FALSE(frame->can_add(OB_RPC_BATCH_FRAME, req_sz, 1000));
+
+  // request frame, sub packets are encoded as they are sent alone
+  ObRpcMemPool pool;
+  int64_t len = frame->get_encoded_size();
+  char* buf = (char*)pool.alloc(len);
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, frame->encode(buf, len, pos));
+  ASSERT_EQ(len, pos);
+  int64_t cnt = 0;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, serialization::decode_i64(buf, len, pos, &cnt));
+  ASSERT_EQ(3, cnt);
+  for (int64_t i = 0; i < cnt; i++) {
+    const char* entry = NULL;
+    int64_t entry_sz = 0;
+    ObRpcPacket* pkt = NULL;
+    ASSERT_EQ(OB_SUCCESS, ObRpcBatchFrame::decode_entry(buf, len, pos, entry, entry_sz));
+    ASSERT_EQ(OB_SUCCESS, rpc_decode_ob_packet(pool, const_cast<char*>(entry), entry_sz, pkt));
+    ASSERT_EQ(OB_TEST_PCODE, pkt->get_pcode());
+    ASSERT_EQ(0, MEMCMP("req", pkt->get_cdata(), pkt->get_clen()));
+  }
+  const char* entry = NULL;
+  int64_t entry_sz = 0;
+  ASSERT_NE(OB_SUCCESS, ObRpcBatchFrame::decode_entry(buf, len, pos, entry, entry_sz));
+
+  // response frame, the second sub request got no response
+  char* resp = NULL;
+  int64_t resp_sz = 0;
+  ASSERT_EQ(OB_SUCCESS, encode_packet(pool, "resp", resp, resp_sz));
+  len = 1024;
+  buf = (char*)pool.alloc(len);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, serialization::encode_i64(buf, len, pos, 3));
+  ASSERT_EQ(OB_SUCCESS, serialization::encode_i64(buf, len, pos, resp_sz));
+  MEMCPY(buf + pos, resp, resp_sz);
+  pos += resp_sz;
+  ASSERT_EQ(OB_SUCCESS, serialization::encode_i64(buf, len, pos, 0));
+  ASSERT_EQ(OB_SUCCESS, serialization::encode_i64(buf, len, pos, 0));
+  frame->handle_resp(buf, pos);
+  ASSERT_EQ(1, process_cnt);
+  ASSERT_EQ(1, error_cnt);
+
+  frame->handle_error(EASY_TIMEOUT);
+  ASSERT_EQ(3, error_cnt);
+  frame->destroy();
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
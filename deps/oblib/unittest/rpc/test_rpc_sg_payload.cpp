@@ -0,0 +1,108 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/checksum/ob_crc64.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obrpc;
+
+class TestRef: public ObRpcSGRef
+{
+public:
+  TestRef(): released_(false) {}
+  bool released_;
+protected:
+  void release() { released_ = true; }
+};
+
+TEST(TestRpcSGPayload, reference_and_fill)
+{
+  const int64_t seg_len = ObRpcSGPayload::MIN_SEGMENT_SIZE;
+  const int64_t clen = seg_len * 2 + 64;
+  char *data = new char[seg_len];
+  char *content = new char[clen];
+  char *expect = new char[clen];
+  memset(data, 'x', seg_len);
+  memset(content, 0, clen);
+  TestRef ref;
+
+  // no guard, copy as usual
+  int64_t pos = 0;
+  ASSERT_FALSE(ObRpcSGPayload::reference(content, clen, pos, data, seg_len, &ref));
+  ASSERT_EQ(0, pos);
+  ObRpcSGPayload *payload = NULL;
+  {
+    ObRpcSGGuard guard(content, clen);
+    pos = 0;
+    MEMCPY(content, "head", 4);
+    pos += 4;
+    ASSERT_TRUE(ObRpcSGPayload::reference(content, clen, pos, data, seg_len, &ref));
+    ASSERT_EQ(4 + seg_len, pos);
+    // small data is copied
+    ASSERT_FALSE(ObRpcSGPayload::reference(content, clen, pos, data, 16, &ref));
+    ASSERT_TRUE(ObRpcSGPayload::reference(content, clen, pos, data, seg_len, &ref));
+    ASSERT_EQ(3, ref.get_ref());
+    payload = guard.take();
+  }
+  ASSERT_TRUE(NULL != payload);
+  ASSERT_EQ(2, payload->get_cnt());
+  ASSERT_EQ(seg_len * 2, payload->get_size());
+
+  memset(expect, 0, clen);
+  MEMCPY(expect, "head", 4);
+  MEMCPY(expect + 4, data, seg_len);
+  MEMCPY(expect + 4 + seg_len, data, seg_len);
+  ASSERT_EQ(ob_crc64(expect, clen), payload->calc_checksum(content, clen));
+  payload->fill(content);
+  ASSERT_EQ(0, MEMCMP(expect, content, clen));
+
+  ObRpcSGPayload::destroy(payload);
+  ASSERT_EQ(1, ref.get_ref());
+  ASSERT_FALSE(ref.released_);
+  ref.dec_ref();
+  ASSERT_TRUE(ref.released_);
+  delete[] data;
+  delete[] content;
+  delete[] expect;
+}
+
+TEST(TestRpcSGPayload, guard_release_untaken)
+{
+  const int64_t seg_len = ObRpcSGPayload::MIN_SEGMENT_SIZE;
+  char *data = new char[seg_len];
+  char *content = new char[seg_len];
+  TestRef ref;
+  {
+    ObRpcSGGuard guard(content, seg_len);
+    int64_t pos = 0;
+    ASSERT_TRUE(ObRpcSGPayload::reference(content, seg_len, pos, data, seg_len, &ref));
+    ASSERT_EQ(2, ref.get_ref());
+  }
+  ASSERT_EQ(1, ref.get_ref());
+  {
+    // not serializing into rpc content
+    ObRpcSGGuard guard(NULL, seg_len);
+    int64_t pos = 0;
+    ASSERT_FALSE(ObRpcSGPayload::reference(content, seg_len, pos, data, seg_len, &ref));
+  }
+  ASSERT_EQ(1, ref.get_ref());
+  delete[] data;
+  delete[] content;
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "rpc/obmysql/ob_sql_nio_uring.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+
+class TestSqlNioUring : public ::testing::Test
+{
+public:
+  enum { ACCEPT = 1, RECV = 2, POLL = 3, SEND = 4, CANCEL = 5 };
+  TestSqlNioUring(): lfd_(-1), cfd_(-1), sfd_(-1), recv_sz_(0), send_sz_(0) {}
+  virtual void SetUp()
+  {
+    int ret = uring_.init(64, 8, 4096);
+    if (OB_NOT_SUPPORTED == ret) {
+      // old kernel
+    } else {
+      ASSERT_EQ(OB_SUCCESS, ret);
+      struct sockaddr_in sin;
+      socklen_t len = sizeof(sin);
+      memset(&sin, 0, sizeof(sin));
+      sin.sin_family = AF_INET;
+      sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      ASSERT_LE(0, lfd_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0));
+      ASSERT_EQ(0, bind(lfd_, (struct sockaddr*)&sin, sizeof(sin)));
+      ASSERT_EQ(0, listen(lfd_, 16));
+      ASSERT_EQ(0, getsockname(lfd_, (struct sockaddr*)&sin, &len));
+      ObSqlNioUring::prep_accept_multishot(uring_.get_sqe(), lfd_, SOCK_NONBLOCK, ACCEPT);
+      ASSERT_EQ(OB_SUCCESS, uring_.submit_and_wait(0));
+      ASSERT_LE(0, cfd_ = socket(AF_INET, SOCK_STREAM, 0));
+      ASSERT_EQ(0, connect(cfd_, (struct sockaddr*)&sin, sizeof(sin)));
+      for (int i = 0; i < 10 && sfd_ < 0; i++) {
+        reap(100 * 1000);
+      }
+      ASSERT_LE(0, sfd_);
+    }
+  }
+  virtual void TearDown()
+  {
+    close(sfd_);
+    close(cfd_);
+    close(lfd_);
+    uring_.destroy();
+  }
+  void reap(int64_t timeout_us)
+  {
+    uring::Cqe* cqe = NULL;
+    ASSERT_EQ(OB_SUCCESS, uring_.submit_and_wait(timeout_us));
+    while (NULL != (cqe = uring_.peek_cqe())) {
+      if (ACCEPT == cqe->user_data_) {
+        ASSERT_LE(0, cqe->res_);
+        ASSERT_TRUE(cqe->flags_ & uring::CQE_F_MORE);
+        sfd_ = cqe->res_;
+      } else if (RECV == cqe->user_data_ && cqe->res_ > 0) {
+        ASSERT_TRUE(cqe->flags_ & uring::CQE_F_BUFFER);
+        uint16_t bid = (uint16_t)(cqe->flags_ >> uring::CQE_BUFFER_SHIFT);
+        memcpy(recv_buf_ + recv_sz_, uring_.get_buf(bid), cqe->res_);
+        recv_sz_ += cqe->res_;
+        uring_.recycle_buf(bid);
+        if (0 == (cqe->flags_ & uring::CQE_F_MORE)) {
+          ObSqlNioUring::prep_recv_multishot(uring_.get_sqe(), sfd_, RECV);
+        }
+      } else if (SEND == cqe->user_data_) {
+        ASSERT_LT(0, cqe->res_);
+        send_sz_ += cqe->res_;
+      }
+      uring_.advance_cqe();
+    }
+  }
+  bool is_supported() const { return lfd_ >= 0; }
+protected:
+  ObSqlNioUring uring_;
+  int lfd_;
+  int cfd_;
+  int sfd_;
+  char recv_buf_[1024];
+  int64_t recv_sz_;
+  int64_t send_sz_;
+};
+
+TEST_F(TestSqlNioUring, recv_multishot)
+{
+  if (is_supported()) {
+    ObSqlNioUring::prep_recv_multishot(uring_.get_sqe(), sfd_, RECV);
+    ASSERT_EQ(OB_SUCCESS, uring_.submit_and_wait(0));
+    // more packets than provided buffers, buffers are recycled
+    for (int i = 0; i < 100; i++) {
+      ASSERT_EQ(1, write(cfd_, "x", 1));
+      reap(10 * 1000);
+    }
+    for (int i = 0; i < 10 && recv_sz_ < 100; i++) {
+      reap(100 * 1000);
+    }
+    ASSERT_EQ(100, recv_sz_);
+  }
+}
+
+TEST_F(TestSqlNioUring, send_and_cancel)
+{
+  if (is_supported()) {
+    const char* resp = "response";
+    const int64_t resp_sz = strlen(resp);
+    char buf[64];
+    ObSqlNioUring::prep_send(uring_.get_sqe(), sfd_, resp, resp_sz, MSG_NOSIGNAL, SEND);
+    ObSqlNioUring::prep_send(uring_.get_sqe(), sfd_, resp, resp_sz, MSG_NOSIGNAL, SEND);
+    for (int i = 0; i < 10 && send_sz_ < 2 * resp_sz; i++) {
+      reap(100 * 1000);
+    }
+    ASSERT_EQ(2 * resp_sz, send_sz_);
+    ASSERT_EQ(2 * resp_sz, read(cfd_, buf, sizeof(buf)));
+
+    ObSqlNioUring::prep_poll_multishot(uring_.get_sqe(), sfd_, POLLIN, POLL);
+    ObSqlNioUring::prep_cancel_fd(uring_.get_sqe(), sfd_, CANCEL);
+    ASSERT_EQ(OB_SUCCESS, uring_.submit_and_wait(100 * 1000));
+    usleep(10 * 1000);
+    bool poll_canceled = false;
+    uring::Cqe* cqe = NULL;
+    while (NULL != (cqe = uring_.peek_cqe())) {
+      if (POLL == cqe->user_data_) {
+        poll_canceled = -ECANCELED == cqe->res_;
+      }
+      uring_.advance_cqe();
+    }
+    ASSERT_TRUE(poll_canceled);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
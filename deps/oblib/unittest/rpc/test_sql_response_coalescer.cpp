@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "rpc/obmysql/ob_sql_sock_session.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+
+class TestSqlResponseCoalescer : public ::testing::Test
+{
+public:
+  static const int64_t SIZE_LIMIT = 64;
+  static const int64_t TIME_LIMIT = 1000;
+};
+
+TEST_F(TestSqlResponseCoalescer, disabled)
+{
+  ObSqlResponseCoalescer coalescer;
+  EXPECT_FALSE(coalescer.hold("a", 1, 0, TIME_LIMIT, 0));
+  EXPECT_EQ(0, coalescer.get_cnt());
+  EXPECT_TRUE(NULL == coalescer.get_buf());
+
+  // nothing held, the response is written as it is
+  const char* buf = "abc";
+  int64_t sz = 3;
+  EXPECT_TRUE(coalescer.merge(buf, sz));
+  EXPECT_EQ(0, MEMCMP("abc", buf, 3));
+  EXPECT_EQ(3, sz);
+}
+
+TEST_F(TestSqlResponseCoalescer, hold_and_merge)
+{
+  ObSqlResponseCoalescer coalescer;
+  ASSERT_TRUE(coalescer.hold("ab", 2, SIZE_LIMIT, TIME_LIMIT, 100));
+  ASSERT_TRUE(coalescer.hold("cd", 2, SIZE_LIMIT, TIME_LIMIT, 200));
+  EXPECT_EQ(2, coalescer.get_cnt());
+  EXPECT_EQ(4, coalescer.get_sz());
+
+  const char* buf = "ef";
+  int64_t sz = 2;
+  ASSERT_TRUE(coalescer.merge(buf, sz));
+  EXPECT_EQ(coalescer.get_buf(), buf);
+  EXPECT_EQ(6, sz);
+  EXPECT_EQ(0, MEMCMP("abcdef", buf, 6));
+  EXPECT_EQ(0, coalescer.get_cnt());
+
+  // the buffer is freed after written
+  coalescer.on_written();
+  EXPECT_TRUE(NULL == coalescer.get_buf());
+  EXPECT_EQ(0, coalescer.get_sz());
+}
+
+TEST_F(TestSqlResponseCoalescer, size_limit)
+{
+  ObSqlResponseCoalescer coalescer;
+  char data[SIZE_LIMIT];
+  MEMSET(data, 'x', sizeof(data));
+  EXPECT_FALSE(coalescer.hold(data, SIZE_LIMIT + 1, SIZE_LIMIT, TIME_LIMIT, 0));
+  ASSERT_TRUE(coalescer.hold(data, SIZE_LIMIT - 1, SIZE_LIMIT, TIME_LIMIT, 0));
+  EXPECT_FALSE(coalescer.hold(data, 2, SIZE_LIMIT, TIME_LIMIT, 0));
+  EXPECT_EQ(1, coalescer.get_cnt());
+
+  // the response does not fit, held responses should be written first
+  const char* buf = data;
+  int64_t sz = 2;
+  EXPECT_FALSE(coalescer.merge(buf, sz));
+  EXPECT_EQ(data, buf);
+  EXPECT_EQ(2, sz);
+  EXPECT_EQ(1, coalescer.get_cnt());
+  EXPECT_EQ(SIZE_LIMIT - 1, coalescer.get_sz());
+  coalescer.on_written();
+  EXPECT_EQ(0, coalescer.get_cnt());
+  EXPECT_TRUE(NULL == coalescer.get_buf());
+}
+
+TEST_F(TestSqlResponseCoalescer, time_limit)
+{
+  ObSqlResponseCoalescer coalescer;
+  ASSERT_TRUE(coalescer.hold("a", 1, SIZE_LIMIT, TIME_LIMIT, 100));
+  ASSERT_TRUE(coalescer.hold("b", 1, SIZE_LIMIT, TIME_LIMIT, 100 + TIME_LIMIT - 1));
+  // since the first held response
+  EXPECT_FALSE(coalescer.hold("c", 1, SIZE_LIMIT, TIME_LIMIT, 100 + TIME_LIMIT));
+  EXPECT_EQ(2, coalescer.get_cnt());
+
+  // the held responses are handed over to write, and the buffer is kept until written
+  coalescer.detach();
+  EXPECT_EQ(0, coalescer.get_cnt());
+  EXPECT_EQ(2, coalescer.get_sz());
+  EXPECT_EQ(0, MEMCMP("ab", coalescer.get_buf(), 2));
+  coalescer.on_written();
+
+  // timer restarts for next held response
+  ASSERT_TRUE(coalescer.hold("d", 1, SIZE_LIMIT, TIME_LIMIT, 100 + 2 * TIME_LIMIT));
+  EXPECT_EQ(1, coalescer.get_cnt());
+  EXPECT_EQ(0, MEMCMP("d", coalescer.get_buf(), 1));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
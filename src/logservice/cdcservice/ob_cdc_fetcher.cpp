@@ -173,6 +173,92 @@ int ObCdcFetcher::fetch_missing_log(const obrpc::ObCdcLSFetchMissLogReq &req,
   return ret;
 }
 
+int ObCdcFetcher::subscribe_log(const obrpc::ObCdcLSSubscribeLogReq &req,
+    obrpc::ObCdcLSSubscribeLogResp &resp,
+    const int64_t receive_ts,
+    volatile bool &stop_flag,
+    bool &need_retry)
+{
+  int ret = OB_SUCCESS;
+  const int64_t wait_time = std::min(req.get_wait_time(), MAX_SUBSCRIBE_WAIT_TIME);
+  // reserve some time for response, the same as fetch_log
+  const int64_t rpc_deadline = THIS_WORKER.get_timeout_ts() - RPC_QIT_RESERVED_TIME;
+  const int64_t end_tstamp = std::min(receive_ts + wait_time, rpc_deadline);
+  need_retry = false;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(! req.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid subscribe_log req", KR(ret), K(req));
+  } else if (OB_FAIL(collect_subscribe_result_(req, resp))) {
+    LOG_WARN("collect_subscribe_result_ fail", KR(ret), K(tenant_id_), K(req));
+  } else if (resp.get_results().count() > 0) {
+    // have new logs
+  } else if (ATOMIC_LOAD(&stop_flag)) {
+    ret = OB_IN_STOP_STATE;
+  } else if (ObTimeUtility::current_time() + SUBSCRIBE_CHECK_INTERVAL > end_tstamp) {
+    // time up, respond with empty result
+  } else if (THIS_WORKER.can_retry()) {
+    // Do not hold the worker, the request is put into the retry queue of tenant and
+    // checked again later, see ObThWorker::process_request
+    THIS_WORKER.set_need_retry();
+    need_retry = true;
+  } else {
+    // retry with current worker, respond with empty result and the client subscribes again
+  }
+
+  if (need_retry) {
+    // not respond
+  } else {
+    if (OB_SUCC(ret)) {
+      EVENT_ADD(CLOG_EXTLOG_SUBSCRIBE_NOTIFY_COUNT, resp.get_results().count());
+    } else if (OB_IN_STOP_STATE != ret) {
+      LOG_WARN("subscribe log error", KR(ret), K(tenant_id_), K(req));
+      ret = OB_ERR_SYS;
+    }
+
+    resp.set_err(ret);
+  }
+  return ret;
+}
+
+int ObCdcFetcher::collect_subscribe_result_(const obrpc::ObCdcLSSubscribeLogReq &req,
+    obrpc::ObCdcLSSubscribeLogResp &resp)
+{
+  int ret = OB_SUCCESS;
+  const obrpc::ObCdcLSSubscribeLogReq::SubscribeParamArray &params = req.get_params();
+  int64_t pending_size = 0;
+
+  for (int64_t i = 0; OB_SUCC(ret) && pending_size < req.get_credit() && i < params.count(); i++) {
+    const ObLSID &ls_id = params.at(i).ls_id_;
+    const LSN &start_lsn = params.at(i).start_lsn_;
+    PalfHandleGuard palf_handle_guard;
+    LSN end_lsn;
+    obrpc::ObCdcLSSubscribeLogResp::SubscribeResult result;
+    int ls_ret = OB_SUCCESS;
+
+    if (OB_SUCCESS != (ls_ret = init_palf_handle_guard_(ls_id, palf_handle_guard))) {
+      // the connector needs to change server
+      result.reset(ls_id, ls_ret, end_lsn);
+    } else if (OB_SUCCESS != (ls_ret = palf_handle_guard.get_end_lsn(end_lsn))) {
+      LOG_WARN("get_end_lsn fail", K(ls_ret), K(tenant_id_), K(ls_id));
+      result.reset(ls_id, ls_ret, end_lsn);
+    } else if (end_lsn > start_lsn) {
+      pending_size += (end_lsn - start_lsn);
+      result.reset(ls_id, OB_SUCCESS, end_lsn);
+    } else {
+      // no new log
+    }
+
+    if (result.ls_id_.is_valid() && OB_FAIL(resp.append_result(result))) {
+      LOG_WARN("append subscribe result fail", KR(ret), K(result));
+    }
+  }
+
+  return ret;
+}
+
 int ObCdcFetcher::init_palf_handle_guard_(const ObLSID &ls_id,
     palf::PalfHandleGuard &palf_handle_guard)
 {
@@ -39,6 +39,10 @@ class ObCdcFetcher
   // When fetch log finds that the remaining time is less than RPC_QIT_RESERVED_TIME,
   // exit immediately to avoid timeout
   static const int64_t RPC_QIT_RESERVED_TIME = 5 * 1000 * 1000; // 5 second
+  // Subscribe request is held at most MAX_SUBSCRIBE_WAIT_TIME in the retry queue of tenant.
+  // It is not retried if less than SUBSCRIBE_CHECK_INTERVAL left.
+  static const int64_t MAX_SUBSCRIBE_WAIT_TIME = 1 * 1000 * 1000; // 1 second
+  static const int64_t SUBSCRIBE_CHECK_INTERVAL = 10 * 1000; // 10 ms, see RETRY_QUEUE_TIMESTEP
 
 public:
   ObCdcFetcher();
@@ -57,7 +61,20 @@ public:
   int fetch_missing_log(const obrpc::ObCdcLSFetchMissLogReq &req,
       obrpc::ObCdcLSFetchLogResp &resp);
 
+  // Subscribe log of a batch of LS, return the LS which have logs after start_lsn.
+  // The logs are still fetched by fetch_log.
+  // If no LS has new log, need_retry is set and the request should not be responded,
+  // it is processed again by worker later until the wait time since receive_ts is up.
+  int subscribe_log(const obrpc::ObCdcLSSubscribeLogReq &req,
+      obrpc::ObCdcLSSubscribeLogResp &resp,
+      const int64_t receive_ts,
+      volatile bool &stop_flag,
+      bool &need_retry);
+
 private:
+  // Collect the LS which have logs after start_lsn, stop when pending log size reach credit
+  int collect_subscribe_result_(const obrpc::ObCdcLSSubscribeLogReq &req,
+      obrpc::ObCdcLSSubscribeLogResp &resp);
   // @retval OB_SUCCESS         Success
   // @retval OB_ENTRY_NOT_EXIST LS not exist in this server
   int init_palf_handle_guard_(const ObLSID &ls_id,
@@ -479,5 +479,189 @@ int ObCdcLSFetchMissLogReq::append_miss_log(const MissLogParam &param)
   return ret;
 }
 
+
+/*
+ *
+ * Subscribe Log
+ *
+ */
+void ObCdcLSSubscribeLogReq::SubscribeParam::reset()
+{
+  ls_id_.reset();
+  start_lsn_.reset();
+}
+
+void ObCdcLSSubscribeLogReq::SubscribeParam::reset(const ObLSID &ls_id, const LSN &start_lsn)
+{
+  ls_id_ = ls_id;
+  start_lsn_ = start_lsn;
+}
+
+bool ObCdcLSSubscribeLogReq::SubscribeParam::is_valid() const
+{
+  return ls_id_.is_valid() && start_lsn_.is_valid();
+}
+
+OB_SERIALIZE_MEMBER(ObCdcLSSubscribeLogReq::SubscribeParam, ls_id_, start_lsn_);
+
+ObCdcLSSubscribeLogReq::ObCdcLSSubscribeLogReq()
+    : rpc_ver_(CUR_RPC_VER),
+      params_(),
+      wait_time_(0),
+      credit_(0),
+      client_pid_(0)
+{ }
+
+ObCdcLSSubscribeLogReq::~ObCdcLSSubscribeLogReq()
+{
+  reset();
+}
+
+void ObCdcLSSubscribeLogReq::reset()
+{
+  params_.reset();
+  wait_time_ = 0;
+  credit_ = 0;
+  client_pid_ = 0;
+}
+
+bool ObCdcLSSubscribeLogReq::is_valid() const
+{
+  int64_t count = params_.count();
+  bool bool_ret = (count > 0) && (wait_time_ >= 0) && (credit_ > 0);
+
+  for (int64_t i = 0; bool_ret && i < count; i++) {
+    bool_ret = params_[i].is_valid();
+  }
+
+  return bool_ret;
+}
+
+int ObCdcLSSubscribeLogReq::append_param(const SubscribeParam &param)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(!param.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    EXTLOG_LOG(WARN, "invalid param", K(ret), K(param));
+  } else if (ITEM_CNT_LMT <= params_.count()) {
+    ret = OB_BUF_NOT_ENOUGH;
+    EXTLOG_LOG(WARN, "err append param, buf not enough", K(ret),
+               LITERAL_K(ITEM_CNT_LMT),
+               "count", params_.count());
+  } else if (OB_SUCCESS != (ret = params_.push_back(param))) {
+    EXTLOG_LOG(ERROR, "err push back param", K(ret));
+  }
+
+  return ret;
+}
+
+OB_DEF_SERIALIZE(ObCdcLSSubscribeLogReq)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_ENCODE, rpc_ver_, params_, wait_time_, credit_, client_pid_);
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObCdcLSSubscribeLogReq)
+{
+  int64_t len = 0;
+  LST_DO_CODE(OB_UNIS_ADD_LEN, rpc_ver_, params_, wait_time_, credit_, client_pid_);
+  return len;
+}
+
+OB_DEF_DESERIALIZE(ObCdcLSSubscribeLogReq)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_DECODE, rpc_ver_);
+  if (CUR_RPC_VER == rpc_ver_) {
+    LST_DO_CODE(OB_UNIS_DECODE, params_, wait_time_, credit_, client_pid_);
+  } else {
+    ret = OB_NOT_SUPPORTED;
+    EXTLOG_LOG(ERROR, "deserialize error, version not match",
+               K(ret), K(rpc_ver_), LITERAL_K(CUR_RPC_VER));
+  }
+  return ret;
+}
+
+void ObCdcLSSubscribeLogResp::SubscribeResult::reset()
+{
+  ls_id_.reset();
+  err_ = OB_SUCCESS;
+  end_lsn_.reset();
+}
+
+void ObCdcLSSubscribeLogResp::SubscribeResult::reset(const ObLSID &ls_id,
+    const int err,
+    const LSN &end_lsn)
+{
+  ls_id_ = ls_id;
+  err_ = err;
+  end_lsn_ = end_lsn;
+}
+
+OB_SERIALIZE_MEMBER(ObCdcLSSubscribeLogResp::SubscribeResult, ls_id_, err_, end_lsn_);
+
+ObCdcLSSubscribeLogResp::ObCdcLSSubscribeLogResp()
+    : rpc_ver_(CUR_RPC_VER),
+      err_(OB_SUCCESS),
+      res_()
+{ }
+
+ObCdcLSSubscribeLogResp::~ObCdcLSSubscribeLogResp()
+{
+  reset();
+}
+
+void ObCdcLSSubscribeLogResp::reset()
+{
+  err_ = OB_SUCCESS;
+  res_.reset();
+}
+
+int ObCdcLSSubscribeLogResp::append_result(const SubscribeResult &result)
+{
+  int ret = OB_SUCCESS;
+
+  if (ITEM_CNT_LMT <= res_.count()) {
+    ret = OB_BUF_NOT_ENOUGH;
+    EXTLOG_LOG(WARN, "err append result, buf not enough", K(ret),
+               LITERAL_K(ITEM_CNT_LMT),
+               "count", res_.count());
+  } else if (OB_SUCCESS != (ret = res_.push_back(result))) {
+    EXTLOG_LOG(ERROR, "err push back result", K(ret));
+  }
+
+  return ret;
+}
+
+OB_DEF_SERIALIZE(ObCdcLSSubscribeLogResp)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_ENCODE, rpc_ver_, err_, res_);
+  return ret;
+}
+
+OB_DEF_SERIALIZE_SIZE(ObCdcLSSubscribeLogResp)
+{
+  int64_t len = 0;
+  LST_DO_CODE(OB_UNIS_ADD_LEN, rpc_ver_, err_, res_);
+  return len;
+}
+
+OB_DEF_DESERIALIZE(ObCdcLSSubscribeLogResp)
+{
+  int ret = OB_SUCCESS;
+  LST_DO_CODE(OB_UNIS_DECODE, rpc_ver_);
+  if (CUR_RPC_VER == rpc_ver_) {
+    LST_DO_CODE(OB_UNIS_DECODE, err_, res_);
+  } else {
+    ret = OB_NOT_SUPPORTED;
+    EXTLOG_LOG(ERROR, "deserialize error, version not match",
+               K(ret), K(rpc_ver_), LITERAL_K(CUR_RPC_VER));
+  }
+  return ret;
+}
+
 } // obrpc
 } // namespace oceanbase
@@ -36,6 +36,9 @@ class ObCdcLSFetchLogResp;
 
 class ObCdcLSFetchMissLogReq;
 
+class ObCdcLSSubscribeLogReq;
+class ObCdcLSSubscribeLogResp;
+
 class ObCdcReqStartLSNByTsReq
 {
 public:
@@ -399,6 +402,115 @@ private:
   uint64_t client_pid_;  // Process ID.
 };
 
+
+/*
+ * Subscribe log of a batch of LS.
+ *
+ * The request is held by server until new logs are committed after start_lsn of some LS, or
+ * wait_time is reached. The LS which have new logs are returned with their end_lsn, CDC
+ * Connector fetches the logs by ObCdcLSFetchLogReq and subscribes again from the next LSN.
+ * Server stops collecting results when the pending log size of the returned LS reaches credit,
+ * so that the connector is not woken up for more logs than it can consume.
+ */
+class ObCdcLSSubscribeLogReq
+{
+public:
+  static const int64_t CUR_RPC_VER = 1;
+  static const int64_t ITEM_CNT_LMT = 10000;
+
+public:
+  struct SubscribeParam
+  {
+    ObLSID ls_id_;
+    LSN start_lsn_;
+    void reset();
+    void reset(const ObLSID &ls_id, const LSN &start_lsn);
+    bool is_valid() const;
+    TO_STRING_KV(K_(ls_id), K_(start_lsn));
+    OB_UNIS_VERSION(1);
+  };
+  typedef common::ObSEArray<SubscribeParam, 16> SubscribeParamArray;
+public:
+  ObCdcLSSubscribeLogReq();
+  ~ObCdcLSSubscribeLogReq();
+public:
+  void reset();
+  bool is_valid() const;
+  int64_t get_rpc_version() const { return rpc_ver_; }
+  void set_rpc_version(const int64_t ver) { rpc_ver_ = ver; }
+
+  int append_param(const SubscribeParam &param);
+  const SubscribeParamArray &get_params() const { return params_; }
+
+  void set_wait_time(const int64_t wait_time) { wait_time_ = wait_time; }
+  int64_t get_wait_time() const { return wait_time_; }
+
+  void set_credit(const int64_t credit) { credit_ = credit; }
+  int64_t get_credit() const { return credit_; }
+
+  void set_client_pid(const uint64_t id) { client_pid_ = id; }
+  uint64_t get_client_pid() const { return client_pid_; }
+
+  TO_STRING_KV(K_(rpc_ver), K_(wait_time), K_(credit), K_(client_pid),
+      "param_count", params_.count(), K_(params));
+  OB_UNIS_VERSION(1);
+private:
+  int64_t rpc_ver_;
+  SubscribeParamArray params_;
+  int64_t wait_time_;   // max time(us) held by server
+  int64_t credit_;      // max pending log size(bytes) of returned LS
+  uint64_t client_pid_; // Process ID.
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCdcLSSubscribeLogReq);
+};
+
+/// subscribe log result
+///
+/// Only the LS which have new logs or fail are returned, it is empty if wait_time is reached.
+class ObCdcLSSubscribeLogResp
+{
+  static const int64_t CUR_RPC_VER = 1;
+  static const int64_t ITEM_CNT_LMT = 10000;
+public:
+  struct SubscribeResult
+  {
+    // LS specific error code.
+    // - OB_SUCCESS: there are new logs in [start_lsn, end_lsn)
+    // - OB_LS_NOT_EXIST: LS not exist in this server
+    // - Other code: fail
+    ObLSID ls_id_;
+    int err_;
+    LSN end_lsn_;
+
+    void reset();
+    void reset(const ObLSID &ls_id, const int err, const LSN &end_lsn);
+
+    TO_STRING_KV(K_(ls_id), K_(err), K_(end_lsn));
+    OB_UNIS_VERSION(1);
+  };
+  typedef common::ObSEArray<SubscribeResult, 16> SubscribeResultArray;
+public:
+  ObCdcLSSubscribeLogResp();
+  ~ObCdcLSSubscribeLogResp();
+public:
+  void reset();
+  int64_t get_rpc_version() const { return rpc_ver_; }
+  void set_rpc_version(const int64_t ver) { rpc_ver_ = ver; }
+  void set_err(const int err) { err_ = err; }
+  int get_err() const { return err_; }
+
+  int append_result(const SubscribeResult &result);
+  const SubscribeResultArray &get_results() const { return res_; }
+  TO_STRING_KV(K_(rpc_ver), K_(err), "result_count", res_.count(), "result", res_);
+  OB_UNIS_VERSION(1);
+private:
+  int64_t rpc_ver_;
+  int err_;
+  SubscribeResultArray res_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCdcLSSubscribeLogResp);
+};
+
 } // namespace obrpc
 } // namespace oceanbase
 
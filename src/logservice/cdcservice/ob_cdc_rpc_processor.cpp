@@ -99,5 +99,34 @@ int ObCdcLSFetchMissingLogP::process()
   return OB_SUCCESS;
 }
 
+int ObCdcLSSubscribeLogP::process()
+{
+  int ret = common::OB_SUCCESS;
+  const ObCdcLSSubscribeLogReq &req = arg_;
+  ObCdcLSSubscribeLogResp &resp = result_;
+  cdc::ObCdcService *cdc_service = nullptr;
+
+  if (OB_FAIL(__get_cdc_service(rpc_pkt_->get_tenant_id(), cdc_service))) {
+    EXTLOG_LOG(ERROR, "__get_cdc_service failed", KR(ret));
+  } else if (OB_ISNULL(cdc_service)) {
+    ret = OB_ERR_UNEXPECTED;
+    EXTLOG_LOG(ERROR, "cdc_service is null", KR(ret));
+  } else {
+    ret = cdc_service->subscribe_log(req, resp, get_receive_timestamp(), need_retry_in_queue_);
+  }
+
+  // rewrite ret for rpc framework
+  return OB_SUCCESS;
+}
+
+int ObCdcLSSubscribeLogP::response(const int retcode)
+{
+  int ret = OB_SUCCESS;
+  if (! need_retry_in_queue_) {
+    ret = ObRpcProcessor::response(retcode);
+  }
+  return ret;
+}
+
 } // namespace obrpc
 } // namespace oceanbase
@@ -53,6 +53,20 @@ protected:
   int process();
 };
 
+class ObCdcLSSubscribeLogP : public
+  obrpc::ObRpcProcessor<obrpc::ObCdcProxy::ObRpc<obrpc::OB_LS_SUBSCRIBE_LOG> >
+{
+public:
+  ObCdcLSSubscribeLogP() : need_retry_in_queue_(false) {}
+  ~ObCdcLSSubscribeLogP() {}
+protected:
+  int process();
+  // the response can NOT be sent if the request is waiting for retry in queue
+  virtual int response(const int retcode) override;
+private:
+  bool need_retry_in_queue_;
+};
+
 } // namespace obrpc
 } // namespace oceanbase
 
@@ -27,6 +27,9 @@ class ObCdcReqStartLSNByTsResp;
 class ObCdcLSFetchLogReq;
 class ObCdcLSFetchLogResp;
 
+class ObCdcLSSubscribeLogReq;
+class ObCdcLSSubscribeLogResp;
+
 // TODO deps/oblib/src/rpc/obrpc/ob_rpc_packet_list.h remove some rpc code
 class ObCdcProxy : public ObRpcProxy
 {
@@ -41,6 +44,9 @@ public:
 
   RPC_AP(@PR5 async_stream_fetch_miss_log, OB_LS_FETCH_MISSING_LOG,
          (ObCdcLSFetchMissLogReq), ObCdcLSFetchLogResp);
+
+  RPC_AP(@PR5 async_subscribe_log, OB_LS_SUBSCRIBE_LOG,
+         (ObCdcLSSubscribeLogReq), ObCdcLSSubscribeLogResp);
 };
 
 } // namespace obrpc
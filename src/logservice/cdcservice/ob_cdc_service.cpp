@@ -167,6 +167,31 @@ int ObCdcService::fetch_missing_log(const obrpc::ObCdcLSFetchMissLogReq &req,
   return ret;
 }
 
+int ObCdcService::subscribe_log(const obrpc::ObCdcLSSubscribeLogReq &req,
+    obrpc::ObCdcLSSubscribeLogResp &resp,
+    const int64_t receive_ts,
+    bool &need_retry)
+{
+  int ret = OB_SUCCESS;
+  need_retry = false;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    EXTLOG_LOG(WARN, "ObCdcService not init", KR(ret));
+  } else if (is_stoped()) {
+    resp.set_err(OB_IN_STOP_STATE);
+    EXTLOG_LOG(INFO, "ObCdcService is stopped", K(req));
+  } else {
+    ret = fetcher_.subscribe_log(req, resp, receive_ts, stop_flag_, need_retry);
+    if (! need_retry) {
+      EVENT_INC(CLOG_EXTLOG_SUBSCRIBE_RPC_COUNT);
+    }
+    EXTLOG_LOG(TRACE, "ObCdcService subscribe_log", K(ret), K(need_retry), K(req), K(resp));
+  }
+
+  return ret;
+}
+
 void ObCdcService::do_monitor_stat_(const int64_t start_ts,
     const int64_t end_ts,
     const int64_t send_ts,
@@ -53,6 +53,13 @@ public:
       const int64_t send_ts,
       const int64_t recv_ts);
 
+  // check whether some LS have new logs, need_retry is set if the request should be
+  // checked again later instead of being responded
+  int subscribe_log(const obrpc::ObCdcLSSubscribeLogReq &req,
+      obrpc::ObCdcLSSubscribeLogResp &resp,
+      const int64_t receive_ts,
+      bool &need_retry);
+
   TO_STRING_KV(K_(is_inited));
 
 private:
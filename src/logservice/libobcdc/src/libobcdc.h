@@ -30,6 +30,51 @@
 #include "oblogmsg/LogRecord.h"
 typedef oceanbase::logmessage::ILogRecord ICDCRecord;
 
+// Arrow C data interface, see https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema
+{
+  // Array type description
+  const char *format;
+  const char *name;
+  const char *metadata;
+  int64_t flags;
+  int64_t n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema *dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowSchema *);
+  // Opaque producer-specific data
+  void *private_data;
+};
+
+struct ArrowArray
+{
+  // Array data description
+  int64_t length;
+  int64_t null_count;
+  int64_t offset;
+  int64_t n_buffers;
+  int64_t n_children;
+  const void **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray *dictionary;
+
+  // Release callback
+  void (*release)(struct ArrowArray *);
+  // Opaque producer-specific data
+  void *private_data;
+};
+
+#endif  // ARROW_C_DATA_INTERFACE
+
 namespace oceanbase
 {
 namespace libobcdc
@@ -133,6 +178,40 @@ public:
   /// @retval OB_SUCCESS      success
   /// @retval other value     fail
   virtual int get_tenant_ids(std::vector<uint64_t> &tenant_ids) = 0;
+
+  /*
+   * fetch next batch of DML records of the same table, in the layout of Arrow C data interface
+   * The batch is a struct array named "<database>.<table>", with columns:
+   *   __op_type         int8,   record type of DML: EINSERT/EUPDATE/EDELETE...
+   *   __commit_version  int64,  commit version of transaction
+   *   <column name>     new value for INSERT/UPDATE, old value for DELETE, int64/uint64 for integer,
+   *                     year and bit columns, float64 for float and double columns, large utf8 or
+   *                     large binary for others. A numeric column whose value can not be parsed is
+   *                     output as large utf8 in that batch.
+   * The values are copied into the batch, the DML records are released by libobcdc.
+   *
+   * The batch ends at the first record which is not a DML record of the same table. If there is no
+   * DML record before such a record, the record is returned by record and the batch is empty
+   * (release of schema and array is NULL), and the record should be released by release_record.
+   *
+   * NOTE: can not be used with next_record by multiple threads at the same time
+   * NOTE: declared last to keep the vtable layout of the interfaces before it
+   *
+   * @param [out] schema        schema of batch, released by schema->release
+   * @param [out] array         data of batch, released by array->release
+   * @param [out] record        non-DML record, NULL if batch is not empty
+   * @param [in]  max_row_count max row count of batch
+   * @param [in]  timeout_us    timeout to wait for records
+   *
+   * @retval OB_SUCCESS       success
+   * @retval OB_TIMEOUT       timeout, and there is no record
+   * @retval other error code fail, the records are not released and returned by the next call
+   */
+  virtual int next_batch(ArrowSchema *schema,
+      ArrowArray *array,
+      ICDCRecord **record,
+      const int64_t max_row_count,
+      const int64_t timeout_us) = 0;
 };
 
 class ObCDCFactory
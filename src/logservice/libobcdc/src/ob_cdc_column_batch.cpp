@@ -0,0 +1,597 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Column batch of DML records, in the layout of Arrow C data interface
+ */
+
+#define USING_LOG_PREFIX OBLOG
+
+#include "ob_cdc_column_batch.h"
+
+#include <strings.h>                            // strncasecmp
+#include <stdlib.h>                             // strtoll, strtoull, strtod
+#include <ctype.h>                              // isspace
+#include <errno.h>                              // errno, ERANGE
+
+#include "lib/utility/ob_utility.h"           // upper_align
+#include "rpc/obmysql/ob_mysql_global.h"      // MYSQL_TYPE_*
+#include "ob_log_binlog_record.h"             // ObLogBR
+#include "ob_log_utils.h"                     // is_lob_type
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+// Arrow format strings
+static const char *ARROW_FORMAT_STRUCT = "+s";
+static const char *ARROW_FORMAT_INT8 = "c";
+static const char *ARROW_FORMAT_INT64 = "l";
+static const char *ARROW_FORMAT_UINT64 = "L";
+static const char *ARROW_FORMAT_DOUBLE = "g";
+static const char *ARROW_FORMAT_LARGE_UTF8 = "U";
+static const char *ARROW_FORMAT_LARGE_BINARY = "Z";
+// buffers are 8 bytes aligned
+static const int64_t ARROW_BUFFER_ALIGN = 8;
+
+const char *ObCDCColumnBatchBuilder::OP_TYPE_COLUMN_NAME = "__op_type";
+const char *ObCDCColumnBatchBuilder::COMMIT_VERSION_COLUMN_NAME = "__commit_version";
+
+ObCDCColumnBatchBuilder::ObCDCColumnBatchBuilder() :
+    records_(),
+    table_meta_(NULL),
+    column_count_(0),
+    col_formats_(),
+    data_sizes_()
+{
+}
+
+ObCDCColumnBatchBuilder::~ObCDCColumnBatchBuilder()
+{
+  reset();
+}
+
+void ObCDCColumnBatchBuilder::reset()
+{
+  records_.reset();
+  table_meta_ = NULL;
+  column_count_ = 0;
+  col_formats_.reset();
+  data_sizes_.reset();
+}
+
+bool ObCDCColumnBatchBuilder::is_dml_record(IBinlogRecord &record)
+{
+  const int record_type = record.recordType();
+  return EINSERT == record_type || EUPDATE == record_type || EDELETE == record_type;
+}
+
+bool ObCDCColumnBatchBuilder::can_append(IBinlogRecord &record) const
+{
+  bool bool_ret = false;
+
+  if (is_dml_record(record)) {
+    ITableMeta *table_meta = record.getTableMeta();
+    // table meta is changed by DDL, rows of different table meta are built into different batches
+    bool_ret = (NULL != table_meta) && (records_.count() <= 0 || table_meta == table_meta_);
+  }
+
+  return bool_ret;
+}
+
+int ObCDCColumnBatchBuilder::append(IBinlogRecord &record)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(! can_append(record))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("record can not be appended to column batch", KR(ret), "record_type", record.recordType(),
+        "table_meta", record.getTableMeta(), K_(table_meta), "row_count", records_.count());
+  } else if (OB_FAIL(records_.push_back(&record))) {
+    LOG_ERROR("push back record fail", KR(ret), "row_count", records_.count());
+  } else if (1 == records_.count()) {
+    table_meta_ = record.getTableMeta();
+    column_count_ = table_meta_->getColCount();
+  }
+
+  return ret;
+}
+
+int ObCDCColumnBatchBuilder::build(ArrowSchema &schema, ArrowArray &array)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(records_.count() <= 0) || OB_ISNULL(table_meta_)) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_ERROR("column batch is empty", KR(ret), "row_count", records_.count(), K_(table_meta));
+  } else if (OB_FAIL(prepare_columns_())) {
+    LOG_ERROR("prepare_columns_ fail", KR(ret), K_(column_count), "row_count", records_.count());
+  } else if (OB_FAIL(build_schema_(schema))) {
+    LOG_ERROR("build_schema_ fail", KR(ret), K_(column_count));
+  } else if (OB_FAIL(build_array_(array))) {
+    LOG_ERROR("build_array_ fail", KR(ret), K_(column_count), "row_count", records_.count());
+    schema.release(&schema);
+  }
+
+  return ret;
+}
+
+void ObCDCColumnBatchBuilder::release_schema_(ArrowSchema *schema)
+{
+  if (NULL != schema && NULL != schema->release) {
+    for (int64_t idx = 0; idx < schema->n_children; idx++) {
+      ArrowSchema *child = schema->children[idx];
+      if (NULL != child->release) {
+        child->release(child);
+      }
+    }
+    ob_free(schema->private_data);
+    schema->private_data = NULL;
+    schema->release = NULL;
+  }
+}
+
+void ObCDCColumnBatchBuilder::release_child_schema_(ArrowSchema *schema)
+{
+  // memory is owned by parent
+  if (NULL != schema) {
+    schema->release = NULL;
+  }
+}
+
+void ObCDCColumnBatchBuilder::release_array_(ArrowArray *array)
+{
+  if (NULL != array && NULL != array->release) {
+    for (int64_t idx = 0; idx < array->n_children; idx++) {
+      ArrowArray *child = array->children[idx];
+      if (NULL != child->release) {
+        child->release(child);
+      }
+    }
+    ob_free(array->private_data);
+    array->private_data = NULL;
+    array->release = NULL;
+  }
+}
+
+void ObCDCColumnBatchBuilder::release_child_array_(ArrowArray *array)
+{
+  // memory is owned by parent
+  if (NULL != array) {
+    array->release = NULL;
+  }
+}
+
+// The value of string types is in the charset of column, which is output as utf8 only if the
+// charset is utf8. Values of other non-numeric types are formatted as ascii strings.
+ObCDCColumnBatchBuilder::ColumnFormat ObCDCColumnBatchBuilder::get_column_format_(IColMeta *col_meta)
+{
+  ColumnFormat format = COLUMN_FORMAT_LARGE_UTF8;
+
+  if (NULL != col_meta) {
+    const int ctype = col_meta->getType();
+    const char *encoding = col_meta->getEncoding();
+    bool is_string_type = is_lob_type(ctype);
+
+    switch (ctype) {
+      case obmysql::MYSQL_TYPE_TINY:
+      case obmysql::MYSQL_TYPE_SHORT:
+      case obmysql::MYSQL_TYPE_INT24:
+      case obmysql::MYSQL_TYPE_LONG:
+      case obmysql::MYSQL_TYPE_LONGLONG:
+      case obmysql::MYSQL_TYPE_YEAR:
+        format = col_meta->isSigned() ? COLUMN_FORMAT_INT64 : COLUMN_FORMAT_UINT64;
+        break;
+      case obmysql::MYSQL_TYPE_BIT:
+        format = COLUMN_FORMAT_UINT64;
+        break;
+      case obmysql::MYSQL_TYPE_FLOAT:
+      case obmysql::MYSQL_TYPE_DOUBLE:
+        format = COLUMN_FORMAT_DOUBLE;
+        break;
+      case obmysql::MYSQL_TYPE_VARCHAR:
+      case obmysql::MYSQL_TYPE_VAR_STRING:
+      case obmysql::MYSQL_TYPE_STRING:
+      case obmysql::MYSQL_TYPE_ENUM:
+      case obmysql::MYSQL_TYPE_SET:
+      case obmysql::MYSQL_TYPE_GEOMETRY:
+      case obmysql::MYSQL_TYPE_OB_RAW:
+      case obmysql::MYSQL_TYPE_OB_NVARCHAR2:
+      case obmysql::MYSQL_TYPE_OB_NCHAR:
+      case obmysql::MYSQL_TYPE_ORA_BLOB:
+      case obmysql::MYSQL_TYPE_ORA_CLOB:
+        is_string_type = true;
+        break;
+      default:
+        break;
+    }
+
+    if (is_string_type && (NULL == encoding || 0 != strncasecmp(encoding, "utf8", 4))) {
+      format = COLUMN_FORMAT_LARGE_BINARY;
+    }
+  }
+
+  return format;
+}
+
+const char *ObCDCColumnBatchBuilder::get_arrow_format_(const ColumnFormat format)
+{
+  const char *arrow_format = ARROW_FORMAT_LARGE_UTF8;
+
+  switch (format) {
+    case COLUMN_FORMAT_INT64:
+      arrow_format = ARROW_FORMAT_INT64;
+      break;
+    case COLUMN_FORMAT_UINT64:
+      arrow_format = ARROW_FORMAT_UINT64;
+      break;
+    case COLUMN_FORMAT_DOUBLE:
+      arrow_format = ARROW_FORMAT_DOUBLE;
+      break;
+    case COLUMN_FORMAT_LARGE_BINARY:
+      arrow_format = ARROW_FORMAT_LARGE_BINARY;
+      break;
+    default:
+      break;
+  }
+
+  return arrow_format;
+}
+
+int ObCDCColumnBatchBuilder::parse_value_(const ColumnFormat format,
+    const char *buf,
+    const int64_t len,
+    char *value)
+{
+  int ret = OB_SUCCESS;
+  char str[MAX_NUMBER_STR_LENGTH + 1];
+  char *end = NULL;
+
+  if (OB_ISNULL(buf) || OB_UNLIKELY(len <= 0 || len > MAX_NUMBER_STR_LENGTH)) {
+    ret = OB_INVALID_DATA;
+  } else {
+    MEMCPY(str, buf, len);
+    str[len] = '\0';
+  }
+
+  if (OB_FAIL(ret)) {
+  } else if (isspace(str[0]) || (COLUMN_FORMAT_UINT64 == format && '-' == str[0])) {
+    // strtoxx skips leading spaces and accepts negative value for unsigned
+    ret = OB_INVALID_DATA;
+  } else {
+    errno = 0;
+    if (COLUMN_FORMAT_INT64 == format) {
+      const int64_t v = strtoll(str, &end, 10);
+      if (NULL != value) {
+        MEMCPY(value, &v, sizeof(v));
+      }
+    } else if (COLUMN_FORMAT_UINT64 == format) {
+      const uint64_t v = strtoull(str, &end, 10);
+      if (NULL != value) {
+        MEMCPY(value, &v, sizeof(v));
+      }
+    } else if (COLUMN_FORMAT_DOUBLE == format) {
+      const double v = strtod(str, &end);
+      if (NULL != value) {
+        MEMCPY(value, &v, sizeof(v));
+      }
+    } else {
+      ret = OB_NOT_SUPPORTED;
+    }
+
+    if (OB_SUCC(ret) && (end != str + len || ERANGE == errno)) {
+      ret = OB_INVALID_DATA;
+    }
+  }
+
+  return ret;
+}
+
+const binlogBuf *ObCDCColumnBatchBuilder::get_values_(IBinlogRecord &record, unsigned int &value_count)
+{
+  const binlogBuf *values = NULL;
+  value_count = 0;
+
+  if (EDELETE == record.recordType()) {
+    values = record.oldCols(value_count);
+  } else {
+    values = record.newCols(value_count);
+  }
+
+  return values;
+}
+
+int ObCDCColumnBatchBuilder::prepare_columns_()
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = records_.count();
+
+  col_formats_.reset();
+  data_sizes_.reset();
+
+  for (int64_t col_idx = 0; OB_SUCC(ret) && col_idx < column_count_; col_idx++) {
+    if (OB_FAIL(col_formats_.push_back(get_column_format_(table_meta_->getCol(static_cast<int>(col_idx)))))) {
+      LOG_ERROR("push back column format fail", KR(ret), K(col_idx));
+    } else if (OB_FAIL(data_sizes_.push_back(0))) {
+      LOG_ERROR("push back data size fail", KR(ret), K(col_idx));
+    }
+  }
+
+  for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; row_idx++) {
+    unsigned int value_count = 0;
+    const binlogBuf *values = get_values_(*records_.at(row_idx), value_count);
+
+    for (int64_t col_idx = 0; col_idx < column_count_ && col_idx < value_count; col_idx++) {
+      const binlogBuf &value = values[col_idx];
+
+      if (NULL == value.buf) {
+        // NULL
+      } else if (is_fixed_width_(col_formats_.at(col_idx))
+          && OB_SUCCESS != parse_value_(col_formats_.at(col_idx), value.buf, value.buf_used_size, NULL)) {
+        LOG_DEBUG("numeric value can not be parsed, output column as string",
+            K(col_idx), K(row_idx), "value", ObString(value.buf_used_size, value.buf));
+        col_formats_.at(col_idx) = COLUMN_FORMAT_LARGE_UTF8;
+      }
+    }
+  }
+
+  for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; row_idx++) {
+    unsigned int value_count = 0;
+    const binlogBuf *values = get_values_(*records_.at(row_idx), value_count);
+
+    for (int64_t col_idx = 0; col_idx < column_count_ && col_idx < value_count; col_idx++) {
+      if (NULL != values[col_idx].buf && ! is_fixed_width_(col_formats_.at(col_idx))) {
+        data_sizes_.at(col_idx) += values[col_idx].buf_used_size;
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObCDCColumnBatchBuilder::build_schema_(ArrowSchema &schema)
+{
+  int ret = OB_SUCCESS;
+  const int64_t child_count = column_count_ + EXTRA_COLUMN_COUNT;
+  const char *db_name = records_.at(0)->dbname();
+  const char *tb_name = records_.at(0)->tbname();
+  const int64_t db_name_len = (NULL == db_name) ? 0 : strlen(db_name);
+  const int64_t tb_name_len = (NULL == tb_name) ? 0 : strlen(tb_name);
+  // "<db>.<tb>\0"
+  int64_t names_size = db_name_len + tb_name_len + 2;
+
+  for (int64_t idx = 0; idx < column_count_; idx++) {
+    IColMeta *col_meta = table_meta_->getCol(static_cast<int>(idx));
+    const char *col_name = (NULL == col_meta) ? NULL : col_meta->getName();
+    names_size += ((NULL == col_name) ? 0 : strlen(col_name)) + 1;
+  }
+
+  const int64_t alloc_size = child_count * (sizeof(ArrowSchema) + sizeof(ArrowSchema *)) + names_size;
+  char *buf = static_cast<char *>(ob_malloc(alloc_size, "CDCColBatch"));
+
+  if (OB_ISNULL(buf)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate memory for column batch schema fail", KR(ret), K(alloc_size), K(child_count));
+  } else {
+    ArrowSchema *children = reinterpret_cast<ArrowSchema *>(buf);
+    ArrowSchema **children_ptr = reinterpret_cast<ArrowSchema **>(children + child_count);
+    char *names = reinterpret_cast<char *>(children_ptr + child_count);
+    int64_t pos = 0;
+
+    MEMCPY(names + pos, db_name, db_name_len);
+    pos += db_name_len;
+    names[pos++] = '.';
+    MEMCPY(names + pos, tb_name, tb_name_len);
+    pos += tb_name_len;
+    names[pos++] = '\0';
+
+    schema.format = ARROW_FORMAT_STRUCT;
+    schema.name = names;
+    schema.metadata = NULL;
+    schema.flags = 0;
+    schema.n_children = child_count;
+    schema.children = children_ptr;
+    schema.dictionary = NULL;
+    schema.release = release_schema_;
+    schema.private_data = buf;
+
+    for (int64_t idx = 0; idx < child_count; idx++) {
+      ArrowSchema &child = children[idx];
+      children_ptr[idx] = &child;
+      child.metadata = NULL;
+      child.n_children = 0;
+      child.children = NULL;
+      child.dictionary = NULL;
+      child.release = release_child_schema_;
+      child.private_data = NULL;
+
+      if (0 == idx) {
+        child.format = ARROW_FORMAT_INT8;
+        child.name = OP_TYPE_COLUMN_NAME;
+        child.flags = 0;
+      } else if (1 == idx) {
+        child.format = ARROW_FORMAT_INT64;
+        child.name = COMMIT_VERSION_COLUMN_NAME;
+        child.flags = 0;
+      } else {
+        IColMeta *col_meta = table_meta_->getCol(static_cast<int>(idx - EXTRA_COLUMN_COUNT));
+        const char *col_name = (NULL == col_meta) ? NULL : col_meta->getName();
+        const int64_t col_name_len = (NULL == col_name) ? 0 : strlen(col_name);
+
+        MEMCPY(names + pos, col_name, col_name_len);
+        child.name = names + pos;
+        pos += col_name_len;
+        names[pos++] = '\0';
+        child.format = get_arrow_format_(col_formats_.at(idx - EXTRA_COLUMN_COUNT));
+        child.flags = ARROW_FLAG_NULLABLE;
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObCDCColumnBatchBuilder::build_array_(ArrowArray &array)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = records_.count();
+  const int64_t child_count = column_count_ + EXTRA_COLUMN_COUNT;
+  const int64_t bitmap_size = upper_align((row_count + 7) / 8, ARROW_BUFFER_ALIGN);
+  const int64_t offsets_size = (row_count + 1) * sizeof(int64_t);
+  const int64_t fixed_values_size = row_count * sizeof(int64_t);
+  // one validity buffer of struct, two buffers of each extra column and fixed width column,
+  // three buffers of each variable width column
+  int64_t buffer_count = 1 + 2 * EXTRA_COLUMN_COUNT;
+  int64_t data_size = upper_align(row_count * sizeof(int8_t), ARROW_BUFFER_ALIGN) + fixed_values_size;
+
+  for (int64_t col_idx = 0; col_idx < column_count_; col_idx++) {
+    if (is_fixed_width_(col_formats_.at(col_idx))) {
+      buffer_count += 2;
+      data_size += bitmap_size + fixed_values_size;
+    } else {
+      buffer_count += 3;
+      data_size += bitmap_size + offsets_size + upper_align(data_sizes_.at(col_idx), ARROW_BUFFER_ALIGN);
+    }
+  }
+
+  const int64_t header_size = upper_align(child_count * (sizeof(ArrowArray) + sizeof(ArrowArray *))
+      + buffer_count * sizeof(void *), ARROW_BUFFER_ALIGN);
+  const int64_t alloc_size = header_size + data_size;
+  char *buf = NULL;
+
+  if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(alloc_size, "CDCColBatch")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate memory for column batch array fail", KR(ret), K(alloc_size), K(row_count),
+        K(child_count));
+  } else {
+    ArrowArray *children = reinterpret_cast<ArrowArray *>(buf);
+    ArrowArray **children_ptr = reinterpret_cast<ArrowArray **>(children + child_count);
+    const void **buffers = reinterpret_cast<const void **>(
+        buf + child_count * (sizeof(ArrowArray) + sizeof(ArrowArray *)));
+    char *data = buf + header_size;
+
+    array.length = row_count;
+    array.null_count = 0;
+    array.offset = 0;
+    array.n_buffers = 1;
+    array.n_children = child_count;
+    array.buffers = buffers;
+    array.children = children_ptr;
+    array.dictionary = NULL;
+    array.release = release_array_;
+    array.private_data = buf;
+    // no validity bitmap, all rows of struct are valid
+    *buffers++ = NULL;
+
+    // __op_type and __commit_version
+    int8_t *op_types = reinterpret_cast<int8_t *>(data);
+    data += upper_align(row_count * sizeof(int8_t), ARROW_BUFFER_ALIGN);
+    int64_t *commit_versions = reinterpret_cast<int64_t *>(data);
+    data += fixed_values_size;
+
+    for (int64_t row_idx = 0; row_idx < row_count; row_idx++) {
+      IBinlogRecord *record = records_.at(row_idx);
+      ObLogBR *br = reinterpret_cast<ObLogBR *>(record->getUserData());
+      op_types[row_idx] = static_cast<int8_t>(record->recordType());
+      commit_versions[row_idx] = (NULL == br) ? 0 : br->get_commit_version();
+    }
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < child_count; idx++) {
+      ArrowArray &child = children[idx];
+      children_ptr[idx] = &child;
+      child.length = row_count;
+      child.null_count = 0;
+      child.offset = 0;
+      child.n_children = 0;
+      child.children = NULL;
+      child.dictionary = NULL;
+      child.release = release_child_array_;
+      child.private_data = NULL;
+      child.buffers = buffers;
+
+      if (idx < EXTRA_COLUMN_COUNT) {
+        child.n_buffers = 2;
+        buffers[0] = NULL;
+        buffers[1] = (0 == idx) ? static_cast<const void *>(op_types) : static_cast<const void *>(commit_versions);
+        buffers += 2;
+      } else {
+        const int64_t col_idx = idx - EXTRA_COLUMN_COUNT;
+        const ColumnFormat format = col_formats_.at(col_idx);
+        const bool is_fixed_width = is_fixed_width_(format);
+        uint8_t *bitmap = reinterpret_cast<uint8_t *>(data);
+        // values of fixed width column, or offsets of variable width column
+        char *values_data = data + bitmap_size;
+        int64_t *offsets = reinterpret_cast<int64_t *>(data + bitmap_size);
+        int64_t values_pos = 0;
+
+        MEMSET(bitmap, 0, bitmap_size);
+        if (is_fixed_width) {
+          MEMSET(values_data, 0, fixed_values_size);
+        } else {
+          values_data = data + bitmap_size + offsets_size;
+          offsets[0] = 0;
+        }
+
+        for (int64_t row_idx = 0; OB_SUCC(ret) && row_idx < row_count; row_idx++) {
+          unsigned int value_count = 0;
+          const binlogBuf *values = get_values_(*records_.at(row_idx), value_count);
+
+          if (col_idx >= value_count || NULL == values[col_idx].buf) {
+            child.null_count++;
+          } else if (is_fixed_width) {
+            // the values have been checked in prepare_columns_
+            if (OB_FAIL(parse_value_(format, values[col_idx].buf, values[col_idx].buf_used_size,
+                values_data + row_idx * sizeof(int64_t)))) {
+              LOG_ERROR("parse numeric value fail", KR(ret), K(col_idx), K(row_idx), "format", static_cast<int64_t>(format));
+            } else {
+              bitmap[row_idx / 8] |= static_cast<uint8_t>(1 << (row_idx % 8));
+            }
+          } else {
+            bitmap[row_idx / 8] |= static_cast<uint8_t>(1 << (row_idx % 8));
+            MEMCPY(values_data + values_pos, values[col_idx].buf, values[col_idx].buf_used_size);
+            values_pos += values[col_idx].buf_used_size;
+          }
+
+          if (! is_fixed_width) {
+            offsets[row_idx + 1] = values_pos;
+          }
+        }
+
+        if (is_fixed_width) {
+          child.n_buffers = 2;
+          buffers[0] = bitmap;
+          buffers[1] = values_data;
+          buffers += 2;
+          data += bitmap_size + fixed_values_size;
+        } else {
+          child.n_buffers = 3;
+          buffers[0] = bitmap;
+          buffers[1] = offsets;
+          buffers[2] = values_data;
+          buffers += 3;
+          data += bitmap_size + offsets_size + upper_align(data_sizes_.at(col_idx), ARROW_BUFFER_ALIGN);
+        }
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+      ob_free(buf);
+      array.private_data = NULL;
+      array.release = NULL;
+    }
+  }
+
+  return ret;
+}
+
+} // namespace libobcdc
+} // namespace oceanbase
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Column batch of DML records, in the layout of Arrow C data interface
+ */
+
+#ifndef OCEANBASE_LIBOBCDC_OB_CDC_COLUMN_BATCH_H_
+#define OCEANBASE_LIBOBCDC_OB_CDC_COLUMN_BATCH_H_
+
+#include "lib/container/ob_se_array.h"      // ObSEArray
+#include "libobcdc.h"                       // ArrowSchema, ArrowArray
+#include "ob_cdc_msg_convert.h"             // IBinlogRecord, ITableMeta, IColMeta, binlogBuf
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+
+// Build DML records of the same table into a struct array with columns:
+//   __op_type          int8    record type: EINSERT/EUPDATE/EDELETE
+//   __commit_version   int64   commit version of transaction
+//   <column name>      new value for INSERT/UPDATE, old value for DELETE, in the format of:
+//                      int64/uint64 for integer, year and bit columns, float64 for float and double
+//                      columns, large utf8 or large binary for other columns
+//
+// The values are copied from the binlog records built by formatter into one buffer of the batch,
+// so the records can be released once the batch is built. Schema and array are allocated
+// separately, and released by their own release callback, the children are owned by the parent.
+//
+// Note: the values of binlog record are strings, the numeric columns are parsed from them. If any
+// value of a numeric column can not be parsed(e.g. hbase mode), the column is output as string in
+// this batch.
+class ObCDCColumnBatchBuilder
+{
+public:
+  static const int64_t EXTRA_COLUMN_COUNT = 2;
+  static const char *OP_TYPE_COLUMN_NAME;
+  static const char *COMMIT_VERSION_COLUMN_NAME;
+
+public:
+  ObCDCColumnBatchBuilder();
+  ~ObCDCColumnBatchBuilder();
+
+public:
+  static bool is_dml_record(IBinlogRecord &record);
+
+  // DML record of the same table meta with the records in batch
+  bool can_append(IBinlogRecord &record) const;
+  int append(IBinlogRecord &record);
+
+  // Build the batch into schema and array
+  // Note: records in batch are not released, and still belong to caller
+  int build(ArrowSchema &schema, ArrowArray &array);
+
+  int64_t get_row_count() const { return records_.count(); }
+  IBinlogRecord *get_record(const int64_t idx) const { return records_.at(idx); }
+  void reset();
+
+private:
+  enum ColumnFormat
+  {
+    COLUMN_FORMAT_INT64 = 0,
+    COLUMN_FORMAT_UINT64,
+    COLUMN_FORMAT_DOUBLE,
+    COLUMN_FORMAT_LARGE_UTF8,
+    COLUMN_FORMAT_LARGE_BINARY,
+  };
+  // max length of the string of numeric value
+  static const int64_t MAX_NUMBER_STR_LENGTH = 64;
+
+private:
+  static void release_schema_(ArrowSchema *schema);
+  static void release_child_schema_(ArrowSchema *schema);
+  static void release_array_(ArrowArray *array);
+  static void release_child_array_(ArrowArray *array);
+  static ColumnFormat get_column_format_(IColMeta *col_meta);
+  static bool is_fixed_width_(const ColumnFormat format) { return format <= COLUMN_FORMAT_DOUBLE; }
+  static const char *get_arrow_format_(const ColumnFormat format);
+  // parse numeric value into 'value' if it is not NULL
+  static int parse_value_(const ColumnFormat format, const char *buf, const int64_t len, char *value);
+  static const binlogBuf *get_values_(IBinlogRecord &record, unsigned int &value_count);
+
+  // decide the format and the data size of each column
+  int prepare_columns_();
+  int build_schema_(ArrowSchema &schema);
+  int build_array_(ArrowArray &array);
+
+private:
+  common::ObSEArray<IBinlogRecord *, 256> records_;
+  ITableMeta                              *table_meta_;
+  int64_t                                 column_count_;
+  common::ObSEArray<ColumnFormat, 64>     col_formats_;
+  common::ObSEArray<int64_t, 64>          data_sizes_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCDCColumnBatchBuilder);
+};
+
+} // namespace libobcdc
+} // namespace oceanbase
+
+#endif
@@ -329,6 +329,13 @@ public:
   T_DEF_INT_INFT(timer_task_count_upper_limit, OB_CLUSTER_PARAMETER, 1024, 1, "max timer task count");
   // Timer task timing time
   T_DEF_INT_INFT(timer_task_wait_time_msec, OB_CLUSTER_PARAMETER, 100, 1, "timer task wait time in milliseconds");
+  // Subscribe logs of idle LS from server instead of hibernating the fetch log stream by timer,
+  // the LS is woken up as soon as there are new logs on server
+  T_DEF_BOOL(enable_fetch_log_subscribe, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
+  // Max time the idle LS is subscribed, the fetch log stream is woken up after that even if there is no new log
+  T_DEF_INT_INFT(fetch_log_subscribe_wait_time_msec, OB_CLUSTER_PARAMETER, 100, 1, "fetch log subscribe wait time in milliseconds");
+  // Server stops notifying more LS when the size of pending logs of notified LS reaches credit
+  T_DEF_INT_INFT(fetch_log_subscribe_credit_mb, OB_CLUSTER_PARAMETER, 64, 1, "fetch log subscribe credit in MB");
   // SYS LS TASK OP TIMEOUT msec
   T_DEF_INT_INFT(sys_ls_task_op_timeout_msec, OB_CLUSTER_PARAMETER, 100, 1, "ddl data op timeout in milliseconds");
 
@@ -509,6 +516,10 @@ public:
    // Switch: Whether to format the module to print the relevant logs
   // No printing by default
   T_DEF_BOOL(enable_formatter_print_log, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
+  // Stmts of one redo log entry are pushed to formatter threads in chunks of formatter_stmt_chunk_size,
+  // so that the rows of a large redo log entry are formatted in parallel. 0 means not split
+  T_DEF_INT_INFT(formatter_stmt_chunk_size, OB_CLUSTER_PARAMETER, 256, 0,
+      "stmt count of one redo log entry pushed to the same formatter thread, 0 means not split");
 
   // Switch: Whether to enable SSL authentication: including MySQL and RPC
   // Disabled by default
@@ -0,0 +1,615 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Fetch Log Subscriber
+ */
+
+#define USING_LOG_PREFIX OBLOG_FETCHER
+
+#include "ob_log_fetch_log_subscriber.h"
+
+#include <unistd.h>                       // getpid
+#include "lib/allocator/ob_malloc.h"      // ob_malloc/ob_free
+#include "ob_log_rpc.h"                   // IObLogRpc
+#include "ob_ls_worker.h"                 // IObLSWorker
+#include "ob_log_ls_fetch_stream.h"       // FetchStream
+#include "ob_log_instance.h"              // IObLogErrHandler
+#include "ob_log_config.h"                // ObLogConfig
+
+using namespace oceanbase::common;
+using namespace oceanbase::obrpc;
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+
+bool ObLogFetchLogSubscriber::g_enable_subscribe =
+    ObLogConfig::default_enable_fetch_log_subscribe;
+int64_t ObLogFetchLogSubscriber::g_wait_time =
+    ObLogConfig::default_fetch_log_subscribe_wait_time_msec * _MSEC_;
+int64_t ObLogFetchLogSubscriber::g_credit =
+    ObLogConfig::default_fetch_log_subscribe_credit_mb * _M_;
+
+ObLogFetchLogSubscriber::ObLogFetchLogSubscriber() :
+    inited_(false),
+    tid_(0),
+    rpc_(NULL),
+    stream_worker_(NULL),
+    err_handler_(NULL),
+    cond_(),
+    lock_(),
+    pending_tasks_(),
+    done_requests_(NULL),
+    flying_requests_(),
+    stop_flag_(true)
+{}
+
+ObLogFetchLogSubscriber::~ObLogFetchLogSubscriber()
+{
+  destroy();
+}
+
+int ObLogFetchLogSubscriber::init(IObLogRpc &rpc,
+    IObLSWorker &stream_worker,
+    IObLogErrHandler &err_handler)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(inited_)) {
+    LOG_ERROR("init twice");
+    ret = OB_INIT_TWICE;
+  } else {
+    tid_ = 0;
+    rpc_ = &rpc;
+    stream_worker_ = &stream_worker;
+    err_handler_ = &err_handler;
+    done_requests_ = NULL;
+    stop_flag_ = true;
+    inited_ = true;
+
+    LOG_INFO("init fetch log subscriber succ");
+  }
+
+  return ret;
+}
+
+void ObLogFetchLogSubscriber::destroy()
+{
+  stop();
+
+  // The RPC of flying requests may still be running, the requests are leaked on purpose
+  // instead of being freed, the FetchStream are dropped the same as ObLogFixedTimer.
+  while (NULL != done_requests_) {
+    RpcRequest *next = done_requests_->next_;
+    free_request_(done_requests_);
+    done_requests_ = next;
+  }
+
+  inited_ = false;
+  tid_ = 0;
+  rpc_ = NULL;
+  stream_worker_ = NULL;
+  err_handler_ = NULL;
+  pending_tasks_.reset();
+  flying_requests_.reset();
+  stop_flag_ = true;
+
+  LOG_INFO("destroy fetch log subscriber succ");
+}
+
+int ObLogFetchLogSubscriber::start()
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("not init");
+    ret = OB_NOT_INIT;
+  } else if (stop_flag_) {
+    stop_flag_ = false;
+
+    int pthread_ret = pthread_create(&tid_, NULL, thread_func_, this);
+
+    if (OB_UNLIKELY(0 != pthread_ret)) {
+      LOG_ERROR("create fetch log subscriber thread fail", K(pthread_ret), KERRNOMSG(pthread_ret));
+      ret = OB_ERR_UNEXPECTED;
+    } else {
+      LOG_INFO("start fetch log subscriber succ");
+    }
+  }
+
+  return ret;
+}
+
+void ObLogFetchLogSubscriber::stop()
+{
+  if (inited_) {
+    stop_flag_ = true;
+
+    if (0 != tid_) {
+      int pthread_ret = pthread_join(tid_, NULL);
+      if (0 != pthread_ret) {
+        LOG_ERROR("pthread_join fail", K(tid_), K(pthread_ret), KERRNOMSG(pthread_ret));
+      }
+
+      tid_ = 0;
+
+      LOG_INFO("stop fetch log subscriber succ");
+    }
+  }
+}
+
+void ObLogFetchLogSubscriber::mark_stop_flag()
+{
+  stop_flag_ = true;
+}
+
+int ObLogFetchLogSubscriber::subscribe(FetchStream &task,
+    const uint64_t tenant_id,
+    const share::ObLSID &ls_id,
+    const common::ObAddr &svr,
+    const palf::LSN &start_lsn)
+{
+  int ret = OB_SUCCESS;
+  SubscribeTask subscribe_task;
+  subscribe_task.stream_ = &task;
+  subscribe_task.tenant_id_ = tenant_id;
+  subscribe_task.ls_id_ = ls_id;
+  subscribe_task.svr_ = svr;
+  subscribe_task.start_lsn_ = start_lsn;
+  subscribe_task.expire_tstamp_ = get_timestamp() + ATOMIC_LOAD(&g_wait_time);
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("not init");
+    ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(! ls_id.is_valid() || ! svr.is_valid() || ! start_lsn.is_valid())) {
+    LOG_ERROR("invalid argument", K(subscribe_task));
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    ObSpinLockGuard guard(lock_);
+
+    if (OB_FAIL(pending_tasks_.push_back(subscribe_task))) {
+      LOG_ERROR("push back subscribe task fail", KR(ret), K(subscribe_task));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    cond_.signal();
+  }
+
+  return ret;
+}
+
+void ObLogFetchLogSubscriber::configure(const ObLogConfig &config)
+{
+  bool enable_fetch_log_subscribe = config.enable_fetch_log_subscribe;
+  int64_t fetch_log_subscribe_wait_time_msec = config.fetch_log_subscribe_wait_time_msec;
+  int64_t fetch_log_subscribe_credit_mb = config.fetch_log_subscribe_credit_mb;
+
+  ATOMIC_STORE(&g_enable_subscribe, enable_fetch_log_subscribe);
+  LOG_INFO("[CONFIG]", K(enable_fetch_log_subscribe));
+  ATOMIC_STORE(&g_wait_time, fetch_log_subscribe_wait_time_msec * _MSEC_);
+  LOG_INFO("[CONFIG]", K(fetch_log_subscribe_wait_time_msec));
+  ATOMIC_STORE(&g_credit, fetch_log_subscribe_credit_mb * _M_);
+  LOG_INFO("[CONFIG]", K(fetch_log_subscribe_credit_mb));
+}
+
+void *ObLogFetchLogSubscriber::thread_func_(void *args)
+{
+  ObLogFetchLogSubscriber *self = static_cast<ObLogFetchLogSubscriber *>(args);
+
+  if (NULL != self) {
+    self->run();
+  }
+
+  return NULL;
+}
+
+void ObLogFetchLogSubscriber::run()
+{
+  int ret = OB_SUCCESS;
+
+  LOG_INFO("fetch log subscriber thread start");
+
+  while (OB_SUCCESS == ret && ! stop_flag_) {
+    if (OB_FAIL(handle_done_requests_())) {
+      LOG_ERROR("handle_done_requests_ fail", KR(ret));
+    } else if (OB_FAIL(launch_requests_())) {
+      LOG_ERROR("launch_requests_ fail", KR(ret));
+    } else {
+      cond_.timedwait(COND_WAIT_TIME);
+    }
+
+    if (REACH_TIME_INTERVAL(STAT_INTERVAL)) {
+      _LOG_INFO("[STAT] [FETCH_LOG_SUBSCRIBER] FLYING_RPC=%ld PENDING_TASK=%ld",
+          flying_requests_.count(), pending_tasks_.count());
+    }
+  }
+
+  if (OB_SUCCESS != ret && OB_IN_STOP_STATE != ret && NULL != err_handler_) {
+    err_handler_->handle_error(ret, "fetch log subscriber thread exits, err=%d", ret);
+  }
+
+  LOG_INFO("fetch log subscriber thread exits", KR(ret), K_(stop_flag));
+}
+
+void ObLogFetchLogSubscriber::handle_rpc_response_(RpcRequest &request)
+{
+  {
+    ObSpinLockGuard guard(lock_);
+    request.next_ = done_requests_;
+    done_requests_ = &request;
+  }
+  // Note: the request can not be accessed after that
+  cond_.signal();
+}
+
+int ObLogFetchLogSubscriber::handle_done_requests_()
+{
+  int ret = OB_SUCCESS;
+  RpcRequest *request = NULL;
+
+  {
+    ObSpinLockGuard guard(lock_);
+    request = done_requests_;
+    done_requests_ = NULL;
+  }
+
+  while (NULL != request) {
+    RpcRequest *next = request->next_;
+
+    remove_flying_request_(request);
+
+    if (OB_SUCC(ret) && OB_FAIL(handle_request_(*request))) {
+      LOG_ERROR("handle subscribe request fail", KR(ret), KPC(request));
+    }
+
+    free_request_(request);
+    request = next;
+  }
+
+  return ret;
+}
+
+int ObLogFetchLogSubscriber::handle_request_(RpcRequest &request)
+{
+  int ret = OB_SUCCESS;
+  SubscribeTaskArray &tasks = request.tasks_;
+  const ObCdcLSSubscribeLogResp::SubscribeResultArray &results = request.results_;
+
+  if (OB_SUCCESS != request.rcode_) {
+    LOG_WARN("subscribe log rpc fail, hibernate streams", "rcode", request.rcode_,
+        "svr", request.get_first_task().svr_, "task_count", tasks.count());
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < tasks.count(); idx++) {
+      if (OB_FAIL(hibernate_(tasks.at(idx)))) {
+        LOG_ERROR("hibernate stream fail", KR(ret), K(tasks.at(idx)));
+      }
+    }
+  } else {
+    const int64_t cur_time = get_timestamp();
+    SubscribeTaskArray remain_tasks;
+    // The results are returned in the same order as the request
+    int64_t res_idx = 0;
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < tasks.count(); idx++) {
+      SubscribeTask &task = tasks.at(idx);
+
+      if (res_idx < results.count() && results.at(res_idx).ls_id_ == task.ls_id_) {
+        // New logs or LS error, fetch log stream handles it
+        ret = dispatch_(task, "SubscribeWakeUp");
+        res_idx++;
+      } else if (cur_time >= task.expire_tstamp_) {
+        ret = dispatch_(task, "SubscribeExpire");
+      } else {
+        ret = remain_tasks.push_back(task);
+      }
+    }
+
+    if (OB_SUCC(ret) && remain_tasks.count() > 0) {
+      ObSpinLockGuard guard(lock_);
+
+      if (OB_FAIL(append(pending_tasks_, remain_tasks))) {
+        LOG_ERROR("append pending tasks fail", KR(ret), "count", remain_tasks.count());
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFetchLogSubscriber::launch_requests_()
+{
+  int ret = OB_SUCCESS;
+  SubscribeTaskArray tasks;
+
+  {
+    ObSpinLockGuard guard(lock_);
+
+    if (pending_tasks_.count() > 0) {
+      if (OB_FAIL(tasks.assign(pending_tasks_))) {
+        LOG_ERROR("assign pending tasks fail", KR(ret), "count", pending_tasks_.count());
+      } else {
+        pending_tasks_.reuse();
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && tasks.count() > 0) {
+    if (OB_FAIL(build_requests_(tasks))) {
+      LOG_ERROR("build subscribe requests fail", KR(ret), "count", tasks.count());
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFetchLogSubscriber::build_requests_(SubscribeTaskArray &tasks)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cur_time = get_timestamp();
+  SubscribeTaskArray remain_tasks;
+  ObSEArray<RpcRequest *, 16> requests;
+
+  for (int64_t idx = 0; OB_SUCC(ret) && idx < tasks.count(); idx++) {
+    SubscribeTask &task = tasks.at(idx);
+    RpcRequest *request = NULL;
+
+    if (cur_time >= task.expire_tstamp_) {
+      ret = dispatch_(task, "SubscribeExpire");
+    } else if (get_svr_flying_count_(task) >= MAX_FLYING_RPC_PER_SVR) {
+      // wait for the flying RPC of the server
+      ret = remain_tasks.push_back(task);
+    } else {
+      for (int64_t req_idx = 0; NULL == request && req_idx < requests.count(); req_idx++) {
+        if (requests.at(req_idx)->get_first_task().is_same_svr(task)
+            && requests.at(req_idx)->tasks_.count() < ObCdcLSSubscribeLogReq::ITEM_CNT_LMT) {
+          request = requests.at(req_idx);
+        }
+      }
+
+      if (NULL != request) {
+        // Hold the request no longer than the earliest expire time
+        request->req_.set_wait_time(std::min(request->req_.get_wait_time(),
+            task.expire_tstamp_ - cur_time));
+      } else if (OB_ISNULL(request = alloc_request_())) {
+        LOG_ERROR("allocate subscribe request fail");
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else if (OB_FAIL(requests.push_back(request))) {
+        LOG_ERROR("push back request fail", KR(ret));
+        free_request_(request);
+        request = NULL;
+      } else {
+        request->req_.set_wait_time(task.expire_tstamp_ - cur_time);
+        request->req_.set_credit(ATOMIC_LOAD(&g_credit));
+        request->req_.set_client_pid(static_cast<uint64_t>(getpid()));
+      }
+
+      if (OB_SUCC(ret)) {
+        ObCdcLSSubscribeLogReq::SubscribeParam param;
+        param.reset(task.ls_id_, task.start_lsn_);
+
+        if (OB_FAIL(request->req_.append_param(param))) {
+          LOG_ERROR("append subscribe param fail", KR(ret), K(param));
+        } else if (OB_FAIL(request->tasks_.push_back(task))) {
+          LOG_ERROR("push back subscribe task fail", KR(ret), K(task));
+        }
+      }
+    }
+  }
+
+  for (int64_t req_idx = 0; req_idx < requests.count(); req_idx++) {
+    RpcRequest *request = requests.at(req_idx);
+
+    if (OB_SUCC(ret)) {
+      ret = send_request_(*request);
+    } else {
+      free_request_(request);
+    }
+  }
+
+  if (OB_SUCC(ret) && remain_tasks.count() > 0) {
+    ObSpinLockGuard guard(lock_);
+
+    if (OB_FAIL(append(pending_tasks_, remain_tasks))) {
+      LOG_ERROR("append pending tasks fail", KR(ret), "count", remain_tasks.count());
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFetchLogSubscriber::send_request_(RpcRequest &request)
+{
+  int ret = OB_SUCCESS;
+  const SubscribeTask &first_task = request.get_first_task();
+  const int64_t rpc_timeout = request.req_.get_wait_time() + SVR_RESERVED_TIME;
+  int send_ret = OB_SUCCESS;
+
+  if (OB_FAIL(flying_requests_.push_back(&request))) {
+    LOG_ERROR("push back flying request fail", KR(ret));
+    request.rcode_ = ret;
+    handle_rpc_response_(request);
+  } else if (OB_SUCCESS != (send_ret = rpc_->async_subscribe_log(first_task.tenant_id_,
+      first_task.svr_, request.req_, request.cb_, rpc_timeout))) {
+    // The callback is not invoked if the RPC fails to send, handle it as a failed RPC
+    LOG_WARN("send subscribe log rpc fail", K(send_ret), K(first_task), K(rpc_timeout));
+    request.rcode_ = send_ret;
+    handle_rpc_response_(request);
+  } else {
+    LOG_DEBUG("send subscribe log rpc succ", "svr", first_task.svr_, K(rpc_timeout),
+        "task_count", request.tasks_.count());
+  }
+
+  return ret;
+}
+
+int64_t ObLogFetchLogSubscriber::get_svr_flying_count_(const SubscribeTask &task) const
+{
+  int64_t count = 0;
+
+  for (int64_t idx = 0; idx < flying_requests_.count(); idx++) {
+    if (flying_requests_.at(idx)->get_first_task().is_same_svr(task)) {
+      count++;
+    }
+  }
+
+  return count;
+}
+
+int ObLogFetchLogSubscriber::dispatch_(SubscribeTask &task, const char *from_mod)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(task.stream_) || OB_ISNULL(stream_worker_)) {
+    LOG_ERROR("invalid subscribe task", K(task), K(stream_worker_));
+    ret = OB_ERR_UNEXPECTED;
+  } else if (OB_FAIL(stream_worker_->dispatch_stream_task(*task.stream_, from_mod))) {
+    LOG_ERROR("dispatch stream task fail", KR(ret), K(task), K(from_mod));
+  } else {
+    // Note: The FetchStream can not be accessed after that
+    task.stream_ = NULL;
+  }
+
+  return ret;
+}
+
+int ObLogFetchLogSubscriber::hibernate_(SubscribeTask &task)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(task.stream_) || OB_ISNULL(stream_worker_)) {
+    LOG_ERROR("invalid subscribe task", K(task), K(stream_worker_));
+    ret = OB_ERR_UNEXPECTED;
+  } else if (OB_FAIL(stream_worker_->hibernate_stream_task(*task.stream_, "SubscribeFail"))) {
+    LOG_ERROR("hibernate stream task fail", KR(ret), K(task));
+  } else {
+    // Note: The FetchStream can not be accessed after that
+    task.stream_ = NULL;
+  }
+
+  return ret;
+}
+
+ObLogFetchLogSubscriber::RpcRequest *ObLogFetchLogSubscriber::alloc_request_()
+{
+  RpcRequest *request = NULL;
+  void *buf = ob_malloc(sizeof(RpcRequest), "CDCSubscribeReq");
+
+  if (NULL != buf) {
+    request = new(buf) RpcRequest(*this);
+  }
+
+  return request;
+}
+
+void ObLogFetchLogSubscriber::free_request_(RpcRequest *request)
+{
+  if (OB_NOT_NULL(request)) {
+    request->~RpcRequest();
+    ob_free(request);
+    request = NULL;
+  }
+}
+
+void ObLogFetchLogSubscriber::remove_flying_request_(RpcRequest *request)
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+
+  for (int64_t idx = 0; ! found && idx < flying_requests_.count(); idx++) {
+    if (request == flying_requests_.at(idx)) {
+      found = true;
+      if (OB_FAIL(flying_requests_.remove(idx))) {
+        LOG_ERROR("remove flying request fail", KR(ret), K(idx));
+      }
+    }
+  }
+}
+
+///////////////////////////// RpcRequest /////////////////////////////
+
+ObLogFetchLogSubscriber::RpcRequest::RpcRequest(ObLogFetchLogSubscriber &host) :
+    host_(host),
+    cb_(*this),
+    req_(),
+    tasks_(),
+    rcode_(OB_SUCCESS),
+    results_(),
+    next_(NULL)
+{}
+
+///////////////////////////// RpcCB /////////////////////////////
+
+rpc::frame::ObReqTransport::AsyncCB *ObLogFetchLogSubscriber::RpcCB::clone(
+    const rpc::frame::SPAlloc &alloc) const
+{
+  void *buf = NULL;
+  RpcCB *cb = NULL;
+
+  if (OB_ISNULL(buf = alloc(sizeof(RpcCB)))) {
+    LOG_ERROR("clone rpc callback fail", K(buf), K(sizeof(RpcCB)));
+  } else if (OB_ISNULL(cb = new(buf) RpcCB(host_))) {
+    LOG_ERROR("construct RpcCB fail", K(buf));
+  } else {
+    // success
+  }
+
+  return cb;
+}
+
+int ObLogFetchLogSubscriber::RpcCB::process()
+{
+  ObCdcLSSubscribeLogResp &result = RpcCBBase::result_;
+  ObRpcResultCode &rcode = RpcCBBase::rcode_;
+
+  do_process_(rcode.rcode_, &result);
+  // Note: Active destructe response after asynchronous RPC processing
+  result.reset();
+
+  return OB_SUCCESS;
+}
+
+void ObLogFetchLogSubscriber::RpcCB::on_timeout()
+{
+  LOG_WARN("subscribe log rpc timeout", "svr", RpcCBBase::dst_, K_(host));
+  do_process_(OB_TIMEOUT, NULL);
+}
+
+void ObLogFetchLogSubscriber::RpcCB::on_invalid()
+{
+  LOG_WARN("subscribe log rpc response packet is invalid", "svr", RpcCBBase::dst_, K_(host));
+  do_process_(OB_RPC_PACKET_INVALID, NULL);
+}
+
+void ObLogFetchLogSubscriber::RpcCB::do_process_(const int rcode,
+    const ObCdcLSSubscribeLogResp *resp)
+{
+  RpcRequest &request = host_;
+  int ret = rcode;
+
+  if (OB_SUCCESS != ret) {
+    // rpc fail
+  } else if (OB_ISNULL(resp)) {
+    ret = OB_INVALID_ERROR;
+  } else if (OB_SUCCESS != (ret = resp->get_err())) {
+    // server fail
+  } else if (OB_FAIL(request.results_.assign(resp->get_results()))) {
+    LOG_ERROR("assign subscribe results fail", KR(ret), KPC(resp));
+  }
+
+  request.rcode_ = ret;
+  // Note: The request can not be accessed after that
+  request.host_.handle_rpc_response_(request);
+}
+
+}
+}
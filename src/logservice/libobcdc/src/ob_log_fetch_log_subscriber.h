@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Fetch Log Subscriber
+ */
+
+#ifndef OCEANBASE_LIBOBCDC_OB_LOG_FETCH_LOG_SUBSCRIBER_H__
+#define OCEANBASE_LIBOBCDC_OB_LOG_FETCH_LOG_SUBSCRIBER_H__
+
+#include "lib/lock/ob_spin_lock.h"              // ObSpinLock
+#include "lib/net/ob_addr.h"                    // ObAddr
+#include "common/ob_queue_thread.h"             // ObCond
+#include "rpc/frame/ob_req_transport.h"         // ObReqTranslator::AsyncCB
+#include "rpc/obrpc/ob_rpc_result_code.h"       // ObRpcResultCode
+#include "logservice/cdcservice/ob_cdc_rpc_proxy.h"  // ObCdcProxy
+#include "ob_log_utils.h"                       // _SEC_
+
+namespace oceanbase
+{
+namespace libobcdc
+{
+class FetchStream;
+class IObLSWorker;
+class IObLogRpc;
+class IObLogErrHandler;
+class ObLogConfig;
+
+// FetchStream is hibernated when there is no log on server. Instead of waking it up by timer,
+// the subscriber holds the FetchStream of all LS fetching logs on the same server, and sends one
+// subscribe RPC for them. The server puts the RPC into the retry queue of tenant instead of
+// holding a worker, and responds once some of them have new logs. The FetchStream of these LS
+// are dispatched to stream worker immediately.
+//
+// Notes:
+// 1. A FetchStream is subscribed for at most g_wait_time, it is dispatched after that even if
+//    there is no new log, the same as being woken up by timer, so that the progress of idle LS
+//    is updated in time.
+// 3. The FetchStream subscribed when the RPC of the server is flying are sent by a new RPC,
+//    at most MAX_FLYING_RPC_PER_SVR RPC are flying for a server.
+// 2. The FetchStream is hibernated by timer if the subscribe RPC fails, e.g. the server does not
+//    support it.
+class IObLogFetchLogSubscriber
+{
+public:
+  virtual ~IObLogFetchLogSubscriber() {}
+
+public:
+  // Subscribe logs of ls_id after start_lsn on svr
+  // Note: The FetchStream can not be accessed after subscribe succeed
+  virtual int subscribe(FetchStream &task,
+      const uint64_t tenant_id,
+      const share::ObLSID &ls_id,
+      const common::ObAddr &svr,
+      const palf::LSN &start_lsn) = 0;
+};
+
+class ObLogFetchLogSubscriber : public IObLogFetchLogSubscriber
+{
+private:
+  static const int64_t STAT_INTERVAL = 30 * _SEC_;
+  static const int64_t COND_WAIT_TIME = 10 * _MSEC_;
+  // The time reserved by server to send response, see ObCdcFetcher::RPC_QIT_RESERVED_TIME
+  static const int64_t SVR_RESERVED_TIME = 6 * _SEC_;
+  // The tasks arrived after the RPC was sent are subscribed by a new RPC instead of waiting
+  // for the flying one, as long as the server has less than MAX_FLYING_RPC_PER_SVR RPC
+  static const int64_t MAX_FLYING_RPC_PER_SVR = 4;
+
+public:
+  static bool g_enable_subscribe;
+  static int64_t g_wait_time;
+  static int64_t g_credit;
+
+public:
+  ObLogFetchLogSubscriber();
+  virtual ~ObLogFetchLogSubscriber();
+
+public:
+  int init(IObLogRpc &rpc,
+      IObLSWorker &stream_worker,
+      IObLogErrHandler &err_handler);
+  void destroy();
+
+  int start();
+  void stop();
+  void mark_stop_flag();
+
+public:
+  int subscribe(FetchStream &task,
+      const uint64_t tenant_id,
+      const share::ObLSID &ls_id,
+      const common::ObAddr &svr,
+      const palf::LSN &start_lsn);
+
+public:
+  static bool is_enabled() { return ATOMIC_LOAD(&g_enable_subscribe); }
+  static void configure(const ObLogConfig &config);
+
+public:
+  void run();
+
+private:
+  static void *thread_func_(void *args);
+
+  struct SubscribeTask
+  {
+    FetchStream     *stream_;
+    uint64_t        tenant_id_;
+    share::ObLSID   ls_id_;
+    common::ObAddr  svr_;
+    palf::LSN       start_lsn_;
+    int64_t         expire_tstamp_;
+
+    bool is_same_svr(const SubscribeTask &other) const
+    {
+      return tenant_id_ == other.tenant_id_ && svr_ == other.svr_;
+    }
+    TO_STRING_KV(KP_(stream), K_(tenant_id), K_(ls_id), K_(svr), K_(start_lsn), K_(expire_tstamp));
+  };
+  typedef common::ObSEArray<SubscribeTask, 16> SubscribeTaskArray;
+
+  struct RpcRequest;
+  typedef obrpc::ObCdcProxy::AsyncCB<obrpc::OB_LS_SUBSCRIBE_LOG> RpcCBBase;
+  class RpcCB : public RpcCBBase
+  {
+  public:
+    explicit RpcCB(RpcRequest &host) : host_(host) {}
+    virtual ~RpcCB() {}
+
+  public:
+    rpc::frame::ObReqTransport::AsyncCB *clone(const rpc::frame::SPAlloc &alloc) const;
+    int process();
+    void on_timeout();
+    void on_invalid();
+    typedef typename obrpc::ObCdcProxy::ObRpc<obrpc::OB_LS_SUBSCRIBE_LOG> ProxyRpc;
+    void set_args(const typename ProxyRpc::Request &args) { UNUSED(args); }
+
+    TO_STRING_KV("host", reinterpret_cast<void *>(&host_));
+
+  private:
+    void do_process_(const int rcode, const obrpc::ObCdcLSSubscribeLogResp *resp);
+
+  private:
+    RpcRequest &host_;
+
+  private:
+    DISALLOW_COPY_AND_ASSIGN(RpcCB);
+  };
+
+  // One subscribe RPC of the LS on the same server
+  struct RpcRequest
+  {
+    ObLogFetchLogSubscriber   &host_;
+    RpcCB                     cb_;
+    obrpc::ObCdcLSSubscribeLogReq req_;
+    SubscribeTaskArray        tasks_;     // in the same order as req_
+    // set by RPC callback
+    int                       rcode_;
+    obrpc::ObCdcLSSubscribeLogResp::SubscribeResultArray results_;
+    RpcRequest                *next_;
+
+    explicit RpcRequest(ObLogFetchLogSubscriber &host);
+    const SubscribeTask &get_first_task() const { return tasks_.at(0); }
+    TO_STRING_KV(K_(rcode), "task_count", tasks_.count(), "result_count", results_.count());
+  };
+
+private:
+  void handle_rpc_response_(RpcRequest &request);
+  int handle_done_requests_();
+  int handle_request_(RpcRequest &request);
+  int launch_requests_();
+  int build_requests_(SubscribeTaskArray &tasks);
+  int send_request_(RpcRequest &request);
+  int64_t get_svr_flying_count_(const SubscribeTask &task) const;
+  int dispatch_(SubscribeTask &task, const char *from_mod);
+  int hibernate_(SubscribeTask &task);
+  RpcRequest *alloc_request_();
+  void free_request_(RpcRequest *request);
+  void remove_flying_request_(RpcRequest *request);
+
+private:
+  bool                      inited_;
+  pthread_t                 tid_;
+  IObLogRpc                 *rpc_;
+  IObLSWorker               *stream_worker_;
+  IObLogErrHandler          *err_handler_;
+  common::ObCond            cond_;
+
+  // written by stream worker threads and RPC callback, protected by lock_
+  common::ObSpinLock        lock_;
+  SubscribeTaskArray        pending_tasks_;
+  RpcRequest                *done_requests_;
+
+  // only accessed by subscriber thread
+  common::ObSEArray<RpcRequest *, 16> flying_requests_;
+
+  volatile bool stop_flag_ CACHE_ALIGNED;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObLogFetchLogSubscriber);
+};
+
+}
+}
+
+#endif
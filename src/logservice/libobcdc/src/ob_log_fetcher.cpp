@@ -153,6 +153,7 @@ int ObLogFetcher::init(
             cfg.timer_task_count_upper_limit,
             idle_pool_,
             dead_pool_,
+            rpc_,
             *err_handler))) {
       LOG_ERROR("init stream worker fail", KR(ret));
     } else if (OB_FAIL(fs_container_mgr_.init(
@@ -454,6 +455,7 @@ void ObLogFetcher::configure(const ObLogConfig &cfg)
   ObLogFixedTimer::configure(cfg);
   ObLogRpc::configure(cfg);
   ObLSWorker::configure(cfg);
+  ObLogFetchLogSubscriber::configure(cfg);
   ObLogLSFetchMgr::configure(cfg);
   FetchLogARpc::configure(cfg);
 
@@ -79,6 +79,8 @@ int ObLogFormatter::RowValue::init(const int64_t column_num, const bool contain_
   return OB_SUCCESS;
 }
 
+int64_t ObLogFormatter::g_stmt_chunk_size = ObLogConfig::default_formatter_stmt_chunk_size;
+
 ObLogFormatter::ObLogFormatter() : inited_(false),
                                    working_mode_(WorkingMode::UNKNOWN_MODE),
                                    obj2str_helper_(NULL),
@@ -224,14 +226,22 @@ int ObLogFormatter::push(IStmtTask *stmt_task, volatile bool &stop_flag)
     LOG_ERROR("invalid arguments", K(stmt_task));
     ret = OB_INVALID_ARGUMENT;
   } else {
-    // Ensure that all stmt of ObLogEntryTask are pushed to the same queue
-    const uint64_t hash_value = ATOMIC_FAA(&round_value_, 1);
+    // Stmts of ObLogEntryTask are pushed to the same queue in chunks of stmt_chunk_size, so that
+    // the stmts of a large ObLogEntryTask are formatted by multiple threads.
+    // The order of rows is kept by ObLogEntryTask::link_row_list, which is called by the thread
+    // formatting the last stmt and links the rows in the order of stmt list.
+    const int64_t stmt_chunk_size = ATOMIC_LOAD(&g_stmt_chunk_size);
+    uint64_t hash_value = ATOMIC_FAA(&round_value_, 1);
     int64_t stmt_count = 0;
 
     while (OB_SUCC(ret) && NULL != stmt_task) {
       IStmtTask *next = stmt_task->get_next();
       void *push_task = static_cast<void *>(stmt_task);
 
+      if (stmt_chunk_size > 0 && stmt_count > 0 && 0 == (stmt_count % stmt_chunk_size)) {
+        hash_value = ATOMIC_FAA(&round_value_, 1);
+      }
+
       RETRY_FUNC(stop_flag, *(static_cast<ObMQThread *>(this)), push, push_task, hash_value, DATA_OP_TIMEOUT);
 
       if (OB_SUCC(ret)) {
@@ -252,6 +262,14 @@ int ObLogFormatter::push(IStmtTask *stmt_task, volatile bool &stop_flag)
   return ret;
 }
 
+void ObLogFormatter::configure(const ObLogConfig &config)
+{
+  int64_t formatter_stmt_chunk_size = config.formatter_stmt_chunk_size;
+
+  ATOMIC_STORE(&g_stmt_chunk_size, formatter_stmt_chunk_size);
+  LOG_INFO("[CONFIG]", K(formatter_stmt_chunk_size));
+}
+
 int ObLogFormatter::push_single_task(IStmtTask *stmt_task, volatile bool &stop_flag)
 {
   int ret = OB_SUCCESS;
@@ -802,7 +820,7 @@ int ObLogFormatter::build_row_value_(
       else if (OB_FAIL(fill_normal_cols_(rv, *old_cols, *new_lob_ctx_cols, simple_table_schema, *tb_schema_info, false))) {
         LOG_ERROR("fill normal old columns fail", KR(ret), K(rv), KPC(old_cols));
       } else if (OB_FAIL(fill_rowkey_cols_(rv, *rowkey_cols, simple_table_schema,
-              *tb_schema_info))) {
+              *tb_schema_info, stmt_task->get_redo_log_entry_task().get_allocator()))) {
         LOG_ERROR("fill_rowkey_cols_ fail", KR(ret), K(rv), KPC(rowkey_cols),
             "stmt_task", *stmt_task, K(simple_table_schema));
       } else if (OB_FAIL(fill_orig_default_value_(rv, simple_table_schema, *tb_schema_info,
@@ -979,7 +997,8 @@ int ObLogFormatter::fill_normal_cols_(
 int ObLogFormatter::fill_rowkey_cols_(RowValue *rv,
     ColValueList &rowkey_cols,
     const TableSchemaType *simple_table_schema,
-    const TableSchemaInfo &tb_schema_info)
+    const TableSchemaInfo &tb_schema_info,
+    common::ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
 
@@ -1016,6 +1035,10 @@ int ObLogFormatter::fill_rowkey_cols_(RowValue *rv,
         ret = OB_ERR_UNEXPECTED;
         LOG_ERROR("rowkey_column is expected output to user", KR(ret),
             K(tb_schema_info), K(rowkey_index), K(column_schema_info), KPC(simple_table_schema));
+      } else if ((NULL == rv->new_columns_[rowkey_index]
+            || (rv->contain_old_column_ && NULL == rv->old_columns_[rowkey_index]))
+          && OB_FAIL(convert_rowkey_col_str_(*cv_node, *simple_table_schema, *column_schema_info, allocator))) {
+        LOG_ERROR("convert_rowkey_col_str_ fail", KR(ret), K(table_id), K(rowkey_index), KPC(cv_node));
       } else {
         // If the primary key column has been modified, the value after the modification is used, otherwise the value before the modification is used
         if (NULL == rv->new_columns_[rowkey_index]) {
@@ -1035,6 +1058,41 @@ int ObLogFormatter::fill_rowkey_cols_(RowValue *rv,
   return ret;
 }
 
+int ObLogFormatter::convert_rowkey_col_str_(ColValue &cv,
+    const TableSchemaType &simple_table_schema,
+    const ColumnSchemaInfo &column_schema_info,
+    common::ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(obj2str_helper_)) {
+    LOG_ERROR("obj2str_helper_ is null", K(obj2str_helper_));
+    ret = OB_ERR_UNEXPECTED;
+  } else if (cv.is_str_converted_) {
+    // converted by previous round of callback
+  } else {
+    common::ObArrayHelper<common::ObString> extended_type_info;
+    column_schema_info.get_extended_type_info(extended_type_info);
+
+    if (OB_FAIL(obj2str_helper_->obj2str(simple_table_schema.get_tenant_id(),
+        simple_table_schema.get_table_id(),
+        cv.column_id_,
+        cv.value_,
+        cv.string_value_,
+        allocator,
+        false/*string_deep_copy*/,
+        extended_type_info,
+        column_schema_info.get_accuracy(),
+        column_schema_info.get_collation_type()))) {
+      LOG_ERROR("obj2str fail", KR(ret), K(cv), K(column_schema_info));
+    } else {
+      cv.is_str_converted_ = 1;
+    }
+  }
+
+  return ret;
+}
+
 int ObLogFormatter::fill_orig_default_value_(RowValue *rv,
     const TableSchemaType *simple_table_schema,
     const TableSchemaInfo &tb_schema_info,
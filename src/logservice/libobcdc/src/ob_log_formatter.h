@@ -38,6 +38,8 @@ class ObString;
 
 namespace libobcdc
 {
+class ObLogConfig;
+
 /////////////////////////////////////////////////////////////////////////////////////////
 // IObLogFormatter
 
@@ -61,6 +63,7 @@ public:
   virtual int push(IStmtTask *task, volatile bool &stop_flag) = 0;
   virtual int push_single_task(IStmtTask *task, volatile bool &stop_flag) = 0;
   virtual int get_task_count(int64_t &br_count, int64_t &log_entry_task_count) = 0;
+  virtual void configure(const ObLogConfig &config) = 0;
 };
 
 
@@ -80,6 +83,8 @@ typedef common::ObMQThread<IObLogFormatter::MAX_FORMATTER_NUM, IObLogFormatter>
 
 class ObLogFormatter : public IObLogFormatter, public FormatterThread
 {
+  static int64_t g_stmt_chunk_size;
+
 public:
   ObLogFormatter();
   virtual ~ObLogFormatter();
@@ -93,6 +98,7 @@ public:
   int get_task_count(int64_t &br_count,
       int64_t &log_entry_task_count);
   int handle(void *data, const int64_t thread_index, volatile bool &stop_flag);
+  void configure(const ObLogConfig &config);
 
 public:
   int init(const int64_t thread_num,
@@ -178,7 +184,12 @@ private:
   int fill_rowkey_cols_(RowValue *rv,
       ColValueList &rowkey_cols,
       const TableSchemaType *simple_table_schema,
-      const TableSchemaInfo &tb_schema_info);
+      const TableSchemaInfo &tb_schema_info,
+      common::ObIAllocator &allocator);
+  int convert_rowkey_col_str_(ColValue &cv,
+      const TableSchemaType &simple_table_schema,
+      const ColumnSchemaInfo &column_schema_info,
+      common::ObIAllocator &allocator);
   int build_binlog_record_(
       ObLogBR *br,
       RowValue *rv,
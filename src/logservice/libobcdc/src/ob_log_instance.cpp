@@ -159,6 +159,8 @@ ObLogInstance::ObLogInstance() :
     hbase_util_(),
     obj2str_helper_(),
     br_queue_(),
+    batch_builder_(),
+    pending_batch_record_(NULL),
     trans_task_pool_(),
     log_entry_task_pool_(NULL),
     store_service_(NULL),
@@ -1107,6 +1109,12 @@ void ObLogInstance::destroy()
 {
   stop();
 
+  if (NULL != pending_batch_record_) {
+    release_record(pending_batch_record_);
+    pending_batch_record_ = NULL;
+  }
+  release_batch_records_();
+
   inited_ = false;
 
   oblog_major_ = 0;
@@ -1666,6 +1674,94 @@ void ObLogInstance::release_record(IBinlogRecord *record)
   }
 }
 
+int ObLogInstance::next_batch(ArrowSchema *schema,
+    ArrowArray *array,
+    IBinlogRecord **record,
+    const int64_t max_row_count,
+    const int64_t timeout_us)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("instance has not been initialized");
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(schema) || OB_ISNULL(array) || OB_ISNULL(record) || OB_UNLIKELY(max_row_count <= 0)) {
+    LOG_ERROR("invalid argument", K(schema), K(array), K(record), K(max_row_count));
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    const int64_t end_tstamp = get_timestamp() + timeout_us;
+    // the records in batch_builder_ are left by the last call which failed to build the batch
+    bool is_batch_end = (batch_builder_.get_row_count() >= max_row_count);
+    *record = NULL;
+    schema->release = NULL;
+    array->release = NULL;
+
+    while (OB_SUCC(ret) && ! is_batch_end) {
+      IBinlogRecord *br = pending_batch_record_;
+      pending_batch_record_ = NULL;
+
+      if (NULL == br) {
+        const int64_t left_time = end_tstamp - get_timestamp();
+        int fetch_ret = OB_SUCCESS;
+
+        if (left_time <= 0) {
+          fetch_ret = OB_TIMEOUT;
+        } else if (OB_SUCCESS != (fetch_ret = next_record(&br, left_time))) {
+          if (OB_TIMEOUT != fetch_ret && OB_IN_STOP_STATE != fetch_ret) {
+            LOG_ERROR("next_record fail", K(fetch_ret));
+          }
+        }
+
+        if (OB_SUCCESS == fetch_ret) {
+        } else if (batch_builder_.get_row_count() > 0) {
+          // return the records in batch, the error is returned by the next call
+          is_batch_end = true;
+        } else {
+          ret = fetch_ret;
+        }
+      }
+
+      if (OB_FAIL(ret) || is_batch_end) {
+      } else if (batch_builder_.can_append(*br)) {
+        if (OB_FAIL(batch_builder_.append(*br))) {
+          LOG_ERROR("append record to column batch fail", KR(ret), "row_count", batch_builder_.get_row_count());
+          // retried by the next call
+          pending_batch_record_ = br;
+        } else {
+          is_batch_end = (batch_builder_.get_row_count() >= max_row_count);
+        }
+      } else if (batch_builder_.get_row_count() > 0) {
+        // returned by the next call
+        pending_batch_record_ = br;
+        is_batch_end = true;
+      } else {
+        *record = br;
+        is_batch_end = true;
+      }
+    }
+
+    if (OB_SUCC(ret) && batch_builder_.get_row_count() > 0) {
+      if (OB_FAIL(batch_builder_.build(*schema, *array))) {
+        // the records are kept in batch_builder_, and built again by the next call
+        LOG_ERROR("build column batch fail", KR(ret), "row_count", batch_builder_.get_row_count());
+      } else {
+        // values are copied into the batch
+        release_batch_records_();
+      }
+    }
+  }
+
+  return ret;
+}
+
+void ObLogInstance::release_batch_records_()
+{
+  for (int64_t idx = 0; idx < batch_builder_.get_row_count(); idx++) {
+    release_record(batch_builder_.get_record(idx));
+  }
+  batch_builder_.reset();
+}
+
 void ObLogInstance::handle_error(const int err_no, const char *fmt, ...)
 {
   static const int64_t MAX_ERR_MSG_LEN = 1024;
@@ -2016,6 +2112,11 @@ void ObLogInstance::reload_config_()
       sequencer_->configure(config);
     }
 
+    // config formatter
+    if (OB_NOT_NULL(formatter_)) {
+      formatter_->configure(config);
+    }
+
     // config committer_
     if (OB_NOT_NULL(committer_)) {
       committer_->configure(config);
@@ -32,6 +32,7 @@
 #include "ob_log_work_mode.h"                             // WorkingMode
 #include "ob_cdc_lob_aux_meta_storager.h"                 // ObCDCLobAuxMetaStorager
 #include "ob_cdc_global_info.h"                           // ObCDCGlobalInfo
+#include "ob_cdc_column_batch.h"                          // ObCDCColumnBatchBuilder
 
 namespace oceanbase
 {
@@ -136,6 +137,11 @@ public:
   virtual int launch();
   virtual void stop();
   virtual int get_tenant_ids(std::vector<uint64_t> &tenant_ids);
+  virtual int next_batch(ArrowSchema *schema,
+      ArrowArray *array,
+      IBinlogRecord **record,
+      const int64_t max_row_count,
+      const int64_t timeout_us);
 
 public:
   void mark_stop_flag();
@@ -195,6 +201,8 @@ private:
   int init_components_(const uint64_t start_tstamp_ns);
   int config_tenant_mgr_(const int64_t start_tstamp_ns, const int64_t sys_schema_version);
   void destroy_components_();
+  // release the records in batch_builder_, and reset it
+  void release_batch_records_();
   void write_pid_file_();
   static void *timer_thread_func_(void *args);
   static void *sql_thread_func_(void *args);
@@ -314,6 +322,10 @@ public:
   ObLogHbaseUtil            hbase_util_;
   ObObj2strHelper           obj2str_helper_;
   BRQueue                   br_queue_;
+  // used by next_batch, the record not in the last batch is kept in pending_batch_record_,
+  // the records of the batch failed to build are kept in batch_builder_
+  ObCDCColumnBatchBuilder   batch_builder_;
+  IBinlogRecord             *pending_batch_record_;
   PartTransTaskPool         trans_task_pool_;
   IObLogEntryTaskPool       *log_entry_task_pool_;
   IObStoreService           *store_service_;
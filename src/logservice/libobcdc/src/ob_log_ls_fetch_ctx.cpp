@@ -75,6 +75,7 @@ void LSFetchCtx::reset()
   FetchTaskListNode::reset();
   mem_storage_.destroy();
   group_iterator_.destroy();
+  log_compressor_.destroy();
   fetched_log_size_ = 0;
   ctx_desc_.reset();
 }
@@ -255,8 +256,8 @@ int LSFetchCtx::read_log(
     volatile bool &stop_flag)
 {
   int ret = OB_SUCCESS;
-  const char *buf = log_entry.get_data_buf();
-  const int64_t buf_len = log_entry.get_data_len();
+  const char *buf = NULL;
+  int64_t buf_len = 0;
   const int64_t submit_ts = log_entry.get_log_ts();
   int64_t pos = 0;
   logservice::ObLogBaseHeader log_base_header;
@@ -264,6 +265,8 @@ int LSFetchCtx::read_log(
   if (OB_ISNULL(part_trans_resolver_)) {
     ret = OB_INVALID_ERROR;
     LOG_ERROR("invalid part trans resolver", KR(ret), K_(part_trans_resolver));
+  } else if (OB_FAIL(log_compressor_.get_data(log_entry, buf, buf_len))) {
+    LOG_ERROR("get data of log_entry failed", KR(ret), K(log_entry), K(lsn), K_(tls_id));
   } else if (OB_ISNULL(buf) || OB_UNLIKELY(0 >= buf_len)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_ERROR("invalid log_entry buf or buf_len", KR(ret), K(log_entry), K(lsn), K_(tls_id));
@@ -316,8 +319,8 @@ int LSFetchCtx::read_miss_tx_log(
     IObCDCPartTransResolver::MissingLogInfo &missing)
 {
   int ret = OB_SUCCESS;
-  const char *buf = log_entry.get_data_buf();
-  const int64_t buf_len = log_entry.get_data_len();
+  const char *buf = NULL;
+  int64_t buf_len = 0;
   const int64_t submit_ts = log_entry.get_log_ts();
   int64_t pos = 0;
   logservice::ObLogBaseHeader log_base_header;
@@ -325,6 +328,8 @@ int LSFetchCtx::read_miss_tx_log(
   if (OB_ISNULL(part_trans_resolver_)) {
     ret = OB_INVALID_ERROR;
     LOG_ERROR("invalid part trans resolver", KR(ret), K(part_trans_resolver_));
+  } else if (OB_FAIL(log_compressor_.get_data(log_entry, buf, buf_len))) {
+    LOG_ERROR("get data of log_entry failed", KR(ret), K(log_entry), K(lsn), K_(tls_id));
   } else if (OB_ISNULL(buf) || OB_UNLIKELY(0 >= buf_len)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_ERROR("invalid log_entry buf or buf_len", KR(ret), K(log_entry), K(lsn), K_(tls_id));
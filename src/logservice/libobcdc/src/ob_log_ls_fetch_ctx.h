@@ -21,6 +21,7 @@
 #include "logservice/logrouteservice/ob_log_route_service.h" // ObLogRouteService
 #include "logservice/palf/log_iterator_storage.h"
 #include "logservice/palf/palf_iterator.h"
+#include "logservice/palf/log_compressor.h"     // LogCompressor
 #include "logservice/ob_log_base_header.h"
 #include "ob_log_utils.h"                     // _SEC_
 #include "ob_log_start_lsn_locator.h"         // StartLSNLocateReq
@@ -473,6 +474,8 @@ private:
 
   palf::MemoryStorage     mem_storage_;
   palf::MemPalfGroupBufferIterator group_iterator_;
+  // used to decompress the payload of palf::LogEntry
+  palf::LogCompressor     log_compressor_;
 
   /////////// Stat ////////////
   int64_t                 fetched_log_size_;
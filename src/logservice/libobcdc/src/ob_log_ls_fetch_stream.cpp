@@ -494,6 +494,26 @@ int FetchStream::hibernate_()
   return ret;
 }
 
+int FetchStream::subscribe_()
+{
+  int ret = OB_SUCCESS;
+
+  if (! ObLogFetchLogSubscriber::is_enabled()) {
+    ret = hibernate_();
+  } else if (OB_ISNULL(stream_worker_) || OB_ISNULL(ls_fetch_ctx_)) {
+    LOG_ERROR("invalid stream worker or ls_fetch_ctx", K(stream_worker_), K(ls_fetch_ctx_));
+    ret = OB_INVALID_ERROR;
+  } else if (OB_FAIL(stream_worker_->subscribe_stream_task(*this, ls_fetch_ctx_->get_tls_id(),
+      svr_, ls_fetch_ctx_->get_next_lsn(), "FetchStream"))) {
+    LOG_ERROR("subscribe_stream_task fail", KR(ret));
+  } else {
+    // Note: You can't continue to manipulate the structure after that, there are concurrency issues!!!
+    handle_when_leave_("Subscribe");
+  }
+
+  return ret;
+}
+
 int FetchStream::prepare_rpc_request_()
 {
   int ret = OB_SUCCESS;
@@ -746,8 +766,8 @@ int FetchStream::handle_fetch_log_task_(volatile bool &stop_flag)
         // Hibernate the task if it needs to be hibernated
         // Note: No more data structures can be accessed afterwards, there is a concurrency scenario !!!!
         } else if (need_hibernate) {
-          if (OB_FAIL(hibernate_())) {
-            LOG_ERROR("hibernate fail", KR(ret));
+          if (OB_FAIL(subscribe_())) {
+            LOG_ERROR("subscribe fail", KR(ret));
           }
         } else {
           // No hibernation required, then recursive processing of IDLE tasks
@@ -163,6 +163,8 @@ private:
       KickOutReason dispatch_reason);
   int check_need_fetch_log_(const int64_t limit, bool &need_fetch_log);
   int hibernate_();
+  // Hibernate until there are new logs on server, fallback to hibernate_() if subscription is disabled
+  int subscribe_();
   int async_fetch_log_(
       const palf::LSN &req_start_lsn,
       bool &rpc_send_succeed);
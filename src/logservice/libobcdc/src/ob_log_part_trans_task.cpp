@@ -571,6 +571,7 @@ int MutatorRow::add_column_(
         accuracy,
         collation_type))) {
       LOG_ERROR("obj2str fail", KR(ret), "obj", *value, K(obj2str_helper), K(accuracy), K(collation_type), K(column_id), K(column_schema_info));
+    } else if (FALSE_IT(cv_node->is_str_converted_ = (NULL != obj2str_helper))) {
     } else if (OB_FAIL(cols.add(cv_node))) {
       LOG_ERROR("add column into ColValueList fail", KR(ret), "column_value", *cv_node, K(cols));
     }
@@ -674,6 +675,9 @@ int MutatorRow::parse_rowkey_(
         }
       }
 
+      // The rowkey columns are contained in the new/old columns in most cases, their string value
+      // is only used when missing in the new/old columns, so that they are converted lazily by
+      // formatter, see ObLogFormatter::fill_rowkey_cols_
       if (OB_SUCC(ret) && ! ignore_column) {
         if (OB_FAIL(add_column_(
             column_id,
@@ -681,7 +685,7 @@ int MutatorRow::parse_rowkey_(
             false/*is_out_row*/,
             simple_table_schema,
             column_schema_info,
-            obj2str_helper,
+            NULL/*obj2str_helper*/,
             rowkey_cols))) {
           LOG_ERROR("add_column_ fail", K(rowkey_cols), KR(ret), K(column_id),
               K(index), K(rowkey_objs[index]), K(obj2str_helper), K(simple_table_schema), K(column_schema_info));
@@ -1657,7 +1661,8 @@ ObLogEntryTask::ObLogEntryTask() :
     stmt_list_(),
     formatted_stmt_num_(0),
     row_ref_cnt_(0),
-    arena_allocator_("LogEntryTask", OB_MALLOC_MIDDLE_BLOCK_SIZE)
+    arena_allocator_("LogEntryTask", OB_MALLOC_MIDDLE_BLOCK_SIZE),
+    safe_allocator_(arena_allocator_)
 {
 }
 
@@ -1678,7 +1683,7 @@ void ObLogEntryTask::reset()
   formatted_stmt_num_ = 0;
   row_ref_cnt_ = 0;
 
-  arena_allocator_.clear();
+  safe_allocator_.clear();
 }
 
 bool ObLogEntryTask::is_valid() const
@@ -1800,7 +1805,7 @@ void *ObLogEntryTask::alloc(const int64_t size)
   void *alloc_ret = NULL;
 
   if (size > 0) {
-    alloc_ret = arena_allocator_.alloc(size);
+    alloc_ret = safe_allocator_.alloc(size);
   }
 
   return alloc_ret;
@@ -1809,7 +1814,7 @@ void *ObLogEntryTask::alloc(const int64_t size)
 // NOTE: For ObArenaAllocator: virtual void free(void *ptr) do nothing
 void ObLogEntryTask::free(void *ptr)
 {
-  arena_allocator_.free(ptr);
+  safe_allocator_.free(ptr);
   ptr = NULL;
 }
 
@@ -19,6 +19,7 @@
 #include "lib/atomic/ob_atomic.h"                   // ATOMIC_LOAD
 #include "lib/lock/ob_small_spin_lock.h"            // ObByteLock
 #include "common/object/ob_object.h"                // ObObj
+#include "lib/allocator/page_arena.h"                // ObArenaAllocator, ObSafeArenaAllocator
 #include "common/ob_queue_thread.h"                 // ObCond
 #include "ob_cdc_tablet_to_table_info.h"            // ObCDCTabletChangeInfo
 #include "storage/tx/ob_trans_define.h"             // ObTransID, ObLSLogInfoArray
@@ -153,6 +154,7 @@ struct ColValue
   ObString      string_value_;    // The value after converting Obj to a string
   ColValue      *next_;
   uint8_t       is_out_row_ : 1;  // Column data is stored out row
+  uint8_t       is_str_converted_ : 1;  // string_value_ is converted, rowkey columns of DML are converted lazily
 
   void reset()
   {
@@ -161,6 +163,7 @@ struct ColValue
     string_value_.reset();
     next_ = NULL;
     is_out_row_ = 0;
+    is_str_converted_ = 0;
   }
 
   bool is_valid()
@@ -175,7 +178,8 @@ struct ColValue
       K_(value),
       K_(column_id),
       K_(string_value),
-      K_(is_out_row));
+      K_(is_out_row),
+      K_(is_str_converted));
 };
 
 ///////////////////////////////////////////////////////////////////////////////////
@@ -641,7 +645,7 @@ public:
 
   int get_valid_row_num(int64_t &valid_row_num);
 
-  common::ObIAllocator &get_allocator() { return arena_allocator_; }
+  common::ObIAllocator &get_allocator() { return safe_allocator_; }
   void *alloc(const int64_t size);
   void free(void *ptr);
 
@@ -701,6 +705,9 @@ private:
   // Non-thread safe allocator
   // used for Parser/Formatter
   common::ObArenaAllocator arena_allocator_;          // allocator
+  // Stmts of one LogEntryTask may be formatted by multiple formatter threads, all allocation
+  // go through safe_allocator_
+  common::ObSafeArenaAllocator safe_allocator_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLogEntryTask);
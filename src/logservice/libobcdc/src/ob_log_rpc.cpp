@@ -119,6 +119,18 @@ int ObLogRpc::async_stream_fetch_missing_log(const uint64_t tenant_id,
   return ret;
 }
 
+int ObLogRpc::async_subscribe_log(const uint64_t tenant_id,
+    const common::ObAddr &svr,
+    const obrpc::ObCdcLSSubscribeLogReq &req,
+    obrpc::ObCdcProxy::AsyncCB<obrpc::OB_LS_SUBSCRIBE_LOG> &cb,
+    const int64_t timeout)
+{
+  int ret = OB_SUCCESS;
+  SEND_RPC(async_subscribe_log, tenant_id, svr, timeout, req, &cb);
+  LOG_DEBUG("rpc: async subscribe log", KR(ret), K(svr), K(timeout), K(req));
+  return ret;
+}
+
 int ObLogRpc::init(const int64_t io_thread_num)
 {
   int ret = OB_SUCCESS;
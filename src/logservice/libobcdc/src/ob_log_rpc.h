@@ -57,6 +57,14 @@ public:
       const obrpc::ObCdcLSFetchMissLogReq &req,
       obrpc::ObCdcProxy::AsyncCB<obrpc::OB_LS_FETCH_MISSING_LOG> &cb,
       const int64_t timeout) = 0;
+
+  // Subscribe logs of a batch of log streams, the server responds when some of them have new logs
+  // Asynchronous RPC
+  virtual int async_subscribe_log(const uint64_t tenant_id,
+      const common::ObAddr &svr,
+      const obrpc::ObCdcLSSubscribeLogReq &req,
+      obrpc::ObCdcProxy::AsyncCB<obrpc::OB_LS_SUBSCRIBE_LOG> &cb,
+      const int64_t timeout) = 0;
 };
 
 //////////////////////////////////////////// ObLogRpc //////////////////////////////////////
@@ -95,6 +103,12 @@ public:
       obrpc::ObCdcProxy::AsyncCB<obrpc::OB_LS_FETCH_MISSING_LOG> &cb,
       const int64_t timeout);
 
+  int async_subscribe_log(const uint64_t tenant_id,
+      const common::ObAddr &svr,
+      const obrpc::ObCdcLSSubscribeLogReq &req,
+      obrpc::ObCdcProxy::AsyncCB<obrpc::OB_LS_SUBSCRIBE_LOG> &cb,
+      const int64_t timeout);
+
 public:
   int init(const int64_t io_thread_num);
   void destroy();
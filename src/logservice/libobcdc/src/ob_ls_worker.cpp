@@ -43,6 +43,7 @@ ObLSWorker::ObLSWorker() :
     dead_pool_(NULL),
     err_handler_(NULL),
     timer_(),
+    subscriber_(),
     stream_task_seq_(0)
 {}
 
@@ -55,6 +56,7 @@ int ObLSWorker::init(const int64_t worker_thread_num,
     const int64_t max_timer_task_count,
     IObLogFetcherIdlePool &idle_pool,
     IObLogFetcherDeadPool &dead_pool,
+    IObLogRpc &rpc,
     IObLogErrHandler &err_handler)
 {
   int ret = OB_SUCCESS;
@@ -68,6 +70,8 @@ int ObLSWorker::init(const int64_t worker_thread_num,
     ret = OB_INVALID_ARGUMENT;
   } else if (OB_FAIL(timer_.init(err_handler, max_timer_task_count))) {
     LOG_ERROR("init timer fail", KR(ret), K(max_timer_task_count));
+  } else if (OB_FAIL(subscriber_.init(rpc, *this, err_handler))) {
+    LOG_ERROR("init fetch log subscriber fail", KR(ret));
   }
   // Initializing the thread pool
   else if (OB_FAIL(StreamWorkerThread::init(worker_thread_num,
@@ -99,6 +103,7 @@ void ObLSWorker::destroy()
   fetcher_resume_time_ = OB_INVALID_TIMESTAMP;
   StreamWorkerThread::destroy();
 
+  subscriber_.destroy();
   timer_.destroy();
 
   idle_pool_ = NULL;
@@ -117,6 +122,8 @@ int ObLSWorker::start()
     ret = OB_NOT_INIT;
   } else if (OB_FAIL(timer_.start())) {
     LOG_ERROR("start timer thread fail", KR(ret));
+  } else if (OB_FAIL(subscriber_.start())) {
+    LOG_ERROR("start fetch log subscriber fail", KR(ret));
   } else if (OB_FAIL(StreamWorkerThread::start())) {
     LOG_ERROR("start stream worker fail", KR(ret));
   } else {
@@ -129,6 +136,7 @@ void ObLSWorker::stop()
 {
   if (OB_LIKELY(inited_)) {
     StreamWorkerThread::stop();
+    subscriber_.stop();
     LOG_INFO("stop stream worker succ");
   }
 }
@@ -136,6 +144,7 @@ void ObLSWorker::stop()
 void ObLSWorker::mark_stop_flag()
 {
   timer_.mark_stop_flag();
+  subscriber_.mark_stop_flag();
   StreamWorkerThread::mark_stop_flag();
 }
 
@@ -294,6 +303,35 @@ int ObLSWorker::hibernate_stream_task(FetchStream &task, const char *from_mod)
   return ret;
 }
 
+int ObLSWorker::subscribe_stream_task(FetchStream &task,
+    const TenantLSID &tls_id,
+    const common::ObAddr &svr,
+    const palf::LSN &start_lsn,
+    const char *from_mod)
+{
+  int ret = OB_SUCCESS;
+  bool print_stream_dispatch_info = ATOMIC_LOAD(&g_print_stream_dispatch_info);
+
+  if (print_stream_dispatch_info) {
+    LOG_INFO("[STAT] [STREAM_WORKER] [SUBSCRIBE_STREAM_TASK]",
+        "task", &task, K(from_mod), K(tls_id), K(svr), K(start_lsn), K(task));
+  } else {
+    LOG_DEBUG("[STAT] [STREAM_WORKER] [SUBSCRIBE_STREAM_TASK]",
+        "task", &task, K(from_mod), K(tls_id), K(svr), K(start_lsn), K(task));
+  }
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("not init", K(inited_));
+    ret = OB_NOT_INIT;
+  } else if (OB_FAIL(subscriber_.subscribe(task, tls_id.get_tenant_id(), tls_id.get_ls_id(),
+      svr, start_lsn))) {
+    LOG_ERROR("subscribe stream task fail", KR(ret), K(tls_id), K(svr), K(start_lsn));
+  } else {
+    // success
+  }
+  return ret;
+}
+
 // hendle function for thread pool
 int ObLSWorker::handle(void *data,
     const int64_t thread_index,
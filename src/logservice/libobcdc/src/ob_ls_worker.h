@@ -23,6 +23,7 @@
 #include "ob_map_queue_thread.h"                // ObMapQueueThread
 #include "ob_log_timer.h"                       // ObLogFixedTimer
 #include "ob_log_ls_fetch_stream.h"             // FetchStream
+#include "ob_log_fetch_log_subscriber.h"        // ObLogFetchLogSubscriber
 
 namespace oceanbase
 {
@@ -53,6 +54,13 @@ public:
 
   // Hibernate fetch log stream task
   virtual int hibernate_stream_task(FetchStream &task, const char *from_mod) = 0;
+
+  // Hibernate fetch log stream task until there are new logs after start_lsn on svr
+  virtual int subscribe_stream_task(FetchStream &task,
+      const TenantLSID &tls_id,
+      const common::ObAddr &svr,
+      const palf::LSN &start_lsn,
+      const char *from_mod) = 0;
 };
 
 //////////////////////////////////////////// ObLSWorker ////////////////////////////////////////////
@@ -61,6 +69,7 @@ class IObLogFetcherIdlePool;
 class IObLogFetcherDeadPool;
 class IObLogSvrFinder;
 class IObLogErrHandler;
+class IObLogRpc;
 
 typedef common::ObMapQueueThread<IObLSWorker::MAX_THREAD_NUM> StreamWorkerThread;
 
@@ -83,6 +92,7 @@ public:
       const int64_t max_timer_task_count,
       IObLogFetcherIdlePool &idle_pool,
       IObLogFetcherDeadPool &dead_pool,
+      IObLogRpc &rpc,
       IObLogErrHandler &err_handler);
   void destroy();
 
@@ -97,6 +107,11 @@ public:
   int dispatch_fetch_task(LSFetchCtx &task, const char *dispatch_reason);
   int dispatch_stream_task(FetchStream &task, const char *from_mod);
   int hibernate_stream_task(FetchStream &task, const char *from_mod);
+  int subscribe_stream_task(FetchStream &task,
+      const TenantLSID &tls_id,
+      const common::ObAddr &svr,
+      const palf::LSN &start_lsn,
+      const char *from_mod);
 
 public:
   // Overloading thread handling functions
@@ -128,6 +143,7 @@ private:
 
   // private module
   ObLogFixedTimer               timer_;                   // timer
+  ObLogFetchLogSubscriber       subscriber_;              // subscriber of idle stream
 
   /// Fetch log stream task processing serial number for rotating the assignment of fetch log stream tasks
   int64_t                       stream_task_seq_ CACHE_ALIGNED;
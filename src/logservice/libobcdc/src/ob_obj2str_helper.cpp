@@ -24,6 +24,7 @@
 #include "sql/engine/expr/ob_expr_operator.h"
 #include "sql/engine/expr/ob_expr_res_type_map.h"
 
+#include "lib/utility/ob_fast_convert.h"            // ObFastFormatInt
 #include "ob_log_utils.h"                           // _M_
 
 using namespace oceanbase::common;
@@ -156,6 +157,10 @@ int ObObj2strHelper::obj2str(const uint64_t tenant_id,
       OBLOG_LOG(ERROR, "convert_char_obj_to_padding_obj_ fail", KR(ret), K(obj), K(accuracy), K(collation_type),
           K(str), K(compat_mode), "compat_mode_str", print_compat_mode(compat_mode));
     }
+  } else if (can_convert_int_obj_directly_(obj, collation_type)) {
+    if (OB_FAIL(convert_int_obj_to_str_(obj, str, allocator))) {
+      OBLOG_LOG(ERROR, "convert_int_obj_to_str_ fail", KR(ret), K(table_id), K(column_id), K(obj));
+    }
   } else if (obj.is_string_type()) {
     if (string_deep_copy) {
       // need deep-copy
@@ -341,6 +346,37 @@ int ObObj2strHelper::convert_timestamp_with_timezone_data_util_succ_(const commo
 }
 
 // bit type output decimal string
+bool ObObj2strHelper::can_convert_int_obj_directly_(const common::ObObj &obj,
+    const common::ObCollationType &collation_type) const
+{
+  const common::ObObjTypeClass obj_tc = obj.get_type_class();
+  // hbase T column is converted based on the result of cast, see convert_hbase_bit_obj_to_positive_bit_str_
+  return (common::ObIntTC == obj_tc || common::ObUIntTC == obj_tc)
+      && ! enable_hbase_mode_
+      && ObCharset::is_valid_collation(collation_type)
+      && ! ObCharset::is_cs_nonascii(collation_type);
+}
+
+int ObObj2strHelper::convert_int_obj_to_str_(const common::ObObj &obj,
+    common::ObString &str,
+    common::ObIAllocator &allocator) const
+{
+  int ret = OB_SUCCESS;
+  const bool is_unsigned = (common::ObUIntTC == obj.get_type_class());
+  common::ObFastFormatInt ffi(obj.get_int(), is_unsigned);
+  char *ptr = NULL;
+
+  if (OB_ISNULL(ptr = static_cast<char *>(allocator.alloc(ffi.length())))) {
+    OBLOG_LOG(ERROR, "allocate memory fail", "size", ffi.length());
+    ret = common::OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    MEMCPY(ptr, ffi.ptr(), ffi.length());
+    str.assign_ptr(ptr, static_cast<ObString::obstr_size_t>(ffi.length()));
+  }
+
+  return ret;
+}
+
 int ObObj2strHelper::convert_bit_obj_to_decimal_str_(const common::ObObj &obj,
     const common::ObObj &str_obj,
     common::ObString &str,
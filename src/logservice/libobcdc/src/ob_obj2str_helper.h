@@ -98,6 +98,14 @@ private:
       common::ObString &str,
       common::ObIAllocator &allocator) const;
 
+  // Integer is formatted directly, which is the same as casting it to varchar by ObObjCaster,
+  // without getting timezone of tenant and the generic cast
+  bool can_convert_int_obj_directly_(const common::ObObj &obj,
+      const common::ObCollationType &collation_type) const;
+  int convert_int_obj_to_str_(const common::ObObj &obj,
+      common::ObString &str,
+      common::ObIAllocator &allocator) const;
+
   // max length of int64_t
   static const int64_t MAX_TIMESTAMP_UTC_LONG_STR_LENGTH = 30;
   int convert_mysql_timestamp_to_utc_(const common::ObObj &obj,
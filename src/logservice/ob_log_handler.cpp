@@ -26,6 +26,9 @@
 #include "logservice/palf/palf_env.h"
 #include "logservice/palf/log_group_entry.h"
 #include "logservice/palf/palf_options.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "share/config/ob_server_config.h"
+#include "share/ob_cluster_version.h"
 #include "storage/tx/ob_ts_mgr.h"
 
 namespace oceanbase
@@ -33,6 +36,25 @@ namespace oceanbase
 namespace logservice
 {
 using namespace palf;
+
+// the compressor used to compress log entries before they are submitted to palf.
+//
+// NB: the servers of lower version can not recognize the COMPRESSED flag of
+// LogEntryHeader, so log entries are not compressed until all servers have been
+// upgraded to current version.
+static common::ObCompressorType get_clog_compressor_type()
+{
+  common::ObCompressorType compressor_type = common::NONE_COMPRESSOR;
+  if (!GCONF.clog_transport_compress_all) {
+  } else if (GET_MIN_CLUSTER_VERSION() < CLUSTER_CURRENT_VERSION) {
+    // compression is disabled during upgrade
+  } else if (OB_SUCCESS != common::ObCompressorPool::get_instance().get_compressor_type(
+          GCONF.clog_transport_compress_func, compressor_type)) {
+    compressor_type = common::NONE_COMPRESSOR;
+  }
+  return compressor_type;
+}
+
 ObLogHandler::ObLogHandler() : self_(),
                                apply_status_(NULL),
                                apply_service_(NULL),
@@ -191,6 +213,7 @@ int ObLogHandler::append(const void *buffer,
   PalfAppendOptions opts;
   opts.need_nonblock = need_nonblock;
   opts.need_check_proposal_id = true;
+  opts.compressor_type = get_clog_compressor_type();
   const int64_t begin_ts = common::ObTimeUtility::current_time();
   while (true) {
     // generate opts
@@ -568,6 +568,17 @@ int ObLogService::iterate_replay(const ObFunction<int(const ObReplayStatus&)> &f
   return ret;
 }
 
+int ObLogService::iterate_replay_lag(const ObFunction<int(const LSReplayLagStat&)> &func)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else {
+    ret = replay_service_.stat_lag_for_each(func);
+  }
+  return ret;
+}
+
 int ObLogService::create_ls_(const share::ObLSID &id,
                              const common::ObReplicaType &replica_type,
                              const share::ObTenantRole &tenant_role,
@@ -181,6 +181,7 @@ public:
   int iterate_palf(const ObFunction<int(const palf::PalfHandle&)> &func);
   int iterate_apply(const ObFunction<int(const ObApplyStatus&)> &func);
   int iterate_replay(const ObFunction<int(const ObReplayStatus&)> &func);
+  int iterate_replay_lag(const ObFunction<int(const LSReplayLagStat&)> &func);
 
   palf::PalfEnv *get_palf_env() { return palf_env_; }
   // TODO by yunlong: temp solution, will by removed after Reporter be added in MTL
@@ -71,6 +71,177 @@ void FetchLogTask::reset()
   start_lsn_.reset();
   log_size_ = 0;
   accepted_mode_pid_ = INVALID_PROPOSAL_ID;
+  stream_seq_ = 0;
+}
+
+void FetchLogStreamChunk::reset()
+{
+  server_.reset();
+  seq_ = 0;
+  proposal_id_ = INVALID_PROPOSAL_ID;
+  prev_lsn_.reset();
+  start_lsn_.reset();
+  log_size_ = 0;
+  log_count_ = 0;
+  accepted_mode_pid_ = INVALID_PROPOSAL_ID;
+}
+
+FetchLogStream::FetchLogStream()
+  : lock_(),
+    seq_(0)
+{
+  reset();
+}
+
+void FetchLogStream::reset()
+{
+  ObSpinLockGuard guard(lock_);
+  server_.reset();
+  // NB: seq_ is not reset to make sure the chunks of the previous streams are dropped.
+  proposal_id_ = INVALID_PROPOSAL_ID;
+  accepted_mode_pid_ = INVALID_PROPOSAL_ID;
+  prev_chunk_end_lsn_.reset();
+  next_prev_lsn_.reset();
+  next_start_lsn_.reset();
+  next_chunk_size_ = 0;
+  wait_ack_lsn_.reset();
+  acked_end_lsn_.reset();
+  is_waiting_ack_ = false;
+  last_active_ts_ns_ = OB_INVALID_TIMESTAMP;
+}
+
+int64_t FetchLogStream::open(const common::ObAddr &server,
+                             const int64_t proposal_id,
+                             const int64_t accepted_mode_pid)
+{
+  int64_t seq = 0;
+  const int64_t curr_ts_ns = ObTimeUtility::current_time_ns();
+  ObSpinLockGuard guard(lock_);
+  if (server_.is_valid() && server_ != server
+      && curr_ts_ns - last_active_ts_ns_ < PALF_FETCH_LOG_INTERVAL_NS) {
+    // another follower is fetching log streamingly
+  } else {
+    server_ = server;
+    seq = ++seq_;
+    proposal_id_ = proposal_id;
+    accepted_mode_pid_ = accepted_mode_pid;
+    prev_chunk_end_lsn_.reset();
+    next_prev_lsn_.reset();
+    next_start_lsn_.reset();
+    next_chunk_size_ = 0;
+    wait_ack_lsn_.reset();
+    acked_end_lsn_.reset();
+    is_waiting_ack_ = false;
+    last_active_ts_ns_ = curr_ts_ns;
+  }
+  return seq;
+}
+
+bool FetchLogStream::is_current(const int64_t seq) const
+{
+  ObSpinLockGuard guard(lock_);
+  return server_.is_valid() && seq == seq_;
+}
+
+int FetchLogStream::on_chunk_sent(const int64_t seq,
+                                  const LSN &last_lsn,
+                                  const LSN &end_lsn,
+                                  const int64_t window_size,
+                                  FetchLogStreamChunk &chunk,
+                                  bool &is_ready)
+{
+  int ret = OB_SUCCESS;
+  is_ready = false;
+  if (0 >= seq || !last_lsn.is_valid() || !end_lsn.is_valid() || 0 >= window_size) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(seq), K(last_lsn), K(end_lsn), K(window_size));
+  } else {
+    ObSpinLockGuard guard(lock_);
+    if (!server_.is_valid() || seq != seq_) {
+      ret = OB_STATE_NOT_MATCH;
+    } else {
+      const int64_t chunk_size = MAX(window_size / 2, 1);
+      // The next chunk [end_lsn, end_lsn + chunk_size) can be sent only after the follower
+      // has acked the chunk before the last one, and the unacked logs do not exceed the window.
+      LSN wait_ack_lsn = prev_chunk_end_lsn_;
+      const int64_t window_start = static_cast<int64_t>(end_lsn.val_) + chunk_size - window_size;
+      if (window_start > 0 && (!wait_ack_lsn.is_valid() || LSN(window_start) > wait_ack_lsn)) {
+        wait_ack_lsn = LSN(window_start);
+      }
+      prev_chunk_end_lsn_ = end_lsn;
+      next_prev_lsn_ = last_lsn;
+      next_start_lsn_ = end_lsn;
+      next_chunk_size_ = chunk_size;
+      if (!wait_ack_lsn.is_valid()
+          || (acked_end_lsn_.is_valid() && acked_end_lsn_ >= wait_ack_lsn)) {
+        is_waiting_ack_ = false;
+        wait_ack_lsn_.reset();
+        gen_next_chunk_(chunk);
+        is_ready = true;
+      } else {
+        is_waiting_ack_ = true;
+        wait_ack_lsn_ = wait_ack_lsn;
+      }
+    }
+  }
+  return ret;
+}
+
+bool FetchLogStream::on_ack(const common::ObAddr &server,
+                            const LSN &end_lsn,
+                            FetchLogStreamChunk &chunk)
+{
+  bool is_ready = false;
+  ObSpinLockGuard guard(lock_);
+  if (!server_.is_valid() || server_ != server) {
+  } else {
+    if (!acked_end_lsn_.is_valid() || end_lsn > acked_end_lsn_) {
+      acked_end_lsn_ = end_lsn;
+    }
+    last_active_ts_ns_ = ObTimeUtility::current_time_ns();
+    if (is_waiting_ack_ && acked_end_lsn_ >= wait_ack_lsn_) {
+      is_waiting_ack_ = false;
+      wait_ack_lsn_.reset();
+      gen_next_chunk_(chunk);
+      is_ready = true;
+    }
+  }
+  return is_ready;
+}
+
+void FetchLogStream::close(const int64_t seq)
+{
+  ObSpinLockGuard guard(lock_);
+  if (seq == seq_ && server_.is_valid()) {
+    PALF_LOG(INFO, "close fetch log stream", K(seq), K_(server), K_(acked_end_lsn), K_(prev_chunk_end_lsn));
+    server_.reset();
+    is_waiting_ack_ = false;
+    wait_ack_lsn_.reset();
+  }
+}
+
+int64_t FetchLogStream::get_outstanding_size() const
+{
+  int64_t outstanding_size = 0;
+  ObSpinLockGuard guard(lock_);
+  if (server_.is_valid() && prev_chunk_end_lsn_.is_valid() && acked_end_lsn_.is_valid()
+      && prev_chunk_end_lsn_ > acked_end_lsn_) {
+    outstanding_size = static_cast<int64_t>(prev_chunk_end_lsn_ - acked_end_lsn_);
+  }
+  return outstanding_size;
+}
+
+void FetchLogStream::gen_next_chunk_(FetchLogStreamChunk &chunk) const
+{
+  chunk.server_ = server_;
+  chunk.seq_ = seq_;
+  chunk.proposal_id_ = proposal_id_;
+  chunk.prev_lsn_ = next_prev_lsn_;
+  chunk.start_lsn_ = next_start_lsn_;
+  chunk.log_size_ = next_chunk_size_;
+  // at most two chunks are in flight, see FetchLogStream
+  chunk.log_count_ = PALF_SLIDING_WINDOW_SIZE / 2;
+  chunk.accepted_mode_pid_ = accepted_mode_pid_;
 }
 
 FetchLogEngine::FetchLogEngine()
@@ -220,7 +391,8 @@ void FetchLogEngine::handle(void *task)
                                                                   fetch_log_task->get_start_lsn(),
                                                                   fetch_log_task->get_log_size(),
                                                                   fetch_log_task->get_log_count(),
-                                                                  fetch_log_task->get_accepted_mode_meta()))) {
+                                                                  fetch_log_task->get_accepted_mode_meta(),
+                                                                  fetch_log_task->get_stream_seq()))) {
         PALF_LOG(WARN, "fetch_log_from_storage failed", K(ret), K(palf_id), KPC(fetch_log_task));
       } else {
         // do nothing
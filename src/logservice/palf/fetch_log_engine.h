@@ -13,6 +13,7 @@
 #ifndef OCEANBASE_LOGSERVICE_OB_FETCH_LOG_ENGINE_
 #define OCEANBASE_LOGSERVICE_OB_FETCH_LOG_ENGINE_
 #include <stdint.h>
+#include "lib/lock/ob_spin_lock.h"
 #include "lib/thread/ob_simple_thread_pool.h"
 #include "lib/thread/thread_mgr_interface.h"
 #include "log_define.h"
@@ -55,9 +56,13 @@ public:
   int64_t get_log_size() const { return log_size_; }
   int64_t get_log_count() const { return log_count_; }
   int64_t get_accepted_mode_meta() const { return accepted_mode_pid_; }
+  // 0 means the task is not a part of FetchLogStream
+  void set_stream_seq(const int64_t stream_seq) { stream_seq_ = stream_seq; }
+  int64_t get_stream_seq() const { return stream_seq_; }
 
   TO_STRING_KV(K_(timestamp_ns), K_(id), K_(server), K_(fetch_type), K_(proposal_id),
-               K_(prev_lsn), K_(start_lsn), K_(log_size), K_(log_count), K_(accepted_mode_pid));
+               K_(prev_lsn), K_(start_lsn), K_(log_size), K_(log_count), K_(accepted_mode_pid),
+               K_(stream_seq));
 private:
   DISALLOW_COPY_AND_ASSIGN(FetchLogTask);
 private:
@@ -71,6 +76,94 @@ private:
   int64_t log_size_;
   int64_t log_count_;
   int64_t accepted_mode_pid_;
+  int64_t stream_seq_;
+};
+
+struct FetchLogStreamChunk
+{
+  FetchLogStreamChunk() { reset(); }
+  ~FetchLogStreamChunk() { reset(); }
+  void reset();
+  TO_STRING_KV(K_(server), K_(seq), K_(proposal_id), K_(prev_lsn), K_(start_lsn),
+               K_(log_size), K_(log_count), K_(accepted_mode_pid));
+  common::ObAddr server_;
+  int64_t seq_;
+  int64_t proposal_id_;
+  LSN prev_lsn_;
+  LSN start_lsn_;
+  int64_t log_size_;
+  int64_t log_count_;
+  int64_t accepted_mode_pid_;
+};
+
+// FetchLogStream is the state of streaming fetch which leader maintains for a lagging
+// follower.
+//
+// The follower sends the next fetch request only after all logs fetched in this round
+// have slid out, so the catch-up speed is limited by RTT on high latency links. With
+// streaming fetch, leader keeps pushing the following logs in chunks after handling a
+// fetch request, instead of waiting for the next request. The flow is controlled by the
+// acks of follower: the size of logs which have been sent but not acked is no more than
+// window_size, and at most two chunks are in flight, so the sliding window of follower
+// will not be exceeded.
+//
+// Each palf replica maintains only one stream at a time, the requests of other followers
+// are handled as before. The stream is reset when the follower sends a new fetch request,
+// and the chunks of old stream still in queue are dropped. If no ack is received for
+// PALF_FETCH_LOG_INTERVAL_NS, the stream can be taken over by other followers.
+class FetchLogStream
+{
+public:
+  FetchLogStream();
+  ~FetchLogStream() { reset(); }
+  void reset();
+  // @brief open a stream for the fetch request from 'server'
+  // @return the seq of the stream, 0 means there is another active stream.
+  int64_t open(const common::ObAddr &server,
+               const int64_t proposal_id,
+               const int64_t accepted_mode_pid);
+  bool is_current(const int64_t seq) const;
+  // @brief called after a chunk of the stream has been sent.
+  // @param[in] last_lsn, the lsn of the last group entry has been sent.
+  // @param[in] end_lsn, the end lsn of the last group entry has been sent.
+  // @param[out] chunk, the next chunk, it is valid only when is_ready is true.
+  // @param[out] is_ready, false means the window is full, the next chunk will be
+  //             generated when receiving ack from follower.
+  int on_chunk_sent(const int64_t seq,
+                    const LSN &last_lsn,
+                    const LSN &end_lsn,
+                    const int64_t window_size,
+                    FetchLogStreamChunk &chunk,
+                    bool &is_ready);
+  // @brief called when receiving ack from 'server', return true if the next chunk
+  //        is ready to be sent.
+  bool on_ack(const common::ObAddr &server,
+              const LSN &end_lsn,
+              FetchLogStreamChunk &chunk);
+  // @brief close the stream when the follower has caught up with leader.
+  void close(const int64_t seq);
+  // @brief the size of logs have been sent but not acked by follower.
+  int64_t get_outstanding_size() const;
+  TO_STRING_KV(K_(server), K_(seq), K_(proposal_id), K_(prev_chunk_end_lsn), K_(next_prev_lsn),
+               K_(next_start_lsn), K_(next_chunk_size), K_(wait_ack_lsn), K_(acked_end_lsn),
+               K_(is_waiting_ack), K_(last_active_ts_ns));
+private:
+  void gen_next_chunk_(FetchLogStreamChunk &chunk) const;
+private:
+  mutable common::ObSpinLock lock_;
+  common::ObAddr server_;
+  int64_t seq_;
+  int64_t proposal_id_;
+  int64_t accepted_mode_pid_;
+  LSN prev_chunk_end_lsn_;
+  LSN next_prev_lsn_;
+  LSN next_start_lsn_;
+  int64_t next_chunk_size_;
+  LSN wait_ack_lsn_;
+  LSN acked_end_lsn_;
+  bool is_waiting_ack_;
+  int64_t last_active_ts_ns_;
+  DISALLOW_COPY_AND_ASSIGN(FetchLogStream);
 };
 
 class FetchLogEngine : public lib::TGTaskHandler
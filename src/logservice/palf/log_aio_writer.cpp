@@ -0,0 +1,326 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PALF
+#include "log_aio_writer.h"
+#include "lib/ob_errno.h"                 // OB_SUCCESS
+#include "lib/time/ob_time_utility.h"     // ObTimeUtility
+#include "lib/utility/ob_utility.h"       // ob_pwrite
+#include "share/rc/ob_tenant_base.h"      // mtl_malloc
+#include "log_define.h"                   // palf_reach_time_interval
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace palf
+{
+LogAIOWriteCtx::LogAIOWriteCtx()
+{
+  reset();
+}
+
+LogAIOWriteCtx::~LogAIOWriteCtx()
+{
+  reset();
+}
+
+void LogAIOWriteCtx::reset()
+{
+  MEMSET(&iocb_, 0, sizeof(iocb_));
+  writer_ = NULL;
+  fd_ = -1;
+  buf_ = NULL;
+  count_ = 0;
+  offset_ = 0;
+  submit_ts_ = OB_INVALID_TIMESTAMP;
+  slot_ = -1;
+  ret_ = OB_SUCCESS;
+  is_inflight_ = false;
+}
+
+int LogAIOWriteCtx::wait()
+{
+  int ret = OB_SUCCESS;
+  if (true == is_inflight_ && OB_FAIL(writer_->wait(*this))) {
+    PALF_LOG(ERROR, "wait aio write failed", K(ret), KPC(this));
+  } else {
+    ret = ret_;
+  }
+  return ret;
+}
+
+LogAIOWriter::LogAIOWriter()
+  : io_context_(NULL),
+    events_(NULL),
+    inflight_ctxs_(NULL),
+    max_inflight_count_(0),
+    inflight_limit_(0),
+    inflight_count_(0),
+    submit_count_(0),
+    rewrite_count_(0),
+    is_inited_(false)
+{
+}
+
+LogAIOWriter::~LogAIOWriter()
+{
+  destroy();
+}
+
+int LogAIOWriter::init(const int64_t max_inflight_count)
+{
+  int ret = OB_SUCCESS;
+  int sys_ret = 0;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    PALF_LOG(ERROR, "LogAIOWriter has inited", K(ret));
+  } else if (0 >= max_inflight_count || MAX_INFLIGHT_COUNT < max_inflight_count) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(ERROR, "invalid argument", K(ret), K(max_inflight_count));
+  } else if (OB_ISNULL(events_ = static_cast<struct io_event *>(
+      mtl_malloc(max_inflight_count * sizeof(struct io_event), "LogAIOWriter")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(ERROR, "allocate memory failed", K(ret), K(max_inflight_count));
+  } else if (OB_ISNULL(inflight_ctxs_ = static_cast<LogAIOWriteCtx **>(
+      mtl_malloc(max_inflight_count * sizeof(LogAIOWriteCtx *), "LogAIOWriter")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(ERROR, "allocate memory failed", K(ret), K(max_inflight_count));
+  } else if (0 != (sys_ret = ::io_setup(static_cast<int>(max_inflight_count), &io_context_))) {
+    ret = OB_IO_ERROR;
+    io_context_ = NULL;
+    PALF_LOG(WARN, "io_setup failed", K(ret), K(sys_ret), K(max_inflight_count));
+  } else {
+    MEMSET(inflight_ctxs_, 0, max_inflight_count * sizeof(LogAIOWriteCtx *));
+    max_inflight_count_ = max_inflight_count;
+    inflight_limit_ = max_inflight_count;
+    inflight_count_ = 0;
+    submit_count_ = 0;
+    rewrite_count_ = 0;
+    is_inited_ = true;
+    PALF_LOG(INFO, "LogAIOWriter init success", K(ret), KPC(this));
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void LogAIOWriter::destroy()
+{
+  if (IS_INIT) {
+    (void)wait_all();
+  }
+  is_inited_ = false;
+  if (NULL != io_context_) {
+    (void)::io_destroy(io_context_);
+    io_context_ = NULL;
+  }
+  if (NULL != events_) {
+    mtl_free(events_);
+    events_ = NULL;
+  }
+  if (NULL != inflight_ctxs_) {
+    mtl_free(inflight_ctxs_);
+    inflight_ctxs_ = NULL;
+  }
+  max_inflight_count_ = 0;
+  inflight_limit_ = 0;
+  inflight_count_ = 0;
+  submit_count_ = 0;
+  rewrite_count_ = 0;
+}
+
+void LogAIOWriter::set_inflight_limit(const int64_t inflight_limit)
+{
+  inflight_limit_ = MAX(1, MIN(inflight_limit, max_inflight_count_));
+}
+
+int LogAIOWriter::submit(const int fd,
+                         const char *buf,
+                         const int64_t count,
+                         const int64_t offset,
+                         LogAIOWriteCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  int submit_ret = 0;
+  struct iocb *iocbp = &ctx.iocb_;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (0 > fd || OB_ISNULL(buf) || 0 >= count || 0 > offset || true == ctx.is_inflight()) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(ERROR, "invalid argument", K(ret), K(fd), KP(buf), K(count), K(offset), K(ctx));
+  } else if (inflight_count_ >= inflight_limit_
+             && OB_FAIL(reap_with_retry_(inflight_count_ - inflight_limit_ + 1))) {
+    PALF_LOG(ERROR, "reap_with_retry_ failed", K(ret), KPC(this));
+  } else if (IS_NOT_INIT) {
+    // the io context has been destroyed while reaping
+    ret = OB_IO_ERROR;
+  } else {
+    int64_t slot = 0;
+    while (slot < max_inflight_count_ && NULL != inflight_ctxs_[slot]) {
+      slot++;
+    }
+    ::io_prep_pwrite(iocbp, fd, const_cast<char *>(buf), count, offset);
+    iocbp->data = &ctx;
+    ctx.writer_ = this;
+    ctx.fd_ = fd;
+    ctx.buf_ = buf;
+    ctx.count_ = count;
+    ctx.offset_ = offset;
+    ctx.submit_ts_ = ObTimeUtility::fast_current_time();
+    ctx.slot_ = slot;
+    ctx.ret_ = OB_SUCCESS;
+    if (slot >= max_inflight_count_) {
+      ret = OB_ERR_UNEXPECTED;
+      PALF_LOG(ERROR, "no free slot for inflight write", K(ret), K(ctx), KPC(this));
+    } else if (1 != (submit_ret = ::io_submit(io_context_, 1, &iocbp))) {
+      ret = OB_IO_ERROR;
+      PALF_LOG(WARN, "io_submit failed, need write synchronously", K(ret), K(submit_ret), K(ctx));
+    } else {
+      inflight_ctxs_[slot] = &ctx;
+      ctx.is_inflight_ = true;
+      inflight_count_++;
+      submit_count_++;
+      PALF_LOG(TRACE, "io_submit success", K(ret), K(ctx), KPC(this));
+    }
+  }
+  return ret;
+}
+
+int LogAIOWriter::wait(LogAIOWriteCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && true == ctx.is_inflight()) {
+    if (OB_FAIL(reap_with_retry_(1))) {
+      PALF_LOG(ERROR, "reap_with_retry_ failed", K(ret), K(ctx), KPC(this));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ret = ctx.get_ret();
+  }
+  return ret;
+}
+
+int LogAIOWriter::wait_all()
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && 0 < inflight_count_) {
+    if (OB_FAIL(reap_with_retry_(inflight_count_))) {
+      PALF_LOG(ERROR, "reap_with_retry_ failed", K(ret), KPC(this));
+    }
+  }
+  return ret;
+}
+
+LogAIOWriter *&LogAIOWriter::get_thread_writer()
+{
+  static __thread LogAIOWriter *writer = NULL;
+  return writer;
+}
+
+int LogAIOWriter::reap_(const int64_t min_nr)
+{
+  int ret = OB_SUCCESS;
+  int sys_ret = 0;
+  while ((sys_ret = ::io_getevents(io_context_, min_nr, max_inflight_count_, events_, NULL)) < 0
+         && -EINTR == sys_ret); // ignore EINTR
+  if (sys_ret < 0) {
+    ret = OB_IO_ERROR;
+    PALF_LOG(WARN, "io_getevents failed", K(ret), K(sys_ret), KPC(this));
+  } else {
+    for (int64_t i = 0; i < sys_ret; i++) {
+      LogAIOWriteCtx *ctx = static_cast<LogAIOWriteCtx *>(events_[i].data);
+      handle_completion_(*ctx, static_cast<int64_t>(events_[i].res));
+    }
+  }
+  return ret;
+}
+
+int LogAIOWriter::reap_with_retry_(const int64_t min_nr)
+{
+  int ret = OB_SUCCESS;
+  int64_t retry_count = 0;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else {
+    while (OB_FAIL(reap_(min_nr)) && ++retry_count < MAX_REAP_RETRY_COUNT) {
+      ob_usleep(RETRY_INTERVAL);
+    }
+    if (OB_FAIL(ret)) {
+      PALF_LOG(ERROR, "io_getevents keeps failing, destroy io context and write synchronously",
+               K(ret), K(retry_count), KPC(this));
+      destroy_io_context_();
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+void LogAIOWriter::destroy_io_context_()
+{
+  // io_destroy waits all inflight writes in kernel, but their results can not be
+  // reaped any more, so rewrite them synchronously.
+  (void)::io_destroy(io_context_);
+  io_context_ = NULL;
+  is_inited_ = false;
+  for (int64_t i = 0; i < max_inflight_count_; i++) {
+    if (NULL != inflight_ctxs_[i]) {
+      handle_completion_(*inflight_ctxs_[i], -EIO);
+    }
+  }
+}
+
+void LogAIOWriter::handle_completion_(LogAIOWriteCtx &ctx, const int64_t res)
+{
+  int ret = OB_SUCCESS;
+  if (res != ctx.count_) {
+    PALF_LOG(WARN, "aio write failed, rewrite synchronously", K(res), K(ctx));
+    rewrite_count_++;
+    if (OB_FAIL(rewrite_(ctx))) {
+      PALF_LOG(ERROR, "rewrite failed", K(ret), K(res), K(ctx), KPC(this));
+    }
+  }
+  const int64_t cost_ts = ObTimeUtility::fast_current_time() - ctx.submit_ts_;
+  if (cost_ts > 100 * 1000) {
+    PALF_LOG(WARN, "aio write cost too much time", K(cost_ts), K(ctx), KPC(this));
+  }
+  ctx.ret_ = ret;
+  inflight_ctxs_[ctx.slot_] = NULL;
+  ctx.slot_ = -1;
+  ctx.is_inflight_ = false;
+  inflight_count_--;
+}
+
+// NB: retry until success, the log_tail of LogStorage has been advanced, giving up
+// the write leaves a hole in the block.
+int LogAIOWriter::rewrite_(const LogAIOWriteCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  int64_t time_interval = OB_INVALID_TIMESTAMP;
+  do {
+    if (ctx.count_ != ob_pwrite(ctx.fd_, ctx.buf_, ctx.count_, ctx.offset_)) {
+      if (palf_reach_time_interval(1000 * 1000, time_interval)) {
+        ret = convert_sys_errno();
+        PALF_LOG(ERROR, "ob_pwrite failed", K(ret), K(ctx));
+      }
+      ob_usleep(RETRY_INTERVAL);
+    } else {
+      ret = OB_SUCCESS;
+      break;
+    }
+  } while (OB_FAIL(ret));
+  return ret;
+}
+
+} // end namespace palf
+} // end namespace oceanbase
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LOGSERVICE_LOG_AIO_WRITER_
+#define OCEANBASE_LOGSERVICE_LOG_AIO_WRITER_
+
+#include <libaio.h>
+#include "lib/utility/ob_macro_utils.h"   // DISALLOW_COPY_AND_ASSIGN
+#include "lib/utility/ob_print_utils.h"   // TO_STRING_KV
+
+namespace oceanbase
+{
+namespace palf
+{
+class LogAIOWriter;
+
+// The context of one asynchronous write, owned by LogBlockHandler, the buffer of
+// the write must not be modified until the write has been completed.
+struct LogAIOWriteCtx
+{
+  LogAIOWriteCtx();
+  ~LogAIOWriteCtx();
+  void reset();
+  // wait until the write has been completed.
+  int wait();
+  bool is_inflight() const { return is_inflight_; }
+  // the result of the write, valid after the write has been completed.
+  int get_ret() const { return ret_; }
+  TO_STRING_KV(K_(fd), KP_(buf), K_(count), K_(offset), K_(submit_ts), K_(slot), K_(ret),
+               K_(is_inflight));
+
+  struct iocb iocb_;
+  LogAIOWriter *writer_;
+  int fd_;
+  const char *buf_;
+  int64_t count_;
+  int64_t offset_;
+  int64_t submit_ts_;
+  // the index in LogAIOWriter::inflight_ctxs_
+  int64_t slot_;
+  int ret_;
+  bool is_inflight_;
+};
+
+// LogAIOWriter allows LogIOWorker to keep multiple writes in flight, each write
+// belongs to a different block(the writes of one block are serial, because the
+// tail of last write will be written again by next write for DIO).
+//
+// NB: all interfaces must be called by the thread which owns this LogAIOWriter.
+class LogAIOWriter
+{
+public:
+  static constexpr int64_t MAX_INFLIGHT_COUNT = 64;
+  LogAIOWriter();
+  ~LogAIOWriter();
+  int init(const int64_t max_inflight_count);
+  void destroy();
+  bool is_inited() const { return is_inited_; }
+  // limit the count of inflight writes to [1, max_inflight_count].
+  void set_inflight_limit(const int64_t inflight_limit);
+  // @retval
+  //   OB_SUCCESS
+  //   OB_IO_ERROR, io_submit failed, caller need write synchronously.
+  int submit(const int fd,
+             const char *buf,
+             const int64_t count,
+             const int64_t offset,
+             LogAIOWriteCtx &ctx);
+  // NB: a failed write is rewritten synchronously until success, as same as
+  // LogBlockHandler::inner_write_impl_, the log_tail of LogStorage has been advanced
+  // when the write is submitted, so the write can not be given up.
+  int wait(LogAIOWriteCtx &ctx);
+  // wait until all inflight writes are completed, the result of each write is
+  // saved in its LogAIOWriteCtx.
+  //
+  // NB: if io_getevents keeps failing, the io context will be destroyed(which
+  // waits all inflight writes in kernel) and all writes after that will be
+  // written synchronously.
+  int wait_all();
+  int64_t get_inflight_count() const { return inflight_count_; }
+  // the LogAIOWriter used by current thread, NULL means write synchronously.
+  static LogAIOWriter *&get_thread_writer();
+  TO_STRING_KV(K_(max_inflight_count), K_(inflight_limit), K_(inflight_count), K_(submit_count),
+               K_(rewrite_count), K_(is_inited));
+private:
+  int reap_(const int64_t min_nr);
+  int reap_with_retry_(const int64_t min_nr);
+  void handle_completion_(LogAIOWriteCtx &ctx, const int64_t res);
+  int rewrite_(const LogAIOWriteCtx &ctx);
+  void destroy_io_context_();
+private:
+  static constexpr int64_t RETRY_INTERVAL = 10 * 1000;
+  // io_getevents is retried at most MAX_REAP_RETRY_COUNT times.
+  static constexpr int64_t MAX_REAP_RETRY_COUNT = 100;
+  io_context_t io_context_;
+  struct io_event *events_;
+  LogAIOWriteCtx **inflight_ctxs_;
+  int64_t max_inflight_count_;
+  int64_t inflight_limit_;
+  int64_t inflight_count_;
+  int64_t submit_count_;
+  // the count of failed writes which have been rewritten synchronously.
+  int64_t rewrite_count_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(LogAIOWriter);
+};
+
+// Set the LogAIOWriter of current thread in the scope.
+class LogAIOWriterGuard
+{
+public:
+  explicit LogAIOWriterGuard(LogAIOWriter *writer)
+  {
+    LogAIOWriter::get_thread_writer() = writer;
+  }
+  ~LogAIOWriterGuard()
+  {
+    LogAIOWriter::get_thread_writer() = NULL;
+  }
+private:
+  DISALLOW_COPY_AND_ASSIGN(LogAIOWriterGuard);
+};
+
+} // end namespace palf
+} // end namespace oceanbase
+#endif
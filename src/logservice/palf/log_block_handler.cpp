@@ -152,6 +152,8 @@ LogBlockHandler::LogBlockHandler()
     trace_time_(OB_INVALID_TIMESTAMP),
     dir_fd_(-1),
     io_fd_(-1),
+    aio_ctx_(),
+    has_pending_write_(false),
     is_inited_(false)
 {
 }
@@ -184,6 +186,7 @@ int LogBlockHandler::init(const int dir_fd,
 void LogBlockHandler::destroy()
 {
   if (IS_INIT) {
+    (void)wait_pending_write_();
     is_inited_ = false;
     dir_fd_ = -1;
     io_fd_ = -1;
@@ -281,6 +284,7 @@ int LogBlockHandler::writev(const offset_t offset,
 int LogBlockHandler::inner_close_()
 {
   int ret = OB_SUCCESS;
+  (void)wait_pending_write_();
   do {
     if (-1 == io_fd_) {
       PALF_LOG(INFO, "block has been closed or not eixst", K(ret));
@@ -326,6 +330,7 @@ int LogBlockHandler::inner_truncate_(const offset_t offset)
   //     was shorter, it is extended, and the extended part reads as null bytes ('\0').
   //
   // TODO by runlin, keep follow steps atomic, can use rename?
+  (void)wait_pending_write_();
   do {
     if (0 != ftruncate(io_fd_, offset)) {
       ret = convert_sys_errno();
@@ -356,6 +361,7 @@ int LogBlockHandler::inner_load_data_(const offset_t offset)
   // tail minus offset must be greater than LOG_DIO_ALIGN_SIZE
   offset_t read_count = offset - aligned_offset;
   offset_t aligned_read_count = upper_align(offset - aligned_offset, LOG_DIO_ALIGN_SIZE);
+  (void)wait_pending_write_();
   if (OB_ISNULL(input = reinterpret_cast<char *>(
       mtl_malloc_align(LOG_DIO_ALIGN_SIZE, aligned_read_count, "LogDIOAligned")))) {
     PALF_LOG(WARN, "allocate memory failed", K(ret));
@@ -385,17 +391,27 @@ int LogBlockHandler::inner_write_once_(const offset_t offset,
   int64_t write_size = 0;
   char *aligned_buf = const_cast<char *>(buf);
   int64_t aligned_buf_len = buf_len;
+  LogAIOWriter *aio_writer = LogAIOWriter::get_thread_writer();
 
   offset_t aligned_block_offset = offset;
-  if (OB_FAIL(dio_aligned_buf_.align_buf(buf, buf_len, aligned_buf,
+  if (OB_FAIL(wait_pending_write_())) {
+    PALF_LOG(ERROR, "wait_pending_write_ failed", K(ret), KPC(this));
+  } else if (OB_FAIL(dio_aligned_buf_.align_buf(buf, buf_len, aligned_buf,
       aligned_buf_len, aligned_block_offset))) {
     PALF_LOG(ERROR, "align_buf failed", K(ret), K(buf), K(buf_len),
         K(aligned_buf), K(aligned_buf_len), K(aligned_block_offset), K(offset));
+  } else if (NULL != aio_writer
+             && OB_SUCCESS == aio_writer->submit(io_fd_, aligned_buf, aligned_buf_len,
+                                                 aligned_block_offset, aio_ctx_)) {
+    // NB: 'dio_aligned_buf_' will be truncated after this write has been completed.
+    has_pending_write_ = true;
   } else if (OB_FAIL(inner_write_impl_(io_fd_, aligned_buf, aligned_buf_len, aligned_block_offset))){
     PALF_LOG(ERROR, "pwrite failed", K(ret), K(io_fd_), K(aligned_buf), K(aligned_block_offset),
         K(offset), K(buf_len), K(write_size));
   } else {
     dio_aligned_buf_.truncate_buf();
+  }
+  if (OB_SUCC(ret)) {
     total_write_size_ += buf_len;
     total_write_size_after_dio_ += aligned_buf_len;
     count_++;
@@ -454,5 +470,19 @@ int LogBlockHandler::inner_write_impl_(const int fd, const char *buf, const int6
   ob_pwrite_used_ts_ += cost_ts;
   return ret;
 }
+
+int LogBlockHandler::wait_pending_write_()
+{
+  int ret = OB_SUCCESS;
+  if (false == has_pending_write_) {
+  } else if (OB_FAIL(aio_ctx_.wait())) {
+    PALF_LOG(ERROR, "wait aio write failed", K(ret), K(aio_ctx_), KPC(this));
+  } else {
+    dio_aligned_buf_.truncate_buf();
+    aio_ctx_.reset();
+    has_pending_write_ = false;
+  }
+  return ret;
+}
 } // end of logservice
 } // end of oceanbase
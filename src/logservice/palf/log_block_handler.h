@@ -16,6 +16,7 @@
 #include "common/storage/ob_io_device.h"                  // ObIOFd
 #include "lib/ob_define.h"
 #include "log_define.h"                                // block_id_t ...
+#include "log_aio_writer.h"                            // LogAIOWriteCtx
 
 // This block contains the key class for writing a log into stable storage
 // device.
@@ -154,6 +155,9 @@ private:
   int inner_writev_once_(const offset_t offset,
       const LogWriteBuf &write_buf);
   int inner_write_impl_(const int fd, const char *buf, const int64_t count, const int64_t offset);
+  // NB: the last write may be asynchronous, wait it completed before modify
+  // 'dio_aligned_buf_' or 'io_fd_'.
+  int wait_pending_write_();
 private:
   static constexpr int64_t RETRY_INTERVAL = 10 * 1000;
   LogDIOAlignedBuf dio_aligned_buf_;
@@ -165,6 +169,8 @@ private:
   int64_t trace_time_;
   int dir_fd_;
   int io_fd_;
+  LogAIOWriteCtx aio_ctx_;
+  bool has_pending_write_;
   bool is_inited_;
 };
 } // end of logservice
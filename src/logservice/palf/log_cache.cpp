@@ -0,0 +1,424 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX PALF
+#include "log_cache.h"
+#include "lib/stat/ob_diagnose_info.h"  // EVENT_INC
+#include "share/rc/ob_tenant_base.h"    // mtl_malloc
+#include "log_writer_utils.h"           // LogWriteBuf
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace palf
+{
+LogCacheKey::LogCacheKey()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    palf_id_(INVALID_PALF_ID),
+    epoch_(-1),
+    block_id_(LOG_INVALID_BLOCK_ID),
+    page_id_(-1)
+{
+}
+
+LogCacheKey::LogCacheKey(const uint64_t tenant_id,
+                         const int64_t palf_id,
+                         const int64_t epoch,
+                         const block_id_t block_id,
+                         const int64_t page_id)
+  : tenant_id_(tenant_id),
+    palf_id_(palf_id),
+    epoch_(epoch),
+    block_id_(block_id),
+    page_id_(page_id)
+{
+}
+
+LogCacheKey::~LogCacheKey()
+{
+}
+
+bool LogCacheKey::operator ==(const ObIKVCacheKey &other) const
+{
+  const LogCacheKey &other_key = reinterpret_cast<const LogCacheKey &>(other);
+  return tenant_id_ == other_key.tenant_id_
+    && palf_id_ == other_key.palf_id_
+    && epoch_ == other_key.epoch_
+    && block_id_ == other_key.block_id_
+    && page_id_ == other_key.page_id_;
+}
+
+uint64_t LogCacheKey::get_tenant_id() const
+{
+  return tenant_id_;
+}
+
+uint64_t LogCacheKey::hash() const
+{
+  return murmurhash(this, sizeof(LogCacheKey), 0);
+}
+
+int64_t LogCacheKey::size() const
+{
+  return sizeof(*this);
+}
+
+int LogCacheKey::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    PALF_LOG(WARN, "invalid log cache key", K(ret), KPC(this));
+  } else {
+    key = new (buf) LogCacheKey(tenant_id_, palf_id_, epoch_, block_id_, page_id_);
+  }
+  return ret;
+}
+
+bool LogCacheKey::is_valid() const
+{
+  return is_valid_tenant_id(tenant_id_)
+    && is_valid_palf_id(palf_id_)
+    && 0 <= epoch_
+    && is_valid_block_id(block_id_)
+    && 0 <= page_id_;
+}
+
+LogCacheValue::LogCacheValue(const char *buf, const int64_t size)
+  : buf_(buf), size_(size)
+{
+}
+
+LogCacheValue::~LogCacheValue()
+{
+}
+
+int64_t LogCacheValue::size() const
+{
+  return sizeof(*this) + size_;
+}
+
+int LogCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), KP(buf), K(buf_len), "request_size", size());
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    PALF_LOG(WARN, "invalid log cache value", K(ret), KPC(this));
+  } else {
+    MEMCPY(buf + sizeof(*this), buf_, size_);
+    value = new (buf) LogCacheValue(buf + sizeof(*this), size_);
+  }
+  return ret;
+}
+
+LogCache &LogCache::get_instance()
+{
+  static LogCache instance;
+  return instance;
+}
+
+LogCache::LogCache() : is_inited_(false)
+{
+}
+
+LogCache::~LogCache()
+{
+}
+
+int LogCache::init(const char *cache_name, const int64_t priority)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    PALF_LOG(WARN, "LogCache has inited", K(ret));
+  } else if (OB_FAIL((common::ObKVCache<LogCacheKey, LogCacheValue>::init(cache_name, priority)))) {
+    PALF_LOG(WARN, "fail to init kv cache", K(ret), K(cache_name), K(priority));
+  } else {
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void LogCache::destroy()
+{
+  is_inited_ = false;
+  common::ObKVCache<LogCacheKey, LogCacheValue>::destroy();
+}
+
+int LogCache::get_page(const LogCacheKey &key, LogCacheValueHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  const LogCacheValue *value = NULL;
+  if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(key));
+  } else if (OB_FAIL(get(key, value, handle.handle_))) {
+    if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+      PALF_LOG(WARN, "fail to get page from log cache", K(ret), K(key));
+    } else {
+      EVENT_INC(ObStatEventIds::LOG_CACHE_MISS);
+    }
+  } else if (OB_ISNULL(value)) {
+    ret = OB_ERR_UNEXPECTED;
+    PALF_LOG(WARN, "unexpected error, the value must not be NULL", K(ret), K(key));
+  } else {
+    handle.value_ = value;
+    EVENT_INC(ObStatEventIds::LOG_CACHE_HIT);
+  }
+  return ret;
+}
+
+int LogCache::put_page(const LogCacheKey &key, const LogCacheValue &value)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!key.is_valid() || !value.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(key), K(value));
+  } else if (OB_FAIL(put(key, value, true/*overwrite*/))) {
+    PALF_LOG(WARN, "fail to put page to log cache", K(ret), K(key), K(value));
+  }
+  return ret;
+}
+
+int64_t LogCache::alloc_epoch()
+{
+  static int64_t global_epoch = 0;
+  return ATOMIC_AAF(&global_epoch, 1);
+}
+
+LogStorageCache::LogStorageCache()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    palf_id_(INVALID_PALF_ID),
+    logical_block_size_(0),
+    epoch_(-1),
+    page_buf_(NULL),
+    page_lsn_(),
+    page_len_(0),
+    is_inited_(false)
+{
+}
+
+LogStorageCache::~LogStorageCache()
+{
+  destroy();
+}
+
+int LogStorageCache::init(const int64_t palf_id, const int64_t logical_block_size)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t tenant_id = is_valid_tenant_id(MTL_ID()) ? MTL_ID() : OB_SERVER_TENANT_ID;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    PALF_LOG(WARN, "LogStorageCache has inited", K(ret), KPC(this));
+  } else if (false == is_valid_palf_id(palf_id) || 0 >= logical_block_size) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(palf_id), K(logical_block_size));
+  } else if (OB_ISNULL(page_buf_ = static_cast<char *>(mtl_malloc(LOG_CACHE_PAGE_SIZE, "LogCache")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(WARN, "alloc page buf failed", K(ret), K(palf_id));
+  } else {
+    tenant_id_ = tenant_id;
+    palf_id_ = palf_id;
+    logical_block_size_ = logical_block_size;
+    epoch_ = LogCache::alloc_epoch();
+    page_lsn_.reset();
+    page_len_ = 0;
+    is_inited_ = true;
+    PALF_LOG(INFO, "LogStorageCache init success", K(ret), KPC(this));
+  }
+  return ret;
+}
+
+void LogStorageCache::destroy()
+{
+  is_inited_ = false;
+  if (NULL != page_buf_) {
+    mtl_free(page_buf_);
+    page_buf_ = NULL;
+  }
+  page_lsn_.reset();
+  page_len_ = 0;
+  epoch_ = -1;
+  logical_block_size_ = 0;
+  palf_id_ = INVALID_PALF_ID;
+  tenant_id_ = OB_INVALID_TENANT_ID;
+}
+
+bool LogStorageCache::is_enabled() const
+{
+  return is_inited_ && LogCache::get_instance().is_inited();
+}
+
+int LogStorageCache::read(const LSN &read_lsn,
+                          const int64_t read_size,
+                          char *buf,
+                          bool &hit) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t epoch = ATOMIC_LOAD(&epoch_);
+  const LSN end_lsn = read_lsn + read_size;
+  LSN curr_lsn = read_lsn;
+  bool miss = false;
+  hit = false;
+  if (false == is_enabled()) {
+    ret = OB_NOT_INIT;
+  } else if (false == read_lsn.is_valid() || 0 >= read_size || OB_ISNULL(buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(read_lsn), K(read_size), KP(buf));
+  }
+  while (OB_SUCC(ret) && false == miss && curr_lsn < end_lsn) {
+    LSN page_start;
+    LSN page_end;
+    LogCacheKey key;
+    LogCacheValueHandle handle;
+    get_page_range_(curr_lsn, page_start, page_end);
+    gen_key_(epoch, page_start, key);
+    if (OB_FAIL(LogCache::get_instance().get_page(key, handle))) {
+      if (OB_ENTRY_NOT_EXIST == ret) {
+        ret = OB_SUCCESS;
+        miss = true;
+      }
+    } else if (OB_UNLIKELY(handle.value_->get_size() != static_cast<int64_t>(page_end - page_start))) {
+      ret = OB_ERR_UNEXPECTED;
+      PALF_LOG(ERROR, "unexpected page size", K(ret), K(key), K(page_start), K(page_end), K(handle));
+    } else {
+      const int64_t copy_size = MIN(page_end, end_lsn) - curr_lsn;
+      MEMCPY(buf + (curr_lsn - read_lsn), handle.value_->get_buffer() + (curr_lsn - page_start), copy_size);
+      curr_lsn = curr_lsn + copy_size;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    hit = (false == miss);
+  }
+  return ret;
+}
+
+void LogStorageCache::fill(const int64_t epoch,
+                           const LSN &lsn,
+                           const char *buf,
+                           const int64_t buf_len) const
+{
+  const LSN end_lsn = lsn + buf_len;
+  LSN curr_lsn = lsn;
+  if (true == is_enabled() && 0 <= epoch && true == lsn.is_valid() && 0 < buf_len && NULL != buf) {
+    while (curr_lsn < end_lsn) {
+      LSN page_start;
+      LSN page_end;
+      get_page_range_(curr_lsn, page_start, page_end);
+      // only complete pages can be cached.
+      if (page_start == curr_lsn && page_end <= end_lsn) {
+        put_page_(epoch, page_start, buf + (curr_lsn - lsn), page_end - page_start);
+      }
+      curr_lsn = page_end;
+    }
+  }
+}
+
+void LogStorageCache::append(const LSN &lsn, const LogWriteBuf &write_buf)
+{
+  int ret = OB_SUCCESS;
+  LSN curr_lsn = lsn;
+  if (true == is_enabled()) {
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < write_buf.get_buf_count(); idx++) {
+      const char *buf = NULL;
+      int64_t buf_len = 0;
+      if (OB_FAIL(write_buf.get_write_buf(idx, buf, buf_len))) {
+        PALF_LOG(WARN, "get_write_buf failed", K(ret), K(idx), K(write_buf));
+        page_lsn_.reset();
+      } else {
+        append_(curr_lsn, buf, buf_len);
+        curr_lsn = curr_lsn + buf_len;
+      }
+    }
+  }
+}
+
+void LogStorageCache::invalidate()
+{
+  if (IS_INIT) {
+    ATOMIC_STORE(&epoch_, LogCache::alloc_epoch());
+    page_lsn_.reset();
+    page_len_ = 0;
+    PALF_LOG(INFO, "LogStorageCache invalidate", KPC(this));
+  }
+}
+
+void LogStorageCache::get_page_range_(const LSN &lsn, LSN &page_start, LSN &page_end) const
+{
+  const block_id_t block_id = lsn_2_block(lsn, logical_block_size_);
+  const offset_t offset = lsn_2_offset(lsn, logical_block_size_);
+  const LSN block_start(block_id * logical_block_size_);
+  page_start = block_start + (offset / LOG_CACHE_PAGE_SIZE * LOG_CACHE_PAGE_SIZE);
+  page_end = MIN(page_start + LOG_CACHE_PAGE_SIZE, block_start + logical_block_size_);
+}
+
+void LogStorageCache::gen_key_(const int64_t epoch, const LSN &page_start, LogCacheKey &key) const
+{
+  const block_id_t block_id = lsn_2_block(page_start, logical_block_size_);
+  const int64_t page_id = lsn_2_offset(page_start, logical_block_size_) / LOG_CACHE_PAGE_SIZE;
+  key = LogCacheKey(tenant_id_, palf_id_, epoch, block_id, page_id);
+}
+
+void LogStorageCache::put_page_(const int64_t epoch,
+                                const LSN &page_start,
+                                const char *buf,
+                                const int64_t len) const
+{
+  int ret = OB_SUCCESS;
+  LogCacheKey key;
+  LogCacheValue value(buf, len);
+  gen_key_(epoch, page_start, key);
+  if (OB_FAIL(LogCache::get_instance().put_page(key, value))) {
+    PALF_LOG(TRACE, "put page to log cache failed", K(ret), K(key));
+  }
+}
+
+void LogStorageCache::append_(const LSN &lsn, const char *buf, const int64_t buf_len)
+{
+  LSN curr_lsn = lsn;
+  const LSN end_lsn = lsn + buf_len;
+  while (curr_lsn < end_lsn) {
+    LSN page_start;
+    LSN page_end;
+    get_page_range_(curr_lsn, page_start, page_end);
+    const int64_t copy_size = MIN(page_end, end_lsn) - curr_lsn;
+    if (page_start == curr_lsn) {
+      page_lsn_ = page_start;
+      page_len_ = 0;
+    }
+    // NB: the data before 'page_lsn_' may be lost after restart or truncate, the page
+    // which has not been staged from its start can't be cached.
+    if (page_lsn_.is_valid() && page_lsn_ + page_len_ == curr_lsn) {
+      MEMCPY(page_buf_ + page_len_, buf + (curr_lsn - lsn), copy_size);
+      page_len_ += copy_size;
+      if (page_lsn_ + page_len_ == page_end) {
+        put_page_(ATOMIC_LOAD(&epoch_), page_lsn_, page_buf_, page_len_);
+        page_lsn_.reset();
+        page_len_ = 0;
+      }
+    } else {
+      page_lsn_.reset();
+      page_len_ = 0;
+    }
+    curr_lsn = curr_lsn + copy_size;
+  }
+}
+
+} // end namespace palf
+} // end namespace oceanbase
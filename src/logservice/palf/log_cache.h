@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LOGSERVICE_LOG_CACHE_
+#define OCEANBASE_LOGSERVICE_LOG_CACHE_
+
+#include "share/cache/ob_kv_storecache.h"  // ObKVCache
+#include "log_define.h"                    // block_id_t
+#include "lsn.h"                           // LSN
+
+namespace oceanbase
+{
+namespace palf
+{
+struct LogWriteBuf;
+
+// The log cache is shared by all readers of PALF(follower fetch, CDC, replay, archive),
+// the data of each block is split into pages of LOG_CACHE_PAGE_SIZE by logical offset,
+// the last page of a block may be shorter than LOG_CACHE_PAGE_SIZE.
+//
+// 'epoch' identifies the content of one LogStorage, it will be advanced when the data
+// on disk has been changed(truncate, rebuild), therefore, the stale pages can never be
+// hit and will be washed out by ObKVGlobalCache.
+class LogCacheKey : public common::ObIKVCacheKey
+{
+public:
+  LogCacheKey();
+  LogCacheKey(const uint64_t tenant_id,
+              const int64_t palf_id,
+              const int64_t epoch,
+              const block_id_t block_id,
+              const int64_t page_id);
+  virtual ~LogCacheKey();
+  virtual bool operator ==(const ObIKVCacheKey &other) const override;
+  virtual uint64_t get_tenant_id() const override;
+  virtual uint64_t hash() const override;
+  virtual int64_t size() const override;
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const override;
+  bool is_valid() const;
+  TO_STRING_KV(K_(tenant_id), K_(palf_id), K_(epoch), K_(block_id), K_(page_id));
+
+private:
+  uint64_t tenant_id_;
+  int64_t palf_id_;
+  int64_t epoch_;
+  block_id_t block_id_;
+  int64_t page_id_;
+};
+
+class LogCacheValue : public common::ObIKVCacheValue
+{
+public:
+  LogCacheValue(const char *buf, const int64_t size);
+  virtual ~LogCacheValue();
+  virtual int64_t size() const override;
+  virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const override;
+  bool is_valid() const { return NULL != buf_ && size_ > 0; }
+  const char *get_buffer() const { return buf_; }
+  int64_t get_size() const { return size_; }
+  TO_STRING_KV(KP_(buf), K_(size));
+
+private:
+  const char *buf_;
+  int64_t size_;
+  DISALLOW_COPY_AND_ASSIGN(LogCacheValue);
+};
+
+struct LogCacheValueHandle
+{
+  LogCacheValueHandle() : value_(NULL), handle_() {}
+  ~LogCacheValueHandle() {}
+  void reset()
+  {
+    handle_.reset();
+    value_ = NULL;
+  }
+  TO_STRING_KV(KP_(value), K_(handle));
+  const LogCacheValue *value_;
+  common::ObKVCacheHandle handle_;
+};
+
+class LogCache : public common::ObKVCache<LogCacheKey, LogCacheValue>
+{
+public:
+  static const int64_t LOG_CACHE_PRIORITY = 1;
+  static LogCache &get_instance();
+  int init(const char *cache_name, const int64_t priority);
+  void destroy();
+  bool is_inited() const { return is_inited_; }
+  // @retval
+  //   OB_SUCCESS
+  //   OB_ENTRY_NOT_EXIST, cache miss
+  int get_page(const LogCacheKey &key, LogCacheValueHandle &handle);
+  int put_page(const LogCacheKey &key, const LogCacheValue &value);
+  // each LogStorage gets an unique epoch, the palf_id may be reused after the palf is removed.
+  static int64_t alloc_epoch();
+private:
+  LogCache();
+  ~LogCache();
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(LogCache);
+};
+
+// The accessor of LogCache for one LogStorage.
+//
+// The pages are filled in two ways:
+// 1. 'append', the data written by LogIOWorker are staged in 'page_buf_' until a page is
+//    complete, so the recent logs can be read from memory by lagging follower and CDC.
+// 2. 'fill', the complete pages read from disk on cache miss.
+class LogStorageCache
+{
+public:
+  static const int64_t LOG_CACHE_PAGE_SIZE = 64 * 1024;
+  LogStorageCache();
+  ~LogStorageCache();
+  int init(const int64_t palf_id, const int64_t logical_block_size);
+  void destroy();
+  bool is_enabled() const;
+  // NB: caller must ensure that [read_lsn, read_lsn + read_size) is in one block and
+  // 'buf' can hold 'read_size' bytes, 'hit' is true only if all pages are in cache.
+  int read(const LSN &read_lsn, const int64_t read_size, char *buf, bool &hit) const;
+  // NB: must be got before reading data from disk, and be passed to 'fill'.
+  int64_t get_epoch() const { return ATOMIC_LOAD(&epoch_); }
+  // put the complete pages of [lsn, lsn + buf_len), the data must have been flushed.
+  // 'epoch' is the one got before the data was read, if 'invalidate' has been called
+  // since then, the pages are put with the stale epoch and will never be hit.
+  void fill(const int64_t epoch, const LSN &lsn, const char *buf, const int64_t buf_len) const;
+  // NB: only be called by LogIOWorker after the data has been written.
+  void append(const LSN &lsn, const LogWriteBuf &write_buf);
+  // discard all cached pages, called when the data on disk has been changed.
+  void invalidate();
+  TO_STRING_KV(K_(tenant_id), K_(palf_id), K_(epoch), K_(page_lsn), K_(page_len), K_(is_inited));
+private:
+  void get_page_range_(const LSN &lsn, LSN &page_start, LSN &page_end) const;
+  void gen_key_(const int64_t epoch, const LSN &page_start, LogCacheKey &key) const;
+  void put_page_(const int64_t epoch, const LSN &page_start, const char *buf, const int64_t len) const;
+  void append_(const LSN &lsn, const char *buf, const int64_t buf_len);
+private:
+  uint64_t tenant_id_;
+  int64_t palf_id_;
+  int64_t logical_block_size_;
+  int64_t epoch_;
+  // the page which is being written.
+  char *page_buf_;
+  LSN page_lsn_;
+  int64_t page_len_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(LogStorageCache);
+};
+
+} // end namespace palf
+} // end namespace oceanbase
+#endif
@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "log_compressor.h"
+#include "lib/compress/ob_compressor_pool.h"   // ObCompressorPool
+#include "lib/allocator/ob_malloc.h"           // ob_malloc
+#include "lib/stat/ob_diagnose_info.h"         // EVENT_INC
+#include "log_entry.h"                         // LogEntry
+#include "log_define.h"                        // MAX_LOG_BODY_SIZE
+
+namespace oceanbase
+{
+using namespace common;
+namespace palf
+{
+LogCompressor::LogCompressor()
+  : buf_(NULL),
+    buf_size_(0),
+    attr_(OB_SERVER_TENANT_ID, "LogCompressor")
+{
+}
+
+LogCompressor::~LogCompressor()
+{
+  destroy();
+}
+
+void LogCompressor::destroy()
+{
+  if (NULL != buf_) {
+    ob_free(buf_);
+    buf_ = NULL;
+  }
+  buf_size_ = 0;
+}
+
+int LogCompressor::compress(const ObCompressorType compressor_type,
+                            const char *buf,
+                            const int64_t buf_len,
+                            const char *&out,
+                            int64_t &out_len,
+                            bool &is_compressed)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  int64_t max_overflow_size = 0;
+  int64_t compress_len = 0;
+  int64_t pos = 0;
+  is_compressed = false;
+  if (NULL == buf || buf_len <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (NONE_COMPRESSOR == compressor_type || INVALID_COMPRESSOR == compressor_type
+             || buf_len < MIN_COMPRESS_SIZE || buf_len > INT32_MAX) {
+    // do nothing
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type, compressor))) {
+    PALF_LOG(WARN, "get compressor failed", K(ret), K(compressor_type));
+  } else if (OB_FAIL(compressor->get_max_overflow_size(buf_len, max_overflow_size))) {
+    PALF_LOG(WARN, "get max overflow size failed", K(ret), K(buf_len));
+  } else if (OB_FAIL(reserve_(COMPRESSED_HEADER_SIZE + buf_len + max_overflow_size))) {
+    PALF_LOG(WARN, "reserve_ failed", K(ret), K(buf_len), K(max_overflow_size));
+  } else if (OB_FAIL(serialization::encode_i16(buf_, buf_size_, pos, static_cast<int16_t>(compressor_type)))
+             || OB_FAIL(serialization::encode_i32(buf_, buf_size_, pos, static_cast<int32_t>(buf_len)))) {
+    PALF_LOG(WARN, "encode compressed header failed", K(ret), K(pos), KPC(this));
+  } else if (OB_FAIL(compressor->compress(buf, buf_len, buf_ + pos, buf_size_ - pos, compress_len))) {
+    PALF_LOG(WARN, "compress log failed", K(ret), K(compressor_type), K(buf_len));
+  } else if (pos + compress_len >= buf_len - (buf_len >> 3)) {
+    // saves less than 1/8, submit the original data
+  } else {
+    out = buf_;
+    out_len = pos + compress_len;
+    is_compressed = true;
+    EVENT_INC(CLOG_COMPRESS_COUNT);
+    EVENT_ADD(CLOG_COMPRESS_SAVED_SIZE, buf_len - out_len);
+  }
+  return ret;
+}
+
+int LogCompressor::decompress(const char *buf,
+                              const int64_t buf_len,
+                              const char *&out,
+                              int64_t &out_len)
+{
+  int ret = OB_SUCCESS;
+  int16_t compressor_type = 0;
+  int32_t original_size = 0;
+  int64_t pos = 0;
+  int64_t decompress_len = 0;
+  ObCompressor *compressor = NULL;
+  if (NULL == buf || buf_len <= COMPRESSED_HEADER_SIZE) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_FAIL(serialization::decode_i16(buf, buf_len, pos, &compressor_type))
+             || OB_FAIL(serialization::decode_i32(buf, buf_len, pos, &original_size))) {
+    PALF_LOG(WARN, "decode compressed header failed", K(ret), K(buf_len));
+  } else if (original_size <= 0 || original_size > MAX_LOG_BODY_SIZE) {
+    ret = OB_INVALID_DATA;
+    PALF_LOG(ERROR, "invalid original size", K(ret), K(original_size), K(compressor_type));
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(
+      static_cast<ObCompressorType>(compressor_type), compressor))) {
+    PALF_LOG(WARN, "get compressor failed", K(ret), K(compressor_type));
+  } else if (OB_FAIL(reserve_(original_size))) {
+    PALF_LOG(WARN, "reserve_ failed", K(ret), K(original_size));
+  } else if (OB_FAIL(compressor->decompress(buf + pos, buf_len - pos, buf_, original_size,
+                                            decompress_len))) {
+    PALF_LOG(WARN, "decompress log failed", K(ret), K(compressor_type), K(original_size));
+  } else if (OB_UNLIKELY(decompress_len != original_size)) {
+    ret = OB_INVALID_DATA;
+    PALF_LOG(ERROR, "decompressed log length mismatch", K(ret), K(decompress_len), K(original_size));
+  } else {
+    out = buf_;
+    out_len = decompress_len;
+    EVENT_INC(CLOG_DECOMPRESS_COUNT);
+  }
+  return ret;
+}
+
+int LogCompressor::get_data(const LogEntry &entry,
+                            const char *&out,
+                            int64_t &out_len)
+{
+  int ret = OB_SUCCESS;
+  if (false == entry.get_header().is_compressed()) {
+    out = entry.get_data_buf();
+    out_len = entry.get_data_len();
+  } else if (OB_FAIL(decompress(entry.get_data_buf(), entry.get_data_len(), out, out_len))) {
+    PALF_LOG(WARN, "decompress failed", K(ret), K(entry));
+  }
+  return ret;
+}
+
+int LogCompressor::reserve_(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  char *buf = NULL;
+  if (size <= buf_size_) {
+  } else if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(size, attr_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(WARN, "allocate memory failed", K(ret), K(size));
+  } else {
+    destroy();
+    buf_ = buf;
+    buf_size_ = size;
+  }
+  return ret;
+}
+
+LogCompressorPool::LogCompressorPool()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    count_(0),
+    compressors_(NULL),
+    free_queue_(),
+    is_inited_(false)
+{
+}
+
+LogCompressorPool::~LogCompressorPool()
+{
+  destroy();
+}
+
+int LogCompressorPool::init(const uint64_t tenant_id, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  const ObMemAttr attr(tenant_id, "LogCompressor");
+  void *ptr = NULL;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    PALF_LOG(WARN, "LogCompressorPool has inited", K(ret), KPC(this));
+  } else if (false == is_valid_tenant_id(tenant_id) || 0 >= count) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(tenant_id), K(count));
+  } else if (OB_FAIL(free_queue_.init(count, global_default_allocator, "LogCompressor"))) {
+    PALF_LOG(WARN, "free_queue_ init failed", K(ret), K(count));
+  } else if (OB_ISNULL(ptr = ob_malloc(count * sizeof(LogCompressor), attr))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(WARN, "allocate memory failed", K(ret), K(tenant_id), K(count));
+  } else {
+    compressors_ = static_cast<LogCompressor *>(ptr);
+    for (int64_t i = 0; i < count; i++) {
+      new (compressors_ + i) LogCompressor();
+      compressors_[i].set_attr(attr);
+      count_++;
+      // the queue can hold 'count' elements, push never fails.
+      (void)free_queue_.push(compressors_ + i);
+    }
+    tenant_id_ = tenant_id;
+    is_inited_ = true;
+    PALF_LOG(INFO, "LogCompressorPool init success", K(ret), KPC(this));
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    destroy();
+  }
+  return ret;
+}
+
+void LogCompressorPool::destroy()
+{
+  is_inited_ = false;
+  free_queue_.destroy();
+  if (NULL != compressors_) {
+    for (int64_t i = 0; i < count_; i++) {
+      compressors_[i].~LogCompressor();
+    }
+    ob_free(compressors_);
+    compressors_ = NULL;
+  }
+  count_ = 0;
+  tenant_id_ = OB_INVALID_TENANT_ID;
+}
+
+LogCompressor *LogCompressorPool::acquire()
+{
+  LogCompressor *compressor = NULL;
+  if (IS_INIT && OB_SUCCESS != free_queue_.pop(compressor)) {
+    compressor = NULL;
+  }
+  return compressor;
+}
+
+void LogCompressorPool::release(LogCompressor *compressor)
+{
+  int ret = OB_SUCCESS;
+  if (NULL == compressor) {
+  } else if (OB_FAIL(free_queue_.push(compressor))) {
+    PALF_LOG(ERROR, "push LogCompressor into free_queue_ failed", K(ret), KP(compressor), KPC(this));
+  }
+}
+
+} // end namespace palf
+} // end namespace oceanbase
@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LOGSERVICE_LOG_COMPRESSOR_
+#define OCEANBASE_LOGSERVICE_LOG_COMPRESSOR_
+
+#include "lib/alloc/alloc_struct.h"         // ObMemAttr
+#include "lib/compress/ob_compress_util.h"   // ObCompressorType
+#include "lib/queue/ob_fixed_queue.h"        // ObFixedQueue
+#include "lib/utility/ob_macro_utils.h"      // DISALLOW_COPY_AND_ASSIGN
+#include "lib/utility/ob_print_utils.h"      // TO_STRING_KV
+
+namespace oceanbase
+{
+namespace palf
+{
+class LogEntry;
+
+// The payload of a LogEntry may be compressed by leader before it is submitted to
+// LogSlidingWindow, and the COMPRESSED flag is set in LogEntryHeader. The checksum of
+// LogEntryHeader covers the compressed payload, therefore, the group entries are
+// replicated, archived and fetched by CDC in the compressed format.
+//
+// The format of compressed payload:
+// | compressor_type(int16) | original_size(int32) | compressed data |
+//
+// NB: LogCompressor is not thread safe, the returned buffer is valid until next call.
+class LogCompressor
+{
+public:
+  LogCompressor();
+  ~LogCompressor();
+  void destroy();
+  // the memory of buffer is allocated with 'attr', the default tenant is OB_SERVER_TENANT_ID.
+  void set_attr(const lib::ObMemAttr &attr) { attr_ = attr; }
+  // @brief compress 'buf' with 'compressor_type'
+  // @param[out] is_compressed, false means compression can not save enough space, the
+  //             original data should be submitted.
+  int compress(const common::ObCompressorType compressor_type,
+               const char *buf,
+               const int64_t buf_len,
+               const char *&out,
+               int64_t &out_len,
+               bool &is_compressed);
+  int decompress(const char *buf,
+                 const int64_t buf_len,
+                 const char *&out,
+                 int64_t &out_len);
+  // @brief get the original payload of 'entry', decompress it if needed.
+  int get_data(const LogEntry &entry,
+               const char *&out,
+               int64_t &out_len);
+  TO_STRING_KV(KP_(buf), K_(buf_size), K_(attr));
+public:
+  // the payload shorter than this value will not be compressed.
+  static const int64_t MIN_COMPRESS_SIZE = 1024;
+  static const int64_t COMPRESSED_HEADER_SIZE = sizeof(int16_t) + sizeof(int32_t);
+private:
+  int reserve_(const int64_t size);
+private:
+  char *buf_;
+  int64_t buf_size_;
+  lib::ObMemAttr attr_;
+  DISALLOW_COPY_AND_ASSIGN(LogCompressor);
+};
+
+// LogCompressorPool holds a fixed count of LogCompressor for the leader which submits logs,
+// the buffer of each LogCompressor is at most COMPRESSED_HEADER_SIZE + MAX_LOG_BODY_SIZE
+// plus the overflow size of compressor, so the memory of one tenant is bounded.
+//
+// NB: 'acquire' returns NULL when all LogCompressors are in use, the caller should submit
+// the original log.
+class LogCompressorPool
+{
+public:
+  static const int64_t DEFAULT_COMPRESSOR_COUNT = 8;
+  LogCompressorPool();
+  ~LogCompressorPool();
+  int init(const uint64_t tenant_id, const int64_t count);
+  void destroy();
+  LogCompressor *acquire();
+  void release(LogCompressor *compressor);
+  TO_STRING_KV(K_(tenant_id), K_(count), "free_count", free_queue_.get_total(), K_(is_inited));
+private:
+  uint64_t tenant_id_;
+  int64_t count_;
+  LogCompressor *compressors_;
+  common::ObFixedQueue<LogCompressor> free_queue_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(LogCompressorPool);
+};
+
+} // end namespace palf
+} // end namespace oceanbase
+#endif
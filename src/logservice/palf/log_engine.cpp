@@ -125,6 +125,8 @@ int LogEngine::init(const int64_t palf_id,
                                        log_storage_switch_cb,
                                        log_block_pool))) {
     PALF_LOG(ERROR, "LogStorage init failed!!!", K(ret), K(palf_id), K(base_dir), K(log_meta));
+  } else if (OB_FAIL(log_storage_.enable_log_cache())) {
+    PALF_LOG(ERROR, "LogStorage enable_log_cache failed", K(ret), K(palf_id));
   } else if (OB_FAIL(log_net_service_.init(palf_id, log_rpc))) {
     PALF_LOG(ERROR, "LogNetService init failed", K(ret), K(palf_id));
   } else if (OB_FAIL(append_log_meta_(log_meta))) {
@@ -213,6 +215,8 @@ int LogEngine::load(const int64_t palf_id,
                                           PALF_BLOCK_SIZE, log_storage_switch_cb, log_block_pool,
                                           entry_header, last_group_entry_header_lsn))) {
     PALF_LOG(ERROR, "LogStorage load failed", K(ret), K(palf_id), K(base_dir));
+  } else if (OB_FAIL(log_storage_.enable_log_cache())) {
+    PALF_LOG(ERROR, "LogStorage enable_log_cache failed", K(ret), K(palf_id));
   } else if (FALSE_IT(guard.click("load log_stoarge_"))
              || OB_FAIL(try_clear_up_holes_and_check_storage_integrity_(
                     last_group_entry_header_lsn, entry_header, expected_next_block_id))) {
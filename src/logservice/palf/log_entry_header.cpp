@@ -84,7 +84,8 @@ void LogEntryHeader::update_header_checksum_()
 
 int LogEntryHeader::generate_header(const char *log_data,
                                     const int64_t data_len,
-                                    const int64_t log_ts)
+                                    const int64_t log_ts,
+                                    const bool is_compressed)
 {
   int ret = OB_SUCCESS;
   if (NULL == log_data || data_len <= 0 || OB_INVALID_TIMESTAMP == log_ts) {
@@ -95,6 +96,7 @@ int LogEntryHeader::generate_header(const char *log_data,
     log_size_ = data_len;
     ts_ = log_ts;
     data_checksum_ = common::ob_crc64(log_data, data_len);
+    flag_ = (true == is_compressed) ? COMPRESSED_MASK : 0;
     // update header checksum after all member vars assigned
     (void) update_header_checksum_();
     PALF_LOG(TRACE, "generate_header", KPC(this));
@@ -26,9 +26,12 @@ public:
   LogEntryHeader();
   ~LogEntryHeader();
 public:
+  // @param[in] is_compressed: whether log_data is compressed by LogCompressor, the
+  //            data_checksum covers the compressed data.
   int generate_header(const char *log_data,
                       const int64_t data_len,
-                      const int64_t log_ts);
+                      const int64_t log_ts,
+                      const bool is_compressed);
   LogEntryHeader& operator=(const LogEntryHeader &header);
   void reset();
   bool is_valid() const;
@@ -36,6 +39,7 @@ public:
   int32_t get_data_len() const { return log_size_; }
   int64_t get_log_ts() const { return ts_; }
   int64_t get_data_checksum() const { return data_checksum_; }
+  bool is_compressed() const { return (flag_ & COMPRESSED_MASK) > 0; }
   bool check_header_integrity() const;
   NEED_SERIALIZE_AND_DESERIALIZE;
   TO_STRING_KV("magic", magic_,
@@ -53,6 +57,7 @@ private:
   bool check_header_checksum_() const;
 private:
   static constexpr int16_t LOG_ENTRY_HEADER_VERSION = 1;
+  static constexpr int64_t COMPRESSED_MASK = 1 << 1;
 private:
   int16_t magic_;
   int16_t version_;
@@ -60,6 +65,7 @@ private:
   int64_t ts_;
   int64_t data_checksum_;
   // The lowest bit is used for parity check.
+  // The second bit from last is used for checking whether the data is compressed.
   int64_t flag_;
 };
 }
@@ -13,7 +13,7 @@
 #include "log_group_entry_header.h"       // LogGroupEntryHeader
 #include "log_entry.h"                    // LogEntry
 #include "log_entry_header.h"             // LogEntryHeader
-#include "lib/checksum/ob_crc64.h"        // ob_crc64
+#include "lib/checksum/ob_crc64.h"        // ob_crc64, ObBatchChecksum
 #include "lib/checksum/ob_parity_check.h" // parity_check
 #include "lib/utility/utility.h"          // !FALSE_IT
 #include "lib/oblog/ob_log_module.h"      // LOG*
@@ -144,7 +144,9 @@ int LogGroupEntryHeader::calculate_log_checksum_(const bool is_padding_log,
     assert(total_buf_len > pos);
     LogEntryHeader log_entry_header;
     int64_t log_entry_data_checksum = 0;
-    int64_t tmp_log_checksum = 0;
+    // the data checksums of log entries are accumulated in batch, which is the same as
+    // calling ob_crc64 on each of them but avoids the per call overhead
+    common::ObBatchChecksum batch_checksum;
     while (OB_SUCC(ret) && NULL != tmp_buf && pos < total_buf_len) {
       if (OB_FAIL(log_entry_header.deserialize(tmp_buf, total_buf_len, pos))) {
         PALF_LOG(ERROR, "log_entry_header deserialize failed", K(ret), KP(tmp_buf), K(pos), K(total_buf_len));
@@ -154,13 +156,13 @@ int LogGroupEntryHeader::calculate_log_checksum_(const bool is_padding_log,
             K(log_entry_header));
       } else {
         log_entry_data_checksum = log_entry_header.get_data_checksum();
-        tmp_log_checksum = common::ob_crc64(tmp_log_checksum, &log_entry_data_checksum, sizeof(log_entry_data_checksum));
+        batch_checksum.fill(&log_entry_data_checksum, sizeof(log_entry_data_checksum));
         pos += log_entry_header.get_data_len();
       }
     }
 
     if (OB_SUCC(ret)) {
-      data_checksum = tmp_log_checksum;
+      data_checksum = static_cast<int64_t>(batch_checksum.calc());
     }
 
     if (NULL != tmp_buf && need_free_mem) {
@@ -388,7 +390,7 @@ bool LogGroupEntryHeader::check_log_checksum_(const char *buf,
     LogEntry log_entry;
     int ret = OB_SUCCESS;
     int64_t log_entry_data_checksum = 0;
-    int64_t tmp_group_checksum = 0;
+    common::ObBatchChecksum batch_checksum;
     bool_ret = true;
     while (OB_SUCC(ret) && bool_ret && pos < data_len) {
       if (OB_FAIL(log_entry.deserialize(buf, data_len, pos))) {
@@ -396,14 +398,14 @@ bool LogGroupEntryHeader::check_log_checksum_(const char *buf,
       } else {
         bool_ret = log_entry.check_integrity();
         log_entry_data_checksum = log_entry.get_header().get_data_checksum();
-        tmp_group_checksum = common::ob_crc64(tmp_group_checksum, &log_entry_data_checksum, sizeof(log_entry_data_checksum));
+        batch_checksum.fill(&log_entry_data_checksum, sizeof(log_entry_data_checksum));
       }
     }
     if (OB_FAIL(ret)) {
       bool_ret = false;
     }
     if (bool_ret) {
-      group_data_checksum = tmp_group_checksum;
+      group_data_checksum = static_cast<int64_t>(batch_checksum.calc());
     }
   }
   return bool_ret;
@@ -441,6 +443,7 @@ int LogGroupEntryHeader::truncate(const char *buf,
     LogEntryHeader log_entry_header;
     int64_t log_entry_data_checksum = 0;
     int64_t tmp_log_checksum = 0;
+    common::ObBatchChecksum batch_checksum;
     while (OB_SUCC(ret) && pos < data_len) {
       if (OB_FAIL(log_entry_header.deserialize(buf, data_len, pos))) {
         PALF_LOG(ERROR, "log_entry_header deserialize failed", K(ret), KP(buf), K(data_len));
@@ -448,7 +451,7 @@ int LogGroupEntryHeader::truncate(const char *buf,
         break;
       } else {
         log_entry_data_checksum = log_entry_header.get_data_checksum();
-        tmp_log_checksum = common::ob_crc64(tmp_log_checksum, &log_entry_data_checksum, sizeof(log_entry_data_checksum));
+        batch_checksum.fill(&log_entry_data_checksum, sizeof(log_entry_data_checksum));
         pos += log_entry_header.get_data_len();
         cut_pos = pos;
         if (log_entry_header.get_log_ts() > tmp_max_log_ts) {
@@ -457,6 +460,7 @@ int LogGroupEntryHeader::truncate(const char *buf,
       }
     }
     if (OB_SUCC(ret)) {
+      tmp_log_checksum = static_cast<int64_t>(batch_checksum.calc());
       group_size_ = cut_pos;
       max_ts_ = tmp_max_log_ts;
       update_accumulated_checksum(common::ob_crc64(pre_accum_checksum, const_cast<int64_t *>(&tmp_log_checksum),
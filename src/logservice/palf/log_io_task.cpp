@@ -445,7 +445,10 @@ BatchLogIOFlushLogTask::BatchLogIOFlushLogTask()
       log_write_buf_array_(),
       log_ts_array_(),
       lsn_array_(),
+      guard_(NULL),
+      flushed_log_end_lsn_(),
       palf_id_(INVALID_PALF_ID),
+      has_appended_(false),
       is_inited_(false)
 {}
 
@@ -457,6 +460,7 @@ BatchLogIOFlushLogTask::~BatchLogIOFlushLogTask()
 int BatchLogIOFlushLogTask::init(const int64_t batch_depth, ObIAllocator *allocator)
 {
   int ret = OB_SUCCESS;
+  void *ptr = NULL;
   io_task_array_.set_allocator(allocator);
   log_write_buf_array_.set_allocator(allocator);
   log_ts_array_.set_allocator(allocator);
@@ -472,7 +476,11 @@ int BatchLogIOFlushLogTask::init(const int64_t batch_depth, ObIAllocator *alloca
     PALF_LOG(ERROR, "log_ts_array_ init failed", K(ret));
   } else if (OB_FAIL(lsn_array_.init(batch_depth))) {
     PALF_LOG(ERROR, "lsn_array_ init failed", K(ret));
+  } else if (OB_ISNULL(ptr = mtl_malloc(sizeof(PalfHandleImplGuard), "LogIOTask"))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(ERROR, "allocate memory failed", K(ret));
   } else {
+    guard_ = new(ptr) PalfHandleImplGuard();
     is_inited_ = true;
   }
   if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
@@ -487,7 +495,12 @@ void BatchLogIOFlushLogTask::reuse()
   log_write_buf_array_.clear();
   log_ts_array_.clear();
   lsn_array_.clear();
+  if (NULL != guard_) {
+    guard_->reset();
+  }
+  flushed_log_end_lsn_.reset();
   palf_id_ = INVALID_PALF_ID;
+  has_appended_ = false;
 }
 
 void BatchLogIOFlushLogTask::destroy()
@@ -497,7 +510,14 @@ void BatchLogIOFlushLogTask::destroy()
   log_write_buf_array_.destroy();
   log_ts_array_.destroy();
   lsn_array_.destroy();
+  if (NULL != guard_) {
+    guard_->~PalfHandleImplGuard();
+    mtl_free(guard_);
+    guard_ = NULL;
+  }
+  flushed_log_end_lsn_.reset();
   palf_id_ = INVALID_PALF_ID;
+  has_appended_ = false;
 }
 
 int BatchLogIOFlushLogTask::push_back(LogIOFlushLogTask *task)
@@ -521,6 +541,18 @@ int BatchLogIOFlushLogTask::push_back(LogIOFlushLogTask *task)
 
 // Each LogIOFlusLoghTask will be free in this function.
 int BatchLogIOFlushLogTask::do_task(int tg_id, PalfEnvImpl *palf_env_impl)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(submit_task(palf_env_impl))) {
+    PALF_LOG(WARN, "submit_task failed", K(ret));
+  } else if (OB_FAIL(finish_task(tg_id, palf_env_impl))) {
+    PALF_LOG(WARN, "finish_task failed", K(ret));
+  } else {
+  }
+  return ret;
+}
+
+int BatchLogIOFlushLogTask::submit_task(PalfEnvImpl *palf_env_impl)
 {
   int ret = OB_SUCCESS;
   // 释放内存
@@ -530,14 +562,41 @@ int BatchLogIOFlushLogTask::do_task(int tg_id, PalfEnvImpl *palf_env_impl)
   } else if (INVALID_PALF_ID == palf_id_ && true == io_task_array_.empty()) {
     ret = OB_ERR_UNEXPECTED;
     PALF_LOG(ERROR, "BatchLogIOFlushLogTask is empty", K(ret), KPC(this));
-  } else if (OB_FAIL(do_task_(tg_id, palf_env_impl))) {
-    PALF_LOG(WARN, "do_task_ failed", K(ret));
+  } else if (OB_FAIL(append_log_(palf_env_impl))) {
+    PALF_LOG(WARN, "append_log_ failed", K(ret));
     clear_memory_(palf_env_impl);
+    guard_->reset();
   } else {
   }
   return ret;
 }
 
+// Any LogIOFlusLoghTask has been push into cb queue, the slot of io_task_array_ will reset to NULL,
+// any LogIOFlusLoghTask in io_task_array_ which is not NULL, will be released after finish_task.
+int BatchLogIOFlushLogTask::finish_task(int tg_id, PalfEnvImpl *palf_env_impl)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    PALF_LOG(ERROR, "LogIOFlushMetaTask not inited!!!", K(ret), KPC(this));
+  } else if (false == has_appended_) {
+    // Advance reuse lsn for group_buffer firstly, then callback asynchronous.
+  } else if (OB_FAIL(guard_->get_palf_handle_impl()->advance_reuse_lsn(flushed_log_end_lsn_))) {
+    PALF_LOG(ERROR, "advance_reuse_lsn failed", K(ret), K(flushed_log_end_lsn_));
+  } else if (OB_FAIL(push_flush_cb_to_thread_pool_(tg_id, palf_env_impl))) {
+    PALF_LOG(ERROR, "push_flush_cb_to_thread_pool_ failed", K(ret), KPC(this));
+  } else {
+  }
+  if (OB_FAIL(ret)) {
+    clear_memory_(palf_env_impl);
+  }
+  has_appended_ = false;
+  if (NULL != guard_) {
+    guard_->reset();
+  }
+  return ret;
+}
+
 int BatchLogIOFlushLogTask::push_flush_cb_to_thread_pool_(int tg_id, PalfEnvImpl *palf_env_impl)
 {
   int ret = OB_SUCCESS;
@@ -564,17 +623,13 @@ int BatchLogIOFlushLogTask::push_flush_cb_to_thread_pool_(int tg_id, PalfEnvImpl
   return ret;
 }
 
-// Any LogIOFlusLoghTask has been push into cb queue, the slot of io_task_array_ will reset to NULL,
-// any LogIOFlusLoghTask in io_task_array_ which is not NULL, will be released after do_task_.
-int BatchLogIOFlushLogTask::do_task_(int tg_id, PalfEnvImpl *palf_env_impl)
+int BatchLogIOFlushLogTask::append_log_(PalfEnvImpl *palf_env_impl)
 {
   int ret = OB_SUCCESS;
   int64_t palf_epoch = -1;
-  PalfHandleImplGuard guard;
-  LSN flushed_log_end_lsn;
-  if (OB_FAIL(palf_env_impl->get_palf_handle_impl(palf_id_, guard))) {
+  if (OB_FAIL(palf_env_impl->get_palf_handle_impl(palf_id_, *guard_))) {
     PALF_LOG(WARN, "PalfEnvImpl get_palf_handle_impl failed", K(ret), K(palf_id_));
-  } else if (OB_FAIL(guard.get_palf_handle_impl()->get_palf_epoch(palf_epoch))) {
+  } else if (OB_FAIL(guard_->get_palf_handle_impl()->get_palf_epoch(palf_epoch))) {
     PALF_LOG(WARN, "PalfEnvImpl get_palf_epoch failed", K(ret), K(palf_id_));
   } else {
     const int64_t count = io_task_array_.count();
@@ -598,18 +653,15 @@ int BatchLogIOFlushLogTask::do_task_(int tg_id, PalfEnvImpl *palf_env_impl)
                  KPC(io_task));
       } else {
         has_valid_data = true;
-        flushed_log_end_lsn = io_task->flush_log_cb_ctx_.lsn_ + io_task->write_buf_.get_total_size();
+        flushed_log_end_lsn_ = io_task->flush_log_cb_ctx_.lsn_ + io_task->write_buf_.get_total_size();
       }
     }
     if (OB_SUCC(ret) && true == has_valid_data) {
-      if (OB_FAIL(guard.get_palf_handle_impl()->inner_append_log(lsn_array_, log_write_buf_array_,
-                                                                 log_ts_array_))) {
+      if (OB_FAIL(guard_->get_palf_handle_impl()->inner_append_log(lsn_array_, log_write_buf_array_,
+                                                                   log_ts_array_))) {
         PALF_LOG(ERROR, "inner_append_log failed", K(ret), KPC(this));
-      } else if (OB_FAIL(guard.get_palf_handle_impl()->advance_reuse_lsn(flushed_log_end_lsn))) {
-        PALF_LOG(ERROR, "advance_reuse_lsn failed", K(ret), K(flushed_log_end_lsn));
-      } else if (OB_FAIL(push_flush_cb_to_thread_pool_(tg_id, palf_env_impl))) {
-        PALF_LOG(ERROR, "push_flush_cb_to_thread_pool_ failed", K(ret), KPC(this));
       } else {
+        has_appended_ = true;
       }
     }
   }
@@ -23,6 +23,7 @@ namespace oceanbase
 namespace palf
 {
 class PalfHandleImpl;
+struct PalfHandleImplGuard;
 class LogMeta;
 class PalfEnvImpl;
 
@@ -160,19 +161,30 @@ public:
   void destroy();
   int push_back(LogIOFlushLogTask *task);
   int do_task(int tg_id, PalfEnvImpl *palf_env_impl);
+  // 'do_task' is split into two phases for asynchronous write:
+  // 1. 'submit_task', append logs to LogStorage, the writes may be still in flight;
+  // 2. 'finish_task', after all writes have been completed, push callbacks into
+  //    LogIOTaskCbThreadPool.
+  // NB: the PalfHandleImpl will be held between the two phases.
+  int submit_task(PalfEnvImpl *palf_env_impl);
+  int finish_task(int tg_id, PalfEnvImpl *palf_env_impl);
   int64_t get_palf_id() const { return palf_id_; }
   int64_t get_count() const { return io_task_array_.count(); }
-  TO_STRING_KV(K_(palf_id), "count", io_task_array_.count(), K_(lsn_array));
+  TO_STRING_KV(K_(palf_id), "count", io_task_array_.count(), K_(lsn_array),
+               K_(flushed_log_end_lsn), K_(has_appended));
 private:
   int push_flush_cb_to_thread_pool_(int tg_id, PalfEnvImpl *palf_env_impl);
-  int do_task_(int tg_id, PalfEnvImpl *palf_env_impl);
+  int append_log_(PalfEnvImpl *palf_env_impl);
   void clear_memory_(PalfEnvImpl *palf_env_impl);
 private:
   BatchIOTaskArray io_task_array_;
   LogWriteBufArray log_write_buf_array_;
   LogTsArray log_ts_array_;
   LSNArray lsn_array_;
+  PalfHandleImplGuard *guard_;
+  LSN flushed_log_end_lsn_;
   int64_t palf_id_;
+  bool has_appended_;
   bool is_inited_;
 };
 } // end namespace palf
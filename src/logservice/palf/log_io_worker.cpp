@@ -16,6 +16,7 @@
 #include "lib/ob_errno.h"                     // OB_SUCCESS
 #include "lib/thread/ob_thread_name.h"        // set_thread_name
 #include "share/rc/ob_tenant_base.h"          // mtl_free
+#include "share/config/ob_server_config.h"    // GCONF
 #include "log_io_task.h"                      // LogIOTask
 #include "palf_env_impl.h"                    // PalfEnvImpl
 
@@ -44,6 +45,7 @@ int LogIOWorker::init(const LogIOWorkerConfig &config,
                       PalfEnvImpl *palf_env_impl)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   if (IS_INIT) {
     ret = OB_INIT_TWICE;
     PALF_LOG(ERROR, "LogIOWorker has been inited", K(ret));
@@ -63,6 +65,10 @@ int LogIOWorker::init(const LogIOWorkerConfig &config,
     log_io_worker_num_ = config.io_worker_num_;
     cb_thread_pool_tg_id_ = cb_thread_pool_tg_id;
     palf_env_impl_ = palf_env_impl;
+    if (0 < config.max_inflight_write_count_
+        && OB_SUCCESS != (tmp_ret = aio_writer_.init(config.max_inflight_write_count_))) {
+      PALF_LOG(WARN, "LogAIOWriter init failed, write synchronously", K(tmp_ret), K(config));
+    }
     is_inited_ = true;
     PALF_LOG(INFO, "LogIOWorker init success", K(ret), K(config), K(cb_thread_pool_tg_id),
              KPC(palf_env_impl));
@@ -83,6 +89,7 @@ void LogIOWorker::destroy()
   log_io_worker_num_ = -1;
   queue_.destroy();
   batch_io_task_mgr_.destroy();
+  aio_writer_.destroy();
   PALF_LOG(INFO, "LogIOWorker destroy success");
 }
 
@@ -196,7 +203,14 @@ int LogIOWorker::reduce_io_task_(void *task)
     }
   }
 
-  if (OB_FAIL(batch_io_task_mgr_.handle(cb_thread_pool_tg_id_, palf_env_impl_))) {
+  // NB: '_log_aio_max_inflight_count' is 0 means write synchronously.
+  const int64_t inflight_limit = GCONF._log_aio_max_inflight_count;
+  LogAIOWriter *aio_writer = NULL;
+  if (0 < inflight_limit && aio_writer_.is_inited()) {
+    aio_writer_.set_inflight_limit(inflight_limit);
+    aio_writer = &aio_writer_;
+  }
+  if (OB_FAIL(batch_io_task_mgr_.handle(cb_thread_pool_tg_id_, palf_env_impl_, aio_writer))) {
     PALF_LOG(WARN, "batch_io_task_mgr_ handle failed", K(ret), K(batch_io_task_mgr_));
   }
 
@@ -276,37 +290,81 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::insert(LogIOFlushLogTask *io_task)
   return ret;
 }
 
-int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id, PalfEnvImpl *palf_env_impl)
+int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id,
+                                                   PalfEnvImpl *palf_env_impl,
+                                                   LogAIOWriter *aio_writer)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   const int64_t count = batch_io_task_array_.count() - usable_count_;
-  // Each BatchLogIOFlushLogTask is a set LogIOFlushLogTask of one palf instance,
-  // even if execute 'do_task_' for one of LogIOFlushLogTask failed, we need
-  // execute 'do_task_' for next LogIOFlushLogTask.
-  for (int64_t i = 0; i < count; i++) {
-    BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
-    if (OB_ISNULL(io_task)) {
-      ret = OB_ERR_UNEXPECTED;
-      PALF_LOG(ERROR,
-               "BatchLogIOFlushLogTask in batch_io_task_array_ is nullptr, unexpected error!!!",
-               K(ret), KP(io_task), K(i));
-    } else if (OB_FAIL(io_task->do_task(tg_id, palf_env_impl))) {
-      PALF_LOG(WARN, "do_task failed", K(ret), KPC(io_task));
-    } else {
-      PALF_LOG(TRACE, "BatchLogIOFlushLogTaskMgr::handle success", K(ret), K(has_batched_size_),
-          KPC(io_task));
+  if (NULL != aio_writer) {
+    // The writes of different palf instances are in flight concurrently, the callbacks
+    // must not be pushed until the data has been written(max_flushed_end_lsn is advanced
+    // in callbacks).
+    {
+      LogAIOWriterGuard aio_guard(aio_writer);
+      for (int64_t i = 0; i < count; i++) {
+        BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+        if (OB_ISNULL(io_task)) {
+          ret = OB_ERR_UNEXPECTED;
+          PALF_LOG(ERROR,
+                   "BatchLogIOFlushLogTask in batch_io_task_array_ is nullptr, unexpected error!!!",
+                   K(ret), KP(io_task), K(i));
+        } else if (OB_SUCCESS != (tmp_ret = io_task->submit_task(palf_env_impl))) {
+          ret = tmp_ret;
+          PALF_LOG(WARN, "submit_task failed", K(ret), KPC(io_task));
+        } else {
+        }
+      }
+      // NB: the failed writes are rewritten synchronously until success.
+      (void)aio_writer->wait_all();
+    }
+    for (int64_t i = 0; i < count; i++) {
+      BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+      if (OB_ISNULL(io_task)) {
+      } else if (OB_SUCCESS != (tmp_ret = io_task->finish_task(tg_id, palf_env_impl))) {
+        ret = tmp_ret;
+        PALF_LOG(WARN, "finish_task failed", K(ret), KPC(io_task));
+      } else {
+        PALF_LOG(TRACE, "BatchLogIOFlushLogTaskMgr::handle success", K(ret), K(has_batched_size_),
+            KPC(io_task));
+      }
+      reuse_batch_io_task_(io_task);
     }
-    if (OB_NOT_NULL(io_task)) {
-      // 'handle_count_' and 'has_batched_size_' are used for statistics
-      handle_count_ += io_task->get_count() <= 1 ? 0 : 1;
-      has_batched_size_ += io_task->get_count() == 1 ? 0 : io_task->get_count();
-      io_task->reuse();
-      usable_count_++;
+  } else {
+    // Each BatchLogIOFlushLogTask is a set LogIOFlushLogTask of one palf instance,
+    // even if execute 'do_task_' for one of LogIOFlushLogTask failed, we need
+    // execute 'do_task_' for next LogIOFlushLogTask.
+    for (int64_t i = 0; i < count; i++) {
+      BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+      if (OB_ISNULL(io_task)) {
+        ret = OB_ERR_UNEXPECTED;
+        PALF_LOG(ERROR,
+                 "BatchLogIOFlushLogTask in batch_io_task_array_ is nullptr, unexpected error!!!",
+                 K(ret), KP(io_task), K(i));
+      } else if (OB_FAIL(io_task->do_task(tg_id, palf_env_impl))) {
+        PALF_LOG(WARN, "do_task failed", K(ret), KPC(io_task));
+      } else {
+        PALF_LOG(TRACE, "BatchLogIOFlushLogTaskMgr::handle success", K(ret), K(has_batched_size_),
+            KPC(io_task));
+      }
+      reuse_batch_io_task_(io_task);
     }
   }
   return ret;
 }
 
+void LogIOWorker::BatchLogIOFlushLogTaskMgr::reuse_batch_io_task_(BatchLogIOFlushLogTask *io_task)
+{
+  if (OB_NOT_NULL(io_task)) {
+    // 'handle_count_' and 'has_batched_size_' are used for statistics
+    handle_count_ += io_task->get_count() <= 1 ? 0 : 1;
+    has_batched_size_ += io_task->get_count() == 1 ? 0 : io_task->get_count();
+    io_task->reuse();
+    usable_count_++;
+  }
+}
+
 bool LogIOWorker::BatchLogIOFlushLogTaskMgr::empty()
 {
   return usable_count_ == batch_width_;
@@ -22,6 +22,7 @@
 #include "lib/hash/ob_array_hash_map.h"             // ObArrayHashMap
 #include "share/ob_thread_pool.h"                   // ObThreadPool
 #include "log_io_task.h"                            // LogBatchIOFlushLogTask
+#include "log_aio_writer.h"                          // LogAIOWriter
 #include "log_define.h"                             // ALF_SLIDING_WINDOW_SIZE
 namespace oceanbase
 {
@@ -46,7 +47,8 @@ struct LogIOWorkerConfig
   }
   bool is_valid() const
   {
-    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 < batch_width_ && 0 < batch_depth_;
+    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 < batch_width_ && 0 < batch_depth_
+           && 0 <= max_inflight_write_count_;
   }
   void reset()
   {
@@ -54,12 +56,16 @@ struct LogIOWorkerConfig
     io_queue_capcity_ = 0;
     batch_width_ = 0;
     batch_depth_ = 0;
+    max_inflight_write_count_ = 0;
   }
   int64_t io_worker_num_;
   int64_t io_queue_capcity_;
   int64_t batch_width_;
   int64_t batch_depth_;
-  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth));
+  // the max count of asynchronous writes in flight, 0 means write synchronously.
+  int64_t max_inflight_write_count_;
+  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth),
+               K_(max_inflight_write_count));
 };
 
 class LogIOWorker : public share::ObThreadPool
@@ -94,11 +100,14 @@ private:
     int init(int64_t batch_width, int64_t batch_depth, ObIAllocator *allocator);
     void destroy();
     int insert(LogIOFlushLogTask *io_task);
-    int handle(const int64_t tg_id, PalfEnvImpl *palf_env_impl);
+    // NB: when 'aio_writer' is not NULL, the writes of each BatchLogIOFlushLogTask are
+    // submitted firstly, and the callbacks are pushed after all writes have been completed.
+    int handle(const int64_t tg_id, PalfEnvImpl *palf_env_impl, LogAIOWriter *aio_writer);
     bool empty();
     TO_STRING_KV(K_(batch_io_task_array), K_(usable_count), K_(batch_width));
   private:
     int find_usable_batch_io_task_(const int64_t palf_id, BatchLogIOFlushLogTask *&batch_io_task);
+    void reuse_batch_io_task_(BatchLogIOFlushLogTask *io_task);
   private:
     typedef ObFixedArray<BatchLogIOFlushLogTask *, common::ObIAllocator> BatchLogIOFlushLogTaskArray;
     BatchLogIOFlushLogTaskArray batch_io_task_array_;
@@ -118,6 +127,7 @@ private:
   PalfEnvImpl *palf_env_impl_;
   ObLightyQueue queue_;
   BatchLogIOFlushLogTaskMgr batch_io_task_mgr_;
+  LogAIOWriter aio_writer_;
   bool is_inited_;
 };
 } // end namespace palf
@@ -133,6 +133,7 @@ public:
   // ================= log sync part begin
   virtual int submit_log(const char *buf,
                  const int64_t buf_len,
+                 const bool is_compressed,
                  const int64_t ref_ts_ns,
                  LSN &lsn,
                  int64_t &log_timestamp);
@@ -267,6 +268,7 @@ private:
                               const LogType &log_type,
                               const char *log_data,
                               const int64_t data_len,
+                              const bool is_compressed,
                               bool &is_need_handle);
   int append_to_group_log_(const LSN &lsn,
                            const int64_t log_id,
@@ -274,6 +276,7 @@ private:
                            const int64_t log_entry_size,
                            const char *log_data,
                            const int64_t data_len,
+                           const bool is_compressed,
                            bool &is_need_handle);
   int handle_next_submit_log_(bool &is_committed_lsn_updated);
   int handle_committed_log_();
@@ -26,6 +26,7 @@ class LogReader;
 LogStorage::LogStorage() :
     block_mgr_(),
     log_reader_(),
+    log_cache_(),
     log_tail_(),
     log_block_header_(),
     curr_block_writable_size_(0),
@@ -91,6 +92,18 @@ int LogStorage::load_manifest_for_meta_storage(block_id_t &expected_next_block_i
   return ret;
 }
 
+int LogStorage::enable_log_cache()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (OB_FAIL(log_cache_.init(palf_id_, logical_block_size_))) {
+    PALF_LOG(WARN, "LogStorageCache init failed", K(ret), KPC(this));
+  } else {
+  }
+  return ret;
+}
+
 void LogStorage::destroy()
 {
   is_inited_ = false;
@@ -98,6 +111,7 @@ void LogStorage::destroy()
   logical_block_size_ = 0;
   block_mgr_.destroy();
   log_reader_.destroy();
+  log_cache_.destroy();
   log_tail_.reset();
   log_block_header_.reset();
   curr_block_writable_size_ = 0;
@@ -139,6 +153,7 @@ int LogStorage::writev(const LSN &lsn, const LogWriteBuf &write_buf, const int64
   } else {
     curr_block_writable_size_ -= write_size;
     update_log_tail_guarded_by_lock_(write_size);
+    log_cache_.append(lsn, write_buf);
     PALF_LOG(TRACE, "LogStorage writev success", K(ret), K(log_block_header_), K(lsn),
              K(log_tail_), K(write_buf), KPC(this));
   }
@@ -325,6 +340,7 @@ int LogStorage::inner_truncate_(const LSN &lsn)
     need_append_block_header_ =
         (curr_block_writable_size_ == logical_block_size_) ? true : false;
     log_tail_ = lsn;
+    log_cache_.invalidate();
     PALF_LOG(INFO, "inner_truncate_ success", K(ret), K(lsn), KPC(this));
   }
   return ret;
@@ -383,6 +399,7 @@ int LogStorage::truncate_prefix_blocks(const LSN &lsn)
     curr_block_writable_size_ = 0;
     need_append_block_header_ = true;
     block_mgr_.reset(block_id);
+    log_cache_.invalidate();
   }
   PALF_EVENT("LogStorage truncate_prefix_blocks finihsed", palf_id_, K(ret), KPC(this),
              K(lsn), K(block_id), K(min_block_id), K(max_block_id),
@@ -726,6 +743,9 @@ int LogStorage::inner_pread_(const LSN &read_lsn,
   // Nowdays, no need to get_log_tail_guarded_by_lock_
   // const LSN &log_tail = get_log_tail_guarded_by_lock_();
   // NB: don't support read data from diffent file.
+  // NB: the epoch of log cache must be got before the data is read from disk, otherwise
+  // the data which has been truncated may be cached with the new epoch.
+  const int64_t log_cache_epoch = log_cache_.get_epoch();
   const LSN log_tail = get_log_tail_guarded_by_lock_();
   const block_id_t read_block_id = lsn_2_block(read_lsn, logical_block_size_);
   const LSN curr_block_end_lsn = LSN((read_block_id + 1) * logical_block_size_);
@@ -735,9 +755,21 @@ int LogStorage::inner_pread_(const LSN &read_lsn,
   const offset_t real_read_offset =
     read_offset == 0 && true ==  need_read_log_block_header ? 0 : get_phy_offset_(read_lsn);
 
+  // NB: the block header is not cached, and the cache must not hide the deleted blocks.
+  const bool can_read_log_cache = real_read_offset != 0
+      && real_in_read_size <= read_buf.buf_len_
+      && true == log_cache_.is_enabled()
+      && false == check_read_out_of_lower_bound_(read_block_id);
+  bool hit_log_cache = false;
+
   if (read_lsn >= log_tail) {
     ret = OB_ERR_OUT_OF_UPPER_BOUND;
     PALF_LOG(WARN, "read something out of upper bound", K(ret), K(read_lsn), K(log_tail_));
+  } else if (true == can_read_log_cache
+             && OB_SUCCESS == log_cache_.read(read_lsn, real_in_read_size, read_buf.buf_, hit_log_cache)
+             && true == hit_log_cache) {
+    out_read_size = real_in_read_size;
+    PALF_LOG(TRACE, "inner_pread hit log cache", K(ret), K(read_lsn), K(real_in_read_size), K(log_tail));
   } else if (OB_FAIL(log_reader_.pread(read_block_id,
                                        real_read_offset,
                                        real_in_read_size,
@@ -746,6 +778,9 @@ int LogStorage::inner_pread_(const LSN &read_lsn,
     PALF_LOG(
         WARN, "LogReader pread failed", K(ret), K(read_lsn), K(log_tail_), K(real_in_read_size));
   } else {
+    if (true == can_read_log_cache) {
+      log_cache_.fill(log_cache_epoch, read_lsn, read_buf.buf_, MIN(out_read_size, real_in_read_size));
+    }
     PALF_LOG(TRACE,
              "inner_pread success",
              K(ret),
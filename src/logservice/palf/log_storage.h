@@ -17,6 +17,7 @@
 #include "share/ob_errno.h"        // errno
 #include "log_block_header.h"      // LogBlockHeader
 #include "log_block_mgr.h"         // LogBlockMgr
+#include "log_cache.h"             // LogStorageCache
 #include "log_reader.h"            // LogReader
 #include "log_storage_interface.h" // ILogStorage
 #include "log_writer_utils.h"      // LogWriteBuf
@@ -58,6 +59,8 @@ public:
            LSN &lsn);
 
   int load_manifest_for_meta_storage(block_id_t &expected_next_block_id);
+  // NB: only the LogStorage of redo log need LogCache.
+  int enable_log_cache();
   void destroy();
 
   int writev(const LSNArray &lsn_array, const LogWriteBufArray &write_buf_array, const LogTsArray &log_ts_array);
@@ -144,6 +147,7 @@ private:
   // Used to perform IO tasks in the background
   LogBlockMgr block_mgr_;
   LogReader log_reader_;
+  LogStorageCache log_cache_;
   LSN log_tail_;
   LogBlockHeader log_block_header_;
   // Used to detemine whether need switch block.
@@ -145,6 +145,8 @@ int PalfEnvImpl::init(
   log_io_worker_config_.io_queue_capcity_ = 100 * 1024;
   log_io_worker_config_.batch_width_ = 8;
   log_io_worker_config_.batch_depth_ = PALF_SLIDING_WINDOW_SIZE;
+  // the count of inflight writes is limited by '_log_aio_max_inflight_count' dynamically.
+  log_io_worker_config_.max_inflight_write_count_ = LogAIOWriter::MAX_INFLIGHT_COUNT;
   if (is_inited_) {
     ret = OB_INIT_TWICE;
     PALF_LOG(ERROR, "PalfEnvImpl is inited twiced", K(ret));
@@ -175,6 +177,9 @@ int PalfEnvImpl::init(
     PALF_LOG(ERROR, "palf_handle_impl_map_ init failed", K(ret));
   } else if (OB_FAIL(log_loop_thread_.init(this))) {
     PALF_LOG(ERROR, "log_loop_thread_ init failed", K(ret));
+  } else if (OB_FAIL(compressor_pool_.init(is_valid_tenant_id(MTL_ID()) ? MTL_ID() : OB_SERVER_TENANT_ID,
+                                           LogCompressorPool::DEFAULT_COMPRESSOR_COUNT))) {
+    PALF_LOG(ERROR, "compressor_pool_ init failed", K(ret));
   } else if (OB_FAIL(
                  election_timer_.init_and_start(1, 1_ms, "ElectTimer"))) { // just one worker thread
     PALF_LOG(ERROR, "election_timer_ init failed", K(ret));
@@ -256,6 +261,7 @@ void PalfEnvImpl::destroy()
   block_gc_timer_task_.destroy();
   fetch_log_engine_.destroy();
   log_rpc_.destroy();
+  compressor_pool_.destroy();
   log_alloc_mgr_ = NULL;
   self_.reset();
   log_dir_[0] = '\0';
@@ -28,6 +28,7 @@
 #include "log_io_worker.h"
 #include "log_io_task_cb_thread_pool.h"
 #include "log_rpc.h"
+#include "log_compressor.h"
 #include "palf_options.h"
 #include "palf_handle_impl.h"
 #include "log_io_worker.h"
@@ -217,6 +218,8 @@ public:
   int get_disk_options(PalfDiskOptions &disk_options);
   int for_each(const common::ObFunction<int(const PalfHandle&)> &func);
   common::ObILogAllocator* get_log_allocator();
+  // the LogCompressors shared by all palf instances of this tenant for compressing logs.
+  LogCompressorPool &get_compressor_pool() { return compressor_pool_; }
   TO_STRING_KV(K_(self), K_(log_dir), K_(disk_options_wrapper));
   // =================== disk space management ==================
 public:
@@ -307,6 +310,7 @@ private:
   common::ObOccamTimer election_timer_;
   LogIOWorker log_io_worker_;
   BlockGCTimerTask block_gc_timer_task_;
+  LogCompressorPool compressor_pool_;
 
   PalfDiskOptionsWrapper disk_options_wrapper_;
   int64_t check_disk_print_log_interval_;
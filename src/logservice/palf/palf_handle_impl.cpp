@@ -17,12 +17,16 @@
 #include "lib/oblog/ob_log_module.h"
 #include "lib/time/ob_time_utility.h"
 #include "lib/utility/ob_print_utils.h"                   // PALF_LOG
+#include "lib/stat/ob_diagnose_info.h"                    // EVENT_ADD
+#include "lib/thread_local/ob_tsi_factory.h"              // GET_TSI
+#include "share/config/ob_server_config.h"                // GCONF
 #include "common/ob_member_list.h"                        // ObMemberList
 #include "common/ob_role.h"                               // ObRole
 #include "fetch_log_engine.h"
 #include "log_engine.h"                                // LogEngine
 #include "election/interface/election_priority.h"
 #include "palf_iterator.h"                             // Iterator
+#include "log_compressor.h"                            // LogCompressor
 #include "palf_env_impl.h"                             // PalfEnvImpl::
 
 namespace oceanbase
@@ -42,6 +46,7 @@ PalfHandleImpl::PalfHandleImpl()
     election_msg_sender_(log_engine_.log_net_service_),
     election_(),
     fetch_log_engine_(NULL),
+    fetch_log_stream_(),
     allocator_(NULL),
     palf_id_(INVALID_PALF_ID),
     self_(),
@@ -200,6 +205,7 @@ void PalfHandleImpl::destroy()
     self_.reset();
     palf_id_ = INVALID_PALF_ID;
     fetch_log_engine_ = NULL;
+    fetch_log_stream_.reset();
     allocator_ = NULL;
     election_.stop();
     log_engine_.destroy();
@@ -359,7 +365,12 @@ int PalfHandleImpl::submit_log(
     int64_t &log_timestamp)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   const int64_t curr_ts_ns = common::ObTimeUtility::current_time_ns();
+  LogCompressor *compressor = NULL;
+  const char *submit_buf = buf;
+  int64_t submit_buf_len = buf_len;
+  bool is_compressed = false;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     PALF_LOG(WARN, "PalfHandleImpl is not inited", K(ret));
@@ -368,6 +379,20 @@ int PalfHandleImpl::submit_log(
     ret = OB_INVALID_ARGUMENT;
     PALF_LOG(WARN, "invalid argument", K(ret), K_(palf_id), KP(buf), K(buf_len), K(ref_ts_ns));
   } else {
+    // compress log before holding lock, submit the original log if compression fails.
+    // NB: the compressed log is held by the LogCompressor acquired from the pool of
+    // PalfEnvImpl, it is copied into LogGroupBuffer in 'sw_.submit_log', and then the
+    // LogCompressor is released.
+    if (common::NONE_COMPRESSOR == opts.compressor_type) {
+    } else if (OB_ISNULL(compressor = palf_env_impl_->get_compressor_pool().acquire())) {
+      PALF_LOG(TRACE, "all LogCompressors are in use, submit the original log", K_(palf_id));
+    } else if (OB_SUCCESS != (tmp_ret = compressor->compress(opts.compressor_type, buf, buf_len,
+                                                             submit_buf, submit_buf_len, is_compressed))) {
+      PALF_LOG(WARN, "compress log failed, submit the original log", K(tmp_ret), K_(palf_id), K(opts));
+      submit_buf = buf;
+      submit_buf_len = buf_len;
+      is_compressed = false;
+    }
     RLockGuard guard(lock_);
     if (false == palf_env_impl_->check_disk_space_enough()) {
       ret = OB_LOG_OUTOF_DISK_SPACE;
@@ -379,7 +404,8 @@ int PalfHandleImpl::submit_log(
       PALF_LOG(WARN, "cannot submit_log", K(ret), KPC(this), KP(buf), K(buf_len), "role",
           state_mgr_.get_role(), "state", state_mgr_.get_state(), "proposal_id",
           state_mgr_.get_proposal_id(), K(opts));
-    } else if (OB_FAIL(sw_.submit_log(buf, buf_len, ref_ts_ns, lsn, log_timestamp))) {
+    } else if (OB_FAIL(sw_.submit_log(submit_buf, submit_buf_len, is_compressed, ref_ts_ns, lsn,
+                                      log_timestamp))) {
       PALF_LOG(WARN, "submit_log failed", K(ret), KPC(this), KP(buf), K(buf_len));
     } else {
       PALF_LOG(TRACE, "submit_log success", K(ret), KPC(this), K(buf_len), K(lsn), K(log_timestamp));
@@ -389,6 +415,10 @@ int PalfHandleImpl::submit_log(
       }
     }
   }
+  if (NULL != compressor) {
+    palf_env_impl_->get_compressor_pool().release(compressor);
+    compressor = NULL;
+  }
   return ret;
 }
 
@@ -2586,6 +2616,11 @@ int PalfHandleImpl::ack_log(const common::ObAddr &server,
   } else if (OB_FAIL(sw_.ack_log(server, log_end_lsn))) {
     PALF_LOG(WARN, "ack_log failed", K(ret), K(server), K(proposal_id), K(log_end_lsn));
   } else {
+    FetchLogStreamChunk chunk;
+    if (fetch_log_stream_.on_ack(server, log_end_lsn, chunk)) {
+      // the follower has acked enough logs, push the next chunk
+      (void) submit_fetch_log_stream_task_(chunk);
+    }
     PALF_LOG(TRACE, "ack_log success", K(ret), K(server), K(proposal_id), K(log_end_lsn));
   }
   return ret;
@@ -2763,9 +2798,13 @@ int PalfHandleImpl::fetch_log_from_storage(const common::ObAddr &server,
                                            const LSN &fetch_start_lsn,
                                            const int64_t fetch_log_size,
                                            const int64_t fetch_log_count,
-                                           const int64_t accepted_mode_pid)
+                                           const int64_t accepted_mode_pid,
+                                           const int64_t stream_seq)
 {
   int ret = OB_SUCCESS;
+  LSN last_lsn;
+  LSN last_end_lsn;
+  bool has_more_log = false;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
   } else if (FETCH_MODE_META == fetch_type) {
@@ -2773,11 +2812,68 @@ int PalfHandleImpl::fetch_log_from_storage(const common::ObAddr &server,
       PALF_LOG(WARN, "submit_fetch_mode_meta_resp_ failed", K(ret), K_(palf_id), K_(self),
           K(msg_proposal_id), K(accepted_mode_pid));
     }
+  } else if (0 != stream_seq && false == fetch_log_stream_.is_current(stream_seq)) {
+    // the stream has been reset by a new fetch request, drop the stale chunk
+    PALF_LOG(TRACE, "fetch log stream has been reset, skip", K_(palf_id), K_(self), K(server),
+        K(stream_seq), K(fetch_start_lsn));
   } else if (OB_FAIL(fetch_log_from_storage_(server, fetch_type, msg_proposal_id, prev_lsn,
-      fetch_start_lsn, fetch_log_size, fetch_log_count))) {
+      fetch_start_lsn, fetch_log_size, fetch_log_count, last_lsn, last_end_lsn, has_more_log))) {
     PALF_LOG(WARN, "fetch_log_from_storage_ failed", K(ret), K_(palf_id), K_(self),
         K(server), K(fetch_type), K(msg_proposal_id), K(prev_lsn), K(fetch_start_lsn),
         K(fetch_log_size), K(fetch_log_count), K(accepted_mode_pid));
+  } else if (0 != stream_seq) {
+    try_continue_fetch_log_stream_(stream_seq, last_lsn, last_end_lsn, has_more_log);
+  }
+  return ret;
+}
+
+void PalfHandleImpl::try_continue_fetch_log_stream_(const int64_t stream_seq,
+                                                    const LSN &last_lsn,
+                                                    const LSN &last_end_lsn,
+                                                    const bool has_more_log)
+{
+  int ret = OB_SUCCESS;
+  const int64_t window_size = GCONF._log_fetch_stream_window_size;
+  FetchLogStreamChunk chunk;
+  bool is_ready = false;
+  if (!has_more_log || !last_lsn.is_valid() || 0 >= window_size) {
+    // the follower has caught up with self, it will receive logs by push_log
+    fetch_log_stream_.close(stream_seq);
+  } else if (OB_FAIL(fetch_log_stream_.on_chunk_sent(stream_seq, last_lsn, last_end_lsn,
+      window_size, chunk, is_ready))) {
+    PALF_LOG(TRACE, "on_chunk_sent failed", K(ret), K_(palf_id), K_(self), K(stream_seq), K(last_end_lsn));
+  } else {
+    // 'clog fetch log stream outstanding size' / 'clog fetch log stream task count' is
+    // the average size of logs in flight
+    EVENT_ADD(CLOG_FETCH_LOG_STREAM_OUTSTANDING_SIZE, fetch_log_stream_.get_outstanding_size());
+    if (!is_ready) {
+      // the window is full, the next chunk will be pushed when receiving ack
+      EVENT_INC(CLOG_FETCH_LOG_STREAM_WAIT_ACK_COUNT);
+    } else if (OB_FAIL(submit_fetch_log_stream_task_(chunk))) {
+      PALF_LOG(WARN, "submit_fetch_log_stream_task_ failed", K(ret), K_(palf_id), K_(self), K(chunk));
+    }
+  }
+}
+
+int PalfHandleImpl::submit_fetch_log_stream_task_(const FetchLogStreamChunk &chunk)
+{
+  int ret = OB_SUCCESS;
+  FetchLogTask *task = NULL;
+  if (NULL == (task = fetch_log_engine_->alloc_fetch_log_task())) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(WARN, "alloc fetch log task failed", K(ret), K_(palf_id));
+  } else if (OB_FAIL(task->set(palf_id_, chunk.server_, FETCH_LOG_FOLLOWER, chunk.proposal_id_,
+      chunk.prev_lsn_, chunk.start_lsn_, chunk.log_size_, chunk.log_count_, chunk.accepted_mode_pid_))) {
+    PALF_LOG(WARN, "set fetch log task error", K(ret), K_(palf_id), K(chunk));
+  } else if (FALSE_IT(task->set_stream_seq(chunk.seq_))) {
+  } else if (OB_FAIL(fetch_log_engine_->submit_fetch_log_task(task))) {
+    PALF_LOG(WARN, "submit fetch log task error", K(ret), K_(palf_id), K(chunk));
+  } else {
+    EVENT_INC(CLOG_FETCH_LOG_STREAM_TASK_COUNT);
+    PALF_LOG(TRACE, "submit fetch log stream task success", K(ret), K_(palf_id), K(chunk));
+  }
+  if (OB_FAIL(ret) && NULL != task) {
+    fetch_log_engine_->free_fetch_log_task(task);
   }
   return ret;
 }
@@ -2811,10 +2907,16 @@ int PalfHandleImpl::fetch_log_from_storage_(const common::ObAddr &server,
                                             const LSN &prev_lsn,
                                             const LSN &fetch_start_lsn,
                                             const int64_t fetch_log_size,
-                                            const int64_t fetch_log_count)
+                                            const int64_t fetch_log_count,
+                                            LSN &last_lsn,
+                                            LSN &last_end_lsn,
+                                            bool &has_more_log)
 {
   int ret = OB_SUCCESS;
   PalfGroupBufferIterator iterator;
+  last_lsn.reset();
+  last_end_lsn.reset();
+  has_more_log = false;
   const LSN fetch_end_lsn = fetch_start_lsn + fetch_log_size;
   const bool need_check_prev_log = (prev_lsn.is_valid() && PALF_INITIAL_LSN_VAL < fetch_start_lsn.val_);
   LSN max_flushed_end_lsn;
@@ -2869,6 +2971,7 @@ int PalfHandleImpl::fetch_log_from_storage_(const common::ObAddr &server,
     LSN curr_log_end_lsn = curr_lsn + curr_group_entry.get_group_entry_size();
     LSN prev_log_end_lsn;
     int64_t prev_log_proposal_id = prev_log_info.log_proposal_id_;
+    int64_t fetched_size = 0;
     while (OB_SUCC(ret) && !is_reach_size_limit && !is_reach_count_limit && !is_reach_end
         && OB_SUCC(iterator.next())) {
       if (OB_FAIL(iterator.get_entry(curr_group_entry, curr_lsn))) {
@@ -2887,6 +2990,7 @@ int PalfHandleImpl::fetch_log_from_storage_(const common::ObAddr &server,
             K(msg_proposal_id), K(each_round_prev_lsn), K(fetch_start_lsn));
       } else {
         fetched_count++;
+        fetched_size += curr_group_entry.get_group_entry_size();
         if (fetched_count >= fetch_log_count) {
           is_reach_count_limit = true;
         }
@@ -2906,8 +3010,12 @@ int PalfHandleImpl::fetch_log_from_storage_(const common::ObAddr &server,
     if (OB_ITER_END == ret) {
       ret = OB_SUCCESS;
     }
+    EVENT_ADD(CLOG_FETCH_LOG_SIZE, fetched_size);
     // try send committed_info to server
     if (OB_SUCC(ret)) {
+      last_lsn = each_round_prev_lsn;
+      last_end_lsn = prev_log_end_lsn;
+      has_more_log = (fetched_count > 0 && !is_reach_end && (is_reach_size_limit || is_reach_count_limit));
       RLockGuard guard(lock_);
       (void) try_send_committed_info_(server, each_round_prev_lsn, prev_log_end_lsn, prev_log_proposal_id);
     }
@@ -3016,6 +3124,11 @@ int PalfHandleImpl::get_log(const common::ObAddr &server,
                                  prev_lsn, start_lsn, fetch_log_size, fetch_log_count, accepted_mode_pid))) {
       PALF_LOG(WARN, "set fetch log task error", K(ret), K_(palf_id),
                K(msg_proposal_id), K(prev_lsn), K(start_lsn), K(fetch_log_size), K(fetch_log_count), K(accepted_mode_pid));
+    } else if (FETCH_LOG_FOLLOWER == fetch_type
+               && state_mgr_.is_leader_active()
+               && 0 < GCONF._log_fetch_stream_window_size
+               && FALSE_IT(task->set_stream_seq(fetch_log_stream_.open(server, msg_proposal_id, accepted_mode_pid)))) {
+      // the logs after this request will be pushed streamingly, it resets the previous stream of server
     } else if (OB_FAIL(fetch_log_engine_->submit_fetch_log_task(task))) {
       PALF_LOG(WARN, "submit fetch log task error", K(ret), K_(palf_id), K(server),
                K(prev_lsn), K(start_lsn), K(fetch_log_size), K(fetch_log_count), K(accepted_mode_pid));
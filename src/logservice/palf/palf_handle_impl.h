@@ -25,6 +25,7 @@
 #include "election/algorithm/election_impl.h"
 #include "palf_callback_wrapper.h"
 #include "log_engine.h"                      // LogEngine
+#include "fetch_log_engine.h"                // FetchLogStream
 #include "log_meta.h"
 #include "lsn.h"
 #include "log_config_mgr.h"
@@ -504,7 +505,8 @@ public:
                                      const LSN &log_offset,
                                      const int64_t fetch_log_size,
                                      const int64_t fetch_log_count,
-                                     const int64_t accepted_mode_pid) = 0;
+                                     const int64_t accepted_mode_pid,
+                                     const int64_t stream_seq) = 0;
   virtual int receive_config_log(const common::ObAddr &server,
                                  const int64_t &msg_proposal_id,
                                  const int64_t &prev_log_proposal_id,
@@ -807,7 +809,8 @@ public:
                              const LSN &fetch_start_lsn,
                              const int64_t fetch_log_size,
                              const int64_t fetch_log_count,
-                             const int64_t accepted_mode_pid);
+                             const int64_t accepted_mode_pid,
+                             const int64_t stream_seq);
   int receive_config_log(const common::ObAddr &server,
                          const int64_t &msg_proposal_id,
                          const int64_t &prev_log_proposal_id,
@@ -878,7 +881,15 @@ private:
                               const LSN &prev_lsn,
                               const LSN &fetch_start_lsn,
                               const int64_t fetch_log_size,
-                              const int64_t fetch_log_count);
+                              const int64_t fetch_log_count,
+                              LSN &last_lsn,
+                              LSN &last_end_lsn,
+                              bool &has_more_log);
+  void try_continue_fetch_log_stream_(const int64_t stream_seq,
+                                      const LSN &last_lsn,
+                                      const LSN &last_end_lsn,
+                                      const bool has_more_log);
+  int submit_fetch_log_stream_task_(const FetchLogStreamChunk &chunk);
   int submit_fetch_log_resp_(const common::ObAddr &server,
                              const int64_t &msg_proposal_id,
                              const int64_t &prev_log_proposal_id,
@@ -985,6 +996,8 @@ private:
   ElectionMsgSender election_msg_sender_;
   election::ElectionImpl election_;
   FetchLogEngine *fetch_log_engine_;
+  // push logs to the lagging follower streamingly
+  FetchLogStream fetch_log_stream_;
   common::ObILogAllocator *allocator_;
   int64_t palf_id_;
   common::ObAddr self_;
@@ -24,10 +24,18 @@ PalfHandleImplGuard::PalfHandleImplGuard() : palf_id_(),
 }
 
 PalfHandleImplGuard::~PalfHandleImplGuard()
+{
+  reset();
+}
+
+void PalfHandleImplGuard::reset()
 {
   if (NULL != palf_handle_impl_ && NULL != palf_handle_impl_map_) {
     palf_handle_impl_map_->revert(palf_handle_impl_);
   }
+  palf_id_ = INVALID_PALF_ID;
+  palf_handle_impl_ = NULL;
+  palf_handle_impl_map_ = NULL;
 }
 
 int PalfHandleImplGuard::set_palf_handle_impl(const int64_t palf_id,
@@ -31,6 +31,7 @@ struct PalfHandleImplGuard
                       PalfHandleImpl *palf_handle_impl,
                       PalfHandleImplMap *palf_handle_impl_map);
   bool is_valid() const;
+  void reset();
   IPalfHandleImpl *get_palf_handle_impl() const { return static_cast<IPalfHandleImpl*>(palf_handle_impl_); }
   TO_STRING_KV(K_(palf_id), KP_(palf_handle_impl), KP_(palf_handle_impl_map));
 
@@ -14,6 +14,7 @@
 #define OCEANBASE_LOGSERVICE_PALF_ITERATOR_
 #include "log_iterator_impl.h"           // LogIteratorImpl
 #include "log_iterator_storage.h"        // LogIteratorStorage
+#include "log_compressor.h"              // LogCompressor
 namespace oceanbase
 {
 namespace palf
@@ -22,7 +23,7 @@ template <class PalfIteratorStorage, class LogEntryType>
 class PalfIterator
 {
 public:
-  PalfIterator() : iterator_storage_(), iterator_impl_(), is_inited_(false) {}
+  PalfIterator() : iterator_storage_(), iterator_impl_(), compressor_(), is_inited_(false) {}
   ~PalfIterator() {destroy();}
   int init(const LSN &start_offset,
            ILogStorage *log_storage,
@@ -59,6 +60,7 @@ public:
       is_inited_ = false;
       iterator_impl_.destroy();
       iterator_storage_.destroy();
+      compressor_.destroy();
     }
   }
   int next()
@@ -73,6 +75,8 @@ public:
     }
     return ret;
   }
+  // NB: the payload of LogEntry may be compressed, use LogCompressor::get_data to get the
+  //     original payload, or use the interfaces which return 'buffer' below.
   int get_entry(LogEntryType &entry, LSN &lsn)
   {
     int ret = OB_SUCCESS;
@@ -87,6 +91,7 @@ public:
     }
     return ret;
   }
+  // the returned 'buffer' is decompressed if needed, it is valid until next call.
   int get_entry(const char *&buffer, int64_t &nbytes, int64_t &ts, LSN &lsn, bool &is_raw_write)
   {
     int ret = OB_SUCCESS;
@@ -96,9 +101,9 @@ public:
       ret = OB_NOT_INIT;
     } else if (OB_FAIL(iterator_impl_.get_entry(entry, lsn, is_raw_write)) && OB_ITER_END != ret) {
       PALF_LOG(WARN, "PalfIterator get_entry failed", K(ret), K(entry), K(lsn), KPC(this));
+    } else if (OB_SUCCESS == ret && OB_FAIL(compressor_.get_data(entry, buffer, nbytes))) {
+      PALF_LOG(WARN, "PalfIterator get_data failed", K(ret), K(entry), K(lsn), KPC(this));
     } else {
-      buffer = entry.get_data_buf();
-      nbytes = entry.get_data_len();
       ts = entry.get_log_ts();
       PALF_LOG(TRACE, "PalfIterator get_entry success", K(iterator_impl_), K(ret), KPC(this), K(entry), K(is_raw_write));
     }
@@ -114,9 +119,9 @@ public:
       ret = OB_NOT_INIT;
     } else if (OB_FAIL(iterator_impl_.get_entry(entry, lsn, unused_is_raw_write)) && OB_ITER_END != ret) {
       PALF_LOG(WARN, "PalfIterator get_entry failed", K(ret), K(entry), K(lsn), KPC(this));
+    } else if (OB_SUCCESS == ret && OB_FAIL(compressor_.get_data(entry, buffer, nbytes))) {
+      PALF_LOG(WARN, "PalfIterator get_data failed", K(ret), K(entry), K(lsn), KPC(this));
     } else {
-      buffer = entry.get_data_buf();
-      nbytes = entry.get_data_len();
       ts = entry.get_log_ts();
       PALF_LOG(TRACE, "PalfIterator get_entry success", K(iterator_impl_), K(ret), KPC(this), K(entry));
     }
@@ -142,6 +147,8 @@ public:
 private:
   PalfIteratorStorage iterator_storage_;
   LogIteratorImpl<LogEntryType> iterator_impl_;
+  // used to decompress the payload of LogEntry.
+  LogCompressor compressor_;
   bool is_inited_;
 };
 
@@ -13,6 +13,7 @@
 #ifndef OCEANBASE_LOGSERVICE_PALF_OPTIONS_
 #define OCEANBASE_LOGSERVICE_PALF_OPTIONS_
 #include "share/ob_partition_modify.h"
+#include "lib/compress/ob_compress_util.h"
 #include <stdint.h>
 namespace oceanbase
 {
@@ -71,7 +72,10 @@ struct PalfAppendOptions
     bool need_nonblock = true;
     bool need_check_proposal_id = true;
     int64_t proposal_id = 0;
-    TO_STRING_KV(K(need_nonblock), K(need_check_proposal_id), K(proposal_id));
+    // 日志在提交到滑动窗口之前使用该压缩算法压缩, 压缩后的日志会被复制、归档以及被CDC拉取,
+    // 读取时由迭代器透明解压; NONE_COMPRESSOR表示不压缩
+    common::ObCompressorType compressor_type = common::NONE_COMPRESSOR;
+    TO_STRING_KV(K(need_nonblock), K(need_check_proposal_id), K(proposal_id), K(compressor_type));
 };
 
 // Palf支持在三种模式中来回切换
@@ -657,6 +657,24 @@ int ObLogReplayService::stat_for_each(const common::ObFunction<int (const ObRepl
   return replay_status_map_.for_each(stat_func);
 }
 
+int ObLogReplayService::stat_lag_for_each(const common::ObFunction<int (const LSReplayLagStat &)> &func)
+{
+  auto stat_func = [&func](const ObLSID &id, ObReplayStatus *replay_status) -> bool {
+    int ret = OB_SUCCESS;
+    bool bret = true;
+    LSReplayLagStat stat;
+    if (OB_FAIL(replay_status->stat_lag(stat))) {
+      // skip this log stream
+      CLOG_LOG(WARN, "stat replay lag failed", K(ret), K(id));
+    } else if (OB_FAIL(func(stat))) {
+      bret = false;
+      CLOG_LOG(WARN, "iter replay lag stat failed", K(ret), K(stat));
+    }
+    return bret;
+  };
+  return replay_status_map_.for_each(stat_func);
+}
+
 int ObLogReplayService::stat_all_ls_replay_process(int64_t &replayed_log_size,
                                                    int64_t &unreplayed_log_size)
 {
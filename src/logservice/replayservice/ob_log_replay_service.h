@@ -136,6 +136,7 @@ public:
   int submit_task(ObReplayServiceTask *task);
   int update_replayable_point(const int64_t replayable_ts_ns);
   int stat_for_each(const common::ObFunction<int (const ObReplayStatus &)> &func);
+  int stat_lag_for_each(const common::ObFunction<int (const LSReplayLagStat &)> &func);
   int stat_all_ls_replay_process(int64_t &replayed_log_size, int64_t &unreplayed_log_size);
   void inc_pending_task_size(const int64_t log_size);
   void dec_pending_task_size(const int64_t log_size);
@@ -1253,5 +1253,39 @@ int ObReplayStatus::stat(LSReplayStat &stat) const
   return ret;
 }
 
+int ObReplayStatus::stat_lag(LSReplayLagStat &stat)
+{
+  int ret = OB_SUCCESS;
+  do {
+    RLockGuard rlock_guard(rwlock_);
+    if (IS_NOT_INIT) {
+      ret = OB_NOT_INIT;
+    } else {
+      stat.ls_id_ = ls_id_.id();
+      stat.role_ = role_;
+      stat.enabled_ = is_enabled_;
+      stat.pending_cnt_ = pending_task_count_;
+      stat.min_unreplayed_log_ts_ns_ = OB_INVALID_TIMESTAMP;
+      if (OB_FAIL(submit_log_task_.get_committed_end_lsn(stat.end_lsn_))) {
+        CLOG_LOG(WARN, "get_committed_end_lsn failed", KPC(this), K(ret));
+      } else {
+        stat.min_unreplayed_lsn_ = stat.end_lsn_;
+      }
+    }
+  } while (0);
+  // get_min_unreplayed_log_info holds rdlock inside
+  if (OB_SUCC(ret) && stat.enabled_
+      && OB_FAIL(get_min_unreplayed_log_info(stat.min_unreplayed_lsn_,
+                                             stat.min_unreplayed_log_ts_ns_))) {
+    if (OB_STATE_NOT_MATCH == ret) {
+      // disabled concurrently
+      ret = OB_SUCCESS;
+    } else {
+      CLOG_LOG(WARN, "get_min_unreplayed_log_info failed", KPC(this), K(ret));
+    }
+  }
+  return ret;
+}
+
 } // namespace logservice
 }
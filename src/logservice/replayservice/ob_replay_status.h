@@ -75,6 +75,26 @@ struct LSReplayStat
                K(pending_cnt_));
 };
 
+//回放延迟虚拟表统计
+struct LSReplayLagStat
+{
+  int64_t ls_id_;
+  common::ObRole role_;
+  bool enabled_;
+  palf::LSN end_lsn_;
+  palf::LSN min_unreplayed_lsn_;
+  int64_t min_unreplayed_log_ts_ns_;
+  int64_t pending_cnt_;
+
+  TO_STRING_KV(K(ls_id_),
+               K(role_),
+               K(enabled_),
+               K(end_lsn_),
+               K(min_unreplayed_lsn_),
+               K(min_unreplayed_log_ts_ns_),
+               K(pending_cnt_));
+};
+
 //此类型为前向barrier日志专用, 与ObLogReplayTask分开分配
 //因此此结构的内存需要单独释放
 struct ObLogReplayBuffer
@@ -508,6 +528,7 @@ public:
   void set_post_barrier_submitted(const palf::LSN &lsn);
   int set_post_barrier_finished(const palf::LSN &lsn);
   int stat(LSReplayStat &stat) const;
+  int stat_lag(LSReplayLagStat &stat);
 
   inline void inc_ref()
   {
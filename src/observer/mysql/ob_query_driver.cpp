@@ -138,7 +138,18 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
       LOG_WARN("fields is null", K(ret), KP(fields));
     }
   }
-  while (OB_SUCC(ret) && row_num < limit_count && !OB_FAIL(result.get_next_row(result_row)) ) {
+  // encode datums of output exprs to packet directly if all columns are supported,
+  // encoders are resolved once for the statement.
+  bool use_datum_row = false;
+  ObSMDatumCellEncoder *encoders = NULL;
+  const ObDatum **datums = NULL;
+  if (OB_SUCC(ret) && !is_packed
+      && OB_FAIL(resolve_datum_encoders(result, encoders, use_datum_row))) {
+    LOG_WARN("fail to resolve datum encoders", K(ret));
+  }
+  while (OB_SUCC(ret) && row_num < limit_count
+         && !OB_FAIL(use_datum_row ? result.get_next_datum_row(datums)
+                                   : result.get_next_row(result_row))) {
     ObNewRow *row = const_cast<ObNewRow*>(result_row);
     if (is_prexecute_ && row_num == limit_count - 1) {
       LOG_DEBUG("is_prexecute_ and row_num is equal with limit_count", K(limit_count));
@@ -152,7 +163,7 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
         LOG_WARN("fail to response query header", K(ret), K(row_num), K(can_retry));
       }
     }
-    for (int64_t i = 0; OB_SUCC(ret) && i < row->get_count(); i++) {
+    for (int64_t i = 0; OB_SUCC(ret) && !use_datum_row && i < row->get_count(); i++) {
       ObObj& value = row->get_cell(i);
       if (result.is_ps_protocol() && !is_packed) {
         if (value.get_type() != fields->at(i).type_.get_type()) {
@@ -182,7 +193,16 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
         }
       }
     }
-    if (OB_SUCC(ret)) {
+    if (OB_FAIL(ret)) {
+    } else if (use_datum_row) {
+      ObSMDatumRow sm(protocol_type, datums, encoders, fields->count());
+      OMPKRow rp(sm);
+      if (OB_FAIL(sender_.response_packet(rp, &result.get_session()))) {
+        LOG_WARN("response packet fail", K(ret), K(row_num), K(can_retry));
+      } else {
+        ++row_num;
+      }
+    } else {
       const ObDataTypeCastParams dtc_params = ObBasicSessionInfo::create_dtc_params(&session_);
       ObSMRow sm(protocol_type, *row, dtc_params,
                          result.get_field_columns(),
@@ -224,6 +244,49 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
   return ret;
 }
 
+int ObQueryDriver::resolve_datum_encoders(ObResultSet &result,
+                                          ObSMDatumCellEncoder *&encoders,
+                                          bool &use_datum_row)
+{
+  int ret = OB_SUCCESS;
+  use_datum_row = false;
+  encoders = NULL;
+  ObCharsetType result_charset = CHARSET_INVALID;
+  const ObExprPtrIArray *exprs = result.get_output_exprs();
+  const ColumnsFieldIArray *fields = result.get_field_columns();
+  if (!lib::is_mysql_mode() || OB_ISNULL(exprs) || OB_ISNULL(fields)
+      || exprs->count() != fields->count() || 0 == exprs->count()) {
+    // lob and oracle types are encoded by ObSMRow
+  } else if (OB_FAIL(session_.get_character_set_results(result_charset))) {
+    LOG_WARN("fail to get result charset", K(ret));
+  } else if (OB_ISNULL(encoders = static_cast<ObSMDatumCellEncoder *>(
+              result.get_mem_pool().alloc(sizeof(ObSMDatumCellEncoder) * exprs->count())))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(exprs->count()));
+  } else {
+    use_datum_row = true;
+    for (int64_t i = 0; OB_SUCC(ret) && use_datum_row && i < exprs->count(); i++) {
+      const ObExpr *expr = exprs->at(i);
+      if (OB_ISNULL(expr)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("output expr is null", K(ret), K(i));
+      } else if (OB_FAIL(ObSMDatumRow::resolve_encoder(expr->obj_meta_,
+                                                       fields->at(i),
+                                                       result_charset,
+                                                       encoders[i],
+                                                       use_datum_row))) {
+        LOG_WARN("fail to resolve datum encoder", K(ret), K(i));
+      }
+    }
+  }
+  if (OB_FAIL(ret) || !use_datum_row) {
+    use_datum_row = false;
+    encoders = NULL;
+  }
+  LOG_DEBUG("resolve datum encoders", K(ret), K(use_datum_row));
+  return ret;
+}
+
 int ObQueryDriver::convert_field_charset(ObIAllocator& allocator,
                                          const ObCollationType& from_collation,
                                          const ObCollationType& dest_collation,
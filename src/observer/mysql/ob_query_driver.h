@@ -20,6 +20,11 @@
 namespace oceanbase
 {
 
+namespace common
+{
+struct ObSMDatumCellEncoder;
+}
+
 namespace sql
 {
 struct ObSqlCtx;
@@ -84,6 +89,9 @@ public:
                                        common::ObIAllocator &allocator);
 
 private:
+  int resolve_datum_encoders(sql::ObResultSet &result,
+                             common::ObSMDatumCellEncoder *&encoders,
+                             bool &use_datum_row);
   int convert_field_charset(common::ObIAllocator& allocator,
       const common::ObCollationType& from_collation,
       const common::ObCollationType& dest_collation,
@@ -63,7 +63,9 @@ ObMPStmtFetch::ObMPStmtFetch(const ObGlobalContext &gctx)
       offset_type_(OB_OCI_DEFAULT),
       offset_(0),
       extend_flag_(0),
-      column_flag_(NULL)
+      column_flag_(NULL),
+      need_close_cursor_(false),
+      need_prefetch_(false)
 {
 }
 int ObMPStmtFetch::before_process()
@@ -388,7 +390,7 @@ int ObMPStmtFetch::response_result(pl::ObPLCursorInfo &cursor,
                 ret = OB_ERR_UNEXPECTED;
                 LOG_WARN("get unexpect streaming result set.", K(ret), K(cursor.get_id()));
               }
-              if (OB_OCI_DEFAULT != offset_type_ || OB_OCI_FETCH_NEXT != offset_type_) {
+              if (!is_streaming_offset_type(offset_type_)) {
                 ret = OB_ERR_UNEXPECTED;
                 LOG_WARN("streaming result set not support this offset type.", K(ret), 
                                                                                K(cursor.get_id()), 
@@ -498,10 +500,10 @@ int ObMPStmtFetch::response_result(pl::ObPLCursorInfo &cursor,
           }
           ObPLExecCtx pl_ctx(cursor.get_allocator(), exec_ctx, &params,
                             NULL/*result*/, &ret, NULL/*func*/, true);
+          common::ObNewRow *fetched_row = NULL;
           while (OB_SUCC(ret) && need_fetch && row_num < fetch_limit
-                  && OB_SUCC(sql::ObSPIService::dbms_cursor_fetch(&pl_ctx,
-                                                  static_cast<pl::ObDbmsCursorInfo&>(cursor)))) {
-            common::ObNewRow &row = cursor.get_current_row();
+                  && OB_SUCC(fetch_cursor_row(pl_ctx, cursor, fetched_row))) {
+            common::ObNewRow &row = *fetched_row;
 #ifndef NDEBUG
             LOG_INFO("cursor fetch: ", K(cursor.get_id()),
                                        K(cursor.is_streaming()),
@@ -537,6 +539,11 @@ int ObMPStmtFetch::response_result(pl::ObPLCursorInfo &cursor,
               last_row = true;
             }
           }
+          if (OB_SUCC(ret) && !last_row && cursor.is_streaming() && fetch_limit > 0
+              && INT64_MAX != fetch_limit && GCONF._enable_ps_cursor_prefetch) {
+            // 结果发送给客户端之后，预取下一批
+            need_prefetch_ = true;
+          }
         }
       }
       if (OB_FAIL(ret)) {
@@ -780,11 +787,85 @@ int ObMPStmtFetch::process()
     flush_ret = flush_buffer(true);
   }
   if (sess != NULL) {
+    if (OB_SUCC(ret) && OB_SUCCESS == flush_ret && need_prefetch_) {
+      int tmp_ret = prefetch_cursor(*sess);
+      if (OB_SUCCESS != tmp_ret) {
+        LOG_WARN("prefetch cursor failed", K(tmp_ret), K_(cursor_id));
+      }
+    }
     revert_session(sess); //current ignore revert session ret
   }
   return (OB_SUCCESS != ret) ? ret : flush_ret;
 }
 
+// 先返回预取的行，预取的行读完之后继续从cursor读
+int ObMPStmtFetch::fetch_cursor_row(ObPLExecCtx &pl_ctx,
+                                    ObPLCursorInfo &cursor,
+                                    common::ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+  ObSPIPrefetchBuffer *buffer = cursor.get_prefetch_buffer();
+  const common::ObNewRow *buffered_row = NULL;
+  row = NULL;
+  if (OB_ISNULL(buffer) || buffer->need_fetch_cursor()) {
+    if (OB_SUCC(sql::ObSPIService::dbms_cursor_fetch(&pl_ctx,
+                                                     static_cast<pl::ObDbmsCursorInfo&>(cursor)))) {
+      row = &cursor.get_current_row();
+    }
+  } else if (OB_SUCC(buffer->get_next_row(cursor, buffered_row))) {
+    row = const_cast<common::ObNewRow*>(buffered_row);
+  }
+  return ret;
+}
+
+/* 流式cursor在回包之后预取下一批行(行数与本次fetch相同)，使下一次fetch不用等待执行。
+ * 预取持有session的query lock, 如果下一次fetch已经开始处理则放弃预取；
+ * 下一次fetch在预取完成前到达会等待query lock。
+ * 行数由本次fetch的大小限制，内存由_chunk_row_store_mem_limit限制，超出后落盘。
+ */
+int ObMPStmtFetch::prefetch_cursor(ObSQLSessionInfo &session)
+{
+  int ret = OB_SUCCESS;
+  ObPLCursorInfo *cursor = NULL;
+  ObSPIPrefetchBuffer *buffer = NULL;
+  if (OB_SUCCESS != session.try_lock_query()) {
+    // next request is being processed
+  } else {
+    if (OB_ISNULL(cursor = session.get_cursor(cursor_id_))
+        || !cursor->isopen()
+        || !cursor->is_streaming()
+        || OB_ISNULL(cursor->get_cursor_entity())
+        || OB_ISNULL(cursor->get_cursor_handler())
+        || OB_ISNULL(cursor->get_cursor_handler()->get_result_set())) {
+      // cursor has been closed
+    } else if (OB_FAIL(cursor->prepare_prefetch_buffer(buffer,
+                                                       session.get_effective_tenant_id()))) {
+      LOG_WARN("prepare prefetch buffer failed", K(ret), K_(cursor_id));
+    } else if (!buffer->need_fetch_cursor()) {
+      // rows prefetched last time are not consumed
+    } else {
+      buffer->reuse();
+      WITH_CONTEXT(cursor->get_cursor_entity()) {
+        lib::ContextTLOptGuard guard(false);
+        ParamStore params;
+        ObExecContext *exec_ctx = &cursor->get_cursor_handler()->get_result_set()->get_exec_context();
+        ObPLExecCtx pl_ctx(cursor->get_allocator(), exec_ctx, &params,
+                           NULL/*result*/, &ret, NULL/*func*/, true);
+        auto fetch_func = [&]() -> int {
+          return sql::ObSPIService::dbms_cursor_fetch(&pl_ctx, static_cast<pl::ObDbmsCursorInfo&>(*cursor));
+        };
+        if (OB_FAIL(buffer->prefetch(*cursor, fetch_rows_, fetch_func))) {
+          LOG_WARN("prefetch rows failed", K(ret), K_(cursor_id));
+        }
+        LOG_DEBUG("prefetch cursor", K(ret), K_(cursor_id), K(buffer->row_store_.get_row_cnt()),
+                  K(buffer->end_ret_));
+      }
+    }
+    session.unlock_query();
+  }
+  return ret;
+}
+
 void ObMPStmtFetch::record_stat(const stmt::StmtType type, const int64_t end_time) const
 {
   UNUSED(type);
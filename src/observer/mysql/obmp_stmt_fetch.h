@@ -53,6 +53,11 @@ public:
   {
     return ObMPBase::flush_buffer(is_last);
   }
+  // 流式结果集只能前滚
+  static inline bool is_streaming_offset_type(const int64_t offset_type)
+  {
+    return OB_OCI_DEFAULT == offset_type || OB_OCI_FETCH_NEXT == offset_type;
+  }
   inline bool has_ok_packet() { return extend_flag_ & OB_OCI_NEED_EXTRA_OK_PACKET; }
   inline bool has_long_data() { return extend_flag_ & OB_OCI_GET_PIECE_INFO; }
   int response_row(sql::ObSQLSessionInfo &session, 
@@ -83,6 +88,10 @@ private:
                       int64_t fetch_limit,
                       int64_t &row_num);
   int response_query_header(sql::ObSQLSessionInfo &session, const ColumnsFieldArray *fields);
+  int fetch_cursor_row(pl::ObPLExecCtx &pl_ctx,
+                       pl::ObPLCursorInfo &cursor,
+                       common::ObNewRow *&row);
+  int prefetch_cursor(sql::ObSQLSessionInfo &session);
   virtual int before_process();
   void record_stat(const sql::stmt::StmtType type, const int64_t end_time) const;
   //重载response，在response中不去调用flush_buffer(true)；flush_buffer(true)在需要回包时显示调用
@@ -97,6 +106,7 @@ private:
   int32_t extend_flag_;
   char    *column_flag_;
   bool    need_close_cursor_;
+  bool    need_prefetch_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMPStmtFetch);
 }; //end of class
@@ -71,3 +71,86 @@ int ObSMRow::encode_cell(
 
   return ret;
 }
+
+int ObSMDatumRow::resolve_encoder(const ObObjMeta &meta,
+                                  const ObField &field,
+                                  const ObCharsetType result_charset,
+                                  ObSMDatumCellEncoder &encoder,
+                                  bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  is_supported = false;
+  encoder.obj_type_ = meta.get_type();
+  if (meta.get_type() != field.type_.get_type()) {
+    // need cast to field type in binary protocol
+  } else if (field.flags_ & ZEROFILL_FLAG) {
+    // zerofill depends on field length
+  } else {
+    switch (meta.get_type_class()) {
+      case ObNullTC:
+        encoder.encode_type_ = ObSMDatumCellEncoder::ENCODE_NULL;
+        is_supported = true;
+        break;
+      case ObIntTC:
+        encoder.encode_type_ = ObSMDatumCellEncoder::ENCODE_INT;
+        is_supported = true;
+        break;
+      case ObUIntTC:
+        encoder.encode_type_ = ObSMDatumCellEncoder::ENCODE_UINT;
+        is_supported = true;
+        break;
+      case ObStringTC: {
+        // same as ObQueryDriver::convert_string_value_charset, no convert needed if
+        // charset of value is the same as character_set_results
+        const ObCollationType cs_type = meta.get_collation_type();
+        if (CS_TYPE_INVALID == cs_type
+            || CS_TYPE_BINARY == cs_type
+            || !ObCharset::is_valid_charset(result_charset)
+            || CHARSET_BINARY == result_charset
+            || ObCharset::charset_type_by_coll(cs_type) == result_charset) {
+          encoder.encode_type_ = ObSMDatumCellEncoder::ENCODE_STRING;
+          is_supported = true;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return ret;
+}
+
+int ObSMDatumRow::encode_cell(
+    int64_t idx, char *buf,
+    int64_t len, int64_t &pos, char *bitmap) const
+{
+  int ret = OB_SUCCESS;
+  if (idx >= cell_cnt_ || idx < 0) {
+    ret = OB_INVALID_ARGUMENT;
+  } else {
+    const ObDatum &datum = *datums_[idx];
+    const ObSMDatumCellEncoder &encoder = encoders_[idx];
+    if (datum.is_null() || ObSMDatumCellEncoder::ENCODE_NULL == encoder.encode_type_) {
+      ret = ObMySQLUtil::null_cell_str(buf, len, type_, pos, idx, bitmap);
+    } else {
+      switch (encoder.encode_type_) {
+        case ObSMDatumCellEncoder::ENCODE_INT:
+          ret = ObMySQLUtil::int_cell_str(buf, len, datum.get_int(), encoder.obj_type_,
+                                          false, type_, pos, false, 0);
+          break;
+        case ObSMDatumCellEncoder::ENCODE_UINT:
+          ret = ObMySQLUtil::int_cell_str(buf, len, datum.get_int(), encoder.obj_type_,
+                                          true, type_, pos, false, 0);
+          break;
+        case ObSMDatumCellEncoder::ENCODE_STRING:
+          ret = ObMySQLUtil::varchar_cell_str(buf, len, datum.get_string(), false, pos);
+          break;
+        default:
+          ret = OB_ERR_UNEXPECTED;
+          SQL_ENG_LOG(WARN, "unexpected encode type", K(ret), K(idx), K(encoder));
+          break;
+      }
+    }
+  }
+  return ret;
+}
@@ -17,6 +17,7 @@
 #include "rpc/obmysql/ob_mysql_row.h"
 #include "common/row/ob_row.h"
 #include "common/ob_field.h"
+#include "share/datum/ob_datum.h"
 
 namespace oceanbase
 {
@@ -66,6 +67,64 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObSMRow);
 }; // end of class OBMP
 
+// Encoder of one result column, resolved once per statement by ObSMDatumRow::resolve_encoder.
+struct ObSMDatumCellEncoder
+{
+  enum EncodeType
+  {
+    ENCODE_NULL = 0,
+    ENCODE_INT,
+    ENCODE_UINT,
+    ENCODE_STRING,
+  };
+  EncodeType encode_type_;
+  ObObjType obj_type_;
+  TO_STRING_KV(K_(encode_type), K_(obj_type));
+};
+
+// Encode datums of output exprs to MySQL row directly, skip building ObObj of ObNewRow.
+// Only the columns which need no cast, charset convert or field info when encoding
+// are supported, see resolve_encoder.
+class ObSMDatumRow
+    : public obmysql::ObMySQLRow
+{
+public:
+  ObSMDatumRow(obmysql::MYSQL_PROTOCOL_TYPE type,
+               const ObDatum **datums,
+               const ObSMDatumCellEncoder *encoders,
+               const int64_t cell_cnt)
+      : ObMySQLRow(type),
+        datums_(datums),
+        encoders_(encoders),
+        cell_cnt_(cell_cnt)
+  {
+  }
+  virtual ~ObSMDatumRow() {}
+
+  // @param [in] meta            obj meta of output expr
+  // @param [in] field           field of the column responsed to client
+  // @param [in] result_charset  character_set_results of session
+  // @param [out] is_supported   false if the column should be encoded by ObSMRow
+  static int resolve_encoder(const ObObjMeta &meta,
+                             const ObField &field,
+                             const ObCharsetType result_charset,
+                             ObSMDatumCellEncoder &encoder,
+                             bool &is_supported);
+
+protected:
+  virtual int64_t get_cells_cnt() const { return cell_cnt_; }
+  virtual int encode_cell(
+      int64_t idx, char *buf,
+      int64_t len, int64_t &pos, char *bitmap) const;
+
+private:
+  const ObDatum **datums_;
+  const ObSMDatumCellEncoder *encoders_;
+  const int64_t cell_cnt_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSMDatumRow);
+}; // end of class ObSMDatumRow
+
 } // end of namespace common
 } // end of namespace oceanbase
 
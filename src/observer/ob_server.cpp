@@ -98,6 +98,7 @@
 #include "share/ob_server_blacklist.h"
 #include "share/ob_primary_standby_service.h" // ObPrimaryStandbyService
 #include "logservice/palf/election/interface/election.h"
+#include "logservice/palf/log_cache.h"
 
 using namespace oceanbase::lib;
 using namespace oceanbase::common;
@@ -360,6 +361,9 @@ int ObServer::init(const ObServerOptions &opts, const ObPLogWriterCfg &log_cfg)
     LOG_ERROR("init px target mgr failed", KR(ret));
   } else if (OB_FAIL(OB_BACKUP_INDEX_CACHE.init())) {
     LOG_ERROR("init backup index cache failed", KR(ret));
+  } else if (OB_FAIL(palf::LogCache::get_instance().init("log_cache",
+                                                        palf::LogCache::LOG_CACHE_PRIORITY))) {
+    LOG_ERROR("init log cache failed", KR(ret));
   } else if (OB_FAIL(ObActiveSessHistList::get_instance().init())) {
     LOG_ERROR("init ASH failed", KR(ret));
   } else if (OB_FAIL(ObServerBlacklist::get_instance().init(self_addr_, net_frame_.get_req_transport()))) {
@@ -520,6 +524,10 @@ void ObServer::destroy()
     OB_BACKUP_INDEX_CACHE.destroy();
     FLOG_INFO("backup index cache destroyed");
 
+    FLOG_INFO("begin to destroy log cache");
+    palf::LogCache::get_instance().destroy();
+    FLOG_INFO("log cache destroyed");
+
     FLOG_INFO("begin to destroy log block mgr");
     log_block_mgr_.destroy();
     FLOG_INFO("log block mgr destroy");
@@ -19,6 +19,8 @@
 #include "lib/allocator/ob_mem_leak_checker.h"
 #include "share/scheduler/ob_dag_scheduler.h"
 #include "rpc/obrpc/ob_rpc_handler.h"
+#include "rpc/obrpc/ob_rpc_batch.h"
+#include "rpc/obmysql/ob_sql_sock_session.h"
 #include "share/ob_cluster_version.h"
 #include "share/ob_task_define.h"
 #include "share/ob_resource_limit.h"
@@ -156,6 +158,7 @@ int ObServerReloadConfig::operator()()
     }
 
     (void)reload_diagnose_info_config(GCONF.enable_perf_event);
+    (void)reload_diagnose_info_sample_config(GCONF._perf_event_sample_percentage);
     (void)reload_trace_log_config(GCONF.enable_record_trace_log);
 
     reload_tenant_freezer_config_();
@@ -232,6 +235,15 @@ int ObServerReloadConfig::operator()()
     obrpc::set_rpc_checksum_check_level(new_level);
   }
 
+  {
+    ATOMIC_STORE(&obmysql::ObSqlSockSession::RESPONSE_COALESCE_SIZE, GCONF._sql_nio_response_coalesce_size.get_value());
+    ATOMIC_STORE(&obmysql::ObSqlSockSession::RESPONSE_COALESCE_TIME, GCONF._sql_nio_response_coalesce_time.get_value());
+  }
+
+  {
+    ATOMIC_STORE(&obrpc::ObRpcBatchClient::BATCH_WINDOW, GCONF._rpc_batch_window.get_value());
+  }
+
   {
     auto new_upgrade_stage = obrpc::get_upgrade_stage(GCONF._upgrade_stage.str());
     auto orig_upgrade_stage = GCTX.get_upgrade_stage();
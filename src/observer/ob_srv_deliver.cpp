@@ -20,6 +20,7 @@
 #include "lib/stat/ob_session_stat.h"
 #include "rpc/ob_request.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
+#include "rpc/obrpc/ob_rpc_batch.h"
 #include "rpc/obmysql/ob_mysql_packet.h"
 #include "rpc/frame/ob_net_easy.h"
 #include "share/ob_thread_mgr.h"
@@ -50,6 +51,9 @@ int check_easy_memory_limit(ObRequest &req)
   if (req.get_nio_protocol() == ObRequest::TRANSPORT_PROTO_RDMA) {
     // Todo:
     return ret;
+  } else if (req.get_nio_protocol() == ObRequest::TRANSPORT_PROTO_BATCH) {
+    // checked by the batch frame
+    return ret;
   }
   easy_connection_t *c = req.get_ez_req()->ms->c;
   if (OB_UNLIKELY(NULL == (stat = c->pool->mod_stat))) {
@@ -244,6 +248,11 @@ int ObSrvDeliver::deliver_rpc_request(ObRequest &req)
   if (!OB_SUCC(ret)) {
 
   } else if (!is_high_prio_rpc_req(req) && OB_FAIL(check_easy_memory_limit(req))) {
+  } else if (OB_RPC_BATCH_FRAME == pkt.get_pcode()) {
+    // split into sub requests, each of them is delivered as a normal request
+    if (OB_FAIL(ObRpcBatchServerHandleContext::deliver(req, *this))) {
+      LOG_WARN("deliver rpc batch frame fail", K(ret), K(req));
+    }
   } else if (pkt.is_stream()) {
     if (!session_handler_.wakeup_next_thread(req)) {
       ret = OB_SESSION_NOT_FOUND;
@@ -289,7 +298,7 @@ int ObSrvDeliver::deliver_rpc_request(ObRequest &req)
         LOG_WARN("tenant receive request fail", K(*tenant), K(req));
       }
     }
-  } else if (!pkt.is_stream()) {
+  } else if (!pkt.is_stream() && OB_RPC_BATCH_FRAME != pkt.get_pcode()) {
     LOG_WARN("not stream packet, should not reach here.");
     ret = OB_ERR_UNEXPECTED;
   }
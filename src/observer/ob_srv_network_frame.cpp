@@ -14,6 +14,7 @@
 #include "io/easy_maccept.h"
 #include "observer/ob_srv_network_frame.h"
 #include "rpc/obmysql/ob_sql_nio_server.h"
+#include "rpc/obrpc/ob_rpc_batch.h"
 #include "observer/mysql/obsm_conn_callback.h"
 
 #include "share/config/ob_server_config.h"
@@ -148,6 +149,8 @@ int ObSrvNetworkFrame::init()
     LOG_ERROR("net keepalive register fail", K(ret));
   } else if (hp_io_cnt > 0 && OB_FAIL(net_.high_prio_rpc_net_register(rpc_handler_, high_prio_rpc_transport_))) {
     LOG_ERROR("high prio rpc net register fail", K(ret));
+  } else if (OB_FAIL(obrpc::global_rpc_batch_client.init(rpc_transport_))) {
+    LOG_ERROR("init rpc batch client fail", K(ret));
   } 
     else {
     share::set_obrpc_transport(rpc_transport_);
@@ -160,6 +163,7 @@ int ObSrvNetworkFrame::init()
 
 void ObSrvNetworkFrame::destroy()
 {
+  obrpc::global_rpc_batch_client.destroy();
   net_.destroy();
   if (NULL != obmysql::global_sql_nio_server) {
     obmysql::global_sql_nio_server->destroy();
@@ -169,6 +173,9 @@ void ObSrvNetworkFrame::destroy()
 int ObSrvNetworkFrame::start()
 {
   int ret = net_.start();
+  if (OB_SUCC(ret) && OB_FAIL(obrpc::global_rpc_batch_client.start())) {
+    LOG_ERROR("rpc batch client start failed", K(ret));
+  }
   if (OB_SUCC(ret)) {
     if (enable_new_sql_nio()) {
       obmysql::global_sql_nio_server = OB_NEW(obmysql::ObSqlNioServer, "SqlNio", obmysql::global_sm_conn_callback, mysql_handler_);
@@ -180,7 +187,8 @@ int ObSrvNetworkFrame::start()
         if (0 == net_thread_count) {
           net_thread_count = get_default_net_thread_count();
         }
-        if(OB_FAIL(obmysql::global_sql_nio_server->start(GCONF.mysql_port, &deliver_, net_thread_count))) {
+        if(OB_FAIL(obmysql::global_sql_nio_server->start(GCONF.mysql_port, &deliver_, net_thread_count,
+                                                              GCONF._enable_sql_nio_io_uring))) {
           LOG_ERROR("sql nio server start failed", K(ret));
         }
       }
@@ -192,6 +192,7 @@ void oceanbase::observer::init_srv_xlator_for_cdc(ObSrvRpcXlator *xlator)
   RPC_PROCESSOR(ObCdcLSReqStartLSNByTsP);
   RPC_PROCESSOR(ObCdcLSFetchLogP);
   RPC_PROCESSOR(ObCdcLSFetchMissingLogP);
+  RPC_PROCESSOR(ObCdcLSSubscribeLogP);
 }
 
 void oceanbase::observer::init_srv_xlator_for_executor(ObSrvRpcXlator *xlator) {
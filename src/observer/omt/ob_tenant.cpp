@@ -233,10 +233,15 @@ int ObResourceGroup::init()
     LOG_ERROR("group init failed");
   } else {
     req_queue_.set_limit(common::ObServerConfig::get_instance().tenant_task_queue_size);
-    set_token_cnt(static_cast<int64_t>(ceil(tenant_->unit_min_cpu())));
-    set_min_token_cnt(token_cnt_);
-    set_max_token_cnt(static_cast<int64_t>(ceil(tenant_->unit_max_cpu())));
-    inited_ = true;
+    if (OB_FAIL(req_queue_.init(common::ObServerConfig::get_instance()._tenant_req_queue_shard_count,
+                                ObMemAttr(tenant_->id(), "GroupReqQueue")))) {
+      LOG_WARN("init group req queue failed", K(ret), K(group_id_));
+    } else {
+      set_token_cnt(static_cast<int64_t>(ceil(tenant_->unit_min_cpu())));
+      set_min_token_cnt(token_cnt_);
+      set_max_token_cnt(static_cast<int64_t>(ceil(tenant_->unit_max_cpu())));
+      inited_ = true;
+    }
   }
   return ret;
 }
@@ -529,6 +534,10 @@ ObTenant::ObTenant(const int64_t id,
       last_calibrate_token_ts_(0),
       last_pop_normal_cnt_(0),
       nesting_worker_has_init_(MULTI_LEVEL_THRESHOLD),
+      adaptive_worker_(false),
+      last_adjust_worker_ts_(0),
+      last_cpu_time_(0),
+      worker_count_ctrl_(),
       stopped_(true),
       wait_mtl_finished_(false),
       req_queue_(),
@@ -563,7 +572,10 @@ ObTenant::ObTenant(const int64_t id,
       st_metrics_(),
       sql_limiter_(),
       worker_us_(0),
-      idle_us_(0)
+      idle_us_(0),
+      sample_req_cnt_(0),
+      sample_queue_us_(0),
+      sample_process_us_(0)
 {
   token_usage_check_ts_ = ObTimeUtility::current_time();
   lock_.set_diagnose(true);
@@ -591,6 +603,9 @@ int ObTenant::init(const ObTenantMeta &meta)
   if (OB_FAIL(ObTenantBase::init(&cgroup_ctrl_))) {
     LOG_WARN("fail to init tenant base", K(ret));
   } else if (FALSE_IT(req_queue_.set_limit(common::ObServerConfig::get_instance().tenant_task_queue_size))) {
+  } else if (OB_FAIL(req_queue_.init(common::ObServerConfig::get_instance()._tenant_req_queue_shard_count,
+                                     ObMemAttr(id_, "TenantReqQueue")))) {
+    LOG_WARN("init req queue failed", K(ret), K_(id));
   } else if (worker_pool_.init(1, 1)) {
     // useless now, but maybe useful later
     LOG_WARN("init worker pool fail", K(ret));
@@ -974,7 +989,7 @@ int ObTenant::get_new_request(
     w.set_large_query(false);
     w.set_curr_request_level(0);
     wk_level = w.get_worker_level();
-    if (OB_SUCC(w.get_group()->req_queue_.pop(task, timeout))) {
+    if (OB_SUCC(w.get_group()->req_queue_.pop(task, timeout, w.Worker::get_tidx()))) {
       w.get_group()->atomic_inc_pop_cnt();
       EVENT_INC(REQUEST_DEQUEUE_COUNT);
       if (nullptr == req && nullptr != task) {
@@ -1028,11 +1043,11 @@ int ObTenant::get_new_request(
       if (OB_UNLIKELY(only_high_high_prio)) {
         // We must ensure at least one worker can process the highest
         // priority task.
-        ret = req_queue_.pop_high_high(task, timeout);
+        ret = req_queue_.pop_high_high(task, timeout, w.Worker::get_tidx());
       } else if (OB_UNLIKELY(only_high_prio)) {
         // We must ensure at least number of tokens of workers which don't
         // process low priority task.
-        ret = req_queue_.pop_high(task, timeout);
+        ret = req_queue_.pop_high(task, timeout, w.Worker::get_tidx());
       } else {
         // If large requests exist and this worker doesn't have LQT but
         // can acquire, do it.
@@ -1043,7 +1058,7 @@ int ObTenant::get_new_request(
           w.set_lq_token();
         }
         if (OB_LIKELY(!w.has_lq_token())) {
-          ret = req_queue_.pop(task, 0L);
+          ret = req_queue_.pop(task, 0L, w.Worker::get_tidx());
         }
         if (OB_UNLIKELY(nullptr == task)) {
           // If large query flag is set, we prefer large query.
@@ -1052,7 +1067,7 @@ int ObTenant::get_new_request(
           } else {
             // Ignore return code from large queue and get request from
             // normal queue.
-            ret = req_queue_.pop(task, timeout);
+            ret = req_queue_.pop(task, timeout, w.Worker::get_tidx());
           }
         }
       }
@@ -1266,6 +1281,7 @@ int ObTenant::timeup()
   calibrate_worker_count();
   handle_retry_req();
   calibrate_token_count();
+  adjust_worker_count();
   return ret;
 }
 
@@ -1314,6 +1330,52 @@ void ObTenant::calibrate_token_count()
   }
 }
 
+void ObTenant::adjust_worker_count()
+{
+  int ret = OB_SUCCESS;
+  const bool enabled = GCONF._enable_adaptive_tenant_worker
+      && OB_DATA_TENANT_ID != id_
+      && !is_virtual_tenant_id(id_);
+  const auto current_time = ObTimeUtility::current_time();
+  if (enabled != adaptive_worker_) {
+    // drop samples of the last period and restart from suggested token count
+    adaptive_worker_ = enabled;
+    worker_count_ctrl_.reset();
+    ATOMIC_SET(&sample_req_cnt_, 0);
+    ATOMIC_SET(&sample_queue_us_, 0);
+    ATOMIC_SET(&sample_process_us_, 0);
+    last_cpu_time_ = 0;
+    last_adjust_worker_ts_ = current_time;
+    set_token(sug_token_cnt_);
+    LOG_INFO("tenant adaptive worker switched", K_(id), K(enabled), K_(token_cnt));
+  } else if (enabled && current_time - last_adjust_worker_ts_ > ADJUST_WORKER_INTERVAL) {
+    ObWorkerCountSample sample;
+    sample.interval_us_ = current_time - last_adjust_worker_ts_;
+    sample.req_cnt_ = ATOMIC_TAS(&sample_req_cnt_, 0);
+    sample.queue_us_ = ATOMIC_TAS(&sample_queue_us_, 0);
+    sample.process_us_ = ATOMIC_TAS(&sample_process_us_, 0);
+    sample.queue_len_ = req_queue_.size();
+    int64_t cpu_time = 0;
+    if (cgroup_ctrl_.is_valid() && OB_SUCC(cgroup_ctrl_.get_cpu_time(id_, cpu_time))) {
+      if (last_cpu_time_ > 0 && cpu_time >= last_cpu_time_) {
+        sample.cpu_us_ = cpu_time - last_cpu_time_;
+      }
+      last_cpu_time_ = cpu_time;
+    }
+    const int64_t token = worker_count_ctrl_.adjust(sample,
+                                                    token_cnt_,
+                                                    sug_token_cnt_,
+                                                    worker_count_bound(),
+                                                    unit_max_cpu_,
+                                                    GCONF._adaptive_tenant_worker_target_queue_time);
+    if (token != token_cnt_) {
+      LOG_INFO("tenant adjust worker count", K_(id), K_(token_cnt), K(token), K(sample));
+      set_token(token);
+    }
+    last_adjust_worker_ts_ = current_time;
+  }
+}
+
 void ObTenant::calibrate_group_token_count()
 {
   if (dynamic_modify_group_token_) {
@@ -32,6 +32,7 @@
 #include "observer/omt/ob_th_worker.h"
 #include "observer/omt/ob_worker_pool.h"
 #include "observer/omt/ob_multi_level_queue.h"
+#include "observer/omt/ob_worker_count_controller.h"
 #include "ob_retry_queue.h"
 #include "lib/utility/ob_query_rate_limiter.h"
 #include "rpc/obrpc/ob_rpc_stat.h"
@@ -295,7 +296,7 @@ public:
 
 protected:
   WList workers_;
-  common::ObPriorityQueue2<0, 1> req_queue_;
+  common::ObShardedPriorityQueue2<0, 1> req_queue_;
 
 private:
   bool inited_;                              // Mark whether the container has threads and queues allocated
@@ -383,6 +384,7 @@ class ObTenant : public share::ObTenantBase
   // pool.
   static constexpr int64_t PRESERVE_INACTIVE_WORKER_TIME = 10 * 1000L * 1000L;
   enum { CALIBRATE_WORKER_INTERVAL = 30 * 1000 * 1000 };
+  enum { ADJUST_WORKER_INTERVAL = 100 * 1000 };
   enum { CALIBRATE_TOKEN_INTERVAL = 100 * 1000 };
 
 public:
@@ -439,6 +441,8 @@ public:
 
   void add_idle_time(int64_t idle_time);
   void add_worker_time(int64_t req_time);
+  // sample of a request processed by normal worker, for adjusting worker count
+  void add_req_sample(int64_t queue_time, int64_t process_time);
 
   int rdlock(common::ObLDHandle &handle);
   int wrlock(common::ObLDHandle &handle);
@@ -466,6 +470,8 @@ public:
   void calibrate_token_count();
   void calibrate_group_token_count();
   void calibrate_worker_count();
+  // size token count by queueing time and cpu usage, see ObWorkerCountController
+  void adjust_worker_count();
   int timeup();
 
   TO_STRING_KV(K_(id),
@@ -525,6 +531,7 @@ public:
   bool user_sched_enabled() const;
   double get_token_usage() const;
   int64_t get_worker_time() const;
+  const ObWorkerCountController &get_worker_count_ctrl() const { return worker_count_ctrl_; }
   // sql throttle
   void update_sql_throttle_metrics(const ObSqlThrottleMetrics &metrics)
   { st_metrics_ = metrics; }
@@ -603,13 +610,17 @@ protected:
   int64_t last_calibrate_token_ts_;
   int64_t last_pop_normal_cnt_;
   int nesting_worker_has_init_;
+  bool adaptive_worker_;
+  int64_t last_adjust_worker_ts_;
+  int64_t last_cpu_time_;
+  ObWorkerCountController worker_count_ctrl_;
 
   bool stopped_;
   bool wait_mtl_finished_;
 
   /// tenant task queue,
   // 'hp' for high priority and 'np' for normal priority
-  common::ObPriorityQueue2<1, QQ_MAX_PRIO - 1, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
+  common::ObShardedPriorityQueue2<1, QQ_MAX_PRIO - 1, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
   common::ObLinkQueue large_req_queue_;
 
   //Create a request queue for each level of nested requests
@@ -672,6 +683,10 @@ public:
   // idle time between two checkpoints
   int64_t worker_us_ CACHE_ALIGNED;
   int64_t idle_us_ CACHE_ALIGNED;
+  // requests sample since last adjust of worker count
+  int64_t sample_req_cnt_ CACHE_ALIGNED;
+  int64_t sample_queue_us_ CACHE_ALIGNED;
+  int64_t sample_process_us_ CACHE_ALIGNED;
 
 }; // end of class ObTenant
 
@@ -716,6 +731,13 @@ inline void ObTenant::add_worker_time(int64_t req_time)
   (void)ATOMIC_FAA(reinterpret_cast<uint64_t *>(&worker_us_), req_time);
 }
 
+inline void ObTenant::add_req_sample(int64_t queue_time, int64_t process_time)
+{
+  (void)ATOMIC_FAA(&sample_req_cnt_, 1);
+  (void)ATOMIC_FAA(&sample_queue_us_, queue_time);
+  (void)ATOMIC_FAA(&sample_process_us_, process_time);
+}
+
 inline void ObTenant::pause_it(ObThWorker &w)
 {
   pause_cnt_++;
@@ -357,6 +357,7 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
   int64_t wait_end_time = 0;
   int64_t req_start_time = 0;
   int64_t req_end_time = 0;
+  int64_t req_queue_time = 0;
   th_created();
 
   // Avoid adding and deleting entities from the root node for every request, the parameters are meaningless
@@ -434,7 +435,8 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
               if (OB_SUCC(ret)) {
                 if (OB_LIKELY(nullptr != req)) {
                   req_recv_timestamp = req->get_receive_timestamp(); // Update backtrace printing parameters
-                  EVENT_ADD(REQUEST_QUEUE_TIME, wait_end_time - req->get_enqueue_timestamp());
+                  req_queue_time = wait_end_time - req->get_enqueue_timestamp();
+                  EVENT_ADD(REQUEST_QUEUE_TIME, req_queue_time);
                   req->set_push_pop_diff(wait_end_time);
                   query_start_time_ = wait_end_time;
                   query_enqueue_time_ = req->get_enqueue_timestamp();
@@ -444,6 +446,9 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
                   process_request(*req);
                   req_end_time = ObTimeUtility::current_time();
                   tenant_->add_worker_time(req_end_time - req_start_time);
+                  if (0 == get_worker_level() && nullptr == get_group()) {
+                    tenant_->add_req_sample(req_queue_time, req_end_time - req_start_time);
+                  }
                   query_enqueue_time_ = INT64_MAX;
                   query_start_time_ = INT64_MAX;
                 } else {
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER_OMT
+#include "ob_worker_count_controller.h"
+
+#include <cmath>
+#include "lib/time/ob_time_utility.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::omt;
+
+const char *ObWorkerCountDecision::get_reason_str(const Reason reason)
+{
+  static const char *reason_strs[] = {
+    "HOLD",
+    "GROW_QUEUE",
+    "SHRINK_CPU",
+    "SHRINK_IDLE",
+    "CLAMP",
+  };
+  STATIC_ASSERT(ARRAYSIZEOF(reason_strs) == MAX_REASON, "reason str count mismatch");
+  const char *str = "UNKNOWN";
+  if (reason >= HOLD && reason < MAX_REASON) {
+    str = reason_strs[reason];
+  }
+  return str;
+}
+
+ObWorkerCountController::ObWorkerCountController()
+    : lock_(),
+      idle_rounds_(0),
+      decision_cnt_(0)
+{
+}
+
+void ObWorkerCountController::reset()
+{
+  ObSpinLockGuard guard(lock_);
+  idle_rounds_ = 0;
+  decision_cnt_ = 0;
+}
+
+int64_t ObWorkerCountController::adjust(const ObWorkerCountSample &sample,
+                                        const int64_t cur_cnt,
+                                        const int64_t min_cnt,
+                                        const int64_t max_cnt,
+                                        const double cpu_limit,
+                                        const int64_t target_queue_us)
+{
+  ObWorkerCountDecision decision;
+  const double interval = static_cast<double>(std::max(1L, sample.interval_us_));
+  const double target = static_cast<double>(std::max(1L, target_queue_us));
+  const int64_t upper = std::max(min_cnt, max_cnt);
+  decision.ts_ = ObTimeUtility::current_time();
+  decision.old_cnt_ = cur_cnt;
+  decision.min_cnt_ = min_cnt;
+  decision.max_cnt_ = upper;
+  decision.throughput_ = static_cast<int64_t>(static_cast<double>(sample.req_cnt_) * 1000000 / interval);
+  decision.busy_workers_ = static_cast<double>(sample.process_us_) / interval;
+  decision.cpu_usage_ = sample.cpu_us_ < 0 ? -1 : static_cast<double>(sample.cpu_us_) / interval;
+  decision.queue_len_ = sample.queue_len_;
+  if (sample.req_cnt_ > 0) {
+    decision.avg_queue_us_ = sample.queue_us_ / sample.req_cnt_;
+  } else if (sample.queue_len_ > 0) {
+    // nothing popped while requests are waiting, they have queued for the whole interval
+    decision.avg_queue_us_ = sample.interval_us_;
+  }
+  const bool cpu_saturated = decision.cpu_usage_ >= 0 && cpu_limit > 0
+      && decision.cpu_usage_ >= cpu_limit * CPU_SATURATED_RATIO;
+
+  int64_t new_cnt = cur_cnt;
+  ObWorkerCountDecision::Reason reason = ObWorkerCountDecision::HOLD;
+  if (static_cast<double>(decision.avg_queue_us_) > target) {
+    idle_rounds_ = 0;
+    if (cpu_saturated) {
+      new_cnt = cur_cnt - 1;
+      reason = ObWorkerCountDecision::SHRINK_CPU;
+    } else {
+      // By Little's law the busy workers are what the current throughput
+      // needs, the backlog needs queue_len * service time / target more to be
+      // drained within target queueing time. Grow at most double each round.
+      const double service_us = sample.req_cnt_ > 0 ?
+          static_cast<double>(sample.process_us_) / static_cast<double>(sample.req_cnt_) : target;
+      const double backlog_workers = static_cast<double>(sample.queue_len_) * service_us / target;
+      const int64_t desired = static_cast<int64_t>(std::ceil(decision.busy_workers_ + backlog_workers));
+      new_cnt = std::max(cur_cnt + 1, std::min(desired, cur_cnt * 2));
+      reason = ObWorkerCountDecision::GROW_QUEUE;
+    }
+  } else if (static_cast<double>(decision.avg_queue_us_) * 2 <= target
+             && decision.busy_workers_ * IDLE_HEADROOM < static_cast<double>(cur_cnt)) {
+    if (++idle_rounds_ >= SHRINK_IDLE_ROUNDS) {
+      idle_rounds_ = 0;
+      const int64_t step = std::max(1L, (cur_cnt - min_cnt) / 4);
+      const int64_t keep = static_cast<int64_t>(std::ceil(decision.busy_workers_ * IDLE_HEADROOM));
+      new_cnt = std::max(cur_cnt - step, keep);
+      reason = ObWorkerCountDecision::SHRINK_IDLE;
+    }
+  } else {
+    idle_rounds_ = 0;
+  }
+
+  new_cnt = std::min(std::max(new_cnt, min_cnt), upper);
+  if (new_cnt != cur_cnt) {
+    if (ObWorkerCountDecision::HOLD == reason) {
+      reason = ObWorkerCountDecision::CLAMP;
+    }
+    decision.new_cnt_ = new_cnt;
+    decision.reason_ = reason;
+    record(decision);
+  }
+  return new_cnt;
+}
+
+void ObWorkerCountController::record(const ObWorkerCountDecision &decision)
+{
+  ObSpinLockGuard guard(lock_);
+  history_[decision_cnt_ % HISTORY_SIZE] = decision;
+  decision_cnt_++;
+}
+
+int64_t ObWorkerCountController::get_decisions(ObWorkerCountDecision *decisions,
+                                               const int64_t cnt) const
+{
+  int64_t ret_cnt = 0;
+  if (OB_NOT_NULL(decisions)) {
+    ObSpinLockGuard guard(lock_);
+    const int64_t total = std::min(decision_cnt_, HISTORY_SIZE);
+    for (; ret_cnt < cnt && ret_cnt < total; ret_cnt++) {
+      decisions[ret_cnt] = history_[(decision_cnt_ - 1 - ret_cnt) % HISTORY_SIZE];
+    }
+  }
+  return ret_cnt;
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_WORKER_COUNT_CONTROLLER_H
+#define OB_WORKER_COUNT_CONTROLLER_H
+
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace omt
+{
+
+// Statistics of a tenant's normal workers within one adjust interval.
+struct ObWorkerCountSample
+{
+  ObWorkerCountSample()
+      : interval_us_(0), req_cnt_(0), queue_us_(0), process_us_(0),
+        cpu_us_(-1), queue_len_(0)
+  {}
+  TO_STRING_KV(K_(interval_us), K_(req_cnt), K_(queue_us), K_(process_us),
+               K_(cpu_us), K_(queue_len));
+
+  int64_t interval_us_;
+  int64_t req_cnt_;     // requests popped by workers
+  int64_t queue_us_;    // total queueing time of popped requests
+  int64_t process_us_;  // total processing time of popped requests
+  int64_t cpu_us_;      // cpu time consumed by the tenant, -1 if unknown
+  int64_t queue_len_;   // requests still queued at the end of the interval
+};
+
+struct ObWorkerCountDecision
+{
+  enum Reason
+  {
+    HOLD = 0,
+    GROW_QUEUE,   // requests queue longer than target and cpu is available
+    SHRINK_CPU,   // cpu is saturated, more workers only add context switches
+    SHRINK_IDLE,  // workers have kept idle for a while
+    CLAMP,        // worker count bounds changed
+    MAX_REASON
+  };
+  ObWorkerCountDecision()
+      : ts_(0), old_cnt_(0), new_cnt_(0), min_cnt_(0), max_cnt_(0),
+        avg_queue_us_(0), throughput_(0), busy_workers_(0), cpu_usage_(-1),
+        queue_len_(0), reason_(HOLD)
+  {}
+  static const char *get_reason_str(const Reason reason);
+  TO_STRING_KV(K_(ts), K_(old_cnt), K_(new_cnt), K_(min_cnt), K_(max_cnt),
+               K_(avg_queue_us), K_(throughput), K_(busy_workers), K_(cpu_usage),
+               K_(queue_len), "reason", get_reason_str(reason_));
+
+  int64_t ts_;
+  int64_t old_cnt_;
+  int64_t new_cnt_;
+  int64_t min_cnt_;
+  int64_t max_cnt_;
+  int64_t avg_queue_us_;
+  int64_t throughput_;    // requests per second
+  double busy_workers_;   // average processing workers, L = λW of Little's law
+  double cpu_usage_;      // cpu cores, -1 if unknown
+  int64_t queue_len_;
+  Reason reason_;
+};
+
+// Sizes the active normal workers of a tenant by the measured queueing time
+// and cpu usage. It grows fast when requests queue and cpu is available, and
+// shrinks slowly after workers keep idle, so that bursts don't wait for workers.
+// Not thread safe except get_decisions, adjust is called by the tenant timer.
+class ObWorkerCountController
+{
+public:
+  static const int64_t HISTORY_SIZE = 32;
+  // shrink only after workers keep idle for so many intervals
+  static const int64_t SHRINK_IDLE_ROUNDS = 10;
+  static constexpr double CPU_SATURATED_RATIO = 0.9;
+  // keep so many times of busy workers when shrinking
+  static constexpr double IDLE_HEADROOM = 1.5;
+
+  ObWorkerCountController();
+  void reset();
+  // Returns the worker count in [min_cnt, max_cnt] for the next interval,
+  // cpu_limit is the number of cpu cores the tenant can use.
+  int64_t adjust(const ObWorkerCountSample &sample,
+                 const int64_t cur_cnt,
+                 const int64_t min_cnt,
+                 const int64_t max_cnt,
+                 const double cpu_limit,
+                 const int64_t target_queue_us);
+  // Copy the latest decisions that changed worker count, newest first.
+  int64_t get_decisions(ObWorkerCountDecision *decisions, const int64_t cnt) const;
+  TO_STRING_KV(K_(idle_rounds), K_(decision_cnt));
+
+private:
+  void record(const ObWorkerCountDecision &decision);
+
+private:
+  mutable common::ObSpinLock lock_;
+  int64_t idle_rounds_;
+  int64_t decision_cnt_;
+  ObWorkerCountDecision history_[HISTORY_SIZE];
+};
+
+} // end of namespace omt
+} // end of namespace oceanbase
+
+#endif /* OB_WORKER_COUNT_CONTROLLER_H */
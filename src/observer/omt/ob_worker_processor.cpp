@@ -26,6 +26,7 @@
 #include "share/config/ob_server_config.h"
 #include "observer/omt/ob_th_worker.h"
 #include "lib/utility/ob_hang_fatal_error.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::omt;
@@ -83,6 +84,8 @@ int ObWorkerProcessor::process(rpc::ObRequest &req)
   OB_ATOMIC_EVENT_RESET_RECORDER();
   PERF_RESET_RECORDER();
   const bool enable_trace_log = lib::is_trace_log_enabled();
+  // decide whether wait events of the request are recorded
+  ObDiagnoseInfoSampleGuard diagnose_sample_guard;
   const int64_t q_time = THIS_THWORKER.get_query_start_time() - req.get_receive_timestamp();
   NG_TRACE_EXT(process_begin,
                OB_ID(in_queue_time), q_time,
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "observer/virtual_table/ob_all_virtual_lock_wait_row_stat.h"
+
+#include "observer/ob_server_utils.h"
+#include "observer/ob_server_struct.h"
+#include "observer/omt/ob_multi_tenant.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+namespace oceanbase
+{
+namespace observer
+{
+
+void ObAllVirtualLockWaitRowStat::reset()
+{
+  ObVirtualTableScannerIterator::reset();
+  slot_idx_ = 0;
+}
+
+int ObAllVirtualLockWaitRowStat::inner_open()
+{
+  int ret = OB_SUCCESS;
+  slot_idx_ = 0;
+  all_tenant_ids_.reset();
+  GCTX.omt_->get_mtl_tenant_ids(all_tenant_ids_);
+  cur_tenant_index_ = 0;
+  return ret;
+}
+
+int ObAllVirtualLockWaitRowStat::inner_get_next_row(ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+  if (!start_to_read_ && OB_FAIL(make_this_ready_to_read())) {
+    SERVER_LOG(WARN, "fail to make_this_ready_to_read", K(ret), K(start_to_read_));
+  } else if (cur_tenant_index_ >= all_tenant_ids_.count()) {
+    ret = OB_ITER_END;
+  } else {
+    // find a valid tenant and fetch a row stat
+    uint64_t tenant_id = 0;
+    bool got_stat = false;
+    do {
+      tenant_id = all_tenant_ids_[cur_tenant_index_];
+      MTL_SWITCH(tenant_id) {
+        if (OB_ISNULL(MTL(memtable::ObLockWaitMgr*))) {
+          ret = OB_ERR_UNEXPECTED;
+          SERVER_LOG(WARN, "lockWaitMgr is null for tenant", K(ret), K(tenant_id));
+        } else if (OB_FAIL(MTL(memtable::ObLockWaitMgr*)->get_next_row_stat(slot_idx_, cur_stat_))) {
+          // OB_ITER_END
+        } else {
+          got_stat = true;
+        }
+      }
+      if ((OB_TENANT_NOT_IN_SERVER == ret || OB_ITER_END == ret) &&
+          cur_tenant_index_ + 1 < all_tenant_ids_.count()) {
+        // prepare for retry
+        slot_idx_ = 0;
+        cur_tenant_index_ += 1;
+        ret = OB_SUCCESS;
+      }
+    } while (OB_SUCC(ret) && !got_stat);
+    if (OB_SUCC(ret)) {
+      const int64_t col_count = output_column_ids_.count();
+      ObString ipstr;
+      for (int64_t i = 0; OB_SUCC(ret) && i < col_count; ++i) {
+        uint64_t col_id = output_column_ids_.at(i);
+        switch (col_id) {
+          case SVR_IP: {
+            ipstr.reset();
+            if (OB_FAIL(ObServerUtils::get_server_ip(allocator_, ipstr))) {
+              SERVER_LOG(ERROR, "get server ip failed", K(ret));
+            } else {
+              cur_row_.cells_[i].set_varchar(ipstr);
+              cur_row_.cells_[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+            }
+            break;
+          }
+          case SVR_PORT: {
+            cur_row_.cells_[i].set_int(GCTX.self_addr().get_port());
+            break;
+          }
+          case TENANT_ID: {
+            cur_row_.cells_[i].set_int(tenant_id);
+            break;
+          }
+          case TABLET_ID:
+            cur_row_.cells_[i].set_int(cur_stat_.tablet_id_);
+            break;
+          case ROWKEY:
+            {
+              ObString rowkey;
+              if (OB_FAIL(ob_write_string(*allocator_, cur_stat_.key_, rowkey))) {
+                SERVER_LOG(WARN, "fail to deep copy rowkey", K(cur_stat_), K(ret));
+              } else {
+                cur_row_.cells_[i].set_varchar(rowkey);
+                cur_row_.cells_[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+              }
+              break;
+            }
+          case WAIT_COUNT:
+            cur_row_.cells_[i].set_int(cur_stat_.wait_cnt_);
+            break;
+          case WAKEUP_COUNT:
+            cur_row_.cells_[i].set_int(cur_stat_.wakeup_cnt_);
+            break;
+          case HANDOFF_COUNT:
+            cur_row_.cells_[i].set_int(cur_stat_.handoff_cnt_);
+            break;
+          case TOTAL_WAIT_TIME:
+            cur_row_.cells_[i].set_int(cur_stat_.total_wait_time_);
+            break;
+          case MAX_WAIT_TIME:
+            cur_row_.cells_[i].set_int(cur_stat_.max_wait_time_);
+            break;
+          case LAST_WAIT_TS:
+            cur_row_.cells_[i].set_int(cur_stat_.last_wait_ts_);
+            break;
+          default:
+            ret = OB_ERR_UNEXPECTED;
+            SERVER_LOG(WARN, "invalid col_id", K(ret), K(col_id));
+            break;
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      row = &cur_row_;
+    }
+  }
+  return ret;
+}
+
+int ObAllVirtualLockWaitRowStat::make_this_ready_to_read()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(allocator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    SERVER_LOG(ERROR, "invalid allocator is NULL", K(allocator_), K(ret));
+  } else if (OB_ISNULL(cur_row_.cells_)) {
+    ret = OB_ERR_UNEXPECTED;
+    SERVER_LOG(ERROR, "cur row cell is NULL", K(ret));
+  } else {
+    start_to_read_ = true;
+  }
+  return ret;
+}
+
+}/* ns observer*/
+}/* ns oceanbase */
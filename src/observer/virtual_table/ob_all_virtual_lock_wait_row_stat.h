@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_ALL_VIRTUAL_LOCK_WAIT_ROW_STAT_H_
+#define OB_ALL_VIRTUAL_LOCK_WAIT_ROW_STAT_H_
+
+#include "share/ob_virtual_table_scanner_iterator.h"
+#include "storage/memtable/ob_lock_wait_mgr.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+class ObAllVirtualLockWaitRowStat : public common::ObVirtualTableScannerIterator
+{
+public:
+  ObAllVirtualLockWaitRowStat() : slot_idx_(0), cur_tenant_index_(0) {}
+  virtual ~ObAllVirtualLockWaitRowStat() { reset(); }
+public:
+  virtual int inner_open();
+  virtual int inner_get_next_row(common::ObNewRow *&row);
+  virtual void reset();
+private:
+  int make_this_ready_to_read();
+private:
+  enum
+  {
+    SVR_IP = common::OB_APP_MIN_COLUMN_ID,
+    SVR_PORT,
+    TENANT_ID,
+    TABLET_ID,
+    ROWKEY,
+    WAIT_COUNT,
+    WAKEUP_COUNT,
+    HANDOFF_COUNT,
+    TOTAL_WAIT_TIME,
+    MAX_WAIT_TIME,
+    LAST_WAIT_TS,
+  };
+  memtable::ObRowContentionStat cur_stat_;
+  int64_t slot_idx_;
+  ObSEArray<uint64_t, 16> all_tenant_ids_;
+  int cur_tenant_index_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObAllVirtualLockWaitRowStat);
+};
+
+}
+}
+#endif /* OB_ALL_VIRTUAL_LOCK_WAIT_ROW_STAT_H_ */
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "observer/ob_server_struct.h"
+#include "ob_all_virtual_tenant_worker_adjust.h"
+#include "share/ob_errno.h"
+#include "observer/omt/ob_tenant.h"
+#include "observer/omt/ob_multi_tenant.h"
+
+namespace oceanbase
+{
+using namespace lib;
+using namespace omt;
+namespace observer
+{
+ObAllVirtualTenantWorkerAdjust::ObAllVirtualTenantWorkerAdjust()
+  : is_inited_(false)
+{
+}
+
+ObAllVirtualTenantWorkerAdjust::~ObAllVirtualTenantWorkerAdjust()
+{
+}
+
+int ObAllVirtualTenantWorkerAdjust::inner_get_next_row(common::ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    auto func = [&] (omt::ObTenant &t) {
+      int ret = OB_SUCCESS;
+      ObWorkerCountDecision decisions[ObWorkerCountController::HISTORY_SIZE];
+      const int64_t cnt = t.get_worker_count_ctrl().get_decisions(
+          decisions, ObWorkerCountController::HISTORY_SIZE);
+      for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+        if (OB_FAIL(add_row(t.id(), decisions[i]))) {
+          SERVER_LOG(WARN, "fail to add row", K(ret), K(decisions[i]));
+        }
+      }
+      return ret;
+    };
+
+    omt::ObMultiTenant *omt = GCTX.omt_;
+    if (OB_ISNULL(omt)) {
+      ret = OB_ERR_UNEXPECTED;
+      SERVER_LOG(WARN, "nullptr", K(ret));
+    } else if (OB_FAIL(omt->for_each(func))){
+      SERVER_LOG(WARN, "omt for each failed", K(ret));
+    } else {
+      scanner_it_ = scanner_.begin();
+      is_inited_ = true;
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(scanner_it_.get_next_row(cur_row_))) {
+      if (OB_ITER_END != ret) {
+        SERVER_LOG(WARN, "fail to get next row", K(ret));
+      }
+    } else {
+      row = &cur_row_;
+    }
+  }
+
+  return ret;
+}
+
+int ObAllVirtualTenantWorkerAdjust::add_row(const uint64_t tenant_id,
+                                            const ObWorkerCountDecision &decision)
+{
+  int ret = OB_SUCCESS;
+  const int64_t col_count = output_column_ids_.count();
+  ObObj *cells = cur_row_.cells_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < col_count; ++i) {
+    uint64_t col_id = output_column_ids_.at(i);
+    switch (col_id) {
+    case OB_APP_MIN_COLUMN_ID:
+      //svr_ip
+      if (ObServerConfig::get_instance().self_addr_.ip_to_string(ip_buf_, sizeof(ip_buf_))) {
+        cells[i].set_varchar(ip_buf_);
+        cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+      }
+      break;
+    case OB_APP_MIN_COLUMN_ID + 1:
+      //svr_port
+      cells[i].set_int(ObServerConfig::get_instance().self_addr_.get_port());
+      break;
+    case OB_APP_MIN_COLUMN_ID + 2:
+      //tenant_id
+      cells[i].set_int(tenant_id);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 3:
+      //adjust_time
+      cells[i].set_int(decision.ts_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 4:
+      //old_worker_cnt
+      cells[i].set_int(decision.old_cnt_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 5:
+      //new_worker_cnt
+      cells[i].set_int(decision.new_cnt_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 6:
+      //min_worker_cnt
+      cells[i].set_int(decision.min_cnt_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 7:
+      //max_worker_cnt
+      cells[i].set_int(decision.max_cnt_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 8:
+      //avg_queue_time
+      cells[i].set_int(decision.avg_queue_us_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 9:
+      //throughput
+      cells[i].set_int(decision.throughput_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 10:
+      //busy_workers
+      cells[i].set_double(decision.busy_workers_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 11:
+      //cpu_usage
+      cells[i].set_double(decision.cpu_usage_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 12:
+      //queue_length
+      cells[i].set_int(decision.queue_len_);
+      break;
+    case OB_APP_MIN_COLUMN_ID + 13:
+      //reason
+      cells[i].set_varchar(ObWorkerCountDecision::get_reason_str(decision.reason_));
+      cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+      break;
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      SERVER_LOG(WARN, "invalid column id, ", K(ret), K(col_id));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(scanner_.add_row(cur_row_))) {
+      SERVER_LOG(WARN, "fail to add row", K(ret), K(cur_row_));
+    }
+  }
+  return ret;
+}
+
+} /* namespace observer */
+} /* namespace oceanbase */
@@ -0,0 +1,40 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_ALL_VIRTUAL_TENANT_WORKER_ADJUST_H_
+#define OB_ALL_VIRTUAL_TENANT_WORKER_ADJUST_H_
+#include "share/ob_virtual_table_scanner_iterator.h"
+#include "observer/omt/ob_worker_count_controller.h"
+
+namespace oceanbase
+{
+namespace observer
+{
+// Recent worker count changes made by the adaptive worker controller of each
+// tenant, newest first.
+class ObAllVirtualTenantWorkerAdjust : public common::ObVirtualTableScannerIterator
+{
+public:
+  ObAllVirtualTenantWorkerAdjust();
+  virtual ~ObAllVirtualTenantWorkerAdjust();
+  virtual int inner_get_next_row(common::ObNewRow *&row);
+private:
+  int add_row(const uint64_t tenant_id, const omt::ObWorkerCountDecision &decision);
+private:
+  char ip_buf_[common::OB_IP_STR_BUFF];
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObAllVirtualTenantWorkerAdjust);
+};
+
+} /* namespace observer */
+} /* namespace oceanbase */
+#endif /* OB_ALL_VIRTUAL_TENANT_WORKER_ADJUST_H_ */
@@ -106,6 +106,7 @@
 #include "observer/virtual_table/ob_all_virtual_sys_task_status.h"
 #include "observer/virtual_table/ob_all_virtual_macro_block_marker_status.h"
 #include "observer/virtual_table/ob_all_virtual_lock_wait_stat.h"
+#include "observer/virtual_table/ob_all_virtual_lock_wait_row_stat.h"
 #include "observer/virtual_table/ob_all_virtual_long_ops_status.h"
 #include "observer/virtual_table/ob_all_virtual_tenant_memstore_allocator_info.h"
 #include "observer/virtual_table/ob_all_virtual_server_object_pool.h"
@@ -175,6 +176,8 @@
 #include "observer/virtual_table/ob_all_virtual_log_stat.h"
 #include "observer/virtual_table/ob_all_virtual_apply_stat.h"
 #include "observer/virtual_table/ob_all_virtual_replay_stat.h"
+#include "observer/virtual_table/ob_all_virtual_replay_lag.h"
+#include "observer/virtual_table/ob_all_virtual_tenant_worker_adjust.h"
 #include "observer/virtual_table/ob_all_virtual_unit.h"
 #include "observer/virtual_table/ob_all_virtual_server.h"
 #include "observer/virtual_table/ob_all_virtual_obj_lock.h"
@@ -1738,6 +1741,28 @@ int ObVTIterCreator::create_vt_iter(ObVTableScanParam &params,
             }
             break;
           }
+          case OB_ALL_VIRTUAL_LOCK_WAIT_ROW_STAT_TID: {
+            ObAllVirtualLockWaitRowStat *lock_wait_row_stat = NULL;
+            if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualLockWaitRowStat, lock_wait_row_stat))) {
+              SERVER_LOG(ERROR, "ObAllVirtualLockWaitRowStat construct failed", K(ret));
+            } else {
+              vt_iter = static_cast<ObVirtualTableIterator *>(lock_wait_row_stat);
+            }
+            break;
+          }
+          case OB_ALL_VIRTUAL_REPLAY_LAG_TID: {
+            ObAllVirtualReplayLag *replay_lag = NULL;
+            omt::ObMultiTenant *omt = GCTX.omt_;
+            if (OB_UNLIKELY(NULL == omt)) {
+              ret = OB_ERR_UNEXPECTED;
+              SERVER_LOG(WARN, "get tenant fail", K(ret));
+            } else if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualReplayLag, replay_lag, omt))) {
+              SERVER_LOG(ERROR, "ObAllVirtualReplayLag construct fail", K(ret));
+            } else {
+              vt_iter = static_cast<ObVirtualTableIterator *>(replay_lag);
+            }
+            break;
+          }
         END_CREATE_VT_ITER_SWITCH_LAMBDA
 
         BEGIN_CREATE_VT_ITER_SWITCH_LAMBDA
@@ -1900,6 +1925,15 @@ int ObVTIterCreator::create_vt_iter(ObVTableScanParam &params,
             }
             break;
           }
+          case OB_ALL_VIRTUAL_TENANT_WORKER_ADJUST_TID: {
+            ObAllVirtualTenantWorkerAdjust *worker_adjust = NULL;
+            if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualTenantWorkerAdjust, worker_adjust))) {
+              SERVER_LOG(ERROR, "ObAllVirtualTenantWorkerAdjust construct fail", K(ret));
+            } else {
+              vt_iter = static_cast<ObVirtualTableIterator *>(worker_adjust);
+            }
+            break;
+          }
           case OB_ALL_VIRTUAL_AUDIT_OPERATION_TID: {
             ObAllVirtualAuditOperationTable *audit_operation_table = NULL;
             if (OB_FAIL(NEW_VIRTUAL_TABLE(ObAllVirtualAuditOperationTable, audit_operation_table))) {
@@ -2019,6 +2019,47 @@ int ObPLCursorInfo::prepare_spi_cursor(ObSPICursor *&spi_cursor,
   return ret;
 }
 
+int ObPLCursorInfo::prepare_prefetch_buffer(ObSPIPrefetchBuffer *&buffer, uint64_t tenant_id)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator *spi_allocator = get_allocator();
+  void *ptr = NULL;
+  if (OB_NOT_NULL(prefetch_buffer_)) {
+    buffer = prefetch_buffer_;
+  } else if (OB_ISNULL(spi_allocator)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("cursor allocator is null.", K(ret), K(spi_allocator), K(id_));
+  } else if (OB_ISNULL(ptr = spi_allocator->alloc(sizeof(ObSPIPrefetchBuffer)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc prefetch buffer failed", K(ret), K(id_));
+  } else {
+    buffer = new (ptr) ObSPIPrefetchBuffer();
+    if (OB_FAIL(buffer->row_store_.init(GCONF._chunk_row_store_mem_limit,
+                                        tenant_id,
+                                        common::ObCtxIds::DEFAULT_CTX_ID,
+                                        "PSCursorPrefetch"))) {
+      LOG_WARN("init prefetch row store failed", K(ret), K(id_));
+      buffer->~ObSPIPrefetchBuffer();
+      spi_allocator->free(buffer);
+      buffer = NULL;
+    } else {
+      prefetch_buffer_ = buffer;
+    }
+  }
+  return ret;
+}
+
+void ObPLCursorInfo::reset_prefetch_buffer()
+{
+  if (OB_NOT_NULL(prefetch_buffer_)) {
+    prefetch_buffer_->~ObSPIPrefetchBuffer();
+    if (OB_NOT_NULL(get_allocator())) {
+      get_allocator()->free(prefetch_buffer_);
+    }
+    prefetch_buffer_ = NULL;
+  }
+}
+
 int ObPLCursorInfo::set_current_position(int64_t position) {
   int ret = OB_SUCCESS;
   if (!is_streaming()) {
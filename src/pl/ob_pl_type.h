@@ -45,6 +45,7 @@ class ObSqlExpression;
 class ObRawExprFactory;
 class ObExecContext;
 struct ObSPICursor;
+struct ObSPIPrefetchBuffer;
 class ObSPIResultSet;
 class ObSQLSessionInfo;
 }
@@ -737,7 +738,8 @@ public:
     cursor_flag_(CURSOR_FLAG_UNDEF),
     ref_count_(0),
     is_scrollable_(false),
-    last_execute_time_(0)
+    last_execute_time_(0),
+    prefetch_buffer_(NULL)
   {
     reset();
   }
@@ -755,7 +757,8 @@ public:
     is_scrollable_(false),
     snapshot_(),
     is_need_check_snapshot_(false),
-    last_execute_time_(0)
+    last_execute_time_(0),
+    prefetch_buffer_(NULL)
   {
     reset();
   }
@@ -774,6 +777,7 @@ public:
   void reuse()
   {
     // reuse接口不充值id
+    reset_prefetch_buffer();
     if (nullptr != entity_) {
       DESTROY_CONTEXT(entity_);
       entity_ = nullptr;
@@ -942,6 +946,9 @@ public:
   int prepare_spi_cursor(sql::ObSPICursor *&spi_cursor,
                           uint64_t tenant_id,
                           uint64_t mem_limit);
+  int prepare_prefetch_buffer(sql::ObSPIPrefetchBuffer *&buffer, uint64_t tenant_id);
+  inline sql::ObSPIPrefetchBuffer *get_prefetch_buffer() const { return prefetch_buffer_; }
+  void reset_prefetch_buffer();
 
   TO_STRING_KV(K_(id),
                K_(is_explicit),
@@ -967,7 +974,8 @@ public:
                K_(is_scrollable),
                K_(snapshot),
                K_(is_need_check_snapshot),
-               K_(last_execute_time));
+               K_(last_execute_time),
+               KP_(prefetch_buffer));
 
 protected:
   int64_t id_;            // Cursor ID
@@ -998,6 +1006,7 @@ protected:
   transaction::ObTxReadSnapshot snapshot_;
   bool is_need_check_snapshot_;
   int64_t last_execute_time_; // 记录上一次cursor操作的时间点
+  sql::ObSPIPrefetchBuffer *prefetch_buffer_; // 流式cursor预取的行, 只用于ps cursor的fetch协议
 };
 
 class ObPLGetCursorAttrInfo
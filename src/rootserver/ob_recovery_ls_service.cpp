@@ -175,7 +175,6 @@ int ObRecoveryLSService::seek_log_iterator_(const int64_t sync_scn, PalfBufferIt
 int ObRecoveryLSService::process_ls_log_(const int64_t start_scn, PalfBufferIterator &iterator)
 {
   int ret = OB_SUCCESS;
-  palf::LogEntry log_entry;
   palf::LSN target_lsn;
   int64_t sync_scn = OB_INVALID_TIMESTAMP;
   if (OB_UNLIKELY(!inited_)) {
@@ -183,16 +182,16 @@ int ObRecoveryLSService::process_ls_log_(const int64_t start_scn, PalfBufferIter
     LOG_WARN("not init", KR(ret), K(inited_));
   }
   while (OB_SUCC(ret) && OB_SUCC(iterator.next())) {
-    if (OB_FAIL(iterator.get_entry(log_entry, target_lsn))) {
-      LOG_WARN("failed to get log", KR(ret), K(log_entry));
-    } else if (OB_ISNULL(log_entry.get_data_buf())) {
+    const char *log_buf = NULL;
+    int64_t log_length = 0;
+    // the payload of log entry is decompressed by iterator if needed
+    if (OB_FAIL(iterator.get_entry(log_buf, log_length, sync_scn, target_lsn))) {
+      LOG_WARN("failed to get log", KR(ret), K(target_lsn));
+    } else if (OB_ISNULL(log_buf)) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("log entry is null", KR(ret));
     } else {
-      LOG_DEBUG("get log", K(log_entry), K(target_lsn), K(start_scn));
-      sync_scn = log_entry.get_log_ts();
-      const char *log_buf = log_entry.get_data_buf();
-      const int64_t log_length = log_entry.get_data_len();
+      LOG_DEBUG("get log", K(log_length), K(target_lsn), K(start_scn), K(sync_scn));
       logservice::ObLogBaseHeader header;
       const int64_t HEADER_SIZE = header.get_serialize_size();
       int64_t log_pos = 0;
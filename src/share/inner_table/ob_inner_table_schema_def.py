@@ -10771,6 +10771,93 @@ def_table_schema(
 # 12339: __all_virtual_show_trace
 # 12340: __all_virtual_ha_diagnose
 
+def_table_schema(
+  owner = 'shanyan.g',
+  table_name = '__all_virtual_lock_wait_row_stat',
+  table_id = '12341',
+  table_type = 'VIRTUAL_TABLE',
+  gm_columns = [],
+  in_tenant_space = False,
+  rowkey_columns = [
+  ],
+
+  normal_columns = [
+  ('svr_ip', 'varchar:MAX_IP_ADDR_LENGTH'),
+  ('svr_port', 'int'),
+  ('tenant_id', 'int'),
+  ('tablet_id', 'int'),
+  ('rowkey', 'varchar:512'),
+  ('wait_count', 'int'),
+  ('wakeup_count', 'int'),
+  ('handoff_count', 'int'),
+  ('total_wait_time', 'int'),
+  ('max_wait_time', 'int'),
+  ('last_wait_ts', 'int')
+  ],
+
+  partition_columns = ['svr_ip', 'svr_port'],
+  vtable_route_policy = 'distributed',
+)
+
+def_table_schema(
+  owner = 'keqing.llt',
+  table_name = '__all_virtual_replay_lag',
+  table_id = '12342',
+  table_type = 'VIRTUAL_TABLE',
+  gm_columns = [],
+  in_tenant_space = False,
+  rowkey_columns = [
+  ],
+
+  normal_columns = [
+    ('svr_ip', 'varchar:MAX_IP_ADDR_LENGTH'),
+    ('svr_port', 'int'),
+    ('tenant_id', 'int'),
+    ('ls_id', 'int'),
+    ('role', 'varchar:32'),
+    ('end_lsn', 'uint'),
+    ('min_unreplayed_lsn', 'uint'),
+    ('min_unreplayed_log_scn', 'uint'),
+    ('unreplayed_log_size', 'int'),
+    ('pending_cnt', 'int'),
+    ('replay_lag', 'int'),
+  ],
+
+  partition_columns = ['svr_ip', 'svr_port'],
+  vtable_route_policy = 'distributed',
+)
+
+def_table_schema(
+  owner = 'nijia.nj',
+  table_name = '__all_virtual_tenant_worker_adjust',
+  table_id = '12343',
+  table_type = 'VIRTUAL_TABLE',
+  gm_columns = [],
+  in_tenant_space = False,
+  rowkey_columns = [
+  ],
+
+  normal_columns = [
+    ('svr_ip', 'varchar:MAX_IP_ADDR_LENGTH'),
+    ('svr_port', 'int'),
+    ('tenant_id', 'int'),
+    ('adjust_time', 'int'),
+    ('old_worker_cnt', 'int'),
+    ('new_worker_cnt', 'int'),
+    ('min_worker_cnt', 'int'),
+    ('max_worker_cnt', 'int'),
+    ('avg_queue_time', 'int'),
+    ('throughput', 'int'),
+    ('busy_workers', 'double'),
+    ('cpu_usage', 'double'),
+    ('queue_length', 'int'),
+    ('reason', 'varchar:32'),
+  ],
+
+  partition_columns = ['svr_ip', 'svr_port'],
+  vtable_route_policy = 'distributed',
+)
+
 #
 # 余留位置
 #
@@ -73,6 +73,21 @@ DEF_INT(rdma_io_thread_count, OB_CLUSTER_PARAMETER, "0", "[0,8]",
 DEF_INT(tenant_task_queue_size, OB_CLUSTER_PARAMETER, "65536", "[1024,]",
         "the size of the task queue for each tenant. Range: [1024,+∞)",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_tenant_req_queue_shard_count, OB_CLUSTER_PARAMETER, "1", "[1,64]",
+        "the number of shards of the request queue of each tenant and resource group, "
+        "workers pop requests from its own shard first and steal from the others when idle. "
+        "It takes effect on tenants created afterwards. Range: [1, 64]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_adaptive_tenant_worker, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the active worker count of each tenant is adjusted by the measured "
+         "request queueing time and cpu usage, between the count given by cpu_quota_concurrency "
+         "and the bound given by workers_per_cpu_quota. "
+         "Value:  True:turned on;  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_adaptive_tenant_worker_target_queue_time, OB_CLUSTER_PARAMETER, "1ms", "[100us, 1s]",
+         "the average request queueing time the adaptive tenant worker tries to keep under. "
+         "Range: [100us, 1s]",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_CAP_WITH_CHECKER(memory_limit, OB_CLUSTER_PARAMETER, "0",
         common::ObConfigMemoryLimitChecker, "[0M,)",
         "the size of the memory reserved for internal use(for testing purpose), 0 means follow memory_limit_percentage. Range: 0, [4G,).",
@@ -133,6 +148,12 @@ DEF_TIME(dead_socket_detection_timeout, OB_CLUSTER_PARAMETER, "3s", "[0s,2h]",
 DEF_BOOL(enable_perf_event, OB_CLUSTER_PARAMETER, "True",
          "specifies whether to enable perf event feature. The default value is True.",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_perf_event_sample_percentage, OB_CLUSTER_PARAMETER, "100", "[1,100]",
+        "the percentage of requests whose wait events are counted into the session and tenant "
+        "wait event statistics when enable_perf_event is True, the statistics of sampled requests "
+        "are scaled accordingly. The per-request wait info of sql audit, session wait and ASH "
+        "is always recorded. Range: [1,100]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_upgrade_mode, OB_CLUSTER_PARAMETER, "False",
          "specifies whether upgrade mode is turned on. "
          "If turned on, daily merger and balancer will be disabled. "
@@ -491,17 +512,15 @@ DEF_INT(log_disk_percentage, OB_CLUSTER_PARAMETER, "0", "[0,99]",
         " b) if the data and the log are on the different disks, means log_disk_perecentage = 90",
         ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
-// TODO(xianlin.lh): add the feature on 4.1
-//DEF_BOOL(clog_transport_compress_all, OB_CLUSTER_PARAMETER, "False",
-//         "If this option is set to true, use compression for clog transport. "
-//         "The default is false(no compression)",
-//         ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(clog_transport_compress_all, OB_CLUSTER_PARAMETER, "False",
+         "If this option is set to true, the log entries are compressed by leader before they are "
+         "replicated, archived and fetched by CDC. The default is false(no compression)",
+         ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
-// TODO(xianlin.lh): add the feature on 4.1
-//DEF_STR_WITH_CHECKER(clog_transport_compress_func, OB_CLUSTER_PARAMETER, "lz4_1.0",
-//                     common::ObConfigBatchRpcCompressFuncChecker,
-//                     "compressor used for clog transport. Values: none, lz4_1.0, zstd_1.0, zstd_1.3.8",
-//                     ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(clog_transport_compress_func, OB_CLUSTER_PARAMETER, "lz4_1.0",
+                     common::ObConfigCompressFuncChecker,
+                     "compressor used for clog transport. Values: none, lz4_1.0, zstd_1.0, zstd_1.3.8",
+                     ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 // TODO(xianlin.lh): add the feature on 4.1
 //DEF_BOOL(enable_clog_persistence_compress, OB_TENANT_PARAMETER, "False",
@@ -546,6 +565,15 @@ DEF_INT(log_disk_utilization_threshold, OB_TENANT_PARAMETER,"80",
         "Range: [10, 100)",
         ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_CAP(_log_fetch_stream_window_size, OB_CLUSTER_PARAMETER, "0M", "[0M, 32M]",
+        "the maximum size of logs which leader pushes to a lagging follower before they are acked, "
+        "0 means leader only sends logs on the fetch requests of follower. Range: [0M, 32M]",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_log_aio_max_inflight_count, OB_CLUSTER_PARAMETER, "0", "[0, 64]",
+        "the maximum count of clog writes in flight of each log io worker, "
+        "0 means clog is written synchronously. Range: [0, 64]",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+
 // ========================= LogService Config End   =====================
 DEF_INT(resource_hard_limit, OB_CLUSTER_PARAMETER, "100", "[100, 10000]",
         "system utilization should not be large than resource_hard_limit",
@@ -658,11 +686,29 @@ DEF_BOOL(enable_early_lock_release, OB_TENANT_PARAMETER, "False",
 DEF_TIME(_ob_get_gts_ahead_interval, OB_CLUSTER_PARAMETER, "0s", "[0s, 1s]",
          "get gts ahead interval. Range: [0s, 1s]",
          ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_gts_rpc_coalesce_window, OB_CLUSTER_PARAMETER, "0ms", "[0ms, 1s]",
+         "the time within which concurrent gts requests wait for the in-flight gts rpc "
+         "instead of sending a new one, a coalesced request may wait up to two rpc round trips. "
+         "0 means disable coalescing. Range: [0ms, 1s]",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_lock_wait_direct_handoff, OB_CLUSTER_PARAMETER, "True",
+         "specifies whether the row lock is handed off to the request waked up from the row, "
+         "so that the next waiter is waked up when the row is released rather than when the request ends. "
+         "Value:  True:turned on;  False: turned off",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_memstore_row_compress_threshold, OB_CLUSTER_PARAMETER, "0", "[0, 64M]",
+        "the row image written into memstore is compressed with lz4 when it is not shorter than the value. "
+        "0 means disable compression. Range: [0, 64M]",
+        ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //// rpc config
 DEF_TIME(rpc_timeout, OB_CLUSTER_PARAMETER, "2s",
          "the time during which a RPC request is permitted to execute before it is terminated",
          ObParameterAttr(Section::RPC, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_rpc_batch_window, OB_CLUSTER_PARAMETER, "0us", "[0us, 10ms]",
+         "the time window in which small asynchronous RPC requests to the same server are merged into one packet. "
+         "0 means disabled, it should be turned on only when all servers in the cluster support it. Range: [0us, 10ms]",
+         ObParameterAttr(Section::RPC, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //// location cache config
 DEF_TIME(virtual_table_location_cache_expire_time, OB_CLUSTER_PARAMETER, "8s", "[1s,)",
@@ -783,6 +829,16 @@ DEF_INT(_fast_commit_callback_count, OB_CLUSTER_PARAMETER, "10000", "[0,)"
         "trigger max callback count allowed within transaction for durable callback checkpoint, 0 represents not allow durable callback"
         "Range: [0, not limited callback count",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_tx_end_parallel_callback_threshold, OB_CLUSTER_PARAMETER, "100000", "[0,)",
+        "the min callback count of a transaction whose callbacks are committed or aborted in parallel, "
+        "0 represents not allow parallel txn end. "
+        "Range: [0, not limited callback count",
+        ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_tx_replay_parallel_redo_row_threshold, OB_CLUSTER_PARAMETER, "2000", "[0,)",
+        "the min row count of a redo log whose rows are replayed in parallel by tablet and rowkey, "
+        "0 represents not allow parallel redo replay. "
+        "Range: [0, not limited row count",
+        ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_minor_compaction_amplification_factor, OB_TENANT_PARAMETER, "0", "[0,100]",
         "thre L1 compaction write amplification factor, 0 means default 25, Range: [0,100] in integer",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -1251,10 +1307,29 @@ DEF_TIME(ob_query_switch_leader_retry_timeout, OB_TENANT_PARAMETER, "0ms", "[0ms
 DEF_BOOL(default_enable_extended_rowid, OB_TENANT_PARAMETER, "false",
          "specifies whether to create table as extended rowid mode or not",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_ps_cursor_prefetch, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the next rows of streaming ps cursor are prefetched after the rows of "
+         "a fetch request are sent. Value: True: prefetch; False: produce rows when fetch request arrives",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_new_sql_nio, OB_CLUSTER_PARAMETER, "false",
 "specifies whether SQL serial network is turned on. Turned on to support mysql_send_long_data"
 "The default value is FALSE. Value: TRUE: turned on FALSE: turned off",
 ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_enable_sql_nio_io_uring, OB_CLUSTER_PARAMETER, "false",
+"specifies whether SQL serial network uses io_uring instead of epoll, it works when _enable_new_sql_nio is turned on "
+"and kernel supports it (6.0 or later), otherwise epoll is used. "
+"The default value is FALSE. Value: TRUE: turned on FALSE: turned off",
+ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_sql_nio_response_coalesce_size, OB_CLUSTER_PARAMETER, "0K", "[0K, 1M]",
+"the max size of responses held for pipelined requests of one connection in SQL serial network, "
+"held responses are written at once when no more request is received. held responses also wait for "
+"the next request to finish, so it should be enabled only if pipelined requests are short. "
+"0 means disabled. The default value is 0. Range: [0K, 1M]",
+ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_sql_nio_response_coalesce_time, OB_CLUSTER_PARAMETER, "1ms", "[0ms, 100ms]",
+"the max time since the first held response of one connection in SQL serial network, "
+"after which no more response is held. Range: [0ms, 100ms]",
+ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 // query response time
 DEF_BOOL(query_response_time_stats, OB_TENANT_PARAMETER, "False",
     "Enable or disable QUERY_RESPONSE_TIME statistics collecting"
@@ -15,6 +15,7 @@
 #include "sql/ob_sql_utils.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 
 using namespace oceanbase::common;
 
@@ -98,8 +99,10 @@ OB_DEF_SERIALIZE(ObDtlLinkedBuffer)
     if (buf_len - pos < size_) {
       ret = OB_SIZE_OVERFLOW;
     } else {
-      MEMCPY(buf + pos, buf_, size_);
-      pos += size_;
+      if (!obrpc::ObRpcSGPayload::reference(buf, buf_len, pos, buf_, size_, sg_ref_)) {
+        MEMCPY(buf + pos, buf_, size_);
+        pos += size_;
+      }
       LST_DO_CODE(OB_UNIS_ENCODE,
         is_data_msg_,
         seq_no_,
@@ -18,6 +18,9 @@
 #include "lib/container/ob_array_serialization.h"
 
 namespace oceanbase {
+namespace obrpc {
+class ObRpcSGRef;
+}
 namespace sql {
 namespace dtl {
 
@@ -133,7 +136,8 @@ public:
         flags_(0), dfo_key_(), use_interm_result_(false), batch_id_(0), batch_info_valid_(false),
         rows_cnt_(0), batch_info_(),
         dfo_id_(common::OB_INVALID_ID),
-        sqc_id_(common::OB_INVALID_ID)
+        sqc_id_(common::OB_INVALID_ID),
+        sg_ref_(NULL)
   {}
   ObDtlLinkedBuffer(char * buf, int64_t size)
       : buf_(buf), size_(size), pos_(), is_data_msg_(false), seq_no_(0), tenant_id_(0),
@@ -141,7 +145,8 @@ public:
         flags_(0), dfo_key_(), use_interm_result_(false), batch_id_(0), batch_info_valid_(false),
         rows_cnt_(0), batch_info_(),
         dfo_id_(common::OB_INVALID_ID),
-        sqc_id_(common::OB_INVALID_ID)
+        sqc_id_(common::OB_INVALID_ID),
+        sg_ref_(NULL)
   {}
   ~ObDtlLinkedBuffer() { reset_batch_info(); }
   TO_STRING_KV(K_(size), K_(pos), K_(is_data_msg), K_(seq_no), K_(tenant_id), K_(allocated_chid),
@@ -342,6 +347,9 @@ public:
   void set_dfo_id(int64_t dfo_id) { dfo_id_ = dfo_id; }
   int64_t get_dfo_id() { return dfo_id_; }
   int64_t get_sqc_id() { return sqc_id_; }
+  // 设置后序列化到 rpc 请求时只引用 buf_, 不拷贝
+  void set_sg_ref(obrpc::ObRpcSGRef *sg_ref) { sg_ref_ = sg_ref; }
+  obrpc::ObRpcSGRef *get_sg_ref() const { return sg_ref_; }
 
 private:
 /*
@@ -408,6 +416,8 @@ The memory layout is as below:
   common::ObSArray<ObDtlBatchInfo> batch_info_;
   int64_t dfo_id_;
   int64_t sqc_id_;
+  // only for sending by rpc, not serialized
+  obrpc::ObRpcSGRef *sg_ref_;
 };
 
 }  // dtl
@@ -22,6 +22,8 @@
 #include "sql/dtl/ob_dtl_channel_agent.h"
 #include "share/rc/ob_context.h"
 #include "sql/dtl/ob_dtl_channel_watcher.h"
+#include "sql/dtl/ob_dtl_tenant_mem_manager.h"
+#include "rpc/obrpc/ob_rpc_sg_payload.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::share;
@@ -264,6 +266,45 @@ int ObDtlRpcChannel::feedup(ObDtlLinkedBuffer *&buffer)
   return ret;
 }
 
+// 发送中的 buffer 被 rpc 包引用, 最后一个引用释放时归还给租户的 dtl 内存
+class ObDtlSendBufferRef : public obrpc::ObRpcSGRef
+{
+public:
+  ObDtlSendBufferRef(uint64_t tenant_id, ObDtlLinkedBuffer *buf)
+      : tenant_id_(tenant_id), buf_(buf) {}
+  static ObDtlSendBufferRef *create(uint64_t tenant_id, ObDtlLinkedBuffer *buf)
+  {
+    ObDtlSendBufferRef *ref = NULL;
+    void *ptr = ob_malloc(sizeof(ObDtlSendBufferRef), ObModIds::OB_SQL_DTL);
+    if (NULL != ptr) {
+      ref = new (ptr) ObDtlSendBufferRef(tenant_id, buf);
+    }
+    return ref;
+  }
+  // buffer 仍归 channel 所有, 例如发送失败后留着重试
+  void detach() { buf_ = NULL; }
+protected:
+  virtual void release() override
+  {
+    int ret = OB_SUCCESS;
+    if (NULL != buf_) {
+      ObDtlTenantMemManager *tenant_mem_mgr = DTL.get_dfc_server().get_tenant_mem_manager(tenant_id_);
+      if (nullptr == tenant_mem_mgr) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("tenant_mem_mgr is null", K(tenant_id_), K(ret));
+      } else if (OB_FAIL(tenant_mem_mgr->free(buf_))) {
+        LOG_WARN("failed to free buffer", K(ret), K(tenant_id_));
+      }
+      buf_ = NULL;
+    }
+    this->~ObDtlSendBufferRef();
+    ob_free(this);
+  }
+private:
+  uint64_t tenant_id_;
+  ObDtlLinkedBuffer *buf_;
+};
+
 int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
 {
   int ret = OB_SUCCESS;
@@ -305,6 +346,12 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
     // we wait first message return and retry until peer setup.
     int64_t timeout_us = buf->timeout_ts() - ObTimeUtility::current_time();
     SendMsgCB cb(msg_response_, *cur_trace_id);
+    ObDtlSendBufferRef *sg_ref = NULL;
+    if (buf->size() >= obrpc::ObRpcSGPayload::MIN_SEGMENT_SIZE) {
+      // 大 buffer 交给 rpc 层引用发送, 省掉一次拷贝. 压缩发送时 rpc 层仍会拷贝
+      sg_ref = ObDtlSendBufferRef::create(tenant_id_, buf);
+      buf->set_sg_ref(sg_ref);
+    }
     if (timeout_us <= 0) {
       ret = OB_TIMEOUT;
       LOG_WARN("send dtl message timeout", K(ret), K(peer_),
@@ -320,6 +367,17 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
         LOG_WARN("set start fail failed", K(tmp_ret));
       }
     }
+    if (NULL != sg_ref) {
+      buf->set_sg_ref(NULL);
+      if (OB_SUCC(ret)) {
+        // buffer 由 sg_ref 释放, 调用者不再持有
+        free_buffer_count();
+        buf = nullptr;
+      } else {
+        sg_ref->detach();
+      }
+      sg_ref->dec_ref();
+    }
     // 1) for data message, if dtl channel is not built, it's cached by first buffer manage,
     //    it's processed rightly, or it's drain
     //    so don't wait first response
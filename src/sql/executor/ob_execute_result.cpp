@@ -85,6 +85,57 @@ int ObExecuteResult::get_next_row(ObExecContext &ctx, const common::ObNewRow *&r
   return ret;
 }
 
+int ObExecuteResult::get_next_datum_row(ObExecContext &ctx, const common::ObDatum **&datums)
+{
+  int ret = OB_SUCCESS;
+  datums = NULL;
+  if (OB_ISNULL(static_engine_root_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), KP(static_engine_root_));
+  } else {
+    const ObOpSpec &spec = static_engine_root_->get_spec();
+    ObEvalCtx &eval_ctx = static_engine_root_->get_eval_ctx();
+    if (spec.output_.count() > 0 && NULL == datums_) {
+      if (OB_ISNULL(datums_ = static_cast<const ObDatum **>(
+                  ctx.get_allocator().alloc(sizeof(ObDatum *) * spec.output_.count())))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (!spec.is_vectorized()) {
+      ret = get_next_row();
+      for (int64_t i = 0; OB_SUCC(ret) && i < spec.output_.count(); i++) {
+        ObDatum *datum = NULL;
+        if (OB_FAIL(spec.output_.at(i)->eval(eval_ctx, datum))) {
+          LOG_WARN("expr evaluate failed", K(ret));
+        } else {
+          datums_[i] = datum;
+        }
+      }
+    } else {
+      ret = br_it_.get_next_row();
+      if (OB_SUCC(ret)) {
+        const int64_t idx = br_it_.cur_idx();
+        for (int64_t i = 0; i < spec.output_.count(); i++) {
+          ObExpr *expr = spec.output_.at(i);
+          // expressions are evaluated in get_next_batch(), get datum value directly
+          datums_[i] = expr->locate_batch_datums(eval_ctx) + (expr->is_batch_result() ? idx : 0);
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      datums = datums_;
+    }
+  }
+  return ret;
+}
+
+const ObExprPtrIArray *ObExecuteResult::get_output_exprs() const
+{
+  return NULL == static_engine_root_ ? NULL : &static_engine_root_->get_spec().output_;
+}
+
 int ObExecuteResult::close(ObExecContext &ctx)
 {
   int ret = OB_SUCCESS;
@@ -34,6 +34,15 @@ public:
   virtual int open(ObExecContext &ctx) = 0;
   virtual int get_next_row(ObExecContext &ctx, const common::ObNewRow *&row) = 0;
   virtual int close(ObExecContext &ctx) = 0;
+  // Get datums of output exprs directly, without converting to ObObj.
+  // Only supported by static engine executed locally, see get_output_exprs().
+  virtual int get_next_datum_row(ObExecContext &ctx, const common::ObDatum **&datums)
+  {
+    UNUSED(ctx);
+    UNUSED(datums);
+    return common::OB_NOT_SUPPORTED;
+  }
+  virtual const ObExprPtrIArray *get_output_exprs() const { return NULL; }
 };
 
 class ObExecuteResult : public ObIExecuteResult
@@ -43,12 +52,15 @@ class ObExecuteResult : public ObIExecuteResult
 public:
   ObExecuteResult()
     : err_code_(OB_ERR_UNEXPECTED),
-      static_engine_root_(NULL) {}
+      static_engine_root_(NULL),
+      datums_(NULL) {}
   virtual ~ObExecuteResult() {}
 
   virtual int open(ObExecContext &ctx) override;
   virtual int get_next_row(ObExecContext &ctx, const common::ObNewRow *&row) override;
   virtual int close(ObExecContext &ctx) override;
+  virtual int get_next_datum_row(ObExecContext &ctx, const common::ObDatum **&datums) override;
+  virtual const ObExprPtrIArray *get_output_exprs() const override;
 
   inline int get_err_code() { return err_code_; }
 
@@ -69,6 +81,8 @@ private:
   // row used to adapt old get_next_row interface.
   mutable common::ObNewRow row_;
   mutable ObBatchRowIter br_it_;
+  // datums used by get_next_datum_row interface, point to datums of output exprs.
+  const common::ObDatum **datums_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObExecuteResult);
 };
@@ -116,6 +116,12 @@ public:
   /// get the next result row
   /// @return OB_ITER_END when no more data available
   int get_next_row(const common::ObNewRow *&row);
+  /// get datums of output exprs of the next result row, without converting to ObObj
+  /// @note only valid when get_output_exprs() is not NULL
+  /// @return OB_ITER_END when no more data available
+  int get_next_datum_row(const common::ObDatum **&datums);
+  /// output exprs of static engine, NULL if result rows can not be got by get_next_datum_row
+  const ObExprPtrIArray *get_output_exprs() const;
   /// close the result set after get all the rows
   int close();
   /// get number of rows affected by INSERT/UPDATE/DELETE
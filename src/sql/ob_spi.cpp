@@ -83,6 +83,25 @@ namespace sql
     } \
   } while (0)
 
+int ObSPIPrefetchBuffer::get_next_row(ObPLCursorInfo &cursor, const ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+  row = NULL;
+  if (!has_row()) {
+    ret = OB_SUCCESS == end_ret_ ? OB_ITER_END : end_ret_;
+  } else if (OB_FAIL(row_store_.get_row(read_pos_, row))) {
+    LOG_WARN("get prefetched row failed", K(ret), K(read_pos_), K(cursor.get_id()));
+  } else if (OB_ISNULL(row)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("prefetched row is null", K(ret), K(read_pos_), K(cursor.get_id()));
+  } else if (OB_FAIL(cursor.set_rowcount(cursor.get_rowcount() + 1))) {
+    LOG_WARN("set rowcount failed", K(ret), K(cursor.get_id()));
+  } else {
+    read_pos_++;
+  }
+  return ret;
+}
+
 ObResultSet *ObSPIResultSet::get_result_set()
 {
   return NULL == mysql_result_.get_result()
@@ -49,6 +49,56 @@ struct ObSPICursor
   common::ColumnsFieldArray fields_;
 };
 
+// 流式cursor预取的行，在上一批结果发送给客户端的同时产生，下一次fetch时先读这里
+struct ObSPIPrefetchBuffer
+{
+  ObSPIPrefetchBuffer() : row_store_(), read_pos_(0), end_ret_(OB_SUCCESS) {}
+
+  inline bool has_row() const { return read_pos_ < row_store_.get_row_cnt(); }
+  // 预取的行已读完并且预取没有结束, 需要继续从cursor读
+  inline bool need_fetch_cursor() const { return !has_row() && OB_SUCCESS == end_ret_; }
+  inline void reuse()
+  {
+    row_store_.reuse();
+    read_pos_ = 0;
+  }
+  // 读下一行预取的行并计入cursor的rowcount, 读完之后返回预取遇到的OB_ITER_END或错误码
+  int get_next_row(pl::ObPLCursorInfo &cursor, const common::ObNewRow *&row);
+  // 用fetch_func从cursor读最多row_cnt行, 每次读到cursor的current row.
+  // 行在发送给客户端时才计入rowcount, 所以预取之后恢复cursor的rowcount
+  template <typename FetchFunc>
+  int prefetch(pl::ObPLCursorInfo &cursor, const int64_t row_cnt, FetchFunc &fetch_func);
+
+  ObRARowStore row_store_;
+  int64_t read_pos_;
+  int end_ret_; // 预取遇到的OB_ITER_END或错误码，读完预取的行之后返回
+};
+
+template <typename FetchFunc>
+int ObSPIPrefetchBuffer::prefetch(pl::ObPLCursorInfo &cursor, const int64_t row_cnt, FetchFunc &fetch_func)
+{
+  int ret = OB_SUCCESS;
+  int fetch_ret = OB_SUCCESS;
+  const int64_t rowcount = cursor.get_rowcount();
+  while (OB_SUCC(ret) && OB_SUCCESS == end_ret_ && row_store_.get_row_cnt() < row_cnt) {
+    if (OB_SUCCESS != (fetch_ret = fetch_func())) {
+      end_ret_ = fetch_ret;
+    } else if (OB_FAIL(row_store_.add_row(cursor.get_current_row()))) {
+      // row has been read from cursor, report error in next fetch
+      SQL_LOG(WARN, "add prefetched row failed", K(ret), K(cursor.get_id()));
+      end_ret_ = ret;
+    }
+  }
+  int finish_ret = row_store_.finish_add_row();
+  if (OB_SUCCESS != finish_ret) {
+    SQL_LOG(WARN, "finish add prefetched row failed", K(finish_ret), K(cursor.get_id()));
+    ret = OB_SUCCESS == ret ? finish_ret : ret;
+    end_ret_ = OB_SUCCESS == end_ret_ ? finish_ret : end_ret_;
+  }
+  IGNORE_RETURN cursor.set_rowcount(rowcount);
+  return ret;
+}
+
 struct ObSPIOutParams
 {
   ObSPIOutParams() : has_out_param_(false), out_params_() {}
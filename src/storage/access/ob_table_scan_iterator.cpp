@@ -522,6 +522,12 @@ int ObTableScanIterator::get_next_row(ObNewRow *&row)
       ret = tmp_ret;
     }
   }
+  if (OB_ITER_END == ret) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(wait_elr_dependency_if_needed_())) {
+      ret = tmp_ret;
+    }
+  }
   return ret;
 }
 
@@ -550,6 +556,12 @@ int ObTableScanIterator::get_next_rows(int64_t &count, int64_t capacity)
       ret = tmp_ret;
     }
   }
+  if (OB_ITER_END == ret) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(wait_elr_dependency_if_needed_())) {
+      ret = tmp_ret;
+    }
+  }
   return ret;
 }
 
@@ -566,5 +578,18 @@ int ObTableScanIterator::check_txn_status_if_read_uncommitted_()
   }
   return ret;
 }
+// the scan has read the data of txns which released their locks early and
+// whose commit logs may be not durable yet, wait for them before ending
+int ObTableScanIterator::wait_elr_dependency_if_needed_()
+{
+  int ret = OB_SUCCESS;
+  ObStoreCtx &store_ctx = ctx_guard_.get_store_ctx();
+  if (OB_LIKELY(!store_ctx.mvcc_acc_ctx_.has_elr_dependency())) {
+    // do nothing
+  } else if (OB_FAIL(MTL(transaction::ObTransService*)->wait_elr_dependency(store_ctx))) {
+    STORAGE_LOG(WARN, "wait elr dependency failed", K(ret), K(store_ctx));
+  }
+  return ret;
+}
 } // namespace storage
 } // namespace oceanbase
@@ -72,6 +72,7 @@ private:
   // for read uncommitted data, txn possible rollbacked before iterate
   // check txn status after read rows to ensure read result is correct
   int check_txn_status_if_read_uncommitted_();
+  int wait_elr_dependency_if_needed_();
   bool is_inited_;
   ObSingleMerge *single_merge_;
   ObMultipleGetMerge *get_merge_;
@@ -47,7 +47,8 @@ public:
       tx_ctx_(NULL),
       mem_ctx_(NULL),
       tx_scn_(-1),
-      handle_start_time_(OB_INVALID_TIMESTAMP)
+      handle_start_time_(OB_INVALID_TIMESTAMP),
+      elr_dependencies_()
   {}
   ~ObMvccAccessCtx() {
     type_ = T::INVL;
@@ -75,6 +76,7 @@ public:
     mem_ctx_ = NULL;
     tx_scn_ = -1;
     handle_start_time_ = OB_INVALID_TIMESTAMP;
+    elr_dependencies_.reset();
   }
   bool is_valid() const {
     switch(type_) {
@@ -202,6 +204,25 @@ public:
     }
     return expire_ts;
   }
+  // record the txn which has released its locks early and whose data is read
+  // by us without a participant on the ls, so that nothing orders our commit
+  // after its commit log, the read must wait for it to be decided.
+  int add_elr_dependency(const transaction::ObTransID &tx_id) {
+    int ret = common::OB_SUCCESS;
+    bool is_exist = false;
+    for (int64_t i = elr_dependencies_.count() - 1; !is_exist && i >= 0; i--) {
+      is_exist = (elr_dependencies_.at(i) == tx_id);
+    }
+    if (!is_exist) {
+      ret = elr_dependencies_.push_back(tx_id);
+    }
+    return ret;
+  }
+  bool has_elr_dependency() const { return !elr_dependencies_.empty(); }
+  const common::ObIArray<transaction::ObTransID> &get_elr_dependencies() const {
+    return elr_dependencies_;
+  }
+  void reset_elr_dependencies() { elr_dependencies_.reset(); }
   TO_STRING_KV(K_(type),
                K_(abs_lock_timeout),
                K_(tx_lock_timeout),
@@ -211,7 +232,8 @@ public:
                KPC_(tx_desc),
                KP_(tx_ctx),
                KP_(mem_ctx),
-               K_(tx_scn));
+               K_(tx_scn),
+               K_(elr_dependencies));
 private:
   void warn_tx_ctx_leaky_();
 public: // NOTE: those field should only be accessed by txn relative routine
@@ -241,6 +263,8 @@ public: // NOTE: those field should only be accessed by txn relative routine
 
   // this was used for runtime mertic
   int64_t handle_start_time_;
+  // the early released txns read by us, see add_elr_dependency
+  common::ObSEArray<transaction::ObTransID, 1> elr_dependencies_;
 };
 } // memtable
 } // oceanbase
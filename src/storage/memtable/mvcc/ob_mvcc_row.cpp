@@ -64,9 +64,23 @@ uint32_t ObMvccTransNode::m_cal_acc_checksum(const uint32_t last_acc_checksum) c
   return acc_checksum;
 }
 
-void ObMvccTransNode::cal_acc_checksum(const uint32_t last_acc_checksum)
+uint32_t ObMvccTransNode::m_cal_acc_checksum(const uint32_t last_acc_checksum,
+                                             const char *data,
+                                             const int64_t data_len) const
 {
-  acc_checksum_ = m_cal_acc_checksum(last_acc_checksum);
+  uint32_t acc_checksum = 0;
+  ObBatchChecksum bc;
+  bc.fill(&last_acc_checksum, sizeof(last_acc_checksum));
+  ((ObMemtableDataHeader *)buf_)->checksum(bc, data, data_len);
+  acc_checksum = static_cast<uint32_t>((bc.calc() ? : 1) & 0xffffffff);
+  return acc_checksum;
+}
+
+void ObMvccTransNode::cal_acc_checksum(const uint32_t last_acc_checksum,
+                                       const char *data,
+                                       const int64_t data_len)
+{
+  acc_checksum_ = m_cal_acc_checksum(last_acc_checksum, data, data_len);
   if (0 == last_acc_checksum) {
     TRANS_LOG(DEBUG, "calc first trans node checksum", K(last_acc_checksum), K(*this));
   }
@@ -1152,12 +1166,17 @@ void ObMvccRow::print_row()
   int ret = OB_SUCCESS;
   blocksstable::ObDatumRow datum_row;
   blocksstable::ObRowReader row_reader;
+  ObArenaAllocator allocator(ObModIds::OB_MEMSTORE);
   ObMvccRow *row = this;
   TRANS_LOG(INFO, "qianchen print row", K(*row));
   for (ObMvccTransNode *node = row->get_list_head(); OB_SUCC(ret) && OB_NOT_NULL(node); node = node->prev_) {
     const ObMemtableDataHeader *mtd = reinterpret_cast<const ObMemtableDataHeader *>(node->buf_);
+    const char *data = NULL;
+    int64_t data_len = 0;
     TRANS_LOG(INFO, "qianchen row: ", K(*node), K(mtd));
-    if (OB_FAIL(row_reader.read_row(mtd->buf_, mtd->buf_len_, nullptr, datum_row))) {
+    if (OB_FAIL(mtd->get_data(allocator, data, data_len))) {
+      TRANS_LOG(WARN, "Failed to get row data", K(ret));
+    } else if (OB_FAIL(row_reader.read_row(data, data_len, nullptr, datum_row))) {
       CLOG_LOG(WARN, "Failed to read datum row", K(ret));
     } else {
       TRANS_LOG(INFO, "    qianchen datum row: ", K(datum_row));
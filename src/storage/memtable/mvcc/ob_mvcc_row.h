@@ -81,7 +81,13 @@ public:
 
   // calc/verify the tx node checksum
   uint32_t m_cal_acc_checksum(const uint32_t last_acc_checksum) const;
-  void cal_acc_checksum(const uint32_t last_acc_checksum);
+  // data is the row image of the tx node returned by ObMemtableDataHeader::get_data
+  uint32_t m_cal_acc_checksum(const uint32_t last_acc_checksum,
+                              const char *data,
+                              const int64_t data_len) const;
+  void cal_acc_checksum(const uint32_t last_acc_checksum,
+                        const char *data,
+                        const int64_t data_len);
   int verify_acc_checksum(const uint32_t last_acc_checksum) const;
 
   // trans_commit/abort commit/abort the tx node
@@ -22,6 +22,8 @@
 #include "storage/memtable/ob_lock_wait_mgr.h"
 #include "storage/tx/ob_trans_ctx.h"
 #include "storage/tx/ob_trans_part_ctx.h"
+#include "storage/tx/ob_trans_service.h"
+#include "storage/memtable/mvcc/ob_tx_callback_worker.h"
 #include "ob_mvcc_ctx.h"
 #include "storage/memtable/ob_memtable_interface.h"
 
@@ -192,6 +194,35 @@ ObTransCallbackMgr::RDLockGuard::RDLockGuard(const SpinRWLock &rwlock)
   time_guard_.click();
 }
 
+// the innermost replay shard guard of the current thread, the guards of
+// different txns may be nested
+static RLOCAL(ObTransCallbackMgr::ReplayShardGuard *, replay_shard_guard);
+
+ObTransCallbackMgr::ReplayShardGuard::ReplayShardGuard(ObTransCallbackMgr &mgr,
+                                                       ObTxCallbackList &shard_list)
+  : mgr_(mgr), shard_list_(shard_list), prev_(replay_shard_guard)
+{
+  replay_shard_guard = this;
+}
+
+ObTransCallbackMgr::ReplayShardGuard::~ReplayShardGuard()
+{
+  replay_shard_guard = prev_;
+}
+
+ObTxCallbackList *ObTransCallbackMgr::get_replay_shard_list_()
+{
+  ObTxCallbackList *shard_list = NULL;
+  for (ReplayShardGuard *guard = replay_shard_guard;
+       OB_ISNULL(shard_list) && OB_NOT_NULL(guard);
+       guard = guard->get_prev()) {
+    if (&guard->get_mgr() == this) {
+      shard_list = &guard->get_shard_list();
+    }
+  }
+  return shard_list;
+}
+
 void ObTransCallbackMgr::reset()
 {
   int64_t stat = ATOMIC_LOAD(&parallel_stat_);
@@ -232,7 +263,10 @@ int ObTransCallbackMgr::append(ObITransCallback *node)
   if (OB_FAIL(before_append(node))) {
     TRANS_LOG(ERROR, "before_append failed", K(ret), K(node));
   } else {
-    if (PARALLEL_STMT == stat) {
+    ObTxCallbackList *shard_list = get_replay_shard_list_();
+    if (OB_NOT_NULL(shard_list)) {
+      ret = shard_list->append_callback(node);
+    } else if (PARALLEL_STMT == stat) {
       if (NULL == callback_lists_) {
         WRLockGuard guard(rwlock_);
         if (NULL == callback_lists_) {
@@ -559,7 +593,24 @@ void ObTransCallbackMgr::set_for_replay(const bool for_replay)
 
 int ObTransCallbackMgr::replay_fail(const int64_t log_timestamp)
 {
-  return callback_list_.replay_fail(log_timestamp);
+  int ret = OB_SUCCESS;
+  ObTxCallbackList *shard_list = get_replay_shard_list_();
+  if (OB_NOT_NULL(shard_list)) {
+    // the callbacks of this log replayed by the current thread are still on
+    // the shard list during the parallel redo replay
+    ret = shard_list->replay_fail(log_timestamp);
+  } else {
+    ret = callback_list_.replay_fail(log_timestamp);
+  }
+  return ret;
+}
+
+int64_t ObTransCallbackMgr::append_replay_shard_callbacks(ObTxCallbackList &shard_list,
+                                                          const int64_t cnt)
+{
+  const int64_t append_cnt = callback_list_.concat_callbacks(shard_list, cnt);
+  add_main_list_append_cnt(append_cnt);
+  return append_cnt;
 }
 
 int ObTransCallbackMgr::replay_succ(const int64_t log_timestamp)
@@ -576,7 +627,13 @@ int ObTransCallbackMgr::trans_end(const bool commit)
   // exists and some data is cached in callback_lists, we need merge them into
   // main callback_list
   merge_multi_callback_lists();
-  if (commit) {
+  bool is_done = false;
+  if (need_parallel_tx_end_()) {
+    ret = parallel_tx_end_(commit, is_done);
+  }
+  if (is_done) {
+    // callbacks have been processed in parallel
+  } else if (commit) {
     ret = callback_list_.tx_commit();
   } else {
     ret = callback_list_.tx_abort();
@@ -587,6 +644,115 @@ int ObTransCallbackMgr::trans_end(const bool commit)
   return ret;
 }
 
+bool ObTransCallbackMgr::need_parallel_tx_end_() const
+{
+  const int64_t threshold = GCONF._tx_end_parallel_callback_threshold;
+  return threshold > 0 && callback_list_.get_length() >= threshold;
+}
+
+// parallel_tx_end_ splits the callbacks by row into several lists and
+// commits or aborts them concurrently with the tenant callback workers. The
+// callbacks of the same row stay in one list with their original order, and
+// callbacks of different rows are independent during txn end just as the
+// callbacks of different txns are. is_done is false if the callbacks are not
+// processed and the caller should fall back to the serial way.
+int ObTransCallbackMgr::parallel_tx_end_(const bool commit, bool &is_done)
+{
+  int ret = OB_SUCCESS;
+  transaction::ObTransService *txs = MTL(transaction::ObTransService *);
+  ObTxCallbackWorker *worker = NULL;
+  is_done = false;
+
+  if (OB_ISNULL(txs)) {
+    // do nothing
+  } else if (FALSE_IT(worker = &txs->get_tx_callback_worker())) {
+  } else if (!worker->is_running() || worker->get_thread_cnt() <= 0) {
+    // do nothing
+  } else {
+    ret = parallel_tx_end_(commit,
+                           worker,
+                           MIN(worker->get_thread_cnt() + 1, MAX_TX_END_CALLBACK_LIST_COUNT),
+                           is_done);
+  }
+
+  return ret;
+}
+
+// The first list is processed by the current thread, and others are pushed
+// to the worker, or processed by the current thread if the worker is NULL or
+// busy. The left callbacks of the failed lists are put back to the main list.
+int ObTransCallbackMgr::parallel_tx_end_(const bool commit,
+                                         ObTxCallbackWorker *worker,
+                                         const int64_t list_cnt,
+                                         bool &is_done)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObTxCallbackList *lists = NULL;
+  ObTxCallbackListTask *tasks = NULL;
+  ObTxCallbackListTaskGroup group;
+  bool is_constructed = false;
+  is_done = false;
+
+  if (list_cnt <= 0) {
+    TRANS_LOG(WARN, "invalid list count for parallel tx end", K(list_cnt));
+  } else if (OB_SUCCESS != (tmp_ret = group.init(list_cnt))) {
+    TRANS_LOG(WARN, "init callback list task group failed", K(tmp_ret), K(list_cnt));
+  } else if (OB_ISNULL(lists = (ObTxCallbackList *)cb_allocator_.alloc(
+                         sizeof(ObTxCallbackList) * list_cnt))) {
+    TRANS_LOG(WARN, "alloc callback lists for parallel tx end failed", K(list_cnt));
+  } else if (OB_ISNULL(tasks = (ObTxCallbackListTask *)cb_allocator_.alloc(
+                         sizeof(ObTxCallbackListTask) * list_cnt))) {
+    TRANS_LOG(WARN, "alloc callback list tasks for parallel tx end failed", K(list_cnt));
+  } else {
+    const int64_t start_ts = ObTimeUtility::fast_current_time();
+    const int64_t total_cnt = callback_list_.get_length();
+    for (int64_t i = 0; i < list_cnt; ++i) {
+      new(lists + i) ObTxCallbackList(*this);
+      new(tasks + i) ObTxCallbackListTask();
+      tasks[i].init(lists + i, commit, &group);
+    }
+    is_constructed = true;
+    (void)callback_list_.split_callbacks(lists, list_cnt);
+    for (int64_t i = 1; i < list_cnt; ++i) {
+      if (lists[i].empty()) {
+        group.finish_one();
+      } else if (OB_ISNULL(worker)
+                 || OB_SUCCESS != (tmp_ret = worker->push(tasks + i))) {
+        tasks[i].run();
+      }
+    }
+    tasks[0].run();
+    group.wait();
+    for (int64_t i = 0; i < list_cnt; ++i) {
+      if (OB_SUCCESS != tasks[i].get_ret_code()) {
+        ret = tasks[i].get_ret_code();
+      }
+      if (!lists[i].empty()) {
+        (void)callback_list_.concat_callbacks(lists[i]);
+      }
+    }
+    is_done = true;
+    TRANS_LOG(INFO, "parallel tx end finished", K(ret), K(commit), K(list_cnt), K(total_cnt),
+              "used_time", ObTimeUtility::fast_current_time() - start_ts,
+              "trans_id", host_.get_tx_id());
+  }
+  if (is_constructed) {
+    for (int64_t i = 0; i < list_cnt; ++i) {
+      tasks[i].~ObTxCallbackListTask();
+      lists[i].~ObTxCallbackList();
+    }
+  }
+  if (OB_NOT_NULL(tasks)) {
+    cb_allocator_.free(tasks);
+  }
+  if (OB_NOT_NULL(lists)) {
+    cb_allocator_.free(lists);
+  }
+
+  return ret;
+}
+
 void ObTransCallbackMgr::calc_checksum_all()
 {
   callback_list_.tx_calc_checksum_all();
@@ -1065,14 +1231,21 @@ MutatorType ObMvccRowCallback::get_mutator_type() const
   return MutatorType::MUTATOR_ROW;
 }
 
-int ObMvccRowCallback::get_redo(RedoDataNode &redo_node)
+int ObMvccRowCallback::get_redo(RedoDataNode &redo_node, ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
+  const ObMemtableDataHeader *mtd = NULL;
+  const char *data = NULL;
+  int64_t data_len = 0;
   if (NULL == key_.get_rowkey() || NULL == tnode_) {
     ret = OB_ENTRY_NOT_EXIST;
   } else if (!is_link_) {
     ret = OB_STATE_NOT_MATCH;
     TRANS_LOG(ERROR, "get_redo: trans_nod not link", K(ret), K(*this));
+  } else if (FALSE_IT(mtd = reinterpret_cast<const ObMemtableDataHeader *>(tnode_->buf_))) {
+  } else if (OB_FAIL(mtd->get_data(allocator, data, data_len))) {
+    // the redo log always carries the uncompressed row image
+    TRANS_LOG(WARN, "get_redo: get row data failed", K(ret), K(*this));
   } else {
     uint32_t last_acc_checksum = 0;
     if (NULL != tnode_->prev_) {
@@ -1080,10 +1253,9 @@ int ObMvccRowCallback::get_redo(RedoDataNode &redo_node)
     } else {
       last_acc_checksum = 0;
     }
-    tnode_->cal_acc_checksum(last_acc_checksum);
-    const ObMemtableDataHeader *mtd = reinterpret_cast<const ObMemtableDataHeader *>(tnode_->buf_);
+    tnode_->cal_acc_checksum(last_acc_checksum, data, data_len);
     ObRowData new_row;
-    new_row.set(mtd->buf_, (int32_t)(data_size_ - sizeof(*mtd)));
+    new_row.set(data, (int32_t)data_len);
     redo_node.set(&key_,
                   old_row_,
                   new_row,
@@ -84,6 +84,7 @@ struct TableLockRedoDataNode
 
 class ObMemtableCtx;
 class ObTxCallbackList;
+class ObTxCallbackWorker;
 
 class ObITransCallbackIterator
 {
@@ -164,12 +165,31 @@ public:
     common::ObSimpleTimeGuard time_guard_; // print log and lbt, if the lock is held too much time.
     common::SpinRLockGuard lock_guard_;
   };
+  // ReplayShardGuard redirects the callbacks appended by the current thread
+  // into the shard list during the parallel redo replay, so that the replay
+  // executor can append them into the main list in the order of the leader
+  // after all shards are finished.
+  class ReplayShardGuard
+  {
+  public:
+    ReplayShardGuard(ObTransCallbackMgr &mgr, ObTxCallbackList &shard_list);
+    ~ReplayShardGuard();
+    ObTransCallbackMgr &get_mgr() { return mgr_; }
+    ObTxCallbackList &get_shard_list() { return shard_list_; }
+    ReplayShardGuard *get_prev() { return prev_; }
+  private:
+    ObTransCallbackMgr &mgr_;
+    ObTxCallbackList &shard_list_;
+    ReplayShardGuard *prev_;
+  };
 
   friend class ObITransCallbackIterator;
   enum { MAX_CALLBACK_LIST_COUNT = OB_MAX_CPU_NUM };
   enum {
     PARALLEL_STMT = -1
   };
+  // the max number of lists the callbacks are splited into during txn end
+  enum { MAX_TX_END_CALLBACK_LIST_COUNT = 64 };
 public:
   ObTransCallbackMgr(ObIMvccCtx &host, ObMemtableCtxCbAllocator &cb_allocator)
     : host_(host),
@@ -204,6 +224,8 @@ public:
   int trans_end(const bool commit);
   int replay_fail(const int64_t log_timestamp);
   int replay_succ(const int64_t log_timestamp);
+  // move the first cnt callbacks of the shard list into the main list
+  int64_t append_replay_shard_callbacks(ObTxCallbackList &shard_list, const int64_t cnt);
   int rollback_to(const int64_t seq_no,
                   const int64_t from_seq_no);
   void set_for_replay(const bool for_replay);
@@ -218,7 +240,14 @@ public:
   ObITransCallbackIterator end() { return ObITransCallbackIterator(get_guard_()); }
   common::SpinRWLock& get_rwlock() { return rwlock_; }
 private:
+  ObTxCallbackList *get_replay_shard_list_();
   void wakeup_waiting_txns_();
+  bool need_parallel_tx_end_() const;
+  int parallel_tx_end_(const bool commit, bool &is_done);
+  int parallel_tx_end_(const bool commit,
+                       ObTxCallbackWorker *worker,
+                       const int64_t list_cnt,
+                       bool &is_done);
 public:
   int calc_checksum_before_log_ts(const int64_t log_ts,
                                   uint64_t &checksum,
@@ -374,7 +403,8 @@ public:
   bool on_memtable(const ObIMemtable * const memtable) override;
   ObIMemtable *get_memtable() const override;
   virtual MutatorType get_mutator_type() const override;
-  int get_redo(RedoDataNode &node);
+  // the uncompressed row image referenced by the node is allocated from the allocator
+  int get_redo(RedoDataNode &node, common::ObIAllocator &allocator);
   ObIMvccCtx &get_ctx() const { return ctx_; }
   const ObRowData &get_old_row() const { return old_row_; }
   const ObMvccRow &get_mvcc_row() const { return value_; }
@@ -67,14 +67,19 @@ void ObQueryEngine::TableIndex::dump2text(FILE* fd)
   } else {
     blocksstable::ObRowReader row_reader;
     blocksstable::ObDatumRow datum_row;
+    ObArenaAllocator allocator(ObModIds::OB_MEMSTORE);
     for (int64_t row_idx = 0; OB_SUCC(ret) && OB_SUCC(iter.next_internal(true)); row_idx++) {
       const ObMemtableKey *key = iter.get_key();
       ObMvccRow *row = iter.get_value();
       fprintf(fd, "row_idx=%ld %s %s purged=%d\n", row_idx, to_cstring(*key), to_cstring(*row), iter.get_iter_flag() & ~STORE_ITER_ROW_PARTIAL);
       for (ObMvccTransNode *node = row->get_list_head(); OB_SUCC(ret) && OB_NOT_NULL(node); node = node->prev_) {
         const ObMemtableDataHeader *mtd = reinterpret_cast<const ObMemtableDataHeader *>(node->buf_);
+        const char *data = NULL;
+        int64_t data_len = 0;
         fprintf(fd, "\t%s dml=%d size=%ld\n", to_cstring(*node), mtd->dml_flag_, mtd->buf_len_);
-        if (OB_FAIL(row_reader.read_row(mtd->buf_, mtd->buf_len_, nullptr, datum_row))) {
+        if (OB_FAIL(mtd->get_data(allocator, data, data_len))) {
+          TRANS_LOG(WARN, "Failed to get row data", K(ret));
+        } else if (OB_FAIL(row_reader.read_row(data, data_len, nullptr, datum_row))) {
           TRANS_LOG(WARN, "Failed to read datum row", K(ret));
         } else {
           for (int64_t i = 0; OB_SUCC(ret) && i < datum_row.get_column_count(); i++) {
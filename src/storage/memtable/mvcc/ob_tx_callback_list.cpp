@@ -13,6 +13,8 @@
 #include "storage/memtable/mvcc/ob_tx_callback_list.h"
 #include "storage/memtable/mvcc/ob_mvcc_ctx.h"
 #include "share/config/ob_server_config.h"
+#include "storage/memtable/mvcc/ob_mvcc_trans_ctx.h"
+#include "lib/hash_func/murmur_hash.h"
 #include "storage/memtable/ob_memtable_key.h"
 #include "storage/tx/ob_trans_define.h"
 #include "storage/tx/ob_trans_part_ctx.h"
@@ -81,6 +83,70 @@ int64_t ObTxCallbackList::concat_callbacks(ObTxCallbackList &that)
   return cnt;
 }
 
+int64_t ObTxCallbackList::concat_callbacks(ObTxCallbackList &that, const int64_t cnt)
+{
+  int64_t concat_cnt = 0;
+
+  if (cnt <= 0 || that.empty()) {
+    // do nothing
+  } else if (cnt >= that.get_length()) {
+    concat_cnt = concat_callbacks(that);
+  } else {
+    SpinLockGuard this_lock(latch_);
+    SpinLockGuard that_lock(that.latch_);
+    ObITransCallback *this_tail = get_tail();
+    ObITransCallback *that_head = that.head_.get_next();
+    ObITransCallback *that_tail = that_head;
+    for (int64_t i = 1; i < cnt; ++i) {
+      that_tail = that_tail->get_next();
+    }
+    ObITransCallback *that_next = that_tail->get_next();
+    that.head_.set_next(that_next);
+    that_next->set_prev(&that.head_);
+    that_head->set_prev(this_tail);
+    this_tail->set_next(that_head);
+    that_tail->set_next(&head_);
+    head_.set_prev(that_tail);
+    length_ += cnt;
+    that.length_ -= cnt;
+    concat_cnt = cnt;
+  }
+
+  return concat_cnt;
+}
+
+int64_t ObTxCallbackList::split_callbacks(ObTxCallbackList *lists, const int64_t list_cnt)
+{
+  int64_t cnt = 0;
+
+  if (OB_ISNULL(lists) || list_cnt <= 0) {
+    TRANS_LOG(ERROR, "invalid argument", KP(lists), K(list_cnt));
+  } else if (empty()) {
+    // do nothing
+  } else {
+    SpinLockGuard this_lock(latch_);
+    ObITransCallback *next = NULL;
+    for (ObITransCallback *iter = head_.get_next(); iter != &head_; iter = next) {
+      next = iter->get_next();
+      int64_t slot = 0;
+      if (!iter->is_table_lock_callback()) {
+        const ObMvccRow *row = &(static_cast<ObMvccRowCallback *>(iter)->get_mvcc_row());
+        slot = common::murmurhash(&row, sizeof(row), 0) % list_cnt;
+      }
+      ObTxCallbackList &list = lists[slot];
+      // the lists are private to the caller, so no lock is needed
+      (void)list.get_tail()->append(iter);
+      list.length_++;
+      cnt++;
+    }
+    head_.set_prev(&head_);
+    head_.set_next(&head_);
+    length_ = 0;
+  }
+
+  return cnt;
+}
+
 int ObTxCallbackList::callback_(ObITxCallbackFunctor &functor)
 {
   return callback_(functor, get_guard(), get_guard());
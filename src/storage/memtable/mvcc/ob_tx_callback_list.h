@@ -48,6 +48,16 @@ public:
   // other. And it will return the concat number during concat_callbacks.
   int64_t concat_callbacks(ObTxCallbackList &other);
 
+  // concat_callbacks with cnt only moves the first cnt callbacks of other into
+  // itself in their order. It returns the concat number.
+  int64_t concat_callbacks(ObTxCallbackList &other, const int64_t cnt);
+
+  // split_callbacks will move all callbacks into the lists by the hash of the
+  // row they belong to and reset itself, so the callbacks of the same row keep
+  // their order in one list. All table lock callbacks go into the first list.
+  // It returns the split number.
+  int64_t split_callbacks(ObTxCallbackList *lists, const int64_t list_cnt);
+
   // remove_callbacks_for_fast_commit will remove all callbacks according to the
   // parameter _fast_commit_callback_count. It will only remove callbacks
   // without removing data by calling checkpoint_callback. So user need
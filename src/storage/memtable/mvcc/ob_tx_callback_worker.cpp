@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/mvcc/ob_tx_callback_worker.h"
+#include "storage/memtable/mvcc/ob_tx_callback_list.h"
+#include "share/ob_thread_mgr.h"
+#include "share/rc/ob_tenant_base.h"
+#include "lib/wait_event/ob_wait_event.h"
+
+namespace oceanbase
+{
+using namespace common;
+
+namespace memtable
+{
+
+int ObTxCallbackListTaskGroup::init(const int64_t task_cnt)
+{
+  int ret = OB_SUCCESS;
+
+  if (task_cnt <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", K(ret), K(task_cnt));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    TRANS_LOG(WARN, "thread cond init failed", K(ret));
+  } else {
+    task_cnt_ = task_cnt;
+    finished_cnt_ = 0;
+  }
+
+  return ret;
+}
+
+void ObTxCallbackListTaskGroup::finish_one()
+{
+  ObThreadCondGuard guard(cond_);
+  if (++finished_cnt_ >= task_cnt_) {
+    (void)cond_.signal();
+  }
+}
+
+void ObTxCallbackListTaskGroup::wait()
+{
+  ObThreadCondGuard guard(cond_);
+  while (finished_cnt_ < task_cnt_) {
+    (void)cond_.wait_us(WAIT_INTERVAL_US);
+  }
+}
+
+void ObTxCallbackListTask::init(ObTxCallbackList *callback_list,
+                                const bool is_commit,
+                                ObTxCallbackListTaskGroup *group)
+{
+  callback_list_ = callback_list;
+  is_commit_ = is_commit;
+  ret_code_ = OB_SUCCESS;
+  group_ = group;
+}
+
+void ObTxCallbackListTask::run()
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(callback_list_) || OB_ISNULL(group_)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(ERROR, "callback list task is not inited", K(ret), KP(this));
+  } else {
+    if (is_commit_) {
+      ret = callback_list_->tx_commit();
+    } else {
+      ret = callback_list_->tx_abort();
+    }
+    ATOMIC_STORE(&ret_code_, ret);
+    // NB: the task may be freed by the owner after it is finished
+    group_->finish_one();
+  }
+}
+
+int ObTxCallbackWorker::init()
+{
+  int ret = OB_SUCCESS;
+
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    TRANS_LOG(WARN, "ObTxCallbackWorker inited twice", KR(ret));
+  } else if (OB_FAIL(TG_CREATE_TENANT(lib::TGDefIDs::TxCallbackWorker, tg_id_))) {
+    TRANS_LOG(WARN, "thread pool init error", K(ret));
+  } else {
+    is_inited_ = true;
+    TRANS_LOG(INFO, "ObTxCallbackWorker inited success", KP(this));
+  }
+
+  return ret;
+}
+
+int ObTxCallbackWorker::push(ObTxCallbackListTask *task)
+{
+  int ret = OB_SUCCESS;
+
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+  } else if (!is_running()) {
+    ret = OB_NOT_RUNNING;
+  } else if (OB_ISNULL(task)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), KP(task));
+  } else {
+    ret = TG_PUSH_TASK(tg_id_, task);
+  }
+
+  return ret;
+}
+
+int ObTxCallbackWorker::start()
+{
+  int ret = OB_SUCCESS;
+
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "ObTxCallbackWorker is not inited", KR(ret));
+  } else if (is_running_) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(WARN, "ObTxCallbackWorker is already running", KR(ret));
+  } else if (OB_FAIL(TG_SET_HANDLER_AND_START(tg_id_, *this))) {
+    TRANS_LOG(WARN, "start tg thread", KR(ret));
+  } else {
+    thread_cnt_ = TG_GET_THREAD_CNT(tg_id_);
+    ATOMIC_STORE(&is_running_, true);
+    TRANS_LOG(INFO, "ObTxCallbackWorker start success", KP(this), K_(thread_cnt));
+  }
+
+  return ret;
+}
+
+void ObTxCallbackWorker::stop()
+{
+  if (!is_inited_) {
+    TRANS_LOG(WARN, "ObTxCallbackWorker is not inited");
+  } else if (!is_running_) {
+    TRANS_LOG(WARN, "ObTxCallbackWorker already has been stopped");
+  } else {
+    ATOMIC_STORE(&is_running_, false);
+    TG_STOP(tg_id_);
+    TRANS_LOG(INFO, "ObTxCallbackWorker stop success");
+  }
+}
+
+void ObTxCallbackWorker::wait()
+{
+  if (!is_inited_) {
+    TRANS_LOG(WARN, "ObTxCallbackWorker is not inited");
+  } else if (is_running_) {
+    TRANS_LOG(WARN, "ObTxCallbackWorker is running");
+  } else {
+    TG_WAIT(tg_id_);
+    TRANS_LOG(INFO, "ObTxCallbackWorker wait success");
+  }
+}
+
+void ObTxCallbackWorker::destroy()
+{
+  if (is_inited_) {
+    if (is_running_) {
+      stop();
+      wait();
+    }
+    TG_DESTROY(tg_id_);
+    tg_id_ = -1;
+    thread_cnt_ = 0;
+    is_inited_ = false;
+    TRANS_LOG(INFO, "ObTxCallbackWorker destroyed", KP(this));
+  }
+}
+
+void ObTxCallbackWorker::handle(void *task)
+{
+  if (NULL == task) {
+    TRANS_LOG(ERROR, "task is null", KP(task));
+  } else {
+    static_cast<ObTxCallbackListTask *>(task)->run();
+  }
+}
+
+} // memtable
+} // oceanbase
@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_MEMTABLE_MVCC_OB_TX_CALLBACK_WORKER
+#define OCEANBASE_STORAGE_MEMTABLE_MVCC_OB_TX_CALLBACK_WORKER
+
+#include "lib/atomic/ob_atomic.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/thread/thread_mgr_interface.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace memtable
+{
+
+class ObTxCallbackList;
+
+// ObTxCallbackListTaskGroup tracks the callback list tasks of one txn end,
+// the ending thread waits on it until all tasks are finished.
+class ObTxCallbackListTaskGroup
+{
+public:
+  ObTxCallbackListTaskGroup() : task_cnt_(0), finished_cnt_(0) {}
+  ~ObTxCallbackListTaskGroup() {}
+  int init(const int64_t task_cnt);
+  // the group must not be accessed by the task anymore after that because the
+  // owner may free it once all tasks are finished.
+  void finish_one();
+  void wait();
+  int64_t get_finished_cnt() const { return ATOMIC_LOAD(&finished_cnt_); }
+  TO_STRING_KV(K_(task_cnt), K_(finished_cnt));
+private:
+  static const int64_t WAIT_INTERVAL_US = 10 * 1000;
+  common::ObThreadCond cond_;
+  int64_t task_cnt_;
+  int64_t finished_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObTxCallbackListTaskGroup);
+};
+
+// ObTxCallbackListTask commits or aborts all callbacks on one callback list,
+// it is used to end a large txn whose callbacks are splited into several
+// independent lists.
+class ObTxCallbackListTask
+{
+public:
+  ObTxCallbackListTask()
+    : callback_list_(NULL),
+      is_commit_(false),
+      ret_code_(common::OB_SUCCESS),
+      group_(NULL) {}
+  ~ObTxCallbackListTask() {}
+  void init(ObTxCallbackList *callback_list,
+            const bool is_commit,
+            ObTxCallbackListTaskGroup *group);
+  // run the task and finish it in the group, the task must not be accessed
+  // by the worker anymore after that because the owner may free it.
+  void run();
+  int get_ret_code() const { return ATOMIC_LOAD(&ret_code_); }
+  TO_STRING_KV(KP_(callback_list), K_(is_commit), K_(ret_code));
+private:
+  ObTxCallbackList *callback_list_;
+  bool is_commit_;
+  int ret_code_;
+  ObTxCallbackListTaskGroup *group_;
+};
+
+// ObTxCallbackWorker is the tenant thread pool which processes the callback
+// lists of large txns in parallel during txn end.
+class ObTxCallbackWorker : public lib::TGTaskHandler
+{
+public:
+  ObTxCallbackWorker() : is_inited_(false), is_running_(false), tg_id_(-1), thread_cnt_(0) {}
+  ~ObTxCallbackWorker() { destroy(); }
+  int init();
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  int push(ObTxCallbackListTask *task);
+  bool is_running() const { return ATOMIC_LOAD(&is_running_); }
+  int64_t get_thread_cnt() const { return thread_cnt_; }
+public:
+  void handle(void *task);
+private:
+  bool is_inited_;
+  bool is_running_;
+  int tg_id_;
+  int64_t thread_cnt_;
+};
+
+} // memtable
+} // oceanbase
+
+#endif // OCEANBASE_STORAGE_MEMTABLE_MVCC_OB_TX_CALLBACK_WORKER
@@ -331,6 +331,10 @@ bool ObLockWaitMgr::wait(Node* node)
         }
       } else {
         wait_succ = true;
+        // the node can not be reposted by others until quiescent
+        if (is_rowkey_hash(hash)) {
+          record_row_wait_(*node);
+        }
       }
     }
     // 4. it should be promised that no other threads is visting the request if
@@ -352,8 +356,12 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
     node = fetch_waiter(hash);
 
     if (NULL != node) {
+      const int64_t wait_time = ObTimeUtility::current_time() - node->lock_ts_;
       EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
-      EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
+      EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, wait_time);
+      if (is_rowkey_hash(hash)) {
+        record_row_wakeup_(hash, wait_time);
+      }
       node->on_retry_lock(hash);
       (void)repost(node);
     }
@@ -381,6 +389,57 @@ ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
   return target;
 }
 
+int ObLockWaitMgr::get_next_row_stat(int64_t &slot_idx, ObRowContentionStat &stat)
+{
+  int ret = OB_ITER_END;
+  for (; OB_ITER_END == ret && slot_idx >= 0 && slot_idx < ROW_STAT_SLOT_COUNT; slot_idx++) {
+    RowStatSlot &slot = row_stat_slots_[slot_idx];
+    ObSpinLockGuard guard(slot.lock_);
+    if (slot.stat_.is_valid()) {
+      stat = slot.stat_;
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+void ObLockWaitMgr::record_row_wait_(const Node &node)
+{
+  const uint64_t hash = node.hash();
+  RowStatSlot &slot = get_row_stat_slot(hash);
+  ObSpinLockGuard guard(slot.lock_);
+  ObRowContentionStat &stat = slot.stat_;
+  if (stat.hash_ != hash) {
+    stat.reset();
+    stat.hash_ = hash;
+    stat.tablet_id_ = node.tablet_id_;
+    snprintf(stat.key_, sizeof(stat.key_), "%s", node.key_);
+  }
+  stat.wait_cnt_++;
+  stat.last_wait_ts_ = node.lock_ts_;
+}
+
+void ObLockWaitMgr::record_row_wakeup_(const uint64_t hash, const int64_t wait_time)
+{
+  RowStatSlot &slot = get_row_stat_slot(hash);
+  ObSpinLockGuard guard(slot.lock_);
+  ObRowContentionStat &stat = slot.stat_;
+  if (stat.hash_ == hash) {
+    stat.wakeup_cnt_++;
+    stat.total_wait_time_ += wait_time;
+    stat.max_wait_time_ = std::max(stat.max_wait_time_, wait_time);
+  }
+}
+
+void ObLockWaitMgr::record_row_handoff_(const uint64_t hash)
+{
+  RowStatSlot &slot = get_row_stat_slot(hash);
+  ObSpinLockGuard guard(slot.lock_);
+  if (slot.stat_.hash_ == hash) {
+    slot.stat_.handoff_cnt_++;
+  }
+}
+
 ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter(uint64_t hash)
 {
   Node* ret = NULL;
@@ -725,6 +784,29 @@ void ObLockWaitMgr::wakeup(const ObLockID &lock_id)
   wakeup(hash_lock_id(lock_id));
 }
 
+void ObLockWaitMgr::handoff_row_lock(const ObTabletID &tablet_id, const Key &key)
+{
+  if (0 != get_thread_hold_key()) {
+    handoff_row_lock_(hash_rowkey(tablet_id, key));
+  }
+}
+
+void ObLockWaitMgr::handoff_row_lock_(const uint64_t hash)
+{
+  uint64_t &hold_key = get_thread_hold_key();
+  if (0 != hold_key
+      && hold_key == hash
+      && NULL != get_thread_node()
+      && GCONF._enable_lock_wait_direct_handoff) {
+    // the row is locked by the request waked up from it, so the next waiter
+    // will be waked up when the row is released instead of the request ends
+    hold_key = 0;
+    EVENT_INC(MEMSTORE_WRITE_LOCK_HANDOFF_COUNT);
+    record_row_handoff_(hash);
+    TRANS_LOG(TRACE, "LockWaitMgr.handoff", K(hash));
+  }
+}
+
 int ObLockWaitMgr::fullfill_row_key(uint64_t hash, char *row_key, int64_t length)
 {
   int ret = OB_SUCCESS;
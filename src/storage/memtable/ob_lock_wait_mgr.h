@@ -37,6 +37,7 @@ namespace oceanbase
 namespace observer
 {
 class ObAllVirtualLockWaitStat;
+class ObAllVirtualLockWaitRowStat;
 }
 namespace memtable
 {
@@ -177,14 +178,49 @@ private:
 };
 /*******************************************/
 
+// contention statistics of a row which requests have waited on, displayed
+// in __all_virtual_lock_wait_row_stat
+struct ObRowContentionStat
+{
+  // same as the length of rowkey column of __all_virtual_lock_wait_row_stat
+  static const int64_t ROW_KEY_BUF_LENGTH = 512;
+  ObRowContentionStat() { reset(); }
+  void reset() { memset(this, 0, sizeof(*this)); }
+  bool is_valid() const { return 0 != hash_; }
+  TO_STRING_KV(K_(hash),
+               K_(tablet_id),
+               KCSTRING_(key),
+               K_(wait_cnt),
+               K_(wakeup_cnt),
+               K_(handoff_cnt),
+               K_(total_wait_time),
+               K_(max_wait_time),
+               K_(last_wait_ts));
+
+  uint64_t hash_;
+  uint64_t tablet_id_;
+  char key_[ROW_KEY_BUF_LENGTH];
+  // count of the requests parked on the row
+  int64_t wait_cnt_;
+  // count of the requests waked up from the row
+  int64_t wakeup_cnt_;
+  // count of the row locks handed off to the waked up request directly
+  int64_t handoff_cnt_;
+  int64_t total_wait_time_;
+  int64_t max_wait_time_;
+  int64_t last_wait_ts_;
+};
+
 class ObLockWaitMgr: public share::ObThreadPool
 {
 public:
   friend class ObDeadLockChecker;
   friend class observer::ObAllVirtualLockWaitStat;
+  friend class observer::ObAllVirtualLockWaitRowStat;
 
 public:
   enum { LOCK_BUCKET_COUNT = 16384};
+  enum { ROW_STAT_SLOT_COUNT = 512 };
   static const int64_t OB_SESSPAIR_COUNT = 16;
   typedef ObMemtableKey Key;
   typedef rpc::ObLockWaitNode Node;
@@ -261,11 +297,19 @@ public:
   void wakeup(const transaction::ObTransID &tx_id);
   // wakeup the request waiting on the tablelock.
   void wakeup(const transaction::tablelock::ObLockID &lock_id);
+  // The request waked up from the row has acquired the row lock, so the lock
+  // is handed off to it. The next waiter keeps waiting in FIFO order until the
+  // new holder releases the row, rather than being waked up when the request
+  // ends only to conflict with the new holder again.
+  void handoff_row_lock(const ObTabletID &tablet_id, const Key &key);
   // for deadlock
   DELEGATE_WITH_RET(row_holder_mapper_, set_hash_holder, void);
   DELEGATE_WITH_RET(row_holder_mapper_, reset_hash_holder, void);
   
   Node* next(Node*& iter, Node* target);
+  // iterate the contention statistics of the rows, OB_ITER_END is returned
+  // if there is no more rows
+  int get_next_row_stat(int64_t &slot_idx, ObRowContentionStat &stat);
 
   static Node*& get_thread_node()
   {
@@ -329,6 +373,22 @@ private:
     return ATOMIC_LOAD(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
   }
 
+  // the row statistics are kept in a direct-mapped array, a row evicts the
+  // former one which has the same slot when it is waited on
+  struct RowStatSlot
+  {
+    common::ObSpinLock lock_;
+    ObRowContentionStat stat_;
+  };
+  RowStatSlot &get_row_stat_slot(uint64_t hash)
+  {
+    return row_stat_slots_[(hash >> 1) % ROW_STAT_SLOT_COUNT];
+  }
+  void record_row_wait_(const Node &node);
+  void record_row_wakeup_(const uint64_t hash, const int64_t wait_time);
+  void record_row_handoff_(const uint64_t hash);
+  void handoff_row_lock_(const uint64_t hash);
+
 private:
   bool is_inited_;
   Hash hash_;
@@ -353,6 +413,7 @@ private:
   DeadlockedSessionArray deadlocked_sessions_[2];
 private:
   RowHolderMapper row_holder_mapper_;
+  RowStatSlot row_stat_slots_[ROW_STAT_SLOT_COUNT];
 };
 
 }; // end namespace memtable
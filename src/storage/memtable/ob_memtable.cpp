@@ -759,7 +759,8 @@ int ObMemtable::get(
     const storage::ObTableIterParam &param,
     storage::ObTableAccessContext &context,
     const ObDatumRowkey &rowkey,
-    blocksstable::ObDatumRow &row)
+    blocksstable::ObDatumRow &row,
+    ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
   ObMemtableKey parameter_mtk;
@@ -806,7 +807,7 @@ int ObMemtable::get(
         int64_t row_scn = 0;
         if (OB_FAIL(bitmap.init(out_cols.count(), store_rowkey->get_obj_cnt()))) {
           TRANS_LOG(WARN, "Failed to innt bitmap", K(ret), K(out_cols), KPC(store_rowkey));
-        } else if (OB_FAIL(ObReadRow::iterate_row(*read_info, *store_rowkey, *context.allocator_, value_iter, row, bitmap, row_scn))) {
+        } else if (OB_FAIL(ObReadRow::iterate_row(*read_info, *store_rowkey, allocator, value_iter, row, bitmap, row_scn))) {
           TRANS_LOG(WARN, "Failed to iterate row, ", K(ret), K(rowkey));
         } else {
           if (param.need_scn_) {
@@ -1088,8 +1089,10 @@ int ObMemtable::replay_row(ObStoreCtx &ctx,
     TRANS_LOG(ERROR, "Unexpected not exist trans node", K(ret), K(dml_flag), K(rowkey));
   } else {
     lib::CompatModeGuard compat_guard(mode_);
+    ObArenaAllocator compress_allocator(ObModIds::OB_MEMSTORE);
     ObMemtableData mtd(dml_flag, row.size_, row.data_);
     ObMemtableKey mtk;
+    compress_row_data(compress_allocator, mtd);
     ObTxNodeArg arg(&mtd,         /*memtable_data*/
                     NULL,         /*old_row*/
                     version,      /*memstore_version*/
@@ -2035,6 +2038,15 @@ void ObMemtable::set_minor_merged()
   minor_merged_time_ = ObTimeUtility::current_time();
 }
 
+void ObMemtable::compress_row_data(ObIAllocator &allocator, ObMemtableData &mtd) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(mtd.compress(GCONF._memstore_row_compress_threshold, allocator))) {
+    // the row image is kept uncompressed
+    TRANS_LOG(WARN, "compress row data failed", K(ret), K(mtd), K_(key));
+  }
+}
+
 int ObMemtable::check_standby_cluster_schema_condition_(ObStoreCtx &ctx,
                                                         const int64_t table_id,
                                                         const int64_t table_version)
@@ -2267,7 +2279,9 @@ int ObMemtable::set_(ObStoreCtx &ctx,
       ret = OB_ERR_UNEXPECTED;
       TRANS_LOG(ERROR, "Unexpected not exist trans node", K(ret), K(new_row));
     } else {
+      ObArenaAllocator compress_allocator(ObModIds::OB_MEMSTORE);
       ObMemtableData mtd(new_row.flag_.get_dml_flag(), len, buf);
+      compress_row_data(compress_allocator, mtd);
       ObTxNodeArg arg(&mtd,        /*memtable_data*/
           NULL == old_row ? NULL : &old_row_data,
           timestamp_,  /*memstore_version*/
@@ -2461,6 +2475,8 @@ int ObMemtable::mvcc_write_(storage::ObStoreCtx &ctx,
         TRANS_LOG(WARN, "lock wait mgr is null", K(ret));
       } else {
         p_lock_wait_mgr->set_hash_holder(key_.get_tablet_id(), *key, mem_ctx->get_tx_id());
+        // the row lock may be handed off to the request waked up from the row
+        p_lock_wait_mgr->handoff_row_lock(key_.get_tablet_id(), *key);
       }
     }
     /***********************/
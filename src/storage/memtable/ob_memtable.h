@@ -249,11 +249,14 @@ public:
   // rowkey is the row key used for read
   // range is the row key range used for scan
   // row/row_iter is the versioned value/value iterator for read
+  // allocator holds the decompressed row images referenced by row, it must
+  // live as long as the row may be referenced, like the memtable itself
   virtual int get(
       const storage::ObTableIterParam &param,
       storage::ObTableAccessContext &context,
       const blocksstable::ObDatumRowkey &rowkey,
-      blocksstable::ObDatumRow &row);
+      blocksstable::ObDatumRow &row,
+      common::ObIAllocator &allocator);
   virtual int get(
       const storage::ObTableIterParam &param,
       storage::ObTableAccessContext &context,
@@ -361,6 +364,10 @@ public:
   common::ObIAllocator &get_allocator() {return local_allocator_;}
   bool has_hotspot_row() const { return ATOMIC_LOAD(&contain_hotspot_row_); }
   void set_contain_hotspot_row() { return ATOMIC_STORE(&contain_hotspot_row_, true); }
+  // compress the row image before it is written into the trans node if it is
+  // not shorter than _memstore_row_compress_threshold, the compressed row image
+  // is allocated from the allocator
+  void compress_row_data(common::ObIAllocator &allocator, ObMemtableData &mtd) const;
   virtual int64_t get_upper_trans_version() const override;
   virtual int estimate_phy_size(const ObStoreRowkey* start_key, const ObStoreRowkey* end_key, int64_t& total_bytes, int64_t& total_rows) override;
   virtual int get_split_ranges(const ObStoreRowkey* start_key, const ObStoreRowkey* end_key, const int64_t part_cnt, common::ObIArray<common::ObStoreRange> &range_array) override;
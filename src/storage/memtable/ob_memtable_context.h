@@ -454,6 +454,7 @@ public:
   int64_t get_checksum() const { return trans_mgr_.get_checksum(); }
   int64_t get_tmp_checksum() const { return trans_mgr_.get_tmp_checksum(); }
   int64_t get_checksum_log_ts() const { return trans_mgr_.get_checksum_log_ts(); }
+  ObTransCallbackMgr &get_trans_callback_mgr() { return trans_mgr_; }
 public:
   // table lock.
   int enable_lock_table(storage::ObTableHandleV2 &handle);
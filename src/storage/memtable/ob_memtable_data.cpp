@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/ob_memtable_data.h"
+#include "lib/allocator/page_arena.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "lib/stat/ob_diagnose_info.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace memtable
+{
+
+int ObMemtableDataHeader::get_data(ObIAllocator &allocator,
+                                   const char *&data,
+                                   int64_t &data_len) const
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  char *buf = NULL;
+  int64_t decompress_len = 0;
+  if (!is_compressed()) {
+    data = buf_;
+    data_len = buf_len_;
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(LZ4_COMPRESSOR, compressor))) {
+    TRANS_LOG(WARN, "get compressor failed", K(ret));
+  } else if (OB_ISNULL(buf = (char *)allocator.alloc(data_len_))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc decompress buf failed", K(ret), K(*this));
+  } else if (OB_FAIL(compressor->decompress(buf_, buf_len_, buf, data_len_, decompress_len))) {
+    TRANS_LOG(WARN, "decompress row failed", K(ret), K(*this));
+  } else if (OB_UNLIKELY(decompress_len != data_len_)) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(ERROR, "decompressed row length mismatch", K(ret), K(decompress_len), K(*this));
+  } else {
+    data = buf;
+    data_len = decompress_len;
+    EVENT_INC(MEMSTORE_ROW_DECOMPRESS_COUNT);
+  }
+  return ret;
+}
+
+int ObMemtableDataHeader::checksum_compressed_(ObBatchChecksum &bc) const
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObModIds::OB_MEMSTORE);
+  const char *data = NULL;
+  int64_t data_len = 0;
+  if (OB_FAIL(get_data(allocator, data, data_len))) {
+    TRANS_LOG(ERROR, "get row data for checksum failed", K(ret), K(*this));
+  } else {
+    ret = checksum(bc, data, data_len);
+  }
+  return ret;
+}
+
+int ObMemtableData::compress(const int64_t threshold, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  int64_t max_overflow_size = 0;
+  int64_t buf_size = 0;
+  char *buf = NULL;
+  int64_t compress_len = 0;
+  if (threshold <= 0 || buf_len_ < threshold || data_len_ > 0 || buf_len_ > INT32_MAX) {
+    // do nothing
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(LZ4_COMPRESSOR, compressor))) {
+    TRANS_LOG(WARN, "get compressor failed", K(ret));
+  } else if (OB_FAIL(compressor->get_max_overflow_size(buf_len_, max_overflow_size))) {
+    TRANS_LOG(WARN, "get max overflow size failed", K(ret), K(*this));
+  } else if (FALSE_IT(buf_size = buf_len_ + max_overflow_size)) {
+  } else if (OB_ISNULL(buf = (char *)allocator.alloc(buf_size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "alloc compress buf failed", K(ret), K(buf_size));
+  } else if (OB_FAIL(compressor->compress(buf_, buf_len_, buf, buf_size, compress_len))) {
+    TRANS_LOG(WARN, "compress row failed", K(ret), K(*this));
+  } else if (compress_len >= buf_len_ - (buf_len_ >> 3)) {
+    // saves less than 1/8, keep the row image uncompressed for fast read
+  } else {
+    EVENT_INC(MEMSTORE_ROW_COMPRESS_COUNT);
+    EVENT_ADD(MEMSTORE_ROW_COMPRESS_SAVED_BYTES, buf_len_ - compress_len);
+    data_len_ = static_cast<int32_t>(buf_len_);
+    buf_len_ = compress_len;
+    buf_ = buf;
+  }
+  return ret;
+}
+
+} // namespace memtable
+} // namespace oceanbase
@@ -23,20 +23,32 @@ namespace oceanbase
 namespace memtable
 {
 // The structure actually written to MvccTransNode::buf_
+//
+// The row image in buf_ may be compressed with lz4 when it is large, in which
+// case data_len_ is the length of the row image before compression. Readers
+// get the row image through get_data(), and the checksum is always calculated
+// on the uncompressed row image so that replicas stay comparable.
 class ObMemtableDataHeader
 {
 public:
-  ObMemtableDataHeader(blocksstable::ObDmlFlag dml_flag, int64_t buf_len)
-      : dml_flag_(dml_flag), buf_len_(buf_len)
+  ObMemtableDataHeader(blocksstable::ObDmlFlag dml_flag, int64_t buf_len, int32_t data_len = 0)
+      : dml_flag_(dml_flag), data_len_(data_len), buf_len_(buf_len)
   {}
   ~ObMemtableDataHeader() {}
-  TO_STRING_KV(K_(dml_flag), K_(buf_len));
+  TO_STRING_KV(K_(dml_flag), K_(data_len), K_(buf_len));
   inline int64_t dup_size() const { return (sizeof(ObMemtableDataHeader) + buf_len_); }
+  inline bool is_compressed() const { return data_len_ > 0; }
+  inline int64_t get_data_len() const { return is_compressed() ? data_len_ : buf_len_; }
+  // the returned row image points to buf_ if it is not compressed,
+  // otherwise it is decompressed into the allocator
+  int get_data(common::ObIAllocator &allocator, const char *&data, int64_t &data_len) const;
   inline int checksum(common::ObBatchChecksum &bc) const
   {
     int ret = common::OB_SUCCESS;
     if (buf_len_ <= 0) {
       ret = common::OB_NOT_INIT;
+    } else if (is_compressed()) {
+      ret = checksum_compressed_(bc);
     } else {
       bc.fill(&dml_flag_, sizeof(dml_flag_));
       bc.fill(&buf_len_, sizeof(buf_len_));
@@ -44,6 +56,20 @@ public:
     }
     return ret;
   }
+  // same as checksum(bc), data is the row image returned by get_data(), so
+  // that a compressed row image need not be decompressed again
+  inline int checksum(common::ObBatchChecksum &bc, const char *data, const int64_t data_len) const
+  {
+    int ret = common::OB_SUCCESS;
+    if (buf_len_ <= 0) {
+      ret = common::OB_NOT_INIT;
+    } else {
+      bc.fill(&dml_flag_, sizeof(dml_flag_));
+      bc.fill(&data_len, sizeof(data_len));
+      bc.fill(data, data_len);
+    }
+    return ret;
+  }
 
   // the template parameter T supports ObMemtableData and ObMemtableDataHeader,
   // but in practice only ObMemtableDataHeader is involved in building.
@@ -55,14 +81,20 @@ public:
       ret = OB_NOT_INIT;
     } else if (OB_ISNULL(data->buf_) || 0 == data->buf_len_) {
       // do nothing
-    } else if (OB_ISNULL(new(new_data) ObMemtableDataHeader(data->dml_flag_, data->buf_len_))) {
+    } else if (OB_ISNULL(new(new_data) ObMemtableDataHeader(data->dml_flag_,
+                                                            data->buf_len_,
+                                                            data->data_len_))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
     } else {
       MEMCPY(new_data->buf_, data->buf_, data->buf_len_);
     }
     return ret;
   }
+private:
+  int checksum_compressed_(common::ObBatchChecksum &bc) const;
+public:
   blocksstable::ObDmlFlag dml_flag_;
+  int32_t data_len_;
   int64_t buf_len_;
   char buf_[0];
 };
@@ -72,21 +104,27 @@ class ObMemtableData
 {
 public:
   ObMemtableData(blocksstable::ObDmlFlag dml_flag, int64_t buf_len, const char *buf)
-      : dml_flag_(dml_flag), buf_len_(buf_len), buf_(buf)
+      : dml_flag_(dml_flag), data_len_(0), buf_len_(buf_len), buf_(buf)
   {}
   ~ObMemtableData() {}
-  TO_STRING_KV(K_(dml_flag), K_(buf_len));
+  TO_STRING_KV(K_(dml_flag), K_(data_len), K_(buf_len));
   void set(blocksstable::ObDmlFlag dml_flag, const int64_t data_len, char *buf)
   {
     dml_flag_ = dml_flag;
+    data_len_ = 0;
     buf_len_ = data_len;
     buf_ = buf;
   }
   // must use the size of ObMemtableDataHeader, since the actual structure
   // involved in dup is always ObMemtableDataHeader
   inline int64_t dup_size() const { return (sizeof(ObMemtableDataHeader) + buf_len_); }
+  // compress the row image with lz4 if it is not shorter than threshold, buf_
+  // is replaced by the compressed row image allocated from the allocator
+  // when compression saves enough memory
+  int compress(const int64_t threshold, common::ObIAllocator &allocator);
 
   blocksstable::ObDmlFlag dml_flag_;
+  int32_t data_len_;
   int64_t buf_len_;
   const char *buf_;
 };
@@ -156,7 +156,8 @@ public:
       const storage::ObTableIterParam &param,
       storage::ObTableAccessContext &context,
       const blocksstable::ObDatumRowkey &rowkey,
-      blocksstable::ObDatumRow &row) = 0;
+      blocksstable::ObDatumRow &row,
+      common::ObIAllocator &allocator) = 0;
 
   // Insert/Delete/Update row
   //
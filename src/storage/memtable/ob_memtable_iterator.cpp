@@ -47,7 +47,8 @@ ObMemtableGetIterator::ObMemtableGetIterator()
       context_(NULL),
       memtable_(NULL),
       rowkey_(NULL),
-      cur_row_()
+      cur_row_(),
+      decompress_allocator_(ObModIds::OB_MEMSTORE)
 {
 }
 
@@ -125,7 +126,8 @@ int ObMemtableGetIterator::inner_get_next_row(const ObDatumRow *&row)
                          *param_,
                          *context_,
                          *rowkey_,
-                         cur_row_))) {
+                         cur_row_,
+                         decompress_allocator_))) {
     TRANS_LOG(WARN, "memtable get fail",
               K(ret), "table_id", param_->table_id_, K(*rowkey_));
   } else {
@@ -145,6 +147,7 @@ void ObMemtableGetIterator::reset()
   memtable_ = NULL;
   rowkey_ = NULL;
   cur_row_.reset();
+  decompress_allocator_.reset();
 }
 
 /**
@@ -161,7 +164,8 @@ ObMemtableScanIterator::ObMemtableScanIterator()
       cur_range_(),
       row_iter_(),
       row_(),
-      iter_flag_(0)
+      iter_flag_(0),
+      decompress_allocator_(ObModIds::OB_MEMSTORE)
 {
   GARL_ADD(&active_resource_, "scan_iter");
 }
@@ -350,7 +354,7 @@ int ObMemtableScanIterator::inner_get_next_row(const ObDatumRow *&row)
         && value_iter->get_trans_node()->is_committed()) {
       is_committed = true;
     }
-    if (OB_FAIL(ObReadRow::iterate_row(*read_info_, *rowkey, *(context_->allocator_), *value_iter, row_, bitmap_, row_scn))) {
+    if (OB_FAIL(ObReadRow::iterate_row(*read_info_, *rowkey, decompress_allocator_, *value_iter, row_, bitmap_, row_scn))) {
       TRANS_LOG(WARN, "iterate_row fail", K(ret), K(*rowkey), KP(value_iter));
     } else {
       STORAGE_LOG(DEBUG, "chaser debug memtable next row", K(row_));
@@ -396,6 +400,7 @@ void ObMemtableScanIterator::reset()
   row_.reset();
   bitmap_.reuse();
   iter_flag_ = 0;
+  decompress_allocator_.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -409,7 +414,8 @@ ObMemtableMGetIterator::ObMemtableMGetIterator()
        rowkeys_(NULL),
        cols_map_(NULL),
        rowkey_iter_(0),
-       cur_row_()
+       cur_row_(),
+       decompress_allocator_(ObModIds::OB_MEMSTORE)
 {
 }
 
@@ -476,7 +482,8 @@ int ObMemtableMGetIterator::inner_get_next_row(const ObDatumRow *&row)
                            *param_,
                            *context_,
                            rowkeys_->at(rowkey_iter_),
-                           cur_row_))) {
+                           cur_row_,
+                           decompress_allocator_))) {
       TRANS_LOG(WARN, "memtable get fail",
                 K(ret), "table_id", param_->table_id_, "rowkey", rowkeys_->at(rowkey_iter_));
     } else {
@@ -497,6 +504,7 @@ void ObMemtableMGetIterator::reset()
   memtable_ = NULL;
   rowkeys_ = NULL;
   rowkey_iter_ = 0;
+  decompress_allocator_.reset();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -595,7 +603,7 @@ int ObMemtableMScanIterator::get_next_row_for_get(const ObDatumRow *&row)
     ret = OB_ITER_END; // should not happen
   } else {
     const ObDatumRange &range = ranges_->at(cur_range_pos_);
-    if (OB_FAIL(memtable_->get(*param_, *context_, range.get_start_key(), row_))) {
+    if (OB_FAIL(memtable_->get(*param_, *context_, range.get_start_key(), row_, decompress_allocator_))) {
       TRANS_LOG(WARN, "fail to get memtable row", K(ret), "table_id", param_->table_id_, "range", range);
     } else {
       row_.scan_index_ = cur_range_pos_;
@@ -703,7 +711,8 @@ ObMemtableMultiVersionScanIterator::ObMemtableMultiVersionScanIterator()
       scan_state_(SCAN_END),
       trans_version_col_idx_(-1),
       sql_sequence_col_idx_(-1),
-      row_checker_()
+      row_checker_(),
+      decompress_allocator_(ObModIds::OB_MEMSTORE)
 {
   GARL_ADD(&active_resource_, "scan_iter");
 }
@@ -1071,6 +1080,7 @@ void ObMemtableMultiVersionScanIterator::reset()
   trans_version_col_idx_ = -1;
   sql_sequence_col_idx_ = -1;
   row_checker_.reset();
+  decompress_allocator_.reset();
 }
 
 void ObMemtableMultiVersionScanIterator::row_reset()
@@ -1176,7 +1186,11 @@ int ObMemtableMultiVersionScanIterator::iterate_uncommitted_row_value_(ObDatumRo
           TRANS_LOG(WARN, "trans node value is null", K(ret), KP(trans_node), KP(mtd));
         } else {
           bool read_finished = false;
-          if (OB_FAIL(row_reader.read_memtable_row(mtd->buf_, mtd->buf_len_, *read_info_, row, bitmap_, read_finished))) {
+          const char *data = NULL;
+          int64_t data_len = 0;
+          if (OB_FAIL(mtd->get_data(decompress_allocator_, data, data_len))) {
+            TRANS_LOG(WARN, "Failed to get row data", K(ret), KPC(mtd));
+          } else if (OB_FAIL(row_reader.read_memtable_row(data, data_len, *read_info_, row, bitmap_, read_finished))) {
             TRANS_LOG(WARN, "Failed to read memtable row", K(ret));
           } else if (-1 == first_sql_sequence) { // record sql sequence
             first_sql_sequence = sql_seq;
@@ -1203,6 +1217,8 @@ int ObMemtableMultiVersionScanIterator::iterate_compacted_row_value_(ObDatumRow
   bool read_finished = false;
   const void *tnode = NULL;
   const ObMemtableDataHeader *mtd = NULL;
+  const char *data = NULL;
+  int64_t data_len = 0;
   row.row_flag_.set_flag(ObDmlFlag::DF_NOT_EXIST);
   row.snapshot_version_ = 0;
   bitmap_.reuse();
@@ -1223,7 +1239,9 @@ int ObMemtableMultiVersionScanIterator::iterate_compacted_row_value_(ObDatumRow
       if (row.row_flag_.is_not_exist()) {
         row.row_flag_.set_flag(mtd->dml_flag_);
       }
-      if (OB_FAIL(row_reader_.read_memtable_row(mtd->buf_, mtd->buf_len_, *read_info_, row, bitmap_, read_finished))) {
+      if (OB_FAIL(mtd->get_data(decompress_allocator_, data, data_len))) {
+        TRANS_LOG(WARN, "Failed to get row data", K(ret), KPC(mtd));
+      } else if (OB_FAIL(row_reader_.read_memtable_row(data, data_len, *read_info_, row, bitmap_, read_finished))) {
         TRANS_LOG(WARN, "Failed to read row without", K(ret));
       } else if (ObDmlFlag::DF_INSERT == mtd->dml_flag_ || ObDmlFlag::DF_DELETE == mtd->dml_flag_ || read_finished) {
         row.set_compacted_multi_version_row();
@@ -1231,7 +1249,7 @@ int ObMemtableMultiVersionScanIterator::iterate_compacted_row_value_(ObDatumRow
         if (ObDmlFlag::DF_INSERT == mtd->dml_flag_ && !read_finished) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("Unexpected not compact insert row", K(ret), K(row), K(bitmap_.get_nop_cnt()),
-                   KPC(reinterpret_cast<const ObRowHeader*>(mtd->buf_)), KPC_(read_info));
+                   KPC(reinterpret_cast<const ObRowHeader*>(data)), KPC_(read_info));
         }
         break;
       }
@@ -1246,11 +1264,12 @@ int ObMemtableMultiVersionScanIterator::iterate_multi_version_row_value_(ObDatum
   int ret = OB_SUCCESS;
   row.row_flag_.set_flag(ObDmlFlag::DF_NOT_EXIST);
   const void *tnode = NULL;
-  const void *data = NULL;
   int64_t trans_version = INT64_MIN;
   int64_t compare_trans_version = INT64_MAX;
   const ObVersionRange &version_range = context_->trans_version_range_;
   const ObMemtableDataHeader *mtd = NULL;
+  const char *data = NULL;
+  int64_t data_len = 0;
   if (OB_ISNULL(value_iter_)) {
     ret = OB_ERR_UNEXPECTED;
     TRANS_LOG(WARN, "Unexpected null value iter", K(ret), K(value_iter_));
@@ -1280,7 +1299,9 @@ int ObMemtableMultiVersionScanIterator::iterate_multi_version_row_value_(ObDatum
 
     bool read_finished = false;
     if (OB_FAIL(ret)) {
-    } else if (OB_FAIL(row_reader_.read_memtable_row(mtd->buf_, mtd->buf_len_, *read_info_, row, bitmap_, read_finished))) {
+    } else if (OB_FAIL(mtd->get_data(decompress_allocator_, data, data_len))) {
+      TRANS_LOG(WARN, "Failed to get row data", K(ret), KPC(mtd));
+    } else if (OB_FAIL(row_reader_.read_memtable_row(data, data_len, *read_info_, row, bitmap_, read_finished))) {
       TRANS_LOG(WARN, "Failed to read row without rowkey", K(ret));
     } else {
       if (compare_trans_version > trans_version) {
@@ -1300,7 +1321,7 @@ int ObMemtableMultiVersionScanIterator::iterate_multi_version_row_value_(ObDatum
         if (row.row_flag_.is_insert() && !read_finished) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("Unexpected not compact insert row", K(ret), K(row), K(bitmap_.get_nop_cnt()),
-                   KPC(reinterpret_cast<const ObRowHeader*>(mtd->buf_)), KPC_(read_info));
+                   KPC(reinterpret_cast<const ObRowHeader*>(data)), KPC_(read_info));
         }
       }
       if (trans_version > version_range.multi_version_start_
@@ -1371,7 +1392,11 @@ OB_INLINE int ObReadRow::iterate_row_value_(
       }
       TRANS_LOG(DEBUG, "row snapshot version", K(row.snapshot_version_));
 
-      if (OB_FAIL(reader.read_memtable_row(mtd->buf_, mtd->buf_len_, read_info, row, bitmap, read_finished))) {
+      const char *data = NULL;
+      int64_t data_len = 0;
+      if (OB_FAIL(mtd->get_data(allocator, data, data_len))) {
+        TRANS_LOG(WARN, "Failed to get row data", K(ret), KPC(mtd));
+      } else if (OB_FAIL(reader.read_memtable_row(data, data_len, read_info, row, bitmap, read_finished))) {
         TRANS_LOG(WARN, "Failed to read memtable row", K(ret));
       } else if (0 == row_scn) {
         row_scn = reinterpret_cast<const ObMvccTransNode *>(tnode)->trans_version_;
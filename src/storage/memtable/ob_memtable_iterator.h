@@ -111,6 +111,9 @@ private:
   ObIMemtable *memtable_;
   const blocksstable::ObDatumRowkey *rowkey_;
   blocksstable::ObDatumRow cur_row_;
+  // holds the decompressed row images until the iterator is reset, rows
+  // returned before may still be referenced by the caller
+  common::ObArenaAllocator decompress_allocator_;
 };
 
 class ObMemtableScanIterator : public ObIMemtableScanIterator
@@ -160,6 +163,9 @@ protected:
   blocksstable::ObDatumRow row_;
   ObNopBitMap bitmap_;
   uint8_t iter_flag_;
+  // holds the decompressed row images until the iterator is reset, rows
+  // returned before may still be referenced by the caller
+  common::ObArenaAllocator decompress_allocator_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -195,6 +201,9 @@ private:
   share::schema::ColumnMap *cols_map_;
   int64_t rowkey_iter_;
   blocksstable::ObDatumRow cur_row_;
+  // holds the decompressed row images until the iterator is reset, rows
+  // returned before may still be referenced by the caller
+  common::ObArenaAllocator decompress_allocator_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -309,6 +318,9 @@ protected:
   int32_t sql_sequence_col_idx_;
   blocksstable::ObRowReader row_reader_;
   ObOuputRowValidateChecker row_checker_;
+  // holds the decompressed row images until the iterator is reset, rows
+  // returned before may still be referenced by the caller
+  common::ObArenaAllocator decompress_allocator_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
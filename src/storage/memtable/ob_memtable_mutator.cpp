@@ -1175,6 +1175,23 @@ int ObMemtableMutatorIterator::iterate_next_row()
   return ret;
 }
 
+int ObMemtableMutatorIterator::set_row_pos(const int64_t pos)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(buf_.get_data())) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "not init", K(ret), K(buf_));
+  } else if (pos < meta_.get_meta_size() || pos > buf_.get_limit()) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid row pos", K(ret), K(pos), K(buf_), K(meta_));
+  } else {
+    buf_.get_position() = pos;
+  }
+
+  return ret;
+}
+
 const ObMutatorRowHeader &ObMemtableMutatorIterator::get_row_head() { return row_header_; }
 
 const ObMemtableMutatorRow &ObMemtableMutatorIterator::get_mutator_row() { return row_; }
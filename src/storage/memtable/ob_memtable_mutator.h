@@ -345,6 +345,10 @@ public:
   const ObMemtableMutatorRow &get_mutator_row();
   const ObMutatorTableLock &get_table_lock_row();
   const ObLsmtMutatorRow &get_ls_mt_row();
+  // the position of the next row in the mutator buffer, the row can be
+  // iterated again after moving back to it with set_row_pos
+  int64_t get_row_pos() const { return buf_.get_position(); }
+  int set_row_pos(const int64_t pos);
 
   TO_STRING_KV(K_(meta),K(buf_.get_position()),K(buf_.get_limit()));
 private:
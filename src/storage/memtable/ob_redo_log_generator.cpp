@@ -276,6 +276,8 @@ int ObRedoLogGenerator::fill_row_redo(ObITransCallbackIterator &cursor,
 
   ObMvccRowCallback *riter = (ObMvccRowCallback *)*cursor;
   bool fake_fill = false;
+  // holds the decompressed row image until it is serialized into the mutator
+  ObArenaAllocator allocator(ObModIds::OB_MEMSTORE);
 
   if (blocksstable::ObDmlFlag::DF_LOCK == riter->get_dml_flag()) {
     if (!log_for_lock_node) {
@@ -288,7 +290,7 @@ int ObRedoLogGenerator::fill_row_redo(ObITransCallbackIterator &cursor,
   }
 
   if (fake_fill) {
-  } else if (OB_FAIL(riter->get_redo(redo)) && OB_ENTRY_NOT_EXIST != ret) {
+  } else if (OB_FAIL(riter->get_redo(redo, allocator)) && OB_ENTRY_NOT_EXIST != ret) {
     TRANS_LOG(ERROR, "get_redo", K(ret));
   } else if (OB_ENTRY_NOT_EXIST == ret) {
     ret = OB_SUCCESS;
@@ -411,6 +411,8 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
   ObDmlFlag dml_flag = ObDmlFlag::DF_NOT_EXIST;
   int64_t compact_row_cnt = 0;
   int64_t rowkey_cnt = 0;
+  // holds the decompressed row images until the compact row is written
+  ObArenaAllocator decompress_allocator(ObModIds::OB_MEMSTORE);
 
   if (NULL == memtable_) {
     ret = OB_ERR_UNEXPECTED;
@@ -429,6 +431,8 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
   while (OB_SUCCESS == ret && NULL != cur) {
     // Read cells & compact them by a map.
     const ObMemtableDataHeader *mtd = NULL;
+    const char *data = NULL;
+    int64_t data_len = 0;
     bool find_committed_tnode = true;
     if (OB_FAIL(try_cleanout_tx_node_during_compact_(tx_table_guard, cur))) {
       TRANS_LOG(WARN, "cleanout tx state failed", K(ret), KPC(row_), KPC(cur));
@@ -444,6 +448,8 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
       TRANS_LOG(ERROR, "unexpected snapshot version", K(snapshot_version), K(*cur), K(*row_));
     } else if (NULL == (mtd = reinterpret_cast<const ObMemtableDataHeader *>(cur->buf_))) {
       ret = OB_ERR_UNEXPECTED;
+    } else if (OB_FAIL(mtd->get_data(decompress_allocator, data, data_len))) {
+      TRANS_LOG(WARN, "Failed to get row data", K(ret), KPC(mtd));
     } else if (blocksstable::ObDmlFlag::DF_LOCK == mtd->dml_flag_) {
       TRANS_LOG(INFO, "ignore lock node when compact", K(*cur), K(*row_));
       cur = cur->prev_;
@@ -452,7 +458,7 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
       ret = OB_ITER_END;
     } else if (rowkey_cnt == 0) {
       const ObRowHeader *row_header = nullptr;
-      if (OB_FAIL(row_reader.read_row_header(mtd->buf_, mtd->buf_len_, row_header))) {
+      if (OB_FAIL(row_reader.read_row_header(data, data_len, row_header))) {
         TRANS_LOG(WARN, "Failed to read row header", K(ret));
       } else if (OB_ISNULL(row_header)) {
         ret = OB_ERR_UNEXPECTED;
@@ -469,7 +475,7 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
       } else if (blocksstable::ObDmlFlag::DF_DELETE == mtd->dml_flag_) {
         // DELETE node & its previous ones are ignored.
         if (0 == compact_row_cnt) {
-          if (OB_FAIL(row_reader.read_row(mtd->buf_, mtd->buf_len_, nullptr, compact_datum_row))) {
+          if (OB_FAIL(row_reader.read_row(data, data_len, nullptr, compact_datum_row))) {
             TRANS_LOG(WARN, "Failed to read delete row", K(ret), KPC(mtd));
           } else {
             //force compact
@@ -481,7 +487,7 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
         } else {
           ret = OB_ITER_END;
         }
-      } else if (OB_FAIL(row_reader.read_row(mtd->buf_, mtd->buf_len_, nullptr, datum_row))) {
+      } else if (OB_FAIL(row_reader.read_row(data, data_len, nullptr, datum_row))) {
         TRANS_LOG(WARN, "Failed to read datum row", K(ret));
       } else if (OB_FAIL(compact_datum_row.reserve(datum_row.get_column_count(), true))) {
           STORAGE_LOG(WARN, "Failed to reserve datum row", K(ret), K(datum_row));
@@ -525,6 +531,7 @@ ObMvccTransNode *ObMemtableRowCompactor::construct_compact_node_(const int64_t s
         // Build trans node & insert it to its place.
         ObMemtableData mtd(dml_flag, len, buf);
         bool is_lock_node = true;
+        memtable_->compress_row_data(decompress_allocator, mtd);
         int64_t node_size = (int64_t)sizeof(*trans_node) + mtd.dup_size();
 
         if (OB_ISNULL(trans_node = (ObMvccTransNode *)node_alloc_->alloc(node_size))) {
@@ -138,7 +138,8 @@ public:
   virtual int get(const storage::ObTableIterParam &param,
                   storage::ObTableAccessContext &context,
                   const blocksstable::ObDatumRowkey &rowkey,
-                  blocksstable::ObDatumRow &row) override;
+                  blocksstable::ObDatumRow &row,
+                  common::ObIAllocator &allocator) override;
 
   virtual int set(storage::ObStoreCtx &ctx,
                   const uint64_t table_id,
@@ -164,6 +164,16 @@ int ObGTSLocalCache::update_latest_srr(const MonotonicTs latest_srr)
   return ret;
 }
 
+bool ObGTSLocalCache::is_gts_rpc_inflight(const MonotonicTs now,
+                                          const int64_t coalesce_window) const
+{
+  const int64_t latest_srr = ATOMIC_LOAD(&latest_srr_.mts_);
+  const int64_t srr = ATOMIC_LOAD(&srr_.mts_);
+  return coalesce_window > 0
+         && latest_srr > srr
+         && now.mts_ - latest_srr < coalesce_window;
+}
+
 int ObGTSLocalCache::update_base_ts(const int64_t base_ts)
 {
   int ret = OB_SUCCESS;
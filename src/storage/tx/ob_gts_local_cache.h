@@ -47,6 +47,9 @@ public:
   int get_srr_and_gts_safe(MonotonicTs &srr, int64_t &gts, MonotonicTs &receive_gts_ts) const;
   int update_latest_srr(const MonotonicTs latest_srr);
   int update_base_ts(const int64_t base_ts);
+  // A gts rpc is regarded as in flight if it was sent after the srr of the
+  // latest response and is not older than the coalesce window
+  bool is_gts_rpc_inflight(const MonotonicTs now, const int64_t coalesce_window) const;
 
   TO_STRING_KV(K_(srr), K_(gts), K_(barrier_ts), K_(latest_srr));
 private:
@@ -41,6 +41,9 @@ void ObGtsStatistics::reset()
   try_get_gts_with_stc_cnt_ = 0;
   wait_gts_elapse_cnt_ = 0;
   try_wait_gts_elapse_cnt_ = 0;
+  gts_rpc_coalesced_cnt_ = 0;
+  gts_rpc_rt_cnt_ = 0;
+  gts_rpc_rt_total_ = 0;
 }
 
 int ObGtsStatistics::init(const uint64_t tenant_id)
@@ -59,6 +62,8 @@ void ObGtsStatistics::statistics()
   const int64_t last_stat_ts = ATOMIC_LOAD(&last_stat_ts_);
   if (cur_ts - last_stat_ts >= STAT_INTERVAL) {
     if (ATOMIC_BCAS(&last_stat_ts_, last_stat_ts, cur_ts)) {
+      const int64_t gts_rpc_rt_cnt = ATOMIC_LOAD(&gts_rpc_rt_cnt_);
+      const int64_t gts_rpc_rt_total = ATOMIC_LOAD(&gts_rpc_rt_total_);
       TRANS_LOG(INFO, "gts statistics",
                       K_(tenant_id),
                       "gts_rpc_cnt", ATOMIC_LOAD(&gts_rpc_cnt_),
@@ -67,7 +72,10 @@ void ObGtsStatistics::statistics()
                       "try_get_gts_cache_cnt", ATOMIC_LOAD(&try_get_gts_cache_cnt_),
                       "try_get_gts_with_stc_cnt", ATOMIC_LOAD(&try_get_gts_with_stc_cnt_),
                       "wait_gts_elapse_cnt", ATOMIC_LOAD(&wait_gts_elapse_cnt_),
-                      "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_));
+                      "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_),
+                      "gts_rpc_coalesced_cnt", ATOMIC_LOAD(&gts_rpc_coalesced_cnt_),
+                      "gts_rpc_rt_cnt", gts_rpc_rt_cnt,
+                      "gts_rpc_avg_rt", (gts_rpc_rt_cnt > 0 ? gts_rpc_rt_total / gts_rpc_rt_cnt : 0));
       ATOMIC_STORE(&gts_rpc_cnt_, 0);
       ATOMIC_STORE(&get_gts_cache_cnt_, 0);
       ATOMIC_STORE(&get_gts_with_stc_cnt_, 0);
@@ -75,6 +83,9 @@ void ObGtsStatistics::statistics()
       ATOMIC_STORE(&try_get_gts_with_stc_cnt_, 0);
       ATOMIC_STORE(&wait_gts_elapse_cnt_, 0);
       ATOMIC_STORE(&try_wait_gts_elapse_cnt_, 0);
+      ATOMIC_STORE(&gts_rpc_coalesced_cnt_, 0);
+      ATOMIC_STORE(&gts_rpc_rt_cnt_, 0);
+      ATOMIC_STORE(&gts_rpc_rt_total_, 0);
     }
   }
 
@@ -93,6 +104,7 @@ void ObGtsSource::reset()
     queue_[i].reset();
   }
   gts_cache_leader_.reset();
+  has_coalesced_waiter_ = false;
 }
 
 
@@ -245,7 +257,7 @@ int ObGtsSource::get_gts(const MonotonicTs stc,
     } else {
       // If not in local, refresh gts
       if (need_send_rpc) {
-        if (OB_SUCCESS != (tmp_ret = query_gts_(leader))) {
+        if (OB_SUCCESS != (tmp_ret = query_gts_or_coalesce_(leader))) {
           TRANS_LOG(WARN, "query gts fail", K(tmp_ret), K(leader));
         }
       }
@@ -612,6 +624,23 @@ int ObGtsSource::query_gts_(const ObAddr &leader)
   return ret;
 }
 
+// Concurrent waiters whose stc is later than the in-flight rpc do not send
+// their own rpc, they are served by a single follow-up rpc which is sent
+// when the in-flight one returns (see handle_gts_result)
+int ObGtsSource::query_gts_or_coalesce_(const ObAddr &leader)
+{
+  int ret = OB_SUCCESS;
+  const int64_t coalesce_window = GCONF._gts_rpc_coalesce_window;
+  if (gts_local_cache_.is_gts_rpc_inflight(MonotonicTs::current_time(), coalesce_window)) {
+    ATOMIC_STORE(&has_coalesced_waiter_, true);
+    gts_statistics_.inc_gts_rpc_coalesced_cnt();
+    ObTransStatistic::get_instance().add_gts_rpc_coalesced_count(tenant_id_, 1);
+  } else {
+    ret = query_gts_(leader);
+  }
+  return ret;
+}
+
 int ObGtsSource::refresh_gts_location_()
 {
   int ret = OB_SUCCESS;
@@ -670,6 +699,11 @@ int ObGtsSource::update_gts(const MonotonicTs srr,
     TRANS_LOG(WARN, "gts local cache update error", KR(ret), K(srr), K(gts),
               K(receive_gts_ts), K(update));
   } else {
+    const int64_t rt = receive_gts_ts.mts_ - srr.mts_;
+    if (rt >= 0) {
+      gts_statistics_.add_gts_rpc_rt(rt);
+      ObTransStatistic::get_instance().add_gts_rpc_total_time(tenant_id_, rt);
+    }
     TRANS_LOG(DEBUG, "gts local cache update success", K(srr), K(gts));
   }
 
@@ -713,6 +747,18 @@ int ObGtsSource::handle_gts_result(const uint64_t tenant_id, const int64_t queue
     ObGTSTaskQueue *queue = &(queue_[queue_index]);
     if (OB_FAIL(queue->foreach_task(srr, gts, receive_gts_ts))) {
       TRANS_LOG(WARN, "iterate task failed", KR(ret), K(queue_index));
+    } else if (queue_index < GET_GTS_QUEUE_COUNT
+               && queue->get_task_count() > 0
+               && ATOMIC_BCAS(&has_coalesced_waiter_, true, false)) {
+      // the waiters coalesced into the finished rpc are not satisfied yet,
+      // send one rpc for all of them
+      int tmp_ret = OB_SUCCESS;
+      const bool need_refresh_gts_location = false;
+      if (OB_SUCCESS != (tmp_ret = refresh_gts_(need_refresh_gts_location))) {
+        if (EXECUTE_COUNT_PER_SEC(16)) {
+          TRANS_LOG(WARN, "refresh gts for coalesced waiters failed", K(tmp_ret), K_(tenant_id));
+        }
+      }
     }
   }
   return ret;
@@ -51,6 +51,12 @@ public:
   void inc_try_get_gts_with_stc_cnt() { ATOMIC_INC(&try_get_gts_with_stc_cnt_); }
   void inc_wait_gts_elapse_cnt() { ATOMIC_INC(&wait_gts_elapse_cnt_); }
   void inc_try_wait_gts_elapse_cnt() { ATOMIC_INC(&try_wait_gts_elapse_cnt_); }
+  void inc_gts_rpc_coalesced_cnt() { ATOMIC_INC(&gts_rpc_coalesced_cnt_); }
+  void add_gts_rpc_rt(const int64_t rt)
+  {
+    ATOMIC_INC(&gts_rpc_rt_cnt_);
+    ATOMIC_AAF(&gts_rpc_rt_total_, rt);
+  }
   void statistics();
 private:
   uint64_t tenant_id_;
@@ -64,6 +70,12 @@ private:
 
   int64_t wait_gts_elapse_cnt_;
   int64_t try_wait_gts_elapse_cnt_;
+
+  // requests served by an in-flight gts rpc instead of sending a new one
+  int64_t gts_rpc_coalesced_cnt_;
+  // round trip of gts rpc, measured from srr to the receipt of the response
+  int64_t gts_rpc_rt_cnt_;
+  int64_t gts_rpc_rt_total_;
 };
 
 class ObGtsSource : public ObITsSource
@@ -100,6 +112,7 @@ private:
   int refresh_gts_location_();
   int refresh_gts_(const bool need_refresh);
   int query_gts_(const common::ObAddr &leader);
+  int query_gts_or_coalesce_(const common::ObAddr &leader);
   void statistics_();
   int get_gts_from_local_timestamp_service_(common::ObAddr &leader,
                                             int64_t &gts,
@@ -124,6 +137,9 @@ private:
   common::ObTimeInterval log_interval_;
   common::ObAddr gts_cache_leader_;
   common::ObTimeInterval refresh_location_interval_;
+  // set when a waiter relies on the in-flight gts rpc, the response handler
+  // sends one more rpc on behalf of all waiters that it can not satisfy
+  bool has_coalesced_waiter_;
 };
 
 } // transaction
@@ -75,7 +75,8 @@ int ObGTSTaskQueue::foreach_task(const MonotonicTs srr,
         break;
       } else {
         const uint64_t tenant_id = task->get_tenant_id();
-        const int64_t request_ts = 0/*task->get_request_ts()*/;
+        // the waiting time of a waiter is counted from its stc
+        const int64_t request_ts = task->get_stc().mts_;
         if (tenant_id != last_tenant_id) {
           if (OB_FAIL(ts_guard.switch_to(tenant_id))) {
             TRANS_LOG(ERROR, "switch tenant failed", K(ret), K(tenant_id));
@@ -114,12 +115,11 @@ int ObGTSTaskQueue::foreach_task(const MonotonicTs srr,
               break;
             }
           } else {
+            const int64_t total_used = request_ts > 0 ? MonotonicTs::current_time().mts_ - request_ts : 0;
             if (GET_GTS == task_type_) {
-              const int64_t total_used = ObTimeUtility::current_time() - request_ts;
               ObTransStatistic::get_instance().add_gts_acquire_total_time(tenant_id, total_used);
               ObTransStatistic::get_instance().add_gts_acquire_total_wait_count(tenant_id, 1);
             } else if (WAIT_GTS_ELAPSING == task_type_) {
-              const int64_t total_used = ObTimeUtility::current_time() - request_ts;
               ObTransStatistic::get_instance().add_gts_wait_elapse_total_time(tenant_id, total_used);
               ObTransStatistic::get_instance().add_gts_wait_elapse_total_wait_count(tenant_id, 1);
             } else {
@@ -149,6 +149,9 @@ void ObTransCtx::set_exiting_()
   if (!is_exiting_) {
     is_exiting_ = true;
     print_trace_log_if_necessary_();
+    if (can_elr_) {
+      elr_handler_.on_tx_decided();
+    }
 
     const int64_t ctx_ref = get_ref();
     if (NULL == ls_tx_ctx_mgr_) {
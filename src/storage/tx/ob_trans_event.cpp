@@ -144,6 +144,16 @@ void ObTransStatistic::add_read_elr_row_count(const uint64_t tenant_id, const in
   common::ObTenantStatEstGuard guard(tenant_id);
   EVENT_ADD(READ_ELR_ROW_COUNT, value);
 }
+void ObTransStatistic::add_elr_commit_dependency_count(const uint64_t tenant_id, const int64_t value)
+{
+  common::ObTenantStatEstGuard guard(tenant_id);
+  EVENT_ADD(ELR_COMMIT_DEPENDENCY_COUNT, value);
+}
+void ObTransStatistic::add_elr_commit_dependency_wait_count(const uint64_t tenant_id, const int64_t value)
+{
+  common::ObTenantStatEstGuard guard(tenant_id);
+  EVENT_ADD(ELR_COMMIT_DEPENDENCY_WAIT_COUNT, value);
+}
 
 void ObTransStatistic::add_local_stmt_count(const uint64_t tenant_id, const int64_t value)
 {
@@ -472,6 +482,18 @@ void ObTransStatistic::add_gts_rpc_count(const uint64_t tenant_id, const int64_t
   EVENT_ADD(GTS_RPC_COUNT, value);
 }
 
+void ObTransStatistic::add_gts_rpc_coalesced_count(const uint64_t tenant_id, const int64_t value)
+{
+  common::ObTenantStatEstGuard guard(tenant_id);
+  EVENT_ADD(GTS_RPC_COALESCED_COUNT, value);
+}
+
+void ObTransStatistic::add_gts_rpc_total_time(const uint64_t tenant_id, const int64_t value)
+{
+  common::ObTenantStatEstGuard guard(tenant_id);
+  EVENT_ADD(GTS_RPC_TOTAL_TIME, value);
+}
+
 void ObTransStatistic::add_gts_try_acquire_total_count(const uint64_t tenant_id, const int64_t value)
 {
   common::ObTenantStatEstGuard guard(tenant_id);
@@ -66,6 +66,10 @@ public:
   // count the number of elr unable transactions
   void add_elr_unable_trans_count(const uint64_t tenant_id, const int64_t value);
   void add_read_elr_row_count(const uint64_t tenant_id, const int64_t value);
+  // count the number of reads which depend on the early released txns
+  void add_elr_commit_dependency_count(const uint64_t tenant_id, const int64_t value);
+  // count the number of reads waiting for the early released txns
+  void add_elr_commit_dependency_wait_count(const uint64_t tenant_id, const int64_t value);
   // count the number of timeout transactions: count when commit the transaction(end_trans)
   void add_trans_timeout_count(const uint64_t tenant_id, const int64_t value);
   // count how many transactions are started, via start_trans
@@ -187,6 +191,10 @@ public:
   void add_gts_wait_elapse_total_wait_count(const uint64_t tenant_id, const int64_t value);
   // Count the number of rpc requests initiated by the gts client
   void add_gts_rpc_count(const uint64_t tenant_id, const int64_t value);
+  // Count the number of gts requests coalesced into an in-flight rpc
+  void add_gts_rpc_coalesced_count(const uint64_t tenant_id, const int64_t value);
+  // count the total round trip time of gts rpc
+  void add_gts_rpc_total_time(const uint64_t tenant_id, const int64_t value);
   // Count the total number of obtaining gts synchronously
   void add_gts_try_acquire_total_count(const uint64_t tenant_id, const int64_t value);
   // count the total number of synchronously waitting gts
@@ -292,6 +300,8 @@ private:
 #define TX_STAT_ELR_ENABLE_TRANS_INC ObTransStatistic::get_instance().add_elr_enable_trans_count(MTL_ID(), 1);
 #define TX_STAT_ELR_UNABLE_TRANS_INC ObTransStatistic::get_instance().add_elr_unable_trans_count(MTL_ID(), 1);
 #define TX_STAT_READ_ELR_ROW_COUNT_INC transaction::ObTransStatistic::get_instance().add_read_elr_row_count(MTL_ID(), 1);
+#define TX_STAT_ELR_COMMIT_DEPENDENCY_INC transaction::ObTransStatistic::get_instance().add_elr_commit_dependency_count(MTL_ID(), 1);
+#define TX_STAT_ELR_COMMIT_DEPENDENCY_WAIT_INC transaction::ObTransStatistic::get_instance().add_elr_commit_dependency_wait_count(MTL_ID(), 1);
 
 // TODO: following events is not used, do clean up
 // count the interval time between statements
@@ -1792,6 +1792,10 @@ int ObPartTransCtx::on_success_ops_(ObTxLogCb *log_cb)
           }
           tg.click();
         }
+        if (can_elr_) {
+          // the commit log is durable, wake up the readers of early released data
+          elr_handler_.on_tx_decided();
+        }
       } else if (ObTxLogType::TX_ABORT_LOG == log_type) {
         if (exec_info_.multi_data_source_.count() > 0 && get_retain_cause() == RetainCause::UNKOWN
             && OB_FAIL(insert_into_retain_ctx_mgr_(RetainCause::MDS_WAIT_GC_COMMIT_LOG, log_ts, log_lsn))) {
@@ -5978,6 +5982,41 @@ int ObPartTransCtx::on_local_commit_tx_()
   return ret;
 }
 
+int ObPartTransCtx::wait_elr_decided(const int64_t expire_ts)
+{
+  int ret = OB_SUCCESS;
+  if (ObTxData::ELR_COMMIT == ctx_tx_data_.get_state()) {
+    const int64_t wait_us = expire_ts - ObClockGenerator::getClock();
+    TX_STAT_ELR_COMMIT_DEPENDENCY_WAIT_INC
+    if (wait_us <= 0) {
+      ret = OB_TIMEOUT;
+      TRANS_LOG(WARN, "wait elr txn decided timeout", K(ret), K(expire_ts), KPC(this));
+    } else if (OB_FAIL(elr_handler_.wait_tx_decided(wait_us))) {
+      TRANS_LOG(WARN, "wait elr txn decided failed", K(ret), K(expire_ts), KPC(this));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    switch (ctx_tx_data_.get_state()) {
+      case ObTxData::COMMIT: {
+        break;
+      }
+      case ObTxData::ABORT: {
+        // the commit log is lost, the early released data read is invalid
+        ret = OB_TRANS_ROLLBACKED;
+        TRANS_LOG(WARN, "elr txn is aborted", K(ret), KPC(this));
+        break;
+      }
+      default: {
+        // the ctx exits before it is decided, e.g. it is killed
+        ret = OB_TRANS_KILLED;
+        TRANS_LOG(WARN, "elr txn exits before decided", K(ret), KPC(this));
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObPartTransCtx::on_local_abort_tx_()
 {
   int ret = OB_SUCCESS;
@@ -205,6 +205,9 @@ public:
 
   // for elr
   bool is_can_elr() const { return can_elr_; }
+  // wait until the early released txn is committed or aborted, it is called
+  // by the reader of its data whose commit is not ordered after ours by clog
+  int wait_elr_decided(const int64_t expire_ts);
 public:
   // thread safe
   int64_t to_string(char* buf, const int64_t buf_len) const;
@@ -148,6 +148,10 @@ int ObTransService::init(const ObAddr &self,
     TRANS_LOG(WARN, "ObTxDescMgr init error", K(ret));
   } else if (OB_FAIL(tx_ctx_mgr_.init(tenant_id, ts_mgr, this))) {
     TRANS_LOG(WARN, "tx_ctx_mgr_ init error", KR(ret));
+  } else if (OB_FAIL(tx_callback_worker_.init())) {
+    TRANS_LOG(WARN, "tx_callback_worker_ init error", KR(ret));
+  } else if (OB_FAIL(tx_replay_worker_.init())) {
+    TRANS_LOG(WARN, "tx_replay_worker_ init error", KR(ret));
   } else {
     self_ = self;
     tenant_id_ = tenant_id;
@@ -211,6 +215,10 @@ int ObTransService::start()
     TRANS_LOG(WARN, "tx_ctx_mgr_ start error", KR(ret));
   } else if (OB_FAIL(tx_desc_mgr_.start())) {
     TRANS_LOG(WARN, "tx_desc_mgr_ start error", KR(ret));
+  } else if (OB_FAIL(tx_callback_worker_.start())) {
+    TRANS_LOG(WARN, "tx_callback_worker_ start error", KR(ret));
+  } else if (OB_FAIL(tx_replay_worker_.start())) {
+    TRANS_LOG(WARN, "tx_replay_worker_ start error", KR(ret));
   } else {
     is_running_ = true;
     TRANS_LOG(INFO, "transaction service start success", KPC(this));
@@ -241,6 +249,8 @@ void ObTransService::stop()
     rpc_->stop();
     dup_table_rpc_->stop();
     gti_source_->stop();
+    tx_callback_worker_.stop();
+    tx_replay_worker_.stop();
     ObSimpleThreadPool::stop();
     is_running_ = false;
     TRANS_LOG(INFO, "transaction service stop success", KPC(this));
@@ -269,6 +279,8 @@ int ObTransService::wait_()
     rpc_->wait();
     dup_table_rpc_->wait();
     gti_source_->wait();
+    tx_callback_worker_.wait();
+    tx_replay_worker_.wait();
     TRANS_LOG(INFO, "transaction service wait success", KPC(this));
   }
   return ret;
@@ -291,6 +303,8 @@ void ObTransService::destroy()
     gti_source_->destroy();
     tx_ctx_mgr_.destroy();
     tx_desc_mgr_.destroy();
+    tx_callback_worker_.destroy();
+    tx_replay_worker_.destroy();
     dup_table_rpc_->destroy();
 #ifdef ENABLE_DEBUG_LOG
     if (NULL != defensive_check_mgr_) {
@@ -40,6 +40,8 @@
 #include "observer/ob_server_struct.h"
 #include "common/storage/ob_sequence.h"
 #include "ob_tx_elr_util.h"
+#include "storage/memtable/mvcc/ob_tx_callback_worker.h"
+#include "storage/tx/ob_tx_replay_worker.h"
 
 namespace oceanbase
 {
@@ -198,6 +200,8 @@ public:
                        const char *buf,
                        const int64_t buf_len);
   ObTxELRUtil &get_tx_elr_util() { return elr_util_; }
+  memtable::ObTxCallbackWorker &get_tx_callback_worker() { return tx_callback_worker_; }
+  ObTxReplayWorker &get_tx_replay_worker() { return tx_replay_worker_; }
 #ifdef ENABLE_DEBUG_LOG
   transaction::ObDefensiveCheckMgr *get_defensive_check_mgr() { return defensive_check_mgr_; }
 #endif
@@ -277,6 +281,10 @@ private:
 
   obrpc::ObSrvRpcProxy *rpc_proxy_;
   ObTxELRUtil elr_util_;
+  // process callbacks of large txn in parallel during txn end
+  memtable::ObTxCallbackWorker tx_callback_worker_;
+  // replay rows of large redo log in parallel on follower
+  ObTxReplayWorker tx_replay_worker_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObTransService);
 };
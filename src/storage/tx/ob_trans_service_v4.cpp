@@ -1199,6 +1199,52 @@ int ObTransService::revert_store_ctx(storage::ObStoreCtx &store_ctx)
   return ret;
 }
 
+/*
+ * the read has read the data of txns which released their locks early, and
+ * it does not participate in the logstream, wait for those txns to be decided
+ * before the rows read are used
+ */
+int ObTransService::wait_elr_dependency(storage::ObStoreCtx &store_ctx)
+{
+  int ret = OB_SUCCESS;
+  auto &acc_ctx = store_ctx.mvcc_acc_ctx_;
+  const share::ObLSID &ls_id = store_ctx.ls_id_;
+  const ObIArray<ObTransID> &tx_ids = acc_ctx.get_elr_dependencies();
+  for (int64_t i = 0; OB_SUCC(ret) && i < tx_ids.count(); i++) {
+    const ObTransID &tx_id = tx_ids.at(i);
+    ObPartTransCtx *tx_ctx = NULL;
+    if (OB_FAIL(get_tx_ctx_(ls_id, store_ctx.ls_, tx_id, tx_ctx))) {
+      if (OB_TRANS_CTX_NOT_EXIST == ret) {
+        // the txn has exited, check its state in tx table
+        int state = ObTxData::RUNNING;
+        int64_t commit_version = 0;
+        if (OB_FAIL(get_tx_state_from_tx_table_(ls_id, tx_id, state, commit_version))) {
+          if (OB_TRANS_CTX_NOT_EXIST == ret) {
+            // the tx data has been recycled after decided
+            ret = OB_SUCCESS;
+          } else {
+            TRANS_LOG(WARN, "get tx state failed", K(ret), K(ls_id), K(tx_id));
+          }
+        } else if (ObTxData::ABORT == state) {
+          ret = OB_TRANS_ROLLBACKED;
+          TRANS_LOG(WARN, "elr txn is aborted", K(ret), K(ls_id), K(tx_id));
+        }
+      } else {
+        TRANS_LOG(WARN, "get tx ctx fail", K(ret), K(ls_id), K(tx_id));
+      }
+    } else {
+      if (OB_FAIL(tx_ctx->wait_elr_decided(acc_ctx.abs_lock_timeout_))) {
+        TRANS_LOG(WARN, "wait elr txn decided failed", K(ret), K(ls_id), K(tx_id));
+      }
+      revert_tx_ctx_(store_ctx.ls_, tx_ctx);
+    }
+  }
+  if (OB_SUCC(ret)) {
+    acc_ctx.reset_elr_dependencies();
+  }
+  return ret;
+}
+
 /*
  * used to validate specified snapshot version
  * precondition: version <= current gts value
@@ -79,6 +79,11 @@ int get_write_store_ctx(ObTxDesc &tx,
                         const ObTxReadSnapshot &snapshot,
                         storage::ObStoreCtx &store_ctx);
 int revert_store_ctx(storage::ObStoreCtx &store_ctx);
+/*
+ * wait for the early lock released txns whose data has been read by the
+ * store_ctx, see ObMvccAccessCtx::add_elr_dependency
+ */
+int wait_elr_dependency(storage::ObStoreCtx &store_ctx);
 
 int acquire_tx_ctx(const share::ObLSID &ls_id,
                    const ObTxDesc &tx,
@@ -15,6 +15,7 @@
 #include "storage/tx/ob_committer_define.h"
 #include "storage/ob_i_store.h"
 #include "storage/tx/ob_trans_define.h"
+#include "storage/tx/ob_trans_event.h"
 #include "storage/memtable/ob_memtable_context.h"
 #include "observer/ob_server_struct.h"
 
@@ -194,6 +195,18 @@ int LockForReadFunctor::inner_lock_for_read(const ObTxData &tx_data, ObTxCCCtx *
       can_read_ = !tx_data.undo_status_list_.is_contain(data_sql_sequence);
       trans_version_ = tx_data.commit_version_;
       is_determined_state_ = false;
+      // The commit log of the data has been submitted but may not be durable.
+      // If we participate in the ls, our commit log follows it; otherwise the
+      // read records it and waits for it to be decided when the scan ends.
+      if (can_read_
+          && trans_version_ <= snapshot_version
+          && OB_ISNULL(lock_for_read_arg_.mvcc_acc_ctx_.mem_ctx_)) {
+        if (OB_FAIL(lock_for_read_arg_.mvcc_acc_ctx_.add_elr_dependency(data_tx_id))) {
+          TRANS_LOG(WARN, "add elr dependency failed", K(ret), K(data_tx_id));
+        } else {
+          TX_STAT_ELR_COMMIT_DEPENDENCY_INC
+        }
+      }
       break;
     }
     case ObTxData::RUNNING: {
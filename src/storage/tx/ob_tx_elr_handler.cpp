@@ -24,6 +24,7 @@ void ObTxELRHandler::reset()
 {
   elr_prepared_state_ = TxELRState::ELR_INIT;
   mt_ctx_ = NULL;
+  decided_cond_.reset();
 }
 
 int ObTxELRHandler::check_and_early_lock_release(ObPartTransCtx *ctx)
@@ -43,5 +44,15 @@ int ObTxELRHandler::check_and_early_lock_release(ObPartTransCtx *ctx)
   return ret;
 }
 
+int ObTxELRHandler::wait_tx_decided(const int64_t wait_us)
+{
+  int ret = OB_SUCCESS;
+  int result = OB_SUCCESS;
+  if (OB_FAIL(decided_cond_.wait(wait_us, result))) {
+    TRANS_LOG(WARN, "wait elr txn decided failed", K(ret), K(wait_us), K(*this));
+  }
+  return ret;
+}
+
 } //transaction
 } //oceanbase
@@ -14,6 +14,7 @@
 #define OCEANBASE_TX_ELR_HANDLER_
 
 #include "ob_trans_define.h"
+#include "ob_trans_result.h"
 
 namespace oceanbase
 {
@@ -50,11 +51,19 @@ public:
   void set_elr_prepared() { ATOMIC_STORE(&elr_prepared_state_, TxELRState::ELR_PREPARED); }
   bool is_elr_prepared() const { return TxELRState::ELR_PREPARED == ATOMIC_LOAD(&elr_prepared_state_); }
   void reset_elr_state() { ATOMIC_STORE(&elr_prepared_state_, TxELRState::ELR_INIT); }
+
+  // the txn which has released its locks early is committed, aborted or
+  // exiting, wake up the readers waiting for it
+  void on_tx_decided() { decided_cond_.notify(common::OB_SUCCESS); }
+  // wait until on_tx_decided is called, used by the reader of the early
+  // released data whose commit is not ordered after ours by the clog
+  int wait_tx_decided(const int64_t wait_us);
   TO_STRING_KV(K_(elr_prepared_state), KP_(mt_ctx));
 private:
   // whether it is ready for elr
   TxELRState elr_prepared_state_;
   memtable::ObMemtableCtx *mt_ctx_;
+  ObTransCond decided_cond_;
 };
 
 } // transaction
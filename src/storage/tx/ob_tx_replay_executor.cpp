@@ -20,9 +20,12 @@
 #include "storage/tx/ob_trans_service.h"
 #include "storage/tx/ob_trans_part_ctx.h"
 #include "storage/tx/ob_tx_replay_executor.h"
+#include "storage/tx/ob_tx_replay_worker.h"
 #include "storage/tx/ob_timestamp_service.h"
 #include "storage/tx/ob_trans_id_service.h"
 #include "storage/tablelock/ob_lock_memtable.h"
+#include "share/config/ob_server_config.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 namespace oceanbase
 {
@@ -505,8 +508,14 @@ int ObTxReplayExecutor::replay_redo_in_memtable_(ObTxRedoLog &redo)
     TRANS_LOG(WARN, "[Replay Tx] deserialize fail or pos does not match data_len", K(ret));
   } else {
     meta_flag = mmi_ptr_->get_meta().get_flags();
+    bool is_done = false;
+    if (need_parallel_replay_redo_(mmi_ptr_->get_meta().get_row_count())
+        && OB_FAIL(parallel_replay_redo_in_memtable_(redo, is_done))) {
+      TRANS_LOG(WARN, "[Replay Tx] parallel replay redo in memtable failed", K(ret),
+                K(log_ts_ns_), K(tx_part_log_no_));
+    }
     ObEncryptRowBuf row_buf;
-    while (OB_SUCC(ret)) {
+    while (OB_SUCC(ret) && !is_done) {
       row_head.reset();
       if (OB_FAIL(mmi_ptr_->iterate_next_row())) {
         if (OB_ITER_END != ret) {
@@ -550,6 +559,261 @@ int ObTxReplayExecutor::replay_redo_in_memtable_(ObTxRedoLog &redo)
   return ret;
 }
 
+bool ObTxReplayExecutor::need_parallel_replay_redo_(const int64_t row_count) const
+{
+  const int64_t threshold = GCONF._tx_replay_parallel_redo_row_threshold;
+  return threshold > 0 && row_count >= threshold;
+}
+
+// parallel_replay_redo_in_memtable_ replays the rows of a large redo log
+// concurrently with the tenant replay workers. The mutator is iterated once to
+// split the rows into shards by tablet and rowkey, so the mutations of the same
+// row are replayed by one shard in their original order, and each shard only
+// decodes its own rows. The callbacks of each shard are kept on its own list
+// and appended into the txn in the order of the log after all shards are
+// finished, so the replay checksum is the same as the leader's. The log itself
+// is still replayed in the order and with the barriers decided by the replay
+// service. is_done is false if the rows are not replayed and the caller should
+// fall back to the serial way.
+int ObTxReplayExecutor::parallel_replay_redo_in_memtable_(ObTxRedoLog &redo, bool &is_done)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObTransService *txs = MTL(ObTransService *);
+  ObTxReplayWorker *worker = NULL;
+  ObTxCallbackListTaskGroup group;
+  char *buf = NULL;
+  ObTxRedoReplayTask *tasks = NULL;
+  ObTxRedoReplayRow *rows = NULL;
+  int64_t *shard_row_idxs = NULL;
+  int64_t shard_row_cnts[MAX_REDO_REPLAY_SHARD_COUNT];
+  const int64_t row_cnt = mmi_ptr_->get_meta().get_row_count();
+  const int64_t start_pos = mmi_ptr_->get_row_pos();
+  int64_t shard_cnt = 0;
+  is_done = false;
+
+  if (OB_ISNULL(txs) || row_cnt <= 0) {
+    // do nothing
+  } else if (FALSE_IT(worker = &txs->get_tx_replay_worker())) {
+  } else if (!worker->is_running() || worker->get_thread_cnt() <= 0) {
+    // do nothing
+  } else if (FALSE_IT(shard_cnt = MIN(worker->get_thread_cnt() + 1,
+                                      MAX_REDO_REPLAY_SHARD_COUNT))) {
+  } else if (OB_SUCCESS != (tmp_ret = group.init(shard_cnt))) {
+    TRANS_LOG(WARN, "[Replay Tx] init redo replay task group failed", K(tmp_ret), K(shard_cnt));
+  } else if (OB_ISNULL(buf = static_cast<char *>(
+                         ob_malloc(sizeof(ObTxRedoReplayTask) * shard_cnt
+                                   + (sizeof(ObTxRedoReplayRow) + sizeof(int64_t)) * row_cnt,
+                                   ObMemAttr(MTL_ID(), "TxReplay"))))) {
+    TRANS_LOG(WARN, "[Replay Tx] alloc redo replay tasks failed", K(shard_cnt), K(row_cnt));
+  } else if (FALSE_IT(rows = reinterpret_cast<ObTxRedoReplayRow *>(
+                          buf + sizeof(ObTxRedoReplayTask) * shard_cnt))) {
+  } else if (FALSE_IT(shard_row_idxs = reinterpret_cast<int64_t *>(rows + row_cnt))) {
+  } else if (OB_SUCCESS != (tmp_ret = split_redo_rows_(shard_cnt, row_cnt, rows,
+                                                       shard_row_idxs, shard_row_cnts))) {
+    TRANS_LOG(WARN, "[Replay Tx] split redo rows failed, replay them serially", K(tmp_ret),
+              K(row_cnt), K(log_ts_ns_));
+    // the serial replay starts from the first row again
+    if (OB_FAIL(mmi_ptr_->set_row_pos(start_pos))) {
+      TRANS_LOG(WARN, "[Replay Tx] reset mutator row pos failed", K(ret), K(start_pos));
+    }
+  } else {
+    const int64_t start_ts = ObTimeUtility::fast_current_time();
+    ObTransCallbackMgr &callback_mgr = mt_ctx_->get_trans_callback_mgr();
+    tasks = reinterpret_cast<ObTxRedoReplayTask *>(buf);
+    ATOMIC_STORE(&parallel_replay_failed_, false);
+    for (int64_t i = 0, offset = 0; i < shard_cnt; offset += shard_row_cnts[i], ++i) {
+      new(tasks + i) ObTxRedoReplayTask(callback_mgr);
+      tasks[i].init(this, &redo, rows, shard_row_idxs + offset, shard_row_cnts[i], &group);
+    }
+    // the first shard is replayed by the current thread, and others are
+    // replayed by the workers or by the current thread if the worker is busy
+    for (int64_t i = 1; i < shard_cnt; ++i) {
+      if (OB_SUCCESS != (tmp_ret = worker->push(tasks + i))) {
+        tasks[i].run();
+      }
+    }
+    tasks[0].run();
+    group.wait();
+    for (int64_t i = 0; OB_SUCC(ret) && i < shard_cnt; ++i) {
+      ret = tasks[i].get_ret_code();
+    }
+    if (OB_SUCC(ret) && OB_FAIL(append_replayed_callbacks_(rows, row_cnt, tasks, shard_cnt))) {
+      TRANS_LOG(ERROR, "[Replay Tx] append replayed callbacks failed", K(ret), K(log_ts_ns_));
+    }
+    if (OB_FAIL(ret)) {
+      // the failed shard has rolled back its callbacks, and the callbacks of
+      // other shards are rolled back together with the whole log
+      for (int64_t i = 0; i < shard_cnt; ++i) {
+        (void)callback_mgr.append_replay_shard_callbacks(tasks[i].get_callback_list(), INT64_MAX);
+      }
+      mt_ctx_->rollback_redo_callbacks(log_ts_ns_);
+    }
+    for (int64_t i = 0; i < shard_cnt; ++i) {
+      tasks[i].~ObTxRedoReplayTask();
+    }
+    is_done = true;
+    const int64_t used_time = ObTimeUtility::fast_current_time() - start_ts;
+    EVENT_INC(TX_REPLAY_PARALLEL_REDO_COUNT);
+    EVENT_ADD(TX_REPLAY_PARALLEL_REDO_TIME, used_time);
+    TRANS_LOG(DEBUG, "[Replay Tx] parallel replay redo finished", K(ret), K(shard_cnt),
+              K(row_cnt), K(used_time), K(log_ts_ns_), "trans_id", ctx_->get_trans_id());
+  }
+  if (OB_NOT_NULL(buf)) {
+    ob_free(buf);
+  }
+
+  return ret;
+}
+
+// split_redo_rows_ iterates the rows of the mutator once, and records the
+// position and the shard of each row. shard_row_idxs keeps the indexes of the
+// rows of each shard together in the order of the log, and shard_row_cnts is
+// the number of rows of each shard.
+int ObTxReplayExecutor::split_redo_rows_(const int64_t shard_cnt,
+                                         const int64_t row_cnt,
+                                         ObTxRedoReplayRow *rows,
+                                         int64_t *shard_row_idxs,
+                                         int64_t *shard_row_cnts)
+{
+  int ret = OB_SUCCESS;
+  int64_t cnt = 0;
+
+  for (int64_t i = 0; i < shard_cnt; ++i) {
+    shard_row_cnts[i] = 0;
+  }
+  while (OB_SUCC(ret)) {
+    const int64_t pos = mmi_ptr_->get_row_pos();
+    if (OB_FAIL(mmi_ptr_->iterate_next_row())) {
+      if (OB_ITER_END != ret) {
+        TRANS_LOG(WARN, "[Replay Tx] iterate_next_row failed", K(ret));
+      }
+    } else if (cnt >= row_cnt) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(WARN, "[Replay Tx] more rows than the mutator meta", K(ret), K(cnt), K(row_cnt));
+    } else {
+      rows[cnt].pos_ = pos;
+      rows[cnt].shard_idx_ = static_cast<int32_t>(get_redo_row_shard_idx_(*mmi_ptr_, shard_cnt));
+      rows[cnt].callback_cnt_ = 0;
+      shard_row_cnts[rows[cnt].shard_idx_]++;
+      cnt++;
+    }
+  }
+  if (OB_ITER_END != ret) {
+    // do nothing
+  } else if (cnt != row_cnt) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(WARN, "[Replay Tx] less rows than the mutator meta", K(ret), K(cnt), K(row_cnt));
+  } else {
+    ret = OB_SUCCESS;
+    int64_t offsets[MAX_REDO_REPLAY_SHARD_COUNT];
+    for (int64_t i = 0, offset = 0; i < shard_cnt; offset += shard_row_cnts[i], ++i) {
+      offsets[i] = offset;
+    }
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      shard_row_idxs[offsets[rows[i].shard_idx_]++] = i;
+    }
+  }
+
+  return ret;
+}
+
+// replay the rows of one shard, the callbacks appended by the replay are kept
+// on the callback list of the shard.
+int ObTxReplayExecutor::replay_redo_shard_in_memtable_(ObTxRedoLog &redo,
+                                                       ObTxRedoReplayRow *rows,
+                                                       const int64_t *row_idxs,
+                                                       const int64_t row_cnt,
+                                                       ObTxCallbackList &callback_list)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  ObMutatorRowHeader row_head;
+  ObEncryptRowBuf row_buf;
+  ObMemtableMutatorIterator mmi;
+  ObTransCallbackMgr::ReplayShardGuard guard(mt_ctx_->get_trans_callback_mgr(), callback_list);
+
+  if (OB_FAIL(mmi.deserialize(redo.get_replay_mutator_buf(), redo.get_mutator_size(), pos,
+                              redo.get_clog_encrypt_info()))) {
+    TRANS_LOG(WARN, "[Replay Tx] deserialize mutator failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+    ObTxRedoReplayRow &row = rows[row_idxs[i]];
+    const int64_t callback_cnt = callback_list.get_length();
+    row_head.reset();
+    if (ATOMIC_LOAD(&parallel_replay_failed_)) {
+      // other shard has failed, the whole log will be retried
+      break;
+    } else if (OB_FAIL(mmi.set_row_pos(row.pos_))) {
+      TRANS_LOG(WARN, "[Replay Tx] set mutator row pos failed", K(ret), K(row));
+    } else if (OB_FAIL(mmi.iterate_next_row())) {
+      TRANS_LOG(WARN, "[Replay Tx] iterate_next_row failed", K(ret), K(row));
+    } else if (FALSE_IT(row_head = mmi.get_row_head())) {
+    } else if (OB_FAIL(replay_one_row_in_memtable_(row_head, &mmi, row_buf))) {
+      if (OB_MINOR_FREEZE_NOT_ALLOW != ret) {
+        TRANS_LOG(WARN, "[Replay Tx] replay_one_row_in_memtable_ failed", K(ret),
+                  K(row_head.tablet_id_), KP(ls_), K(log_ts_ns_), K(tx_part_log_no_), K(row));
+      }
+    } else {
+      row.callback_cnt_ = static_cast<int32_t>(callback_list.get_length() - callback_cnt);
+    }
+  }
+  if (OB_FAIL(ret)) {
+    ATOMIC_STORE(&parallel_replay_failed_, true);
+  }
+  // free ObRowKey's objs's memory
+  THIS_WORKER.get_sql_arena_allocator().reset();
+  return ret;
+}
+
+// append the callbacks of the shards into the txn in the order of the rows in
+// the log, which is the order of the callbacks on the leader.
+int ObTxReplayExecutor::append_replayed_callbacks_(const ObTxRedoReplayRow *rows,
+                                                   const int64_t row_cnt,
+                                                   ObTxRedoReplayTask *tasks,
+                                                   const int64_t shard_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObTransCallbackMgr &callback_mgr = mt_ctx_->get_trans_callback_mgr();
+
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt;) {
+    // the continuous rows of the same shard are appended together
+    const int32_t shard_idx = rows[i].shard_idx_;
+    int64_t callback_cnt = 0;
+    for (; i < row_cnt && shard_idx == rows[i].shard_idx_; ++i) {
+      callback_cnt += rows[i].callback_cnt_;
+    }
+    if (callback_cnt != callback_mgr.append_replay_shard_callbacks(
+                          tasks[shard_idx].get_callback_list(), callback_cnt)) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(ERROR, "[Replay Tx] shard callbacks are less than replayed", K(ret),
+                K(shard_idx), K(callback_cnt), K(i));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < shard_cnt; ++i) {
+    if (!tasks[i].get_callback_list().empty()) {
+      ret = OB_ERR_UNEXPECTED;
+      TRANS_LOG(ERROR, "[Replay Tx] shard callbacks are more than replayed", K(ret), K(i),
+                K(tasks[i].get_callback_list().get_length()));
+    }
+  }
+
+  return ret;
+}
+
+// table lock rows are always replayed by the first shard to keep their order
+int64_t ObTxReplayExecutor::get_redo_row_shard_idx_(ObMemtableMutatorIterator &mmi,
+                                                    const int64_t shard_cnt) const
+{
+  int64_t shard_idx = 0;
+  const ObMutatorRowHeader &row_head = mmi.get_row_head();
+  if (MutatorType::MUTATOR_ROW == row_head.mutator_type_) {
+    const uint64_t hash = mmi.get_mutator_row().rowkey_.murmurhash(row_head.tablet_id_.hash());
+    shard_idx = static_cast<int64_t>(hash % shard_cnt);
+  }
+  return shard_idx;
+}
+
 int ObTxReplayExecutor::replay_one_row_in_memtable_(ObMutatorRowHeader &row_head,
                                                     memtable::ObMemtableMutatorIterator *mmi_ptr,
                                                     memtable::ObEncryptRowBuf &row_buf)
@@ -591,7 +855,7 @@ int ObTxReplayExecutor::replay_one_row_in_memtable_(ObMutatorRowHeader &row_head
     lib::CompatModeGuard compat_guard(mode);
     switch (row_head.mutator_type_) {
     case MutatorType::MUTATOR_ROW: {
-      if (OB_FAIL(replay_row_(storeCtx, tablet, mmi_ptr_, row_buf)) && OB_ITER_END != ret) {
+      if (OB_FAIL(replay_row_(storeCtx, tablet, mmi_ptr, row_buf)) && OB_ITER_END != ret) {
         if (OB_NO_NEED_UPDATE != ret && OB_MINOR_FREEZE_NOT_ALLOW != ret) {
           TRANS_LOG(WARN, "[Replay Tx] replay row failed.", K(ret), K(mt_ctx_),
                     K(row_head.tablet_id_));
@@ -603,16 +867,16 @@ int ObTxReplayExecutor::replay_one_row_in_memtable_(ObMutatorRowHeader &row_head
         }
       }
       if (OB_SUCC(ret)) {
-        mvcc_row_count_++;
+        ATOMIC_INC(&mvcc_row_count_);
       }
       break;
     }
     case MutatorType::MUTATOR_TABLE_LOCK: {
-      if (OB_FAIL(replay_lock_(storeCtx, tablet, mmi_ptr_, row_buf)) && OB_ITER_END != ret) {
+      if (OB_FAIL(replay_lock_(storeCtx, tablet, mmi_ptr, row_buf)) && OB_ITER_END != ret) {
         TRANS_LOG(WARN, "[Replay Tx] replay lock failed.", K(ret), K(mt_ctx_),
                   K(row_head.tablet_id_));
       } else {
-        table_lock_row_count_++;
+        ATOMIC_INC(&table_lock_row_count_);
       }
       break;
     }
@@ -31,6 +31,7 @@ class ObMemtableCtx;
 class ObMemtable;
 class ObMemtableMutatorIterator;
 class ObEncryptRowBuf;
+class ObTxCallbackList;
 };
 namespace storage
 {
@@ -45,6 +46,8 @@ namespace transaction
 class ObTxLogBlock;
 class ObPartTransCtx;
 class ObTransService;
+class ObTxRedoReplayTask;
+struct ObTxRedoReplayRow;
 
 typedef ObPartTransCtx ReplayTxCtx;
 
@@ -77,7 +80,8 @@ private:
                      const int64_t &log_timestamp)
       : ctx_(nullptr), ls_(ls), ls_tx_srv_(ls_tx_srv), lsn_(lsn),
         log_ts_ns_(log_timestamp), mmi_ptr_(nullptr), mt_ctx_(nullptr), first_created_ctx_(false),
-        has_redo_(false), tx_part_log_no_(0), mvcc_row_count_(0), table_lock_row_count_(0)
+        has_redo_(false), tx_part_log_no_(0), mvcc_row_count_(0), table_lock_row_count_(0),
+        parallel_replay_failed_(false)
   {}
 
   ~ObTxReplayExecutor() { ob_free(mmi_ptr_); }
@@ -107,6 +111,24 @@ private:
   int replay_record_();
 
   int replay_redo_in_memtable_(ObTxRedoLog &redo);
+  bool need_parallel_replay_redo_(const int64_t row_count) const;
+  int parallel_replay_redo_in_memtable_(ObTxRedoLog &redo, bool &is_done);
+  int split_redo_rows_(const int64_t shard_cnt,
+                       const int64_t row_cnt,
+                       ObTxRedoReplayRow *rows,
+                       int64_t *shard_row_idxs,
+                       int64_t *shard_row_cnts);
+  int replay_redo_shard_in_memtable_(ObTxRedoLog &redo,
+                                     ObTxRedoReplayRow *rows,
+                                     const int64_t *row_idxs,
+                                     const int64_t row_cnt,
+                                     memtable::ObTxCallbackList &callback_list);
+  int append_replayed_callbacks_(const ObTxRedoReplayRow *rows,
+                                 const int64_t row_cnt,
+                                 ObTxRedoReplayTask *tasks,
+                                 const int64_t shard_cnt);
+  int64_t get_redo_row_shard_idx_(memtable::ObMemtableMutatorIterator &mmi,
+                                  const int64_t shard_cnt) const;
   virtual int replay_one_row_in_memtable_(memtable::ObMutatorRowHeader& row_head,
                                   memtable::ObMemtableMutatorIterator *mmi_ptr,
                                   memtable::ObEncryptRowBuf &row_buf);
@@ -126,6 +148,8 @@ private:
   void rewrite_replay_retry_code_(int &ret_code);
 
 private:
+  friend class ObTxRedoReplayTask;
+  static const int64_t MAX_REDO_REPLAY_SHARD_COUNT = 16;
   DISALLOW_COPY_AND_ASSIGN(ObTxReplayExecutor);
 
   ReplayTxCtx *ctx_;
@@ -147,6 +171,8 @@ private:
   // memtable::ObMemtable * mem_store_;
   int64_t mvcc_row_count_;
   int64_t table_lock_row_count_;
+  // set when any shard fails during parallel redo replay, so others can stop early
+  bool parallel_replay_failed_;
 };
 }
 } // namespace oceanbase
@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/tx/ob_tx_replay_worker.h"
+#include "storage/tx/ob_tx_replay_executor.h"
+#include "share/ob_thread_mgr.h"
+#include "share/rc/ob_tenant_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+
+namespace transaction
+{
+
+void ObTxRedoReplayTask::init(ObTxReplayExecutor *executor,
+                              ObTxRedoLog *redo,
+                              ObTxRedoReplayRow *rows,
+                              const int64_t *row_idxs,
+                              const int64_t row_cnt,
+                              memtable::ObTxCallbackListTaskGroup *group)
+{
+  executor_ = executor;
+  redo_ = redo;
+  rows_ = rows;
+  row_idxs_ = row_idxs;
+  row_cnt_ = row_cnt;
+  ret_code_ = OB_SUCCESS;
+  group_ = group;
+}
+
+void ObTxRedoReplayTask::run()
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(executor_) || OB_ISNULL(redo_) || OB_ISNULL(group_)
+      || (row_cnt_ > 0 && (OB_ISNULL(rows_) || OB_ISNULL(row_idxs_)))) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(ERROR, "redo replay task is not inited", K(ret), KP(this));
+  } else {
+    if (row_cnt_ > 0) {
+      ret = executor_->replay_redo_shard_in_memtable_(*redo_, rows_, row_idxs_, row_cnt_,
+                                                      callback_list_);
+    }
+    ATOMIC_STORE(&ret_code_, ret);
+    // NB: the task may be freed by the owner after it is finished
+    group_->finish_one();
+  }
+}
+
+int ObTxReplayWorker::init()
+{
+  int ret = OB_SUCCESS;
+
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    TRANS_LOG(WARN, "ObTxReplayWorker inited twice", KR(ret));
+  } else if (OB_FAIL(TG_CREATE_TENANT(lib::TGDefIDs::TxReplayWorker, tg_id_))) {
+    TRANS_LOG(WARN, "thread pool init error", K(ret));
+  } else {
+    is_inited_ = true;
+    TRANS_LOG(INFO, "ObTxReplayWorker inited success", KP(this));
+  }
+
+  return ret;
+}
+
+int ObTxReplayWorker::push(ObTxRedoReplayTask *task)
+{
+  int ret = OB_SUCCESS;
+
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+  } else if (!is_running()) {
+    ret = OB_NOT_RUNNING;
+  } else if (OB_ISNULL(task)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), KP(task));
+  } else {
+    ret = TG_PUSH_TASK(tg_id_, task);
+  }
+
+  return ret;
+}
+
+int ObTxReplayWorker::start()
+{
+  int ret = OB_SUCCESS;
+
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "ObTxReplayWorker is not inited", KR(ret));
+  } else if (is_running_) {
+    ret = OB_ERR_UNEXPECTED;
+    TRANS_LOG(WARN, "ObTxReplayWorker is already running", KR(ret));
+  } else if (OB_FAIL(TG_SET_HANDLER_AND_START(tg_id_, *this))) {
+    TRANS_LOG(WARN, "start tg thread", KR(ret));
+  } else {
+    thread_cnt_ = TG_GET_THREAD_CNT(tg_id_);
+    ATOMIC_STORE(&is_running_, true);
+    TRANS_LOG(INFO, "ObTxReplayWorker start success", KP(this), K_(thread_cnt));
+  }
+
+  return ret;
+}
+
+void ObTxReplayWorker::stop()
+{
+  if (!is_inited_) {
+    TRANS_LOG(WARN, "ObTxReplayWorker is not inited");
+  } else if (!is_running_) {
+    TRANS_LOG(WARN, "ObTxReplayWorker already has been stopped");
+  } else {
+    ATOMIC_STORE(&is_running_, false);
+    TG_STOP(tg_id_);
+    TRANS_LOG(INFO, "ObTxReplayWorker stop success");
+  }
+}
+
+void ObTxReplayWorker::wait()
+{
+  if (!is_inited_) {
+    TRANS_LOG(WARN, "ObTxReplayWorker is not inited");
+  } else if (is_running_) {
+    TRANS_LOG(WARN, "ObTxReplayWorker is running");
+  } else {
+    TG_WAIT(tg_id_);
+    TRANS_LOG(INFO, "ObTxReplayWorker wait success");
+  }
+}
+
+void ObTxReplayWorker::destroy()
+{
+  if (is_inited_) {
+    if (is_running_) {
+      stop();
+      wait();
+    }
+    TG_DESTROY(tg_id_);
+    tg_id_ = -1;
+    thread_cnt_ = 0;
+    is_inited_ = false;
+    TRANS_LOG(INFO, "ObTxReplayWorker destroyed", KP(this));
+  }
+}
+
+void ObTxReplayWorker::handle(void *task)
+{
+  if (NULL == task) {
+    TRANS_LOG(ERROR, "task is null", KP(task));
+  } else {
+    static_cast<ObTxRedoReplayTask *>(task)->run();
+  }
+}
+
+} // transaction
+} // oceanbase
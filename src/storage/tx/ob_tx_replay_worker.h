@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_TRANSACTION_OB_TX_REPLAY_WORKER
+#define OCEANBASE_TRANSACTION_OB_TX_REPLAY_WORKER
+
+#include "lib/atomic/ob_atomic.h"
+#include "lib/thread/thread_mgr_interface.h"
+#include "lib/utility/ob_print_utils.h"
+#include "storage/memtable/mvcc/ob_tx_callback_list.h"
+#include "storage/memtable/mvcc/ob_tx_callback_worker.h"
+
+namespace oceanbase
+{
+namespace transaction
+{
+
+class ObTxReplayExecutor;
+class ObTxRedoLog;
+
+// ObTxRedoReplayRow is one row of a large redo log which is split into shards
+// by ObTxReplayExecutor.
+struct ObTxRedoReplayRow
+{
+  // the position of the row in the mutator buffer
+  int64_t pos_;
+  int32_t shard_idx_;
+  // the number of callbacks appended by the replay of the row, it is set by
+  // the shard and used to append the callbacks in the order of the leader
+  int32_t callback_cnt_;
+  TO_STRING_KV(K_(pos), K_(shard_idx), K_(callback_cnt));
+};
+
+// ObTxRedoReplayTask replays the rows of one shard of a large redo log, the
+// callbacks appended by the replay are kept on its own callback list.
+class ObTxRedoReplayTask
+{
+public:
+  explicit ObTxRedoReplayTask(memtable::ObTransCallbackMgr &callback_mgr)
+    : executor_(NULL),
+      redo_(NULL),
+      rows_(NULL),
+      row_idxs_(NULL),
+      row_cnt_(0),
+      callback_list_(callback_mgr),
+      ret_code_(common::OB_SUCCESS),
+      group_(NULL) {}
+  ~ObTxRedoReplayTask() {}
+  void init(ObTxReplayExecutor *executor,
+            ObTxRedoLog *redo,
+            ObTxRedoReplayRow *rows,
+            const int64_t *row_idxs,
+            const int64_t row_cnt,
+            memtable::ObTxCallbackListTaskGroup *group);
+  // run the task and finish it in the group, the task must not be accessed
+  // by the worker anymore after that because the owner may free it.
+  void run();
+  int get_ret_code() const { return ATOMIC_LOAD(&ret_code_); }
+  memtable::ObTxCallbackList &get_callback_list() { return callback_list_; }
+  TO_STRING_KV(KP_(executor), K_(row_cnt), K_(ret_code));
+private:
+  ObTxReplayExecutor *executor_;
+  ObTxRedoLog *redo_;
+  ObTxRedoReplayRow *rows_;
+  // the indexes of the rows of this shard in rows_, in the order of the log
+  const int64_t *row_idxs_;
+  int64_t row_cnt_;
+  memtable::ObTxCallbackList callback_list_;
+  int ret_code_;
+  memtable::ObTxCallbackListTaskGroup *group_;
+};
+
+// ObTxReplayWorker is the tenant thread pool which replays the rows of large
+// redo logs in parallel on followers.
+class ObTxReplayWorker : public lib::TGTaskHandler
+{
+public:
+  ObTxReplayWorker() : is_inited_(false), is_running_(false), tg_id_(-1), thread_cnt_(0) {}
+  ~ObTxReplayWorker() { destroy(); }
+  int init();
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  int push(ObTxRedoReplayTask *task);
+  bool is_running() const { return ATOMIC_LOAD(&is_running_); }
+  int64_t get_thread_cnt() const { return thread_cnt_; }
+public:
+  void handle(void *task);
+private:
+  bool is_inited_;
+  bool is_running_;
+  int tg_id_;
+  int64_t thread_cnt_;
+};
+
+} // transaction
+} // oceanbase
+
+#endif // OCEANBASE_TRANSACTION_OB_TX_REPLAY_WORKER
@@ -107,12 +107,14 @@ int ObTxCtxMemtable::scan(const ObTableIterParam &param,
 int ObTxCtxMemtable::get(const storage::ObTableIterParam &param,
                          storage::ObTableAccessContext &context,
                          const blocksstable::ObDatumRowkey &rowkey,
-                         blocksstable::ObDatumRow &row)
+                         blocksstable::ObDatumRow &row,
+                         common::ObIAllocator &allocator)
 {
   UNUSED(param);
   UNUSED(context);
   UNUSED(rowkey);
   UNUSED(row);
+  UNUSED(allocator);
   return OB_NOT_SUPPORTED;
 }
 
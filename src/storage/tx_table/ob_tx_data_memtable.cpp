@@ -856,13 +856,15 @@ int ObTxDataMemtable::get_frozen_schema_version(int64_t &schema_version) const
 int ObTxDataMemtable::get(const storage::ObTableIterParam &param,
                           storage::ObTableAccessContext &context,
                           const blocksstable::ObDatumRowkey &rowkey,
-                          blocksstable::ObDatumRow &row)
+                          blocksstable::ObDatumRow &row,
+                          common::ObIAllocator &allocator)
 {
   int ret = OB_NOT_SUPPORTED;
   UNUSED(param);
   UNUSED(context);
   UNUSED(rowkey);
   UNUSED(row);
+  UNUSED(allocator);
   return ret;
 }
 
@@ -214,7 +214,8 @@ public: /* derived from ObIMemtable */
   virtual int get(const storage::ObTableIterParam &param,
                   storage::ObTableAccessContext &context,
                   const blocksstable::ObDatumRowkey &rowkey,
-                  blocksstable::ObDatumRow &row) override;
+                  blocksstable::ObDatumRow &row,
+                  common::ObIAllocator &allocator) override;
   // not supported
   virtual int set(storage::ObStoreCtx &ctx,
                   const uint64_t table_id,
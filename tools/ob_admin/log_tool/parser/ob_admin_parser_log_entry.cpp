@@ -24,6 +24,7 @@
 #include "storage/tx/ob_keep_alive_ls_handler.h"
 #include "logservice/ob_log_base_header.h"
 #include "logservice/ob_garbage_collector.h"
+#include "logservice/palf/log_entry.h"
 
 
 #include <rapidjson/prettywriter.h>
@@ -42,7 +43,7 @@ ObAdminParserLogEntry::ObAdminParserLogEntry(const LogEntry &entry,
                                              const block_id_t block_id,
                                              const LSN lsn,
                                              const ObAdminMutatorStringArg &str_arg)
-    : buf_(entry.get_data_buf()), buf_len_(entry.get_data_len()), pos_(0),
+    : entry_(entry), compressor_(), buf_(NULL), buf_len_(0), pos_(0),
     log_ts_(entry.get_log_ts()), block_id_(block_id), lsn_(lsn)
 {
   str_arg_ = str_arg;
@@ -55,7 +56,9 @@ int ObAdminParserLogEntry::parse()
 {
   int ret = OB_SUCCESS;
   ObLogBaseHeader header;
-  if (OB_FAIL(get_entry_header_(header))) {
+  if (OB_FAIL(compressor_.get_data(entry_, buf_, buf_len_))) {
+    LOG_WARN("get log entry data failed", K(ret), K(entry_), K(block_id_), K(lsn_));
+  } else if (OB_FAIL(get_entry_header_(header))) {
     LOG_WARN("get_entry_header failed", K(ret));
   } else if (OB_FAIL(parse_different_entry_type_(header))){
     LOG_WARN("parse_different_entry_type_ failed", K(ret), K(header));
@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include "storage/tx/ob_tx_log.h"
 #include "logservice/ob_log_base_type.h"
+#include "logservice/palf/log_compressor.h"
 #include "../ob_admin_log_tool_executor.h"
 namespace oceanbase
 {
@@ -72,8 +73,11 @@ private:
                      bool &has_dumped_tx_id);
 
 private:
+  const palf::LogEntry &entry_;
+  // the original payload of 'entry_', it is decompressed by 'compressor_' if needed.
+  palf::LogCompressor compressor_;
   const char *buf_;
-  const int64_t buf_len_;
+  int64_t buf_len_;
   int64_t pos_;
 
   int64_t log_ts_;
@@ -101,7 +101,7 @@ public:
     int64_t log_entry_header_size = entry_header.get_serialize_size();
     int64_t ts = get_timestamp();
 
-    if (OB_FAIL(entry_header.generate_header(buf, buf_len, ts))) {
+    if (OB_FAIL(entry_header.generate_header(buf, buf_len, ts, false))) {
       LOG_ERROR("generate_header failed", KR(ret), K(buf), K(buf_len), K(ts));
     } else {
       log_entry.header_ = entry_header;
@@ -136,7 +136,7 @@ public:
 
     if (OB_FAIL(log_base_header.serialize(buf, serizlize_size, pos))) {
       LOG_ERROR("serialize log_base_header failed", KR(ret), K(buf), K(serizlize_size), K(pos));
-    } else if (OB_FAIL(entry_header.generate_header(buf, serizlize_size, ts))) {
+    } else if (OB_FAIL(entry_header.generate_header(buf, serizlize_size, ts, false))) {
       LOG_ERROR("generate_header for offline log_entry failed", KR(ret));
     } else {
       log_entry.buf_ = buf;
@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "share/ob_define.h"
+#include "lib/oblog/ob_log.h"
+#include "rpc/obmysql/ob_mysql_global.h"
+#include "logservice/libobcdc/src/ob_cdc_column_batch.h"
+
+using namespace oceanbase;
+using namespace common;
+using namespace libobcdc;
+
+namespace oceanbase
+{
+namespace unittest
+{
+
+class TestColumnBatch : public ::testing::Test
+{
+public:
+  static const int64_t MAX_RECORD_COUNT = 8;
+
+  TestColumnBatch() : table_meta_(NULL), other_table_meta_(NULL), record_count_(0) {}
+
+  virtual void SetUp()
+  {
+    table_meta_ = create_table_meta("tb");
+    other_table_meta_ = create_table_meta("tb");
+    ASSERT_TRUE(NULL != table_meta_);
+    ASSERT_TRUE(NULL != other_table_meta_);
+  }
+  virtual void TearDown()
+  {
+    for (int64_t idx = 0; idx < record_count_; idx++) {
+      // table meta is not owned by record
+      records_[idx]->setTableMeta(NULL);
+      DRCMessageFactory::destroy(records_[idx]);
+      records_[idx] = NULL;
+    }
+    record_count_ = 0;
+    DRCMessageFactory::destroy(table_meta_);
+    DRCMessageFactory::destroy(other_table_meta_);
+    table_meta_ = NULL;
+    other_table_meta_ = NULL;
+  }
+
+  // columns: c1 int, c2 varchar utf8, c3 varchar gbk
+  ITableMeta *create_table_meta(const char *tb_name)
+  {
+    ITableMeta *table_meta = DRCMessageFactory::createTableMeta();
+    if (NULL != table_meta) {
+      table_meta->setName(tb_name);
+      add_column(*table_meta, "c1", obmysql::MYSQL_TYPE_LONG, "binary", true);
+      add_column(*table_meta, "c2", obmysql::MYSQL_TYPE_VARCHAR, "utf8mb4");
+      add_column(*table_meta, "c3", obmysql::MYSQL_TYPE_VARCHAR, "gbk");
+    }
+    return table_meta;
+  }
+  void add_column(ITableMeta &table_meta, const char *name, const int type, const char *encoding,
+      const bool is_signed = true)
+  {
+    IColMeta *col_meta = DRCMessageFactory::createColMeta();
+    ASSERT_TRUE(NULL != col_meta);
+    col_meta->setName(name);
+    col_meta->setType(type);
+    col_meta->setEncoding(encoding);
+    col_meta->setSigned(is_signed);
+    ASSERT_EQ(0, table_meta.append(name, col_meta));
+  }
+
+  // the value is NULL if it is NULL
+  IBinlogRecord *create_record(const int record_type, ITableMeta *table_meta,
+      const char *c1, const char *c2, const char *c3)
+  {
+    const char *values[] = {c1, c2, c3};
+    return create_record(record_type, table_meta, values, 3);
+  }
+  IBinlogRecord *create_record(const int record_type, ITableMeta *table_meta,
+      const char **values, const int64_t value_count)
+  {
+    IBinlogRecord *record = NULL;
+    if (record_count_ < MAX_RECORD_COUNT) {
+      record = DRCMessageFactory::createBinlogRecord("LogRecordImpl", true);
+    }
+    if (NULL != record) {
+      records_[record_count_++] = record;
+      record->setRecordType(record_type);
+      record->setTableMeta(table_meta);
+      record->setDbname("db");
+      record->setTbname("tb");
+      for (int64_t idx = 0; idx < value_count; idx++) {
+        const int len = (NULL == values[idx]) ? 0 : static_cast<int>(strlen(values[idx]));
+        if (EDELETE == record_type) {
+          record->putOld(values[idx], len);
+        } else {
+          record->putNew(values[idx], len);
+        }
+      }
+    }
+    return record;
+  }
+
+  // value of the row in the column of array
+  void check_value(const ArrowArray &array, const int64_t col_idx, const int64_t row_idx,
+      const char *expected)
+  {
+    const ArrowArray *child = array.children[ObCDCColumnBatchBuilder::EXTRA_COLUMN_COUNT + col_idx];
+    const uint8_t *bitmap = static_cast<const uint8_t *>(child->buffers[0]);
+    const int64_t *offsets = static_cast<const int64_t *>(child->buffers[1]);
+    const char *data = static_cast<const char *>(child->buffers[2]);
+    const bool is_valid = (0 != (bitmap[row_idx / 8] & (1 << (row_idx % 8))));
+
+    if (NULL == expected) {
+      EXPECT_FALSE(is_valid);
+      EXPECT_EQ(offsets[row_idx], offsets[row_idx + 1]);
+    } else {
+      ASSERT_TRUE(is_valid);
+      ASSERT_EQ(static_cast<int64_t>(strlen(expected)), offsets[row_idx + 1] - offsets[row_idx]);
+      EXPECT_EQ(0, MEMCMP(expected, data + offsets[row_idx], strlen(expected)));
+    }
+  }
+
+  // value of the row in the fixed width column of array
+  template <typename T>
+  void check_fixed_value(const ArrowArray &array, const int64_t col_idx, const int64_t row_idx,
+      const T *expected)
+  {
+    const ArrowArray *child = array.children[ObCDCColumnBatchBuilder::EXTRA_COLUMN_COUNT + col_idx];
+    const uint8_t *bitmap = static_cast<const uint8_t *>(child->buffers[0]);
+    const T *data = static_cast<const T *>(child->buffers[1]);
+    const bool is_valid = (0 != (bitmap[row_idx / 8] & (1 << (row_idx % 8))));
+
+    ASSERT_EQ(2, child->n_buffers);
+    if (NULL == expected) {
+      EXPECT_FALSE(is_valid);
+    } else {
+      ASSERT_TRUE(is_valid);
+      EXPECT_EQ(*expected, data[row_idx]);
+    }
+  }
+
+  ITableMeta *table_meta_;
+  ITableMeta *other_table_meta_;
+  IBinlogRecord *records_[MAX_RECORD_COUNT];
+  int64_t record_count_;
+};
+
+TEST_F(TestColumnBatch, can_append)
+{
+  ObCDCColumnBatchBuilder builder;
+  IBinlogRecord *begin = create_record(EBEGIN, NULL, NULL, NULL, NULL);
+  IBinlogRecord *no_meta = create_record(EINSERT, NULL, "1", "a", "b");
+  IBinlogRecord *insert = create_record(EINSERT, table_meta_, "1", "a", "b");
+  IBinlogRecord *other = create_record(EINSERT, other_table_meta_, "1", "a", "b");
+  ASSERT_TRUE(NULL != begin && NULL != no_meta && NULL != insert && NULL != other);
+
+  EXPECT_FALSE(ObCDCColumnBatchBuilder::is_dml_record(*begin));
+  EXPECT_TRUE(ObCDCColumnBatchBuilder::is_dml_record(*insert));
+  EXPECT_FALSE(builder.can_append(*begin));
+  EXPECT_FALSE(builder.can_append(*no_meta));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, builder.append(*begin));
+  EXPECT_EQ(0, builder.get_row_count());
+
+  // records of different table meta are not in the same batch
+  EXPECT_TRUE(builder.can_append(*other));
+  EXPECT_EQ(OB_SUCCESS, builder.append(*insert));
+  EXPECT_FALSE(builder.can_append(*other));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, builder.append(*other));
+  EXPECT_EQ(1, builder.get_row_count());
+  EXPECT_EQ(insert, builder.get_record(0));
+
+  builder.reset();
+  EXPECT_EQ(0, builder.get_row_count());
+  EXPECT_TRUE(builder.can_append(*other));
+}
+
+TEST_F(TestColumnBatch, build_empty)
+{
+  ObCDCColumnBatchBuilder builder;
+  ArrowSchema schema;
+  ArrowArray array;
+  EXPECT_EQ(OB_STATE_NOT_MATCH, builder.build(schema, array));
+}
+
+TEST_F(TestColumnBatch, build)
+{
+  ObCDCColumnBatchBuilder builder;
+  ArrowSchema schema;
+  ArrowArray array;
+  IBinlogRecord *rows[] = {
+    create_record(EINSERT, table_meta_, "1", "a", "gbk_1"),
+    create_record(EUPDATE, table_meta_, "2", NULL, "gbk_2"),
+    create_record(EDELETE, table_meta_, "3", "ccc", NULL)
+  };
+  const int64_t row_count = sizeof(rows) / sizeof(rows[0]);
+
+  for (int64_t idx = 0; idx < row_count; idx++) {
+    ASSERT_TRUE(NULL != rows[idx]);
+    ASSERT_EQ(OB_SUCCESS, builder.append(*rows[idx]));
+  }
+  ASSERT_EQ(OB_SUCCESS, builder.build(schema, array));
+  // records are still in builder
+  EXPECT_EQ(row_count, builder.get_row_count());
+
+  // schema
+  const int64_t child_count = 3 + ObCDCColumnBatchBuilder::EXTRA_COLUMN_COUNT;
+  EXPECT_STREQ("+s", schema.format);
+  EXPECT_STREQ("db.tb", schema.name);
+  ASSERT_EQ(child_count, schema.n_children);
+  EXPECT_STREQ(ObCDCColumnBatchBuilder::OP_TYPE_COLUMN_NAME, schema.children[0]->name);
+  EXPECT_STREQ("c", schema.children[0]->format);
+  EXPECT_STREQ(ObCDCColumnBatchBuilder::COMMIT_VERSION_COLUMN_NAME, schema.children[1]->name);
+  EXPECT_STREQ("l", schema.children[1]->format);
+  EXPECT_STREQ("c1", schema.children[2]->name);
+  EXPECT_STREQ("l", schema.children[2]->format);
+  EXPECT_STREQ("c2", schema.children[3]->name);
+  EXPECT_STREQ("U", schema.children[3]->format);
+  // not utf8 string
+  EXPECT_STREQ("c3", schema.children[4]->name);
+  EXPECT_STREQ("Z", schema.children[4]->format);
+  EXPECT_EQ(ARROW_FLAG_NULLABLE, schema.children[4]->flags);
+
+  // array
+  EXPECT_EQ(row_count, array.length);
+  ASSERT_EQ(child_count, array.n_children);
+  const int8_t *op_types = static_cast<const int8_t *>(array.children[0]->buffers[1]);
+  const int64_t *commit_versions = static_cast<const int64_t *>(array.children[1]->buffers[1]);
+  for (int64_t idx = 0; idx < row_count; idx++) {
+    EXPECT_EQ(rows[idx]->recordType(), op_types[idx]);
+    // no ObLogBR as user data
+    EXPECT_EQ(0, commit_versions[idx]);
+  }
+  const int64_t c1_values[] = {1, 2, 3};
+  check_fixed_value(array, 0, 0, &c1_values[0]);
+  check_fixed_value(array, 0, 1, &c1_values[1]);
+  check_fixed_value(array, 0, 2, &c1_values[2]);
+  check_value(array, 1, 0, "a");
+  check_value(array, 1, 1, NULL);
+  check_value(array, 1, 2, "ccc");
+  check_value(array, 2, 0, "gbk_1");
+  check_value(array, 2, 1, "gbk_2");
+  check_value(array, 2, 2, NULL);
+  EXPECT_EQ(0, array.children[2]->null_count);
+  EXPECT_EQ(1, array.children[3]->null_count);
+  EXPECT_EQ(1, array.children[4]->null_count);
+
+  // the values are copied, and the batch is released by itself
+  builder.reset();
+  check_value(array, 1, 2, "ccc");
+  schema.release(&schema);
+  array.release(&array);
+  EXPECT_TRUE(NULL == schema.release);
+  EXPECT_TRUE(NULL == array.release);
+}
+
+TEST_F(TestColumnBatch, build_numeric)
+{
+  // columns: i1 bigint, u1 bigint unsigned, d1 double, i2 int
+  ITableMeta *table_meta = DRCMessageFactory::createTableMeta();
+  ASSERT_TRUE(NULL != table_meta);
+  table_meta->setName("tb");
+  add_column(*table_meta, "i1", obmysql::MYSQL_TYPE_LONGLONG, "binary", true);
+  add_column(*table_meta, "u1", obmysql::MYSQL_TYPE_LONGLONG, "binary", false);
+  add_column(*table_meta, "d1", obmysql::MYSQL_TYPE_DOUBLE, "binary", true);
+  add_column(*table_meta, "i2", obmysql::MYSQL_TYPE_LONG, "binary", true);
+
+  ObCDCColumnBatchBuilder builder;
+  ArrowSchema schema;
+  ArrowArray array;
+  const char *row1[] = {"-9223372036854775808", "18446744073709551615", "1.5", "1"};
+  const char *row2[] = {NULL, "0", "-2.25e10", "not_a_number"};
+  IBinlogRecord *rows[] = {
+    create_record(EINSERT, table_meta, row1, 4),
+    create_record(EINSERT, table_meta, row2, 4)
+  };
+  const int64_t row_count = sizeof(rows) / sizeof(rows[0]);
+
+  for (int64_t idx = 0; idx < row_count; idx++) {
+    ASSERT_TRUE(NULL != rows[idx]);
+    ASSERT_EQ(OB_SUCCESS, builder.append(*rows[idx]));
+  }
+  ASSERT_EQ(OB_SUCCESS, builder.build(schema, array));
+
+  EXPECT_STREQ("l", schema.children[2]->format);
+  EXPECT_STREQ("L", schema.children[3]->format);
+  EXPECT_STREQ("g", schema.children[4]->format);
+  // the value can not be parsed, the column is output as string
+  EXPECT_STREQ("U", schema.children[5]->format);
+
+  const int64_t i1_value = INT64_MIN;
+  const uint64_t u1_values[] = {UINT64_MAX, 0};
+  const double d1_values[] = {1.5, -2.25e10};
+  check_fixed_value<int64_t>(array, 0, 0, &i1_value);
+  check_fixed_value<int64_t>(array, 0, 1, NULL);
+  EXPECT_EQ(1, array.children[2]->null_count);
+  check_fixed_value(array, 1, 0, &u1_values[0]);
+  check_fixed_value(array, 1, 1, &u1_values[1]);
+  check_fixed_value(array, 2, 0, &d1_values[0]);
+  check_fixed_value(array, 2, 1, &d1_values[1]);
+  check_value(array, 3, 0, "1");
+  check_value(array, 3, 1, "not_a_number");
+
+  schema.release(&schema);
+  array.release(&array);
+  builder.reset();
+  for (int64_t idx = 0; idx < record_count_; idx++) {
+    records_[idx]->setTableMeta(NULL);
+  }
+  DRCMessageFactory::destroy(table_meta);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_cdc_column_batch.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
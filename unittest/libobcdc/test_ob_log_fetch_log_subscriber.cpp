@@ -0,0 +1,342 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "share/ob_define.h"
+#include "lib/oblog/ob_log.h"
+#define private public
+#include "logservice/libobcdc/src/ob_log_fetch_log_subscriber.h"
+#undef private
+#include "logservice/libobcdc/src/ob_log_rpc.h"
+#include "logservice/libobcdc/src/ob_ls_worker.h"
+#include "logservice/libobcdc/src/ob_log_instance.h"
+#include "logservice/libobcdc/src/ob_log_config.h"
+
+using namespace oceanbase;
+using namespace common;
+using namespace obrpc;
+using namespace libobcdc;
+
+namespace oceanbase
+{
+namespace unittest
+{
+
+typedef ObLogFetchLogSubscriber::RpcCB SubscribeRpcCB;
+
+class MockRpc : public IObLogRpc
+{
+public:
+  MockRpc() : send_ret_(OB_SUCCESS), cbs_(), params_() {}
+  virtual ~MockRpc() {}
+
+  virtual int req_start_lsn_by_tstamp(const uint64_t tenant_id,
+      const common::ObAddr &svr,
+      const ObCdcReqStartLSNByTsReq &req,
+      ObCdcReqStartLSNByTsResp &resp,
+      const int64_t timeout)
+  {
+    UNUSED(tenant_id); UNUSED(svr); UNUSED(req); UNUSED(resp); UNUSED(timeout);
+    return OB_NOT_SUPPORTED;
+  }
+  virtual int async_stream_fetch_log(const uint64_t tenant_id,
+      const common::ObAddr &svr,
+      const ObCdcLSFetchLogReq &req,
+      ObCdcProxy::AsyncCB<OB_LS_FETCH_LOG2> &cb,
+      const int64_t timeout)
+  {
+    UNUSED(tenant_id); UNUSED(svr); UNUSED(req); UNUSED(cb); UNUSED(timeout);
+    return OB_NOT_SUPPORTED;
+  }
+  virtual int async_stream_fetch_missing_log(const uint64_t tenant_id,
+      const common::ObAddr &svr,
+      const ObCdcLSFetchMissLogReq &req,
+      ObCdcProxy::AsyncCB<OB_LS_FETCH_MISSING_LOG> &cb,
+      const int64_t timeout)
+  {
+    UNUSED(tenant_id); UNUSED(svr); UNUSED(req); UNUSED(cb); UNUSED(timeout);
+    return OB_NOT_SUPPORTED;
+  }
+  virtual int async_subscribe_log(const uint64_t tenant_id,
+      const common::ObAddr &svr,
+      const ObCdcLSSubscribeLogReq &req,
+      ObCdcProxy::AsyncCB<OB_LS_SUBSCRIBE_LOG> &cb,
+      const int64_t timeout)
+  {
+    int ret = send_ret_;
+    UNUSED(tenant_id); UNUSED(svr); UNUSED(timeout);
+    if (OB_SUCC(ret)) {
+      EXPECT_GT(req.get_wait_time(), 0);
+      EXPECT_EQ(OB_SUCCESS, cbs_.push_back(static_cast<SubscribeRpcCB *>(&cb)));
+      EXPECT_EQ(OB_SUCCESS, params_.push_back(req.get_params().count()));
+    }
+    return ret;
+  }
+
+  int send_ret_;
+  ObSEArray<SubscribeRpcCB *, 16> cbs_;   // callback of each sent RPC
+  ObSEArray<int64_t, 16> params_;         // param count of each sent RPC
+};
+
+class MockStreamWorker : public IObLSWorker
+{
+public:
+  MockStreamWorker() : dispatched_(), hibernated_() {}
+  virtual ~MockStreamWorker() {}
+
+  virtual int start() { return OB_SUCCESS; }
+  virtual void stop() {}
+  virtual void pause() {}
+  virtual void resume(int64_t fetcher_resume_tstamp) { UNUSED(fetcher_resume_tstamp); }
+  virtual void mark_stop_flag() {}
+  virtual int64_t get_fetcher_resume_tstamp() { return 0; }
+  virtual int dispatch_fetch_task(LSFetchCtx &task, const char *dispatch_reason)
+  {
+    UNUSED(task); UNUSED(dispatch_reason);
+    return OB_NOT_SUPPORTED;
+  }
+  virtual int dispatch_stream_task(FetchStream &task, const char *from_mod)
+  {
+    UNUSED(from_mod);
+    return dispatched_.push_back(&task);
+  }
+  virtual int hibernate_stream_task(FetchStream &task, const char *from_mod)
+  {
+    UNUSED(from_mod);
+    return hibernated_.push_back(&task);
+  }
+  virtual int subscribe_stream_task(FetchStream &task,
+      const TenantLSID &tls_id,
+      const common::ObAddr &svr,
+      const palf::LSN &start_lsn,
+      const char *from_mod)
+  {
+    UNUSED(task); UNUSED(tls_id); UNUSED(svr); UNUSED(start_lsn); UNUSED(from_mod);
+    return OB_NOT_SUPPORTED;
+  }
+
+  bool is_dispatched(FetchStream *stream) const
+  {
+    bool bool_ret = false;
+    for (int64_t idx = 0; ! bool_ret && idx < dispatched_.count(); idx++) {
+      bool_ret = (stream == dispatched_.at(idx));
+    }
+    return bool_ret;
+  }
+
+  ObSEArray<FetchStream *, 16> dispatched_;
+  ObSEArray<FetchStream *, 16> hibernated_;
+};
+
+class MockErrHandler : public IObLogErrHandler
+{
+public:
+  virtual void handle_error(const int err_no, const char *fmt, ...)
+  {
+    UNUSED(err_no); UNUSED(fmt);
+  }
+};
+
+class TestFetchLogSubscriber : public ::testing::Test
+{
+public:
+  static const int64_t STREAM_COUNT = 8;
+  static const uint64_t TENANT_ID = 1001;
+
+  virtual void SetUp()
+  {
+    ObLogFetchLogSubscriber::g_wait_time = 10 * _SEC_;
+    svr_.set_ip_addr("127.0.0.1", 2882);
+    other_svr_.set_ip_addr("127.0.0.2", 2882);
+    ASSERT_EQ(OB_SUCCESS, subscriber_.init(rpc_, worker_, err_handler_));
+  }
+  virtual void TearDown()
+  {
+    // respond the flying RPC, so that the requests are freed
+    for (int64_t idx = 0; idx < rpc_.cbs_.count(); idx++) {
+      if (NULL != rpc_.cbs_.at(idx)) {
+        rpc_.cbs_.at(idx)->do_process_(OB_TIMEOUT, NULL);
+      }
+    }
+    rpc_.cbs_.reset();
+    EXPECT_EQ(OB_SUCCESS, subscriber_.handle_done_requests_());
+    subscriber_.destroy();
+    ObLogFetchLogSubscriber::g_wait_time =
+        ObLogConfig::default_fetch_log_subscribe_wait_time_msec * _MSEC_;
+  }
+
+  FetchStream *stream(const int64_t idx)
+  {
+    return reinterpret_cast<FetchStream *>(&streams_[idx]);
+  }
+  int subscribe(const int64_t idx, const ObAddr &svr)
+  {
+    return subscriber_.subscribe(*stream(idx), TENANT_ID, share::ObLSID(idx + 1), svr,
+        palf::LSN(100));
+  }
+  void respond(const int64_t rpc_idx, const int64_t *notified_ls, const int64_t count)
+  {
+    ObCdcLSSubscribeLogResp resp;
+    for (int64_t idx = 0; idx < count; idx++) {
+      ObCdcLSSubscribeLogResp::SubscribeResult result;
+      result.reset(share::ObLSID(notified_ls[idx]), OB_SUCCESS, palf::LSN(200));
+      ASSERT_EQ(OB_SUCCESS, resp.append_result(result));
+    }
+    rpc_.cbs_.at(rpc_idx)->do_process_(OB_SUCCESS, &resp);
+    rpc_.cbs_.at(rpc_idx) = NULL;
+  }
+
+  int64_t streams_[STREAM_COUNT];
+  ObAddr svr_;
+  ObAddr other_svr_;
+  MockRpc rpc_;
+  MockStreamWorker worker_;
+  MockErrHandler err_handler_;
+  ObLogFetchLogSubscriber subscriber_;
+};
+
+TEST_F(TestFetchLogSubscriber, invalid_argument)
+{
+  ObLogFetchLogSubscriber subscriber;
+  EXPECT_EQ(OB_NOT_INIT, subscriber.subscribe(*stream(0), TENANT_ID, share::ObLSID(1), svr_,
+      palf::LSN(100)));
+  EXPECT_EQ(OB_INIT_TWICE, subscriber_.init(rpc_, worker_, err_handler_));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, subscriber_.subscribe(*stream(0), TENANT_ID, share::ObLSID(),
+      svr_, palf::LSN(100)));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, subscriber_.subscribe(*stream(0), TENANT_ID, share::ObLSID(1),
+      ObAddr(), palf::LSN(100)));
+}
+
+TEST_F(TestFetchLogSubscriber, one_rpc_per_server)
+{
+  ASSERT_EQ(OB_SUCCESS, subscribe(0, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscribe(1, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscribe(2, other_svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(2, rpc_.cbs_.count());
+  EXPECT_EQ(2, rpc_.params_.at(0));
+  EXPECT_EQ(1, rpc_.params_.at(1));
+  EXPECT_EQ(2, subscriber_.flying_requests_.count());
+  EXPECT_EQ(0, subscriber_.pending_tasks_.count());
+}
+
+TEST_F(TestFetchLogSubscriber, dispatch_notified_streams)
+{
+  for (int64_t idx = 0; idx < 3; idx++) {
+    ASSERT_EQ(OB_SUCCESS, subscribe(idx, svr_));
+  }
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(1, rpc_.cbs_.count());
+
+  // LS 2 has new logs, the others are subscribed again
+  const int64_t notified_ls[] = {2};
+  respond(0, notified_ls, 1);
+  ASSERT_EQ(OB_SUCCESS, subscriber_.handle_done_requests_());
+  EXPECT_EQ(0, subscriber_.flying_requests_.count());
+  ASSERT_EQ(1, worker_.dispatched_.count());
+  EXPECT_TRUE(worker_.is_dispatched(stream(1)));
+  EXPECT_EQ(2, subscriber_.pending_tasks_.count());
+
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(2, rpc_.cbs_.count());
+  EXPECT_EQ(2, rpc_.params_.at(1));
+  EXPECT_EQ(0, worker_.hibernated_.count());
+}
+
+TEST_F(TestFetchLogSubscriber, new_task_not_wait_flying_rpc)
+{
+  ASSERT_EQ(OB_SUCCESS, subscribe(0, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(1, rpc_.cbs_.count());
+
+  // the task arrived after the RPC was sent is subscribed by a new RPC
+  ASSERT_EQ(OB_SUCCESS, subscribe(1, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(2, rpc_.cbs_.count());
+  EXPECT_EQ(0, subscriber_.pending_tasks_.count());
+
+  // the flying RPC of a server is limited
+  const int64_t max_flying = ObLogFetchLogSubscriber::MAX_FLYING_RPC_PER_SVR;
+  for (int64_t idx = 2; idx < max_flying; idx++) {
+    ASSERT_EQ(OB_SUCCESS, subscribe(idx, svr_));
+    ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  }
+  ASSERT_EQ(max_flying, rpc_.cbs_.count());
+  ASSERT_EQ(OB_SUCCESS, subscribe(max_flying, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  EXPECT_EQ(max_flying, rpc_.cbs_.count());
+  EXPECT_EQ(1, subscriber_.pending_tasks_.count());
+
+  // sent after one RPC of the server is done
+  const int64_t notified_ls[] = {1};
+  respond(0, notified_ls, 1);
+  ASSERT_EQ(OB_SUCCESS, subscriber_.handle_done_requests_());
+  EXPECT_TRUE(worker_.is_dispatched(stream(0)));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  EXPECT_EQ(max_flying + 1, rpc_.cbs_.count());
+  EXPECT_EQ(0, subscriber_.pending_tasks_.count());
+}
+
+TEST_F(TestFetchLogSubscriber, hibernate_when_rpc_fail)
+{
+  ASSERT_EQ(OB_SUCCESS, subscribe(0, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscribe(1, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(1, rpc_.cbs_.count());
+  rpc_.cbs_.at(0)->do_process_(OB_NOT_SUPPORTED, NULL);
+  rpc_.cbs_.at(0) = NULL;
+  ASSERT_EQ(OB_SUCCESS, subscriber_.handle_done_requests_());
+  EXPECT_EQ(2, worker_.hibernated_.count());
+  EXPECT_EQ(0, worker_.dispatched_.count());
+
+  // fail to send
+  rpc_.send_ret_ = OB_RPC_SEND_ERROR;
+  ASSERT_EQ(OB_SUCCESS, subscribe(2, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(OB_SUCCESS, subscriber_.handle_done_requests_());
+  EXPECT_EQ(3, worker_.hibernated_.count());
+  EXPECT_EQ(0, subscriber_.flying_requests_.count());
+}
+
+TEST_F(TestFetchLogSubscriber, dispatch_expired_streams)
+{
+  ObLogFetchLogSubscriber::g_wait_time = 0;
+  ASSERT_EQ(OB_SUCCESS, subscribe(0, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  EXPECT_EQ(0, rpc_.cbs_.count());
+  EXPECT_TRUE(worker_.is_dispatched(stream(0)));
+
+  // expired when the RPC is done without notification
+  ObLogFetchLogSubscriber::g_wait_time = 10 * _MSEC_;
+  ASSERT_EQ(OB_SUCCESS, subscribe(1, svr_));
+  ASSERT_EQ(OB_SUCCESS, subscriber_.launch_requests_());
+  ASSERT_EQ(1, rpc_.cbs_.count());
+  ::usleep(20 * 1000);
+  respond(0, NULL, 0);
+  ASSERT_EQ(OB_SUCCESS, subscriber_.handle_done_requests_());
+  EXPECT_TRUE(worker_.is_dispatched(stream(1)));
+  EXPECT_EQ(0, subscriber_.pending_tasks_.count());
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_log_fetch_log_subscriber.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
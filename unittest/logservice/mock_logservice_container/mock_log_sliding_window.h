@@ -123,6 +123,7 @@ public:
   // ================= log sync part begin
   int submit_log(const char *buf,
                  const int64_t buf_len,
+                 const bool is_compressed,
                  const int64_t ref_ts_ns,
                  LSN &lsn,
                  int64_t &log_timestamp)
@@ -130,6 +131,7 @@ public:
     int ret = OB_SUCCESS;
     UNUSED(buf);
     UNUSED(buf_len);
+    UNUSED(is_compressed);
     UNUSED(ref_ts_ns);
     UNUSED(lsn);
     UNUSED(log_timestamp);
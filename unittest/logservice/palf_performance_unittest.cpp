@@ -123,7 +123,7 @@ public:
       }
       OB_ASSERT(
           OB_SUCCESS == e_header.generate_header(
-                            buf + sizeof(header) + sizeof(e_header) + pos, curr_log_entry_sz - sizeof(e_header), 1));
+                            buf + sizeof(header) + sizeof(e_header) + pos, curr_log_entry_sz - sizeof(e_header), 1, false));
       OB_ASSERT(OB_SUCCESS == e_header.serialize(buf + sizeof(header), buf_len, pos));
       remain_size -= curr_log_entry_sz;
       pos += (curr_log_entry_sz - sizeof(e_header));
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "logservice/palf/fetch_log_engine.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+namespace unittest
+{
+static const int64_t MB = 1024 * 1024L;
+
+TEST(TestFetchLogStream, test_flow_control)
+{
+  FetchLogStream stream;
+  FetchLogStreamChunk chunk;
+  bool is_ready = false;
+  const ObAddr server(ObAddr::IPV4, "127.0.0.1", 1000);
+  const int64_t window_size = 16 * MB;
+  const int64_t seq = stream.open(server, 1, 1);
+  EXPECT_LT(0, seq);
+  EXPECT_TRUE(stream.is_current(seq));
+
+  // the first chunk (fetch request) [0, 8M) has been sent, next chunk is ready
+  EXPECT_EQ(OB_SUCCESS, stream.on_chunk_sent(seq, LSN(8 * MB - 100), LSN(8 * MB), window_size, chunk, is_ready));
+  EXPECT_TRUE(is_ready);
+  EXPECT_EQ(seq, chunk.seq_);
+  EXPECT_EQ(server, chunk.server_);
+  EXPECT_EQ(LSN(8 * MB - 100), chunk.prev_lsn_);
+  EXPECT_EQ(LSN(8 * MB), chunk.start_lsn_);
+  EXPECT_EQ(window_size / 2, chunk.log_size_);
+
+  // [8M, 16M) has been sent, the next chunk waits for ack of the first chunk
+  chunk.reset();
+  EXPECT_EQ(OB_SUCCESS, stream.on_chunk_sent(seq, LSN(16 * MB - 100), LSN(16 * MB), window_size, chunk, is_ready));
+  EXPECT_FALSE(is_ready);
+  EXPECT_FALSE(stream.on_ack(server, LSN(4 * MB), chunk));
+  EXPECT_EQ(12 * MB, stream.get_outstanding_size());
+  // ack from other server is ignored
+  EXPECT_FALSE(stream.on_ack(ObAddr(ObAddr::IPV4, "127.0.0.1", 1001), LSN(16 * MB), chunk));
+  EXPECT_TRUE(stream.on_ack(server, LSN(8 * MB), chunk));
+  EXPECT_EQ(LSN(16 * MB), chunk.start_lsn_);
+  EXPECT_EQ(LSN(16 * MB - 100), chunk.prev_lsn_);
+  // no chunk is waiting for ack
+  EXPECT_FALSE(stream.on_ack(server, LSN(16 * MB), chunk));
+}
+
+TEST(TestFetchLogStream, test_reset_and_preempt)
+{
+  FetchLogStream stream;
+  FetchLogStreamChunk chunk;
+  bool is_ready = false;
+  const ObAddr server1(ObAddr::IPV4, "127.0.0.1", 1000);
+  const ObAddr server2(ObAddr::IPV4, "127.0.0.1", 1001);
+  const int64_t seq1 = stream.open(server1, 1, 1);
+  EXPECT_LT(0, seq1);
+  // another follower can not open stream when server1 is active
+  EXPECT_EQ(0, stream.open(server2, 1, 1));
+  // a new request from server1 resets the stream, the old chunks are stale
+  const int64_t seq2 = stream.open(server1, 1, 1);
+  EXPECT_LT(seq1, seq2);
+  EXPECT_FALSE(stream.is_current(seq1));
+  EXPECT_EQ(OB_STATE_NOT_MATCH, stream.on_chunk_sent(seq1, LSN(100), LSN(200), 16 * MB, chunk, is_ready));
+  EXPECT_FALSE(is_ready);
+  // server1 has caught up
+  stream.close(seq2);
+  EXPECT_FALSE(stream.is_current(seq2));
+  EXPECT_LT(seq2, stream.open(server2, 1, 1));
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_fetch_log_stream.log*");
+  OB_LOGGER.set_file_name("test_fetch_log_stream.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_fetch_log_stream");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <thread>
+#define private public
+#include "logservice/palf/log_aio_writer.h"
+#undef private
+#include "lib/ob_errno.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace common;
+using namespace palf;
+
+class TestLogAIOWriter : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    fd_ = ::open(FILE_NAME, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_LE(0, fd_);
+    for (int64_t i = 0; i < WRITE_COUNT; i++) {
+      MEMSET(bufs_[i], 'a' + i, WRITE_SIZE);
+    }
+  }
+  virtual void TearDown()
+  {
+    ::close(fd_);
+    ::unlink(FILE_NAME);
+  }
+  bool check_data(const int64_t count)
+  {
+    bool bool_ret = true;
+    char buf[WRITE_SIZE];
+    for (int64_t i = 0; bool_ret && i < count; i++) {
+      bool_ret = WRITE_SIZE == ::pread(fd_, buf, WRITE_SIZE, i * WRITE_SIZE)
+                 && 0 == MEMCMP(buf, bufs_[i], WRITE_SIZE);
+    }
+    return bool_ret;
+  }
+  // make 'ctx' look like an inflight write of 'writer'.
+  void mock_inflight(LogAIOWriter &writer, const int fd, LogAIOWriteCtx &ctx)
+  {
+    ctx.writer_ = &writer;
+    ctx.fd_ = fd;
+    ctx.buf_ = bufs_[0];
+    ctx.count_ = WRITE_SIZE;
+    ctx.offset_ = 0;
+    ctx.submit_ts_ = ObTimeUtility::current_time();
+    ctx.slot_ = 0;
+    ctx.is_inflight_ = true;
+    writer.inflight_ctxs_[0] = &ctx;
+    writer.inflight_count_++;
+  }
+  static constexpr const char *FILE_NAME = "test_log_aio_writer.data";
+  static const int64_t WRITE_SIZE = 4096;
+  static const int64_t WRITE_COUNT = 8;
+  int fd_;
+  char bufs_[WRITE_COUNT][WRITE_SIZE];
+};
+
+TEST_F(TestLogAIOWriter, test_submit_and_wait_all)
+{
+  LogAIOWriter writer;
+  LogAIOWriteCtx ctxs[WRITE_COUNT];
+  EXPECT_EQ(OB_INVALID_ARGUMENT, writer.init(0));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, writer.init(LogAIOWriter::MAX_INFLIGHT_COUNT + 1));
+  ASSERT_EQ(OB_SUCCESS, writer.init(4));
+  EXPECT_EQ(OB_INIT_TWICE, writer.init(4));
+  writer.set_inflight_limit(2);
+  for (int64_t i = 0; i < WRITE_COUNT; i++) {
+    EXPECT_EQ(OB_SUCCESS, writer.submit(fd_, bufs_[i], WRITE_SIZE, i * WRITE_SIZE, ctxs[i]));
+    EXPECT_GE(2, writer.get_inflight_count());
+  }
+  // the ctx is still in flight
+  if (ctxs[WRITE_COUNT - 1].is_inflight()) {
+    EXPECT_EQ(OB_INVALID_ARGUMENT, writer.submit(fd_, bufs_[0], WRITE_SIZE, 0, ctxs[WRITE_COUNT - 1]));
+  }
+  EXPECT_EQ(OB_SUCCESS, writer.wait_all());
+  EXPECT_EQ(0, writer.get_inflight_count());
+  for (int64_t i = 0; i < WRITE_COUNT; i++) {
+    EXPECT_FALSE(ctxs[i].is_inflight());
+    EXPECT_EQ(OB_SUCCESS, ctxs[i].get_ret());
+  }
+  EXPECT_TRUE(check_data(WRITE_COUNT));
+  // the limit is bounded by max_inflight_count
+  writer.set_inflight_limit(100);
+  EXPECT_EQ(4, writer.inflight_limit_);
+  writer.set_inflight_limit(0);
+  EXPECT_EQ(1, writer.inflight_limit_);
+  writer.destroy();
+  EXPECT_FALSE(writer.is_inited());
+}
+
+TEST_F(TestLogAIOWriter, test_wait_one)
+{
+  LogAIOWriter writer;
+  LogAIOWriteCtx ctx;
+  ASSERT_EQ(OB_SUCCESS, writer.init(4));
+  EXPECT_EQ(OB_SUCCESS, writer.submit(fd_, bufs_[0], WRITE_SIZE, 0, ctx));
+  EXPECT_EQ(OB_SUCCESS, ctx.wait());
+  EXPECT_FALSE(ctx.is_inflight());
+  EXPECT_EQ(0, writer.get_inflight_count());
+  // wait a completed write returns its result
+  EXPECT_EQ(OB_SUCCESS, ctx.wait());
+  EXPECT_TRUE(check_data(1));
+}
+
+TEST_F(TestLogAIOWriter, test_failed_write_is_rewritten)
+{
+  LogAIOWriter writer;
+  LogAIOWriteCtx ctx;
+  ASSERT_EQ(OB_SUCCESS, writer.init(4));
+  mock_inflight(writer, fd_, ctx);
+  writer.handle_completion_(ctx, -EIO);
+  EXPECT_FALSE(ctx.is_inflight());
+  EXPECT_EQ(OB_SUCCESS, ctx.get_ret());
+  EXPECT_EQ(0, writer.get_inflight_count());
+  EXPECT_EQ(1, writer.rewrite_count_);
+  EXPECT_TRUE(check_data(1));
+}
+
+TEST_F(TestLogAIOWriter, test_rewrite_until_success)
+{
+  LogAIOWriter writer;
+  LogAIOWriteCtx ctx;
+  const int fd = ::open(FILE_NAME, O_RDONLY);
+  ASSERT_LE(0, fd);
+  ASSERT_EQ(OB_SUCCESS, writer.init(4));
+  mock_inflight(writer, fd, ctx);
+  // the write keeps failing on the read only fd, until 'fd' is redirected to a
+  // writable file.
+  std::thread repair([&]() {
+    ::usleep(500 * 1000);
+    EXPECT_EQ(fd, ::dup2(fd_, fd));
+  });
+  const int64_t start_ts = ObTimeUtility::current_time();
+  writer.handle_completion_(ctx, -EIO);
+  repair.join();
+  EXPECT_LE(500 * 1000, ObTimeUtility::current_time() - start_ts);
+  EXPECT_FALSE(ctx.is_inflight());
+  EXPECT_EQ(OB_SUCCESS, ctx.get_ret());
+  EXPECT_EQ(OB_SUCCESS, ctx.wait());
+  EXPECT_EQ(0, writer.get_inflight_count());
+  EXPECT_TRUE(check_data(1));
+  ::close(fd);
+}
+
+TEST_F(TestLogAIOWriter, test_destroy_io_context)
+{
+  LogAIOWriter writer;
+  LogAIOWriteCtx ctxs[2];
+  LogAIOWriteCtx ctx;
+  ASSERT_EQ(OB_SUCCESS, writer.init(4));
+  EXPECT_EQ(OB_SUCCESS, writer.submit(fd_, bufs_[0], WRITE_SIZE, 0, ctxs[0]));
+  EXPECT_EQ(OB_SUCCESS, writer.submit(fd_, bufs_[1], WRITE_SIZE, WRITE_SIZE, ctxs[1]));
+  // io_getevents keeps failing, the inflight writes are rewritten synchronously
+  writer.destroy_io_context_();
+  EXPECT_FALSE(writer.is_inited());
+  EXPECT_EQ(0, writer.get_inflight_count());
+  EXPECT_EQ(OB_SUCCESS, ctxs[0].wait());
+  EXPECT_EQ(OB_SUCCESS, ctxs[1].wait());
+  EXPECT_TRUE(check_data(2));
+  // the caller need write synchronously
+  EXPECT_EQ(OB_NOT_INIT, writer.submit(fd_, bufs_[2], WRITE_SIZE, 2 * WRITE_SIZE, ctx));
+  EXPECT_EQ(OB_SUCCESS, writer.wait_all());
+  writer.destroy();
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_aio_writer.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_log_aio_writer");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
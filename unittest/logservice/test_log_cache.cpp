@@ -0,0 +1,170 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "share/cache/ob_kv_storecache.h"
+#include "share/ob_simple_mem_limit_getter.h"
+#include "logservice/palf/log_cache.h"
+#include "logservice/palf/log_writer_utils.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+namespace unittest
+{
+static ObSimpleMemLimitGetter getter;
+static const int64_t PAGE_SIZE = LogStorageCache::LOG_CACHE_PAGE_SIZE;
+
+class TestLogCache : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    int ret = OB_SUCCESS;
+    ASSERT_EQ(OB_SUCCESS, getter.add_tenant(OB_SERVER_TENANT_ID, 128 * 1024 * 1024, 256 * 1024 * 1024));
+    ret = ObKVGlobalCache::get_instance().init(&getter, 1024, 1024 * 1024 * 1024, lib::ACHUNK_SIZE);
+    ASSERT_EQ(OB_SUCCESS, ret);
+    ASSERT_EQ(OB_SUCCESS, LogCache::get_instance().init("log_cache", LogCache::LOG_CACHE_PRIORITY));
+  }
+  virtual void TearDown()
+  {
+    LogCache::get_instance().destroy();
+    ObKVGlobalCache::get_instance().destroy();
+    getter.reset();
+  }
+};
+
+static void fill_data(char *buf, const int64_t len)
+{
+  for (int64_t i = 0; i < len; i++) {
+    buf[i] = static_cast<char>(i % 251);
+  }
+}
+
+TEST_F(TestLogCache, test_append_and_read)
+{
+  const int64_t data_len = 3 * PAGE_SIZE + 100;
+  char *data = static_cast<char *>(ob_malloc(data_len, "TestLogCache"));
+  char *read_buf = static_cast<char *>(ob_malloc(data_len, "TestLogCache"));
+  ASSERT_TRUE(NULL != data && NULL != read_buf);
+  fill_data(data, data_len);
+
+  LogStorageCache cache;
+  ASSERT_EQ(OB_SUCCESS, cache.init(1, PALF_BLOCK_SIZE));
+  ASSERT_TRUE(cache.is_enabled());
+
+  // write logs in small pieces, the complete pages are cached.
+  const int64_t step = 1000;
+  for (int64_t pos = 0; pos < data_len; pos += step) {
+    LogWriteBuf write_buf;
+    ASSERT_EQ(OB_SUCCESS, write_buf.push_back(data + pos, MIN(step, data_len - pos)));
+    cache.append(LSN(pos), write_buf);
+  }
+  bool hit = false;
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(100), 2 * PAGE_SIZE, read_buf, hit));
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(0, MEMCMP(data + 100, read_buf, 2 * PAGE_SIZE));
+
+  // the last page is not complete.
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(3 * PAGE_SIZE), 100, read_buf, hit));
+  EXPECT_FALSE(hit);
+
+  // truncate invalidates all pages.
+  cache.invalidate();
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(0), PAGE_SIZE, read_buf, hit));
+  EXPECT_FALSE(hit);
+
+  // fill by the data read from disk, only the complete pages are cached.
+  cache.fill(cache.get_epoch(), LSN(100), data + 100, 2 * PAGE_SIZE);
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(PAGE_SIZE), PAGE_SIZE, read_buf, hit));
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(0, MEMCMP(data + PAGE_SIZE, read_buf, PAGE_SIZE));
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(0), PAGE_SIZE, read_buf, hit));
+  EXPECT_FALSE(hit);
+
+  cache.destroy();
+  ob_free(data);
+  ob_free(read_buf);
+}
+
+TEST_F(TestLogCache, test_truncate_before_fill)
+{
+  const int64_t data_len = 2 * PAGE_SIZE;
+  char *data = static_cast<char *>(ob_malloc(data_len, "TestLogCache"));
+  char *read_buf = static_cast<char *>(ob_malloc(data_len, "TestLogCache"));
+  ASSERT_TRUE(NULL != data && NULL != read_buf);
+  fill_data(data, data_len);
+
+  LogStorageCache cache;
+  ASSERT_EQ(OB_SUCCESS, cache.init(1, PALF_BLOCK_SIZE));
+  bool hit = false;
+  // the reader misses and gets the epoch before reading from disk.
+  const int64_t epoch = cache.get_epoch();
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(0), data_len, read_buf, hit));
+  EXPECT_FALSE(hit);
+  // truncate happens while the reader is reading disk.
+  cache.invalidate();
+  // the stale data must not be hit after truncate.
+  cache.fill(epoch, LSN(0), data, data_len);
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(0), PAGE_SIZE, read_buf, hit));
+  EXPECT_FALSE(hit);
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(PAGE_SIZE), PAGE_SIZE, read_buf, hit));
+  EXPECT_FALSE(hit);
+  // the data read after truncate can be cached.
+  cache.fill(cache.get_epoch(), LSN(0), data, data_len);
+  ASSERT_EQ(OB_SUCCESS, cache.read(LSN(0), data_len, read_buf, hit));
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(0, MEMCMP(data, read_buf, data_len));
+
+  cache.destroy();
+  ob_free(data);
+  ob_free(read_buf);
+}
+
+TEST_F(TestLogCache, test_last_page_of_block)
+{
+  // the last page of block is shorter than LOG_CACHE_PAGE_SIZE.
+  const int64_t last_page_size = PALF_BLOCK_SIZE % PAGE_SIZE;
+  const LSN last_page_lsn(PALF_BLOCK_SIZE - last_page_size);
+  char *data = static_cast<char *>(ob_malloc(last_page_size, "TestLogCache"));
+  char *read_buf = static_cast<char *>(ob_malloc(last_page_size, "TestLogCache"));
+  ASSERT_TRUE(NULL != data && NULL != read_buf);
+  fill_data(data, last_page_size);
+
+  LogStorageCache cache;
+  ASSERT_EQ(OB_SUCCESS, cache.init(1, PALF_BLOCK_SIZE));
+  LogWriteBuf write_buf;
+  ASSERT_EQ(OB_SUCCESS, write_buf.push_back(data, last_page_size));
+  cache.append(last_page_lsn, write_buf);
+  bool hit = false;
+  ASSERT_EQ(OB_SUCCESS, cache.read(last_page_lsn, last_page_size, read_buf, hit));
+  EXPECT_TRUE(hit);
+  EXPECT_EQ(0, MEMCMP(data, read_buf, last_page_size));
+
+  cache.destroy();
+  ob_free(data);
+  ob_free(read_buf);
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_log_cache.log*");
+  OB_LOGGER.set_file_name("test_log_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_log_cache");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#define private public
+#include "logservice/palf/log_compressor.h"
+#undef private
+#include "logservice/palf/log_define.h"
+#include "lib/compress/ob_compressor_pool.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+namespace unittest
+{
+
+class TestLogCompressor : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    data_ = static_cast<char *>(ob_malloc(MAX_LOG_BODY_SIZE, "TestLogCompress"));
+    ASSERT_TRUE(NULL != data_);
+  }
+  virtual void TearDown()
+  {
+    ob_free(data_);
+    data_ = NULL;
+  }
+  void fill_compressible(const int64_t len)
+  {
+    for (int64_t i = 0; i < len; i++) {
+      data_[i] = static_cast<char>('a' + (i % 16));
+    }
+  }
+  void fill_random(const int64_t len)
+  {
+    srandom(static_cast<unsigned int>(ObTimeUtility::current_time()));
+    for (int64_t i = 0; i < len; i++) {
+      data_[i] = static_cast<char>(random() & 0xFF);
+    }
+  }
+  char *data_;
+};
+
+TEST_F(TestLogCompressor, test_round_trip)
+{
+  const int64_t lens[] = {LogCompressor::MIN_COMPRESS_SIZE, 64 * 1024, MAX_LOG_BODY_SIZE};
+  ObCompressorType types[] = {LZ4_COMPRESSOR, ZSTD_1_3_8_COMPRESSOR};
+  LogCompressor compressor;
+  LogCompressor decompressor;
+  for (int64_t i = 0; i < ARRAYSIZEOF(types); i++) {
+    for (int64_t j = 0; j < ARRAYSIZEOF(lens); j++) {
+      const char *out = NULL;
+      int64_t out_len = 0;
+      bool is_compressed = false;
+      const char *payload = NULL;
+      int64_t payload_len = 0;
+      fill_compressible(lens[j]);
+      EXPECT_EQ(OB_SUCCESS, compressor.compress(types[i], data_, lens[j], out, out_len, is_compressed));
+      EXPECT_TRUE(is_compressed);
+      EXPECT_LT(out_len, lens[j]);
+      EXPECT_EQ(OB_SUCCESS, decompressor.decompress(out, out_len, payload, payload_len));
+      EXPECT_EQ(lens[j], payload_len);
+      EXPECT_EQ(0, MEMCMP(data_, payload, lens[j]));
+    }
+  }
+  // the buffer is bounded by the max size of log body.
+  int64_t max_overflow_size = 0;
+  ObCompressor *lz4 = NULL;
+  ASSERT_EQ(OB_SUCCESS, ObCompressorPool::get_instance().get_compressor(LZ4_COMPRESSOR, lz4));
+  ASSERT_EQ(OB_SUCCESS, lz4->get_max_overflow_size(MAX_LOG_BODY_SIZE, max_overflow_size));
+  EXPECT_GE(LogCompressor::COMPRESSED_HEADER_SIZE + MAX_LOG_BODY_SIZE + max_overflow_size,
+            compressor.buf_size_);
+}
+
+TEST_F(TestLogCompressor, test_incompressible_fallback)
+{
+  const int64_t len = 64 * 1024;
+  const char *out = NULL;
+  int64_t out_len = 0;
+  bool is_compressed = true;
+  LogCompressor compressor;
+  // the random data can not save 1/8 space, the original data should be submitted.
+  fill_random(len);
+  EXPECT_EQ(OB_SUCCESS, compressor.compress(LZ4_COMPRESSOR, data_, len, out, out_len, is_compressed));
+  EXPECT_FALSE(is_compressed);
+  // short log is not compressed.
+  fill_compressible(len);
+  is_compressed = true;
+  EXPECT_EQ(OB_SUCCESS, compressor.compress(LZ4_COMPRESSOR, data_, LogCompressor::MIN_COMPRESS_SIZE - 1,
+                                            out, out_len, is_compressed));
+  EXPECT_FALSE(is_compressed);
+  is_compressed = true;
+  EXPECT_EQ(OB_SUCCESS, compressor.compress(NONE_COMPRESSOR, data_, len, out, out_len, is_compressed));
+  EXPECT_FALSE(is_compressed);
+  // the compressor is still usable after fallback.
+  EXPECT_EQ(OB_SUCCESS, compressor.compress(LZ4_COMPRESSOR, data_, len, out, out_len, is_compressed));
+  EXPECT_TRUE(is_compressed);
+  // the corrupted data can not be decompressed.
+  const char *payload = NULL;
+  int64_t payload_len = 0;
+  EXPECT_EQ(OB_INVALID_ARGUMENT, compressor.decompress(out, LogCompressor::COMPRESSED_HEADER_SIZE,
+                                                       payload, payload_len));
+}
+
+TEST_F(TestLogCompressor, test_compressor_pool)
+{
+  const uint64_t tenant_id = 1001;
+  LogCompressorPool pool;
+  EXPECT_TRUE(NULL == pool.acquire());
+  EXPECT_EQ(OB_INVALID_ARGUMENT, pool.init(tenant_id, 0));
+  ASSERT_EQ(OB_SUCCESS, pool.init(tenant_id, 2));
+  EXPECT_EQ(OB_INIT_TWICE, pool.init(tenant_id, 2));
+  LogCompressor *c1 = pool.acquire();
+  LogCompressor *c2 = pool.acquire();
+  ASSERT_TRUE(NULL != c1 && NULL != c2);
+  EXPECT_NE(c1, c2);
+  // all compressors are in use.
+  EXPECT_TRUE(NULL == pool.acquire());
+  // the buffer is allocated for the tenant.
+  EXPECT_EQ(tenant_id, c1->attr_.tenant_id_);
+  const char *out = NULL;
+  int64_t out_len = 0;
+  bool is_compressed = false;
+  fill_compressible(64 * 1024);
+  EXPECT_EQ(OB_SUCCESS, c1->compress(LZ4_COMPRESSOR, data_, 64 * 1024, out, out_len, is_compressed));
+  EXPECT_TRUE(is_compressed);
+  pool.release(c1);
+  // the released compressor is reused with its buffer.
+  LogCompressor *c3 = pool.acquire();
+  EXPECT_EQ(c1, c3);
+  EXPECT_TRUE(NULL != c3->buf_);
+  pool.release(c2);
+  pool.release(c3);
+  pool.destroy();
+  EXPECT_TRUE(NULL == pool.acquire());
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_compressor.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_log_compressor");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,7 @@
 #define private public
 #include "logservice/palf/log_group_entry_header.h"
 #include "logservice/palf/log_entry.h"
+#include "logservice/palf/log_compressor.h"
 #undef private
 
 #include <gtest/gtest.h>
@@ -58,8 +59,8 @@ TEST(TestLogGroupEntryHeader, test_log_group_entry_header)
 
   // test LogEntry and LogEntryHeader
   LogEntry log_entry;
-  EXPECT_EQ(OB_INVALID_ARGUMENT, log_entry_header.generate_header(NULL, 0, 1));
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(data, data_len, 1));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_entry_header.generate_header(NULL, 0, 1, false));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(data, data_len, 1, false));
   log_entry.header_ = log_entry_header;
   log_entry.buf_ = data;
   int64_t tmp_pos = 0;
@@ -130,6 +131,56 @@ TEST(TestLogGroupEntryHeader, test_log_group_entry_header)
   EXPECT_TRUE(log_group_entry2.check_integrity());
 }
 
+TEST(TestLogEntryHeader, test_compressed_log_entry)
+{
+  const int64_t BUFSIZE = 64 * 1024;
+  const int64_t data_len = 16 * 1024;
+  char *data = static_cast<char *>(ob_malloc(data_len, "TestLogEntry"));
+  char *buf = static_cast<char *>(ob_malloc(BUFSIZE, "TestLogEntry"));
+  ASSERT_TRUE(NULL != data && NULL != buf);
+  for (int64_t i = 0; i < data_len; i++) {
+    data[i] = static_cast<char>('a' + (i % 16));
+  }
+  LogCompressor compressor;
+  const char *out = NULL;
+  int64_t out_len = 0;
+  bool is_compressed = false;
+  // short log and NONE_COMPRESSOR are not compressed.
+  EXPECT_EQ(OB_SUCCESS, compressor.compress(LZ4_COMPRESSOR, data, LogCompressor::MIN_COMPRESS_SIZE - 1,
+                                            out, out_len, is_compressed));
+  EXPECT_FALSE(is_compressed);
+  EXPECT_EQ(OB_SUCCESS, compressor.compress(NONE_COMPRESSOR, data, data_len, out, out_len, is_compressed));
+  EXPECT_FALSE(is_compressed);
+
+  ObCompressorType types[] = {LZ4_COMPRESSOR, ZSTD_1_3_8_COMPRESSOR};
+  for (int64_t i = 0; i < ARRAYSIZEOF(types); i++) {
+    EXPECT_EQ(OB_SUCCESS, compressor.compress(types[i], data, data_len, out, out_len, is_compressed));
+    EXPECT_TRUE(is_compressed);
+    EXPECT_LT(out_len, data_len);
+    // the checksum covers the compressed data.
+    LogEntryHeader header;
+    EXPECT_EQ(OB_SUCCESS, header.generate_header(out, out_len, 1, true));
+    EXPECT_TRUE(header.is_compressed());
+    EXPECT_TRUE(header.check_integrity(out, out_len));
+    int64_t pos = 0;
+    EXPECT_EQ(OB_SUCCESS, header.serialize(buf, BUFSIZE, pos));
+    MEMCPY(buf + pos, out, out_len);
+    LogEntry log_entry;
+    pos = 0;
+    EXPECT_EQ(OB_SUCCESS, log_entry.deserialize(buf, BUFSIZE, pos));
+    EXPECT_TRUE(log_entry.check_integrity());
+    EXPECT_TRUE(log_entry.get_header().is_compressed());
+    LogCompressor decompressor;
+    const char *payload = NULL;
+    int64_t payload_len = 0;
+    EXPECT_EQ(OB_SUCCESS, decompressor.get_data(log_entry, payload, payload_len));
+    EXPECT_EQ(data_len, payload_len);
+    EXPECT_EQ(0, MEMCMP(data, payload, data_len));
+  }
+  ob_free(data);
+  ob_free(buf);
+}
+
 } // namespace unittest
 } // namespace oceanbase
 
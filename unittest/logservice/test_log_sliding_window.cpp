@@ -199,7 +199,7 @@ TEST_F(TestLogSlidingWindow, test_to_follower_pending)
   int64_t log_ts = -1;
   ref_ts = 99;
   buf_len = 2 * 1024 * 1024;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   EXPECT_EQ(OB_SUCCESS, log_sw_.to_follower_pending(last_lsn));
 }
 
@@ -250,7 +250,7 @@ TEST_F(TestLogSlidingWindow, test_report_log_task_trace)
   int64_t log_ts = -1;
   ref_ts = 99;
   buf_len = 2 * 1024 * 1024;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   EXPECT_EQ(OB_SUCCESS, log_sw_.report_log_task_trace(1));
 }
 
@@ -289,32 +289,32 @@ TEST_F(TestLogSlidingWindow, test_submit_log)
   int64_t ref_ts = 99;
   LSN lsn;
   int64_t log_ts = -1;
-  EXPECT_EQ(OB_NOT_INIT, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_NOT_INIT, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   EXPECT_EQ(OB_SUCCESS, log_sw_.init(palf_id_, self_, &mock_state_mgr_,
         &mock_mm_, &mock_mode_mgr_, &mock_log_engine_, &palf_fs_cb_, alloc_mgr_, base_info));
-  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(NULL, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(NULL, buf_len, false, ref_ts, lsn, log_ts));
   buf_len = 0;
-  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   buf_len = 64 * 1024 * 1024;
-  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   buf_len = 1000;
   ref_ts = -1;
-  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   ref_ts = 99;
   buf_len = 2 * 1024 * 1024;
   for (int i = 0; i < 8; ++i) {
-    EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+    EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   }
   // append to last group log
   buf_len = 1 * 1024 * 1024;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   buf_len = 2 * 1024 * 1024;
   for (int i = 0; i < 11; ++i) {
-    EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+    EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   }
   PALF_LOG(INFO, "current lsn", K(lsn), K(buf_len));
   // 40M已填充39M，无法继续submit 2M log
-  EXPECT_EQ(OB_EAGAIN, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_EAGAIN, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
 }
 
 TEST_F(TestLogSlidingWindow, test_submit_group_log)
@@ -338,7 +338,7 @@ TEST_F(TestLogSlidingWindow, test_submit_group_log)
   char log_data[2048];
   int64_t log_data_len = 2048;
   int64_t group_data_checksum = -1;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   static const int64_t DATA_BUF_LEN = 64 * 1024 * 1024;
   int64_t group_header_size = LogGroupEntryHeader::HEADER_SER_SIZE;
   int64_t pos = 0;
@@ -387,7 +387,7 @@ TEST_F(TestLogSlidingWindow, test_receive_log)
   int64_t buf_len = 2 * 1024 * 1024;
   int64_t ref_ts = 999;
   int64_t log_ts = -1;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   // update lsn for next group entry
   lsn.val_ = lsn.val_ + LogEntryHeader::HEADER_SER_SIZE + buf_len;
   // generate new group entry
@@ -400,7 +400,7 @@ TEST_F(TestLogSlidingWindow, test_receive_log)
   char log_data[2048];
   log_data_len = 2048;
   int64_t group_data_checksum = -1;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   static const int64_t DATA_BUF_LEN = 64 * 1024 * 1024;
   int64_t group_header_size = LogGroupEntryHeader::HEADER_SER_SIZE;
   int64_t pos = 0;
@@ -410,7 +410,7 @@ TEST_F(TestLogSlidingWindow, test_receive_log)
   log_entry_size = pos + log_data_len;
   // gen 2nd log entry
   max_log_ts = 222222;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   pos = 0;
   log_entry_header.serialize(data_buf_ + group_header_size + log_entry_size, DATA_BUF_LEN, pos);
   EXPECT_TRUE(pos > 0);
@@ -563,7 +563,7 @@ TEST_F(TestLogSlidingWindow, test_after_flush_log)
   int64_t ref_ts = 999;
   LSN lsn;
   int64_t log_ts = -1;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   EXPECT_EQ(OB_INVALID_ARGUMENT, log_sw_.after_flush_log(flush_log_ctx));
 
   flush_log_ctx.log_id_ = PALF_SLIDING_WINDOW_SIZE + 100;
@@ -613,7 +613,7 @@ TEST_F(TestLogSlidingWindow, test_truncate_log)
   LSN lsn;
   int64_t log_ts = -1;
   // submit first log
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   EXPECT_EQ(OB_SUCCESS, log_sw_.period_freeze_last_log());
   // generate new group entry
   LogEntryHeader log_entry_header;
@@ -625,7 +625,7 @@ TEST_F(TestLogSlidingWindow, test_truncate_log)
   char log_data[2048];
   int64_t log_data_len = 2048;
   int64_t group_data_checksum = -1;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   static const int64_t DATA_BUF_LEN = 64 * 1024 * 1024;
   int64_t group_header_size = LogGroupEntryHeader::HEADER_SER_SIZE;
   int64_t pos = 0;
@@ -635,7 +635,7 @@ TEST_F(TestLogSlidingWindow, test_truncate_log)
   int64_t log_entry_size = pos + log_data_len;
   // gen 2nd log entry
   max_log_ts = 222222;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   pos = 0;
   log_entry_header.serialize(data_buf_ + group_header_size + log_entry_size, DATA_BUF_LEN, pos);
   EXPECT_TRUE(pos > 0);
@@ -731,7 +731,7 @@ TEST_F(TestLogSlidingWindow, test_ack_log)
   int64_t ref_ts = 999;
   LSN lsn;
   int64_t log_ts = -1;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   LSN end_lsn = lsn + LogEntryHeader::HEADER_SER_SIZE + buf_len;
   ObAddr server;
   server.set_ip_addr("127.0.0.1", 12346);
@@ -775,7 +775,7 @@ TEST_F(TestLogSlidingWindow, test_truncate_for_rebuild)
   int64_t ref_ts = 999;
   LSN lsn;
   int64_t log_ts = -1;
-  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, ref_ts, lsn, log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_sw_.submit_log(buf, buf_len, false, ref_ts, lsn, log_ts));
   // generate new group entry
   LogEntryHeader log_entry_header;
   LogGroupEntryHeader group_header;
@@ -786,7 +786,7 @@ TEST_F(TestLogSlidingWindow, test_truncate_for_rebuild)
   char log_data[2048];
   int64_t log_data_len = 2048;
   int64_t group_data_checksum = -1;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   static const int64_t DATA_BUF_LEN = 64 * 1024 * 1024;
   int64_t group_header_size = LogGroupEntryHeader::HEADER_SER_SIZE;
   int64_t pos = 0;
@@ -796,7 +796,7 @@ TEST_F(TestLogSlidingWindow, test_truncate_for_rebuild)
   int64_t log_entry_size = pos + log_data_len;
   // gen 2nd log entry
   max_log_ts = 222222;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   pos = 0;
   log_entry_header.serialize(data_buf_ + group_header_size + log_entry_size, DATA_BUF_LEN, pos);
   EXPECT_TRUE(pos > 0);
@@ -887,7 +887,7 @@ TEST_F(TestLogSlidingWindow, test_append_disk_log)
   char log_data[2048];
   int64_t log_data_len = 2048;
   int64_t group_data_checksum = -1;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   static const int64_t DATA_BUF_LEN = 64 * 1024 * 1024;
   int64_t group_header_size = LogGroupEntryHeader::HEADER_SER_SIZE;
   int64_t pos = 0;
@@ -910,7 +910,7 @@ TEST_F(TestLogSlidingWindow, test_append_disk_log)
   int64_t log_entry_size = pos + log_data_len;
   // gen 2nd log entry
   max_log_ts = 222222;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   pos = 0;
   log_entry_header.serialize(data_buf_ + group_header_size + log_entry_size, DATA_BUF_LEN, pos);
   EXPECT_TRUE(pos > 0);
@@ -1005,7 +1005,7 @@ TEST_F(TestLogSlidingWindow, test_group_entry_truncate)
   char log_data[2048];
   int64_t log_data_len = 2048;
   int64_t group_data_checksum = -1;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   static const int64_t DATA_BUF_LEN = 64 * 1024 * 1024;
   int64_t group_header_size = LogGroupEntryHeader::HEADER_SER_SIZE;
   int64_t pos = 0;
@@ -1016,7 +1016,7 @@ TEST_F(TestLogSlidingWindow, test_group_entry_truncate)
   int64_t log_entry_size = pos + log_data_len;
   // gen 2nd log entry
   max_log_ts = 222222;
-  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts));
+  EXPECT_EQ(OB_SUCCESS, log_entry_header.generate_header(log_data, log_data_len, max_log_ts, false));
   pos = 0;
   log_entry_header.serialize(data_buf_ + group_header_size + log_entry_size, DATA_BUF_LEN, pos);
   EXPECT_TRUE(pos > 0);
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/utility/ob_test_util.h"
+#include "common/ob_field.h"
+#include "observer/mysql/obsm_row.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+
+class TestSMDatumRow: public ::testing::Test
+{
+public:
+  static const int64_t MAX_CELL_CNT = 16;
+  static const int64_t BUF_LEN = 4096;
+
+  TestSMDatumRow() : cell_cnt_(0) {}
+  virtual ~TestSMDatumRow() {}
+  virtual void SetUp() { cell_cnt_ = 0; }
+  virtual void TearDown() {}
+
+protected:
+  void add_cell(const ObObj &obj, const ObObjType field_type)
+  {
+    ASSERT_LT(cell_cnt_, MAX_CELL_CNT);
+    cells_[cell_cnt_] = obj;
+    fields_[cell_cnt_].type_.set_type(field_type);
+    fields_[cell_cnt_].flags_ = 0;
+    datums_[cell_cnt_].ptr_ = reinterpret_cast<const char *>(datum_bufs_[cell_cnt_]);
+    ASSERT_EQ(OB_SUCCESS, datums_[cell_cnt_].from_obj(obj));
+    datum_ptrs_[cell_cnt_] = &datums_[cell_cnt_];
+    cell_cnt_++;
+  }
+  void add_cell(const ObObj &obj) { add_cell(obj, obj.get_type()); }
+
+  // resolve encoders of all cells, return false if any cell is not supported
+  bool resolve(const ObCharsetType result_charset)
+  {
+    bool all_supported = true;
+    for (int64_t i = 0; i < cell_cnt_; i++) {
+      bool is_supported = false;
+      EXPECT_EQ(OB_SUCCESS, ObSMDatumRow::resolve_encoder(cells_[i].get_meta(), fields_[i],
+          result_charset, encoders_[i], is_supported));
+      all_supported = all_supported && is_supported;
+    }
+    return all_supported;
+  }
+
+  // the datum row must be encoded the same as ObSMRow
+  void check_same_as_obj_row(const MYSQL_PROTOCOL_TYPE type)
+  {
+    char obj_buf[BUF_LEN];
+    char datum_buf[BUF_LEN];
+    int64_t obj_pos = 0;
+    int64_t datum_pos = 0;
+    ObNewRow row;
+    row.cells_ = cells_;
+    row.count_ = cell_cnt_;
+    ObSEArray<ObField, MAX_CELL_CNT> fields;
+    for (int64_t i = 0; i < cell_cnt_; i++) {
+      ASSERT_EQ(OB_SUCCESS, fields.push_back(fields_[i]));
+    }
+    ObDataTypeCastParams dtc_params;
+    ObSMRow obj_row(type, row, dtc_params, &fields);
+    ObSMDatumRow datum_row(type, datum_ptrs_, encoders_, cell_cnt_);
+
+    MEMSET(obj_buf, 0, sizeof(obj_buf));
+    MEMSET(datum_buf, 0, sizeof(datum_buf));
+    ASSERT_EQ(OB_SUCCESS, obj_row.serialize(obj_buf, BUF_LEN, obj_pos));
+    ASSERT_EQ(OB_SUCCESS, datum_row.serialize(datum_buf, BUF_LEN, datum_pos));
+    ASSERT_EQ(obj_pos, datum_pos);
+    EXPECT_EQ(0, MEMCMP(obj_buf, datum_buf, obj_pos));
+
+    // buffer not enough
+    for (int64_t len = 0; len < obj_pos; len++) {
+      int64_t pos = 0;
+      EXPECT_NE(OB_SUCCESS, datum_row.serialize(datum_buf, len, pos));
+      EXPECT_EQ(0, pos);
+    }
+  }
+  void check_same_as_obj_row()
+  {
+    check_same_as_obj_row(TEXT);
+    check_same_as_obj_row(BINARY);
+  }
+
+  void check_one_cell(const ObObj &obj, const ObCharsetType result_charset)
+  {
+    cell_cnt_ = 0;
+    add_cell(obj);
+    ASSERT_TRUE(resolve(result_charset));
+    check_same_as_obj_row();
+  }
+
+  ObObj cells_[MAX_CELL_CNT];
+  ObField fields_[MAX_CELL_CNT];
+  ObDatum datums_[MAX_CELL_CNT];
+  const ObDatum *datum_ptrs_[MAX_CELL_CNT];
+  int64_t datum_bufs_[MAX_CELL_CNT][2];
+  ObSMDatumCellEncoder encoders_[MAX_CELL_CNT];
+  int64_t cell_cnt_;
+};
+
+TEST_F(TestSMDatumRow, int_types)
+{
+  const ObObjType types[] = {ObTinyIntType, ObSmallIntType, ObMediumIntType, ObInt32Type, ObIntType};
+  const int64_t values[] = {0, 1, -1, 127, -128, 32767, -32768, INT32_MAX, INT32_MIN, INT64_MAX, INT64_MIN};
+  for (int64_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    for (int64_t v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+      ObObj obj;
+      obj.set_int(types[t], values[v]);
+      check_one_cell(obj, CHARSET_UTF8MB4);
+    }
+  }
+}
+
+TEST_F(TestSMDatumRow, uint_types)
+{
+  const ObObjType types[] = {ObUTinyIntType, ObUSmallIntType, ObUMediumIntType, ObUInt32Type, ObUInt64Type};
+  const uint64_t values[] = {0, 1, 255, 65535, UINT32_MAX, INT64_MAX, UINT64_MAX};
+  for (int64_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    for (int64_t v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+      ObObj obj;
+      obj.set_uint(types[t], values[v]);
+      check_one_cell(obj, CHARSET_UTF8MB4);
+    }
+  }
+}
+
+TEST_F(TestSMDatumRow, string_types)
+{
+  const ObObjType types[] = {ObVarcharType, ObCharType};
+  const ObCollationType coll_types[] = {CS_TYPE_UTF8MB4_GENERAL_CI, CS_TYPE_UTF8MB4_BIN,
+                                        CS_TYPE_GBK_CHINESE_CI, CS_TYPE_BINARY};
+  const ObCharsetType result_charsets[] = {CHARSET_UTF8MB4, CHARSET_GBK, CHARSET_BINARY,
+                                           CHARSET_INVALID};
+  const char *values[] = {"", "a", "abc", "\xe4\xb8\xad\xe6\x96\x87", "a\0b"};
+  const int64_t value_lens[] = {0, 1, 3, 6, 3};
+  for (int64_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    for (int64_t c = 0; c < sizeof(coll_types) / sizeof(coll_types[0]); c++) {
+      for (int64_t r = 0; r < sizeof(result_charsets) / sizeof(result_charsets[0]); r++) {
+        const ObCollationType coll_type = coll_types[c];
+        const ObCharsetType result_charset = result_charsets[r];
+        // charset of value is converted to character_set_results by ObSMRow path
+        const bool need_convert = CS_TYPE_BINARY != coll_type
+            && CHARSET_BINARY != result_charset
+            && CHARSET_INVALID != result_charset
+            && ObCharset::charset_type_by_coll(coll_type) != result_charset;
+        for (int64_t v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+          ObObj obj;
+          if (ObVarcharType == types[t]) {
+            obj.set_varchar(values[v], static_cast<int32_t>(value_lens[v]));
+          } else {
+            obj.set_char(ObString(value_lens[v], values[v]));
+          }
+          obj.set_collation_type(coll_type);
+          cell_cnt_ = 0;
+          add_cell(obj);
+          if (need_convert) {
+            EXPECT_FALSE(resolve(result_charset));
+          } else {
+            ASSERT_TRUE(resolve(result_charset));
+            check_same_as_obj_row();
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(TestSMDatumRow, null_cells)
+{
+  ObObj null_obj;
+  null_obj.set_null();
+  check_one_cell(null_obj, CHARSET_UTF8MB4);
+
+  // NULL value of int and string column, the bitmap of binary protocol is checked
+  ObObj int_obj;
+  ObObj str_obj;
+  ObObj null_int;
+  ObObj null_str;
+  int_obj.set_int(100);
+  str_obj.set_varchar("abc");
+  str_obj.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  null_int.set_null();
+  null_str.set_null();
+  cell_cnt_ = 0;
+  for (int64_t i = 0; i < 5; i++) {
+    add_cell(int_obj);
+    add_cell(null_int, ObIntType);
+    add_cell(str_obj);
+  }
+  add_cell(null_str, ObVarcharType);
+  // the expr of NULL cell is of the field type
+  for (int64_t i = 0; i < cell_cnt_; i++) {
+    bool is_supported = false;
+    const ObObjMeta meta = cells_[i].is_null() ? fields_[i].type_.get_meta() : cells_[i].get_meta();
+    ASSERT_EQ(OB_SUCCESS, ObSMDatumRow::resolve_encoder(meta, fields_[i], CHARSET_UTF8MB4,
+        encoders_[i], is_supported));
+    ASSERT_TRUE(is_supported);
+  }
+  check_same_as_obj_row();
+}
+
+TEST_F(TestSMDatumRow, unsupported)
+{
+  bool is_supported = true;
+  ObField field;
+  ObSMDatumCellEncoder encoder;
+  ObObj obj;
+
+  // need cast to field type
+  obj.set_int32(1);
+  field.type_.set_type(ObIntType);
+  EXPECT_EQ(OB_SUCCESS, ObSMDatumRow::resolve_encoder(obj.get_meta(), field, CHARSET_UTF8MB4,
+      encoder, is_supported));
+  EXPECT_FALSE(is_supported);
+
+  // zerofill depends on field length
+  field.type_.set_type(ObInt32Type);
+  field.flags_ = ZEROFILL_FLAG;
+  EXPECT_EQ(OB_SUCCESS, ObSMDatumRow::resolve_encoder(obj.get_meta(), field, CHARSET_UTF8MB4,
+      encoder, is_supported));
+  EXPECT_FALSE(is_supported);
+  field.flags_ = 0;
+  EXPECT_EQ(OB_SUCCESS, ObSMDatumRow::resolve_encoder(obj.get_meta(), field, CHARSET_UTF8MB4,
+      encoder, is_supported));
+  EXPECT_TRUE(is_supported);
+
+  // other types are encoded by ObSMRow
+  const ObObjType types[] = {ObFloatType, ObDoubleType, ObNumberType, ObDateTimeType, ObDateType,
+                             ObTimeType, ObYearType, ObBitType, ObTinyTextType, ObLongTextType};
+  for (int64_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    ObObjMeta meta;
+    meta.set_type(types[t]);
+    meta.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+    field.type_.set_type(types[t]);
+    EXPECT_EQ(OB_SUCCESS, ObSMDatumRow::resolve_encoder(meta, field, CHARSET_UTF8MB4,
+        encoder, is_supported));
+    EXPECT_FALSE(is_supported);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
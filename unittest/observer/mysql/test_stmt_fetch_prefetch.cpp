@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/alloc/ob_malloc_allocator.h"
+#include "sql/ob_spi.h"
+#include "observer/mysql/obmp_stmt_fetch.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+using namespace oceanbase::pl;
+using namespace oceanbase::observer;
+
+// rows of a streaming cursor, fetched into the current row of cursor one by one
+class MockCursorSource
+{
+public:
+  MockCursorSource(ObPLCursorInfo &cursor, const int64_t row_cnt, const int end_ret)
+    : cursor_(cursor), row_cnt_(row_cnt), end_ret_(end_ret), fetch_cnt_(0)
+  {
+    row_.cells_ = &cell_;
+    row_.count_ = 1;
+  }
+  // like dbms_cursor_fetch, the fetched row is counted in rowcount of cursor
+  int operator()()
+  {
+    int ret = OB_SUCCESS;
+    fetch_cnt_++;
+    if (fetch_cnt_ > row_cnt_) {
+      ret = end_ret_;
+    } else if (OB_FAIL(cursor_.set_rowcount(cursor_.get_rowcount() + 1))) {
+    } else {
+      cell_.set_int(fetch_cnt_);
+      cursor_.get_current_row() = row_;
+    }
+    return ret;
+  }
+  int64_t get_fetch_cnt() const { return fetch_cnt_; }
+private:
+  ObPLCursorInfo &cursor_;
+  int64_t row_cnt_;
+  int end_ret_;
+  int64_t fetch_cnt_;
+  ObObj cell_;
+  ObNewRow row_;
+};
+
+class TestStmtFetchPrefetch : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    lib::ObMallocAllocator *malloc_allocator = lib::ObMallocAllocator::get_instance();
+    ASSERT_EQ(OB_SUCCESS, malloc_allocator->create_tenant_ctx_allocator(OB_SYS_TENANT_ID));
+  }
+  virtual void SetUp()
+  {
+    cursor_.open();
+    cursor_.set_streaming();
+    ASSERT_EQ(OB_SUCCESS, buffer_.row_store_.init(0, OB_SYS_TENANT_ID,
+                                                  ObCtxIds::DEFAULT_CTX_ID, "PSCursorPrefetch"));
+  }
+  virtual void TearDown()
+  {
+    buffer_.row_store_.reset();
+  }
+  void check_next_row(const int64_t value)
+  {
+    const ObNewRow *row = NULL;
+    ASSERT_FALSE(buffer_.need_fetch_cursor());
+    ASSERT_EQ(OB_SUCCESS, buffer_.get_next_row(cursor_, row));
+    ASSERT_TRUE(NULL != row);
+    ASSERT_EQ(1, row->count_);
+    EXPECT_EQ(value, row->cells_[0].get_int());
+  }
+protected:
+  ObPLCursorInfo cursor_;
+  ObSPIPrefetchBuffer buffer_;
+};
+
+TEST_F(TestStmtFetchPrefetch, serve_prefetched_rows)
+{
+  MockCursorSource source(cursor_, 5, OB_ITER_END);
+  EXPECT_TRUE(buffer_.need_fetch_cursor());
+  ASSERT_EQ(OB_SUCCESS, buffer_.prefetch(cursor_, 3, source));
+  EXPECT_EQ(3, source.get_fetch_cnt());
+  EXPECT_EQ(3, buffer_.row_store_.get_row_cnt());
+  EXPECT_EQ(OB_SUCCESS, buffer_.end_ret_);
+
+  check_next_row(1);
+  check_next_row(2);
+  check_next_row(3);
+  // cursor is not at end, the next row is read from cursor
+  const ObNewRow *row = NULL;
+  EXPECT_TRUE(buffer_.need_fetch_cursor());
+  EXPECT_EQ(OB_ITER_END, buffer_.get_next_row(cursor_, row));
+  EXPECT_TRUE(NULL == row);
+
+  // next window starts from the following row of cursor
+  buffer_.reuse();
+  ASSERT_EQ(OB_SUCCESS, buffer_.prefetch(cursor_, 3, source));
+  EXPECT_EQ(2, buffer_.row_store_.get_row_cnt());
+  EXPECT_EQ(OB_ITER_END, buffer_.end_ret_);
+  check_next_row(4);
+  check_next_row(5);
+}
+
+TEST_F(TestStmtFetchPrefetch, carry_end_ret)
+{
+  MockCursorSource source(cursor_, 2, OB_ITER_END);
+  ASSERT_EQ(OB_SUCCESS, buffer_.prefetch(cursor_, 5, source));
+  EXPECT_EQ(3, source.get_fetch_cnt());
+  EXPECT_EQ(2, buffer_.row_store_.get_row_cnt());
+  EXPECT_EQ(OB_ITER_END, buffer_.end_ret_);
+
+  check_next_row(1);
+  check_next_row(2);
+  // end of cursor is returned by next fetch without reading cursor again
+  const ObNewRow *row = NULL;
+  EXPECT_FALSE(buffer_.need_fetch_cursor());
+  EXPECT_EQ(OB_ITER_END, buffer_.get_next_row(cursor_, row));
+  EXPECT_EQ(OB_ITER_END, buffer_.get_next_row(cursor_, row));
+  // no more prefetch after end of cursor
+  ASSERT_EQ(OB_SUCCESS, buffer_.prefetch(cursor_, 5, source));
+  EXPECT_EQ(3, source.get_fetch_cnt());
+}
+
+TEST_F(TestStmtFetchPrefetch, carry_error)
+{
+  MockCursorSource source(cursor_, 1, OB_TIMEOUT);
+  ASSERT_EQ(OB_SUCCESS, buffer_.prefetch(cursor_, 5, source));
+  EXPECT_EQ(1, buffer_.row_store_.get_row_cnt());
+  EXPECT_EQ(OB_TIMEOUT, buffer_.end_ret_);
+
+  // error is reported after the prefetched rows are sent
+  check_next_row(1);
+  const ObNewRow *row = NULL;
+  EXPECT_FALSE(buffer_.need_fetch_cursor());
+  EXPECT_EQ(OB_TIMEOUT, buffer_.get_next_row(cursor_, row));
+}
+
+TEST_F(TestStmtFetchPrefetch, rowcount)
+{
+  MockCursorSource source(cursor_, 5, OB_ITER_END);
+  ASSERT_EQ(OB_SUCCESS, cursor_.set_rowcount(10));
+  ASSERT_EQ(OB_SUCCESS, buffer_.prefetch(cursor_, 3, source));
+  // rows are counted when they are sent
+  EXPECT_EQ(10, cursor_.get_rowcount());
+  check_next_row(1);
+  EXPECT_EQ(11, cursor_.get_rowcount());
+  check_next_row(2);
+  check_next_row(3);
+  EXPECT_EQ(13, cursor_.get_rowcount());
+}
+
+TEST_F(TestStmtFetchPrefetch, streaming_offset_type)
+{
+  EXPECT_TRUE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_DEFAULT));
+  EXPECT_TRUE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_NEXT));
+  EXPECT_FALSE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_CURRENT));
+  EXPECT_FALSE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_FIRST));
+  EXPECT_FALSE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_LAST));
+  EXPECT_FALSE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_PRIOR));
+  EXPECT_FALSE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_ABSOLUTE));
+  EXPECT_FALSE(ObMPStmtFetch::is_streaming_offset_type(ObMPStmtFetch::OB_OCI_FETCH_RELATIVE));
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
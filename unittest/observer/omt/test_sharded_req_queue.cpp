@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "lib/queue/ob_priority_queue.h"
+#include "lib/time/ob_time_utility.h"
+
+using namespace oceanbase::common;
+
+// same priorities as the request queue of tenant
+typedef ObPriorityQueue2<1, 2, 3> SharedQueue;
+typedef ObShardedPriorityQueue2<1, 2, 3> ShardedQueue;
+
+struct QData : public ObLink
+{
+  QData() : prio_(0) {}
+  int prio_;
+};
+
+TEST(TestShardedReqQueue, priority_and_steal)
+{
+  ShardedQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init(4, ObMemAttr(OB_SERVER_TENANT_ID, "TestReqQueue")));
+  ASSERT_EQ(OB_INIT_TWICE, queue.init(4, ObMemAttr(OB_SERVER_TENANT_ID, "TestReqQueue")));
+  QData low, high, high_high;
+  low.prio_ = 5;
+  high.prio_ = 1;
+  high_high.prio_ = 0;
+  ASSERT_EQ(OB_SUCCESS, queue.push(&low, low.prio_, 0));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&high, high.prio_, 1));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&high_high, high_high.prio_, 2));
+  ASSERT_EQ(3, queue.size());
+  ASSERT_EQ(1, queue.queue_size(5));
+
+  // higher priority tasks in sibling shards are preferred to the home shard
+  ObLink *task = NULL;
+  ASSERT_EQ(OB_SUCCESS, queue.pop(task, 0, 0));
+  ASSERT_EQ(&high_high, task);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop_high_high(task, 0, 3));
+  ASSERT_EQ(OB_SUCCESS, queue.pop_high(task, 0, 3));
+  ASSERT_EQ(&high, task);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop_high(task, 0, 3));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(task, 0, 3));
+  ASSERT_EQ(&low, task);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop(task, 0, 3));
+  ASSERT_EQ(0, queue.size());
+}
+
+TEST(TestShardedReqQueue, limit)
+{
+  ShardedQueue queue;
+  queue.set_limit(3);
+  ASSERT_EQ(OB_SUCCESS, queue.init(2, ObMemAttr(OB_SERVER_TENANT_ID, "TestReqQueue")));
+  QData datas[8];
+  int64_t succ_cnt = 0;
+  for (int64_t i = 0; i < 8; i++) {
+    // always push to shard 0, the full shard overflows to its sibling
+    if (OB_SUCCESS == queue.push(&datas[i], 2, 0)) {
+      succ_cnt++;
+    }
+  }
+  // the limit is split among shards, no more than 3 tasks in total
+  ASSERT_EQ(3, succ_cnt);
+  ASSERT_EQ(3, queue.size());
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&datas[0], 2, 1));
+  ObLink *task = NULL;
+  for (int64_t i = 0; i < succ_cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.pop(task, 0, 1));
+  }
+  ASSERT_EQ(0, queue.size());
+}
+
+int pop_req(SharedQueue &queue, ObLink *&task, int64_t timeout, int64_t home)
+{
+  UNUSED(home);
+  return queue.pop(task, timeout);
+}
+
+int pop_req(ShardedQueue &queue, ObLink *&task, int64_t timeout, int64_t home)
+{
+  return queue.pop(task, timeout, home);
+}
+
+template <typename Queue>
+int64_t bench(Queue &queue, const int64_t n_pusher, const int64_t n_worker, const int64_t n_task)
+{
+  std::vector<std::thread> threads;
+  QData *datas = new QData[n_task];
+  int64_t pop_cnt = 0;
+  const int64_t start = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < n_worker; i++) {
+    threads.emplace_back([&queue, &pop_cnt, n_task, i]() {
+      ObLink *task = NULL;
+      while (ATOMIC_LOAD(&pop_cnt) < n_task) {
+        if (OB_SUCCESS == pop_req(queue, task, 1000, i)) {
+          ATOMIC_INC(&pop_cnt);
+        }
+      }
+    });
+  }
+  for (int64_t i = 0; i < n_pusher; i++) {
+    threads.emplace_back([&queue, datas, n_pusher, n_task, i]() {
+      for (int64_t j = i; j < n_task; j += n_pusher) {
+        // mix of priorities the network threads push at
+        datas[j].prio_ = 1 + static_cast<int>(j % 5);
+        while (OB_SUCCESS != queue.push(&datas[j], datas[j].prio_)) {
+          sched_yield();
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  const int64_t cost = ObTimeUtility::current_time() - start;
+  delete [] datas;
+  return cost;
+}
+
+TEST(TestShardedReqQueue, bench)
+{
+  const int64_t n_cpu = std::max(4L, static_cast<int64_t>(sysconf(_SC_NPROCESSORS_ONLN)));
+  const int64_t n_pusher = std::max(2L, n_cpu / 8);
+  const int64_t n_worker = n_cpu;
+  const int64_t n_task = 2000000;
+  const int64_t max_shard_cnt = ShardedQueue::MAX_SHARD_CNT;
+  const int64_t shard_cnt = std::min(max_shard_cnt, std::max(2L, n_cpu / 4));
+
+  SharedQueue shared_queue;
+  shared_queue.set_limit(65536);
+  const int64_t shared_cost = bench(shared_queue, n_pusher, n_worker, n_task);
+
+  ShardedQueue sharded_queue;
+  sharded_queue.set_limit(65536);
+  ASSERT_EQ(OB_SUCCESS, sharded_queue.init(shard_cnt, ObMemAttr(OB_SERVER_TENANT_ID, "TestReqQueue")));
+  const int64_t sharded_cost = bench(sharded_queue, n_pusher, n_worker, n_task);
+  ASSERT_EQ(0, sharded_queue.size());
+
+  fprintf(stdout, "pusher=%ld worker=%ld task=%ld shared=%ldus(%.0f/s) sharded(%ld)=%ldus(%.0f/s)\n",
+          n_pusher, n_worker, n_task,
+          shared_cost, n_task * 1000000.0 / shared_cost,
+          shard_cnt, sharded_cost, n_task * 1000000.0 / sharded_cost);
+}
+
+int main(int argc, char *argv[])
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
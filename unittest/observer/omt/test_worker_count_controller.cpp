@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "observer/omt/ob_worker_count_controller.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::omt;
+
+static const int64_t INTERVAL = 100 * 1000;
+static const int64_t TARGET = 1000;
+
+static ObWorkerCountSample make_sample(int64_t req_cnt, int64_t avg_queue_us,
+                                       double busy_workers, double cpu_usage,
+                                       int64_t queue_len)
+{
+  ObWorkerCountSample sample;
+  sample.interval_us_ = INTERVAL;
+  sample.req_cnt_ = req_cnt;
+  sample.queue_us_ = req_cnt * avg_queue_us;
+  sample.process_us_ = static_cast<int64_t>(busy_workers * INTERVAL);
+  sample.cpu_us_ = cpu_usage < 0 ? -1 : static_cast<int64_t>(cpu_usage * INTERVAL);
+  sample.queue_len_ = queue_len;
+  return sample;
+}
+
+TEST(TestWorkerCountController, grow_on_queueing)
+{
+  ObWorkerCountController ctrl;
+  ObWorkerCountDecision decision;
+  // 4 busy workers, 50 requests waiting 5ms in average while cpu is available
+  ObWorkerCountSample sample = make_sample(100, 5000, 4, 4, 50);
+  ASSERT_EQ(8, ctrl.adjust(sample, 4, 2, 20, 8, TARGET));
+  ASSERT_EQ(1, ctrl.get_decisions(&decision, 1));
+  ASSERT_EQ(ObWorkerCountDecision::GROW_QUEUE, decision.reason_);
+  ASSERT_EQ(4, decision.old_cnt_);
+  ASSERT_EQ(8, decision.new_cnt_);
+  ASSERT_EQ(5000, decision.avg_queue_us_);
+  ASSERT_EQ(1000, decision.throughput_);
+  // no more than max
+  ASSERT_EQ(20, ctrl.adjust(sample, 16, 2, 20, 8, TARGET));
+  // nothing popped while requests waiting
+  sample = make_sample(0, 0, 0, 0, 10);
+  ASSERT_EQ(8, ctrl.adjust(sample, 4, 2, 20, 8, TARGET));
+  // unknown cpu usage never saturates
+  sample = make_sample(100, 5000, 4, -1, 0);
+  ASSERT_EQ(5, ctrl.adjust(sample, 4, 2, 20, 8, TARGET));
+}
+
+TEST(TestWorkerCountController, shrink_on_cpu_saturated)
+{
+  ObWorkerCountController ctrl;
+  ObWorkerCountDecision decision;
+  ObWorkerCountSample sample = make_sample(100, 5000, 7.5, 7.5, 50);
+  ASSERT_EQ(7, ctrl.adjust(sample, 8, 2, 20, 8, TARGET));
+  ASSERT_EQ(1, ctrl.get_decisions(&decision, 1));
+  ASSERT_EQ(ObWorkerCountDecision::SHRINK_CPU, decision.reason_);
+  // never below min
+  ASSERT_EQ(2, ctrl.adjust(sample, 2, 2, 20, 8, TARGET));
+  ASSERT_EQ(1, ctrl.get_decisions(&decision, 1));
+}
+
+TEST(TestWorkerCountController, shrink_after_idle)
+{
+  ObWorkerCountController ctrl;
+  ObWorkerCountDecision decision;
+  ObWorkerCountSample idle = make_sample(100, 0, 1, 1, 0);
+  for (int64_t i = 1; i < ObWorkerCountController::SHRINK_IDLE_ROUNDS; i++) {
+    ASSERT_EQ(12, ctrl.adjust(idle, 12, 2, 20, 8, TARGET));
+  }
+  // a busy round restarts counting
+  ObWorkerCountSample busy = make_sample(100, 600, 1, 1, 0);
+  ASSERT_EQ(12, ctrl.adjust(busy, 12, 2, 20, 8, TARGET));
+  for (int64_t i = 1; i < ObWorkerCountController::SHRINK_IDLE_ROUNDS; i++) {
+    ASSERT_EQ(12, ctrl.adjust(idle, 12, 2, 20, 8, TARGET));
+  }
+  ASSERT_EQ(0, ctrl.get_decisions(&decision, 1));
+  ASSERT_EQ(10, ctrl.adjust(idle, 12, 2, 20, 8, TARGET));
+  ASSERT_EQ(1, ctrl.get_decisions(&decision, 1));
+  ASSERT_EQ(ObWorkerCountDecision::SHRINK_IDLE, decision.reason_);
+  // keep headroom over busy workers
+  ObWorkerCountSample half = make_sample(100, 0, 2, 2, 0);
+  for (int64_t i = 1; i < ObWorkerCountController::SHRINK_IDLE_ROUNDS; i++) {
+    ASSERT_EQ(4, ctrl.adjust(half, 4, 2, 20, 8, TARGET));
+  }
+  ASSERT_EQ(3, ctrl.adjust(half, 4, 2, 20, 8, TARGET));
+}
+
+TEST(TestWorkerCountController, clamp_and_history)
+{
+  ObWorkerCountController ctrl;
+  ObWorkerCountDecision decisions[ObWorkerCountController::HISTORY_SIZE];
+  ObWorkerCountSample hold = make_sample(100, 600, 8, 8, 0);
+  ASSERT_EQ(8, ctrl.adjust(hold, 8, 2, 20, 16, TARGET));
+  ASSERT_EQ(0, ctrl.get_decisions(decisions, ObWorkerCountController::HISTORY_SIZE));
+  ASSERT_EQ(20, ctrl.adjust(hold, 30, 2, 20, 16, TARGET));
+  ASSERT_EQ(4, ctrl.adjust(hold, 1, 4, 20, 16, TARGET));
+  ASSERT_EQ(2, ctrl.get_decisions(decisions, ObWorkerCountController::HISTORY_SIZE));
+  ASSERT_EQ(ObWorkerCountDecision::CLAMP, decisions[0].reason_);
+  ASSERT_EQ(4, decisions[0].new_cnt_);
+  ASSERT_EQ(20, decisions[1].new_cnt_);
+  ASSERT_STREQ("CLAMP", ObWorkerCountDecision::get_reason_str(decisions[0].reason_));
+
+  for (int64_t i = 0; i < ObWorkerCountController::HISTORY_SIZE * 2; i++) {
+    ctrl.adjust(hold, 100 + i, 2, 20, 16, TARGET);
+  }
+  ASSERT_EQ(ObWorkerCountController::HISTORY_SIZE,
+            ctrl.get_decisions(decisions, ObWorkerCountController::HISTORY_SIZE));
+  ASSERT_EQ(100 + ObWorkerCountController::HISTORY_SIZE * 2 - 1, decisions[0].old_cnt_);
+  ctrl.reset();
+  ASSERT_EQ(0, ctrl.get_decisions(decisions, ObWorkerCountController::HISTORY_SIZE));
+}
+
+int main(int argc, char *argv[])
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,7 +18,10 @@
 #include "storage/memtable/ob_memtable.h"
 #include "storage/memtable/mvcc/ob_mvcc_trans_ctx.h"
 #include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/mvcc/ob_tx_callback_worker.h"
 #include "lib/random/ob_random.h"
+#include <thread>
+#include <vector>
 
 namespace oceanbase
 {
@@ -1028,6 +1031,340 @@ TEST_F(TestTxCallbackList, checksum_all_and_tx_end_test) {
 
 }
 
+class ObMockTxEndCallback : public ObITransCallback
+{
+public:
+  ObMockTxEndCallback(const bool is_table_lock, const int end_ret)
+    : ObITransCallback(false, false),
+      is_table_lock_(is_table_lock), end_ret_(end_ret), end_cnt_(0) {}
+  virtual bool is_table_lock_callback() const override { return is_table_lock_; }
+  virtual bool is_need_free() const override { return false; }
+  virtual int trans_commit() override { end_cnt_++; return end_ret_; }
+  virtual int trans_abort() override { end_cnt_++; return end_ret_; }
+
+  bool is_table_lock_;
+  int end_ret_;
+  int64_t end_cnt_;
+};
+
+class TestTxCallbackSplit : public TestTxCallbackList
+{
+public:
+  static const int64_t ROW_CNT = 7;
+  static const int64_t MAX_LIST_CNT = 8;
+  virtual void SetUp() override
+  {
+    TestTxCallbackList::SetUp();
+    lists_ = reinterpret_cast<ObTxCallbackList *>(lists_buf_);
+    for (int64_t i = 0; i < MAX_LIST_CNT; ++i) {
+      new(lists_ + i) ObTxCallbackList(mgr_);
+    }
+  }
+  virtual void TearDown() override
+  {
+    for (int64_t i = 0; i < MAX_LIST_CNT; ++i) {
+      lists_[i].~ObTxCallbackList();
+    }
+    for (int64_t i = 0; i < (int64_t)cbs_.size(); ++i) {
+      delete cbs_[i];
+    }
+    cbs_.clear();
+    TestTxCallbackList::TearDown();
+  }
+  ObITransCallback *append_row_callback(ObTxCallbackList &list, const int64_t row_idx)
+  {
+    ObMvccRowCallback *cb = new ObMvccRowCallback(mt_ctx_, rows_[row_idx], NULL);
+    cb->need_fill_redo_ = false;
+    cb->need_submit_log_ = false;
+    cbs_.push_back(cb);
+    EXPECT_EQ(OB_SUCCESS, list.append_callback(cb));
+    return cb;
+  }
+  ObMockTxEndCallback *append_mock_callback(ObTxCallbackList &list,
+                                            const bool is_table_lock,
+                                            const int end_ret = OB_SUCCESS)
+  {
+    ObMockTxEndCallback *cb = new ObMockTxEndCallback(is_table_lock, end_ret);
+    cbs_.push_back(cb);
+    EXPECT_EQ(OB_SUCCESS, list.append_callback(cb));
+    return cb;
+  }
+  int64_t index_of(const ObITransCallback *cb) const
+  {
+    int64_t idx = -1;
+    for (int64_t i = 0; idx < 0 && i < (int64_t)cbs_.size(); ++i) {
+      if (cbs_[i] == cb) {
+        idx = i;
+      }
+    }
+    return idx;
+  }
+  // every row lives in exactly one list and callbacks keep the append order
+  void check_split(const int64_t list_cnt, const int64_t total_cnt)
+  {
+    int64_t cnt = 0;
+    int64_t row_list[ROW_CNT];
+    for (int64_t i = 0; i < ROW_CNT; ++i) {
+      row_list[i] = -1;
+    }
+    for (int64_t i = 0; i < list_cnt; ++i) {
+      int64_t last_idx = -1;
+      int64_t list_len = 0;
+      ObITransCallback *head = lists_[i].get_guard();
+      for (ObITransCallback *it = head->get_next(); it != head; it = it->get_next()) {
+        const int64_t idx = index_of(it);
+        EXPECT_LT(last_idx, idx);
+        last_idx = idx;
+        list_len++;
+        if (it->is_table_lock_callback()) {
+          EXPECT_EQ(0, i);
+        } else {
+          const int64_t row_idx = &static_cast<ObMvccRowCallback *>(it)->get_mvcc_row() - rows_;
+          EXPECT_TRUE(-1 == row_list[row_idx] || i == row_list[row_idx]);
+          row_list[row_idx] = i;
+        }
+      }
+      EXPECT_EQ(list_len, lists_[i].get_length());
+      cnt += list_len;
+    }
+    EXPECT_EQ(total_cnt, cnt);
+  }
+
+  ObMvccRow rows_[ROW_CNT];
+  char lists_buf_[sizeof(ObTxCallbackList) * MAX_LIST_CNT];
+  ObTxCallbackList *lists_;
+  std::vector<ObITransCallback *> cbs_;
+};
+
+TEST_F(TestTxCallbackSplit, split_callbacks_boundary)
+{
+  // invalid arguments and empty list split nothing
+  EXPECT_EQ(0, callback_list_.split_callbacks(lists_, 4));
+  append_row_callback(callback_list_, 0);
+  EXPECT_EQ(0, callback_list_.split_callbacks(NULL, 4));
+  EXPECT_EQ(0, callback_list_.split_callbacks(lists_, 0));
+  EXPECT_EQ(1, callback_list_.get_length());
+
+  // one list keeps everything in order
+  append_mock_callback(callback_list_, true /*is_table_lock*/);
+  append_row_callback(callback_list_, 1);
+  EXPECT_EQ(3, callback_list_.split_callbacks(lists_, 1));
+  EXPECT_TRUE(callback_list_.empty());
+  EXPECT_EQ(0, callback_list_.get_length());
+  check_split(1, 3);
+}
+
+TEST_F(TestTxCallbackSplit, split_callbacks_by_row)
+{
+  const int64_t total_cnt = 100;
+  for (int64_t i = 0; i < total_cnt; ++i) {
+    if (0 == i % 10) {
+      append_mock_callback(callback_list_, true /*is_table_lock*/);
+    } else {
+      append_row_callback(callback_list_, i % ROW_CNT);
+    }
+  }
+  EXPECT_EQ(total_cnt, callback_list_.split_callbacks(lists_, MAX_LIST_CNT));
+  EXPECT_TRUE(callback_list_.empty());
+  check_split(MAX_LIST_CNT, total_cnt);
+
+  // split lists can be concatenated back
+  for (int64_t i = 0; i < MAX_LIST_CNT; ++i) {
+    callback_list_.concat_callbacks(lists_[i]);
+    EXPECT_TRUE(lists_[i].empty());
+  }
+  EXPECT_EQ(total_cnt, callback_list_.get_length());
+}
+
+TEST_F(TestTxCallbackSplit, parallel_tx_end_with_failed_list)
+{
+  const int64_t list_cnt = 4;
+  bool is_done = false;
+  ASSERT_EQ(OB_SUCCESS, cb_allocator_.init(OB_SERVER_TENANT_ID));
+  ObTxCallbackList &main_list = mgr_.callback_list_;
+  for (int64_t i = 0; i < 20; ++i) {
+    append_row_callback(main_list, i % ROW_CNT);
+  }
+  // table lock callbacks all go to the first list, and the list stops at the
+  // failed one just as the serial tx end does
+  ObMockTxEndCallback *ok_cb = append_mock_callback(main_list, true);
+  ObMockTxEndCallback *failed_cb = append_mock_callback(main_list, true, OB_ERR_UNEXPECTED);
+  ObMockTxEndCallback *left_cb = append_mock_callback(main_list, true);
+  EXPECT_EQ(OB_ERR_UNEXPECTED, mgr_.parallel_tx_end_(true, NULL, list_cnt, is_done));
+  EXPECT_TRUE(is_done);
+  EXPECT_EQ(1, ok_cb->end_cnt_);
+  EXPECT_EQ(1, failed_cb->end_cnt_);
+  EXPECT_EQ(0, left_cb->end_cnt_);
+  // callbacks of other lists are all ended and removed
+  EXPECT_EQ(2, main_list.get_length());
+  EXPECT_EQ(failed_cb, main_list.get_guard()->get_next());
+  EXPECT_EQ(left_cb, main_list.get_guard()->get_prev());
+  EXPECT_EQ(21, mgr_.get_callback_remove_for_trans_end_count());
+
+  // retry after the failure is fixed
+  failed_cb->end_ret_ = OB_SUCCESS;
+  EXPECT_EQ(OB_SUCCESS, mgr_.parallel_tx_end_(true, NULL, list_cnt, is_done));
+  EXPECT_TRUE(is_done);
+  EXPECT_TRUE(main_list.empty());
+  EXPECT_EQ(0, cb_allocator_.alloc_count_ - cb_allocator_.free_count_);
+}
+
+TEST_F(TestTxCallbackSplit, task_group_wait_concurrent_lists)
+{
+  const int64_t list_cnt = 6;
+  const int64_t failed_list = 3;
+  ObTxCallbackListTaskGroup group;
+  ObTxCallbackListTask tasks[list_cnt];
+  EXPECT_EQ(OB_INVALID_ARGUMENT, group.init(0));
+  ASSERT_EQ(OB_SUCCESS, group.init(list_cnt));
+  for (int64_t i = 0; i < list_cnt; ++i) {
+    for (int64_t j = 0; j < 100; ++j) {
+      append_mock_callback(lists_[i], false,
+                           (failed_list == i && 50 == j) ? OB_ERR_UNEXPECTED : OB_SUCCESS);
+    }
+    tasks[i].init(lists_ + i, false /*is_commit*/, &group);
+  }
+  std::vector<std::thread> threads;
+  for (int64_t i = 1; i < list_cnt; ++i) {
+    threads.push_back(std::thread([&tasks, i]() {
+      ::usleep(1000 * i);
+      tasks[i].run();
+    }));
+  }
+  tasks[0].run();
+  group.wait();
+  EXPECT_EQ(list_cnt, group.get_finished_cnt());
+  for (int64_t i = 0; i < list_cnt; ++i) {
+    if (failed_list == i) {
+      EXPECT_EQ(OB_ERR_UNEXPECTED, tasks[i].get_ret_code());
+      EXPECT_EQ(50, lists_[i].get_length());
+    } else {
+      EXPECT_EQ(OB_SUCCESS, tasks[i].get_ret_code());
+      EXPECT_TRUE(lists_[i].empty());
+    }
+  }
+  for (int64_t i = 0; i < (int64_t)threads.size(); ++i) {
+    threads[i].join();
+  }
+}
+
+TEST_F(TestTxCallbackSplit, concat_first_callbacks)
+{
+  const int64_t cb_cnt = 5;
+  ObITransCallback *cbs[cb_cnt];
+  for (int64_t i = 0; i < cb_cnt; ++i) {
+    cbs[i] = append_mock_callback(lists_[0], false /*is_table_lock*/);
+  }
+  EXPECT_EQ(0, callback_list_.concat_callbacks(lists_[0], 0));
+  EXPECT_EQ(2, callback_list_.concat_callbacks(lists_[0], 2));
+  EXPECT_EQ(2, callback_list_.get_length());
+  EXPECT_EQ(3, lists_[0].get_length());
+  EXPECT_EQ(cbs[0], callback_list_.get_guard()->get_next());
+  EXPECT_EQ(cbs[1], callback_list_.get_tail());
+  EXPECT_EQ(cbs[2], lists_[0].get_guard()->get_next());
+  EXPECT_EQ(lists_[0].get_guard(), cbs[2]->get_prev());
+
+  // more than the list has
+  EXPECT_EQ(3, callback_list_.concat_callbacks(lists_[0], 10));
+  EXPECT_TRUE(lists_[0].empty());
+  EXPECT_EQ(0, callback_list_.concat_callbacks(lists_[0], 1));
+  int64_t idx = 0;
+  ObITransCallback *head = callback_list_.get_guard();
+  for (ObITransCallback *it = head->get_next(); it != head; it = it->get_next()) {
+    EXPECT_EQ(cbs[idx++], it);
+  }
+  EXPECT_EQ(cb_cnt, idx);
+  EXPECT_EQ(cb_cnt, callback_list_.get_length());
+}
+
+TEST_F(TestTxCallbackSplit, replay_shard_callbacks_in_leader_order)
+{
+  const int64_t shard_cnt = 3;
+  const int64_t row_cnt = 30;
+  int64_t row_shards[row_cnt];
+  ObITransCallback *row_cbs[row_cnt];
+  ObTxCallbackList &main_list = mgr_.callback_list_;
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    row_shards[i] = (i * 7) % shard_cnt;
+    row_cbs[i] = new ObMockTxEndCallback(false /*is_table_lock*/, OB_SUCCESS);
+    cbs_.push_back(row_cbs[i]);
+  }
+  // the shards replay their rows concurrently
+  std::vector<std::thread> threads;
+  for (int64_t s = 0; s < shard_cnt; ++s) {
+    threads.push_back(std::thread([&, s]() {
+      ObTransCallbackMgr::ReplayShardGuard guard(mgr_, lists_[s]);
+      for (int64_t i = 0; i < row_cnt; ++i) {
+        if (s == row_shards[i]) {
+          EXPECT_EQ(OB_SUCCESS, mgr_.append(row_cbs[i]));
+        }
+      }
+    }));
+  }
+  for (int64_t i = 0; i < (int64_t)threads.size(); ++i) {
+    threads[i].join();
+  }
+  EXPECT_TRUE(main_list.empty());
+  for (int64_t s = 0; s < shard_cnt; ++s) {
+    EXPECT_EQ(row_cnt / shard_cnt, lists_[s].get_length());
+  }
+
+  // append the callbacks in the order of the rows
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    EXPECT_EQ(1, mgr_.append_replay_shard_callbacks(lists_[row_shards[i]], 1));
+  }
+  int64_t idx = 0;
+  ObITransCallback *head = main_list.get_guard();
+  for (ObITransCallback *it = head->get_next(); it != head; it = it->get_next()) {
+    EXPECT_EQ(row_cbs[idx++], it);
+  }
+  EXPECT_EQ(row_cnt, idx);
+  EXPECT_EQ(row_cnt, main_list.get_length());
+  EXPECT_EQ(row_cnt, mgr_.get_callback_main_list_append_count());
+  for (int64_t s = 0; s < shard_cnt; ++s) {
+    EXPECT_TRUE(lists_[s].empty());
+  }
+}
+
+TEST_F(TestTxCallbackSplit, replay_shard_guard)
+{
+  ObMemtable *mt = create_memtable();
+  ObTxCallbackList &main_list = mgr_.callback_list_;
+  ObTransCallbackMgr other_mgr(mt_ctx_, cb_allocator_);
+  EXPECT_EQ(OB_SUCCESS, main_list.append_callback(create_callback(mt, false, false, 1)));
+  {
+    ObTransCallbackMgr::ReplayShardGuard guard(mgr_, lists_[0]);
+    EXPECT_EQ(OB_SUCCESS, mgr_.append(create_callback(mt, false, false, 2)));
+    EXPECT_EQ(OB_SUCCESS, mgr_.append(create_callback(mt, false, false, 2)));
+    {
+      // the guard of other txn does not take effect
+      ObTransCallbackMgr::ReplayShardGuard other_guard(other_mgr, lists_[2]);
+      EXPECT_EQ(OB_SUCCESS, mgr_.append(create_callback(mt, false, false, 2)));
+      // the innermost guard takes effect
+      ObTransCallbackMgr::ReplayShardGuard inner_guard(mgr_, lists_[1]);
+      EXPECT_EQ(OB_SUCCESS, mgr_.append(create_callback(mt, false, false, 2)));
+    }
+    EXPECT_EQ(1, main_list.get_length());
+    EXPECT_EQ(3, lists_[0].get_length());
+    EXPECT_EQ(1, lists_[1].get_length());
+    EXPECT_TRUE(lists_[2].empty());
+    // only the callbacks of the shard are rolled back
+    EXPECT_EQ(OB_SUCCESS, mgr_.replay_fail(2));
+    EXPECT_TRUE(lists_[0].empty());
+    EXPECT_EQ(3, rollback_cnt_);
+  }
+  EXPECT_EQ(1, lists_[1].get_length());
+
+  // out of the guard, the callbacks go to the main list
+  EXPECT_EQ(OB_SUCCESS, mgr_.append(create_callback(mt, false, false, 2)));
+  EXPECT_EQ(2, main_list.get_length());
+  EXPECT_EQ(1, mgr_.append_replay_shard_callbacks(lists_[1], INT64_MAX));
+  EXPECT_TRUE(lists_[1].empty());
+  EXPECT_EQ(OB_SUCCESS, mgr_.replay_fail(2));
+  EXPECT_EQ(1, main_list.get_length());
+  EXPECT_EQ(5, rollback_cnt_);
+}
+
 } // namespace unittest
 
 namespace memtable
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "storage/memtable/ob_lock_wait_mgr.h"
+#include "share/config/ob_server_config.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace common;
+using namespace memtable;
+
+class TestLockWaitMgr : public ::testing::Test
+{
+public:
+  virtual void SetUp() override
+  {
+    mgr_ = new ObLockWaitMgr();
+    ObLockWaitMgr::get_thread_node() = NULL;
+    ObLockWaitMgr::get_thread_hold_key() = 0;
+    GCONF._enable_lock_wait_direct_handoff.set_value("True");
+  }
+  virtual void TearDown() override
+  {
+    ObLockWaitMgr::get_thread_node() = NULL;
+    ObLockWaitMgr::get_thread_hold_key() = 0;
+    delete mgr_;
+    mgr_ = NULL;
+  }
+  // the hash of a row has neither trans flag nor table lock flag
+  static uint64_t row_hash(const uint64_t seed, const int64_t slot)
+  {
+    return (((seed * ObLockWaitMgr::ROW_STAT_SLOT_COUNT + slot) << 1) | 1) & ~(3UL << 62);
+  }
+  void set_node(ObLockWaitMgr::Node &node, const uint64_t hash, const char *key)
+  {
+    node.set(NULL, hash, 0, INT64_MAX, 1001 /*tablet_id*/, 0, 0, key, 1, 2);
+  }
+  ObLockWaitMgr::RowStatSlot &slot_of(const uint64_t hash)
+  {
+    return mgr_->get_row_stat_slot(hash);
+  }
+
+  ObLockWaitMgr *mgr_;
+};
+
+TEST_F(TestLockWaitMgr, handoff_row_lock)
+{
+  const uint64_t hash = row_hash(1, 3);
+  ObLockWaitMgr::Node node;
+  set_node(node, hash, "row1");
+  mgr_->record_row_wait_(node);
+
+  // the request is waked up from the row and locks it again
+  ObLockWaitMgr::get_thread_node() = &node;
+  ObLockWaitMgr::get_thread_hold_key() = hash;
+  mgr_->handoff_row_lock_(hash);
+  EXPECT_EQ(0, ObLockWaitMgr::get_thread_hold_key());
+  EXPECT_EQ(1, slot_of(hash).stat_.handoff_cnt_);
+
+  // nothing to hand off once the hold key is cleared
+  mgr_->handoff_row_lock_(hash);
+  EXPECT_EQ(1, slot_of(hash).stat_.handoff_cnt_);
+}
+
+TEST_F(TestLockWaitMgr, no_handoff)
+{
+  const uint64_t hash = row_hash(1, 3);
+  const uint64_t other_hash = row_hash(2, 4);
+  ObLockWaitMgr::Node node;
+  set_node(node, hash, "row1");
+  mgr_->record_row_wait_(node);
+
+  // another row is locked by the request
+  ObLockWaitMgr::get_thread_node() = &node;
+  ObLockWaitMgr::get_thread_hold_key() = hash;
+  mgr_->handoff_row_lock_(other_hash);
+  EXPECT_EQ(hash, ObLockWaitMgr::get_thread_hold_key());
+
+  // the request is not waked up from lock wait mgr
+  ObLockWaitMgr::get_thread_node() = NULL;
+  mgr_->handoff_row_lock_(hash);
+  EXPECT_EQ(hash, ObLockWaitMgr::get_thread_hold_key());
+
+  // turned off
+  ObLockWaitMgr::get_thread_node() = &node;
+  GCONF._enable_lock_wait_direct_handoff.set_value("False");
+  mgr_->handoff_row_lock_(hash);
+  EXPECT_EQ(hash, ObLockWaitMgr::get_thread_hold_key());
+  EXPECT_EQ(0, slot_of(hash).stat_.handoff_cnt_);
+
+  GCONF._enable_lock_wait_direct_handoff.set_value("True");
+  mgr_->handoff_row_lock_(hash);
+  EXPECT_EQ(0, ObLockWaitMgr::get_thread_hold_key());
+}
+
+TEST_F(TestLockWaitMgr, row_stat)
+{
+  const uint64_t hash = row_hash(1, 5);
+  const uint64_t evict_hash = row_hash(2, 5);
+  ObLockWaitMgr::Node node;
+  // the longest key of the node is kept without truncation
+  char long_key[sizeof(node.key_)];
+  memset(long_key, 'k', sizeof(long_key) - 1);
+  long_key[sizeof(long_key) - 1] = '\0';
+  set_node(node, hash, long_key);
+  mgr_->record_row_wait_(node);
+  mgr_->record_row_wait_(node);
+  mgr_->record_row_wakeup_(hash, 100);
+  mgr_->record_row_wakeup_(hash, 300);
+  mgr_->record_row_handoff_(hash);
+  // other rows are not counted into the slot
+  mgr_->record_row_wakeup_(evict_hash, 1000);
+  mgr_->record_row_handoff_(evict_hash);
+
+  int64_t slot_idx = 0;
+  ObRowContentionStat stat;
+  ASSERT_EQ(OB_SUCCESS, mgr_->get_next_row_stat(slot_idx, stat));
+  EXPECT_EQ(hash, stat.hash_);
+  EXPECT_EQ(1001, stat.tablet_id_);
+  EXPECT_STREQ(long_key, stat.key_);
+  EXPECT_EQ(2, stat.wait_cnt_);
+  EXPECT_EQ(2, stat.wakeup_cnt_);
+  EXPECT_EQ(1, stat.handoff_cnt_);
+  EXPECT_EQ(400, stat.total_wait_time_);
+  EXPECT_EQ(300, stat.max_wait_time_);
+  EXPECT_EQ(OB_ITER_END, mgr_->get_next_row_stat(slot_idx, stat));
+
+  // a row waited on evicts the former one in the same slot
+  ObLockWaitMgr::Node evict_node;
+  set_node(evict_node, evict_hash, "row2");
+  mgr_->record_row_wait_(evict_node);
+  slot_idx = 0;
+  ASSERT_EQ(OB_SUCCESS, mgr_->get_next_row_stat(slot_idx, stat));
+  EXPECT_EQ(evict_hash, stat.hash_);
+  EXPECT_STREQ("row2", stat.key_);
+  EXPECT_EQ(1, stat.wait_cnt_);
+  EXPECT_EQ(0, stat.wakeup_cnt_);
+  EXPECT_EQ(OB_ITER_END, mgr_->get_next_row_stat(slot_idx, stat));
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_lock_wait_mgr.log*");
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_lock_wait_mgr.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/ob_memtable_data.h"
+#include "lib/allocator/page_arena.h"
+
+#include <gtest/gtest.h>
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+static const int64_t ROW_LEN = 16 * 1024;
+
+static void fill_row(char *row, const int64_t len)
+{
+  // a document-like row image which compresses well
+  const char *doc = "{\"name\": \"oceanbase\", \"tags\": [\"db\", \"htap\"]}";
+  const int64_t doc_len = strlen(doc);
+  for (int64_t i = 0; i < len; i++) {
+    row[i] = doc[i % doc_len];
+  }
+}
+
+static ObMemtableDataHeader *dup_header(ObArenaAllocator &allocator, const ObMemtableData &data)
+{
+  ObMemtableDataHeader *header = (ObMemtableDataHeader *)allocator.alloc(data.dup_size());
+  EXPECT_TRUE(NULL != header);
+  EXPECT_EQ(OB_SUCCESS, ObMemtableDataHeader::build(header, &data));
+  return header;
+}
+
+TEST(TestObMemtableData, test_compress_round_trip)
+{
+  ObArenaAllocator allocator;
+  char row[ROW_LEN];
+  fill_row(row, ROW_LEN);
+
+  ObMemtableData data(blocksstable::ObDmlFlag::DF_INSERT, ROW_LEN, row);
+  EXPECT_EQ(OB_SUCCESS, data.compress(1024, allocator));
+  EXPECT_EQ(ROW_LEN, data.data_len_);
+  EXPECT_LT(data.buf_len_, ROW_LEN);
+
+  ObMemtableDataHeader *header = dup_header(allocator, data);
+  EXPECT_TRUE(header->is_compressed());
+  EXPECT_EQ(ROW_LEN, header->get_data_len());
+
+  const char *out = NULL;
+  int64_t out_len = 0;
+  EXPECT_EQ(OB_SUCCESS, header->get_data(allocator, out, out_len));
+  EXPECT_EQ(ROW_LEN, out_len);
+  EXPECT_EQ(0, MEMCMP(row, out, ROW_LEN));
+}
+
+TEST(TestObMemtableData, test_compress_threshold)
+{
+  ObArenaAllocator allocator;
+  char row[ROW_LEN];
+  fill_row(row, ROW_LEN);
+
+  // disabled
+  ObMemtableData data(blocksstable::ObDmlFlag::DF_INSERT, ROW_LEN, row);
+  EXPECT_EQ(OB_SUCCESS, data.compress(0, allocator));
+  EXPECT_EQ(0, data.data_len_);
+  EXPECT_EQ(row, data.buf_);
+
+  // shorter than the threshold
+  EXPECT_EQ(OB_SUCCESS, data.compress(ROW_LEN + 1, allocator));
+  EXPECT_EQ(0, data.data_len_);
+  EXPECT_EQ(ROW_LEN, data.buf_len_);
+
+  ObMemtableDataHeader *header = dup_header(allocator, data);
+  const char *out = NULL;
+  int64_t out_len = 0;
+  EXPECT_FALSE(header->is_compressed());
+  EXPECT_EQ(OB_SUCCESS, header->get_data(allocator, out, out_len));
+  EXPECT_EQ(header->buf_, out);
+  EXPECT_EQ(ROW_LEN, out_len);
+}
+
+TEST(TestObMemtableData, test_checksum)
+{
+  ObArenaAllocator allocator;
+  char row[ROW_LEN];
+  fill_row(row, ROW_LEN);
+
+  ObMemtableData plain_data(blocksstable::ObDmlFlag::DF_UPDATE, ROW_LEN, row);
+  ObMemtableData compressed_data(blocksstable::ObDmlFlag::DF_UPDATE, ROW_LEN, row);
+  EXPECT_EQ(OB_SUCCESS, compressed_data.compress(1024, allocator));
+  ObMemtableDataHeader *plain = dup_header(allocator, plain_data);
+  ObMemtableDataHeader *compressed = dup_header(allocator, compressed_data);
+  EXPECT_TRUE(compressed->is_compressed());
+
+  // replicas may compress the same row differently
+  ObBatchChecksum plain_bc;
+  ObBatchChecksum compressed_bc;
+  EXPECT_EQ(OB_SUCCESS, plain->checksum(plain_bc));
+  EXPECT_EQ(OB_SUCCESS, compressed->checksum(compressed_bc));
+  EXPECT_EQ(plain_bc.calc(), compressed_bc.calc());
+
+  // the row image already decompressed for redo gives the same checksum
+  const char *data = NULL;
+  int64_t data_len = 0;
+  ObBatchChecksum redo_bc;
+  EXPECT_EQ(OB_SUCCESS, compressed->get_data(allocator, data, data_len));
+  EXPECT_EQ(OB_SUCCESS, compressed->checksum(redo_bc, data, data_len));
+  EXPECT_EQ(plain_bc.calc(), redo_bc.calc());
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_memtable_data.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -433,7 +433,7 @@ int ObTxNode::read(const ObTxReadSnapshot &snapshot,
     key_obj.set_int(key);
     row_key.assign(&row_key_obj, 1);
     row_key.store_rowkey_.assign(&key_obj, 1);
-    OZ(memtable_->get(iter_param, access_context, row_key, row));
+    OZ(memtable_->get(iter_param, access_context, row_key, row, allocator));
     STORAGE_LOG(INFO, "read_result", K(row), KPC(this));
   }
   OZ(txs_.revert_store_ctx(read_store_ctx));
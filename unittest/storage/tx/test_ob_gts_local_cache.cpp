@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "storage/tx/ob_gts_local_cache.h"
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+namespace unittest
+{
+
+class TestObGTSLocalCache : public ::testing::Test
+{
+public :
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+};
+
+TEST_F(TestObGTSLocalCache, get_gts_with_stc)
+{
+  ObGTSLocalCache cache;
+  int64_t gts = 0;
+  MonotonicTs receive_gts_ts;
+  bool need_send_rpc = false;
+  bool update = false;
+
+  // empty cache
+  EXPECT_EQ(OB_EAGAIN, cache.get_gts(MonotonicTs(100), gts, receive_gts_ts, need_send_rpc));
+  EXPECT_TRUE(need_send_rpc);
+
+  // rpc sent at 100 and not returned, later stc needs another rpc
+  EXPECT_EQ(OB_SUCCESS, cache.update_latest_srr(MonotonicTs(100)));
+  EXPECT_EQ(OB_SUCCESS, cache.update_gts(MonotonicTs(100), 1000, MonotonicTs(150), update));
+  EXPECT_TRUE(update);
+  EXPECT_EQ(OB_SUCCESS, cache.get_gts(MonotonicTs(90), gts, receive_gts_ts, need_send_rpc));
+  EXPECT_EQ(1000, gts);
+  EXPECT_EQ(150, receive_gts_ts.mts_);
+  EXPECT_EQ(OB_EAGAIN, cache.get_gts(MonotonicTs(120), gts, receive_gts_ts, need_send_rpc));
+  EXPECT_TRUE(need_send_rpc);
+}
+
+TEST_F(TestObGTSLocalCache, gts_rpc_inflight)
+{
+  ObGTSLocalCache cache;
+  bool update = false;
+  const int64_t window = 10 * 1000;
+
+  // no rpc sent yet
+  EXPECT_FALSE(cache.is_gts_rpc_inflight(MonotonicTs(100), window));
+
+  // rpc sent at 100 is in flight until its response arrives
+  EXPECT_EQ(OB_SUCCESS, cache.update_latest_srr(MonotonicTs(100)));
+  EXPECT_TRUE(cache.is_gts_rpc_inflight(MonotonicTs(200), window));
+  // coalescing disabled
+  EXPECT_FALSE(cache.is_gts_rpc_inflight(MonotonicTs(200), 0));
+  // the rpc is regarded as lost out of the window
+  EXPECT_FALSE(cache.is_gts_rpc_inflight(MonotonicTs(100 + window), window));
+
+  EXPECT_EQ(OB_SUCCESS, cache.update_gts(MonotonicTs(100), 1000, MonotonicTs(300), update));
+  EXPECT_FALSE(cache.is_gts_rpc_inflight(MonotonicTs(400), window));
+
+  // an older response does not finish a newer rpc
+  EXPECT_EQ(OB_SUCCESS, cache.update_latest_srr(MonotonicTs(500)));
+  EXPECT_EQ(OB_SUCCESS, cache.update_gts(MonotonicTs(100), 1001, MonotonicTs(600), update));
+  EXPECT_TRUE(cache.is_gts_rpc_inflight(MonotonicTs(700), window));
+  EXPECT_EQ(OB_SUCCESS, cache.update_gts(MonotonicTs(500), 1002, MonotonicTs(800), update));
+  EXPECT_FALSE(cache.is_gts_rpc_inflight(MonotonicTs(900), window));
+}
+
+}//end of unittest
+}//end of oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_gts_local_cache.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#define protected public
+#include "storage/tx/ob_tx_elr_handler.h"
+#include "storage/tx/ob_tx_data_functor.h"
+#include "storage/tx/ob_tx_data_define.h"
+#include "storage/memtable/mvcc/ob_mvcc_acc_ctx.h"
+#include "common/ob_clock_generator.h"
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+using namespace storage;
+using namespace memtable;
+namespace unittest
+{
+
+class TestObTxELRDependency : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    acc_ctx_.reset();
+    acc_ctx_.type_ = ObMvccAccessCtx::T::STRONG_READ;
+    acc_ctx_.snapshot_.version_ = SNAPSHOT_VERSION;
+    acc_ctx_.abs_lock_timeout_ = ObTimeUtility::current_time() + 1000 * 1000;
+  }
+  virtual void TearDown() { acc_ctx_.reset(); }
+
+  // read the data of DATA_TX_ID whose tx data is in state
+  int lock_for_read(const int32_t state, const int64_t commit_version, bool &can_read)
+  {
+    int64_t trans_version = 0;
+    bool is_determined_state = false;
+    ObTxData tx_data;
+    tx_data.tx_id_ = DATA_TX_ID;
+    tx_data.state_ = state;
+    tx_data.commit_version_ = commit_version;
+    ObLockForReadArg arg(acc_ctx_, DATA_TX_ID, 1, false);
+    LockForReadFunctor fn(arg, can_read, trans_version, is_determined_state);
+    return fn(tx_data);
+  }
+
+  static const int64_t SNAPSHOT_VERSION = 100;
+  static const ObTransID DATA_TX_ID;
+  ObMvccAccessCtx acc_ctx_;
+};
+const ObTransID TestObTxELRDependency::DATA_TX_ID = ObTransID(2);
+
+TEST_F(TestObTxELRDependency, add_elr_dependency)
+{
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+  EXPECT_EQ(OB_SUCCESS, acc_ctx_.add_elr_dependency(ObTransID(1)));
+  EXPECT_EQ(OB_SUCCESS, acc_ctx_.add_elr_dependency(ObTransID(2)));
+  // the same txn is recorded once
+  EXPECT_EQ(OB_SUCCESS, acc_ctx_.add_elr_dependency(ObTransID(1)));
+  EXPECT_EQ(OB_SUCCESS, acc_ctx_.add_elr_dependency(ObTransID(2)));
+  EXPECT_TRUE(acc_ctx_.has_elr_dependency());
+  EXPECT_EQ(2, acc_ctx_.get_elr_dependencies().count());
+  EXPECT_EQ(ObTransID(1), acc_ctx_.get_elr_dependencies().at(0));
+  EXPECT_EQ(ObTransID(2), acc_ctx_.get_elr_dependencies().at(1));
+  acc_ctx_.reset_elr_dependencies();
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+
+  // reset for the next access
+  EXPECT_EQ(OB_SUCCESS, acc_ctx_.add_elr_dependency(ObTransID(3)));
+  acc_ctx_.reset();
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+}
+
+TEST_F(TestObTxELRDependency, read_elr_data_without_participant)
+{
+  bool can_read = false;
+  EXPECT_EQ(OB_SUCCESS, lock_for_read(ObTxData::ELR_COMMIT, SNAPSHOT_VERSION - 10, can_read));
+  EXPECT_TRUE(can_read);
+  ASSERT_EQ(1, acc_ctx_.get_elr_dependencies().count());
+  EXPECT_EQ(DATA_TX_ID, acc_ctx_.get_elr_dependencies().at(0));
+  // the rows of the same txn are recorded once
+  EXPECT_EQ(OB_SUCCESS, lock_for_read(ObTxData::ELR_COMMIT, SNAPSHOT_VERSION - 10, can_read));
+  EXPECT_EQ(1, acc_ctx_.get_elr_dependencies().count());
+}
+
+TEST_F(TestObTxELRDependency, read_elr_data_with_participant)
+{
+  // our commit log follows the elr txn in the same ls, nothing is recorded
+  bool can_read = false;
+  acc_ctx_.mem_ctx_ = reinterpret_cast<ObMemtableCtx *>(0x1);
+  EXPECT_EQ(OB_SUCCESS, lock_for_read(ObTxData::ELR_COMMIT, SNAPSHOT_VERSION - 10, can_read));
+  EXPECT_TRUE(can_read);
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+  acc_ctx_.mem_ctx_ = NULL;
+}
+
+TEST_F(TestObTxELRDependency, read_no_dependency)
+{
+  bool can_read = false;
+  // the elr data is invisible to the snapshot
+  EXPECT_EQ(OB_SUCCESS, lock_for_read(ObTxData::ELR_COMMIT, SNAPSHOT_VERSION + 10, can_read));
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+  // the commit log is durable
+  EXPECT_EQ(OB_SUCCESS, lock_for_read(ObTxData::COMMIT, SNAPSHOT_VERSION - 10, can_read));
+  EXPECT_TRUE(can_read);
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+  EXPECT_EQ(OB_SUCCESS, lock_for_read(ObTxData::ABORT, 0, can_read));
+  EXPECT_FALSE(can_read);
+  EXPECT_FALSE(acc_ctx_.has_elr_dependency());
+}
+
+TEST_F(TestObTxELRDependency, wait_tx_decided)
+{
+  ObTxELRHandler handler;
+  const int64_t WAIT_US = 20 * 1000;
+  int64_t start_ts = ObTimeUtility::current_time();
+  EXPECT_EQ(OB_TIMEOUT, handler.wait_tx_decided(WAIT_US));
+  EXPECT_GE(ObTimeUtility::current_time() - start_ts, WAIT_US);
+
+  // woken up by the decision
+  std::thread th([&handler]() {
+    ::usleep(10 * 1000);
+    handler.on_tx_decided();
+  });
+  EXPECT_EQ(OB_SUCCESS, handler.wait_tx_decided(10 * 1000 * 1000));
+  th.join();
+
+  // decided before waiting, and any later waiter returns at once
+  start_ts = ObTimeUtility::current_time();
+  EXPECT_EQ(OB_SUCCESS, handler.wait_tx_decided(10 * 1000 * 1000));
+  EXPECT_LT(ObTimeUtility::current_time() - start_ts, 1000 * 1000);
+
+  // the ctx is reused
+  handler.reset();
+  EXPECT_EQ(OB_TIMEOUT, handler.wait_tx_decided(WAIT_US));
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  oceanbase::common::ObLogger &logger = oceanbase::common::ObLogger::get_logger();
+  logger.set_file_name("test_ob_tx_elr_dependency.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}